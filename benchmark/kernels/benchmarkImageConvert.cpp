@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the image conversion paths.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchmarkImageConvert.cpp
+
+  Timed kernels of the vpImageConvert paths used per frame : RGBa to
+  grayscale, grayscale to RGBa and YUV422 decoding, at 1080p.
+*/
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
+
+#include "vpBenchmark.h"
+
+struct ConvertContext
+{
+  vpImage<vpRGBa> color;
+  vpImage<unsigned char> gray;
+  vpImage<vpRGBa> colorOut;
+  std::vector<unsigned char> yuv;
+  unsigned int width;
+  unsigned int height;
+};
+
+static void kernelRGBaToGray(void *context)
+{
+  ConvertContext *ctx = (ConvertContext *)context;
+  vpImageConvert::convert(ctx->color, ctx->gray);
+}
+
+static void kernelGrayToRGBa(void *context)
+{
+  ConvertContext *ctx = (ConvertContext *)context;
+  vpImageConvert::convert(ctx->gray, ctx->colorOut);
+}
+
+static void kernelYUV422ToRGBa(void *context)
+{
+  ConvertContext *ctx = (ConvertContext *)context;
+  vpImageConvert::YUV422ToRGBa(&ctx->yuv[0], (unsigned char *)ctx->colorOut.bitmap,
+                               ctx->width * ctx->height);
+}
+
+int main()
+{
+  vpBenchmark bench;
+  ConvertContext ctx;
+  ctx.width = 1920;
+  ctx.height = 1080;
+  ctx.color.resize(ctx.height, ctx.width);
+  ctx.colorOut.resize(ctx.height, ctx.width);
+  ctx.yuv.resize((size_t)ctx.width * ctx.height * 2);
+
+  for (unsigned int i = 0; i < ctx.height; i++)
+    for (unsigned int j = 0; j < ctx.width; j++) {
+      ctx.color[i][j].R = (unsigned char)(i + j);
+      ctx.color[i][j].G = (unsigned char)(2 * i + j);
+      ctx.color[i][j].B = (unsigned char)(i + 3 * j);
+      ctx.color[i][j].A = 0;
+    }
+  for (size_t k = 0; k < ctx.yuv.size(); k++)
+    ctx.yuv[k] = (unsigned char)(k * 31);
+
+  bench.run("imageconvert.rgba_to_gray.1080p", kernelRGBaToGray, &ctx);
+  bench.run("imageconvert.gray_to_rgba.1080p", kernelGrayToRGBa, &ctx);
+  bench.run("imageconvert.yuv422_to_rgba.1080p", kernelYUV422ToRGBa, &ctx);
+
+  return 0;
+}
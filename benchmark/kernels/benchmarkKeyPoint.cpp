@@ -0,0 +1,88 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the keypoint matching pipeline.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchmarkKeyPoint.cpp
+
+  Timed kernel of the vpKeyPoint detect/extract/match pipeline on a
+  synthetic textured image. Requires OpenCV.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
+
+#include <visp3/vision/vpKeyPoint.h>
+
+#include "vpBenchmark.h"
+
+struct KeyPointContext
+{
+  vpImage<unsigned char> I;
+  vpKeyPoint *keypoint;
+};
+
+static void kernelMatch(void *context)
+{
+  KeyPointContext *ctx = (KeyPointContext *)context;
+  ctx->keypoint->matchPoint(ctx->I);
+}
+
+int main()
+{
+  vpBenchmark bench;
+  KeyPointContext ctx;
+  ctx.I.resize(480, 640);
+  //Synthetic texture with corners at several scales
+  for (unsigned int i = 0; i < 480; i++)
+    for (unsigned int j = 0; j < 640; j++)
+      ctx.I[i][j] = (unsigned char)(((i / 8) ^ (j / 8)) * 37 + ((i / 32) * (j / 32)));
+
+  ctx.keypoint = new vpKeyPoint("ORB", "ORB", "BruteForce-Hamming");
+  ctx.keypoint->buildReference(ctx.I);
+
+  bench.run("keypoint.match.orb.640x480", kernelMatch, &ctx);
+  delete ctx.keypoint;
+
+  return 0;
+}
+
+#else
+#include <cstdio>
+int main()
+{
+  printf("{\"name\":\"keypoint.match.orb.640x480\",\"skipped\":\"OpenCV not available\"}\n");
+  return 0;
+}
+#endif
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the dense linear algebra kernels.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchmarkMatrix.cpp
+
+  Timed kernels of vpMatrix : multiplication, transpose product and SVD,
+  at the sizes met in the visual servoing and pose estimation pipelines.
+*/
+
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpPhiloxRand.h>
+
+#include "vpBenchmark.h"
+
+struct MatrixContext
+{
+  vpMatrix A;
+  vpMatrix B;
+  vpMatrix C;
+};
+
+static void fillRandom(vpMatrix &M, const unsigned int rows, const unsigned int cols, vpPhiloxRand &rng)
+{
+  M.resize(rows, cols);
+  for (unsigned int i = 0; i < rows; i++)
+    for (unsigned int j = 0; j < cols; j++)
+      M[i][j] = rng() - 0.5;
+}
+
+static void kernelMult(void *context)
+{
+  MatrixContext *ctx = (MatrixContext *)context;
+  ctx->C = ctx->A * ctx->B;
+}
+
+static void kernelAtA(void *context)
+{
+  MatrixContext *ctx = (MatrixContext *)context;
+  ctx->C = ctx->A.AtA();
+}
+
+static void kernelSvd(void *context)
+{
+  MatrixContext *ctx = (MatrixContext *)context;
+  vpMatrix M = ctx->A;
+  vpColVector w;
+  vpMatrix V;
+  M.svd(w, V);
+}
+
+int main()
+{
+  vpBenchmark bench;
+  vpPhiloxRand rng(2015, 0);
+  MatrixContext ctx;
+
+  const unsigned int sizes[] = { 6, 50, 100, 200 };
+  char name[64];
+  for (unsigned int s = 0; s < 4; s++) {
+    unsigned int n = sizes[s];
+    fillRandom(ctx.A, n, n, rng);
+    fillRandom(ctx.B, n, n, rng);
+    sprintf(name, "matrix.mult.%u", n);
+    //Batch the small sizes above the timer resolution
+    bench.run(name, kernelMult, &ctx, n <= 50 ? 100 : 1);
+  }
+
+  //Stacked interaction matrix shape of the trackers
+  fillRandom(ctx.A, 600, 6, rng);
+  bench.run("matrix.AtA.600x6", kernelAtA, &ctx, 100);
+
+  for (unsigned int s = 0; s < 3; s++) {
+    unsigned int n = sizes[s + 1];
+    fillRandom(ctx.A, n, n, rng);
+    sprintf(name, "matrix.svd.%u", n);
+    bench.run(name, kernelSvd, &ctx);
+  }
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the moving edge and model-based trackers.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchmarkTracking.cpp
+
+  Timed kernels of vpMeTracker::track (moving edge sites on a synthetic
+  line) and of vpMbEdgeTracker::track on a synthetic cube sequence
+  generated in memory, so that the benchmark needs no dataset.
+*/
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/me/vpMeLine.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+#include "vpBenchmark.h"
+
+#include <fstream>
+
+//Synthetic scene helpers -----------------------------------------------
+
+static void renderLine(vpImage<unsigned char> &I)
+{
+  I = 255;
+  for (int s = 0; s <= 2000; s++) {
+    double t = (double)s / 2000;
+    int i = (int)(50 + t * (430 - 50));
+    int j = (int)(100 + t * (540 - 100));
+    for (int di = -2; di <= 2; di++)
+      for (int dj = -2; dj <= 2; dj++)
+        if (i + di >= 0 && j + dj >= 0 && i + di < (int)I.getHeight() && j + dj < (int)I.getWidth())
+          I[i + di][j + dj] = 30;
+  }
+}
+
+static void renderCube(vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo,
+                       const vpCameraParameters &cam)
+{
+  I = 255;
+  double pts[8][3] = {{-0.05,-0.05,0},{0.05,-0.05,0},{0.05,0.05,0},{-0.05,0.05,0},
+                      {-0.05,-0.05,-0.1},{0.05,-0.05,-0.1},{0.05,0.05,-0.1},{-0.05,0.05,-0.1}};
+  int edges[12][2] = {{0,1},{1,2},{2,3},{3,0},{4,5},{5,6},{6,7},{7,4},{0,4},{1,5},{2,6},{3,7}};
+  vpImagePoint ip[8];
+  for (int k = 0; k < 8; k++) {
+    vpPoint P; P.setWorldCoordinates(pts[k][0], pts[k][1], pts[k][2]);
+    P.changeFrame(cMo); P.projection();
+    vpMeterPixelConversion::convertPoint(cam, P.get_x(), P.get_y(), ip[k]);
+  }
+  for (int e = 0; e < 12; e++) {
+    double i0 = ip[edges[e][0]].get_i(), j0 = ip[edges[e][0]].get_j();
+    double i1 = ip[edges[e][1]].get_i(), j1 = ip[edges[e][1]].get_j();
+    int n = (int)(2 * sqrt((i1-i0)*(i1-i0) + (j1-j0)*(j1-j0))) + 1;
+    for (int s = 0; s <= n; s++) {
+      double t = (double)s / n;
+      int ii = (int)(i0 + t*(i1-i0)), jj = (int)(j0 + t*(j1-j0));
+      for (int di = -1; di <= 1; di++)
+        for (int dj = -1; dj <= 1; dj++)
+          if (ii+di >= 0 && jj+dj >= 0 && ii+di < (int)I.getHeight() && jj+dj < (int)I.getWidth())
+            I[ii+di][jj+dj] = 30;
+    }
+  }
+}
+
+static std::string writeCubeModel()
+{
+  std::string path = "./benchmark_cube.cao";
+  //The .cao grammar of this tree : points, lines, polygons by lines,
+  //polygons by points, cylinders, circles
+  std::ofstream g(path.c_str());
+  g << "V1\n";
+  g << "8\n";
+  g << "-0.05 -0.05 0\n0.05 -0.05 0\n0.05 0.05 0\n-0.05 0.05 0\n";
+  g << "-0.05 -0.05 -0.1\n0.05 -0.05 -0.1\n0.05 0.05 -0.1\n-0.05 0.05 -0.1\n";
+  g << "0\n";        // lines
+  g << "0\n";        // polygons by lines
+  g << "6\n";        // polygons by points
+  g << "4 0 1 2 3\n4 4 5 6 7\n4 0 1 5 4\n4 1 2 6 5\n4 2 3 7 6\n4 3 0 4 7\n";
+  g << "0\n0\n";     // cylinders, circles
+  g.close();
+  return path;
+}
+
+//Kernels ---------------------------------------------------------------
+
+struct MeContext
+{
+  vpImage<unsigned char> I;
+  vpMe me;
+  vpMeLine *line;
+};
+
+static void kernelMeTrack(void *context)
+{
+  MeContext *ctx = (MeContext *)context;
+  ctx->line->track(ctx->I);
+}
+
+struct MbtContext
+{
+  std::vector< vpImage<unsigned char> > sequence;
+  vpMbEdgeTracker *tracker;
+  vpCameraParameters cam;
+  vpHomogeneousMatrix cMo0;
+  unsigned int frame;
+};
+
+static void kernelMbtTrack(void *context)
+{
+  MbtContext *ctx = (MbtContext *)context;
+  //One sample is one frame of the synthetic sequence; restart the
+  //sequence from the initial pose when it wraps.
+  if (ctx->frame == 0)
+    ctx->tracker->setPose(ctx->sequence[0], ctx->cMo0);
+  ctx->tracker->track(ctx->sequence[ctx->frame]);
+  ctx->frame = (ctx->frame + 1) % (unsigned int)ctx->sequence.size();
+}
+
+int main()
+{
+  vpBenchmark bench;
+
+  //--- moving edge sites on a line ---
+  {
+    MeContext ctx;
+    ctx.I.resize(480, 640);
+    renderLine(ctx.I);
+    ctx.me.setMaskSize(5); ctx.me.setMaskNumber(180); ctx.me.setRange(6);
+    ctx.me.setThreshold(1000); ctx.me.setMu1(0.5); ctx.me.setMu2(0.5);
+    ctx.me.setSampleStep(4);
+    ctx.line = new vpMeLine;
+    ctx.line->setMe(&ctx.me);
+    ctx.line->initTracking(ctx.I, vpImagePoint(50, 100), vpImagePoint(430, 540));
+
+    bench.run("me.track.line.640x480", kernelMeTrack, &ctx);
+    delete ctx.line;
+  }
+
+  //--- model-based edge tracker on a synthetic cube sequence ---
+  {
+    MbtContext ctx;
+    ctx.cam.initPersProjWithoutDistortion(600, 600, 320, 240);
+    ctx.cMo0 = vpHomogeneousMatrix(0.01, -0.02, 0.5, 0.2, 0.1, 0.05);
+    ctx.frame = 0;
+
+    //16 frame sequence with a slow pose drift
+    for (int f = 0; f < 16; f++) {
+      vpImage<unsigned char> I(480, 640);
+      vpHomogeneousMatrix cMo(0.01 + 0.0002*f, -0.02 + 0.0002*f, 0.5 + 0.0005*f,
+                              0.2 + 0.001*f, 0.1 - 0.001*f, 0.05);
+      renderCube(I, cMo, ctx.cam);
+      ctx.sequence.push_back(I);
+    }
+
+    std::string model = writeCubeModel();
+    ctx.tracker = new vpMbEdgeTracker;
+    vpMe me;
+    me.setMaskSize(5); me.setMaskNumber(180); me.setRange(8);
+    me.setThreshold(1000); me.setMu1(0.5); me.setMu2(0.5); me.setSampleStep(4);
+    ctx.tracker->setMovingEdge(me);
+    ctx.tracker->setCameraParameters(ctx.cam);
+    ctx.tracker->loadModel(model.c_str());
+    ctx.tracker->initFromPose(ctx.sequence[0], ctx.cMo0);
+
+    bench.run("mbt.track.cube.640x480", kernelMbtTrack, &ctx);
+    delete ctx.tracker;
+    vpIoTools::remove(model);
+  }
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Timed kernel harness shared by the benchmark programs.
+ *
+ *****************************************************************************/
+
+#ifndef __vpBenchmark_h_
+#define __vpBenchmark_h_
+
+#include <visp3/core/vpTime.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/*!
+  Harness running one timed kernel with statistical repetition : after a
+  warmup the kernel is repeated until at least \e minReps samples and
+  \e minSeconds of accumulated run time, then one machine-readable JSON
+  line is printed per kernel:
+
+  \verbatim
+  {"name":"matrix.mult.100","unit":"ms","reps":64,"mean":1.23,...}
+  \endverbatim
+
+  The per-sample times feed the median so that scheduler spikes do not
+  shift the reported figure.
+*/
+class vpBenchmark
+{
+public:
+  typedef void (*vpKernelFn)(void *context);
+
+  vpBenchmark(const unsigned int &minReps = 10, const double &minSeconds = 0.5,
+              const unsigned int &warmupReps = 2)
+    : m_minReps(minReps), m_minSeconds(minSeconds), m_warmupReps(warmupReps)
+  {}
+
+  /*!
+    Time one kernel and print its JSON result line on stdout.
+
+    \param name : Kernel identifier, e.g. "matrix.mult.100".
+    \param fn : Kernel body; one call is one timed sample.
+    \param context : Passed to \e fn at each call.
+    \param innerReps : Calls of \e fn per timed sample; raise it for
+    kernels shorter than the timer resolution, the reported times stay
+    per call.
+
+    \return Median time of one call, in ms.
+  */
+  double run(const char *name, vpKernelFn fn, void *context, const unsigned int &innerReps = 1)
+  {
+    for (unsigned int i = 0; i < m_warmupReps; i++)
+      fn(context);
+
+    std::vector<double> samples;
+    double total = 0.; //per call times, for the mean
+    double wall = 0.;  //accumulated run time, for the stop condition
+    while (samples.size() < m_minReps || wall < 1000. * m_minSeconds) {
+      double t0 = vpTime::measureTimeMs();
+      for (unsigned int r = 0; r < innerReps; r++)
+        fn(context);
+      double dt = (vpTime::measureTimeMs() - t0) / innerReps;
+      samples.push_back(dt);
+      total += dt;
+      wall += dt * innerReps;
+      if (samples.size() >= 100000)
+        break;
+    }
+
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    double median = sorted[sorted.size() / 2];
+    double mean = total / samples.size();
+    double var = 0.;
+    for (unsigned int i = 0; i < samples.size(); i++)
+      var += (samples[i] - mean) * (samples[i] - mean);
+    var /= samples.size();
+
+    printf("{\"name\":\"%s\",\"unit\":\"ms\",\"reps\":%u,"
+           "\"mean\":%.6f,\"median\":%.6f,\"stddev\":%.6f,\"min\":%.6f,\"max\":%.6f}\n",
+           name, (unsigned int)samples.size(), mean, median, std::sqrt(var),
+           sorted[0], sorted[sorted.size() - 1]);
+    fflush(stdout);
+
+    return median;
+  }
+
+private:
+  unsigned int m_minReps;
+  double m_minSeconds;
+  unsigned int m_warmupReps;
+};
+
+#endif
@@ -0,0 +1,269 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Deterministic tracker replay over a recorded sequence.
+ *
+ *****************************************************************************/
+
+/*!
+  \example replayTracker.cpp
+
+  Headless, config-driven replay of a recorded sequence through a tracker,
+  reporting per-frame timing and pose error against an optional ground
+  truth, as CSV plus a JSON summary.
+
+  The configuration file uses the vpIoTools::loadConfigFile() format, one
+  "name value" pair per line:
+
+  \verbatim
+  tracker   mbt                          # tracker type (mbt)
+  model     /data/cube.cao               # model file
+  sequence  /data/seq/image%04d.pgm      # vpVideoReader pattern (.vraw works too)
+  cam_px    600                          # camera intrinsics, or cam_xml + cam_name
+  cam_py    600
+  cam_u0    320
+  cam_v0    240
+  init_pose 0.01,-0.02,0.5,0.2,0.1,0.05  # initial cMo (t, thetaU)
+  gt        /data/seq/gt.txt             # optional: one "tx ty tz tux tuy tuz" line per frame
+  csv       /tmp/replay.csv              # per-frame output
+  json      /tmp/replay.json             # summary output
+  trace     /tmp/replay_trace.json       # optional: chrome://tracing phase timings
+  \endverbatim
+*/
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpProfiler.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpXmlParserCamera.h>
+#include <visp3/io/vpVideoReader.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static bool parsePose(const std::string &text, vpHomogeneousMatrix &M)
+{
+  double v[6];
+  if (sscanf(text.c_str(), "%lf,%lf,%lf,%lf,%lf,%lf", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6)
+    return false;
+  M.buildFrom(v[0], v[1], v[2], v[3], v[4], v[5]);
+  return true;
+}
+
+static void poseError(const vpHomogeneousMatrix &pose, const vpHomogeneousMatrix &gt,
+                      double &translationError, double &rotationError)
+{
+  vpHomogeneousMatrix delta = gt.inverse() * pose;
+  vpTranslationVector t;
+  delta.extract(t);
+  translationError = sqrt(t.sumSquare());
+  vpThetaUVector tu(delta);
+  rotationError = sqrt(tu[0]*tu[0] + tu[1]*tu[1] + tu[2]*tu[2]);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 2) {
+    std::cout << "Usage: " << argv[0] << " <config-file>" << std::endl;
+    return 1;
+  }
+  if (!vpIoTools::loadConfigFile(argv[1])) {
+    std::cerr << "Cannot read the configuration file " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::string trackerType = "mbt", model, sequence, gtPath, csvPath, jsonPath, tracePath;
+  std::string camXml, camName;
+  vpIoTools::readConfigVar("tracker", trackerType);
+  if (!vpIoTools::readConfigVar("model", model)
+      || !vpIoTools::readConfigVar("sequence", sequence)) {
+    std::cerr << "The configuration needs at least 'model' and 'sequence'" << std::endl;
+    return 1;
+  }
+  vpIoTools::readConfigVar("gt", gtPath);
+  vpIoTools::readConfigVar("csv", csvPath);
+  vpIoTools::readConfigVar("json", jsonPath);
+  vpIoTools::readConfigVar("trace", tracePath);
+
+  // Camera: either explicit intrinsics or an XML calibration
+  vpCameraParameters cam;
+  double px = 0, py = 0, u0 = 0, v0 = 0;
+  if (vpIoTools::readConfigVar("cam_px", px) && vpIoTools::readConfigVar("cam_py", py)
+      && vpIoTools::readConfigVar("cam_u0", u0) && vpIoTools::readConfigVar("cam_v0", v0)) {
+    cam.initPersProjWithoutDistortion(px, py, u0, v0);
+  }
+  else if (vpIoTools::readConfigVar("cam_xml", camXml)
+           && vpIoTools::readConfigVar("cam_name", camName)) {
+#ifdef VISP_HAVE_XML2
+    vpXmlParserCamera parser;
+    if (parser.parse(cam, camXml.c_str(), camName,
+                     vpCameraParameters::perspectiveProjWithoutDistortion, 0, 0)
+        != vpXmlParserCamera::SEQUENCE_OK) {
+      std::cerr << "Cannot parse camera " << camName << " from " << camXml << std::endl;
+      return 1;
+    }
+#else
+    std::cerr << "XML camera support not built in" << std::endl;
+    return 1;
+#endif
+  }
+  else {
+    std::cerr << "The configuration needs cam_px/cam_py/cam_u0/cam_v0 or cam_xml/cam_name" << std::endl;
+    return 1;
+  }
+
+  std::string initPoseText;
+  vpHomogeneousMatrix cMoInit;
+  if (!vpIoTools::readConfigVar("init_pose", initPoseText) || !parsePose(initPoseText, cMoInit)) {
+    std::cerr << "The configuration needs init_pose as tx,ty,tz,tux,tuy,tuz" << std::endl;
+    return 1;
+  }
+
+  if (trackerType != "mbt") {
+    // The harness architecture is tracker-agnostic; the keypoint (KLT)
+    // replay needs an OpenCV build to exist at all.
+    std::cerr << "Unsupported tracker type '" << trackerType << "' (supported: mbt)" << std::endl;
+    return 1;
+  }
+
+  // Ground truth: one pose per frame
+  std::vector<vpHomogeneousMatrix> gt;
+  if (!gtPath.empty()) {
+    std::ifstream f(gtPath.c_str());
+    double v[6];
+    while (f >> v[0] >> v[1] >> v[2] >> v[3] >> v[4] >> v[5]) {
+      vpHomogeneousMatrix M;
+      M.buildFrom(v[0], v[1], v[2], v[3], v[4], v[5]);
+      gt.push_back(M);
+    }
+  }
+
+  vpVideoReader reader;
+  vpImage<unsigned char> I;
+  vpMbEdgeTracker tracker;
+  try {
+    reader.setFileName(sequence.c_str());
+    reader.open(I);
+
+    vpMe me;
+    me.setMaskSize(5); me.setMaskNumber(180); me.setRange(8);
+    me.setThreshold(1000); me.setMu1(0.5); me.setMu2(0.5); me.setSampleStep(4);
+    double sampleStep = 0;
+    if (vpIoTools::readConfigVar("me_sample_step", sampleStep))
+      me.setSampleStep(sampleStep);
+    tracker.setMovingEdge(me);
+    tracker.setCameraParameters(cam);
+    tracker.loadModel(model.c_str());
+    tracker.initFromPose(I, cMoInit);
+  }
+  catch (vpException &e) {
+    std::cerr << "Cannot set up the replay: " << e.getMessage() << std::endl;
+    return 1;
+  }
+
+  if (!tracePath.empty())
+    vpProfiler::setEnabled(true);
+
+  FILE *csv = csvPath.empty() ? NULL : fopen(csvPath.c_str(), "w");
+  if (csv)
+    fprintf(csv, "frame,track_ms,translation_error_m,rotation_error_rad\n");
+
+  unsigned long nbFrames = 0, nbFailures = 0;
+  double totalMs = 0., maxMs = 0.;
+  double totalTerr = 0., maxTerr = 0., totalRerr = 0., maxRerr = 0.;
+  unsigned long nbGt = 0;
+
+  while (!reader.end()) {
+    try {
+      reader.acquire(I);
+    }
+    catch (vpException &e) {
+      // A hole in the sequence: report what was replayed so far
+      std::cerr << "Cannot read frame " << nbFrames + 1 << ": " << e.getMessage() << std::endl;
+      nbFailures++;
+      break;
+    }
+    double t0 = vpTime::measureTimeMs();
+    bool ok = true;
+    try {
+      tracker.track(I);
+    }
+    catch (...) {
+      ok = false;
+      nbFailures++;
+    }
+    double dt = vpTime::measureTimeMs() - t0;
+    nbFrames++;
+    totalMs += dt;
+    if (dt > maxMs) maxMs = dt;
+
+    double terr = -1., rerr = -1.;
+    if (ok && nbFrames <= gt.size()) {
+      vpHomogeneousMatrix pose;
+      tracker.getPose(pose);
+      poseError(pose, gt[(size_t)nbFrames - 1], terr, rerr);
+      totalTerr += terr; if (terr > maxTerr) maxTerr = terr;
+      totalRerr += rerr; if (rerr > maxRerr) maxRerr = rerr;
+      nbGt++;
+    }
+
+    if (csv)
+      fprintf(csv, "%lu,%.3f,%.6f,%.6f\n", nbFrames, dt, terr, rerr);
+  }
+  if (csv)
+    fclose(csv);
+
+  if (!tracePath.empty()) {
+    vpProfiler::setEnabled(false);
+    vpProfiler::saveTrace(tracePath);
+  }
+
+  if (!jsonPath.empty()) {
+    FILE *js = fopen(jsonPath.c_str(), "w");
+    if (js) {
+      fprintf(js, "{\"tracker\":\"%s\",\"frames\":%lu,\"failures\":%lu,"
+                  "\"mean_ms\":%.3f,\"max_ms\":%.3f",
+              trackerType.c_str(), nbFrames, nbFailures,
+              nbFrames ? totalMs / nbFrames : 0., maxMs);
+      if (nbGt)
+        fprintf(js, ",\"mean_t_err\":%.6f,\"max_t_err\":%.6f,"
+                    "\"mean_r_err\":%.6f,\"max_r_err\":%.6f,\"gt_frames\":%lu",
+                totalTerr / nbGt, maxTerr, totalRerr / nbGt, maxRerr, nbGt);
+      fprintf(js, "}\n");
+      fclose(js);
+    }
+  }
+
+  std::cout << "Replayed " << nbFrames << " frames, " << nbFailures << " failures, mean "
+            << (nbFrames ? totalMs / nbFrames : 0.) << " ms/frame" << std::endl;
+  return nbFailures == 0 ? 0 : 2;
+}
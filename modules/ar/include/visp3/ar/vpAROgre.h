@@ -180,6 +180,21 @@ class VISP_EXPORT vpAROgre : public Ogre::FrameListener, public Ogre::WindowEven
 
   void load(const std::string &entityName, const std::string &model);
 
+  /*!
+    Request a hierarchical (octree) scene manager, so whole node subtrees
+    are culled against the view frustum instead of testing every entity.
+    Has to be called before init(); silently falls back on the generic
+    scene manager when the octree plugin is not available. Hardware
+    occlusion queries are not driven by this class : they require
+    per-frame query readback the caller's render loop has to own.
+
+    \param enable : True to use hierarchical culling.
+  */
+  void setHierarchicalCulling(const bool &enable) { m_hierarchicalCulling = enable; }
+
+  void setEntityVisible(const std::string &entityName, const bool &visible);
+
+
   bool renderOneFrame(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMw);
   
   bool renderOneFrame(const vpImage<vpRGBa> &I, const vpHomogeneousMatrix &cMw);
@@ -333,6 +348,7 @@ class VISP_EXPORT vpAROgre : public Ogre::FrameListener, public Ogre::WindowEven
   virtual void updateBackgroundTexture(const vpImage<unsigned char> &I);
 
   virtual void updateBackgroundTexture(const vpImage<vpRGBa> &I);
+  void flipBackgroundTexture();
 
 
  private:
@@ -369,6 +385,9 @@ class VISP_EXPORT vpAROgre : public Ogre::FrameListener, public Ogre::WindowEven
   vpImage<vpRGBa> mImageRGBA;                             /** vpImage to store grabbed image */
   vpImage<unsigned char> mImage;                          /** vpImage to store grabbed image */
   Ogre::HardwarePixelBufferSharedPtr mPixelBuffer;        /** Pointer to the pixel buffer */
+  Ogre::HardwarePixelBufferSharedPtr mPixelBuffers[2];    /** Double buffered background textures */
+  unsigned int mBackgroundTextureIndex;                   /** Texture the next upload writes into */
+  bool m_hierarchicalCulling;                             /** Use an octree scene manager when available */
   Ogre::Rectangle2D* mBackground;                         /** Background image */
   unsigned int mBackgroundHeight;                         /** Height of the acquired image */
   unsigned int mBackgroundWidth;                          /** Width of the acquired image */
@@ -77,7 +77,7 @@ vpAROgre::vpAROgre(const vpCameraParameters &cam,
       mInputManager(0), mKeyboard(0),
 #endif
       keepOn(true), // When created no reason to stop displaying
-      mImageRGBA(), mImage(), mPixelBuffer(NULL), mBackground(NULL), mBackgroundHeight(0),
+      mImageRGBA(), mImage(), mPixelBuffer(NULL), mPixelBuffers(), mBackgroundTextureIndex(0), m_hierarchicalCulling(false), mBackground(NULL), mBackgroundHeight(0),
       mBackgroundWidth(0), mWindowHeight(height), mWindowWidth(width), windowHidden(false),
       mNearClipping(0.001), mFarClipping(200), mcam(cam), mshowConfigDialog(true),
       mOptionnalResourceLocation()
@@ -394,7 +394,20 @@ void vpAROgre::init(bool
   //		ST_INTERIOR = Quake3 BSP
   //-----------------------------------------------------
 
-  mSceneMgr = mRoot->createSceneManager(Ogre::ST_GENERIC);
+  // A hierarchical scene manager culls whole node subtrees against the
+  // frustum instead of testing every entity; fall back on the generic one
+  // when the octree plugin is not loaded
+  if (m_hierarchicalCulling) {
+    try {
+      mSceneMgr = mRoot->createSceneManager("OctreeSceneManager");
+    }
+    catch (...) {
+      mSceneMgr = mRoot->createSceneManager(Ogre::ST_GENERIC);
+    }
+  }
+  else {
+    mSceneMgr = mRoot->createSceneManager(Ogre::ST_GENERIC);
+  }
 
   // Create the camera
   createCamera();
@@ -676,6 +689,20 @@ void vpAROgre::load(const std::string &entityName, const std::string &model)
   newNode->attachObject(newEntity);
 }
 
+/*!
+  Show or hide an entity of the scene. A hidden entity costs nothing at
+  render time, which is the cheapest culling when the application knows an
+  overlay cannot be in view.
+
+  \param entityName : Name given to load().
+  \param visible : True to render the entity.
+*/
+void vpAROgre::setEntityVisible(const std::string &entityName, const bool &visible)
+{
+  Ogre::SceneNode *node = mSceneMgr->getSceneNode(entityName);
+  node->setVisible(visible);
+}
+
 /*!
   Change position of a ScneneNode.
   \param sceneName : Name of the SceneNode to move.
@@ -806,35 +833,26 @@ void vpAROgre::createBackground(vpImage<unsigned char> & /* I */)
 
   // Dynamic texture
   // If we are using opengl we can boost a little bit performances with a dynamic texture
-  if(mRoot->getRenderSystem()->getName() == "OpenGL Rendering Subsystem") {
-    Ogre::TextureManager::getSingleton().createManual("BackgroundTexture",
-						      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
-						      Ogre::TEX_TYPE_2D,
-						      mBackgroundWidth,//width
-						      mBackgroundHeight,//height
-						      0,  // num of mip maps
-						      Ogre::PF_BYTE_L,
-						      Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
-  }
-  else{
-    Ogre::TextureManager::getSingleton().createManual("BackgroundTexture",
+  // Double buffered so that the upload of a frame overlaps the rendering
+  // of the previous one
+  Ogre::TextureUsage usage = Ogre::TU_DEFAULT;
+  if(mRoot->getRenderSystem()->getName() == "OpenGL Rendering Subsystem")
+    usage = Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE;
+  for (unsigned int b = 0; b < 2; b++) {
+    Ogre::String name = b == 0 ? "BackgroundTexture" : "BackgroundTexture1";
+    Ogre::TextureManager::getSingleton().createManual(name,
 						      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
 						      Ogre::TEX_TYPE_2D,
 						      mBackgroundWidth,//width
 						      mBackgroundHeight,//height
 						      0,  // num of mip maps
 						      Ogre::PF_BYTE_L,
-						      Ogre::TU_DEFAULT);
+						      usage);
+    Ogre::TexturePtr texPtr = Ogre::TextureManager::getSingleton().getByName(name);
+    mPixelBuffers[b] = texPtr->getBuffer();
   }
-
-  // Pointer to the dynamic texture
-  Ogre::TexturePtr dynTexPtr = Ogre::TextureManager::getSingleton().getByName("BackgroundTexture");
-//#if ( OGRE_VERSION >= (1 << 16 | 9 << 8 | 0) )
-//    .dynamicCast<Ogre::Texture>();// Get the pixel buffer
-//#else
-//      ;
-//#endif
-  mPixelBuffer = dynTexPtr->getBuffer();
+  mBackgroundTextureIndex = 0;
+  mPixelBuffer = mPixelBuffers[0];
 
   // Material to apply the texture to the background
   Ogre::MaterialPtr Backgroundmaterial
@@ -877,8 +895,15 @@ void vpAROgre::createBackground(vpImage<vpRGBa> & /* I */)
 
   // Dynamic texture
   // If we are using opengl we can boost a little bit performances with a dynamic texture
-  if(mRoot->getRenderSystem()->getName() == "OpenGL Rendering Subsystem") {
-    Ogre::TextureManager::getSingleton().createManual("BackgroundTexture",
+  // Double buffered so that the upload of a frame overlaps the rendering
+  // of the previous one. As the discardable texture does not seem to work
+  // properly with direct3D we use a default texture there.
+  Ogre::TextureUsage usage = Ogre::TU_DEFAULT;
+  if(mRoot->getRenderSystem()->getName() == "OpenGL Rendering Subsystem")
+    usage = Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE;
+  for (unsigned int b = 0; b < 2; b++) {
+    Ogre::String name = b == 0 ? "BackgroundTexture" : "BackgroundTexture1";
+    Ogre::TextureManager::getSingleton().createManual(name,
 						      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
 						      Ogre::TEX_TYPE_2D,
 						      mBackgroundWidth,//width
@@ -886,32 +911,12 @@ void vpAROgre::createBackground(vpImage<vpRGBa> & /* I */)
 						      0,  // num of mip maps
                   //Ogre::PF_BYTE_RGBA,
                   Ogre::PF_BYTE_BGRA,
-                  Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+                  usage);
+    Ogre::TexturePtr texPtr = Ogre::TextureManager::getSingleton().getByName(name);
+    mPixelBuffers[b] = texPtr->getBuffer();
   }
-  else{ // As that texture does not seem to work properly with direct3D we use a default texture
-    Ogre::TextureManager::getSingleton().createManual("BackgroundTexture",
-						      Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
-						      Ogre::TEX_TYPE_2D,
-						      mBackgroundWidth,//width
-						      mBackgroundHeight,//height
-						      0,  // num of mip maps
-                  //Ogre::PF_BYTE_RGBA,
-                  Ogre::PF_BYTE_BGRA,
-						      Ogre::TU_DEFAULT);
-  }
-
-
-  // Pointer to the dynamic texture
-  Ogre::TexturePtr dynTexPtr =
-    Ogre::TextureManager::getSingleton().getByName("BackgroundTexture");
-//#if ( OGRE_VERSION >= (1 << 16 | 9 << 8 | 0) )
-//      .dynamicCast<Ogre::Texture>();// Get the pixel buffer
-//#else
-//      ;
-//#endif
-
-  // Get the pixel buffer
-  mPixelBuffer = dynTexPtr->getBuffer();
+  mBackgroundTextureIndex = 0;
+  mPixelBuffer = mPixelBuffers[0];
 
   // Material to apply the texture to the background
   Ogre::MaterialPtr Backgroundmaterial
@@ -982,23 +987,49 @@ void vpAROgre::updateCameraProjection(void)
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Point the background material at the texture that was just filled and
+  select the other one for the next upload.
+*/
+void vpAROgre::flipBackgroundTexture()
+{
+  if (mPixelBuffers[0].isNull() || mPixelBuffers[1].isNull())
+    return;
+  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName("BackgroundMaterial");
+  if (material.isNull())
+    return;
+  Ogre::String name = mBackgroundTextureIndex == 0 ? "BackgroundTexture" : "BackgroundTexture1";
+  material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureName(name);
+  mBackgroundTextureIndex = 1 - mBackgroundTextureIndex;
+}
+#endif
+
 /*!
   Update the texture we see in background with a grey level image.
 */
 void vpAROgre::updateBackgroundTexture(const vpImage<unsigned char> &I)
 {
   // Inspired from Ogre wiki : http://www.ogre3d.org/tikiwiki/Creating+dynamic+textures
-  // Lock the pixel buffer and get a pixel box. HBL_DISCARD is to use for best
-  // performance than HBL_NORMAL
-  mPixelBuffer->lock(Ogre::HardwareBuffer::HBL_DISCARD); // Lock the buffer
-  const Ogre::PixelBox& pixelBox = mPixelBuffer->getCurrentLock();
+  // The texture the renderer is not reading is filled, then the background
+  // material flips onto it : the upload overlaps the rendering of the
+  // previous frame. HBL_DISCARD gives the driver a fresh buffer.
+  Ogre::HardwarePixelBufferSharedPtr buffer =
+    mPixelBuffers[mBackgroundTextureIndex].isNull() ? mPixelBuffer : mPixelBuffers[mBackgroundTextureIndex];
+  buffer->lock(Ogre::HardwareBuffer::HBL_DISCARD); // Lock the buffer
+  const Ogre::PixelBox& pixelBox = buffer->getCurrentLock();
   // Buffer data
   Ogre::uint8* pDest = static_cast<Ogre::uint8*>(pixelBox.data);
-  // Fill in the data in the grey level texture
-  memcpy(pDest, I.bitmap, mBackgroundHeight*mBackgroundWidth);
+  // Fill in the data in the grey level texture, row by row since the
+  // driver may pad the rows
+  size_t rowPitchBytes = pixelBox.rowPitch * Ogre::PixelUtil::getNumElemBytes(pixelBox.format);
+  for (unsigned int i = 0; i < mBackgroundHeight; i++)
+    memcpy(pDest + i * rowPitchBytes, I.bitmap + (size_t)i * mBackgroundWidth, mBackgroundWidth);
 
   // Unlock the pixel buffer
-  mPixelBuffer->unlock();
+  buffer->unlock();
+
+  flipBackgroundTexture();
 }
 
 /*!
@@ -1007,34 +1038,29 @@ void vpAROgre::updateBackgroundTexture(const vpImage<unsigned char> &I)
 void vpAROgre::updateBackgroundTexture(const vpImage<vpRGBa> &I)
 {
   // Inspired from Ogre wiki : http://www.ogre3d.org/tikiwiki/Creating+dynamic+textures
-  // Lock the pixel buffer and get a pixel box. HBL_DISCARD is to use for best
-  // performance than HBL_NORMAL
-  mPixelBuffer->lock(Ogre::HardwareBuffer::HBL_DISCARD); // Lock the buffer
-  const Ogre::PixelBox& pixelBox = mPixelBuffer->getCurrentLock();
+  // Double buffered as for the grey level overload.
+  Ogre::HardwarePixelBufferSharedPtr buffer =
+    mPixelBuffers[mBackgroundTextureIndex].isNull() ? mPixelBuffer : mPixelBuffers[mBackgroundTextureIndex];
+  buffer->lock(Ogre::HardwareBuffer::HBL_DISCARD); // Lock the buffer
+  const Ogre::PixelBox& pixelBox = buffer->getCurrentLock();
   // Buffer data
   Ogre::uint8* pDest = static_cast<Ogre::uint8*>(pixelBox.data);
-  // Fill in the data in the grey level texture
-#if 1 // if texture in BGRa format
+  // Fill in the data in the BGRa texture, honoring the driver row pitch
+  size_t rowPitchBytes = pixelBox.rowPitch * Ogre::PixelUtil::getNumElemBytes(pixelBox.format);
   for(unsigned int i=0; i<mBackgroundHeight; i++){
+    Ogre::uint8 *row = pDest + i * rowPitchBytes;
     for(unsigned int j=0; j<mBackgroundWidth; j++){
-      // Color Image
-//      *pDest++=I[i][mBackgroundWidth-j].B; // Blue component
-//      *pDest++=I[i][mBackgroundWidth-j].G; // Green component
-//      *pDest++=I[i][mBackgroundWidth-j].R; // Red component
-
-      *pDest++=I[i][j].B; // Blue component
-      *pDest++=I[i][j].G; // Green component
-      *pDest++=I[i][j].R; // Red component
-
-      *pDest++ = 255;     // Alpha component
+      *row++=I[i][j].B; // Blue component
+      *row++=I[i][j].G; // Green component
+      *row++=I[i][j].R; // Red component
+      *row++ = 255;     // Alpha component
     }
   }
-#else // if texture in RGBa format which is the format of the input image
-  memcpy(pDest, I.bitmap, mBackgroundHeight*mBackgroundWidth*sizeof(vpRGBa));
-#endif
 
   // Unlock the pixel buffer
-  mPixelBuffer->unlock();
+  buffer->unlock();
+
+  flipBackgroundTexture();
 }
 
 /*!
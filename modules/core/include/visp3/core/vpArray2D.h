@@ -49,6 +49,10 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpException.h>
 
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+#  include <utility> // std::move
+#endif
+
 /*!
   \class vpArray2D
   \ingroup group_core_matrices
@@ -80,8 +84,13 @@ protected:
   unsigned int dsize;
 
 public:
-  //! Address of the first element of the data array
+  //! Address of the first element of the data array. The storage allocated
+  //! by resize() is contiguous and 64-byte aligned on Unix platforms, so
+  //! that vectorized kernels can process it with aligned accesses.
   Type *data;
+  //! True when the array owns its data buffer, false when it views an
+  //! external one (see view()); rowPtrs are always owned.
+  bool hasOwnership;
 
 public:
   /*!
@@ -89,17 +98,37 @@ public:
   Number of columns and rows are set to zero.
   */
   vpArray2D<Type>()
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), hasOwnership(true)
   {}
   /*!
   Copy constructor of a 2D array.
   */
   vpArray2D<Type>(const vpArray2D<Type> & A)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), hasOwnership(true)
   {
     resize(A.rowNum, A.colNum);
     memcpy(data, A.data, rowNum*colNum*sizeof(Type));
   }
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  /*!
+  Move constructor of a 2D array. The storage of \e A is stolen without
+  any copy and \e A is left as an empty array.
+
+  \warning Should not be used to move from a vpSubMatrix or vpSubColVector
+  view whose storage belongs to a parent array.
+  */
+  vpArray2D<Type>(vpArray2D<Type> && A)
+    : rowNum(A.rowNum), colNum(A.colNum), rowPtrs(A.rowPtrs), dsize(A.dsize), data(A.data),
+      hasOwnership(A.hasOwnership)
+  {
+    A.hasOwnership = true;
+    A.rowNum = 0;
+    A.colNum = 0;
+    A.rowPtrs = NULL;
+    A.dsize = 0;
+    A.data = NULL;
+  }
+#endif
   /*!
   Constructor that initializes a 2D array with 0.
 
@@ -107,7 +136,7 @@ public:
   \param c : Array number of columns.
   */
   vpArray2D<Type>(unsigned int r, unsigned int c)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), hasOwnership(true)
   {
     resize(r, c);
   }
@@ -119,7 +148,7 @@ public:
   \param val : Each element of the array is set to \e val.
   */
   vpArray2D<Type>(unsigned int r, unsigned int c, Type val)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), hasOwnership(true)
   {
     resize(r, c);
     *this = val;
@@ -130,7 +159,8 @@ public:
   virtual ~vpArray2D<Type>()
   {
     if (data != NULL ) {
-      free(data);
+      if (hasOwnership)
+        free(data);
       data=NULL;
     }
 
@@ -177,6 +207,15 @@ public:
       Type * copyTmp = NULL;
       unsigned int rowTmp = 0, colTmp=0;
 
+      if (!hasOwnership) {
+        // A view resized to another geometry detaches from the external
+        // buffer: the array becomes a regular owning one (the old content
+        // is not carried over, the mapping is left untouched)
+        this->data = NULL;
+        this->dsize = 0;
+        hasOwnership = true;
+      }
+
       // Recopy case per case is required if number of cols has changed;
       // structure of Type array is not the same in this case.
       if (recopyNeeded && this->data != NULL) {
@@ -185,14 +224,38 @@ public:
         rowTmp=this->rowNum; colTmp=this->colNum;
       }
 
-      // Reallocation of this->data array
+      // Reallocation of this->data array. The new storage is 64-byte
+      // aligned where posix_memalign() is available so that vectorized
+      // kernels working on the flat data pointer can rely on aligned
+      // accesses; the memory remains compatible with free().
+      const unsigned int dsizeTmp = this->dsize;
+      Type *dataTmp = this->data;
       this->dsize = nrows*ncols;
-      this->data = (Type*)realloc(this->data, this->dsize*sizeof(Type));
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+      {
+        void *ptr = NULL;
+        if (posix_memalign(&ptr, 64, this->dsize*sizeof(Type)) != 0)
+          ptr = NULL;
+        this->data = (Type*)ptr;
+      }
+#else
+      this->data = (Type*)malloc(this->dsize*sizeof(Type));
+#endif
       if ((NULL == this->data) && (0 != this->dsize)) {
+        // Keep the previous storage so that the array remains consistent
+        this->data = dataTmp;
+        this->dsize = dsizeTmp;
         if (copyTmp != NULL) delete [] copyTmp;
         throw(vpException(vpException::memoryAllocationError,
           "Memory allocation error when allocating 2D array data")) ;
       }
+      if (dataTmp != NULL) {
+        // Keep the values of the common part when the data structure is
+        // unchanged, as realloc() did before
+        if (! recopyNeeded && ! flagNullify)
+          memcpy(this->data, dataTmp, sizeof(Type)*((this->dsize < dsizeTmp) ? this->dsize : dsizeTmp));
+        free(dataTmp);
+      }
 
       this->rowPtrs = (Type**)realloc (this->rowPtrs, nrows*sizeof(Type*));
       if ((NULL == this->rowPtrs) && (0 != this->dsize)) {
@@ -245,6 +308,34 @@ public:
     return *this;
   }
 
+  /*!
+    Make the array a non-owning view over an external contiguous buffer: the
+    data pointer is adopted without copy nor ownership (the caller keeps the
+    buffer alive and frees it), only the row pointers are rebuilt. Resizing
+    a view to another geometry (including by assignment) detaches it into a
+    regular owning array; same-size assignments write through the view.
+
+    \param buffer : External row-major buffer of nrows x ncols elements.
+    \param nrows, ncols : Geometry of the viewed buffer.
+  */
+  void view(Type * const buffer, const unsigned int nrows, const unsigned int ncols)
+  {
+    if (data != NULL && hasOwnership)
+      free(data);
+    if (rowPtrs != NULL)
+      free(rowPtrs);
+
+    rowNum = nrows;
+    colNum = ncols;
+    dsize = nrows*ncols;
+    data = buffer;
+    hasOwnership = false;
+
+    rowPtrs = (Type**)malloc(nrows*sizeof(Type*));
+    for (unsigned int i = 0; i < nrows; i++)
+      rowPtrs[i] = data + i*ncols;
+  }
+
   /*!
     Copy operator of a 2D array.
   */
@@ -254,6 +345,36 @@ public:
     memcpy(data, A.data, rowNum*colNum*sizeof(Type));
     return *this;
   }
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  /*!
+    Move operator of a 2D array. The storage of \e A is stolen without any
+    copy and \e A is left as an empty array, so that an expression like
+    \e v = \e A + \e B reuses the buffer of the temporary instead of
+    duplicating it.
+  */
+  vpArray2D<Type> & operator=(vpArray2D<Type> && A)
+  {
+    if (this != &A) {
+      if (data != NULL && hasOwnership)
+        free(data);
+      if (rowPtrs != NULL)
+        free(rowPtrs);
+      hasOwnership = A.hasOwnership;
+      A.hasOwnership = true;
+      rowNum = A.rowNum;
+      colNum = A.colNum;
+      rowPtrs = A.rowPtrs;
+      dsize = A.dsize;
+      data = A.data;
+      A.rowNum = 0;
+      A.colNum = 0;
+      A.rowPtrs = NULL;
+      A.dsize = 0;
+      A.data = NULL;
+    }
+    return *this;
+  }
+#endif
 
   //! Set element \f$A_{ij} = x\f$ using A[i][j] = x
   inline Type *operator[](unsigned int i) { return rowPtrs[i]; }
@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Single file container of named binary sections.
+ *
+ *****************************************************************************/
+
+#ifndef __vpArtifactBundle_h_
+#define __vpArtifactBundle_h_
+
+#include <visp3/core/vpConfig.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+  \class vpArtifactBundle
+
+  \ingroup group_core_files_io
+
+  \brief Single file container of named binary sections, used to ship
+  the artifacts of a learned detector (model geometry, learning data,
+  matcher index, calibration) as one deployable file instead of a
+  directory of loose files parsed one by one.
+
+  Writing appends named sections; reading scans the section table once
+  and then serves sections by name, either in memory or extracted to a
+  file for consumers that only read from paths. Sections are stored
+  contiguously with explicit sizes, so a loader can also map the file
+  and address a section in place.
+
+  \code
+// packaging :
+vpArtifactBundle bundle;
+bundle.create("detector.vpb");
+bundle.addFile("model", "cube.cao");
+bundle.addSection("camera", serializedCam);
+bundle.close();
+
+// deployment :
+vpArtifactBundle bundle;
+bundle.open("detector.vpb");
+bundle.extractSection("model", "/tmp/cube.cao");
+std::vector<char> cam;
+bundle.getSection("camera", cam);
+  \endcode
+*/
+class VISP_EXPORT vpArtifactBundle
+{
+public:
+  vpArtifactBundle();
+  virtual ~vpArtifactBundle();
+
+  void create(const std::string &filename);
+  void open(const std::string &filename);
+  void close();
+
+  void addSection(const std::string &name, const std::vector<char> &data);
+  void addSection(const std::string &name, const char *data, const size_t &size);
+  void addFile(const std::string &name, const std::string &path);
+
+  bool hasSection(const std::string &name) const;
+  //! Get the names of the sections of an open() bundle.
+  std::vector<std::string> getSectionNames() const;
+  //! Get the byte size of a section, 0 when absent.
+  size_t getSectionSize(const std::string &name) const;
+
+  void getSection(const std::string &name, std::vector<char> &data) const;
+  void extractSection(const std::string &name, const std::string &path) const;
+
+private:
+  //Copy not supported
+  vpArtifactBundle(const vpArtifactBundle &);
+  vpArtifactBundle &operator=(const vpArtifactBundle &);
+
+  typedef struct {
+    unsigned long long offset; //!< Payload offset in the file
+    unsigned long long size;   //!< Payload size in bytes
+  } vpSectionEntry;
+
+  std::string m_filename;
+  bool m_writing;
+  std::map<std::string, vpSectionEntry> m_sections;
+  std::fstream *m_stream; //!< Stream of the open file, NULL when closed
+};
+
+#endif
@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Capture thread wrapper around any frame grabber.
+ *
+ *****************************************************************************/
+
+#ifndef __vpAsyncGrabber_h_
+#define __vpAsyncGrabber_h_
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+#include <visp3/core/vpFrameGrabber.h>
+#include <visp3/core/vpFrameQueue.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpTime.h>
+
+#if !defined(_WIN32)
+#  include <unistd.h> // usleep
+#endif
+
+/*!
+  \class vpAsyncGrabber
+
+  \ingroup group_core_threading
+
+  \brief Capture thread wrapping any vpFrameGrabber : the device is
+  acquired continuously on a dedicated thread and the frames are handed
+  over through the lock-free vpFrameQueue, so the processing loop never
+  blocks on the device and, with the default latest-only policy, always
+  works on the newest frame.
+
+  \code
+#include <visp3/core/vpAsyncGrabber.h>
+#include <visp3/sensor/vpV4l2Grabber.h>
+
+int main()
+{
+  vpV4l2Grabber g;
+  vpImage<unsigned char> I;
+  g.open(I);
+
+  vpAsyncGrabber<unsigned char> capture(g);
+  capture.start();
+
+  for ( ; ; ) {
+    double timestamp;
+    if (capture.acquire(I, timestamp)) {
+      // newest frame, captured at 'timestamp' (us)
+    }
+  }
+}
+  \endcode
+
+  \sa vpFrameQueue
+*/
+template <class Type> class vpAsyncGrabber
+{
+public:
+  /*!
+    Mount a grabber in the capture wrapper. The grabber has to be opened
+    by the caller and stays owned by it.
+
+    \param grabber : Wrapped device.
+    \param policy : Frame delivery policy, see vpFrameQueue.
+    \param capacity : Capacity of the handoff queue.
+  */
+  vpAsyncGrabber(vpFrameGrabber &grabber,
+                 const typename vpFrameQueue<Type>::vpQueuePolicy &policy = vpFrameQueue<Type>::LATEST_ONLY,
+                 const unsigned int &capacity = 4)
+    : m_grabber(grabber), m_queue(policy, capacity), m_thread(NULL),
+      m_running(false), m_captureFailed(false)
+  {
+  }
+
+  //! Stops the capture thread if still running.
+  virtual ~vpAsyncGrabber()
+  {
+    stop();
+  }
+
+  /*!
+    Take a frame from the capture thread.
+
+    \param I : Delivered frame (the newest one under the latest-only
+    policy).
+    \param timestamp : Capture time of the frame from
+    vpTime::measureTimeMicros().
+    \param blocking : If true, wait until a frame is available or the
+    capture stops; if false return immediately.
+
+    \return True if a frame was delivered.
+  */
+  bool acquire(vpImage<Type> &I, double &timestamp, const bool &blocking = true)
+  {
+    for (;;) {
+      if (m_queue.pop(I, timestamp))
+        return true;
+      if (!blocking || !m_running || m_captureFailed)
+        return false;
+      //The producer is the device : nap instead of spinning
+#if defined(_WIN32)
+      Sleep(1);
+#else
+      usleep(200);
+#endif
+    }
+  }
+
+  /*!
+    Get the number of frames the delivery policy dropped.
+
+    \return Number of dropped frames, see vpFrameQueue::getNbDropped().
+  */
+  unsigned long getNbDropped() const { return m_queue.getNbDropped(); }
+
+  /*!
+    Indicates if the capture thread stopped on a device error.
+
+    \return True after an acquisition threw.
+  */
+  bool captureFailed() const { return m_captureFailed; }
+
+  /*!
+    Start the capture thread.
+  */
+  void start()
+  {
+    if (m_running)
+      return;
+    m_captureFailed = false;
+    m_running = true;
+    m_thread = new vpThread(captureLoop, (vpThread::Args)this);
+  }
+
+  /*!
+    Stop the capture thread. Returns once the thread joined, after its
+    current device acquisition completed.
+  */
+  void stop()
+  {
+    if (!m_running)
+      return;
+    m_running = false;
+    delete m_thread; // joins
+    m_thread = NULL;
+  }
+
+private:
+  //Copy not supported
+  vpAsyncGrabber(const vpAsyncGrabber &);
+  vpAsyncGrabber &operator=(const vpAsyncGrabber &);
+
+  static vpThread::Return captureLoop(vpThread::Args args)
+  {
+    vpAsyncGrabber *self = (vpAsyncGrabber *)args;
+    vpImage<Type> I;
+    while (self->m_running) {
+      try {
+        self->m_grabber.acquire(I);
+      }
+      catch (...) {
+        //Leave the consumer a way to notice the device died
+        self->m_captureFailed = true;
+        break;
+      }
+      self->m_queue.push(I, vpTime::measureTimeMicros());
+    }
+    return NULL;
+  }
+
+  vpFrameGrabber &m_grabber;
+  vpFrameQueue<Type> m_queue;
+  vpThread *m_thread;
+  volatile bool m_running;
+  volatile bool m_captureFailed;
+};
+
+#endif
+#endif
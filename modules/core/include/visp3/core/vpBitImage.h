@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bit-packed binary image with word parallel morphology.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpBitImage_h_
+#define __vpBitImage_h_
+
+#include <vector>
+#include <stdint.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageMorphology.h>
+
+/*!
+  \class vpBitImage
+  \ingroup group_core_image
+
+  \brief Binary image packed at one bit per pixel, with word parallel
+  erosion and dilatation.
+
+  vpImageMorphology processes binary masks stored as one byte per
+  pixel. Packing the mask at one bit per pixel divides the memory
+  footprint by eight and lets the 3x3 erosion and dilatation combine 64
+  pixels per bitwise operation:
+
+  \code
+  vpBitImage mask;
+  mask.buildFrom(I, 128);                            // bit = (I >= 128)
+  mask.erosion(vpImageMorphology::CONNEXITY_4);      // 64 pixels per op
+  mask.dilatation(vpImageMorphology::CONNEXITY_8);
+  mask.toImage(Ibin);                                // back to 0/255
+  \endcode
+
+  The border conventions are the ones of vpImageMorphology: outside
+  pixels are foreground for the erosion and background for the
+  dilatation.
+*/
+class VISP_EXPORT vpBitImage
+{
+public:
+  vpBitImage();
+  vpBitImage(unsigned int height, unsigned int width);
+  virtual ~vpBitImage();
+
+  void resize(unsigned int height, unsigned int width);
+
+  void buildFrom(const vpImage<unsigned char> &I, unsigned char threshold);
+  void toImage(vpImage<unsigned char> &I, unsigned char value_true=255, unsigned char value_false=0) const;
+
+  //! Return the state of pixel \f$(i,j)\f$.
+  inline bool operator()(unsigned int i, unsigned int j) const {
+    return (m_words[i*m_words_per_row + (j >> 6)] >> (j & 63)) & 1;
+  }
+  //! Set pixel \f$(i,j)\f$.
+  inline void set(unsigned int i, unsigned int j) {
+    m_words[i*m_words_per_row + (j >> 6)] |= ((uint64_t)1) << (j & 63);
+  }
+  //! Clear pixel \f$(i,j)\f$.
+  inline void clear(unsigned int i, unsigned int j) {
+    m_words[i*m_words_per_row + (j >> 6)] &= ~(((uint64_t)1) << (j & 63));
+  }
+
+  //! Return the image height.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the image width.
+  inline unsigned int getWidth() const { return m_width; }
+
+  void erosion(const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+  void dilatation(const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+
+private:
+  void morphologyPass(bool erode, bool connexity8);
+
+  unsigned int m_height;         //!< Image height
+  unsigned int m_width;          //!< Image width
+  unsigned int m_words_per_row;  //!< Number of 64-bit words per row
+  std::vector<uint64_t> m_words; //!< Packed rows; the padding bits of the last word of a row are kept null
+  std::vector<uint64_t> m_buffer; //!< Working copy used by the morphology passes
+  std::vector<uint64_t> m_result; //!< Output buffer of the morphology passes, reused between the calls
+};
+
+#endif
@@ -0,0 +1,82 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Runtime detection of the CPU vector instruction sets.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpCPUFeatures_h_
+#define __vpCPUFeatures_h_
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \file vpCPUFeatures.h
+  \brief Runtime detection of the CPU vector instruction sets.
+
+  The vectorized kernels of the image and math modules are compiled when
+  the build flags enable the corresponding instruction set. On x86 a
+  binary compiled with SSE2 only may still run on hosts with wider vector
+  units, and conversely a kernel compiled for an instruction set cannot
+  be executed on a host without it. The functions of this namespace query
+  the host once through cpuid (or the auxiliary vector on ARM) and cache
+  the result, so that a kernel guarded by a compile-time flag can also
+  bail out to the scalar implementation at run time:
+
+  \code
+  #if VISP_HAVE_SSE2
+    if (vpCPUFeatures::checkSSE2()) {
+      // vectorized kernel
+    }
+    else
+  #endif
+    {
+      // scalar fallback
+    }
+  \endcode
+*/
+namespace vpCPUFeatures
+{
+  VISP_EXPORT bool checkSSE2();
+  VISP_EXPORT bool checkSSE3();
+  VISP_EXPORT bool checkSSSE3();
+  VISP_EXPORT bool checkSSE41();
+  VISP_EXPORT bool checkSSE42();
+  VISP_EXPORT bool checkAVX();
+  VISP_EXPORT bool checkAVX2();
+  VISP_EXPORT bool checkNeon();
+
+  VISP_EXPORT void printVectorisationInfo();
+}
+
+#endif
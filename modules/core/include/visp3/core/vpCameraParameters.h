@@ -55,6 +55,15 @@
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpDebug.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Compile-time projection model tags : passing one of these to the typed
+//conversion overloads of vpMeterPixelConversion / vpPixelMeterConversion
+//instantiates branch-free code, selected once at tracker setup instead of
+//switching on the runtime model per call.
+struct vpCamPerspective {}; //!< Perspective projection without distortion
+struct vpCamDistorted {};   //!< Perspective projection with distortion
+#endif
+
 /*!
   \class vpCameraParameters
 
@@ -45,6 +45,7 @@
 
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <math.h>
+#include <vector>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpForwardProjection.h>
@@ -110,7 +111,10 @@ public:
   //###################
 
   public:
+  //! Keep the inherited scalar project() visible besides the batched overload
+  using vpForwardProjection::project;
   static void computeIntersectionPoint(const vpCircle &circle, const vpCameraParameters &cam, const double &rho, const double &theta, double &i, double &j);
+  static void project(const std::vector<vpCircle *> &circles, const vpHomogeneousMatrix &cMo);
 
 } ;
 
@@ -82,6 +82,10 @@ public:
   vpColVector(unsigned int n, double val) : vpArray2D<double>(n, 1, val){};
   //! Copy constructor that allows to construct a column vector from an other one.
   vpColVector(const vpColVector &v) : vpArray2D<double>(v) {};
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  //! Move constructor that steals the storage of the \e v temporary.
+  vpColVector(vpColVector &&v) : vpArray2D<double>(std::move(v)) {};
+#endif
   vpColVector(const vpColVector &v, unsigned int r, unsigned int nrows) ;
   //! Constructor that initialize a column vector from a 3-dim (Euler or \f$\theta {\bf u}\f$)
   //! or 4-dim (quaternion) rotation vector.
@@ -174,6 +178,14 @@ public:
   inline const double &operator[](unsigned int n) const { return *(data+n);  }
   //! Copy operator.   Allow operation such as A = v
   vpColVector &operator=(const vpColVector &v);
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  //! Move assignment that reuses the buffer of the \e v temporary.
+  vpColVector &operator=(vpColVector &&v)
+  {
+    vpArray2D<double>::operator=(std::move(v));
+    return *this;
+  }
+#endif
   vpColVector &operator=(const vpPoseVector &p);
   vpColVector &operator=(const vpRotationVector &rv);
   vpColVector &operator=(const vpTranslationVector &tv);
@@ -279,6 +291,11 @@ public:
   static vpColVector sort(const vpColVector &v)  ;
 
   static vpColVector stack(const vpColVector &A, const vpColVector &B);
+  static void addScaled(const vpColVector &v1, const double alpha,
+                        const vpColVector &v2, vpColVector &r);
+
+  void addScaled(const double alpha, const vpColVector &v);
+
   static void stack(const vpColVector &A, const vpColVector &B, vpColVector &C);
 
   static double stdev(const vpColVector &v, const bool useBesselCorrection=false);  
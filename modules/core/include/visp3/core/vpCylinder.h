@@ -46,6 +46,7 @@
 
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <math.h>
+#include <vector>
 #include <visp3/core/vpMath.h>
 
 #include <visp3/core/vpForwardProjection.h>
@@ -185,6 +186,10 @@ public:
   void projection() ;
   void projection(const vpColVector &cP, vpColVector &p) ;
 
+  //! Keep the inherited scalar project() visible besides the batched overload
+  using vpForwardProjection::project;
+  static void project(const std::vector<vpCylinder *> &cylinders, const vpHomogeneousMatrix &cMo) ;
+
   void setWorldCoordinates(const vpColVector& oP) ;
   void setWorldCoordinates(const double A, const double B,
                            const double C,
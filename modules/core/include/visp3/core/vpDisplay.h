@@ -179,6 +179,33 @@ class VISP_EXPORT vpDisplay
   unsigned int height ;
   std::string title_;
 
+ public:
+  //! Type of a batched overlay primitive, see beginOverlayBatch().
+  typedef enum {
+    PRIMITIVE_POINT,
+    PRIMITIVE_LINE,
+    PRIMITIVE_CROSS
+  } vpOverlayPrimitiveType;
+
+  //! One overlay primitive accumulated by the display list, see beginOverlayBatch().
+  struct vpOverlayPrimitive
+  {
+    vpOverlayPrimitiveType type;
+    vpImagePoint ip1;
+    vpImagePoint ip2;   //!< Second end for PRIMITIVE_LINE
+    unsigned int size;  //!< Cross size for PRIMITIVE_CROSS
+    vpColor color;
+    unsigned int thickness;
+  };
+
+ protected :
+  //! Overlay primitives accumulated between beginOverlayBatch() and endOverlayBatch()
+  std::vector<vpOverlayPrimitive> m_overlayBatch;
+  //! True while the overlay primitives are accumulated instead of drawn
+  bool m_overlayBatching;
+
+  virtual void displayPrimitives(const std::vector<vpOverlayPrimitive> &primitives);
+
 public:
 public:
   vpDisplay() ;
@@ -197,6 +224,25 @@ public:
     \sa getHeight()
   */
   inline  unsigned int getWidth() const  { return width ; }
+
+  void beginOverlayBatch();
+  void endOverlayBatch();
+  void endOverlayBatch(std::vector<vpOverlayPrimitive> &primitives);
+  void submitPrimitives(const std::vector<vpOverlayPrimitive> &primitives);
+
+  /*!
+    Indicates if the overlay primitives are being accumulated in the
+    display list rather than drawn immediately.
+
+    \sa beginOverlayBatch()
+
+    \return True while batching.
+  */
+  inline bool isOverlayBatching() const { return m_overlayBatching; }
+
+  void bufferPoint(const vpImagePoint &ip, const vpColor &color);
+  void bufferLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color, unsigned int thickness);
+  void bufferCross(const vpImagePoint &ip, unsigned int size, const vpColor &color, unsigned int thickness);
   /*!
     Return the position (along the horizontal axis) on the screen of the display window.
     \sa getWindowYPosition()
@@ -710,6 +756,11 @@ int main()
   static void displayLine(const vpImage<vpRGBa> &I, int i1, int j1, int i2, int j2, const vpColor &color, unsigned int thickness=1) ;
   static void displayPoint(const vpImage<vpRGBa> &I, const vpImagePoint &ip, const vpColor &color, unsigned int thickness=1) ;
   static void displayPoint(const vpImage<vpRGBa> &I, int i, int j, const vpColor &color, unsigned int thickness=1) ;
+
+  static void beginOverlayBatch(const vpImage<unsigned char> &I);
+  static void endOverlayBatch(const vpImage<unsigned char> &I);
+  static void beginOverlayBatch(const vpImage<vpRGBa> &I);
+  static void endOverlayBatch(const vpImage<vpRGBa> &I);
   static void displayPolygon(const vpImage<vpRGBa> &I, const std::vector<vpImagePoint> &vip, const vpColor &color, unsigned int thickness=1) ;
   static void displayRectangle(const vpImage<vpRGBa> &I, const vpImagePoint &topLeft, unsigned int width, unsigned int height, const vpColor &color, bool fill = false, unsigned int thickness=1);
   static void displayRectangle(const vpImage<vpRGBa> &I, const vpImagePoint &topLeft, const vpImagePoint &bottomRight, const vpColor &color, bool fill = false, unsigned int thickness=1);
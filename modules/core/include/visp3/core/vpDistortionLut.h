@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed lookup table of the lens distortion model.
+ *
+ *****************************************************************************/
+
+#ifndef __vpDistortionLut_h_
+#define __vpDistortionLut_h_
+
+#include <visp3/core/vpCameraParameters.h>
+
+#include <vector>
+
+/*!
+  \class vpDistortionLut
+
+  \ingroup group_core_camera
+
+  \brief Precomputed lookup table mapping undistorted pixel coordinates
+  to their position in the raw (distorted) image.
+
+  The table samples the \f$(1+k_{ud} r^2)\f$ distortion model of
+  vpCameraParameters on a regular grid and interpolates bilinearly in
+  between, so a sparse consumer -- typically a moving-edge tracker whose
+  sites live in undistorted coordinates -- can read the raw image
+  directly instead of paying a full-frame vpImageTools::undistort()
+  remap for a few thousand sample points.
+
+  \code
+vpCameraParameters cam;
+cam.initPersProjWithDistortion(px, py, u0, v0, kud, kdu);
+
+vpDistortionLut lut;
+lut.init(cam, I.getHeight(), I.getWidth());
+
+vpMe me;
+me.setDistortionLut(&lut);  // the moving edges now sample the raw image
+  \endcode
+
+  \sa vpImageTools::undistort(), vpMe::setDistortionLut()
+*/
+class VISP_EXPORT vpDistortionLut
+{
+public:
+  vpDistortionLut();
+  virtual ~vpDistortionLut() {}
+
+  void init(const vpCameraParameters &cam, const unsigned int &height, const unsigned int &width,
+            const unsigned int &step = 8);
+
+  //! Indicates if init() was called.
+  bool isInitialized() const { return m_gridWidth != 0; }
+
+  /*!
+    Map an undistorted pixel position to its position in the raw image,
+    by bilinear interpolation of the precomputed grid. Positions outside
+    the initialized image size are clamped onto its border.
+
+    \param u, v : Undistorted pixel coordinates (column, row).
+    \param ud, vd : Corresponding coordinates in the raw image.
+  */
+  inline void distort(const double &u, const double &v, double &ud, double &vd) const
+  {
+    if (m_gridWidth < 2) { // not initialized : identity
+      ud = u;
+      vd = v;
+      return;
+    }
+    double gu = u / m_step;
+    double gv = v / m_step;
+    if (gu < 0) gu = 0; else if (gu > m_gridWidth - 2) gu = m_gridWidth - 2;
+    if (gv < 0) gv = 0; else if (gv > m_gridHeight - 2) gv = m_gridHeight - 2;
+
+    unsigned int iu = (unsigned int)gu;
+    unsigned int iv = (unsigned int)gv;
+    double fu = gu - iu;
+    double fv = gv - iv;
+
+    const double *r0 = &m_grid[2 * (iv * m_gridWidth + iu)];
+    const double *r1 = r0 + 2 * m_gridWidth;
+    double w00 = (1 - fv) * (1 - fu), w01 = (1 - fv) * fu;
+    double w10 = fv * (1 - fu), w11 = fv * fu;
+    ud = w00 * r0[0] + w01 * r0[2] + w10 * r1[0] + w11 * r1[2];
+    vd = w00 * r0[1] + w01 * r0[3] + w10 * r1[1] + w11 * r1[3];
+  }
+
+private:
+  unsigned int m_step;       //!< Grid sampling step in pixels
+  unsigned int m_gridWidth;  //!< Number of grid nodes per row
+  unsigned int m_gridHeight; //!< Number of grid rows
+  std::vector<double> m_grid; //!< Interleaved (ud, vd) per node
+};
+
+#endif
@@ -47,6 +47,7 @@
 #define vpExponentialMap_h
 
 #include <visp3/core/vpHomogeneousMatrix.h>
+#include <vector>
 #include <visp3/core/vpColVector.h>
 
 /*!
@@ -93,6 +94,11 @@ public:
   static vpHomogeneousMatrix direct(const vpColVector &v);
   static vpHomogeneousMatrix direct(const vpColVector &v, const double &delta_t);
   static vpColVector inverse(const vpHomogeneousMatrix &M);
+
+  static void direct(const std::vector<vpColVector> &v, const double &delta_t,
+                     std::vector<vpHomogeneousMatrix> &M);
+  static void inverse(const std::vector<vpHomogeneousMatrix> &M, const double &delta_t,
+                      std::vector<vpColVector> &v);
   static vpColVector inverse(const vpHomogeneousMatrix &M, const double &delta_t);
 };
 #endif
@@ -0,0 +1,179 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Lock-free single-producer single-consumer frame queue.
+ *
+ *****************************************************************************/
+
+#ifndef __vpFrameQueue_h_
+#define __vpFrameQueue_h_
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#endif
+
+/*!
+  \class vpFrameQueue
+
+  \ingroup group_core_threading
+
+  \brief Lock-free single-producer single-consumer queue of timestamped
+  frames, the standard handoff between a capture thread and a processing
+  thread.
+
+  One thread push()es the captured frames, one other thread pop()s them;
+  neither ever takes a lock. Two delivery policies exist :
+
+  - LATEST_ONLY (the default, the one a servoing loop wants) : pop()
+    drains the queue and delivers the newest frame, counting the skipped
+    ones in getNbDropped();
+  - BOUNDED_DROP_NEWEST : pop() delivers the frames in order; when the
+    consumer falls behind by the whole capacity, push() drops the frame
+    it was given and counts it.
+
+  \sa vpAsyncGrabber
+*/
+template <class Type> class vpFrameQueue
+{
+public:
+  //! Delivery policy of the queue.
+  typedef enum {
+    LATEST_ONLY,        /*!< pop() delivers the newest frame, skipping (and counting) older ones. */
+    BOUNDED_DROP_NEWEST /*!< pop() delivers in order; push() drops when the queue is full. */
+  } vpQueuePolicy;
+
+  /*!
+    Build the queue.
+
+    \param policy : Delivery policy.
+    \param capacity : Number of frames the queue can hold.
+  */
+  vpFrameQueue(const vpQueuePolicy &policy = LATEST_ONLY, const unsigned int &capacity = 4)
+    : m_policy(policy), m_size(capacity < 1 ? 2 : capacity + 1),
+      m_slots(m_size), m_timestamps(m_size, 0.),
+      m_head(0), m_tail(0), m_nbDroppedPush(0), m_nbDroppedPop(0)
+  {
+  }
+
+  /*!
+    Get the number of frames dropped, either skipped by a LATEST_ONLY
+    pop() or refused by a full BOUNDED_DROP_NEWEST push().
+
+    \return Number of dropped frames.
+  */
+  unsigned long getNbDropped() const { return m_nbDroppedPush + m_nbDroppedPop; }
+
+  /*!
+    Publish a frame. To be called from the single producer thread.
+
+    \param I : Captured frame, copied into the queue slot (the slot keeps
+    its allocation across frames of the same size).
+    \param timestamp : Timestamp delivered with the frame.
+
+    \return True if the frame entered the queue, false if it was dropped
+    because the consumer is a full capacity behind.
+  */
+  bool push(const vpImage<Type> &I, const double &timestamp)
+  {
+    unsigned int head = m_head;
+    unsigned int next = (head + 1) % m_size;
+    if (next == m_tail) {
+      //Queue full : the consumer lags by the whole capacity
+      m_nbDroppedPush++;
+      return false;
+    }
+    m_slots[head] = I;
+    m_timestamps[head] = timestamp;
+    memoryBarrier();
+    m_head = next;
+    return true;
+  }
+
+  /*!
+    Take a frame. To be called from the single consumer thread.
+
+    \param I : Delivered frame.
+    \param timestamp : Timestamp the frame was pushed with.
+
+    \return True if a frame was delivered, false if the queue was empty.
+  */
+  bool pop(vpImage<Type> &I, double &timestamp)
+  {
+    unsigned int head = m_head; // snapshot of the published frames
+    unsigned int tail = m_tail;
+    if (tail == head)
+      return false;
+    memoryBarrier();
+
+    unsigned int index = tail;
+    if (m_policy == LATEST_ONLY) {
+      unsigned int available = (head + m_size - tail) % m_size;
+      index = (tail + available - 1) % m_size;
+      m_nbDroppedPop += available - 1;
+    }
+
+    I = m_slots[index];
+    timestamp = m_timestamps[index];
+    memoryBarrier();
+    m_tail = (index + 1) % m_size;
+    return true;
+  }
+
+private:
+  //Copy not supported
+  vpFrameQueue(const vpFrameQueue &);
+  vpFrameQueue &operator=(const vpFrameQueue &);
+
+  static void memoryBarrier()
+  {
+#if defined(_WIN32)
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+  }
+
+  vpQueuePolicy m_policy;
+  unsigned int m_size; //!< Ring size : capacity + 1
+  std::vector< vpImage<Type> > m_slots;
+  std::vector<double> m_timestamps;
+  volatile unsigned int m_head; //!< Next slot the producer writes
+  volatile unsigned int m_tail; //!< Next slot the consumer reads
+  //One counter per side : each is written by a single thread
+  volatile unsigned long m_nbDroppedPush;
+  volatile unsigned long m_nbDroppedPop;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bank of Hinkley cumulative sum tests over several channels.
+ *
+ *****************************************************************************/
+
+#ifndef vpHinkleyBank_H
+#define vpHinkleyBank_H
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpHinkley.h>
+
+#include <vector>
+
+/*!
+  \class vpHinkleyBank
+
+  \ingroup group_core_math_tools
+
+  \brief Bank of Hinkley cumulative sum tests running the two-sided jump
+  detection of vpHinkley over many channels at once.
+
+  The per-channel state (mean, cumulated sums and their extrema) is kept
+  in flat arrays and a whole block of samples is processed in one call,
+  so monitoring dozens of force/torque or joint channels at kilohertz
+  rates costs one function call per block instead of one virtual-free but
+  separate call per channel and sample. The detection is sample-for-sample
+  identical to vpHinkley::testDownUpwardJump(), including the drifting
+  mean guard and the automatic reset after a detected jump.
+
+  Events are reported compactly as (channel, direction, sample index).
+
+  \sa vpHinkley
+*/
+class VISP_EXPORT vpHinkleyBank
+{
+public:
+  //! One detected jump.
+  struct vpHinkleyEvent
+  {
+    unsigned int channel;                     //!< Channel the jump occurred on.
+    vpHinkley::vpHinkleyJumpType direction;   //!< Upward or downward jump.
+    unsigned long sampleIndex;                //!< Sample count at detection, from init().
+  };
+
+  vpHinkleyBank();
+  vpHinkleyBank(const unsigned int &nbChannels, const double &alpha, const double &delta);
+
+  void init(const unsigned int &nbChannels, const double &alpha, const double &delta);
+
+  /*!
+    Get the number of monitored channels.
+
+    \return Number of channels.
+  */
+  unsigned int getNbChannels() const { return m_nbChannels; }
+
+  /*!
+    Get the number of sample frames processed since init().
+
+    \return Number of processed frames.
+  */
+  unsigned long getSampleCount() const { return m_time; }
+
+  void update(const double *samples, std::vector<vpHinkleyEvent> &events);
+  void update(const double *block, const unsigned int &nbSamples, std::vector<vpHinkleyEvent> &events);
+
+private:
+  unsigned int m_nbChannels;
+  double m_dmin2;
+  double m_alpha;
+  unsigned long m_time; //!< Frames processed since init()
+
+  //Per channel state, flat for the block sweep
+  std::vector<double> m_mean;
+  std::vector<double> m_Sk;
+  std::vector<double> m_Mk;
+  std::vector<double> m_Tk;
+  std::vector<double> m_Nk;
+  std::vector<unsigned long> m_nsignal;
+};
+
+#endif
@@ -53,6 +53,7 @@
 #include <visp3/core/vpHistogramPeak.h>
 #include <visp3/core/vpHistogramValey.h>
 #include <visp3/core/vpColor.h>
+#include <visp3/core/vpRect.h>
 
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
 #  include <visp3/core/vpList.h>
@@ -240,6 +241,7 @@ public:
   };
 
   void     calculate(const vpImage<unsigned char> &I, const unsigned int nbins=256, const unsigned int nbThreads=1);
+  void     update(const vpImage<unsigned char> &Iprev, const vpImage<unsigned char> &I, const vpRect &roi);
 
   void     display(const vpImage<unsigned char> &I, const vpColor &color=vpColor::white, const unsigned int thickness=2,
                    const unsigned int maxValue_=0);
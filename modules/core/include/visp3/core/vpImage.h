@@ -196,6 +196,20 @@ public:
    */
   inline unsigned int getSize() const { return width*height ; }
 
+  /*!
+    Get the acquisition timestamp of the image content, in ms with the
+    vpTime::measureTimeMs() time base, or a negative value when the
+    frame was never stamped. Grabbers set it at acquisition (from the
+    driver timestamp when the hardware provides one) and it travels
+    with every copy of the image, so any consumer can compute the age
+    of the data it processes.
+
+    \sa setTimestamp()
+  */
+  inline double getTimestamp() const { return timestamp; }
+  //! Set the acquisition timestamp of the image content, see getTimestamp().
+  inline void setTimestamp(const double &t) { timestamp = t; }
+
   // Gets the value of a pixel at a location with bilinear interpolation.
   Type getValue(double i, double j) const;
   // Gets the value of a pixel at a location with bilinear interpolation.
@@ -318,6 +332,8 @@ private:
   unsigned int width ;   ///! number of columns
   unsigned int height ;  ///! number of rows
   Type **row ;    //!< points the row pointer array
+  bool hasOwnership ; //!< true if this instance owns the bitmap, false when it maps an external buffer
+  double timestamp ; //!< acquisition time in ms, negative when never stamped
 };
 
 
@@ -529,7 +545,8 @@ vpImage<Type>::init(unsigned int h, unsigned int w)
   {
     if (bitmap != NULL) {
       vpDEBUG_TRACE(10,"Destruction bitmap[]") ;
-      delete [] bitmap;
+      if (hasOwnership)
+        delete [] bitmap;
       bitmap = NULL;
     }
   }
@@ -539,7 +556,10 @@ vpImage<Type>::init(unsigned int h, unsigned int w)
 
   npixels=width*height;
 
-  if (bitmap == NULL)  bitmap = new  Type[npixels] ;
+  if (bitmap == NULL) {
+    bitmap = new  Type[npixels] ;
+    hasOwnership = true ;
+  }
 
   //  vpERROR_TRACE("Allocate bitmap %p",bitmap) ;
   if (bitmap == NULL)
@@ -589,7 +609,8 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
   //Delete bitmap if copyData==false, otherwise only if the dimension differs
   if ( (copyData && ((h != this->height) || (w != this->width))) || !copyData ) {
     if (bitmap != NULL) {
-      delete [] bitmap;
+      if (hasOwnership)
+        delete [] bitmap;
       bitmap = NULL;
     }
   }
@@ -600,7 +621,10 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
   npixels = width*height;
 
   if(copyData) {
-    if (bitmap == NULL)  bitmap = new  Type[npixels];
+    if (bitmap == NULL) {
+      bitmap = new  Type[npixels];
+      hasOwnership = true ;
+    }
 
     if (bitmap == NULL) {
       throw(vpException(vpException::memoryAllocationError,
@@ -610,8 +634,10 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
     //Copy the image data
     memcpy(bitmap, array, (size_t) (npixels * sizeof(Type)));
   } else {
-    //Copy the address of the array in the bitmap
+    //Map the external buffer without taking its ownership, so that it
+    //is neither freed by this instance nor copied
     bitmap = array;
+    hasOwnership = false ;
   }
 
   if (row == NULL)  row = new Type*[height];
@@ -645,7 +671,7 @@ vpImage<Type>::init(Type * const array, const unsigned int h, const unsigned int
 */
 template<class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), timestamp(-1.)
 {
   try
   {
@@ -676,7 +702,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template<class Type>
 vpImage<Type>::vpImage (unsigned int h, unsigned int w, Type value)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), timestamp(-1.)
 {
   try
   {
@@ -705,7 +731,7 @@ vpImage<Type>::vpImage (unsigned int h, unsigned int w, Type value)
 */
 template<class Type>
 vpImage<Type>::vpImage (Type * const array, const unsigned int h, const unsigned int w, const bool copyData)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), timestamp(-1.)
 {
   try
   {
@@ -728,7 +754,7 @@ vpImage<Type>::vpImage (Type * const array, const unsigned int h, const unsigned
 */
 template<class Type>
 vpImage<Type>::vpImage()
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), timestamp(-1.)
 {
 }
 
@@ -819,7 +845,8 @@ vpImage<Type>::destroy()
   {
   //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap) ;
 //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap) ;
-    delete [] bitmap ;
+    if (hasOwnership)
+      delete [] bitmap ;
     bitmap = NULL;
   }
 
@@ -853,13 +880,14 @@ vpImage<Type>::~vpImage()
 */
 template<class Type>
 vpImage<Type>::vpImage(const vpImage<Type>& I)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), timestamp(-1.)
 {
   try
   {
     resize(I.getHeight(),I.getWidth());
     memcpy(bitmap, I.bitmap, I.npixels*sizeof(Type)) ;
     for (unsigned int i =0  ; i < this->height ; i++) row[i] = bitmap + i*this->width ;
+    timestamp = I.timestamp ;
   }
   catch(vpException &)
   {
@@ -924,7 +952,8 @@ vpImage<Type> & vpImage<Type>::operator=(const vpImage<Type> &I)
 {
     /* we first have to set the initial values of the image because resize function calls init function that test the actual size of the image */
   if(bitmap != NULL){
-    delete[] bitmap;
+    if (hasOwnership)
+      delete[] bitmap;
     bitmap = NULL ;
   }
 
@@ -935,12 +964,14 @@ vpImage<Type> & vpImage<Type>::operator=(const vpImage<Type> &I)
   this->width = I.width;
   this->height = I.height;
   this->npixels = I.npixels;
+  this->timestamp = I.timestamp;
   try
   {
     if(I.npixels != 0)
     {
       if (bitmap == NULL){
         bitmap = new  Type[npixels] ;
+        hasOwnership = true ;
       }
 
       if (bitmap == NULL){
@@ -101,6 +101,8 @@ public:
   static void createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage<vpRGBa> &dest_rgba);
   static void convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> & dest) ;
   static void convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> & dest) ;
+  static void convertWithStats(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest,
+      double &mean, unsigned char &min, unsigned char &max) ;
           
   static void convert(const vpImage<float> &src, vpImage<unsigned char> &dest);
   static void convert(const vpImage<unsigned char> &src, vpImage<float> &dest);
@@ -220,6 +222,15 @@ public:
   static void YUV420ToGrey(unsigned char* yuv,
         unsigned char* grey, unsigned int size);
 
+  static void demosaicRGGBToRGBa(const unsigned char *bayer, unsigned char *rgba,
+      unsigned int width, unsigned int height);
+  static void demosaicBGGRToRGBa(const unsigned char *bayer, unsigned char *rgba,
+      unsigned int width, unsigned int height);
+  static void demosaicGBRGToRGBa(const unsigned char *bayer, unsigned char *rgba,
+      unsigned int width, unsigned int height);
+  static void demosaicGRBGToRGBa(const unsigned char *bayer, unsigned char *rgba,
+      unsigned int width, unsigned int height);
+
   static void YUV444ToRGBa(unsigned char* yuv,
         unsigned char* rgba, unsigned int size);
   static void YUV444ToRGB(unsigned char* yuv,
@@ -242,11 +253,14 @@ public:
 
   static void RGBToGrey(unsigned char* rgb, unsigned char* grey, unsigned int size);
   static void RGBaToGrey(unsigned char* rgba, unsigned char* grey, unsigned int size);
+  static void RGBaToGrey(unsigned char* rgba, unsigned char* grey, unsigned int size, unsigned int nbThreads);
 
   static void RGBToRGBa(unsigned char * rgb, unsigned char * rgba,
       unsigned int width, unsigned int height, bool flip = false);
   static void RGBToGrey(unsigned char * rgb, unsigned char * grey,
       unsigned int width, unsigned int height, bool flip = false);
+  static void RGBToGrey(unsigned char * rgb, unsigned char * grey,
+      unsigned int width, unsigned int height, bool flip, unsigned int nbThreads);
 
   static void GreyToRGBa(unsigned char* grey,
       unsigned char* rgba, unsigned int size);
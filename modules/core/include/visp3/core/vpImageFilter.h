@@ -193,6 +193,16 @@ public:
   static void filterX(const vpImage<unsigned char> &I, vpImage<double>& dIx, const double *filter,unsigned  int size);
   static void filterX(const vpImage<double> &I, vpImage<double>& dIx, const double *filter,unsigned  int size);
 
+  static void sobelGradient(const vpImage<unsigned char> &I,
+                            vpImage<double> &GIx, vpImage<double> &GIy);
+  static void gradientMagnitudeOrientation(const vpImage<unsigned char> &I,
+                                           vpImage<double> &Gm, vpImage<double> &Go);
+
+  static void sepFilter(const vpImage<unsigned char> &I, vpImage<double>& If,
+                        const double *filterX, unsigned int sizeX,
+                        const double *filterY, unsigned int sizeY,
+                        unsigned int nbThreads=1);
+
   static inline double filterX(const vpImage<unsigned char> &I,
                                unsigned int r, unsigned int c,
                                const double *filter,unsigned  int size)
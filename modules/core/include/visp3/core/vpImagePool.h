@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pool recycling vpImage buffers between the frames of a pipeline.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpImagePool_h_
+#define __vpImagePool_h_
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMutex.h>
+
+/*!
+  \class vpImagePool
+  \ingroup group_core_image
+
+  \brief Pool recycling vpImage instances between the stages of a
+  pipeline.
+
+  A capture/process pipeline that allocates a fresh image per frame pays
+  an allocation and a page-fault warmup on every cycle. The pool keeps
+  the released images and hands them back on the next acquire(): since
+  vpImage::resize() reuses its buffer when the size is unchanged, the
+  steady state of a fixed-size pipeline performs no allocation:
+
+  \code
+  vpImagePool<unsigned char> pool;
+  while (running) {
+    vpImage<unsigned char> *frame = pool.acquire(480, 640);
+    grabber.acquire(*frame);
+    queue.push(frame);           // consumer calls pool.release(frame)
+  }
+  \endcode
+
+  acquire() and release() are protected by a mutex so that a producer
+  and a consumer thread can share the pool, which is the natural use
+  when frames are handed from a grabber thread to a processing thread.
+  For external (driver, DMA) memory, bind the buffer with
+  vpImage::init(buffer, h, w, false) instead: since the image does not
+  own such memory it can be pooled the same way.
+*/
+template<class Type>
+class vpImagePool
+{
+public:
+  vpImagePool() : m_free(), m_all(), m_mutex() {}
+
+  /*!
+    Destructor: every image created by the pool is freed. All the
+    acquired images must have been released.
+  */
+  virtual ~vpImagePool()
+  {
+    for (size_t i = 0; i < m_all.size(); i++)
+      delete m_all[i];
+  }
+
+  /*!
+    Hand out an image of the requested size, reusing a released one when
+    available. The buffer of a reused image is kept when its size is
+    unchanged, so a fixed-size pipeline allocates only on its first
+    cycles.
+
+    \param height, width : Size of the image.
+    \return An image owned by the pool, to give back with release().
+  */
+  vpImage<Type> *acquire(unsigned int height, unsigned int width)
+  {
+    vpImage<Type> *image = NULL;
+    {
+      vpMutex::vpScopedLock lock(m_mutex);
+      // Prefer a free image with the right size to avoid any realloc
+      for (size_t i = 0; i < m_free.size(); i++) {
+        if (m_free[i]->getHeight() == height && m_free[i]->getWidth() == width) {
+          image = m_free[i];
+          m_free[i] = m_free.back();
+          m_free.pop_back();
+          break;
+        }
+      }
+      if (image == NULL && !m_free.empty()) {
+        image = m_free.back();
+        m_free.pop_back();
+      }
+    }
+    if (image == NULL) {
+      image = new vpImage<Type>();
+      vpMutex::vpScopedLock lock(m_mutex);
+      m_all.push_back(image);
+    }
+    image->resize(height, width);
+    return image;
+  }
+
+  /*!
+    Give an image back to the pool so that the next acquire() can reuse
+    its buffer.
+
+    \param image : Image obtained from acquire().
+  */
+  void release(vpImage<Type> *image)
+  {
+    if (image == NULL)
+      return;
+    vpMutex::vpScopedLock lock(m_mutex);
+    m_free.push_back(image);
+  }
+
+  //! Return the number of images created by the pool.
+  unsigned int getNbImages() const { return (unsigned int)m_all.size(); }
+
+private:
+  // A pool owns its images: copying it makes no sense
+  vpImagePool(const vpImagePool &);
+  vpImagePool &operator=(const vpImagePool &);
+
+  std::vector<vpImage<Type> *> m_free; //!< Released images, ready for reuse
+  std::vector<vpImage<Type> *> m_all;  //!< Every image created by the pool
+  vpMutex m_mutex;                     //!< Protects the free list
+};
+
+#endif
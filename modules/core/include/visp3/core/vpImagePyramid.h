@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-level image pyramid with buffers reused between the frames.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpImagePyramid_h_
+#define __vpImagePyramid_h_
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpImagePyramid
+  \ingroup group_core_image
+
+  \brief Multi-level subsampled image pyramid whose buffers are reused
+  between the frames.
+
+  The pyramidal trackers each rebuild a pyramid per frame, allocating
+  and freeing every level. This container owns the level buffers and
+  only refills them when build() is called again with an image of the
+  same size: after the first frame no allocation occurs, and the same
+  pyramid object can feed several trackers working on the same input
+  image.
+
+  Level 0 is a zero-copy view on the input image; level \e i is the
+  input decimated by \f$2^i\f$ with the same nearest neighbor
+  subsampling as the pyramidal model-based tracker:
+
+  \code
+  vpImagePyramid pyramid;
+  while (grab(I)) {
+    pyramid.build(I, 4);             // no allocation after the 1st frame
+    const vpImage<unsigned char> &coarse = pyramid.getLevel(3);
+    // ... track from coarse to fine ...
+  }
+  \endcode
+
+  The level 0 view stays valid as long as the input image passed to
+  build() is alive and not resized.
+*/
+class VISP_EXPORT vpImagePyramid
+{
+public:
+  vpImagePyramid();
+  virtual ~vpImagePyramid();
+
+  void build(const vpImage<unsigned char> &I, unsigned int nbLevels);
+
+  //! Return the number of levels of the pyramid.
+  inline unsigned int getNbLevels() const { return (unsigned int)m_levels.size(); }
+
+  const vpImage<unsigned char> &getLevel(unsigned int level) const;
+
+private:
+  // A pyramid owns its level images: copying it makes no sense
+  vpImagePyramid(const vpImagePyramid &);
+  vpImagePyramid &operator=(const vpImagePyramid &);
+
+  //! Level images; level 0 maps the input image without copy.
+  std::vector<vpImage<unsigned char> *> m_levels;
+};
+
+#endif
@@ -0,0 +1,173 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Zero-copy rectangular view on a vpImage.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpImageRoi_h_
+#define __vpImageRoi_h_
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+/*!
+  \class vpImageRoi
+  \ingroup group_core_image
+
+  \brief Zero-copy rectangular view on a region of a vpImage.
+
+  Extracting a region of interest with vpImageTools::crop() copies the
+  pixels; when the region is only read or modified in place, as done by
+  the trackers that process a window around each feature, the copy is
+  pure overhead. A vpImageRoi keeps a pointer in the parent bitmap and
+  the parent row stride, so that building or moving a view costs a few
+  scalar writes and accessing \c roi[i][j] is a single indexation:
+
+  \code
+  vpImage<unsigned char> I(480, 640);
+  vpImageRoi<unsigned char> roi(I, vpRect(100, 50, 64, 48));
+  double sum = 0;
+  for (unsigned int i = 0; i < roi.getHeight(); i++)
+    for (unsigned int j = 0; j < roi.getWidth(); j++)
+      sum += roi[i][j];          // reads I[50+i][100+j]
+  roi[0][0] = 255;               // writes through to the parent image
+  \endcode
+
+  The view does not own any memory and stays valid as long as the parent
+  image is alive and not resized. Within a row the pixels are contiguous
+  (the rows are spaced by the parent stride), which row based kernels
+  can exploit.
+*/
+template<class Type>
+class vpImageRoi
+{
+public:
+  /*!
+    Basic constructor of an empty view.
+  */
+  vpImageRoi() : m_base(NULL), m_stride(0), m_height(0), m_width(0) {}
+
+  /*!
+    Construct a view on the region \e roi of the image \e I.
+  */
+  vpImageRoi(vpImage<Type> &I, const vpRect &roi)
+    : m_base(NULL), m_stride(0), m_height(0), m_width(0)
+  {
+    init(I, roi);
+  }
+
+  /*!
+    Construct a view from the top left corner and the size of the region.
+  */
+  vpImageRoi(vpImage<Type> &I, unsigned int top, unsigned int left,
+             unsigned int height, unsigned int width)
+    : m_base(NULL), m_stride(0), m_height(0), m_width(0)
+  {
+    init(I, vpRect(left, top, width, height));
+  }
+
+  /*!
+    Initialize or move the view on the region \e roi of the image \e I.
+    Re-initializing an existing view performs no allocation.
+
+    \exception vpException::dimensionError : If the region does not fit
+    in the image.
+  */
+  void init(vpImage<Type> &I, const vpRect &roi)
+  {
+    unsigned int top = (unsigned int)roi.getTop();
+    unsigned int left = (unsigned int)roi.getLeft();
+    m_height = (unsigned int)roi.getHeight();
+    m_width = (unsigned int)roi.getWidth();
+
+    if (top + m_height > I.getHeight() || left + m_width > I.getWidth()) {
+      throw(vpException(vpException::dimensionError,
+                        "The (%dx%d+%d+%d) region does not fit in the (%dx%d) image",
+                        m_width, m_height, left, top, I.getWidth(), I.getHeight())) ;
+    }
+
+    m_stride = I.getWidth();
+    m_base = I.bitmap + top*m_stride + left;
+  }
+
+  //! Return the height of the view.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the width of the view.
+  inline unsigned int getWidth() const { return m_width; }
+  //! Return the number of pixels of the view.
+  inline unsigned int getSize() const { return m_width*m_height; }
+
+  //! Set pixel \f$(i,j)\f$ of the view using roi[i][j] = x; the write goes
+  //! through to the parent image.
+  inline Type *operator[](unsigned int i) { return m_base + i*m_stride; }
+  //! Get pixel \f$(i,j)\f$ of the view using x = roi[i][j].
+  inline const Type *operator[](unsigned int i) const { return m_base + i*m_stride; }
+
+  /*!
+    Materialize the view in the image \e dst, equivalent to
+    vpImageTools::crop() on the parent region.
+  */
+  void copyTo(vpImage<Type> &dst) const
+  {
+    dst.resize(m_height, m_width);
+    for (unsigned int i = 0; i < m_height; i++)
+      memcpy(dst[i], m_base + i*m_stride, m_width*sizeof(Type));
+  }
+
+  /*!
+    Copy the content of \e src in the region viewed, writing through to
+    the parent image.
+
+    \exception vpException::dimensionError : If \e src has not the size
+    of the view.
+  */
+  void copyFrom(const vpImage<Type> &src)
+  {
+    if (src.getHeight() != m_height || src.getWidth() != m_width) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot copy a (%dx%d) image in a (%dx%d) region",
+                        src.getHeight(), src.getWidth(), m_height, m_width)) ;
+    }
+    for (unsigned int i = 0; i < m_height; i++)
+      memcpy(m_base + i*m_stride, src[i], m_width*sizeof(Type));
+  }
+
+private:
+  Type *m_base;           //!< First pixel of the region in the parent bitmap
+  unsigned int m_stride;  //!< Parent image width
+  unsigned int m_height;  //!< View height
+  unsigned int m_width;   //!< View width
+};
+
+#endif
@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Tile based parallel scheduler for image processing kernels.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpImageTileScheduler_h_
+#define __vpImageTileScheduler_h_
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpMutex.h>
+
+/*!
+  \class vpImageTileScheduler
+  \ingroup group_core_image
+
+  \brief Cut an image in cache-sized tiles processed concurrently by a
+  pool of threads.
+
+  The threaded kernels of the library (histogram, conversions,
+  filtering) each re-implement their row slicing. This scheduler
+  factorizes the pattern for tile-independent kernels: the image is cut
+  in rectangular tiles queued in a shared list, and the worker threads
+  pull tiles until the list is exhausted, which balances the load when
+  the per-tile cost is not uniform:
+
+  \code
+  struct ThresholdContext { vpImage<unsigned char> *I; unsigned char t; };
+  void thresholdTile(unsigned int r0, unsigned int r1,
+                     unsigned int c0, unsigned int c1, void *ctx)
+  {
+    ThresholdContext *p = (ThresholdContext *)ctx;
+    for (unsigned int i = r0; i < r1; i++)
+      for (unsigned int j = c0; j < c1; j++)
+        (*p->I)[i][j] = (*p->I)[i][j] >= p->t ? 255 : 0;
+  }
+  // ...
+  vpImageTileScheduler scheduler(4);
+  ThresholdContext ctx = { &I, 128 };
+  scheduler.process(I.getHeight(), I.getWidth(), thresholdTile, &ctx);
+  \endcode
+
+  The tile function must only touch the pixels of its tile; tiles never
+  overlap. Without pthread support process() runs the tiles sequentially.
+*/
+class vpImageTileScheduler
+{
+public:
+  //! Kernel applied to one tile, rows [row_start, row_end) and columns
+  //! [col_start, col_end).
+  typedef void (*vpTileFn)(unsigned int row_start, unsigned int row_end,
+                           unsigned int col_start, unsigned int col_end, void *context);
+
+  /*!
+    Construct a scheduler using \e nbThreads worker threads.
+  */
+  explicit vpImageTileScheduler(unsigned int nbThreads = 2)
+    : m_nbThreads(nbThreads == 0 ? 1 : nbThreads)
+  {
+  }
+
+  /*!
+    Cut the \e height x \e width domain in tiles of \e tileHeight x
+    \e tileWidth pixels and apply \e fn on each, the worker threads
+    pulling the tiles from a shared list until exhaustion.
+
+    \param height, width : Size of the processed domain.
+    \param fn : Kernel applied to each tile.
+    \param context : Opaque pointer handed to the kernel.
+    \param tileHeight, tileWidth : Tile size; the right and bottom tiles
+    are smaller when the sizes do not divide the domain.
+  */
+  void process(unsigned int height, unsigned int width, vpTileFn fn, void *context,
+               unsigned int tileHeight = 64, unsigned int tileWidth = 256)
+  {
+    if (height == 0 || width == 0)
+      return;
+    if (tileHeight == 0) tileHeight = height;
+    if (tileWidth == 0) tileWidth = width;
+
+    Work work;
+    work.fn = fn;
+    work.context = context;
+    work.next = 0;
+    unsigned int tiles_per_row = (width + tileWidth - 1) / tileWidth;
+    unsigned int tiles_per_col = (height + tileHeight - 1) / tileHeight;
+    work.nb_tiles = tiles_per_row * tiles_per_col;
+    work.tiles_per_row = tiles_per_row;
+    work.tile_height = tileHeight;
+    work.tile_width = tileWidth;
+    work.height = height;
+    work.width = width;
+
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+    unsigned int nthreads = m_nbThreads;
+    if (nthreads > work.nb_tiles)
+      nthreads = work.nb_tiles;
+    if (nthreads > 1) {
+      std::vector<vpThread *> threadpool;
+      for (unsigned int i = 0; i < nthreads; i++)
+        threadpool.push_back(new vpThread((vpThread::Fn) workerThread, (vpThread::Args) &work));
+      for (size_t i = 0; i < threadpool.size(); i++)
+        threadpool[i]->join();
+      for (size_t i = 0; i < threadpool.size(); i++)
+        delete threadpool[i];
+      return;
+    }
+#endif
+    // Sequential fallback
+    workerThread(&work);
+  }
+
+  //! Return the number of worker threads.
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+
+private:
+  struct Work {
+    vpTileFn fn;
+    void *context;
+    unsigned int next;          //!< Next tile to process, under the mutex
+    unsigned int nb_tiles;
+    unsigned int tiles_per_row;
+    unsigned int tile_height;
+    unsigned int tile_width;
+    unsigned int height;
+    unsigned int width;
+    vpMutex mutex;
+  };
+
+  static vpThread::Return workerThread(vpThread::Args args)
+  {
+    Work *work = (Work *)args;
+    for (;;) {
+      unsigned int tile;
+      {
+        vpMutex::vpScopedLock lock(work->mutex);
+        if (work->next >= work->nb_tiles)
+          break;
+        tile = work->next++;
+      }
+      unsigned int tr = tile / work->tiles_per_row;
+      unsigned int tc = tile % work->tiles_per_row;
+      unsigned int r0 = tr * work->tile_height;
+      unsigned int r1 = r0 + work->tile_height;
+      if (r1 > work->height) r1 = work->height;
+      unsigned int c0 = tc * work->tile_width;
+      unsigned int c1 = c0 + work->tile_width;
+      if (c1 > work->width) c1 = work->width;
+      work->fn(r0, r1, c0, c1, work->context);
+    }
+    return 0;
+  }
+
+  unsigned int m_nbThreads; //!< Number of worker threads
+};
+
+#endif
@@ -53,7 +53,12 @@
 #  include <pthread.h>
 #endif
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#endif
+
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpCameraParameters.h>
@@ -76,10 +81,21 @@ class VISP_EXPORT vpImageTools
 {
 
 public:
+  typedef enum {
+    INTERPOLATION_NEAREST, /*!< Nearest neighbor interpolation. */
+    INTERPOLATION_LINEAR   /*!< Bilinear interpolation. */
+  } vpImageInterpolationType;
+
   template<class Type>
   static inline void binarise(vpImage<Type> &I,
                               Type threshold1, Type threshold2,
-                              Type value1, Type value2, Type value3, const bool useLUT=true);
+                              Type value1, Type value2, Type value3, const bool useLUT=true,
+                              const unsigned int nbThreads=1);
+  static unsigned char computeOtsuThreshold(const vpImage<unsigned char> &I,
+                                            const unsigned int nbThreads=1);
+  static void binariseOtsu(vpImage<unsigned char> &I,
+                           unsigned char value1=0, unsigned char value2=255, const bool useLUT=true,
+                           const unsigned int nbThreads=1);
   static void changeLUT(vpImage<unsigned char>& I,
                         unsigned char A,
                         unsigned char newA,
@@ -113,11 +129,37 @@ public:
                                       const vpImage<unsigned char> &I2,
                                       vpImage<unsigned char> &Idiff);
 
+  template<class Type>
+  static void getInterpolatedValues(const vpImage<Type> &I, const double *i, const double *j,
+                                    double *value, const unsigned int &nb);
+
   static void imageAdd(const vpImage<unsigned char> &I1,
                        const vpImage<unsigned char> &I2,
                        vpImage<unsigned char> &Ires,
                        const bool saturate=false);
 
+  template<class Type>
+  static void resize(const vpImage<Type> &I, vpImage<Type> &Ires,
+                     unsigned int width, unsigned int height,
+                     const vpImageInterpolationType &method = INTERPOLATION_NEAREST);
+
+  static void initUndistortMap(const vpCameraParameters &cam,
+                               unsigned int width, unsigned int height,
+                               vpArray2D<int> &mapU, vpArray2D<int> &mapV,
+                               vpArray2D<float> &mapDu, vpArray2D<float> &mapDv);
+
+  template<class Type>
+  static void remap(const vpImage<Type> &I,
+                    const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                    const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv,
+                    vpImage<Type> &Iundist);
+
+  static void integralImage(const vpImage<unsigned char> &I,
+                            vpImage<double> &II);
+  static void integralImage(const vpImage<unsigned char> &I,
+                            vpImage<double> &II, vpImage<double> &IIsq);
+  static double integralImageSum(const vpImage<double> &II, const vpRect &rect);
+
   static void imageSubtract(const vpImage<unsigned char> &I1,
                             const vpImage<unsigned char> &I2,
                             vpImage<unsigned char> &Ires,
@@ -325,9 +367,11 @@ void vpImageTools::crop(const unsigned char *bitmap, unsigned int width, unsigne
 
   crop.resize(roi_height, roi_width);
   for (unsigned int i=0 ; i < roi_height ; i++) {
-    Type *src = (Type *)bitmap + ( (i+roi_top)*width + roi_left ) * sizeof(Type);
+    //Pointer arithmetic already scales by the pixel size, and only the
+    //region row must be copied
+    Type *src = (Type *)bitmap + ( (i+roi_top)*width + roi_left );
     Type *dst = (Type *)crop[i];
-    memcpy(dst, src, width*sizeof(Type));
+    memcpy(dst, src, roi_width*sizeof(Type));
   }
 }
 
@@ -346,11 +390,13 @@ void vpImageTools::crop(const unsigned char *bitmap, unsigned int width, unsigne
 template<class Type>
 inline void vpImageTools::binarise(vpImage<Type> &I,
                                    Type threshold1, Type threshold2,
-                                   Type value1, Type value2, Type value3, const bool useLUT)
+                                   Type value1, Type value2, Type value3, const bool useLUT,
+                                   const unsigned int nbThreads)
 {
   if(useLUT) {
     std::cerr << "LUT not available for this type ! Will use the iteration method." << std::endl;
   }
+  (void)nbThreads;
 
   Type v;
   Type *p = I.bitmap;
@@ -378,7 +424,8 @@ inline void vpImageTools::binarise(vpImage<Type> &I,
 template<>
 inline void vpImageTools::binarise(vpImage<unsigned char> &I,
                                    unsigned char threshold1, unsigned char threshold2,
-                                   unsigned char value1, unsigned char value2, unsigned char value3, const bool useLUT)
+                                   unsigned char value1, unsigned char value2, unsigned char value3, const bool useLUT,
+                                   const unsigned int nbThreads)
 {
   if(useLUT) {
     //Construct the LUT
@@ -387,7 +434,8 @@ inline void vpImageTools::binarise(vpImage<unsigned char> &I,
       lut[i] = i < threshold1 ? value1 : (i > threshold2 ? value3 : value2);
     }
 
-    I.performLut(lut);
+    // The LUT application spreads the pixels over the requested threads
+    I.performLut(lut, nbThreads);
   } else {
     unsigned char v;
     unsigned char *p = I.bitmap;
@@ -502,7 +550,6 @@ void *vpUndistortInternalType<Type>::vpUndistort_threaded(void *arg)
     }
   }
 
-  pthread_exit((void*) 0);
   return NULL;
 }
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -550,18 +597,19 @@ void vpImageTools::undistort(const vpImage<Type> &I,
     return;
   }
 
-  unsigned int nthreads = 2;
-  pthread_attr_t attr;
-  pthread_t *callThd = new pthread_t [nthreads];
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  //The slices run on the process-wide pool, so that no thread is created
+  //for the call.
+  vpThreadPool &pool = vpThreadPool::getInstance();
+  unsigned int nthreads = pool.getNbThreads();
+  if (nthreads < 2)
+    nthreads = 2;
 
   vpUndistortInternalType<Type> *undistortSharedData;
   undistortSharedData = new vpUndistortInternalType<Type> [nthreads];
+  vpThreadPool::vpTaskStatus *status = new vpThreadPool::vpTaskStatus [nthreads];
 
   for(unsigned int i=0;i<nthreads;i++) {
-    // Each thread works on a different set of data.
-    //    vpTRACE("create thread %d", i);
+    // Each task works on a different set of data.
     undistortSharedData[i].src      = I.bitmap;
     undistortSharedData[i].dst      = undistI.bitmap;
     undistortSharedData[i].width    = I.getWidth();
@@ -569,19 +617,16 @@ void vpImageTools::undistort(const vpImage<Type> &I,
     undistortSharedData[i].cam      = cam;
     undistortSharedData[i].nthreads = nthreads;
     undistortSharedData[i].threadid = i;
-    pthread_create( &callThd[i], &attr,
-                    &vpUndistortInternalType<Type>::vpUndistort_threaded,
-                    &undistortSharedData[i]);
+    pool.enqueue(&vpUndistortInternalType<Type>::vpUndistort_threaded,
+                 &undistortSharedData[i], &status[i]);
   }
-  pthread_attr_destroy(&attr);
-  /* Wait on the other threads */
+  /* Wait on the tasks */
 
   for(unsigned int i=0;i<nthreads;i++) {
-    //  vpTRACE("join thread %d", i);
-    pthread_join( callThd[i], NULL);
+    status[i].wait();
   }
 
-  delete [] callThd;
+  delete [] status;
   delete [] undistortSharedData;
 #else // VISP_HAVE_PTHREAD
   //
@@ -691,6 +736,142 @@ void vpImageTools::undistort(const vpImage<Type> &I,
 #endif
 }
 
+/*!
+  Resize the image to the given dimensions, the destination rows being
+  spread over the available threads when OpenMP is enabled.
+
+  \param I : Input image.
+  \param Ires : Resized image.
+  \param width, height : Size of the resized image.
+  \param method : Interpolation method: nearest neighbor (fastest, used
+  by the pyramidal trackers) or bilinear.
+*/
+template<class Type>
+void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires,
+                          unsigned int width, unsigned int height,
+                          const vpImageInterpolationType &method)
+{
+  if (I.getSize() == 0 || width == 0 || height == 0) {
+    throw (vpException(vpException::dimensionError, "Cannot resize an empty image or resize to an empty image"));
+  }
+
+  Ires.resize(height, width);
+
+  double scale_u = (double)I.getWidth() / (double)width;
+  double scale_v = (double)I.getHeight() / (double)height;
+  int i_width = (int)I.getWidth();
+  int i_height = (int)I.getHeight();
+
+  if (method == INTERPOLATION_NEAREST) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < (int)height; v++) {
+      unsigned int sv = (unsigned int)(v*scale_v);
+      if (sv >= (unsigned int)i_height) sv = (unsigned int)i_height-1;
+      const Type *src = I[sv];
+      Type *dst = Ires[(unsigned int)v];
+      for (unsigned int u = 0; u < width; u++) {
+        unsigned int su = (unsigned int)(u*scale_u);
+        if (su >= (unsigned int)i_width) su = (unsigned int)i_width-1;
+        dst[u] = src[su];
+      }
+    }
+  }
+  else {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < (int)height; v++) {
+      // Center the sampling grid as done by the classical resamplers
+      double v_double = (v + 0.5)*scale_v - 0.5;
+      int v_round = (int)v_double;
+      if (v_double < 0) v_round = -1;
+      double dv = v_double - v_round;
+      Type *dst = Ires[(unsigned int)v];
+      for (unsigned int u = 0; u < width; u++) {
+        double u_double = (u + 0.5)*scale_u - 0.5;
+        int u_round = (int)u_double;
+        if (u_double < 0) u_round = -1;
+        double du = u_double - u_round;
+
+        if (u_round >= 0 && v_round >= 0 && u_round < i_width-1 && v_round < i_height-1) {
+          const Type *_mp = &I[(unsigned int)v_round][(unsigned int)u_round];
+          Type v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du));
+          _mp += i_width;
+          Type v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du));
+          dst[u] = (Type)(v01 + ((v23 - v01) * dv));
+        }
+        else {
+          // Clamp on the image border
+          unsigned int su = u_round < 0 ? 0 : (u_round >= i_width-1 ? (unsigned int)i_width-1 : (unsigned int)u_round);
+          unsigned int sv = v_round < 0 ? 0 : (v_round >= i_height-1 ? (unsigned int)i_height-1 : (unsigned int)v_round);
+          dst[u] = I[sv][su];
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Apply the undistortion mapping precomputed by initUndistortMap(): for
+  each destination pixel the integer source coordinates and the
+  fractional parts are read from the maps and the same bilinear
+  interpolation as undistort() is performed. When the camera does not
+  move, computing the maps once and calling remap() per frame removes
+  the per-pixel distortion polynomial evaluation from the frame loop.
+  The fractional parts being stored as float, isolated pixels may
+  differ by one grey level from undistort().
+
+  \param I : Input image.
+  \param mapU, mapV : Integer source coordinates maps.
+  \param mapDu, mapDv : Fractional parts maps.
+  \param Iundist : Undistorted output image, sized to the maps.
+*/
+template<class Type>
+void vpImageTools::remap(const vpImage<Type> &I,
+                         const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                         const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv,
+                         vpImage<Type> &Iundist)
+{
+  unsigned int height = mapU.getRows(), width = mapU.getCols();
+  if (mapV.getRows() != height || mapV.getCols() != width
+      || mapDu.getRows() != height || mapDu.getCols() != width
+      || mapDv.getRows() != height || mapDv.getCols() != width) {
+    throw (vpException(vpException::dimensionError, "The remap maps do not have the same size"));
+  }
+
+  Iundist.resize(height, width);
+
+  int i_width = (int)I.getWidth();
+  int i_height = (int)I.getHeight();
+  Type *dst = Iundist.bitmap;
+
+  for (unsigned int v = 0; v < height; v++) {
+    for (unsigned int u = 0; u < width; u++) {
+      int u_round = mapU[v][u];
+      int v_round = mapV[v][u];
+      double du_double = mapDu[v][u];
+      double dv_double = mapDv[v][u];
+      Type v01;
+      Type v23;
+      if ( (0 <= u_round) && (0 <= v_round) &&
+           (u_round < (i_width - 1)) && (v_round < (i_height - 1)) ) {
+        //process interpolation
+        const Type* _mp = &I[(unsigned int)v_round][(unsigned int)u_round];
+        v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
+        _mp += i_width;
+        v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
+        *dst = (Type)(v01 + ((v23 - v01) * dv_double));
+      }
+      else {
+        *dst = 0;
+      }
+      dst++;
+    }
+  }
+}
+
 /*!
   Flip vertically the input image and give the result in the output image.
 
@@ -769,8 +950,140 @@ void vpImageTools::flip(vpImage<Type> &I)
     }
 }
 
+/*!
+  Batched equivalent of \e nb calls to vpImage::getValue(double, double):
+  compute the bilinear interpolation of the image at every subpixel location
+  (i[k], j[k]). A single range pre-validation over the whole batch replaces
+  the per access bounds checks, which makes this primitive suited to the
+  inner loops of the trackers where thousands of subpixel fetches are
+  performed per iteration.
+
+  \param I : Image to sample.
+  \param i : Array of the \e nb sub-pixel coordinates along the rows.
+  \param j : Array of the \e nb sub-pixel coordinates along the columns.
+  \param value : Output array of the \e nb interpolated values, rounded to
+  the nearest pixel value like vpImage::getValue().
+  \param nb : Number of samples.
+
+  \exception vpImageException::notInTheImage : If one of the locations lies
+  outside \f$ [0, height-1[ \times [0, width-1[ \f$.
+*/
+template<class Type>
+void vpImageTools::getInterpolatedValues(const vpImage<Type> &I, const double *i, const double *j,
+                                         double *value, const unsigned int &nb)
+{
+  if (nb == 0)
+    return;
+
+  const double hlim = (double)(I.getHeight()-1);
+  const double wlim = (double)(I.getWidth()-1);
+  double mini = i[0], maxi = i[0], minj = j[0], maxj = j[0];
+  for (unsigned int k = 1; k < nb; k++) {
+    if (i[k] < mini) mini = i[k]; else if (i[k] > maxi) maxi = i[k];
+    if (j[k] < minj) minj = j[k]; else if (j[k] > maxj) maxj = j[k];
+  }
+  if (!(mini >= 0 && maxi < hlim && minj >= 0 && maxj < wlim))
+    throw(vpException(vpImageException::notInTheImage,
+          "At least one sub-pixel location outside the image"));
+
+  for (unsigned int k = 0; k < nb; k++) {
+    unsigned int iround = (unsigned int)i[k];
+    unsigned int jround = (unsigned int)j[k];
+    double rratio = i[k] - (double)iround;
+    double cratio = j[k] - (double)jround;
+    double rfrac = 1.0 - rratio;
+    double cfrac = 1.0 - cratio;
+
+    const Type *row0 = I[iround];
+    const Type *row1 = I[iround+1];
+    double v = ((double)row0[jround]*rfrac + (double)row1[jround]*rratio)*cfrac
+             + ((double)row0[jround+1]*rfrac + (double)row1[jround+1]*rratio)*cratio;
+    value[k] = (double)((Type)vpMath::round(v));
+  }
+}
+
+/*!
+  Batched equivalent of \e nb calls to vpImage<double>::getValue(double,
+  double): compute the bilinear interpolation of the image at every subpixel
+  location (i[k], j[k]), two samples per iteration on SSE2. A single range
+  pre-validation over the whole batch replaces the per access bounds checks.
+
+  \param I : Image to sample.
+  \param i : Array of the \e nb sub-pixel coordinates along the rows.
+  \param j : Array of the \e nb sub-pixel coordinates along the columns.
+  \param value : Output array of the \e nb interpolated values.
+  \param nb : Number of samples.
+
+  \exception vpImageException::notInTheImage : If one of the locations lies
+  outside \f$ [0, height-1[ \times [0, width-1[ \f$.
+*/
+template<>
+inline void vpImageTools::getInterpolatedValues(const vpImage<double> &I, const double *i, const double *j,
+                                                double *value, const unsigned int &nb)
+{
+  if (nb == 0)
+    return;
+
+  const double hlim = (double)(I.getHeight()-1);
+  const double wlim = (double)(I.getWidth()-1);
+  double mini = i[0], maxi = i[0], minj = j[0], maxj = j[0];
+  for (unsigned int k = 1; k < nb; k++) {
+    if (i[k] < mini) mini = i[k]; else if (i[k] > maxi) maxi = i[k];
+    if (j[k] < minj) minj = j[k]; else if (j[k] > maxj) maxj = j[k];
+  }
+  if (!(mini >= 0 && maxi < hlim && minj >= 0 && maxj < wlim))
+    throw(vpException(vpImageException::notInTheImage,
+          "At least one sub-pixel location outside the image"));
+
+  unsigned int k = 0;
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+  const __m128d one = _mm_set1_pd(1.0);
+  for (; k+1 < nb; k += 2) {
+    unsigned int ir0 = (unsigned int)i[k], ir1 = (unsigned int)i[k+1];
+    unsigned int jr0 = (unsigned int)j[k], jr1 = (unsigned int)j[k+1];
+
+    __m128d rratio = _mm_sub_pd(_mm_loadu_pd(i+k), _mm_set_pd((double)ir1, (double)ir0));
+    __m128d cratio = _mm_sub_pd(_mm_loadu_pd(j+k), _mm_set_pd((double)jr1, (double)jr0));
+    __m128d rfrac = _mm_sub_pd(one, rratio);
+    __m128d cfrac = _mm_sub_pd(one, cratio);
+
+    const double *p00 = I[ir0] + jr0;
+    const double *p01 = I[ir0+1] + jr0;
+    const double *p10 = I[ir1] + jr1;
+    const double *p11 = I[ir1+1] + jr1;
+    __m128d v00 = _mm_set_pd(p10[0], p00[0]);
+    __m128d v10 = _mm_set_pd(p11[0], p01[0]);
+    __m128d v01 = _mm_set_pd(p10[1], p00[1]);
+    __m128d v11 = _mm_set_pd(p11[1], p01[1]);
+
+    __m128d v = _mm_add_pd(
+        _mm_mul_pd(_mm_add_pd(_mm_mul_pd(v00, rfrac), _mm_mul_pd(v10, rratio)), cfrac),
+        _mm_mul_pd(_mm_add_pd(_mm_mul_pd(v01, rfrac), _mm_mul_pd(v11, rratio)), cratio));
+    _mm_storeu_pd(value+k, v);
+  }
 #endif
+  for (; k < nb; k++) {
+    unsigned int iround = (unsigned int)i[k];
+    unsigned int jround = (unsigned int)j[k];
+    double rratio = i[k] - (double)iround;
+    double cratio = j[k] - (double)jround;
+    double rfrac = 1.0 - rratio;
+    double cfrac = 1.0 - cratio;
+
+    const double *row0 = I[iround];
+    const double *row1 = I[iround+1];
+    value[k] = (row0[jround]*rfrac + row1[jround]*rratio)*cfrac
+             + (row0[jround+1]*rfrac + row1[jround+1]*rratio)*cratio;
+  }
+}
+
+/*
+ * Local variables:
+ * c-basic-offset: 2
+ * End:
+ */
 
+#endif
 
 /*
  * Local variables:
@@ -51,6 +51,7 @@
 #include <string>
 #include <stdlib.h>
 #include <vector>
+#include <map>
 #include <visp3/core/vpColor.h>
 
 /*!
@@ -201,6 +202,8 @@ public:
   //@{
   // read configuration file
   static bool loadConfigFile(const std::string &confFile);
+  static unsigned int readConfigVars(const std::vector<std::string> &vars, std::vector<double> &values);
+  static unsigned int readConfigVars(const std::vector<std::string> &vars, std::vector<std::string> &values);
   static bool readConfigVar(const std::string &var, float &value);
   static bool readConfigVar(const std::string &var, double &value);
   static bool readConfigVar(const std::string &var, int &value);
@@ -233,6 +236,11 @@ public:
   static std::string configFile;
   static std::vector<std::string> configVars;
   static std::vector<std::string> configValues;
+  //! Index of configVars built by loadConfigFile() so that every
+  //! readConfigVar() lookup is a map access instead of a linear scan
+  static std::map<std::string, unsigned int> configIndex;
+
+  static bool getConfigValue(const std::string &var, std::string &value);
 } ;
 
 
@@ -141,6 +141,15 @@ public:
   void init(unsigned int size_state, unsigned int size_measure, unsigned int n_signal) ;
   void prediction() ;
   void filtering(const vpColVector &z) ;
+
+  void computeSteadyStateGain(double tol=1e-8, unsigned int max_iter=1000) ;
+  void predictionSteadyState() ;
+  void filteringSteadyState(const vpColVector &z) ;
+  void filteringSteadyState(const vpMatrix &Z) ;
+  /*!
+    Return the steady state gain computed by computeSteadyStateGain().
+  */
+  inline const vpMatrix &getSteadyStateGain() const { return Wss; }
   /*!
     Return the size of the state vector \f${\bf x}_{(k)}\f$ for one signal.
   */
@@ -215,6 +224,9 @@ protected:
 
   //! Identity matrix \f$ \bf I\f$.
   vpMatrix I ;
+
+  //! Steady state filter gain, set by computeSteadyStateGain().
+  vpMatrix Wss ;
 } ;
 
 
@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Age-of-data statistics of a processing stage.
+ *
+ *****************************************************************************/
+
+#ifndef __vpLatencyStats_h_
+#define __vpLatencyStats_h_
+
+#include <visp3/core/vpConfig.h>
+
+#include <vector>
+
+/*!
+  \class vpLatencyStats
+
+  \ingroup group_core_time
+
+  \brief Age-of-data statistics of a processing stage : each record()ed
+  latency sample (typically now minus the vpImage::getTimestamp() of the
+  frame being consumed) updates running count/min/max/mean and a
+  histogram of 100 bins of \e binMs plus one overflow bin, so a
+  capture-to-control latency distribution is available without external
+  instrumentation.
+
+  \sa vpImage::getTimestamp(), vpServo::setDataTimestamp()
+*/
+class VISP_EXPORT vpLatencyStats
+{
+public:
+  /*!
+    Build the statistics.
+    \param binMs : Width of one histogram bin, in ms.
+  */
+  vpLatencyStats(const double &binMs = 1.)
+    : m_nbSamples(0), m_lastMs(0.), m_minMs(0.), m_maxMs(0.), m_totalMs(0.),
+      m_binMs(binMs <= 0. ? 1. : binMs), m_histogram(101, 0)
+  {
+  }
+
+  //! Record one latency sample, in ms.
+  void record(const double &latencyMs)
+  {
+    m_lastMs = latencyMs;
+    if (m_nbSamples == 0 || latencyMs < m_minMs)
+      m_minMs = latencyMs;
+    if (m_nbSamples == 0 || latencyMs > m_maxMs)
+      m_maxMs = latencyMs;
+    m_totalMs += latencyMs;
+    m_nbSamples++;
+
+    unsigned int bin = (latencyMs <= 0.) ? 0 : (unsigned int)(latencyMs / m_binMs);
+    if (bin > 100) bin = 100; // overflow bin
+    m_histogram[bin]++;
+  }
+
+  //! Get the number of recorded samples.
+  unsigned long getNbSamples() const { return m_nbSamples; }
+  //! Get the last recorded latency, in ms.
+  double getLastMs() const { return m_lastMs; }
+  //! Get the smallest recorded latency, in ms.
+  double getMinMs() const { return m_minMs; }
+  //! Get the largest recorded latency, in ms.
+  double getMaxMs() const { return m_maxMs; }
+  //! Get the mean recorded latency, in ms.
+  double getMeanMs() const { return m_nbSamples ? m_totalMs / m_nbSamples : 0.; }
+
+  /*!
+    Get the latency histogram : 100 bins of getBinMs() plus one
+    overflow bin for samples of 100 bins and beyond.
+  */
+  const std::vector<unsigned int> &getHistogram() const { return m_histogram; }
+  //! Get the width of one histogram bin, in ms.
+  double getBinMs() const { return m_binMs; }
+
+  //! Reset every counter and the histogram.
+  void reset()
+  {
+    m_nbSamples = 0;
+    m_lastMs = m_minMs = m_maxMs = m_totalMs = 0.;
+    m_histogram.assign(101, 0);
+  }
+
+private:
+  unsigned long m_nbSamples;
+  double m_lastMs;
+  double m_minMs;
+  double m_maxMs;
+  double m_totalMs;
+  double m_binMs;
+  std::vector<unsigned int> m_histogram;
+};
+
+#endif
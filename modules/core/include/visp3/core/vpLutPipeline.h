@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Composition of grey level point operations in one look up table.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpLutPipeline_h_
+#define __vpLutPipeline_h_
+
+#include <math.h>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+
+/*!
+  \class vpLutPipeline
+  \ingroup group_core_image
+
+  \brief Composition of grey level point operations (gain, offset, gamma,
+  inversion, custom tables) in one 256 entry look up table applied in a
+  single image pass.
+
+  A camera pipeline often chains several point operations per frame:
+  gain/offset from the auto exposure, a gamma correction, sometimes an
+  inversion or a custom response curve. Applying them one after the
+  other traverses the image once per stage; composing them in the table
+  keeps the whole chain at one vpImage::performLut() pass whatever its
+  length:
+
+  \code
+  vpLutPipeline lut;
+  lut.appendGain(1.8, -20.);   // exposure correction
+  lut.appendGamma(2.2);        // display gamma
+  lut.apply(I);                // one image pass, optionally threaded
+  \endcode
+
+  The stages are composed when appended (256 table reads per stage), so
+  changing a gain once per frame costs nothing measurable while the per
+  pixel work stays a single indexation.
+*/
+class vpLutPipeline
+{
+public:
+  //! Construct an identity pipeline.
+  vpLutPipeline()
+  {
+    reset();
+  }
+
+  //! Reset the pipeline to the identity mapping.
+  void reset()
+  {
+    for (unsigned int i = 0; i < 256; i++)
+      m_lut[i] = (unsigned char)i;
+  }
+
+  /*!
+    Append an affine stage \f$ v \mapsto gain \; v + offset \f$, the
+    result being saturated to [0, 255].
+  */
+  void appendGain(double gain, double offset = 0.)
+  {
+    for (unsigned int i = 0; i < 256; i++) {
+      double v = gain * m_lut[i] + offset;
+      m_lut[i] = vpMath::saturate<unsigned char>(v);
+    }
+  }
+
+  /*!
+    Append a gamma correction stage
+    \f$ v \mapsto 255 \, (v/255)^{1/\gamma} \f$.
+
+    \param gamma : Gamma value, greater than 0.
+  */
+  void appendGamma(double gamma)
+  {
+    for (unsigned int i = 0; i < 256; i++) {
+      double v = 255. * pow(m_lut[i] / 255., 1. / gamma);
+      m_lut[i] = vpMath::saturate<unsigned char>(v);
+    }
+  }
+
+  //! Append an inversion stage \f$ v \mapsto 255 - v \f$.
+  void appendInvert()
+  {
+    for (unsigned int i = 0; i < 256; i++)
+      m_lut[i] = (unsigned char)(255 - m_lut[i]);
+  }
+
+  /*!
+    Append a custom response curve given as a 256 entry table.
+  */
+  void append(const unsigned char (&lut)[256])
+  {
+    for (unsigned int i = 0; i < 256; i++)
+      m_lut[i] = lut[m_lut[i]];
+  }
+
+  /*!
+    Apply the composed pipeline on the image in one pass, the pixels
+    being spread over \e nbThreads threads by vpImage::performLut().
+  */
+  void apply(vpImage<unsigned char> &I, unsigned int nbThreads = 1) const
+  {
+    I.performLut(m_lut, nbThreads);
+  }
+
+  //! Direct access to the composed table.
+  const unsigned char (&getLut() const)[256] { return m_lut; }
+
+private:
+  unsigned char m_lut[256]; //!< Composed table of the whole pipeline
+};
+
+#endif
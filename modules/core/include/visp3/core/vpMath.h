@@ -170,6 +170,11 @@ class VISP_EXPORT vpMath
   static double mcosc(double cosx, double x) ;
   static double msinc(double sinx, double x) ;
 
+  // fast trigonometry for the tracking loops
+  static double fastCos(double x) ;
+  static double fastSin(double x) ;
+  static void fastSinCos(unsigned int n, const double *x, double *sinx, double *cosx) ;
+
   // sigmoid
   static inline double sigmoid(double x, double x0=0.,double x1=1., double n=12.);
 
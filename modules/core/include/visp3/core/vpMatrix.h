@@ -91,6 +91,11 @@ class vpForceTwistMatrix;
 */
 class VISP_EXPORT vpMatrix : public vpArray2D<double>
 {
+ private:
+  //! Number of rows of the left operand from which mult2Matrices()
+  //! spreads the product over the available threads.
+  static unsigned int parallelMultMinRows;
+
  public:
   /*!
     Method used to compute the determinant of a square matrix.
@@ -135,6 +140,12 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
    */
   vpMatrix(const vpArray2D<double>& A) : vpArray2D<double>(A) {};
 
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  vpMatrix(const vpMatrix &M) = default;
+  //! Move constructor that steals the storage of the \e M temporary.
+  vpMatrix(vpMatrix &&M) : vpArray2D<double>(std::move(M)) {};
+#endif
+
   //! Destructor (Memory de-allocation)
   virtual ~vpMatrix() {};
 
@@ -177,6 +188,15 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
   //@{
   vpMatrix &operator<<(double*);
   vpMatrix &operator=(const vpArray2D<double> &A);
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  vpMatrix &operator=(const vpMatrix &M) = default;
+  //! Move assignment that reuses the buffer of the \e M temporary.
+  vpMatrix &operator=(vpMatrix &&M)
+  {
+    vpArray2D<double>::operator=(std::move(M));
+    return *this;
+  }
+#endif
   vpMatrix &operator=(const double x);
   //@}
 
@@ -468,6 +488,12 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
   static void add2WeightedMatrices(const vpMatrix &A, const double &wA, const vpMatrix &B,const double &wB, vpMatrix &C);
   static void computeHLM(const vpMatrix &H, const double &alpha, vpMatrix &HLM);
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C);
+  static void setParallelMultMinRows(unsigned int min_rows);
+  static unsigned int getParallelMultMinRows();
+
+  // Direct solvers with SVD fallback on ill conditioned systems
+  void choleskySolve(const vpColVector &b, vpColVector &x) const;
+  void luSolve(const vpColVector &b, vpColVector &x) const;
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpRotationMatrix &C);
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpHomogeneousMatrix &C);
   static void mult2Matrices(const vpMatrix &A, const vpColVector &B, vpColVector &C);
@@ -568,6 +594,11 @@ class VISP_EXPORT vpMatrix : public vpArray2D<double>
   {
     return vpArray2D<double>::saveYAML(filename, M, header);
   }
+
+  static bool saveMatrixV2(const std::string &filename, const vpArray2D<double> &M, const char *header = "");
+  static bool loadMatrixV2(const std::string &filename, vpArray2D<double> &M, char *header = NULL);
+  static bool loadMatrixMmap(const std::string &filename, vpMatrix &M, void **map_addr, size_t *map_length);
+  static void unloadMatrixMmap(void *map_addr, size_t map_length);
   //@}
 
 
@@ -0,0 +1,292 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Fixed size matrix with stack storage dedicated to real-time control laws.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpMatrixT_h_
+#define __vpMatrixT_h_
+
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpColVector.h>
+
+/*!
+  \class vpMatrixT
+  \ingroup group_core_matrices
+
+  \brief Fixed size matrix with stack storage whose dimensions are known at
+  compile time.
+
+  Contrary to vpMatrix whose storage is allocated on the heap, a
+  vpMatrixT<Rows, Cols> holds its \e Rows x \e Cols elements in a plain
+  member array. No allocation occurs when a vpMatrixT is constructed,
+  copied or produced by an arithmetic operator, which makes this container
+  suitable for control laws that run at high rate where temporary vpMatrix
+  objects would introduce malloc/free jitter.
+
+  Any container of the vpArray2D<double> hierarchy with matching dimensions
+  (vpMatrix, vpHomogeneousMatrix, vpVelocityTwistMatrix, vpColVector, ...)
+  can be converted to and from a vpMatrixT:
+
+  \code
+  vpVelocityTwistMatrix cVe;
+  vpMatrixT<6, 6> V(cVe);        // no allocation
+  vpMatrixT<6, 6> J;             // robot jacobian
+  vpMatrixT<6, 6> VJ = V * J;    // no allocation
+  vpMatrix L = VJ.toMatrix();    // back to a dynamic container
+  \endcode
+*/
+template<unsigned int Rows, unsigned int Cols>
+class vpMatrixT
+{
+protected:
+  //! Elements stored in row major order, without any heap allocation.
+  double m[Rows*Cols];
+
+public:
+  /*!
+    Basic constructor. All the elements are set to zero.
+  */
+  vpMatrixT()
+  {
+    for (unsigned int i = 0; i < Rows*Cols; i++)
+      m[i] = 0.;
+  }
+
+  /*!
+    Construct a fixed size matrix from any container of the vpArray2D<double>
+    hierarchy (vpMatrix, vpHomogeneousMatrix, vpVelocityTwistMatrix,
+    vpColVector, ...).
+
+    \exception vpException::dimensionError : If the container dimensions
+    differ from \e Rows x \e Cols.
+  */
+  vpMatrixT(const vpArray2D<double> &A)
+  {
+    if (A.getRows() != Rows || A.getCols() != Cols) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot initialize a (%dx%d) fixed size matrix from a (%dx%d) array",
+                        Rows, Cols, A.getRows(), A.getCols())) ;
+    }
+    memcpy(m, A.data, Rows*Cols*sizeof(double));
+  }
+
+  //! Return the number of rows of the matrix.
+  inline unsigned int getRows() const { return Rows; }
+  //! Return the number of columns of the matrix.
+  inline unsigned int getCols() const { return Cols; }
+  //! Return the number of elements of the matrix.
+  inline unsigned int size() const { return Rows*Cols; }
+
+  //! Set element \f$A_{ij} = x\f$ using A[i][j] = x
+  inline double *operator[](unsigned int i) { return m + i*Cols; }
+  //! Get element \f$x = A_{ij}\f$ using x = A[i][j]
+  inline const double *operator[](unsigned int i) const { return m + i*Cols; }
+
+  //! Set all the elements of the matrix to \e x.
+  vpMatrixT<Rows, Cols> &operator=(double x)
+  {
+    for (unsigned int i = 0; i < Rows*Cols; i++)
+      m[i] = x;
+    return *this;
+  }
+
+  //! Copy the content of a container with matching dimensions.
+  vpMatrixT<Rows, Cols> &operator=(const vpArray2D<double> &A)
+  {
+    if (A.getRows() != Rows || A.getCols() != Cols) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot copy a (%dx%d) array in a (%dx%d) fixed size matrix",
+                        A.getRows(), A.getCols(), Rows, Cols)) ;
+    }
+    memcpy(m, A.data, Rows*Cols*sizeof(double));
+    return *this;
+  }
+
+  //! Operation C = A + B with A the current matrix.
+  vpMatrixT<Rows, Cols> operator+(const vpMatrixT<Rows, Cols> &B) const
+  {
+    vpMatrixT<Rows, Cols> C;
+    for (unsigned int i = 0; i < Rows*Cols; i++)
+      C.m[i] = m[i] + B.m[i];
+    return C;
+  }
+
+  //! Operation C = A - B with A the current matrix.
+  vpMatrixT<Rows, Cols> operator-(const vpMatrixT<Rows, Cols> &B) const
+  {
+    vpMatrixT<Rows, Cols> C;
+    for (unsigned int i = 0; i < Rows*Cols; i++)
+      C.m[i] = m[i] - B.m[i];
+    return C;
+  }
+
+  //! Operation C = A * x with A the current matrix and x a scalar.
+  vpMatrixT<Rows, Cols> operator*(double x) const
+  {
+    vpMatrixT<Rows, Cols> C;
+    for (unsigned int i = 0; i < Rows*Cols; i++)
+      C.m[i] = m[i] * x;
+    return C;
+  }
+
+  /*!
+    Operation C = A * B with A the current matrix. The three matrix sizes
+    are checked at compile time and the result is built on the stack.
+  */
+  template<unsigned int BCols>
+  vpMatrixT<Rows, BCols> operator*(const vpMatrixT<Cols, BCols> &B) const
+  {
+    vpMatrixT<Rows, BCols> C;
+    for (unsigned int i = 0; i < Rows; i++) {
+      const double *ai = m + i*Cols;
+      double *ci = C[i];
+      for (unsigned int j = 0; j < BCols; j++) {
+        double s = 0.;
+        for (unsigned int k = 0; k < Cols; k++)
+          s += ai[k] * B[k][j];
+        ci[j] = s;
+      }
+    }
+    return C;
+  }
+
+  /*!
+    Operation v = A * B with A the current matrix and B a column vector.
+
+    \exception vpException::dimensionError : If the vector size differs
+    from the matrix column number.
+  */
+  vpMatrixT<Rows, 1> operator*(const vpColVector &B) const
+  {
+    if (B.getRows() != Cols) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot multiply a (%dx%d) fixed size matrix by a (%d) column vector",
+                        Rows, Cols, B.getRows())) ;
+    }
+    vpMatrixT<Rows, 1> C;
+    for (unsigned int i = 0; i < Rows; i++) {
+      const double *ai = m + i*Cols;
+      double s = 0.;
+      for (unsigned int k = 0; k < Cols; k++)
+        s += ai[k] * B[k];
+      C[i][0] = s;
+    }
+    return C;
+  }
+
+  /*!
+    Operation v = A * B with A the current matrix and B a column vector.
+    The result is placed in \e C so that no allocation occurs when \e C
+    has already the right size.
+  */
+  void mult(const vpColVector &B, vpColVector &C) const
+  {
+    if (B.getRows() != Cols) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot multiply a (%dx%d) fixed size matrix by a (%d) column vector",
+                        Rows, Cols, B.getRows())) ;
+    }
+    if (C.getRows() != Rows)
+      C.resize(Rows);
+    for (unsigned int i = 0; i < Rows; i++) {
+      const double *ai = m + i*Cols;
+      double s = 0.;
+      for (unsigned int k = 0; k < Cols; k++)
+        s += ai[k] * B[k];
+      C[i] = s;
+    }
+  }
+
+  //! Return the transpose of the matrix, built on the stack.
+  vpMatrixT<Cols, Rows> t() const
+  {
+    vpMatrixT<Cols, Rows> C;
+    for (unsigned int i = 0; i < Rows; i++)
+      for (unsigned int j = 0; j < Cols; j++)
+        C[j][i] = m[i*Cols + j];
+    return C;
+  }
+
+  //! Convert the fixed size matrix in a vpMatrix with the same content.
+  vpMatrix toMatrix() const
+  {
+    vpMatrix M(Rows, Cols);
+    memcpy(M.data, m, Rows*Cols*sizeof(double));
+    return M;
+  }
+
+  /*!
+    Convert a single column fixed size matrix in a vpColVector with the
+    same content.
+
+    \exception vpException::dimensionError : If the matrix has more than
+    one column.
+  */
+  vpColVector toColVector() const
+  {
+    if (Cols != 1) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot convert a (%dx%d) fixed size matrix in a column vector",
+                        Rows, Cols)) ;
+    }
+    vpColVector v(Rows);
+    memcpy(v.data, m, Rows*sizeof(double));
+    return v;
+  }
+
+  /*!
+    \relates vpMatrixT
+    Writes the given fixed size matrix to the output stream with the same
+    layout than vpArray2D<double>.
+  */
+  friend std::ostream &operator<<(std::ostream &s, const vpMatrixT<Rows, Cols> &A)
+  {
+    std::ios_base::fmtflags original_flags = s.flags();
+    s.precision(10) ;
+    for (unsigned int i = 0; i < Rows; i++) {
+      for (unsigned int j = 0; j < Cols-1; j++)
+        s << A[i][j] << "  ";
+      s << A[i][Cols-1];
+      if (i < Rows-1)
+        s << std::endl;
+    }
+    s.flags(original_flags); // restore s to standard state
+    return s;
+  }
+};
+
+#endif
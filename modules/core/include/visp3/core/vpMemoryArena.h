@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bump allocator recycling the scratch memory of iterative loops.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpMemoryArena_h_
+#define __vpMemoryArena_h_
+
+#include <cstddef>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMemoryArena
+  \ingroup group_core_tools
+
+  \brief Bump allocator dedicated to the scratch buffers of iterative
+  loops.
+
+  A minimization or tracking loop typically allocates the same small
+  scratch buffers (permutation arrays, residue copies, jacobian blocks)
+  at every iteration. A vpMemoryArena hands out 64-byte aligned slices
+  of one growing block; reset() recycles the whole arena in constant
+  time at the top of the next iteration, so that after the first pass
+  the loop performs no allocation at all:
+
+  \code
+  vpMemoryArena arena;
+  while (!converged) {
+    arena.reset();                                  // O(1), keeps the memory
+    double *residues = arena.allocateDoubles(n);
+    unsigned int *perm = (unsigned int *)arena.allocate(n*sizeof(unsigned int));
+    // ... iteration body ...
+  }
+  \endcode
+
+  Allocations are never freed individually; the memory is released by
+  the destructor. An arena is not protected against concurrent use: one
+  instance is needed per thread.
+*/
+class VISP_EXPORT vpMemoryArena
+{
+public:
+  explicit vpMemoryArena(size_t capacity = 4096);
+  virtual ~vpMemoryArena();
+
+  void *allocate(size_t nbytes);
+  double *allocateDoubles(unsigned int n);
+
+  void reset();
+
+  //! Return the number of bytes handed out since the last reset().
+  inline size_t getUsed() const { return m_used; }
+  //! Return the capacity in bytes of the current block.
+  inline size_t getCapacity() const { return m_capacity; }
+
+private:
+  // An arena owns raw memory: copying it makes no sense
+  vpMemoryArena(const vpMemoryArena &);
+  vpMemoryArena &operator=(const vpMemoryArena &);
+
+  unsigned char *m_block; //!< Current memory block, 64-byte aligned
+  size_t m_capacity;      //!< Size of the current block
+  size_t m_used;          //!< Bytes handed out from the current block
+  size_t m_high_water;    //!< Largest total usage seen, drives the regrowth
+  size_t m_retired_used;  //!< Bytes handed out from the retired blocks
+  //! Blocks exhausted in the middle of an iteration, kept alive until
+  //! reset() so that the slices they handed out stay valid
+  std::vector<unsigned char *> m_retired;
+};
+
+#endif
@@ -71,6 +71,10 @@ public:
                                const vpCircle &circle, vpImagePoint &center,
                                double &mu20_p, double &mu11_p, double &mu02_p);
 
+    static void convertPoints(const vpCameraParameters &cam,
+                              unsigned int npoints,
+                              const double *x, const double *y,
+                              double *u, double *v) ;
     static void convertLine(const vpCameraParameters &cam,
                             const double &rho_m, const double &theta_m,
                             double &rho_p, double &theta_p) ;
@@ -242,6 +246,28 @@ public:
     iP.set_v( cam.v0 + cam.py*y*r2 );
   }
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
+  /*!
+    Compile-time selected conversion, without the runtime projection
+    model switch : the \e vpCamPerspective overload converts with the
+    undistorted model, the \e vpCamDistorted one with the distorted
+    model, whatever the model carried by \e cam.
+  */
+  static inline void convertPoint(vpCamPerspective, const vpCameraParameters &cam,
+                                  const double &x, const double &y, double &u, double &v)
+  { convertPointWithoutDistortion(cam, x, y, u, v); }
+  //! See convertPoint(vpCamPerspective, const vpCameraParameters &, const double &, const double &, double &, double &).
+  static inline void convertPoint(vpCamDistorted, const vpCameraParameters &cam,
+                                  const double &x, const double &y, double &u, double &v)
+  { convertPointWithDistortion(cam, x, y, u, v); }
+  //! Compile-time selected conversion filling a vpImagePoint, see the scalar overload.
+  static inline void convertPoint(vpCamPerspective, const vpCameraParameters &cam,
+                                  const double &x, const double &y, vpImagePoint &iP)
+  { convertPointWithoutDistortion(cam, x, y, iP); }
+  //! Compile-time selected conversion filling a vpImagePoint, see the scalar overload.
+  static inline void convertPoint(vpCamDistorted, const vpCameraParameters &cam,
+                                  const double &x, const double &y, vpImagePoint &iP)
+  { convertPointWithDistortion(cam, x, y, iP); }
+
 } ;
 
 #endif
@@ -44,6 +44,7 @@
 #include <visp3/core/vpImage.h>
 
 #include <map>
+#include <vector>
 #include <iostream>
 #include <cstring>
 
@@ -146,6 +147,8 @@ class VISP_EXPORT vpMomentDatabase{
         vpMoment& get_first(){return *(moments.begin()->second);}
 
         virtual void updateAll(vpMomentObject& object);
+
+        void updateRequired(vpMomentObject& object, const std::vector<const char*> &names);
         //@}
 
         friend class vpMoment;
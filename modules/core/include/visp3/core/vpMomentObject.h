@@ -241,6 +241,9 @@ public:
   void fromImage(const vpImage<unsigned char>& image, const vpCameraParameters& cam, vpCameraImgBckGrndType bg_type, bool normalize_with_pix_size = true); // Photometric version
 
   void fromVector(std::vector<vpPoint>& points);
+
+  void updatePoint(double x, double y, double w);
+  void updateRun(double y, double x0, double dx, unsigned int nb, double w);
   const std::vector<double>& get() const;
   double get(unsigned int i,unsigned int j) const;
 
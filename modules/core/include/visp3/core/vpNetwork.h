@@ -49,6 +49,7 @@
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
 #  include <unistd.h> 
 #  include <sys/socket.h>
+#  include <sys/uio.h>
 #  include <netinet/in.h>
 #  include <arpa/inet.h>
 #  include <netdb.h>
@@ -144,18 +145,38 @@ protected:
   
   bool                    verboseMode;
   
-private:
+protected:
   
   std::vector<int>  _handleRequests();
   int               _handleFirstRequest();
   
+private:
+  
   void              _receiveRequest();
   void              _receiveRequestFrom(const unsigned int &receptorEmitting);
   int               _receiveRequestOnce();
   int               _receiveRequestOnceFrom(const unsigned int &receptorEmitting);
   
+  int               _receiveAll(const unsigned int &receptor, void *buffer, const unsigned int &size);
+  int               _selectOnReceptor(const unsigned int &receptor);
+  
 public:
 
+  /*!
+    Caller-owned buffer segment used by the binary scatter-gather messaging
+    functions. The network layer never copies the data it points to.
+    
+    \sa vpNetwork::sendBinaryRequestTo()
+    \sa vpNetwork::receiveBinaryRequestFrom()
+  */
+  struct vpNetworkBuffer{
+    void          *data;
+    unsigned int  size;
+    
+    vpNetworkBuffer() : data(NULL), size(0) {}
+    vpNetworkBuffer(void *buffer, const unsigned int &bufferSize) : data(buffer), size(bufferSize) {}
+  };
+
                     vpNetwork();
   virtual           ~vpNetwork();
   
@@ -212,6 +233,12 @@ public:
   int               sendRequest(vpRequest &req);
   int               sendRequestTo(vpRequest &req, const unsigned int &dest);
   
+  int               sendBinaryRequest(const char *id, const vpNetworkBuffer *buffers, const unsigned int &nbBuffers);
+  int               sendBinaryRequestTo(const char *id, const vpNetworkBuffer *buffers, const unsigned int &nbBuffers, const unsigned int &dest);
+  
+  int               receiveBinaryRequest(std::string &id, vpNetworkBuffer *buffers, const unsigned int &nbBuffers);
+  int               receiveBinaryRequestFrom(std::string &id, vpNetworkBuffer *buffers, const unsigned int &nbBuffers, const unsigned int &receptorEmitting);
+  
   int               sendAndEncodeRequest(vpRequest &req);
   int               sendAndEncodeRequestTo(vpRequest &req, const unsigned int &dest);
   
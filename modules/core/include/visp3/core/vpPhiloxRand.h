@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Counter-based random number generation.
+ *
+ *****************************************************************************/
+
+#ifndef vpPhiloxRand_hh
+#define vpPhiloxRand_hh
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpPhiloxRand
+
+  \ingroup group_core_random
+  \brief Counter-based random number generator (Philox 4x32-10) with bulk
+  array generation and reproducible parallel streams.
+
+  Contrary to vpUniRand, the generator is stateless up to a counter : the
+  value drawn only depends on the seed, the stream and the position in the
+  sequence, so that several generators built with the same seed but
+  different streams produce independent and reproducible sequences whatever
+  the thread interleaving. This is the generator used by the parallelized
+  samplers (e.g. RANSAC), one stream per hypothesis or per thread.
+
+  fill() produces uniform doubles in bulk and fillGaussian() normal
+  variates through a ziggurat fed by the same bulk generation. Each stream
+  delivers \f$2^{34}\f$ values before wrapping.
+
+  The following example draws the same third value twice:
+\code
+#include <visp3/core/vpPhiloxRand.h>
+
+int main()
+{
+  vpPhiloxRand r1(42, 0);
+  double a=r1(), b=r1(), c=r1();
+
+  vpPhiloxRand r2(42, 0);
+  r2.setCounter(2);
+  double c2 = r2(); // c2 == c
+}
+\endcode
+
+  \sa vpUniRand
+  \sa vpGaussRand
+ */
+class VISP_EXPORT vpPhiloxRand
+{
+public:
+  vpPhiloxRand(const unsigned int seed = 0, const unsigned int stream = 0)
+    : m_key0(seed), m_key1(0x9E3779B9u ^ stream), m_counterLo(0), m_counterHi(stream),
+      m_buffer(), m_bufferIndex(4)
+  {
+    m_buffer[0] = m_buffer[1] = m_buffer[2] = m_buffer[3] = 0;
+  }
+
+  virtual ~vpPhiloxRand() {}
+
+  void fill(double *values, const unsigned int &n);
+  void fill(unsigned int *values, const unsigned int &n);
+  void fillGaussian(double *values, const unsigned int &n,
+                    const double &mean = 0., const double &sigma = 1.);
+
+  /*!
+    Get the seed of the generator.
+    \return Seed given to the constructor.
+  */
+  unsigned int getSeed() const { return m_key0; }
+
+  //! Operator that allows to get a uniform random value in (0, 1).
+  double operator()()
+  {
+    return (next() + 0.5) * 2.328306436538696e-10; // 2^-32
+  }
+
+  /*!
+    Move the generator to the \e n-th position of its sequence, as if \e n
+    values had been drawn since construction.
+
+    \param n : Position in the sequence.
+  */
+  void setCounter(const unsigned int &n)
+  {
+    m_counterLo = n / 4;
+    m_bufferIndex = 4;
+    //Consume the remainder inside the block
+    for (unsigned int i = 0; i < n % 4; i++)
+      next();
+  }
+
+private:
+  unsigned int next();
+  void nextBlock(const unsigned int &counterLo, const unsigned int &counterHi,
+                 unsigned int output[4]) const;
+
+  unsigned int m_key0;
+  unsigned int m_key1;
+  unsigned int m_counterLo; //!< Position of the next 4-value block
+  unsigned int m_counterHi; //!< Stream identifier
+  unsigned int m_buffer[4];
+  unsigned int m_bufferIndex;
+};
+
+#endif
@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Software-pipelined execution of multi-stage per-frame processing.
+ *
+ *****************************************************************************/
+
+#ifndef __vpPipeline_h_
+#define __vpPipeline_h_
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpMutex.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/*!
+   \class vpPipeline
+
+   \ingroup group_core_threading
+
+   \brief Software-pipelined execution of the stages of a per-frame vision
+   pipeline declared with their dependencies.
+
+   Each stage (e.g. capture, convert, track, servo, display) runs on its
+   own worker and processes the frames in order; independent stages of the
+   same frame run concurrently and stage \e n of frame \e k overlaps stage
+   \e n-1 of frame \e k+1, so that the throughput is set by the slowest
+   stage instead of the sum of the stages. The number of frames in flight
+   is bounded, with a configurable policy when a new frame arrives while
+   the pipeline is full, and every stage accumulates its latency
+   statistics.
+
+   The pipeline only schedules caller-provided frame tokens: the stage
+   functions receive the token and are responsible for the data it points
+   to, typically a per-frame structure holding the image and the
+   intermediate results.
+
+   \code
+#include <visp3/core/vpPipeline.h>
+
+void capture(void *user_data, void *frame) { ... }
+void track(void *user_data, void *frame)   { ... }
+void display(void *user_data, void *frame) { ... }
+
+int main()
+{
+  vpPipeline pipeline;
+  unsigned int s0 = pipeline.addStage("capture", capture, NULL);
+  std::vector<unsigned int> deps(1, s0);
+  unsigned int s1 = pipeline.addStage("track", track, NULL, deps);
+  deps[0] = s1;
+  pipeline.addStage("display", display, NULL, deps);
+
+  pipeline.setDropPolicy(vpPipeline::DROP_OLDEST);
+  pipeline.start();
+
+  for ( ; ; ) {
+    pipeline.submitFrame(getFreeFrameBuffer());
+    void *frame;
+    while (pipeline.getCompletedFrame(frame))
+      releaseFrameBuffer(frame);
+  }
+}
+   \endcode
+
+   \sa vpThreadPool
+   \sa vpThread
+*/
+class VISP_EXPORT vpPipeline
+{
+public:
+  //! Signature of a stage, called once per frame with the submitted token.
+  typedef void (*vpStageFn)(void *user_data, void *frame);
+
+  //! Policy applied when a frame is submitted while the pipeline is full.
+  typedef enum {
+    BLOCK_WHEN_FULL, /*!< submitFrame() waits for a slot (default). */
+    DROP_OLDEST,     /*!< The oldest frame not processed yet is dropped. */
+    DROP_NEWEST      /*!< The submitted frame is rejected. */
+  } vpDropPolicy;
+
+  //! Latency statistics of a stage.
+  struct vpStageStats
+  {
+    unsigned int nbFrames; //!< Number of frames processed by the stage.
+    double lastMs;         //!< Latency of the last frame, in ms.
+    double meanMs;         //!< Mean latency, in ms.
+    double maxMs;          //!< Worst latency, in ms.
+
+    vpStageStats() : nbFrames(0), lastMs(0.), meanMs(0.), maxMs(0.) {}
+  };
+
+  vpPipeline();
+  virtual ~vpPipeline();
+
+  unsigned int addStage(const std::string &name, vpStageFn fn, void *user_data);
+  unsigned int addStage(const std::string &name, vpStageFn fn, void *user_data,
+                        const std::vector<unsigned int> &dependencies);
+
+  void flush();
+
+  bool getCompletedFrame(void *&frame, const bool &waitFrame = false);
+
+  /*!
+    Get the number of frames dropped since start(), under the DROP_OLDEST
+    and DROP_NEWEST policies.
+
+    \return Number of dropped frames.
+  */
+  unsigned int getNbDroppedFrames() const { return m_nbDropped; }
+
+  /*!
+    Get the number of declared stages.
+
+    \return Number of stages.
+  */
+  unsigned int getNbStages() const { return (unsigned int)m_stages.size(); }
+
+  std::string getStageName(const unsigned int &stage) const;
+  vpStageStats getStageStats(const unsigned int &stage);
+
+  /*!
+    Change the bound on the number of frames processed concurrently.
+    Has to be called before start(). Initially this value is set to 3.
+
+    \param nb : Maximum number of frames in flight, at least 1.
+  */
+  void setMaxFramesInFlight(const unsigned int &nb) { m_maxInFlight = (nb == 0 ? 1 : nb); }
+
+  /*!
+    Change the policy applied when a frame is submitted while the maximum
+    number of frames is in flight. Initially set to BLOCK_WHEN_FULL.
+
+    \param policy : New policy.
+  */
+  void setDropPolicy(const vpDropPolicy &policy) { m_dropPolicy = policy; }
+
+  void start();
+  void stop();
+
+  bool submitFrame(void *frame);
+
+private:
+  //State of a frame traveling through the stages
+  struct vpFrameState
+  {
+    void *frame;
+    unsigned int doneMask;
+    unsigned int runningMask;
+
+    vpFrameState() : frame(NULL), doneMask(0), runningMask(0) {}
+  };
+
+  //Description of a declared stage
+  struct vpStage
+  {
+    std::string name;
+    vpStageFn fn;
+    void *user_data;
+    unsigned int depMask;
+    vpStageStats stats;
+    double totalMs;
+    vpThread *worker;
+
+    vpStage() : name(), fn(NULL), user_data(NULL), depMask(0), stats(), totalMs(0.), worker(NULL) {}
+  };
+
+  //Copy not supported
+  vpPipeline(const vpPipeline &);
+  vpPipeline &operator=(const vpPipeline &);
+
+  static vpThread::Return stageLoop(vpThread::Args args);
+  void runStage(const unsigned int &stage);
+  bool findRunnableFrame(const unsigned int &stage, unsigned int &frameIndex);
+
+  void lockGraph();
+  void unlockGraph();
+  void waitGraph();
+  void signalGraph();
+
+  std::vector<vpStage> m_stages;
+  std::deque<vpFrameState *> m_window;     //frames in flight, oldest first
+  std::deque<void *> m_completed;          //tokens of the frames that left the pipeline
+  unsigned int m_maxInFlight;
+  vpDropPolicy m_dropPolicy;
+  volatile unsigned int m_nbDropped;
+  volatile bool m_started;
+  volatile bool m_stop;
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_t m_graphMutex;
+  pthread_cond_t m_graphCond;
+#else
+  vpMutex m_graphMutex;
+#endif
+
+  //Worker bootstrap argument
+  struct vpStageLoopArgs
+  {
+    vpPipeline *pipeline;
+    unsigned int stage;
+  };
+  std::vector<vpStageLoopArgs> m_loopArgs;
+};
+
+#endif
+#endif
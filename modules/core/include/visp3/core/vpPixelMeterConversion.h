@@ -240,6 +240,10 @@ convertPointWithDistortion(
 }
 
   //! line coordinates conversion (rho,theta)
+  static void convertPoints(const vpCameraParameters &cam,
+                            unsigned int npoints,
+                            const double *u, const double *v,
+                            double *x, double *y) ;
   static void convertLine(const vpCameraParameters &cam,
 		      const double &rho_p, const double &theta_p,
 		      double &rho_m, double &theta_m) ;
@@ -249,6 +253,20 @@ convertPointWithDistortion(
 			    unsigned int order,
 			    const vpMatrix &moment_pixel,
 			    vpMatrix &moment_meter) ;
+  /*!
+    Compile-time selected conversion, without the runtime projection
+    model switch : the \e vpCamPerspective overload converts with the
+    undistorted model, the \e vpCamDistorted one with the distorted
+    model, whatever the model carried by \e cam.
+  */
+  static inline void convertPoint(vpCamPerspective, const vpCameraParameters &cam,
+                                  const double &u, const double &v, double &x, double &y)
+  { convertPointWithoutDistortion(cam, u, v, x, y); }
+  //! See convertPoint(vpCamPerspective, const vpCameraParameters &, const double &, const double &, double &, double &).
+  static inline void convertPoint(vpCamDistorted, const vpCameraParameters &cam,
+                                  const double &u, const double &v, double &x, double &y)
+  { convertPointWithDistortion(cam, u, v, x, y); }
+
 } ;
 
 #endif
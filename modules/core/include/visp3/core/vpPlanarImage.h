@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Planar (structure of arrays) color image.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpPlanarImage_h_
+#define __vpPlanarImage_h_
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
+
+/*!
+  \class vpPlanarImage
+  \ingroup group_core_image
+
+  \brief Color image stored as separate R, G, B planes instead of the
+  interleaved vpRGBa layout.
+
+  Per-channel processing of a vpImage<vpRGBa> strides over four bytes
+  per pixel, which wastes three quarters of each cache line and defeats
+  the vectorized grey level kernels. This container keeps each channel
+  in its own contiguous vpImage<unsigned char>, so that any existing
+  grey level algorithm (filters, histogram, morphology, moving edges)
+  runs unchanged on a channel at full speed:
+
+  \code
+  vpPlanarImage P;
+  P.buildFrom(Icolor);                       // deinterleave once
+  vpImageFilter::sobelGradient(P.G, gx, gy); // grey kernels on a channel
+  P.toRGBa(Icolor);                          // back to interleaved
+  \endcode
+
+  The conversions rely on vpImageConvert::split() and merge(); the
+  planes are public members so that they can be processed in place.
+*/
+class VISP_EXPORT vpPlanarImage
+{
+public:
+  vpImage<unsigned char> R; //!< Red plane
+  vpImage<unsigned char> G; //!< Green plane
+  vpImage<unsigned char> B; //!< Blue plane
+
+  vpPlanarImage() : R(), G(), B() {}
+
+  /*!
+    Construct the planes from an interleaved color image.
+  */
+  explicit vpPlanarImage(const vpImage<vpRGBa> &I) : R(), G(), B()
+  {
+    buildFrom(I);
+  }
+
+  /*!
+    Deinterleave the color image in the three planes. The plane buffers
+    are reused when the size is unchanged.
+  */
+  void buildFrom(const vpImage<vpRGBa> &I)
+  {
+    vpImageConvert::split(I, &R, &G, &B);
+  }
+
+  /*!
+    Interleave the three planes back in a color image, the alpha
+    channel being set to its default value.
+  */
+  void toRGBa(vpImage<vpRGBa> &I) const
+  {
+    vpImageConvert::merge(&R, &G, &B, NULL, I);
+  }
+
+  /*!
+    Set the size of the three planes without initializing the pixels.
+  */
+  void resize(unsigned int height, unsigned int width)
+  {
+    R.resize(height, width);
+    G.resize(height, width);
+    B.resize(height, width);
+  }
+
+  //! Return the height of the planes.
+  inline unsigned int getHeight() const { return R.getHeight(); }
+  //! Return the width of the planes.
+  inline unsigned int getWidth() const { return R.getWidth(); }
+};
+
+#endif
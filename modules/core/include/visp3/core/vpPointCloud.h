@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Batched frame change and perspective projection of 3D point sets.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpPointCloud_h_
+#define __vpPointCloud_h_
+
+#include <vector>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+
+/*!
+  \class vpPointCloud
+  \ingroup group_core_geometry
+
+  \brief Set of 3D points stored as separate coordinate arrays allowing
+  batched frame changes and perspective projections.
+
+  vpPoint::changeFrame() and vpPoint::projection() process one point at a
+  time through the virtual vpForwardProjection interface. When thousands
+  of points of a CAD model or of a keypoint cloud are transformed every
+  frame, the per-point virtual dispatch and the scattered memory layout
+  dominate the cost. This container keeps the object frame, camera frame
+  and image plane coordinates in separate contiguous arrays and performs
+  the transformation of the whole set in one pass over each array, which
+  the compiler can vectorize:
+
+  \code
+  vpPointCloud cloud(model.size());
+  for (unsigned int i = 0; i < model.size(); i++)
+    cloud.setPoint(i, model[i].get_oX(), model[i].get_oY(), model[i].get_oZ());
+
+  cloud.project(cMo);  // all points: object frame -> camera frame -> image plane
+
+  double x = cloud.get_x(0), y = cloud.get_y(0);
+  \endcode
+
+  The object frame coordinates are considered affine (unit fourth
+  homogeneous coordinate), which is the way vpPoint is used by the
+  trackers and the pose estimators.
+*/
+class VISP_EXPORT vpPointCloud
+{
+public:
+  vpPointCloud();
+  explicit vpPointCloud(unsigned int npoints);
+  virtual ~vpPointCloud();
+
+  void resize(unsigned int npoints);
+  //! Return the number of points of the set.
+  inline unsigned int size() const { return m_npoints; }
+
+  void setPoint(unsigned int i, double oX, double oY, double oZ);
+  void setPoints(const std::vector<vpPoint> &points);
+
+  void changeFrame(const vpHomogeneousMatrix &cMo);
+  void projection();
+  void project(const vpHomogeneousMatrix &cMo);
+
+  void getPoint(unsigned int i, vpPoint &point) const;
+
+  //! Get the X coordinate of point \e i in the object frame.
+  inline double get_oX(unsigned int i) const { return m_oX[i]; }
+  //! Get the Y coordinate of point \e i in the object frame.
+  inline double get_oY(unsigned int i) const { return m_oY[i]; }
+  //! Get the Z coordinate of point \e i in the object frame.
+  inline double get_oZ(unsigned int i) const { return m_oZ[i]; }
+  //! Get the X coordinate of point \e i in the camera frame, set by changeFrame().
+  inline double get_X(unsigned int i) const { return m_X[i]; }
+  //! Get the Y coordinate of point \e i in the camera frame, set by changeFrame().
+  inline double get_Y(unsigned int i) const { return m_Y[i]; }
+  //! Get the Z coordinate of point \e i in the camera frame, set by changeFrame().
+  inline double get_Z(unsigned int i) const { return m_Z[i]; }
+  //! Get the x coordinate of point \e i in the image plane, set by projection().
+  inline double get_x(unsigned int i) const { return m_x[i]; }
+  //! Get the y coordinate of point \e i in the image plane, set by projection().
+  inline double get_y(unsigned int i) const { return m_y[i]; }
+
+  //! Direct access to the camera frame depth array, useful for batched
+  //! visibility tests.
+  inline const std::vector<double> &get_Z() const { return m_Z; }
+  //! Direct access to the image plane x coordinate array.
+  inline const std::vector<double> &get_x() const { return m_x; }
+  //! Direct access to the image plane y coordinate array.
+  inline const std::vector<double> &get_y() const { return m_y; }
+
+private:
+  unsigned int m_npoints;     //!< Number of points of the set
+  std::vector<double> m_oX;   //!< X coordinates in the object frame
+  std::vector<double> m_oY;   //!< Y coordinates in the object frame
+  std::vector<double> m_oZ;   //!< Z coordinates in the object frame
+  std::vector<double> m_X;    //!< X coordinates in the camera frame
+  std::vector<double> m_Y;    //!< Y coordinates in the camera frame
+  std::vector<double> m_Z;    //!< Z coordinates in the camera frame
+  std::vector<double> m_x;    //!< x coordinates in the image plane
+  std::vector<double> m_y;    //!< y coordinates in the image plane
+};
+
+#endif
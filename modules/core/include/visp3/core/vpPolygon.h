@@ -127,6 +127,7 @@ class VISP_EXPORT vpPolygon
     void initClick(const vpImage<unsigned char>& I);
     
     bool isInside(const vpImagePoint &iP);
+    void isInside(const std::vector<vpImagePoint> &ips, std::vector<bool> &results) const;
 
     void display(const vpImage<unsigned char>& I, const vpColor& color, unsigned int thickness=1) const;
     
@@ -88,7 +88,23 @@ public:
   //! Distance for near clipping
   double distFarClip;
   
-private:            
+private:
+  //! SoA copies of the camera frame vertices used by the batched plane pre-pass of computePolygonClipped()
+  std::vector<double> clipX;
+  std::vector<double> clipY;
+  std::vector<double> clipZ;
+    //! Edge clipping scratch kept across frames so the per-frame work never reallocates
+    std::vector<std::pair<vpPoint,unsigned int> > m_clipScratch1;
+    std::vector<std::pair<vpPoint,unsigned int> > m_clipScratch2;
+  //! Pose used to compute the current content of polyClipped
+  vpHomogeneousMatrix clipCachedPose;
+  //! True when polyClipped matches clipCachedPose
+  bool hasClipCachedPose;
+  //! Pose displacement (in meter and radian) under which the previous clipping result is reused (0: always recompute)
+  double clipCacheTolerance;
+  //! Pose given to the last call to changeFrame()
+  vpHomogeneousMatrix lastChangeFramePose;
+
             bool          getClippedPointsFovGeneric(const vpPoint &p1, const vpPoint &p2,
                                            vpPoint &p1Clipped, vpPoint &p2Clipped, 
                                            unsigned int &p1ClippedInfo, unsigned int &p2ClippedInfo,
@@ -118,8 +134,15 @@ public:
     
     \return Clipping flags.
   */          
-  inline    unsigned int  getClipping() const { return clippingFlag; } 
-  
+  inline    unsigned int  getClipping() const { return clippingFlag; }
+
+  /*!
+    Get the pose displacement under which the previous clipping result is reused.
+
+    \return Pose tolerance (in meter and radian).
+  */
+  inline    double        getClippedPolygonCacheTolerance() const { return clipCacheTolerance; }
+
    /*!
     Get the far distance for clipping.
     
@@ -186,14 +209,24 @@ public:
     
     \param flags : New clipping flags.
   */
-  inline    void          setClipping(const unsigned int &flags) { clippingFlag = flags; }
-  
+  inline    void          setClipping(const unsigned int &flags) { clippingFlag = flags; hasClipCachedPose = false; }
+
+  /*!
+    Set the pose displacement under which the result of the previous call to
+    computePolygonClipped() is reused instead of being recomputed. The tolerance
+    applies both to the translation (in meter) and to the rotation (in radian)
+    of the displacement since the pose used for the last effective clipping.
+
+    \param tol : Pose tolerance (0 to always recompute).
+  */
+  inline    void          setClippedPolygonCacheTolerance(const double &tol) { clipCacheTolerance = tol; }
+
   /*!
     Set the far distance for clipping.
-    
+
     \param dist : Far clipping value.
   */
-  inline    void          setFarClippingDistance(const double &dist) { distFarClip = dist; clippingFlag = (clippingFlag | vpPolygon3D::FAR_CLIPPING);}
+  inline    void          setFarClippingDistance(const double &dist) { distFarClip = dist; clippingFlag = (clippingFlag | vpPolygon3D::FAR_CLIPPING); hasClipCachedPose = false;}
 
   virtual        void     setNbPoint(const unsigned int nb)  ;
   
@@ -202,7 +235,7 @@ public:
     
     \param dist : Near clipping value.
   */
-  inline    void          setNearClippingDistance(const double &dist) { distNearClip = dist; clippingFlag = (clippingFlag | vpPolygon3D::NEAR_CLIPPING);}
+  inline    void          setNearClippingDistance(const double &dist) { distNearClip = dist; clippingFlag = (clippingFlag | vpPolygon3D::NEAR_CLIPPING); hasClipCachedPose = false;}
   
 public:
   static   void           getClippedPolygon(const std::vector<vpPoint> &ptIn, std::vector<vpPoint> &ptOut, const vpHomogeneousMatrix &cMo,
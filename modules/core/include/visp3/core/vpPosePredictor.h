@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Inter-frame pose prediction used to warm start the trackers.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpPosePredictor_h_
+#define __vpPosePredictor_h_
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpColVector.h>
+
+/*!
+  \class vpPosePredictor
+  \ingroup group_core_tracking
+
+  \brief Constant velocity pose prediction between two frames.
+
+  The trackers start each frame from the pose estimated on the previous
+  one, which forces large search ranges when the motion is fast. This
+  class extrapolates the pose one frame ahead from the velocity twist
+  observed between the two last estimated poses; the prediction can seed
+  the tracker so that the search starts closer to the solution:
+
+  \code
+  vpPosePredictor predictor;
+  tracker.setPosePredictor(&predictor);    // model-based tracker
+  while (grab(I)) {
+    tracker.track(I);                      // seeded once the predictor is ready
+  }
+  \endcode
+
+  update() and predict() are virtual: a predictor filtering the velocity,
+  typically with vpLinearKalmanFilterInstantiation, only has to derive
+  this class and is plugged in the trackers the same way.
+*/
+class VISP_EXPORT vpPosePredictor
+{
+public:
+  vpPosePredictor();
+  virtual ~vpPosePredictor();
+
+  virtual void reset();
+  virtual void update(const vpHomogeneousMatrix &cMo);
+  virtual vpHomogeneousMatrix predict() const;
+
+  //! Return true once two poses were fed, ie when a velocity is available.
+  inline bool isReady() const { return m_nbUpdates > 1; }
+
+  //! Return the velocity twist observed between the two last poses.
+  inline const vpColVector &getVelocity() const { return m_v; }
+
+protected:
+  vpHomogeneousMatrix m_cMo;    //!< Last estimated pose
+  vpColVector m_v;              //!< Velocity twist between the two last poses
+  unsigned int m_nbUpdates;     //!< Number of poses fed since the last reset
+};
+
+#endif
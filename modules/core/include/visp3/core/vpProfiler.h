@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Scoped instrumentation of the hot paths.
+ *
+ *****************************************************************************/
+
+#ifndef __vpProfiler_h_
+#define __vpProfiler_h_
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpTime.h>
+
+#include <string>
+
+/*!
+  \class vpProfiler
+
+  \ingroup group_core_time
+
+  \brief Scoped instrumentation of the processing phases, with
+  chrome://tracing export.
+
+  The annotated scopes (see VP_PROFILE_SCOPE()) record begin/end
+  timestamps into per-thread buffers written without any lock, so that the
+  instrumentation can stay in production code : while recording is
+  disabled (the default) an annotation costs one test, and while enabled
+  about a hundred nanoseconds. saveTrace() dumps every recorded event as a
+  chrome://tracing JSON file, to be loaded in the chrome://tracing or
+  https://ui.perfetto.dev viewers.
+
+  \code
+#include <visp3/core/vpProfiler.h>
+
+void track()
+{
+  VP_PROFILE_SCOPE("track");
+  // ...
+}
+
+int main()
+{
+  vpProfiler::setEnabled(true);
+  for (int i = 0; i < 100; i++)
+    track();
+  vpProfiler::saveTrace("/tmp/trace.json");
+}
+  \endcode
+
+  Defining VISP_PROFILING_DISABLE before including this header compiles
+  the annotations out entirely.
+
+  \sa vpTime
+*/
+class VISP_EXPORT vpProfiler
+{
+public:
+  //! One recorded scope. The name has to point to a string literal.
+  struct vpEvent
+  {
+    const char *name;
+    double beginUs;
+    double endUs;
+  };
+
+  /*!
+    Indicates if the events are being recorded.
+
+    \return True when recording.
+  */
+  static bool isEnabled() { return s_enabled; }
+
+  static void record(const char *name, const double &beginUs, const double &endUs);
+
+  static void reset();
+
+  static bool saveTrace(const std::string &filename);
+
+  /*!
+    Start or stop the recording of the annotated scopes.
+
+    \param enable : True to record, false to make the annotations inert.
+  */
+  static void setEnabled(const bool &enable) { s_enabled = enable; }
+
+  static unsigned int getNbDroppedEvents();
+
+private:
+  static volatile bool s_enabled;
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  RAII helper of VP_PROFILE_SCOPE() : records the time spent between its
+  construction and its destruction.
+*/
+class vpProfilerScope
+{
+public:
+  vpProfilerScope(const char *name) : m_name(name), m_beginUs(0.)
+  {
+    if (vpProfiler::isEnabled())
+      m_beginUs = vpTime::measureTimeMicros();
+  }
+
+  ~vpProfilerScope()
+  {
+    if (m_beginUs != 0.)
+      vpProfiler::record(m_name, m_beginUs, vpTime::measureTimeMicros());
+  }
+
+private:
+  const char *m_name;
+  double m_beginUs;
+};
+#endif
+
+#ifndef VISP_PROFILING_DISABLE
+//Helpers building a unique variable name per line
+#  define VP_PROFILE_CONCAT_(a, b) a##b
+#  define VP_PROFILE_CONCAT(a, b) VP_PROFILE_CONCAT_(a, b)
+/*!
+  Record the time spent in the enclosing scope under \e name (a string
+  literal), when vpProfiler recording is enabled.
+*/
+#  define VP_PROFILE_SCOPE(name) vpProfilerScope VP_PROFILE_CONCAT(vpProfilerScope_, __LINE__)(name)
+#else
+#  define VP_PROFILE_SCOPE(name)
+#endif
+
+#endif
@@ -51,6 +51,7 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpRotationMatrix.h>
 #include <visp3/core/vpRotationVector.h>
+#include <visp3/core/vpTranslationVector.h>
 #include <visp3/core/vpThetaUVector.h>
 
 
@@ -115,6 +116,17 @@ public:
   vpQuaternionVector inverse() const;
   double magnitude() const;
   void normalize();
+
+  vpTranslationVector rotate(const vpTranslationVector &t) const;
+
+  static void composePose(const vpQuaternionVector &q1, const vpTranslationVector &t1,
+                          const vpQuaternionVector &q2, const vpTranslationVector &t2,
+                          vpQuaternionVector &q12, vpTranslationVector &t12);
+
+  static vpQuaternionVector slerp(const vpQuaternionVector &q0, const vpQuaternionVector &q1,
+                                  const double t);
+  static void slerp(const vpQuaternionVector &q0, const vpQuaternionVector &q1,
+                    unsigned int n, const double *t, vpQuaternionVector *q);
 } ;
 
 #endif
@@ -48,10 +48,12 @@
 
 
 #include <visp3/core/vpUniRand.h> // random number generation
+#include <visp3/core/vpPhiloxRand.h> // counter-based streams
 #include <visp3/core/vpDebug.h> // debug and trace
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
 #include <ctime>
+#include <vector>
 /*!
   \class vpRansac
   \ingroup group_core_robust
@@ -83,6 +85,15 @@ public:
 		      int consensus = 1000,
           double not_used = 0.0,
           const int maxNbumbersOfTrials = 10000);
+
+  static  bool ransacParallel(unsigned int npts,
+		      vpColVector &x,
+		      unsigned int s, double t,
+		      vpColVector &model,
+		      vpColVector &inliers,
+		      int consensus = 1000,
+          double not_used = 0.0,
+          const int maxNbumbersOfTrials = 10000);
 };
 
 /*!
@@ -251,5 +262,153 @@ vpRansac<vpTransformation>::ransac(unsigned int npts, vpColVector &x,
   return true;
 }
 
+/*!
+  \brief
+  RANSAC - Robustly fits a model to data, evaluating the hypotheses in
+  parallel.
+
+  Same contract as ransac() with the hypotheses scored by batches
+  distributed over the available threads when OpenMP is enabled, each
+  hypothesis drawing its samples from an own random stream. Between two
+  batches the adaptive trial bound is updated so that the early
+  termination on the inlier ratio is kept; a batch may evaluate a few
+  hypotheses more than the strictly sequential version. Without OpenMP
+  this entry point simply delegates to ransac().
+
+  \sa ransac() for the description of the parameters.
+*/
+template <class vpTransformation>
+bool
+vpRansac<vpTransformation>::ransacParallel(unsigned int npts, vpColVector &x,
+				   unsigned int s, double t,
+				   vpColVector &M,
+				   vpColVector &inliers,
+				   int consensus,
+           double not_used,
+           const int maxNbumbersOfTrials)
+{
+#ifndef VISP_HAVE_OPENMP
+  return ransac(npts, x, s, t, M, inliers, consensus, not_used, maxNbumbersOfTrials);
+#else
+  (void)not_used;
+  double eps = 1e-6 ;
+  double p = 0.99;    // Desired probability of choosing at least one sample
+  // free from outliers
+
+  int maxTrials = maxNbumbersOfTrials;      // Maximum number of trials before we give up.
+  int  maxDataTrials = 1000;  // Max number of attempts to select a non-degenerate
+  // data set.
+  const int batchSize = 32;   // Number of hypotheses scored per parallel round
+
+  if (s<4)
+    s = 4;
+
+  bool solutionFind = false ;
+  vpColVector bestM ;
+  int trialcount = 0;
+  int  bestscore =  -1;
+  double   N = 1;            // Dummy initialisation for number of trials.
+
+  long seed = (long)time(NULL);
+  vpColVector bestinliers ;
+  bool degenerateFailure = false;
+
+  std::vector<vpColVector> models((size_t)batchSize);
+  std::vector<int> scores((size_t)batchSize);
+
+  while(( N > trialcount) && (consensus > bestscore) && (trialcount <= maxTrials)
+        && !degenerateFailure)
+  {
+#pragma omp parallel for schedule(dynamic)
+    for (int h = 0; h < batchSize; h++)
+    {
+      // Own counter-based stream per hypothesis so that the batch is
+      // reproducible whatever the thread scheduling
+      vpPhiloxRand random((unsigned int)seed, (unsigned int)(trialcount + h)) ;
+      unsigned int *ind = new unsigned int [s] ;
+      vpColVector Mh ;
+      vpColVector d ;
+
+      // Select at random s datapoints to form a trial model, checking
+      // that they are not in a degenerate configuration.
+      bool degenerate = true;
+      int count = 1;
+      while ( degenerate == true && count <= maxDataTrials)
+      {
+        for  (unsigned int i=0 ; i < s ; i++)
+          ind[i] = (unsigned int)ceil(random()*npts) -1;
+
+        degenerate = vpTransformation::degenerateConfiguration(x,ind) ;
+        count = count + 1;
+      }
+      if (degenerate) {
+        scores[(size_t)h] = -1;
+        degenerateFailure = true;
+      }
+      else {
+        vpTransformation::computeTransformation(x,ind, Mh);
+        vpTransformation::computeResidual(x, Mh, d) ;
+
+        int ninliers = 0 ;
+        for (unsigned int i=0 ; i < npts ; i++)
+        {
+          if (fabs(d[i]) < t)
+            ninliers++ ;
+        }
+        scores[(size_t)h] = ninliers;
+        models[(size_t)h] = Mh;
+      }
+      delete [] ind;
+    }
+
+    if (degenerateFailure) {
+      vpERROR_TRACE("Unable to select a nondegenerate data set");
+      throw(vpException(vpException::fatalError, "Unable to select a nondegenerate data set"));
+    }
+
+    // Sequential merge of the batch, keeping the adaptive bound update
+    for (int h = 0; h < batchSize; h++)
+    {
+      if (scores[(size_t)h] > bestscore)
+      {
+        bestscore = scores[(size_t)h];
+        bestM = models[(size_t)h];
+        solutionFind = true ;
+
+        double fracinliers =  (double)bestscore / (double)npts;
+        double pNoOutliers = 1 -  pow(fracinliers,static_cast<int>(s));
+        pNoOutliers = vpMath::maximum(eps, pNoOutliers);  // Avoid division by -Inf
+        pNoOutliers = vpMath::minimum(1-eps, pNoOutliers);// Avoid division by 0.
+        N = (log(1-p)/log(pNoOutliers));
+      }
+    }
+    trialcount = trialcount + batchSize;
+
+    if (trialcount > maxTrials)
+    {
+      vpTRACE("ransac reached the maximum number of %d trials",   maxTrials);
+      break ;
+    }
+  }
+
+  if (solutionFind==true)   // We got a solution
+  {
+    M = bestM;
+    // Mark the inliers of the retained model, as ransac() does while
+    // scoring
+    vpColVector d ;
+    vpTransformation::computeResidual(x, bestM, d) ;
+    for (unsigned int i=0 ; i < npts ; i++)
+      inliers[i] = (fabs(d[i]) < t) ? 1 : 0;
+  }
+  else
+  {
+    vpTRACE("ransac was unable to find a useful solution");
+    M = 0;
+  }
+
+  return true;
+#endif
+}
 
 #endif
@@ -113,6 +113,12 @@ public:
 		 const vpColVector& all_residues,
 		 vpColVector &weights);
 
+  //! Same as MEstimator() with a vectorized Tukey weight kernel;
+  //! numerically equivalent but not bitwise identical to MEstimator()
+  void MEstimatorFast(const vpRobustEstimatorType method,
+		 const vpColVector &residues,
+		 vpColVector &weights);
+
   //! Simult Mestimator 
   vpColVector simultMEstimator(vpColVector &residues);
 
@@ -153,8 +159,10 @@ public:
   //---------------------------------
   /** @name PsiFunctions  */
   //@{
-  //! Tuckey influence function 
+  //! Tuckey influence function
   void psiTukey(double sigma, vpColVector &x, vpColVector &w);
+  //! Tuckey influence function, vectorized kernel
+  void psiTukeyFast(double sigma, vpColVector &x, vpColVector &w);
   //! Caucht influence function 
   void psiCauchy(double sigma, vpColVector &x, vpColVector &w);
   //! McLure influence function 
@@ -78,6 +78,10 @@ public:
   vpRowVector(unsigned int n, double val) : vpArray2D<double>(1, n, val){};
   //! Copy constructor that allows to construct a row vector from an other one.
   vpRowVector(const vpRowVector &v) : vpArray2D<double>(v) {};
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  //! Move constructor that steals the storage of the \e v temporary.
+  vpRowVector(vpRowVector &&v) : vpArray2D<double>(std::move(v)) {};
+#endif
   vpRowVector(const vpRowVector &v, unsigned int c, unsigned int ncols) ;
   vpRowVector(const vpMatrix &M);
   vpRowVector(const vpMatrix &M, unsigned int i);
@@ -162,6 +166,14 @@ public:
 
   //! Copy operator.   Allow operation such as A = v
   vpRowVector &operator=(const vpRowVector &v);
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+  //! Move assignment that reuses the buffer of the \e v temporary.
+  vpRowVector &operator=(vpRowVector &&v)
+  {
+    vpArray2D<double>::operator=(std::move(v));
+    return *this;
+  }
+#endif
   vpRowVector &operator=(const vpMatrix &M);
   vpRowVector &operator=(const std::vector<double> &v);
   vpRowVector &operator=(const std::vector<float> &v);
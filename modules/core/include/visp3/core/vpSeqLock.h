@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Sequence lock for wait-free state snapshots between threads.
+ *
+ *****************************************************************************/
+
+#ifndef __vpSeqLock_h_
+#define __vpSeqLock_h_
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#endif
+
+/*!
+  \class vpSeqLock
+
+  \ingroup group_core_threading
+
+  \brief Sequence lock publishing a plain-data value between threads : the
+  readers get a consistent snapshot without ever blocking the writer, and a
+  writer never waits for the readers.
+
+  The payload \e Type has to be copyable by plain assignment (no pointers
+  to owned data). Writers exclude each other with a short spin, so several
+  threads may publish; readers are completely lock-free and simply retry
+  when a write was in flight, which makes read() safe to call from a high
+  rate control loop while a display or simulation thread publishes.
+
+  \warning A reader retries while a write is in flight : if a writer can
+  be preempted for long by a strictly higher priority reader, give the
+  writer at least the reader's priority to avoid starving the retries.
+
+  \code
+#include <visp3/core/vpSeqLock.h>
+
+struct vpState { double q[6]; };
+vpSeqLock<vpState> state;
+
+// control thread, 1 kHz :
+vpState s = state.read();
+
+// simulation thread :
+state.write(s2);
+  \endcode
+
+  \sa vpMutex
+*/
+template <class Type> class vpSeqLock
+{
+public:
+  vpSeqLock() : m_sequence(0), m_writeLock(0), m_value() {}
+
+  /*!
+    Get a consistent snapshot of the published value, retrying while a
+    write is in flight. Never blocks the writer.
+
+    \return The last value published by write().
+  */
+  Type read() const
+  {
+    Type copy;
+    for (;;) {
+      unsigned int seqBefore = m_sequence;
+      if (seqBefore & 1u)
+        continue; // write in flight
+      memoryBarrier();
+      copy = m_value;
+      memoryBarrier();
+      if (m_sequence == seqBefore)
+        return copy;
+    }
+  }
+
+  /*!
+    Publish a new value. Concurrent writers exclude each other with a
+    short spin; the readers are never blocked.
+
+    \param value : Value to publish.
+  */
+  void write(const Type &value)
+  {
+    writerLock();
+    m_sequence++;
+    memoryBarrier();
+    m_value = value;
+    memoryBarrier();
+    m_sequence++;
+    writerUnlock();
+  }
+
+private:
+  //Copy not supported
+  vpSeqLock(const vpSeqLock &);
+  vpSeqLock &operator=(const vpSeqLock &);
+
+  static void memoryBarrier()
+  {
+#if defined(_WIN32)
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+  }
+
+  void writerLock()
+  {
+#if defined(_WIN32)
+    while (InterlockedExchange(&m_writeLock, 1) != 0) {}
+#else
+    while (__sync_lock_test_and_set(&m_writeLock, 1) != 0) {}
+#endif
+  }
+
+  void writerUnlock()
+  {
+#if defined(_WIN32)
+    InterlockedExchange(&m_writeLock, 0);
+#else
+    __sync_lock_release(&m_writeLock);
+#endif
+  }
+
+  volatile unsigned int m_sequence;
+#if defined(_WIN32)
+  volatile LONG m_writeLock;
+#else
+  volatile int m_writeLock;
+#endif
+  Type m_value;
+};
+
+#endif
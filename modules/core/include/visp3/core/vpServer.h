@@ -43,6 +43,8 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpNetwork.h>
 
+#include <map>
+
 
 /*!
   \class vpServer
@@ -169,6 +171,24 @@ private:
   bool         started;
   unsigned int max_clients;
   
+  //Event loop mode (epoll backed on Linux)
+  bool         useEventLoop;
+#ifdef __linux__
+  int          epollFd;
+  std::map<int, unsigned int> fdToReceptor;
+  //Closed connections whose receive buffer still has to be parsed; the
+  //erasure is deferred to the next waitForEvents() call
+  std::vector<int> pendingCloseFds;
+#endif
+  std::vector<std::string> receptorBuffers;
+  
+#ifdef __linux__
+  bool          _registerReceptorEvent(const unsigned int &index);
+  void          _rebuildEventIndex();
+  int           _drainReceptor(const unsigned int &index, bool &closed);
+  void          _eraseReceptor(const unsigned int &index);
+#endif
+  
 public:
   
   vpServer();
@@ -206,8 +226,24 @@ public:
   
   void          print();
   
+  std::vector<int> receiveBufferedRequestsFrom(const unsigned int &receptor);
+  std::vector<int> receiveAndDecodeBufferedRequestsFrom(const unsigned int &receptor);
+  
+  bool          setEventLoopMode(const bool &enable);
+  
+  /*!
+    Check if the epoll backed event loop mode is in use.
+    
+    \sa vpServer::setEventLoopMode()
+    
+    \return True if the event loop mode is in use, false otherwise.
+  */
+  bool          isEventLoopMode(){ return useEventLoop; }
+  
   bool          start();
   
+  int           waitForEvents(std::vector<unsigned int> &readyReceptors);
+  
   /*!
     Set the maximum number of clients that can be connected to the server.
     
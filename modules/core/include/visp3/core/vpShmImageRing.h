@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Shared memory image ring for multi-process frame exchange.
+ *
+ *****************************************************************************/
+
+#ifndef __vpShmImageRing_h_
+#define __vpShmImageRing_h_
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpShmImageRing
+
+  \ingroup group_core_threading
+
+  \brief Shared memory ring of image slots for single-producer
+  single-consumer frame exchange between processes, e.g. a capture
+  process feeding tracking and logging processes without sockets or
+  copies.
+
+  The producer create()s the ring at a System V key and publish()es
+  frames; each slot carries a sequence guard, a frame number and a
+  timestamp. A consumer attach()es and acquire()s the newest complete
+  frame either as a zero-copy non-owning vpImage view straight into the
+  shared slot -- valid until the producer cycles back onto that slot,
+  which checkView() detects -- or copied out with read().
+
+  \code
+// capture process :
+vpShmImageRing ring;
+ring.create(0x4d50, 480, 640, 1, 4);
+ring.publish(I, vpTime::measureTimeMicros());
+
+// tracking process :
+vpShmImageRing ring;
+ring.attach(0x4d50);
+vpImage<unsigned char> view;
+double timestamp; unsigned long frame;
+if (ring.acquire(view, timestamp, frame)) {
+  // process the view without copying ...
+  if (!ring.checkView(frame)) { } // the producer lapped us : resample
+}
+  \endcode
+
+  \sa vpFrameQueue, vpSeqLock
+*/
+class VISP_EXPORT vpShmImageRing
+{
+public:
+  vpShmImageRing();
+  virtual ~vpShmImageRing();
+
+  bool create(const int &key, const unsigned int &height, const unsigned int &width,
+              const unsigned int &pixelSize, const unsigned int &nbSlots = 4);
+  bool attach(const int &key);
+  void close();
+
+  //! Get the image height of the ring, available after create() or attach().
+  unsigned int getHeight() const { return m_height; }
+  //! Get the image width of the ring.
+  unsigned int getWidth() const { return m_width; }
+  //! Get the pixel size in bytes (1 for grayscale, 4 for vpRGBa).
+  unsigned int getPixelSize() const { return m_pixelSize; }
+
+  bool publish(const vpImage<unsigned char> &I, const double &timestamp);
+  bool publish(const vpImage<vpRGBa> &I, const double &timestamp);
+
+  bool acquire(vpImage<unsigned char> &view, double &timestamp, unsigned long &frame);
+  bool acquire(vpImage<vpRGBa> &view, double &timestamp, unsigned long &frame);
+  bool read(vpImage<unsigned char> &I, double &timestamp, unsigned long &frame);
+
+  bool checkView(const unsigned long &frame) const;
+
+private:
+  //Copy not supported
+  vpShmImageRing(const vpShmImageRing &);
+  vpShmImageRing &operator=(const vpShmImageRing &);
+
+  bool publishRaw(const unsigned char *pixels, const double &timestamp);
+  int acquireSlot(double &timestamp, unsigned long &frame);
+
+  unsigned int m_height;
+  unsigned int m_width;
+  unsigned int m_pixelSize;
+  unsigned int m_nbSlots;
+  bool m_isProducer;
+  unsigned long m_frameCounter;
+  unsigned long m_lastAcquiredSeq; //!< Slot sequence snapshot of the last acquire()
+  int m_lastAcquiredSlot;
+  int m_shmId;
+  unsigned char *m_shmAddr;
+};
+
+#endif
@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reusable workspace for SVD based decompositions.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpSvdContext_h_
+#define __vpSvdContext_h_
+
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpColVector.h>
+
+/*!
+  \class vpSvdContext
+  \ingroup group_core_matrices
+
+  \brief Workspace that can be handed repeatedly to SVD based computations
+  to avoid per-call allocations.
+
+  vpMatrix::svd() and vpMatrix::pseudoInverse() allocate fresh working
+  matrices on every call. When the same decomposition shape is computed
+  thousands of times, as in a visual servo loop that inverts a 6xN
+  interaction matrix at every iteration, these allocations show up as
+  jitter. A vpSvdContext keeps the working copies and, when lapack is
+  used, the dgesdd workspace alive between calls: after the first call
+  with a given shape the subsequent ones are allocation free.
+
+  \code
+  vpSvdContext svd_context;
+  vpMatrix L, Lp;
+  while (servoing) {
+    // ... build L ...
+    svd_context.pseudoInverse(L, Lp);  // no allocation after the 1st pass
+  }
+  \endcode
+
+  vpServo uses such a context internally for its control law computation.
+  A context is not protected against concurrent use: one instance is
+  needed per thread.
+*/
+class VISP_EXPORT vpSvdContext
+{
+public:
+  vpSvdContext();
+  virtual ~vpSvdContext();
+
+  void svd(const vpMatrix &A, vpColVector &w, vpMatrix &U, vpMatrix &V);
+
+  unsigned int pseudoInverse(const vpMatrix &A, vpMatrix &Ap, double svThreshold=1e-6);
+  unsigned int pseudoInverse(const vpMatrix &A, vpMatrix &Ap, vpColVector &sv, double svThreshold,
+                             vpMatrix &imA, vpMatrix &imAt);
+
+  void solveBySVD(const vpMatrix &A, const vpColVector &b, vpColVector &x);
+
+private:
+  // A context owns raw lapack workspace: copying it makes no sense
+  vpSvdContext(const vpSvdContext &);
+  vpSvdContext &operator=(const vpSvdContext &);
+
+  vpMatrix m_a;      //!< Working copy of the decomposed matrix, holds U on output
+  vpMatrix m_a1;     //!< Working copy used to build the pseudo inverse
+  vpMatrix m_ap;     //!< Pseudo inverse kept by solveBySVD() between the calls
+  vpMatrix m_v;      //!< Right singular vectors
+  vpColVector m_sv;  //!< Singular values
+
+#ifdef VISP_HAVE_LAPACK_C
+  double *m_work;          //!< dgesdd work array, reused between calls
+  int *m_iwork;            //!< dgesdd integer work array
+  int m_lwork;             //!< Size of the work array
+  unsigned int m_workRows; //!< Shape for which the workspace was sized
+  unsigned int m_workCols;
+  double *m_acopy;         //!< dgesdd destructive input copy
+#endif
+};
+
+#endif
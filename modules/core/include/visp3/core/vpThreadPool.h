@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Process-wide thread pool.
+ *
+ *****************************************************************************/
+
+#ifndef __vpThreadPool_h_
+#define __vpThreadPool_h_
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpMutex.h>
+
+#include <vector>
+#include <deque>
+
+/*!
+   \class vpThreadPool
+
+   \ingroup group_core_threading
+
+   \brief Process-wide pool of worker threads with a work queue, task
+   futures and a parallel-for helper.
+
+   The workers are created once and reused, so that the parallelized
+   functions of ViSP do not pay a thread creation for every call. A single
+   shared instance is available through getInstance(); it is the substrate
+   of the internal parallelizations but separate pools can also be
+   instantiated.
+
+   \code
+#include <visp3/core/vpThreadPool.h>
+
+void *myTask(void *arg)
+{
+  // ...
+  return NULL;
+}
+
+int main()
+{
+  vpThreadPool &pool = vpThreadPool::getInstance();
+
+  vpThreadPool::vpTaskStatus status;
+  pool.enqueue(myTask, NULL, &status);
+  // ...
+  status.wait();
+}
+   \endcode
+
+   \sa vpThread
+   \sa vpMutex
+*/
+class VISP_EXPORT vpThreadPool
+{
+public:
+  //! Signature of a task, identical to the one of vpThread.
+  typedef vpThread::Return (*vpTaskFn)(vpThread::Args);
+  //! Signature of a parallel-for body, called on [first, last) iteration ranges.
+  typedef void (*vpRangeFn)(void *args, const unsigned int first, const unsigned int last);
+
+  /*!
+     Future of a task submitted with vpThreadPool::enqueue(). The object has
+     to stay alive until the task completed; wait() blocks until then.
+   */
+  class vpTaskStatus
+  {
+    friend class vpThreadPool;
+
+  public:
+    vpTaskStatus() : m_done(true), m_ret(NULL), m_pool(NULL) {}
+
+    /*!
+      Indicates if the task completed.
+
+      \return True if the task has completed, false otherwise.
+    */
+    bool isDone() const { return m_done; }
+
+    vpThread::Return wait();
+
+  private:
+    volatile bool m_done;
+    vpThread::Return m_ret;
+    vpThreadPool *m_pool;
+  };
+
+  vpThreadPool(unsigned int nbThreads = 0);
+  virtual ~vpThreadPool();
+
+  void enqueue(vpTaskFn fn, vpThread::Args args, vpTaskStatus *status = NULL);
+
+  /*!
+    Get the number of worker threads of the pool.
+
+    \return Number of workers.
+  */
+  unsigned int getNbThreads() const { return (unsigned int)m_workers.size(); }
+
+  void parallelFor(vpRangeFn fn, void *args, const unsigned int &nbIterations);
+
+  void setAffinity(const std::vector<unsigned int> &cpus);
+
+  void waitAll();
+
+  static vpThreadPool &getInstance();
+
+  static unsigned int getHardwareConcurrency();
+
+private:
+  //Internal description of a submitted task
+  struct vpPoolTask
+  {
+    vpTaskFn fn;
+    vpThread::Args args;
+    vpTaskStatus *status;
+
+    vpPoolTask() : fn(NULL), args(NULL), status(NULL) {}
+  };
+
+  //Copy not supported
+  vpThreadPool(const vpThreadPool &);
+  vpThreadPool &operator=(const vpThreadPool &);
+
+  //Range chunk of parallelFor(), submitted as a plain task
+  struct vpRangeTask
+  {
+    vpRangeFn fn;
+    void *args;
+    unsigned int first;
+    unsigned int last;
+
+    vpRangeTask() : fn(NULL), args(NULL), first(0), last(0) {}
+  };
+
+  static vpThread::Return workerLoop(vpThread::Args args);
+  static vpThread::Return rangeTask(vpThread::Args args);
+  void runTask(vpPoolTask &task);
+  bool tryRunOneTask();
+
+  std::vector<vpThread *> m_workers;
+  std::deque<vpPoolTask> m_taskQueue;
+#if defined(VISP_HAVE_PTHREAD)
+  //vpMutex does not expose its native handle, needed here by the condition
+  //variables the workers sleep on
+  pthread_mutex_t m_queueMutex;
+  pthread_cond_t m_workCond;
+  pthread_cond_t m_doneCond;
+#else
+  vpMutex m_queueMutex;
+#endif
+  volatile bool m_stop;
+  volatile unsigned int m_activeTasks;
+  std::vector<unsigned int> m_affinity;
+};
+
+#endif
+#endif
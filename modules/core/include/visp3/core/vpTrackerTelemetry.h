@@ -0,0 +1,204 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Lock-free telemetry ring buffer for the trackers.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpTrackerTelemetry_h_
+#define __vpTrackerTelemetry_h_
+
+/*!
+  \file vpTrackerTelemetry.h
+  \brief Lock-free telemetry ring buffer for the trackers.
+*/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpTime.h>
+
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#endif
+
+/*!
+  \class vpTrackerTelemetry
+
+  \ingroup group_core_threading
+
+  \brief Lock-free single-writer single-reader telemetry ring buffer.
+
+  The trackers publish one structured vpTrackerTelemetry::vpRecord per frame
+  into the buffer, and a monitoring thread drains the records without
+  perturbing the tracking thread: publish() and drain() never block and never
+  copy more than one record. When the buffer is full, publish() drops the new
+  record and accounts it in getDropped() so that the tracking loop is never
+  slowed down by a late consumer.
+
+  The buffer supports exactly one producer thread and one consumer thread:
+  the producer only writes the head index, the consumer only writes the tail
+  index, and a memory barrier orders the record with respect to its index
+  publication.
+
+  \code
+#include <visp3/core/vpTrackerTelemetry.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+int main()
+{
+  vpTrackerTelemetry telemetry;
+  vpMbEdgeTracker tracker;
+  tracker.setTelemetry(&telemetry);
+
+  // ... tracking loop in the main thread: tracker.track(I);
+
+  // In the monitoring thread:
+  vpTrackerTelemetry::vpRecord record;
+  while (telemetry.drain(record)) {
+    std::cout << "frame " << record.frame << ": " << record.nbFeatures
+              << " features, residual " << record.residual << std::endl;
+  }
+}
+  \endcode
+*/
+class vpTrackerTelemetry
+{
+public:
+  //! Structured per-frame diagnostics published by a tracker.
+  struct vpRecord {
+    double timestamp;          //!< Publication time in ms, see vpTime::measureTimeMs().
+    unsigned int frame;        //!< Frame counter of the publishing tracker.
+    unsigned int nbFeatures;   //!< Number of features (moving-edge sites, points, ...) used.
+    unsigned int nbIterations; //!< Number of optimization iterations spent on the frame.
+    double residual;           //!< Final residual of the frame.
+    double meanWeight;         //!< Mean robust weight of the features.
+    double dataAgeMs;          //!< Age of the processed frame at tracking time, negative when the frame was not stamped.
+
+    vpRecord()
+      : timestamp(0.), frame(0), nbFeatures(0), nbIterations(0),
+        residual(0.), meanWeight(1.), dataAgeMs(-1.) {}
+  };
+
+  /*!
+    Build a telemetry buffer.
+
+    \param capacity : Number of records the buffer can hold, rounded up to
+    the next power of two (256 by default, i.e. several seconds of frames).
+  */
+  explicit vpTrackerTelemetry(unsigned int capacity = 256)
+    : m_buffer(), m_mask(0), m_head(0), m_tail(0), m_dropped(0)
+  {
+    unsigned int size = 1;
+    while (size < capacity)
+      size *= 2;
+    m_buffer.resize(size);
+    m_mask = size - 1;
+  }
+
+  /*!
+    Publish a record. Must be called from the single producer thread; never
+    blocks. The publication timestamp of the record is set here.
+
+    \param record : The record to publish.
+
+    \return True if the record has been published, false if the buffer was
+    full and the record dropped (see getDropped()).
+  */
+  bool publish(const vpRecord &record)
+  {
+    unsigned int head = m_head;
+    if (head - m_tail > m_mask) {
+      m_dropped = m_dropped + 1;
+      return false;
+    }
+    m_buffer[head & m_mask] = record;
+    m_buffer[head & m_mask].timestamp = vpTime::measureTimeMs();
+    memoryBarrier(); // The record must be visible before its index
+    m_head = head + 1;
+    return true;
+  }
+
+  /*!
+    Drain the oldest record. Must be called from the single consumer thread;
+    never blocks.
+
+    \param record : Filled with the oldest published record on success.
+
+    \return True if a record has been drained, false if the buffer was empty.
+  */
+  bool drain(vpRecord &record)
+  {
+    unsigned int tail = m_tail;
+    if (tail == m_head)
+      return false;
+    memoryBarrier(); // The index must be read before the record
+    record = m_buffer[tail & m_mask];
+    memoryBarrier(); // The record must be read before its slot is released
+    m_tail = tail + 1;
+    return true;
+  }
+
+  //! Get the number of records the buffer can hold.
+  unsigned int getCapacity() const { return m_mask + 1; }
+
+  //! Get the number of records dropped because the buffer was full.
+  unsigned int getDropped() const { return m_dropped; }
+
+  //! Get the number of records currently waiting to be drained.
+  unsigned int getSize() const { return m_head - m_tail; }
+
+private:
+  //! Full memory barrier ordering the record accesses with the index publications.
+  static void memoryBarrier()
+  {
+#if defined(__GNUC__)
+    __sync_synchronize();
+#elif defined(_WIN32)
+    MemoryBarrier();
+#endif
+  }
+
+  // The buffer is bound to its producer and consumer threads: copying it
+  // would break the single-writer single-reader contract.
+  vpTrackerTelemetry(const vpTrackerTelemetry &);
+  vpTrackerTelemetry &operator=(const vpTrackerTelemetry &);
+
+  std::vector<vpRecord> m_buffer;
+  unsigned int m_mask;
+  volatile unsigned int m_head;    //!< Written only by the producer
+  volatile unsigned int m_tail;    //!< Written only by the consumer
+  volatile unsigned int m_dropped; //!< Written only by the producer
+};
+
+#endif
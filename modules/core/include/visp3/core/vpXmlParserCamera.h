@@ -185,6 +185,9 @@ int main()
 class VISP_EXPORT vpXmlParserCamera: public vpXmlParser
 {
 
+  //! True when parse() prefers the binary cache beside the XML files
+  static bool s_parseCacheEnabled;
+
 public:
 
   /* --- XML Code------------------------------------------------------------ */
@@ -248,6 +251,19 @@ public:
 
   vpXmlParserCamera& operator =(const vpXmlParserCamera& twinparser);
 
+  /*!
+    Enable the binary parse cache: a successful parse() writes the resolved
+    camera parameters in a small binary file beside the XML, keyed by the
+    XML content hash and the query (camera name, projection model, image
+    size), and subsequent parses serve matching queries from it without
+    touching libxml2. A modified XML invalidates the cache through the hash.
+    Disabled by default (no files are dropped beside configurations unless
+    asked for).
+
+    \param enable : True to prefer the cache.
+  */
+  static void setParseCacheEnabled(bool enable) { s_parseCacheEnabled = enable; }
+
   int parse(vpCameraParameters &cam, const std::string &filename,
       const std::string &camera_name,
       const vpCameraParameters::vpCameraParametersProjType &projModel,
@@ -47,6 +47,49 @@
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpDebug.h>
 
+/*!
+  Point coordinates conversion from normalized coordinates in meter to
+  pixel coordinates for a whole array of points, with the camera model
+  hoisted out of the loop.
+
+  Same conversion as convertPoint() applied to each entry of the arrays.
+
+  \param cam : camera parameters.
+  \param npoints : number of points to convert.
+  \param x : input coordinates in meter along image plane x-axis.
+  \param y : input coordinates in meter along image plane y-axis.
+  \param u : output coordinates in pixels along image horizontal axis.
+  \param v : output coordinates in pixels along image vertical axis.
+*/
+void
+vpMeterPixelConversion::convertPoints(const vpCameraParameters &cam,
+				      unsigned int npoints,
+				      const double *x, const double *y,
+				      double *u, double *v)
+{
+  const double u0 = cam.u0, v0 = cam.v0;
+  const double px = cam.px, py = cam.py;
+
+  switch(cam.projModel){
+    case vpCameraParameters::perspectiveProjWithoutDistortion :
+      for (unsigned int i = 0; i < npoints; i++) {
+        u[i] = x[i]*px + u0;
+        v[i] = y[i]*py + v0;
+      }
+      break;
+    case vpCameraParameters::perspectiveProjWithDistortion :
+    {
+      const double kud = cam.kud;
+      for (unsigned int i = 0; i < npoints; i++) {
+        double r2 = 1. + kud*(x[i]*x[i] + y[i]*y[i]);
+        u[i] = u0 + px*x[i]*r2;
+        v[i] = v0 + py*y[i]*r2;
+      }
+      break;
+    }
+  }
+}
+
 //! Line coordinates conversion (rho,theta).
 void
 vpMeterPixelConversion::convertLine(const vpCameraParameters &cam,
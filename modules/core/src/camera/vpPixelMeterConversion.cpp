@@ -47,6 +47,53 @@
 #include<visp3/core/vpDebug.h>
 
 
+/*!
+  Point coordinates conversion from pixel coordinates to normalized
+  coordinates in meter for a whole array of points, with the camera model
+  hoisted out of the loop.
+
+  Same conversion as convertPoint() applied to each entry of the arrays;
+  dedicated to the callers that convert thousands of coordinates per
+  frame, such as the moving-edge sites handling.
+
+  \param cam : camera parameters.
+  \param npoints : number of points to convert.
+  \param u : input coordinates in pixels along image horizontal axis.
+  \param v : input coordinates in pixels along image vertical axis.
+  \param x : output coordinates in meter along image plane x-axis.
+  \param y : output coordinates in meter along image plane y-axis.
+*/
+void
+vpPixelMeterConversion::convertPoints(const vpCameraParameters &cam,
+				      unsigned int npoints,
+				      const double *u, const double *v,
+				      double *x, double *y)
+{
+  const double u0 = cam.u0, v0 = cam.v0;
+  const double inv_px = cam.inv_px, inv_py = cam.inv_py;
+
+  switch(cam.projModel){
+    case vpCameraParameters::perspectiveProjWithoutDistortion :
+      for (unsigned int i = 0; i < npoints; i++) {
+        x[i] = (u[i] - u0)*inv_px;
+        y[i] = (v[i] - v0)*inv_py;
+      }
+      break;
+    case vpCameraParameters::perspectiveProjWithDistortion :
+    {
+      const double kdu = cam.kdu;
+      for (unsigned int i = 0; i < npoints; i++) {
+        double xd = (u[i] - u0)*inv_px;
+        double yd = (v[i] - v0)*inv_py;
+        double r2 = 1. + kdu*(xd*xd + yd*yd);
+        x[i] = xd*r2;
+        y[i] = yd*r2;
+      }
+      break;
+    }
+  }
+}
+
 //! line coordinates conversion (rho,theta)
 void
 vpPixelMeterConversion::convertLine(const vpCameraParameters &cam,
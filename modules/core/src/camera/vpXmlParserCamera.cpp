@@ -43,6 +43,10 @@
 
 */
 #include <visp3/core/vpXmlParserCamera.h>
+
+#include <vector>
+#include <string.h>
+#include <stdio.h>
 #ifdef VISP_HAVE_XML2
 
 #include <stdlib.h>
@@ -136,6 +140,142 @@ vpXmlParserCamera::operator =(const vpXmlParserCamera& twinParser) {
 
   \return error code.
 */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+bool vpXmlParserCamera::s_parseCacheEnabled = false;
+
+//! One entry of the binary parse cache: a resolved query and its camera.
+struct vpXmlCamCacheEntry
+{
+  char name[64];
+  unsigned int projModel;
+  unsigned int width;
+  unsigned int height;
+  unsigned int storedModel;
+  double px, py, u0, v0, kud, kdu;
+};
+
+//! Header of the parse cache file written beside the XML.
+struct vpXmlCamCacheHeader
+{
+  unsigned int magic;   //!< 0x56505843 ("VPXC")
+  unsigned int version;
+  unsigned long long contentHash;
+  unsigned int nbEntries;
+  unsigned int reserved;
+};
+
+//! FNV-1a hash of the XML file content, 0 when the file cannot be read.
+static unsigned long long vpXmlCamContentHash(const std::string &filename)
+{
+  FILE *f = fopen(filename.c_str(), "rb");
+  if (f == NULL)
+    return 0;
+  unsigned long long h = 14695981039346656037ULL;
+  unsigned char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    for (size_t i = 0; i < n; i++) {
+      h ^= buf[i];
+      h *= 1099511628211ULL;
+    }
+  }
+  fclose(f);
+  return h;
+}
+
+//! Try to serve the query from the cache beside the XML.
+static bool vpXmlCamCacheLookup(const std::string &filename, unsigned long long hash,
+                                const std::string &cam_name, unsigned int projModel,
+                                unsigned int w, unsigned int h_, vpCameraParameters &cam)
+{
+  FILE *f = fopen((filename + ".vpcache").c_str(), "rb");
+  if (f == NULL)
+    return false;
+
+  vpXmlCamCacheHeader header;
+  if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != 0x56505843u ||
+      header.version != 1 || header.contentHash != hash) {
+    fclose(f);
+    return false;
+  }
+
+  vpXmlCamCacheEntry e;
+  bool found = false;
+  for (unsigned int i = 0; i < header.nbEntries && !found; i++) {
+    if (fread(&e, sizeof(e), 1, f) != 1)
+      break;
+    if (cam_name.compare(e.name) == 0 && e.projModel == projModel &&
+        e.width == w && e.height == h_) {
+      if (e.storedModel == (unsigned int) vpCameraParameters::perspectiveProjWithDistortion)
+        cam.initPersProjWithDistortion(e.px, e.py, e.u0, e.v0, e.kud, e.kdu);
+      else
+        cam.initPersProjWithoutDistortion(e.px, e.py, e.u0, e.v0);
+      found = true;
+    }
+  }
+  fclose(f);
+  return found;
+}
+
+//! Append the resolved query to the cache, rewriting it when the XML changed.
+static void vpXmlCamCacheStore(const std::string &filename, unsigned long long hash,
+                               const std::string &cam_name, unsigned int projModel,
+                               unsigned int w, unsigned int h_, const vpCameraParameters &cam)
+{
+  if (cam_name.size() >= sizeof(((vpXmlCamCacheEntry *)0)->name))
+    return; //name too long for the fixed entry layout
+
+  std::string cacheName = filename + ".vpcache";
+  vpXmlCamCacheHeader header;
+  std::vector<vpXmlCamCacheEntry> entries;
+
+  FILE *f = fopen(cacheName.c_str(), "rb");
+  if (f != NULL) {
+    if (fread(&header, sizeof(header), 1, f) == 1 && header.magic == 0x56505843u &&
+        header.version == 1 && header.contentHash == hash) {
+      vpXmlCamCacheEntry e;
+      for (unsigned int i = 0; i < header.nbEntries; i++) {
+        if (fread(&e, sizeof(e), 1, f) != 1)
+          break;
+        entries.push_back(e);
+      }
+    }
+    fclose(f);
+  }
+
+  vpXmlCamCacheEntry e;
+  memset(&e, 0, sizeof(e));
+  strncpy(e.name, cam_name.c_str(), sizeof(e.name)-1);
+  e.projModel = projModel;
+  e.width = w;
+  e.height = h_;
+  e.storedModel = (unsigned int) cam.get_projModel();
+  e.px = cam.get_px();
+  e.py = cam.get_py();
+  e.u0 = cam.get_u0();
+  e.v0 = cam.get_v0();
+  e.kud = cam.get_kud();
+  e.kdu = cam.get_kdu();
+  entries.push_back(e);
+
+  f = fopen(cacheName.c_str(), "wb");
+  if (f == NULL)
+    return; //read-only location: simply do not cache
+
+  memset(&header, 0, sizeof(header));
+  header.magic = 0x56505843u;
+  header.version = 1;
+  header.contentHash = hash;
+  header.nbEntries = (unsigned int) entries.size();
+  bool ok = (fwrite(&header, sizeof(header), 1, f) == 1);
+  for (size_t i = 0; ok && i < entries.size(); i++)
+    ok = (fwrite(&entries[i], sizeof(vpXmlCamCacheEntry), 1, f) == 1);
+  fclose(f);
+  if (!ok)
+    remove(cacheName.c_str());
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 int
 vpXmlParserCamera::parse(vpCameraParameters &cam, const std::string &filename,
                          const std::string& cam_name,
@@ -146,6 +286,19 @@ vpXmlParserCamera::parse(vpCameraParameters &cam, const std::string &filename,
   xmlDocPtr doc;
   xmlNodePtr node;
 
+  unsigned long long content_hash = 0;
+  if (s_parseCacheEnabled) {
+    //The binary cache beside the XML resolves the query without libxml2
+    //as long as the file content is unchanged
+    content_hash = vpXmlCamContentHash(filename);
+    if (content_hash != 0 &&
+        vpXmlCamCacheLookup(filename, content_hash, cam_name,
+                            (unsigned int) projModel, im_width, im_height, cam)) {
+      camera = cam;
+      return SEQUENCE_OK;
+    }
+  }
+
   doc = xmlParseFile(filename.c_str());
   if (doc == NULL)
   {
@@ -163,6 +316,11 @@ vpXmlParserCamera::parse(vpCameraParameters &cam, const std::string &filename,
 
   cam = camera ;
 
+  if (s_parseCacheEnabled && content_hash != 0 && ret == SEQUENCE_OK) {
+    vpXmlCamCacheStore(filename, content_hash, cam_name,
+                       (unsigned int) projModel, im_width, im_height, cam);
+  }
+
   xmlFreeDoc(doc);
 
   return ret;
@@ -55,13 +55,15 @@
   Default constructor.
 */
 vpDisplay::vpDisplay()
-  : displayHasBeenInitialized(false), windowXPosition(0), windowYPosition(0), width(0), height(0), title_() {}
+  : displayHasBeenInitialized(false), windowXPosition(0), windowYPosition(0), width(0), height(0), title_(),
+    m_overlayBatch(), m_overlayBatching(false) {}
 
 /*!
   Copy constructor.
 */
 vpDisplay::vpDisplay(const vpDisplay &d)
-  : displayHasBeenInitialized(false), windowXPosition(0), windowYPosition(0), width(0), height(0), title_()
+  : displayHasBeenInitialized(false), windowXPosition(0), windowYPosition(0), width(0), height(0), title_(),
+    m_overlayBatch(), m_overlayBatching(false)
 {
   displayHasBeenInitialized = d.displayHasBeenInitialized;
   windowXPosition = d.windowXPosition;
@@ -253,3 +255,179 @@ vpDisplay::getImage(const vpImage<vpRGBa> &Isrc, vpImage<vpRGBa> &Idest)
     throw ;
   }
 }
+
+/*!
+  Start accumulating the overlay primitives (points, lines, crosses) into
+  a display list instead of drawing them immediately. endOverlayBatch()
+  submits the whole list to the backend in one pass, saving the per
+  primitive backend calls when thousands of sites or segments are drawn
+  each frame.
+
+  \sa endOverlayBatch()
+*/
+void vpDisplay::beginOverlayBatch()
+{
+  m_overlayBatch.clear();
+  m_overlayBatching = true;
+}
+
+/*!
+  Submit the primitives accumulated since beginOverlayBatch() to the
+  backend in one pass and leave the batching mode.
+
+  \sa beginOverlayBatch()
+*/
+void vpDisplay::endOverlayBatch()
+{
+  if (!m_overlayBatching)
+    return;
+  m_overlayBatching = false;
+  if (!m_overlayBatch.empty()) {
+    displayPrimitives(m_overlayBatch);
+    m_overlayBatch.clear();
+  }
+}
+
+/*!
+  Leave the batching mode and hand the accumulated primitives to the
+  caller without drawing them, e.g. to cache them for replay through
+  submitPrimitives().
+
+  \param primitives : Receives the accumulated display list.
+
+  \sa beginOverlayBatch(), submitPrimitives()
+*/
+void vpDisplay::endOverlayBatch(std::vector<vpOverlayPrimitive> &primitives)
+{
+  if (!m_overlayBatching) {
+    primitives.clear();
+    return;
+  }
+  m_overlayBatching = false;
+  primitives.swap(m_overlayBatch);
+  m_overlayBatch.clear();
+}
+
+/*!
+  Draw a previously captured display list in one backend pass.
+
+  \param primitives : Display list captured by
+  endOverlayBatch(std::vector<vpOverlayPrimitive> &).
+*/
+void vpDisplay::submitPrimitives(const std::vector<vpOverlayPrimitive> &primitives)
+{
+  if (!primitives.empty())
+    displayPrimitives(primitives);
+}
+
+/*!
+  Append a point to the display list, see beginOverlayBatch().
+*/
+void vpDisplay::bufferPoint(const vpImagePoint &ip, const vpColor &color)
+{
+  vpOverlayPrimitive p;
+  p.type = PRIMITIVE_POINT;
+  p.ip1 = ip;
+  p.size = 0;
+  p.color = color;
+  p.thickness = 1;
+  m_overlayBatch.push_back(p);
+}
+
+/*!
+  Append a line to the display list, see beginOverlayBatch().
+*/
+void vpDisplay::bufferLine(const vpImagePoint &ip1, const vpImagePoint &ip2,
+                           const vpColor &color, unsigned int thickness)
+{
+  vpOverlayPrimitive p;
+  p.type = PRIMITIVE_LINE;
+  p.ip1 = ip1;
+  p.ip2 = ip2;
+  p.size = 0;
+  p.color = color;
+  p.thickness = thickness;
+  m_overlayBatch.push_back(p);
+}
+
+/*!
+  Append a cross to the display list, see beginOverlayBatch().
+*/
+void vpDisplay::bufferCross(const vpImagePoint &ip, unsigned int size,
+                            const vpColor &color, unsigned int thickness)
+{
+  vpOverlayPrimitive p;
+  p.type = PRIMITIVE_CROSS;
+  p.ip1 = ip;
+  p.size = size;
+  p.color = color;
+  p.thickness = thickness;
+  m_overlayBatch.push_back(p);
+}
+
+/*!
+  Draw a batch of overlay primitives. The default implementation replays
+  them one by one through the virtual drawing functions; the backends able
+  to submit primitives in groups (e.g. vpDisplayX) override it.
+
+  \param primitives : Display list built between beginOverlayBatch() and
+  endOverlayBatch().
+*/
+void vpDisplay::displayPrimitives(const std::vector<vpOverlayPrimitive> &primitives)
+{
+  for (unsigned int i = 0; i < primitives.size(); i++) {
+    const vpOverlayPrimitive &p = primitives[i];
+    switch (p.type) {
+    case PRIMITIVE_POINT:
+      displayPoint(p.ip1, p.color);
+      break;
+    case PRIMITIVE_LINE:
+      displayLine(p.ip1, p.ip2, p.color, p.thickness);
+      break;
+    case PRIMITIVE_CROSS:
+    default:
+      displayCross(p.ip1, p.size, p.color, p.thickness);
+      break;
+    }
+  }
+}
+
+/*!
+  Start batching the overlay primitives of the display associated to \e I,
+  see beginOverlayBatch().
+*/
+void vpDisplay::beginOverlayBatch(const vpImage<unsigned char> &I)
+{
+  if (I.display != NULL)
+    (I.display)->beginOverlayBatch();
+}
+
+/*!
+  Submit the batched overlay primitives of the display associated to \e I,
+  see endOverlayBatch().
+*/
+void vpDisplay::endOverlayBatch(const vpImage<unsigned char> &I)
+{
+  if (I.display != NULL)
+    (I.display)->endOverlayBatch();
+}
+
+/*!
+  Start batching the overlay primitives of the display associated to \e I,
+  see beginOverlayBatch().
+*/
+void vpDisplay::beginOverlayBatch(const vpImage<vpRGBa> &I)
+{
+  if (I.display != NULL)
+    (I.display)->beginOverlayBatch();
+}
+
+/*!
+  Submit the batched overlay primitives of the display associated to \e I,
+  see endOverlayBatch().
+*/
+void vpDisplay::endOverlayBatch(const vpImage<vpRGBa> &I)
+{
+  if (I.display != NULL)
+    (I.display)->endOverlayBatch();
+}
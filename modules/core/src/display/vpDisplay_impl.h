@@ -195,7 +195,10 @@ vp_display_display_cross(const vpImage<Type> &I, const vpImagePoint &ip, unsigne
   {
     if ( I.display != NULL )
     {
-      ( I.display )->displayCross ( ip, size, color, thickness ) ;
+      if ( ( I.display )->isOverlayBatching() )
+        ( I.display )->bufferCross ( ip, size, color, thickness ) ;
+      else
+        ( I.display )->displayCross ( ip, size, color, thickness ) ;
     }
   }
   catch ( ... )
@@ -217,7 +220,10 @@ vp_display_display_cross(const vpImage<Type> &I, int i, int j, unsigned int size
       ip.set_i( i );
       ip.set_j( j );
 
-      ( I.display )->displayCross ( ip, size, color, thickness ) ;
+      if ( ( I.display )->isOverlayBatching() )
+        ( I.display )->bufferCross ( ip, size, color, thickness ) ;
+      else
+        ( I.display )->displayCross ( ip, size, color, thickness ) ;
     }
   }
   catch ( ... )
@@ -346,7 +352,10 @@ vp_display_display_ellipse(const vpImage<Type> &I, const vpImagePoint &center,
         iP22.set_j ( center.get_j() + ce *j2 - se *i2 );
         iP22.set_i ( center.get_i() + se *j2 + ce *i2 );
 
-        ( I.display )->displayLine(iP11, iP22, color, thickness) ;
+        if ( ( I.display )->isOverlayBatching() )
+          ( I.display )->bufferLine(iP11, iP22, color, thickness) ;
+        else
+          ( I.display )->displayLine(iP11, iP22, color, thickness) ;
 
         iP11 = iP22;
 
@@ -415,7 +424,10 @@ vp_display_display_line(const vpImage<Type> &I, const vpImagePoint &ip1, const v
   {
     if ( I.display != NULL )
     {
-      ( I.display )->displayLine ( ip1, ip2, color, thickness );
+      if ( ( I.display )->isOverlayBatching() )
+        ( I.display )->bufferLine ( ip1, ip2, color, thickness );
+      else
+        ( I.display )->displayLine ( ip1, ip2, color, thickness );
     }
   }
   catch ( ... )
@@ -438,7 +450,10 @@ vp_display_display_line(const vpImage<Type> &I, int i1, int j1, int i2, int j2,
       ip1.set_j( j1 );
       ip2.set_i( i2 );
       ip2.set_j( j2 );
-      ( I.display )->displayLine ( ip1, ip2, color, thickness );
+      if ( ( I.display )->isOverlayBatching() )
+        ( I.display )->bufferLine ( ip1, ip2, color, thickness );
+      else
+        ( I.display )->displayLine ( ip1, ip2, color, thickness );
     }
   }
   catch ( ... )
@@ -456,8 +471,12 @@ vp_display_display_point(const vpImage<Type> &I, const vpImagePoint &ip,
   {
     if ( I.display != NULL )
     {
-      if (thickness == 1)
-        ( I.display )->displayPoint ( ip, color ) ;
+      if (thickness == 1) {
+        if ( ( I.display )->isOverlayBatching() )
+          ( I.display )->bufferPoint ( ip, color ) ;
+        else
+          ( I.display )->displayPoint ( ip, color ) ;
+      }
       else {
         vpRect rect(0, 0, thickness, thickness);
         rect.moveCenter(ip);
@@ -483,8 +502,12 @@ vp_display_display_point(const vpImage<Type> &I, int i, int j,
       vpImagePoint ip;
       ip.set_i( i );
       ip.set_j( j );
-      if (thickness == 1)
-        ( I.display )->displayPoint ( ip, color ) ;
+      if (thickness == 1) {
+        if ( ( I.display )->isOverlayBatching() )
+          ( I.display )->bufferPoint ( ip, color ) ;
+        else
+          ( I.display )->displayPoint ( ip, color ) ;
+      }
       else {
         vpRect rect(0, 0, thickness, thickness);
         rect.moveCenter(ip);
@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bit-packed binary image with word parallel morphology.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpBitImage.h>
+#include <visp3/core/vpException.h>
+
+#include <string.h>
+
+vpBitImage::vpBitImage()
+  : m_height(0), m_width(0), m_words_per_row(0), m_words(), m_buffer(), m_result()
+{
+}
+
+vpBitImage::vpBitImage(unsigned int height, unsigned int width)
+  : m_height(0), m_width(0), m_words_per_row(0), m_words(), m_buffer(), m_result()
+{
+  resize(height, width);
+}
+
+vpBitImage::~vpBitImage()
+{
+}
+
+/*!
+  Set the size of the binary image and clear every pixel.
+
+  \param height, width : Image size.
+*/
+void vpBitImage::resize(unsigned int height, unsigned int width)
+{
+  m_height = height;
+  m_width = width;
+  m_words_per_row = (width + 63) / 64;
+  m_words.assign((size_t)m_height*m_words_per_row, 0);
+}
+
+/*!
+  Build the binary image from a grey level image: the bit \f$(i,j)\f$ is
+  set when \f$ I(i,j) \geq threshold \f$.
+
+  \param I : Input grey level image.
+  \param threshold : Binarization threshold.
+*/
+void vpBitImage::buildFrom(const vpImage<unsigned char> &I, unsigned char threshold)
+{
+  if (m_height != I.getHeight() || m_width != I.getWidth())
+    resize(I.getHeight(), I.getWidth());
+  else
+    m_words.assign(m_words.size(), 0);
+
+  for (unsigned int i = 0; i < m_height; i++) {
+    const unsigned char *row = I[i];
+    uint64_t *words = &m_words[(size_t)i*m_words_per_row];
+    for (unsigned int j = 0; j < m_width; j++) {
+      if (row[j] >= threshold)
+        words[j >> 6] |= ((uint64_t)1) << (j & 63);
+    }
+  }
+}
+
+/*!
+  Unpack the binary image in a grey level image.
+
+  \param I : Output image, resized to the binary image size.
+  \param value_true : Value given to the set pixels.
+  \param value_false : Value given to the cleared pixels.
+*/
+void vpBitImage::toImage(vpImage<unsigned char> &I, unsigned char value_true, unsigned char value_false) const
+{
+  I.resize(m_height, m_width);
+  for (unsigned int i = 0; i < m_height; i++) {
+    unsigned char *row = I[i];
+    const uint64_t *words = &m_words[(size_t)i*m_words_per_row];
+    for (unsigned int j = 0; j < m_width; j++) {
+      row[j] = ((words[j >> 6] >> (j & 63)) & 1) ? value_true : value_false;
+    }
+  }
+}
+
+// Combine the 64 pixel words of one row with their west and east
+// neighbors; border_bit tells what enters at the image border (1 for the
+// erosion, 0 for the dilatation)
+static inline uint64_t vpShiftWest(const uint64_t *row, unsigned int k, unsigned int nwords,
+                                   uint64_t border_bit)
+{
+  // West neighbor of pixel j is bit j-1: shift towards the MSB
+  uint64_t v = row[k] << 1;
+  if (k > 0)
+    v |= row[k-1] >> 63;
+  else
+    v |= border_bit;
+  (void)nwords;
+  return v;
+}
+
+static inline uint64_t vpShiftEast(const uint64_t *row, unsigned int k, unsigned int nwords,
+                                   uint64_t east_in)
+{
+  // East neighbor of pixel j is bit j+1: shift towards the LSB;
+  // east_in holds the bit entering the last word at the image border
+  uint64_t v = row[k] >> 1;
+  if (k + 1 < nwords)
+    v |= row[k+1] << 63;
+  else
+    v |= east_in;
+  return v;
+}
+
+/*!
+  Shared word parallel 3x3 pass: for the erosion a pixel stays set when
+  all its neighbors are set (outside pixels being foreground), for the
+  dilatation a pixel becomes set when one neighbor is set (outside
+  pixels being background). Same conventions as vpImageMorphology.
+*/
+void vpBitImage::morphologyPass(bool erode, bool connexity8)
+{
+  if (m_height == 0 || m_width == 0)
+    return;
+
+  unsigned int nwords = m_words_per_row;
+  unsigned int tail_bits = m_width & 63;
+  uint64_t tail_mask = tail_bits ? ((((uint64_t)1) << tail_bits) - 1) : ~(uint64_t)0;
+  uint64_t full = ~(uint64_t)0;
+
+  // For the erosion the padding bits of the last word and the virtual
+  // rows above/below must read as foreground
+  m_buffer.assign(m_words.begin(), m_words.end());
+  if (erode && tail_bits) {
+    for (unsigned int i = 0; i < m_height; i++)
+      m_buffer[(size_t)i*nwords + nwords-1] |= ~tail_mask;
+  }
+
+  uint64_t border_bit = erode ? 1 : 0;
+  // Bit entering the east side of the row: after the right shift of
+  // vpShiftEast it must land on the last pixel position, i.e. bit
+  // tail_bits-1 of the last word, or bit 63 when the row fills the word
+  uint64_t east_in = 0;
+  if (erode)
+    east_in = tail_bits ? (((uint64_t)1) << (tail_bits-1)) : (((uint64_t)1) << 63);
+
+  m_result.assign((size_t)m_height*nwords, 0);
+  std::vector<uint64_t> &out = m_result;
+
+  for (unsigned int i = 0; i < m_height; i++) {
+    const uint64_t *cur = &m_buffer[(size_t)i*nwords];
+    const uint64_t *up = (i > 0) ? &m_buffer[(size_t)(i-1)*nwords] : NULL;
+    const uint64_t *down = (i+1 < m_height) ? &m_buffer[(size_t)(i+1)*nwords] : NULL;
+    uint64_t *dst = &out[(size_t)i*nwords];
+
+    for (unsigned int k = 0; k < nwords; k++) {
+      uint64_t c = cur[k];
+      uint64_t w = vpShiftWest(cur, k, nwords, border_bit);
+      uint64_t e = vpShiftEast(cur, k, nwords, east_in);
+      uint64_t u = up ? up[k] : (erode ? full : 0);
+      uint64_t d = down ? down[k] : (erode ? full : 0);
+
+      uint64_t res;
+      if (erode)
+        res = c & w & e & u & d;
+      else
+        res = c | w | e | u | d;
+
+      if (connexity8) {
+        uint64_t uw = up ? vpShiftWest(up, k, nwords, border_bit) : (erode ? full : 0);
+        uint64_t ue = up ? vpShiftEast(up, k, nwords, east_in) : (erode ? full : 0);
+        uint64_t dw = down ? vpShiftWest(down, k, nwords, border_bit) : (erode ? full : 0);
+        uint64_t de = down ? vpShiftEast(down, k, nwords, east_in) : (erode ? full : 0);
+        if (erode)
+          res &= uw & ue & dw & de;
+        else
+          res |= uw | ue | dw | de;
+      }
+
+      dst[k] = res;
+    }
+    // Keep the padding bits null
+    dst[nwords-1] &= tail_mask;
+  }
+
+  m_words.swap(m_result);
+}
+
+/*!
+  Erode the set pixels with a 3x3 structuring element, 64 pixels per
+  bitwise operation. Outside pixels are considered set, as in
+  vpImageMorphology::erosion().
+
+  \param connexity : Type of connexity: 4 or 8.
+*/
+void vpBitImage::erosion(const vpImageMorphology::vpConnexityType &connexity)
+{
+  morphologyPass(true, connexity == vpImageMorphology::CONNEXITY_8);
+}
+
+/*!
+  Dilate the set pixels with a 3x3 structuring element, 64 pixels per
+  bitwise operation. Outside pixels are considered cleared, as in
+  vpImageMorphology::dilatation().
+
+  \param connexity : Type of connexity: 4 or 8.
+*/
+void vpBitImage::dilatation(const vpImageMorphology::vpConnexityType &connexity)
+{
+  morphologyPass(false, connexity == vpImageMorphology::CONNEXITY_8);
+}
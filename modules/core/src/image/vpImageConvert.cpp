@@ -48,6 +48,37 @@
 
 // image
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThread.h>
+
+#if defined __ARM_NEON__ || defined __ARM_NEON
+#  include <arm_neon.h>
+#  define VISP_HAVE_NEON 1
+
+// Luminance of 4 widened pixels : the 16.16 fixed point counterpart of
+// the scalar 0.2126 R + 0.7152 G + 0.0722 B, accumulated in 32 bits and
+// truncated once so it stays within one grey level of the scalar path
+static inline uint16x4_t vpGrey4_NEON(const uint16x4_t &r, const uint16x4_t &g, const uint16x4_t &b)
+{
+  uint32x4_t acc = vmull_u16(r, vdup_n_u16(13933));
+  acc = vmlal_u16(acc, g, vdup_n_u16(46871));
+  acc = vmlal_u16(acc, b, vdup_n_u16(4732));
+  return vshrn_n_u32(acc, 16);
+}
+
+//Luminance of 16 pixels given as three planes
+static inline uint8x16_t vpGreyFromRGB_NEON(const uint8x16_t &r, const uint8x16_t &g, const uint8x16_t &b)
+{
+  uint16x8_t r_lo = vmovl_u8(vget_low_u8(r)), r_hi = vmovl_u8(vget_high_u8(r));
+  uint16x8_t g_lo = vmovl_u8(vget_low_u8(g)), g_hi = vmovl_u8(vget_high_u8(g));
+  uint16x8_t b_lo = vmovl_u8(vget_low_u8(b)), b_hi = vmovl_u8(vget_high_u8(b));
+
+  uint16x8_t grey_lo = vcombine_u16(vpGrey4_NEON(vget_low_u16(r_lo), vget_low_u16(g_lo), vget_low_u16(b_lo)),
+                                    vpGrey4_NEON(vget_high_u16(r_lo), vget_high_u16(g_lo), vget_high_u16(b_lo)));
+  uint16x8_t grey_hi = vcombine_u16(vpGrey4_NEON(vget_low_u16(r_hi), vget_low_u16(g_hi), vget_low_u16(b_hi)),
+                                    vpGrey4_NEON(vget_high_u16(r_hi), vget_high_u16(g_hi), vget_high_u16(b_hi)));
+  return vcombine_u8(vmovn_u16(grey_lo), vmovn_u16(grey_hi));
+}
+#endif
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #  include <emmintrin.h>
@@ -1178,6 +1209,43 @@ void vpImageConvert::convert(const yarp::sig::ImageOf< yarp::sig::PixelRgb > *sr
 
   \sa YUV422ToRGBa()
 */
+#if VISP_HAVE_SSE2
+// Extract byte \e index of each 32-bit group of two consecutive 16-byte
+// chunks in one vector of eight 16-bit lanes
+static inline __m128i vpExtractByteOf32(const __m128i &c0, const __m128i &c1, const int index)
+{
+  const __m128i mask = _mm_set1_epi32(0x000000FF);
+  __m128i b0 = _mm_and_si128(_mm_srli_epi32(c0, 8*index), mask);
+  __m128i b1 = _mm_and_si128(_mm_srli_epi32(c1, 8*index), mask);
+  return _mm_packs_epi32(b0, b1);
+}
+
+// Interleave the even/odd pixel planes and store 16 RGBA pixels, the
+// saturation to [0, 255] being performed by the unsigned byte packing
+static inline void vpStoreRGBaPixels_SSE2(unsigned char *d,
+                                          const __m128i &r_even, const __m128i &r_odd,
+                                          const __m128i &g_even, const __m128i &g_odd,
+                                          const __m128i &b_even, const __m128i &b_odd)
+{
+  __m128i r_lo = _mm_unpacklo_epi16(r_even, r_odd), r_hi = _mm_unpackhi_epi16(r_even, r_odd);
+  __m128i g_lo = _mm_unpacklo_epi16(g_even, g_odd), g_hi = _mm_unpackhi_epi16(g_even, g_odd);
+  __m128i b_lo = _mm_unpacklo_epi16(b_even, b_odd), b_hi = _mm_unpackhi_epi16(b_even, b_odd);
+
+  __m128i r8 = _mm_packus_epi16(r_lo, r_hi);
+  __m128i g8 = _mm_packus_epi16(g_lo, g_hi);
+  __m128i b8 = _mm_packus_epi16(b_lo, b_hi);
+  __m128i a8 = _mm_setzero_si128();
+
+  __m128i rg_lo = _mm_unpacklo_epi8(r8, g8), rg_hi = _mm_unpackhi_epi8(r8, g8);
+  __m128i ba_lo = _mm_unpacklo_epi8(b8, a8), ba_hi = _mm_unpackhi_epi8(b8, a8);
+
+  _mm_storeu_si128((__m128i *)d,      _mm_unpacklo_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *)(d+16), _mm_unpackhi_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *)(d+32), _mm_unpacklo_epi16(rg_hi, ba_hi));
+  _mm_storeu_si128((__m128i *)(d+48), _mm_unpackhi_epi16(rg_hi, ba_hi));
+}
+#endif
+
 void vpImageConvert::YUYVToRGBa(unsigned char* yuyv, unsigned char* rgba,
                                 unsigned int width, unsigned int height)
 {
@@ -1192,7 +1260,66 @@ void vpImageConvert::YUYVToRGBa(unsigned char* yuyv, unsigned char* rgba,
   d = rgba;
   while (h--) {
     int c = w >> 1;
-    while (c--) {
+
+#if VISP_HAVE_SSE2
+    // Eight macropixels (y0 u y1 v), sixteen RGBA pixels per iteration.
+    // The chroma terms are computed in 32-bit lanes with the very same
+    // integer expressions as the scalar loop below, so that both paths
+    // produce bitwise identical images.
+    const __m128i v_128 = _mm_set1_epi32(128);
+    for (; c >= 8; c -= 8) {
+      __m128i c0 = _mm_loadu_si128((const __m128i *)s);
+      __m128i c1 = _mm_loadu_si128((const __m128i *)(s+16));
+      s += 32;
+
+      __m128i v_y1 = vpExtractByteOf32(c0, c1, 0);
+      __m128i v_u16 = vpExtractByteOf32(c0, c1, 1);
+      __m128i v_y2 = vpExtractByteOf32(c0, c1, 2);
+      __m128i v_v16 = vpExtractByteOf32(c0, c1, 3);
+
+      // Widen the chroma to 32-bit lanes: the products (t*454, t*359,
+      // t*88 + t*183) overflow 16 bits
+      __m128i u_lo = _mm_sub_epi32(_mm_unpacklo_epi16(v_u16, _mm_setzero_si128()), v_128);
+      __m128i u_hi = _mm_sub_epi32(_mm_unpackhi_epi16(v_u16, _mm_setzero_si128()), v_128);
+      __m128i v_lo = _mm_sub_epi32(_mm_unpacklo_epi16(v_v16, _mm_setzero_si128()), v_128);
+      __m128i v_hi = _mm_sub_epi32(_mm_unpackhi_epi16(v_v16, _mm_setzero_si128()), v_128);
+
+      // t*454 = t*(256+128+64+4+2), t*359 = t*(256+64+32+4+2+1),
+      // t*88 = t*(64+16+8), t*183 = t*(128+32+16+4+2+1); shifts and adds
+      // keep the arithmetic exact
+#define VP_MUL454(t) _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(t,8), _mm_slli_epi32(t,7)), \
+                     _mm_add_epi32(_mm_slli_epi32(t,6), _mm_add_epi32(_mm_slli_epi32(t,2), _mm_slli_epi32(t,1))))
+#define VP_MUL359(t) _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(t,8), _mm_slli_epi32(t,6)), \
+                     _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(t,5), _mm_slli_epi32(t,2)), _mm_add_epi32(_mm_slli_epi32(t,1), t)))
+#define VP_MUL88(t)  _mm_add_epi32(_mm_slli_epi32(t,6), _mm_add_epi32(_mm_slli_epi32(t,4), _mm_slli_epi32(t,3)))
+#define VP_MUL183(t) _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(t,7), _mm_slli_epi32(t,5)), \
+                     _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(t,4), _mm_slli_epi32(t,2)), _mm_add_epi32(_mm_slli_epi32(t,1), t)))
+
+      __m128i cb_lo = _mm_srai_epi32(VP_MUL454(u_lo), 8);
+      __m128i cb_hi = _mm_srai_epi32(VP_MUL454(u_hi), 8);
+      __m128i cr_lo = _mm_srai_epi32(VP_MUL359(v_lo), 8);
+      __m128i cr_hi = _mm_srai_epi32(VP_MUL359(v_hi), 8);
+      __m128i cg_lo = _mm_srai_epi32(_mm_add_epi32(VP_MUL88(u_lo), VP_MUL183(v_lo)), 8);
+      __m128i cg_hi = _mm_srai_epi32(_mm_add_epi32(VP_MUL88(u_hi), VP_MUL183(v_hi)), 8);
+
+      __m128i v_cb = _mm_packs_epi32(cb_lo, cb_hi);
+      __m128i v_cr = _mm_packs_epi32(cr_lo, cr_hi);
+      __m128i v_cg = _mm_packs_epi32(cg_lo, cg_hi);
+
+      __m128i r1 = _mm_add_epi16(v_y1, v_cr), r2 = _mm_add_epi16(v_y2, v_cr);
+      __m128i g1 = _mm_sub_epi16(v_y1, v_cg), g2 = _mm_sub_epi16(v_y2, v_cg);
+      __m128i b1 = _mm_add_epi16(v_y1, v_cb), b2 = _mm_add_epi16(v_y2, v_cb);
+
+      vpStoreRGBaPixels_SSE2(d, r1, r2, g1, g2, b1, b2);
+      d += 64;
+    }
+#undef VP_MUL454
+#undef VP_MUL359
+#undef VP_MUL88
+#undef VP_MUL183
+#endif
+
+    while (c-- > 0) {
       y1 = *s++;
       cb = ((*s - 128) * 454) >> 8;
       cg = (*s++ - 128) * 88;
@@ -1291,12 +1418,22 @@ void vpImageConvert::YUYVToGrey(unsigned char* yuyv, unsigned char* grey, unsign
 {
   unsigned int i=0,j=0;
 
-  while( j < size*2)
+#if defined(VISP_HAVE_NEON)
+  //The luminance is every even byte of the y u y v stream
+  if (size >= 16) {
+    for (; i <= size - 16; i += 16, j += 32)
+      vst1q_u8(grey + i, vld2q_u8(yuyv + j).val[0]);
+  }
+#endif
+
+  while( i + 2 <= size)
     {
       grey[i++] = yuyv[j];
       grey[i++] = yuyv[j+2];
       j+=4;
     }
+  if (i < size) // odd pixel count : the pair loop above would overrun
+    grey[i] = yuyv[j];
 }
 
 
@@ -1436,7 +1573,59 @@ void vpImageConvert::YUV422ToRGBa(unsigned char* yuv, unsigned char* rgba, unsig
 
 #if 1
   //  std::cout << "call optimized convertYUV422ToRGBa()" << std::endl;
-  for( unsigned int i = size / 2; i; i-- ) {
+  unsigned int macropixels = size / 2;
+
+#if VISP_HAVE_SSE2
+  // Eight macropixels (u y0 v y1), sixteen RGBA pixels per iteration.
+  // The scalar loop below truncates (u-128)*0.354 and (v-128)*0.707
+  // towards zero; the same values are obtained on the absolute value
+  // with the 16.16 fixed point multipliers 23200 and 46330 before
+  // restoring the sign, so that both paths produce identical images
+  // (the alpha byte that the scalar path leaves untouched is set to 0
+  // as done by the other converters of the family).
+  {
+    const __m128i v_128 = _mm_set1_epi16(128);
+    const __m128i v_zero = _mm_setzero_si128();
+    const __m128i v_354 = _mm_set1_epi16(23200);
+    const __m128i v_707 = _mm_set1_epi16((short)46330);
+    for (; macropixels >= 8; macropixels -= 8) {
+      __m128i c0 = _mm_loadu_si128((const __m128i *)yuv);
+      __m128i c1 = _mm_loadu_si128((const __m128i *)(yuv+16));
+      yuv += 32;
+
+      __m128i v_u16 = vpExtractByteOf32(c0, c1, 0);
+      __m128i v_y0 = vpExtractByteOf32(c0, c1, 1);
+      __m128i v_v16 = vpExtractByteOf32(c0, c1, 2);
+      __m128i v_y1 = vpExtractByteOf32(c0, c1, 3);
+
+      __m128i t_u = _mm_sub_epi16(v_u16, v_128);
+      __m128i t_v = _mm_sub_epi16(v_v16, v_128);
+      __m128i abs_u = _mm_max_epi16(t_u, _mm_sub_epi16(v_zero, t_u));
+      __m128i abs_v = _mm_max_epi16(t_v, _mm_sub_epi16(v_zero, t_v));
+      __m128i neg_u = _mm_cmplt_epi16(t_u, v_zero);
+      __m128i neg_v = _mm_cmplt_epi16(t_v, v_zero);
+
+      // |t|*23200 >> 16 then sign restoration = (int)(t*0.354)
+      __m128i v_U = _mm_mulhi_epu16(abs_u, v_354);
+      v_U = _mm_sub_epi16(_mm_xor_si128(v_U, neg_u), neg_u);
+      __m128i v_V = _mm_mulhi_epu16(abs_v, v_707);
+      v_V = _mm_sub_epi16(_mm_xor_si128(v_V, neg_v), neg_v);
+
+      __m128i v_U5 = _mm_add_epi16(_mm_slli_epi16(v_U, 2), v_U);
+      __m128i v_V2 = _mm_slli_epi16(v_V, 1);
+      __m128i v_UV = _mm_sub_epi16(_mm_sub_epi16(v_zero, v_U), v_V);
+
+      __m128i r0 = _mm_add_epi16(v_y0, v_V2), r1 = _mm_add_epi16(v_y1, v_V2);
+      __m128i g0 = _mm_add_epi16(v_y0, v_UV), g1 = _mm_add_epi16(v_y1, v_UV);
+      __m128i b0 = _mm_add_epi16(v_y0, v_U5), b1 = _mm_add_epi16(v_y1, v_U5);
+
+      vpStoreRGBaPixels_SSE2(rgba, r0, r1, g0, g1, b0, b1);
+      rgba += 64;
+    }
+  }
+#endif
+
+  for( unsigned int i = macropixels; i; i-- ) {
     int U   = (int)((*yuv++ - 128) * 0.354);
     int U5  = 5*U;
     int Y0  = *yuv++;
@@ -1458,7 +1647,7 @@ void vpImageConvert::YUV422ToRGBa(unsigned char* yuv, unsigned char* rgba, unsig
     *rgba++ = (unsigned char)R;
     *rgba++ = (unsigned char)G;
     *rgba++ = (unsigned char)B;
-    rgba++;
+    *rgba++ = 0;
 
     //---
     R = Y1 + V2;
@@ -1473,7 +1662,7 @@ void vpImageConvert::YUV422ToRGBa(unsigned char* yuv, unsigned char* rgba, unsig
     *rgba++ = (unsigned char)R;
     *rgba++ = (unsigned char)G;
     *rgba++ = (unsigned char)B;
-    rgba++;
+    *rgba++ = 0;
   }
 
 #else
@@ -1614,12 +1803,22 @@ void vpImageConvert::YUV422ToGrey(unsigned char* yuv, unsigned char* grey, unsig
 {
  unsigned int i=0,j=0;
 
- while( j < size*2)
+#if defined(VISP_HAVE_NEON)
+ //The luminance is every odd byte of the u y v y stream
+ if (size >= 16) {
+   for (; i <= size - 16; i += 16, j += 32)
+     vst1q_u8(grey + i, vld2q_u8(yuv + j).val[1]);
+ }
+#endif
+
+ while( i + 2 <= size)
  {
    grey[i++] = yuv[j+1];
    grey[i++] = yuv[j+3];
    j+=4;
  }
+ if (i < size) // odd pixel count : the pair loop above would overrun
+   grey[i] = yuv[j+1];
 }
 
 /*!
@@ -2854,9 +3053,130 @@ void vpImageConvert::RGBaToRGB(unsigned char* rgba, unsigned char* rgb, unsigned
   http://www.poynton.com/notes/colour_and_gamma/ColorFAQ.html
 
 */
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+namespace {
+  struct GreyConversion_Param_t {
+    unsigned char *m_src;
+    unsigned char *m_grey;
+    unsigned int m_size;        //!< Number of pixels of the slice
+    unsigned int m_pixel_size;  //!< 3 for RGB, 4 for RGBa
+
+    GreyConversion_Param_t(unsigned char *src, unsigned char *grey,
+        const unsigned int size, const unsigned int pixel_size) :
+      m_src(src), m_grey(grey), m_size(size), m_pixel_size(pixel_size) {
+    }
+  };
+
+  vpThread::Return greyConversionThread(vpThread::Args args) {
+    GreyConversion_Param_t *conversion_param = ( (GreyConversion_Param_t *) args );
+    if (conversion_param->m_pixel_size == 4)
+      vpImageConvert::RGBaToGrey(conversion_param->m_src, conversion_param->m_grey, conversion_param->m_size);
+    else
+      vpImageConvert::RGBToGrey(conversion_param->m_src, conversion_param->m_grey, conversion_param->m_size);
+    return 0;
+  }
+
+  // Cut the image in per-thread slices whose sizes are multiples of 16
+  // pixels (except the last) so that the vectorized kernels process the
+  // same pixel groups as the single threaded call and the result stays
+  // bitwise identical
+  void greyConversionMultithread(unsigned char *src, unsigned char *grey, unsigned int size,
+      unsigned int pixel_size, unsigned int nbThreads) {
+    std::vector<vpThread *> threadpool;
+    std::vector<GreyConversion_Param_t *> conversionParams;
+
+    unsigned int step = (size / nbThreads) & ~15u;
+    unsigned int start = 0;
+
+    for (unsigned int index = 0; index < nbThreads; index++) {
+      unsigned int slice = (index == nbThreads-1) ? size - start : step;
+      GreyConversion_Param_t *conversion_param = new GreyConversion_Param_t(
+            src + start*pixel_size, grey + start, slice, pixel_size);
+      conversionParams.push_back(conversion_param);
+      threadpool.push_back(new vpThread((vpThread::Fn) greyConversionThread, (vpThread::Args) conversion_param));
+      start += slice;
+    }
+
+    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
+      threadpool[cpt]->join();
+    }
+
+    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
+      delete threadpool[cpt];
+      delete conversionParams[cpt];
+    }
+  }
+}
+#endif
+
+/*!
+  Convert a RGB image to a greyscale one, the pixels being spread over
+  \e nbThreads threads. Same result as the single threaded call. The
+  threaded path only applies to non flipped conversions; with \e flip
+  the single threaded code is used.
+
+  \param rgb : Input RGB image buffer.
+  \param grey : Output greyscale buffer, allocated by the caller.
+  \param width, height : Image size.
+  \param flip : When true, flip the image vertically.
+  \param nbThreads : Number of threads to use.
+*/
+void vpImageConvert::RGBToGrey(unsigned char* rgb, unsigned char* grey,
+                               unsigned int width, unsigned int height, bool flip,
+                               unsigned int nbThreads)
+{
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+  unsigned int size = width*height;
+  if (!flip && nbThreads > 1 && size > nbThreads*16) {
+    greyConversionMultithread(rgb, grey, size, 3, nbThreads);
+    return;
+  }
+#else
+  (void)nbThreads;
+#endif
+  RGBToGrey(rgb, grey, width, height, flip);
+}
+
+/*!
+  Convert a RGBa image to a greyscale one, the pixel rows being spread
+  over \e nbThreads threads. Same result as the single threaded call.
+
+  \param rgba : Input RGBa image buffer.
+  \param grey : Output greyscale buffer, allocated by the caller.
+  \param size : Image size in pixels.
+  \param nbThreads : Number of threads to use.
+*/
+void vpImageConvert::RGBaToGrey(unsigned char* rgba, unsigned char* grey, unsigned int size, unsigned int nbThreads)
+{
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+  if (nbThreads > 1 && size > nbThreads*16) {
+    greyConversionMultithread(rgba, grey, size, 4, nbThreads);
+    return;
+  }
+#else
+  (void)nbThreads;
+#endif
+  RGBaToGrey(rgba, grey, size);
+}
+
 void vpImageConvert::RGBToGrey(unsigned char* rgb, unsigned char* grey, unsigned int size)
 {
-#if VISP_HAVE_SSSE3
+#if defined(VISP_HAVE_NEON)
+  unsigned int i = 0;
+  if (size >= 16) {
+    for (; i <= size - 16; i += 16, rgb += 48, grey += 16) {
+      uint8x16x3_t px = vld3q_u8(rgb); //de-interleaved R, G, B planes
+      vst1q_u8(grey, vpGreyFromRGB_NEON(px.val[0], px.val[1], px.val[2]));
+    }
+  }
+  for (; i < size; i++) {
+    *grey = (unsigned char) (0.2126 * (*rgb)
+      + 0.7152 * (*(rgb + 1))
+      + 0.0722 * (*(rgb + 2)) );
+    rgb += 3;
+    ++grey;
+  }
+#elif VISP_HAVE_SSSE3
   unsigned int i = 0;
 
   if(size >= 16) {
@@ -2990,7 +3310,22 @@ void vpImageConvert::RGBToGrey(unsigned char* rgb, unsigned char* grey, unsigned
 */
 void vpImageConvert::RGBaToGrey(unsigned char* rgba, unsigned char* grey, unsigned int size)
 {
-#if VISP_HAVE_SSSE3
+#if defined(VISP_HAVE_NEON)
+  unsigned int i = 0;
+  if (size >= 16) {
+    for (; i <= size - 16; i += 16, rgba += 64, grey += 16) {
+      uint8x16x4_t px = vld4q_u8(rgba); //de-interleaved R, G, B, A planes
+      vst1q_u8(grey, vpGreyFromRGB_NEON(px.val[0], px.val[1], px.val[2]));
+    }
+  }
+  for (; i < size; i++) {
+    *grey = (unsigned char) (0.2126 * (*rgba)
+      + 0.7152 * (*(rgba + 1))
+      + 0.0722 * (*(rgba + 2)) );
+    rgba += 4;
+    ++grey;
+  }
+#elif VISP_HAVE_SSSE3
   unsigned int i = 0;
 
   if(size >= 16) {
@@ -4373,3 +4708,167 @@ void vpImageConvert::RGBToHSV(const unsigned char *rgb, unsigned char *hue, unsi
  * c-basic-offset: 2
  * End:
  */
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+// Shared bilinear demosaicing kernel: (red_row, red_col) give the parity
+// of the red sites for the pattern. The borders use mirrored neighbors.
+// The inner rows are free of any branch on the pixel position (the
+// pattern parity is hoisted in the two-by-two phase), which lets the
+// compiler vectorize the accumulations.
+static void vpBayerToRGBaBilinear(const unsigned char *bayer, unsigned char *rgba,
+                                  unsigned int width, unsigned int height,
+                                  unsigned int red_row, unsigned int red_col)
+{
+  // A Bayer mosaic needs at least one full 2x2 tile; the mirrored
+  // neighbors would read out of the buffer below that
+  if (width < 2 || height < 2)
+    return;
+
+  for (unsigned int i = 0; i < height; i++) {
+    // Mirrored row neighbors on the borders
+    const unsigned char *rm = bayer + (size_t)(i > 0 ? i-1 : i+1)*width;
+    const unsigned char *r0 = bayer + (size_t)i*width;
+    const unsigned char *rp = bayer + (size_t)(i+1 < height ? i+1 : i-1)*width;
+    unsigned char *dst = rgba + (size_t)i*width*4;
+
+    unsigned int row_phase = (i + red_row) & 1; // 0: red/green row, 1: green/blue row
+
+    for (unsigned int j = 0; j < width; j++) {
+      unsigned int jm = j > 0 ? j-1 : j+1;
+      unsigned int jp = j+1 < width ? j+1 : j-1;
+      unsigned int col_phase = (j + red_col) & 1;
+      unsigned int r, g, b;
+
+      if (row_phase == 0) {
+        if (col_phase == 0) {
+          // Red site
+          r = r0[j];
+          g = (r0[jm] + r0[jp] + rm[j] + rp[j] + 2) >> 2;
+          b = (rm[jm] + rm[jp] + rp[jm] + rp[jp] + 2) >> 2;
+        }
+        else {
+          // Green site on a red row
+          r = (r0[jm] + r0[jp] + 1) >> 1;
+          g = r0[j];
+          b = (rm[j] + rp[j] + 1) >> 1;
+        }
+      }
+      else {
+        if (col_phase == 0) {
+          // Green site on a blue row
+          r = (rm[j] + rp[j] + 1) >> 1;
+          g = r0[j];
+          b = (r0[jm] + r0[jp] + 1) >> 1;
+        }
+        else {
+          // Blue site
+          r = (rm[jm] + rm[jp] + rp[jm] + rp[jp] + 2) >> 2;
+          g = (r0[jm] + r0[jp] + rm[j] + rp[j] + 2) >> 2;
+          b = r0[j];
+        }
+      }
+
+      dst[4*j]   = (unsigned char)r;
+      dst[4*j+1] = (unsigned char)g;
+      dst[4*j+2] = (unsigned char)b;
+      dst[4*j+3] = 0;
+    }
+  }
+}
+#endif
+
+/*!
+  Bilinear demosaicing of a RGGB Bayer pattern image in a RGBa buffer
+  allocated by the caller (4 bytes per pixel, alpha set to 0). The
+  missing color components are interpolated from the two or four
+  closest sites of the mosaic, with mirrored neighbors on the borders.
+
+  \param bayer : Input raw Bayer image.
+  \param rgba : Output RGBa buffer.
+  \param width, height : Image size.
+*/
+void vpImageConvert::demosaicRGGBToRGBa(const unsigned char *bayer, unsigned char *rgba,
+                                        unsigned int width, unsigned int height)
+{
+  vpBayerToRGBaBilinear(bayer, rgba, width, height, 0, 0);
+}
+
+/*!
+  Bilinear demosaicing of a BGGR Bayer pattern image, see
+  demosaicRGGBToRGBa().
+*/
+void vpImageConvert::demosaicBGGRToRGBa(const unsigned char *bayer, unsigned char *rgba,
+                                        unsigned int width, unsigned int height)
+{
+  vpBayerToRGBaBilinear(bayer, rgba, width, height, 1, 1);
+}
+
+/*!
+  Bilinear demosaicing of a GBRG Bayer pattern image, see
+  demosaicRGGBToRGBa().
+*/
+void vpImageConvert::demosaicGBRGToRGBa(const unsigned char *bayer, unsigned char *rgba,
+                                        unsigned int width, unsigned int height)
+{
+  vpBayerToRGBaBilinear(bayer, rgba, width, height, 1, 0);
+}
+
+/*!
+  Bilinear demosaicing of a GRBG Bayer pattern image, see
+  demosaicRGGBToRGBa().
+*/
+void vpImageConvert::demosaicGRBGToRGBa(const unsigned char *bayer, unsigned char *rgba,
+                                        unsigned int width, unsigned int height)
+{
+  vpBayerToRGBaBilinear(bayer, rgba, width, height, 0, 1);
+}
+
+/*!
+  Convert a color image to a greyscale one and compute the mean, minimum
+  and maximum grey levels in the same pass over the pixels. An
+  auto-exposure or auto-gain loop that converts the frame then calls the
+  vpImage statistics traverses the image twice; this entry point fuses
+  the two while the pixels are hot in cache.
+
+  The grey levels are computed with the same luminance weights as
+  convert(const vpImage<vpRGBa> &, vpImage<unsigned char> &); the
+  statistics describe the produced greyscale image.
+
+  \param src : Input color image.
+  \param dest : Output greyscale image.
+  \param mean : Mean grey level of \e dest.
+  \param min : Minimum grey level of \e dest.
+  \param max : Maximum grey level of \e dest.
+*/
+void vpImageConvert::convertWithStats(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest,
+                                      double &mean, unsigned char &min, unsigned char &max)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+
+  unsigned int size = src.getSize();
+  if (size == 0) {
+    mean = 0.;
+    min = 0;
+    max = 0;
+    return;
+  }
+
+  const unsigned char *rgba = (const unsigned char *)src.bitmap;
+  unsigned char *grey = dest.bitmap;
+  double sum = 0.; // exact for any realistic image size, unlike a 32-bit integer
+  unsigned char vmin = 255, vmax = 0;
+
+  for (unsigned int i = 0; i < size; i++, rgba += 4) {
+    unsigned char g = (unsigned char)(0.2126 * rgba[0]
+        + 0.7152 * rgba[1]
+        + 0.0722 * rgba[2]);
+    grey[i] = g;
+    sum += g;
+    if (g < vmin) vmin = g;
+    if (g > vmax) vmax = g;
+  }
+
+  mean = sum / size;
+  min = vmin;
+  max = vmax;
+}
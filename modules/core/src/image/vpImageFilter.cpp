@@ -37,6 +37,27 @@
 
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThread.h>
+
+#if defined __ARM_NEON__ || defined __ARM_NEON
+#  include <arm_neon.h>
+#  include <cstring>
+#  define VISP_HAVE_NEON 1
+
+// 16 taps of the 1 4 6 4 1 pyramid kernel in 16 bit : the sum is at
+// most 16 * 255, the >> 4 truncation matches the scalar /16.
+static inline uint8x16_t vpGaussPyr16_NEON(const uint8x16_t &p0, const uint8x16_t &p1, const uint8x16_t &p2,
+                                           const uint8x16_t &p3, const uint8x16_t &p4)
+{
+  uint16x8_t lo = vaddl_u8(vget_low_u8(p0), vget_low_u8(p4));
+  lo = vmlaq_n_u16(lo, vaddl_u8(vget_low_u8(p1), vget_low_u8(p3)), 4);
+  lo = vmlaq_n_u16(lo, vmovl_u8(vget_low_u8(p2)), 6);
+  uint16x8_t hi = vaddl_u8(vget_high_u8(p0), vget_high_u8(p4));
+  hi = vmlaq_n_u16(hi, vaddl_u8(vget_high_u8(p1), vget_high_u8(p3)), 4);
+  hi = vmlaq_n_u16(hi, vmovl_u8(vget_high_u8(p2)), 6);
+  return vcombine_u8(vshrn_n_u16(lo, 4), vshrn_n_u16(hi, 4));
+}
+#endif
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 #  include <opencv2/imgproc/imgproc.hpp>
 #elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020101)
@@ -288,6 +309,140 @@ void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<double>& dI
     }
   }
 }
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+namespace {
+  struct SepFilter_Param_t {
+    const vpImage<unsigned char> *m_I;  //!< Input of the horizontal pass, NULL for the vertical one
+    const vpImage<double> *m_Itmp;      //!< Input of the vertical pass
+    vpImage<double> *m_out;
+    const double *m_filter;
+    unsigned int m_size;
+    unsigned int m_row_start;
+    unsigned int m_row_end;
+
+    SepFilter_Param_t(const vpImage<unsigned char> *I, const vpImage<double> *Itmp,
+        vpImage<double> *out, const double *filter, const unsigned int size,
+        const unsigned int row_start, const unsigned int row_end) :
+      m_I(I), m_Itmp(Itmp), m_out(out), m_filter(filter), m_size(size),
+      m_row_start(row_start), m_row_end(row_end) {
+    }
+  };
+
+  // Horizontal pass on a band of rows; every row is independent
+  vpThread::Return sepFilterXThread(vpThread::Args args) {
+    SepFilter_Param_t *p = ( (SepFilter_Param_t *) args );
+    const vpImage<unsigned char> &I = *(p->m_I);
+    vpImage<double> &dIx = *(p->m_out);
+    const double *filter = p->m_filter;
+    unsigned int size = p->m_size;
+    for (unsigned int i = p->m_row_start; i < p->m_row_end; i++) {
+      for (unsigned int j = 0; j < (size-1)/2; j++)
+        dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
+      for (unsigned int j = (size-1)/2; j < I.getWidth()-(size-1)/2; j++)
+        dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
+      for (unsigned int j = I.getWidth()-(size-1)/2; j < I.getWidth(); j++)
+        dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
+    }
+    return 0;
+  }
+
+  // Vertical pass on a band of rows; the input is the full horizontal
+  // pass output so the bands only read shared data
+  vpThread::Return sepFilterYThread(vpThread::Args args) {
+    SepFilter_Param_t *p = ( (SepFilter_Param_t *) args );
+    const vpImage<double> &Itmp = *(p->m_Itmp);
+    vpImage<double> &dIy = *(p->m_out);
+    const double *filter = p->m_filter;
+    unsigned int size = p->m_size;
+    unsigned int half = (size-1)/2;
+    for (unsigned int i = p->m_row_start; i < p->m_row_end; i++) {
+      if (i < half) {
+        for (unsigned int j = 0; j < Itmp.getWidth(); j++)
+          dIy[i][j] = vpImageFilter::filterYTopBorder(Itmp, i, j, filter, size);
+      }
+      else if (i >= Itmp.getHeight()-half) {
+        for (unsigned int j = 0; j < Itmp.getWidth(); j++)
+          dIy[i][j] = vpImageFilter::filterYBottomBorder(Itmp, i, j, filter, size);
+      }
+      else {
+        for (unsigned int j = 0; j < Itmp.getWidth(); j++)
+          dIy[i][j] = vpImageFilter::filterY(Itmp, i, j, filter, size);
+      }
+    }
+    return 0;
+  }
+
+  void sepFilterRunPass(vpThread::Fn fn, const vpImage<unsigned char> *I,
+      const vpImage<double> *Itmp, vpImage<double> *out,
+      const double *filter, unsigned int size,
+      unsigned int height, unsigned int nbThreads) {
+    std::vector<vpThread *> threadpool;
+    std::vector<SepFilter_Param_t *> params;
+    unsigned int step = height / nbThreads;
+
+    for (unsigned int index = 0; index < nbThreads; index++) {
+      unsigned int row_start = index*step;
+      unsigned int row_end = (index == nbThreads-1) ? height : row_start+step;
+      SepFilter_Param_t *param = new SepFilter_Param_t(I, Itmp, out, filter, size, row_start, row_end);
+      params.push_back(param);
+      threadpool.push_back(new vpThread(fn, (vpThread::Args) param));
+    }
+    for (size_t cpt = 0; cpt < threadpool.size(); cpt++)
+      threadpool[cpt]->join();
+    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
+      delete threadpool[cpt];
+      delete params[cpt];
+    }
+  }
+}
+#endif
+
+/*!
+  Separable convolution of the image: the horizontal kernel \e filterX
+  is applied on every row then the vertical kernel \e filterY on every
+  column, with the same border handling as filterX() and filterY().
+  The rows of each pass are spread over \e nbThreads threads; the two
+  passes are identical to calling filterX() then filterY() so the
+  result does not depend on the number of threads.
+
+  \param I : Input image.
+  \param If : Filtered image.
+  \param filterX : Horizontal half kernel, as for filterX().
+  \param sizeX : Horizontal kernel size (odd).
+  \param filterY : Vertical half kernel, as for filterY().
+  \param sizeY : Vertical kernel size (odd).
+  \param nbThreads : Number of threads per pass.
+*/
+void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double>& If,
+                              const double *filterX, unsigned int sizeX,
+                              const double *filterY, unsigned int sizeY,
+                              unsigned int nbThreads)
+{
+  vpImage<double> Itmp;
+
+  bool use_single_thread;
+#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+  use_single_thread = true;
+#else
+  use_single_thread = (nbThreads == 0 || nbThreads == 1);
+#endif
+  if (!use_single_thread && I.getHeight() < nbThreads)
+    use_single_thread = true;
+
+  if (use_single_thread) {
+    vpImageFilter::filterX(I, Itmp, filterX, sizeX);
+    vpImageFilter::filterY(Itmp, If, filterY, sizeY);
+    return;
+  }
+
+#if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
+  Itmp.resize(I.getHeight(), I.getWidth());
+  If.resize(I.getHeight(), I.getWidth());
+  sepFilterRunPass((vpThread::Fn) sepFilterXThread, &I, NULL, &Itmp, filterX, sizeX, I.getHeight(), nbThreads);
+  sepFilterRunPass((vpThread::Fn) sepFilterYThread, NULL, &Itmp, &If, filterY, sizeY, I.getHeight(), nbThreads);
+#endif
+}
+
 void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double>& dIy, const double *filter,unsigned  int size)
 {
   dIy.resize(I.getHeight(),I.getWidth()) ;
@@ -664,7 +819,26 @@ void vpImageFilter::getGaussXPyramidal(const vpImage<unsigned char> &I, vpImage<
   for (unsigned int i=0 ; i < I.getHeight() ; i++)
   {
     GI[i][0]=I[i][0];
-    for (unsigned int j=1 ; j < w-1 ; j++)
+    unsigned int j = 1;
+#if defined(VISP_HAVE_NEON)
+    //16 outputs per step need the source bytes 2j-2 .. 2j+61 : the even
+    //offsets are the 1 6 1 taps, the odd ones the 4 4 taps
+    if (I.getWidth() >= 63) {
+      for (; j + 16 <= w - 1 && 2*j + 61 <= I.getWidth() - 1; j += 16)
+      {
+        const unsigned char *src = &I[i][2*j - 2];
+        uint8x16x2_t s0 = vld2q_u8(src);
+        uint8x16x2_t s1 = vld2q_u8(src + 32);
+        uint8x16_t e0 = s0.val[0];
+        uint8x16_t e1 = vextq_u8(s0.val[0], s1.val[0], 1);
+        uint8x16_t e2 = vextq_u8(s0.val[0], s1.val[0], 2);
+        uint8x16_t o0 = s0.val[1];
+        uint8x16_t o1 = vextq_u8(s0.val[1], s1.val[1], 1);
+        vst1q_u8(&GI[i][j], vpGaussPyr16_NEON(e0, o0, e1, o1, e2));
+      }
+    }
+#endif
+    for (; j < w-1 ; j++)
     {
       GI[i][j]=vpImageFilter::filterGaussXPyramidal(I,i,2*j);
     }
@@ -692,6 +866,25 @@ void vpImageFilter::getGaussYPyramidal(const vpImage<unsigned char> &I, vpImage<
   unsigned int h = I.getHeight()/2;
 
   GI.resize(h, I.getWidth()) ;
+#if defined(VISP_HAVE_NEON)
+  //Row major traversal : the five source rows of one output row are
+  //contiguous in j, 16 columns per step
+  memcpy(GI[0], I[0], I.getWidth());
+  for (unsigned int i=1 ; i < h-1 ; i++)
+  {
+    const unsigned char *r0 = I[2*i - 2], *r1 = I[2*i - 1], *r2 = I[2*i];
+    const unsigned char *r3 = I[2*i + 1], *r4 = I[2*i + 2];
+    unsigned int j = 0;
+    if (I.getWidth() >= 16) {
+      for (; j + 16 <= I.getWidth(); j += 16)
+        vst1q_u8(&GI[i][j], vpGaussPyr16_NEON(vld1q_u8(r0 + j), vld1q_u8(r1 + j), vld1q_u8(r2 + j),
+                                              vld1q_u8(r3 + j), vld1q_u8(r4 + j)));
+    }
+    for (; j < I.getWidth(); j++)
+      GI[i][j]=vpImageFilter::filterGaussYPyramidal(I,2*i,j);
+  }
+  memcpy(GI[h-1], I[2*h-1], I.getWidth());
+#else
   for (unsigned int j=0 ; j < I.getWidth() ; j++)
   {
     GI[0][j]=I[0][j];
@@ -702,6 +895,106 @@ void vpImageFilter::getGaussYPyramidal(const vpImage<unsigned char> &I, vpImage<
     GI[h-1][j]=I[2*h-1][j];
   }
 #endif
+#endif
 }
 
 
+
+/*!
+  Compute the horizontal and vertical Sobel gradients of the image in
+  one traversal, the rows being spread over the available threads with
+  OpenMP. The one pixel border of the outputs is set to zero, as done
+  by getGradX() and getGradY().
+
+  \param I : Input image.
+  \param GIx : Horizontal gradient (Sobel x kernel).
+  \param GIy : Vertical gradient (Sobel y kernel).
+*/
+void vpImageFilter::sobelGradient(const vpImage<unsigned char> &I,
+                                  vpImage<double> &GIx, vpImage<double> &GIy)
+{
+  unsigned int height = I.getHeight(), width = I.getWidth();
+  GIx.resize(height, width);
+  GIy.resize(height, width);
+
+  if (height < 3 || width < 3) {
+    GIx = 0.;
+    GIy = 0.;
+    return;
+  }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i = 1; i < (int)height-1; i++) {
+    const unsigned char *r0 = I[(unsigned int)i-1];
+    const unsigned char *r1 = I[(unsigned int)i];
+    const unsigned char *r2 = I[(unsigned int)i+1];
+    double *gx = GIx[(unsigned int)i];
+    double *gy = GIy[(unsigned int)i];
+    gx[0] = 0.; gy[0] = 0.;
+    gx[width-1] = 0.; gy[width-1] = 0.;
+    for (unsigned int j = 1; j < width-1; j++) {
+      // Sobel taps shared by the two derivatives: one image traversal
+      double a = r0[j-1], b = r0[j], c = r0[j+1];
+      double d = r1[j-1],             e = r1[j+1];
+      double f = r2[j-1], g = r2[j], h = r2[j+1];
+      gx[j] = (c + 2*e + h) - (a + 2*d + f);
+      gy[j] = (f + 2*g + h) - (a + 2*b + c);
+    }
+  }
+  for (unsigned int j = 0; j < width; j++) {
+    GIx[0][j] = GIy[0][j] = 0.;
+    GIx[height-1][j] = GIy[height-1][j] = 0.;
+  }
+}
+
+/*!
+  Compute in one fused pass the Sobel gradient magnitude
+  \f$ \sqrt{g_x^2+g_y^2} \f$ and orientation \f$ \mbox{atan2}(g_y, g_x) \f$
+  of the image, without materializing the two gradient images. The one
+  pixel border is set to zero.
+
+  \param I : Input image.
+  \param Gm : Gradient magnitude.
+  \param Go : Gradient orientation in radians, in \f$ [-\pi, \pi] \f$.
+*/
+void vpImageFilter::gradientMagnitudeOrientation(const vpImage<unsigned char> &I,
+                                                 vpImage<double> &Gm, vpImage<double> &Go)
+{
+  unsigned int height = I.getHeight(), width = I.getWidth();
+  Gm.resize(height, width);
+  Go.resize(height, width);
+
+  if (height < 3 || width < 3) {
+    Gm = 0.;
+    Go = 0.;
+    return;
+  }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i = 1; i < (int)height-1; i++) {
+    const unsigned char *r0 = I[(unsigned int)i-1];
+    const unsigned char *r1 = I[(unsigned int)i];
+    const unsigned char *r2 = I[(unsigned int)i+1];
+    double *gm = Gm[(unsigned int)i];
+    double *go = Go[(unsigned int)i];
+    gm[0] = 0.; go[0] = 0.;
+    gm[width-1] = 0.; go[width-1] = 0.;
+    for (unsigned int j = 1; j < width-1; j++) {
+      double a = r0[j-1], b = r0[j], c = r0[j+1];
+      double d = r1[j-1],             e = r1[j+1];
+      double f = r2[j-1], g = r2[j], h = r2[j+1];
+      double gx = (c + 2*e + h) - (a + 2*d + f);
+      double gy = (f + 2*g + h) - (a + 2*b + c);
+      gm[j] = sqrt(gx*gx + gy*gy);
+      go[j] = atan2(gy, gx);
+    }
+  }
+  for (unsigned int j = 0; j < width; j++) {
+    Gm[0][j] = Go[0][j] = 0.;
+    Gm[height-1][j] = Go[height-1][j] = 0.;
+  }
+}
@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Multi-level image pyramid with buffers reused between the frames.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpException.h>
+
+vpImagePyramid::vpImagePyramid()
+  : m_levels()
+{
+}
+
+vpImagePyramid::~vpImagePyramid()
+{
+  for (size_t i = 0; i < m_levels.size(); i++)
+    delete m_levels[i];
+}
+
+/*!
+  Build or rebuild the pyramid from the image \e I. Level 0 maps \e I
+  without any copy; level \e i holds \e I decimated by \f$2^i\f$ with a
+  nearest neighbor subsampling. The level buffers are kept between the
+  calls so that rebuilding the pyramid of a video stream allocates
+  nothing after the first frame.
+
+  \param I : Input image, which must stay alive while level 0 is used.
+  \param nbLevels : Number of levels, at least 1.
+*/
+void vpImagePyramid::build(const vpImage<unsigned char> &I, unsigned int nbLevels)
+{
+  if (nbLevels == 0) {
+    throw(vpException(vpException::badValue,
+                      "Cannot build an image pyramid without any level")) ;
+  }
+
+  // Drop the supernumerary levels of a previous deeper pyramid
+  while (m_levels.size() > nbLevels) {
+    delete m_levels.back();
+    m_levels.pop_back();
+  }
+  while (m_levels.size() < nbLevels)
+    m_levels.push_back(new vpImage<unsigned char>());
+
+  // Level 0: zero-copy mapping of the input image
+  m_levels[0]->init(I.bitmap, I.getHeight(), I.getWidth(), false);
+
+  unsigned int scale = 1;
+  for (unsigned int i = 1; i < nbLevels; i++) {
+    scale *= 2;
+    unsigned int height = I.getHeight() / scale;
+    unsigned int width = I.getWidth() / scale;
+    vpImage<unsigned char> &level = *m_levels[i];
+    level.resize(height, width);
+
+    // Same nearest neighbor decimation as the pyramidal trackers
+    for (unsigned int k = 0, ii = 0; k < height; k += 1, ii += scale) {
+      const unsigned char *src = I[ii];
+      unsigned char *dst = level[k];
+      for (unsigned int l = 0, jj = 0; l < width; l += 1, jj += scale) {
+        dst[l] = src[jj];
+      }
+    }
+  }
+}
+
+/*!
+  Return the image of the requested pyramid level, level 0 being the
+  input image itself.
+
+  \param level : Level index in [0, getNbLevels()-1].
+*/
+const vpImage<unsigned char> &vpImagePyramid::getLevel(unsigned int level) const
+{
+  if (level >= m_levels.size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot get level %d of a %d level image pyramid",
+                      level, m_levels.size())) ;
+  }
+  return *m_levels[level];
+}
@@ -35,8 +35,14 @@
  *
  *****************************************************************************/
 
+#include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImageTools.h>
 
+#if defined __ARM_NEON__ || defined __ARM_NEON
+#  include <arm_neon.h>
+#  define VISP_HAVE_NEON 1
+#endif
+
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #  include <emmintrin.h>
 #  define VISP_HAVE_SSE2 1
@@ -128,6 +134,83 @@ void vpImageTools::changeLUT(vpImage<unsigned char>& I,
     }
 }
 
+/*!
+  Compute the Otsu threshold of an image : the gray level that maximizes
+  the between-class variance of the histogram, separating the image into
+  a dark and a bright class without any manual tuning.
+
+  \param I : Input image.
+  \param nbThreads : Number of threads the histogram computation spreads
+  the image rows over.
+
+  \return The threshold \e t : pixels of value less than or equal to
+  \e t belong to the dark class.
+
+  \sa binariseOtsu(), vpHistogram::calculate()
+*/
+unsigned char vpImageTools::computeOtsuThreshold(const vpImage<unsigned char> &I,
+                                                 const unsigned int nbThreads)
+{
+  vpHistogram histogram;
+  histogram.calculate(I, 256, nbThreads);
+
+  double total = (double)I.getSize();
+  double sumAll = 0.;
+  for (unsigned int l = 0; l < 256; l++)
+    sumAll += l * (double)histogram[(unsigned char)l];
+
+  double sumBackground = 0., weightBackground = 0.;
+  double maxVariance = -1.;
+  unsigned char threshold = 0;
+  for (unsigned int l = 0; l < 256; l++) {
+    weightBackground += (double)histogram[(unsigned char)l];
+    if (weightBackground <= 0.)
+      continue;
+    double weightForeground = total - weightBackground;
+    if (weightForeground <= 0.)
+      break;
+    sumBackground += l * (double)histogram[(unsigned char)l];
+
+    double meanBackground = sumBackground / weightBackground;
+    double meanForeground = (sumAll - sumBackground) / weightForeground;
+    double variance = weightBackground * weightForeground
+        * (meanBackground - meanForeground) * (meanBackground - meanForeground);
+    if (variance > maxVariance) {
+      maxVariance = variance;
+      threshold = (unsigned char)l;
+    }
+  }
+  return threshold;
+}
+
+/*!
+  Binarise an image with the Otsu automatic threshold : pixels of the
+  dark class (values less than or equal to the computeOtsuThreshold()
+  of the image) are set to \e value1, the others to \e value2.
+
+  \param I : Image to binarise.
+  \param value1 : Value of the dark class.
+  \param value2 : Value of the bright class.
+  \param useLUT : If true the thresholding goes through the LUT fast
+  path of binarise().
+  \param nbThreads : Number of threads used by both the histogram
+  computation and the LUT application.
+
+  \sa binarise(), computeOtsuThreshold()
+*/
+void vpImageTools::binariseOtsu(vpImage<unsigned char> &I,
+                                unsigned char value1, unsigned char value2, const bool useLUT,
+                                const unsigned int nbThreads)
+{
+  unsigned char threshold = computeOtsuThreshold(I, nbThreads);
+  if (threshold == 255) { // degenerate histogram : everything is dark class
+    binarise(I, (unsigned char)255, (unsigned char)255, value1, value1, value1, useLUT, nbThreads);
+    return;
+  }
+  binarise(I, (unsigned char)(threshold + 1), (unsigned char)255,
+           value1, value2, value2, useLUT, nbThreads);
+}
+
 /*!
   Compute the signed difference between the two images I1 and I2 for
   visualization issue : Idiff = I1-I2
@@ -229,6 +312,14 @@ vpImageTools::imageAdd(const vpImage<unsigned char> &I1,
       _mm_storeu_si128( (__m128i*) ptr_Ires, vres );
     }
   }
+#elif defined(VISP_HAVE_NEON)
+  if (Ires.getSize() >= 16) {
+    for (; cpt <= Ires.getSize() - 16 ; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
+      const uint8x16_t v1 = vld1q_u8(ptr_I1);
+      const uint8x16_t v2 = vld1q_u8(ptr_I2);
+      vst1q_u8(ptr_Ires, saturate ? vqaddq_u8(v1, v2) : vaddq_u8(v1, v2));
+    }
+  }
 #endif
 
   for (; cpt < Ires.getSize(); cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
@@ -273,9 +364,176 @@ vpImageTools::imageSubtract(const vpImage<unsigned char> &I1,
       _mm_storeu_si128( (__m128i*) ptr_Ires, vres );
     }
   }
+#elif defined(VISP_HAVE_NEON)
+  if (Ires.getSize() >= 16) {
+    for (; cpt <= Ires.getSize() - 16 ; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
+      const uint8x16_t v1 = vld1q_u8(ptr_I1);
+      const uint8x16_t v2 = vld1q_u8(ptr_I2);
+      vst1q_u8(ptr_Ires, saturate ? vqsubq_u8(v1, v2) : vsubq_u8(v1, v2));
+    }
+  }
 #endif
 
   for (; cpt < Ires.getSize(); cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
     *ptr_Ires = saturate ? vpMath::saturate<unsigned char>( (short int) *ptr_I1 - (short int) *ptr_I2 ) : *ptr_I1 - *ptr_I2;
   }
 }
+
+/*!
+  Compute the integral image of \e I: \e II has one more row and column
+  than \e I, filled with zeros, and \f$ II(i,j) = \sum_{i' < i, j' < j}
+  I(i',j') \f$. Any rectangular sum of \e I can then be evaluated in
+  four reads with integralImageSum().
+
+  \param I : Input image.
+  \param II : Integral image, of size (height+1) x (width+1).
+*/
+void vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<double> &II)
+{
+  unsigned int height = I.getHeight(), width = I.getWidth();
+  if (II.getHeight() != height+1 || II.getWidth() != width+1)
+    II.resize(height+1, width+1);
+
+  for (unsigned int j = 0; j <= width; j++)
+    II[0][j] = 0.;
+
+  for (unsigned int i = 1; i <= height; i++) {
+    const unsigned char *row = I[i-1];
+    double *sum_row = II[i];
+    const double *sum_prev = II[i-1];
+    double row_sum = 0.;
+    sum_row[0] = 0.;
+    for (unsigned int j = 1; j <= width; j++) {
+      row_sum += row[j-1];
+      sum_row[j] = sum_prev[j] + row_sum;
+    }
+  }
+}
+
+/*!
+  Compute in one pass the integral image and the squared integral image
+  of \e I, useful to evaluate means and variances over rectangular
+  windows in constant time (zero-mean normalized cross correlations,
+  adaptive thresholds, ...).
+
+  \param I : Input image.
+  \param II : Integral image, of size (height+1) x (width+1).
+  \param IIsq : Integral image of the squared intensities, same size.
+*/
+void vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<double> &II, vpImage<double> &IIsq)
+{
+  unsigned int height = I.getHeight(), width = I.getWidth();
+  if (II.getHeight() != height+1 || II.getWidth() != width+1)
+    II.resize(height+1, width+1);
+  if (IIsq.getHeight() != height+1 || IIsq.getWidth() != width+1)
+    IIsq.resize(height+1, width+1);
+
+  for (unsigned int j = 0; j <= width; j++) {
+    II[0][j] = 0.;
+    IIsq[0][j] = 0.;
+  }
+
+  for (unsigned int i = 1; i <= height; i++) {
+    const unsigned char *row = I[i-1];
+    double *sum_row = II[i];
+    const double *sum_prev = II[i-1];
+    double *sq_row = IIsq[i];
+    const double *sq_prev = IIsq[i-1];
+    double row_sum = 0., row_sq = 0.;
+    sum_row[0] = 0.;
+    sq_row[0] = 0.;
+    for (unsigned int j = 1; j <= width; j++) {
+      double v = row[j-1];
+      row_sum += v;
+      row_sq += v*v;
+      sum_row[j] = sum_prev[j] + row_sum;
+      sq_row[j] = sq_prev[j] + row_sq;
+    }
+  }
+}
+
+/*!
+  Sum of the image intensities over the rectangle \e rect, evaluated in
+  four reads of the integral image computed by integralImage().
+
+  \param II : Integral image.
+  \param rect : Rectangle in the coordinates of the original image; the
+  right and bottom edges are included, as with vpRect.
+
+  \return The sum of the intensities over the rectangle.
+*/
+double vpImageTools::integralImageSum(const vpImage<double> &II, const vpRect &rect)
+{
+  unsigned int top = (unsigned int)rect.getTop();
+  unsigned int left = (unsigned int)rect.getLeft();
+  unsigned int bottom = (unsigned int)rect.getBottom();
+  unsigned int right = (unsigned int)rect.getRight();
+
+  if (bottom+1 >= II.getHeight() || right+1 >= II.getWidth()) {
+    throw (vpException(vpException::dimensionError,
+                       "The rectangle does not fit in the integral image"));
+  }
+
+  return II[bottom+1][right+1] - II[top][right+1] - II[bottom+1][left] + II[top][left];
+}
+
+/*!
+  Precompute the undistortion mapping used by remap(): for each pixel of
+  the undistorted image the integer coordinates of the source pixel and
+  the fractional parts of the bilinear interpolation are stored, with the
+  same distortion model evaluation as undistort(). For a static
+  calibration this is computed once and remap() then undistorts each
+  frame without evaluating the distortion polynomial per pixel.
+
+  \param cam : Camera parameters with the kud distortion coefficient.
+  \param width, height : Size of the images to undistort.
+  \param mapU, mapV : Filled with the integer source coordinates.
+  \param mapDu, mapDv : Filled with the fractional parts.
+*/
+void vpImageTools::initUndistortMap(const vpCameraParameters &cam,
+                                    unsigned int width, unsigned int height,
+                                    vpArray2D<int> &mapU, vpArray2D<int> &mapV,
+                                    vpArray2D<float> &mapDu, vpArray2D<float> &mapDv)
+{
+  mapU.resize(height, width, false);
+  mapV.resize(height, width, false);
+  mapDu.resize(height, width, false);
+  mapDv.resize(height, width, false);
+
+  double u0 = cam.get_u0();
+  double v0 = cam.get_v0();
+  double px = cam.get_px();
+  double py = cam.get_py();
+  double kud = cam.get_kud();
+
+  double invpx = 1.0/px;
+  double invpy = 1.0/py;
+
+  double kud_px2 = kud * invpx * invpx;
+  double kud_py2 = kud * invpy * invpy;
+
+  for (unsigned int v = 0; v < height; v++) {
+    double deltav = v - v0;
+    double fr1 = 1.0 + kud_py2 * deltav * deltav;
+
+    for (unsigned int u = 0; u < width; u++) {
+      // Computation of u,v : corresponding pixel coordinates in the
+      // distorted image, same expressions as undistort()
+      double deltau = u - u0;
+      double fr2 = fr1 + kud_px2 * deltau * deltau;
+
+      double u_double = deltau * fr2 + u0;
+      double v_double = deltav * fr2 + v0;
+
+      int u_round = (int) (u_double);
+      int v_round = (int) (v_double);
+      if (u_round < 0.f) u_round = -1;
+      if (v_round < 0.f) v_round = -1;
+
+      mapU[v][u] = u_round;
+      mapV[v][u] = v_round;
+      mapDu[v][u] = (float)(u_double - (double) u_round);
+      mapDv[v][u] = (float)(v_double - (double) v_round);
+    }
+  }
+}
@@ -89,7 +89,7 @@ vpKalmanFilter::init(unsigned int size_state_vector, unsigned int size_measure_v
 */
 vpKalmanFilter::vpKalmanFilter()
   : iter(0), size_state(0), size_measure(0), nsignal(0), verbose_mode(false),
-    Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I()
+    Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I(), Wss()
 {
 }
 
@@ -102,7 +102,7 @@ vpKalmanFilter::vpKalmanFilter()
 */
 vpKalmanFilter::vpKalmanFilter(unsigned int n_signal)
   : iter(0), size_state(0), size_measure(0), nsignal(n_signal), verbose_mode(false),
-    Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I()
+    Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I(), Wss()
 {
 }
 
@@ -120,7 +120,7 @@ vpKalmanFilter::vpKalmanFilter(unsigned int n_signal)
 */
 vpKalmanFilter::vpKalmanFilter(unsigned int size_state_vector, unsigned int size_measure_vector, unsigned int n_signal)
   : iter(0), size_state(0), size_measure(0), nsignal(0), verbose_mode(false),
-    Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I()
+    Xest(), Xpre(), F(), H(), R(), Q(), dt(-1), Ppre(), Pest(), W(), I(), Wss()
 {
   init( size_state_vector, size_measure_vector, n_signal) ;
 }
@@ -461,3 +461,117 @@ vpKalmanFilter::initFilterSinger(double dt,
 }
 
 #endif
+
+/*!
+  Precompute the steady state filter gain \f$ {\bf W}_{\infty} \f$ by
+  iterating the covariance and gain equations with the current \f$ \bf F,
+  H, Q, R \f$ matrices until the gain converges. For a filter whose
+  matrices are constant, predictionSteadyState() and
+  filteringSteadyState() can then be used in place of prediction() and
+  filtering(): the per-iteration covariance products and the matrix
+  inversion disappear from the filtering loop.
+
+  The estimated state covariance members Ppre and Pest hold on return the
+  steady state covariances.
+
+  \param tol : Convergence threshold on the infinity norm of the gain
+  variation between two iterations.
+  \param max_iter : Maximum number of Riccati iterations.
+
+  \exception vpException::notInitialized : If the filter state size is
+  null, meaning that init() was not called.
+*/
+void
+vpKalmanFilter::computeSteadyStateGain(double tol, unsigned int max_iter)
+{
+  if (size_state == 0) {
+    throw(vpException(vpException::notInitialized,
+                      "The Kalman filter is not initialized")) ;
+  }
+
+  vpMatrix W_prev ;
+  for (unsigned int i = 0; i < max_iter; i++) {
+    // Bar-Shalom  5.2.3.5, 5.2.3.11, 5.2.3.15
+    Ppre = F*Pest*F.t() + Q ;
+    vpMatrix S = H*Ppre*H.t() + R ;
+    Wss = (Ppre * H.t())* S.inverseByLU() ;
+    Pest = Ppre - Wss*S*Wss.t() ;
+
+    if (i > 0) {
+      double variation = 0. ;
+      for (unsigned int r = 0; r < Wss.getRows(); r++)
+        for (unsigned int c = 0; c < Wss.getCols(); c++) {
+          double d = fabs(Wss[r][c] - W_prev[r][c]) ;
+          if (d > variation) variation = d ;
+        }
+      if (variation < tol)
+        break ;
+    }
+    W_prev = Wss ;
+  }
+  W = Wss ;
+}
+
+/*!
+  Predict the new state with the steady state gain hypothesis: only the
+  state vector is propagated, the covariance being frozen to its steady
+  state value computed by computeSteadyStateGain().
+*/
+void
+vpKalmanFilter::predictionSteadyState()
+{
+  if (Wss.getRows() == 0) {
+    throw(vpException(vpException::notInitialized,
+                      "Steady state gain not computed: call computeSteadyStateGain() first")) ;
+  }
+  // Bar-Shalom  5.2.3.2
+  Xpre = F*Xest ;
+}
+
+/*!
+  Update the filter state from the measure \e z using the precomputed
+  steady state gain: \f$ {\bf x}_{k|k} = {\bf x}_{k|k-1} + {\bf W}_{\infty}
+  ({\bf z}_k - {\bf H} {\bf x}_{k|k-1}) \f$. No covariance is updated.
+
+  \param z : Measure provided at the current iteration.
+*/
+void
+vpKalmanFilter::filteringSteadyState(const vpColVector &z)
+{
+  if (Wss.getRows() == 0) {
+    throw(vpException(vpException::notInitialized,
+                      "Steady state gain not computed: call computeSteadyStateGain() first")) ;
+  }
+  // Bar-Shalom  5.2.3.12
+  Xest = Xpre + (Wss*(z - (H*Xpre))) ;
+  iter++ ;
+}
+
+/*!
+  Apply the steady state prediction/filtering pair on a batch of
+  successive measures, stored one per column of \e Z. Equivalent to
+  calling predictionSteadyState() then filteringSteadyState() for each
+  column, with the temporaries reused over the whole batch.
+
+  \param Z : Measures, one iteration per column.
+*/
+void
+vpKalmanFilter::filteringSteadyState(const vpMatrix &Z)
+{
+  if (Wss.getRows() == 0) {
+    throw(vpException(vpException::notInitialized,
+                      "Steady state gain not computed: call computeSteadyStateGain() first")) ;
+  }
+  unsigned int zrows = Z.getRows() ;
+  vpColVector innov(zrows), gain_innov(Xest.getRows()) ;
+  for (unsigned int k = 0; k < Z.getCols(); k++) {
+    // Bar-Shalom  5.2.3.2 and 5.2.3.12
+    vpMatrix::mult2Matrices(F, Xest, Xpre) ;
+    vpMatrix::mult2Matrices(H, Xpre, innov) ;
+    for (unsigned int r = 0; r < zrows; r++)
+      innov[r] = Z[r][k] - innov[r] ;
+    vpMatrix::mult2Matrices(Wss, innov, gain_innov) ;
+    vpColVector::addScaled(Xpre, 1., gain_innov, Xest) ;
+    iter++ ;
+  }
+}
@@ -79,6 +79,59 @@ vpColVector::operator+(const vpColVector &v) const
     r[i] = (*this)[i] + v[i];
   return r;
 }
+/*!
+  Compute in one pass \f$ r = v_1 + \alpha v_2 \f$ without any
+  temporary, as the expression \e v1 + \e alpha * \e v2 written with the
+  arithmetic operators would allocate one vector per operator.
+
+  The result is placed in the third parameter \e r and not returned: no
+  allocation occurs when \e r has already the right size, which makes
+  this entry point suitable for control laws running at high rate.
+
+  \param v1 : First vector.
+  \param alpha : Scale applied to \e v2.
+  \param v2 : Second vector.
+  \param r : Resulting vector \f$ v_1 + \alpha v_2 \f$.
+
+  \sa addScaled(const double, const vpColVector &)
+*/
+void vpColVector::addScaled(const vpColVector &v1, const double alpha,
+                            const vpColVector &v2, vpColVector &r)
+{
+  if (v1.getRows() != v2.getRows() ) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot add (%dx1) column vector to (%dx1) column vector",
+                      v1.getRows(), v2.getRows())) ;
+  }
+  if (r.getRows() != v1.getRows())
+    r.resize(v1.getRows());
+
+  for (unsigned int i=0;i<v1.rowNum;i++)
+    r.data[i] = v1.data[i] + alpha*v2.data[i];
+}
+
+/*!
+  Add in place \f$ \alpha v \f$ to the current vector in one pass and
+  without any temporary: this is the classical axpy operation
+  \f$ this \leftarrow this + \alpha v \f$.
+
+  \param alpha : Scale applied to \e v.
+  \param v : Vector to accumulate.
+
+  \sa addScaled(const vpColVector &, const double, const vpColVector &, vpColVector &)
+*/
+void vpColVector::addScaled(const double alpha, const vpColVector &v)
+{
+  if (getRows() != v.getRows() ) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot add (%dx1) column vector to (%dx1) column vector",
+                      getRows(), v.getRows())) ;
+  }
+
+  for (unsigned int i=0;i<rowNum;i++)
+    data[i] += alpha*v.data[i];
+}
+
 /*!
   Operator that allows to add a column vector to a translation vector.
 
@@ -1358,9 +1411,19 @@ double vpColVector::sum() const
   __m128d v_sum1 = _mm_setzero_pd(), v_sum2 = _mm_setzero_pd(), v_sum;
 
   if(rowNum >= 4) {
-    for(; i <= rowNum- 4; i+=4) {
-      v_sum1 = _mm_add_pd(_mm_loadu_pd(data + i), v_sum1);
-      v_sum2 = _mm_add_pd(_mm_loadu_pd(data + i + 2), v_sum2);
+    if ((((size_t)data) & 0xF) == 0) {
+      // Aligned storage guaranteed by vpArray2D::resize()
+      for(; i <= rowNum- 4; i+=4) {
+        v_sum1 = _mm_add_pd(_mm_load_pd(data + i), v_sum1);
+        v_sum2 = _mm_add_pd(_mm_load_pd(data + i + 2), v_sum2);
+      }
+    }
+    else {
+      // Unaligned path kept for the sub-vectors that alias a parent storage
+      for(; i <= rowNum- 4; i+=4) {
+        v_sum1 = _mm_add_pd(_mm_loadu_pd(data + i), v_sum1);
+        v_sum2 = _mm_add_pd(_mm_loadu_pd(data + i + 2), v_sum2);
+      }
     }
   }
 
@@ -1400,12 +1463,25 @@ double vpColVector::sumSquare() const
   __m128d v_sum = _mm_setzero_pd();
 
   if(rowNum >= 4) {
-    for(; i <= rowNum- 4; i+=4) {
-      v_mul1 = _mm_mul_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(data + i));
-      v_mul2 = _mm_mul_pd(_mm_loadu_pd(data + i + 2), _mm_loadu_pd(data + i + 2));
-
-      v_sum = _mm_add_pd(v_mul1, v_sum);
-      v_sum = _mm_add_pd(v_mul2, v_sum);
+    if ((((size_t)data) & 0xF) == 0) {
+      // Aligned storage guaranteed by vpArray2D::resize()
+      for(; i <= rowNum- 4; i+=4) {
+        v_mul1 = _mm_mul_pd(_mm_load_pd(data + i), _mm_load_pd(data + i));
+        v_mul2 = _mm_mul_pd(_mm_load_pd(data + i + 2), _mm_load_pd(data + i + 2));
+
+        v_sum = _mm_add_pd(v_mul1, v_sum);
+        v_sum = _mm_add_pd(v_mul2, v_sum);
+      }
+    }
+    else {
+      // Unaligned path kept for the sub-vectors that alias a parent storage
+      for(; i <= rowNum- 4; i+=4) {
+        v_mul1 = _mm_mul_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(data + i));
+        v_mul2 = _mm_mul_pd(_mm_loadu_pd(data + i + 2), _mm_loadu_pd(data + i + 2));
+
+        v_sum = _mm_add_pd(v_mul1, v_sum);
+        v_sum = _mm_add_pd(v_mul2, v_sum);
+      }
     }
   }
 
@@ -1461,7 +1537,21 @@ double vpColVector::euclideanNorm() const
 double vpColVector::infinityNorm() const
 {
   double norm=0.0;
-  for (unsigned int i=0;i<rowNum;i++){
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  if (rowNum >= 2) {
+    __m128d v_sign_mask = _mm_set1_pd(-0.0);
+    __m128d v_max = _mm_setzero_pd();
+    for (; i <= rowNum-2; i+=2)
+      v_max = _mm_max_pd(_mm_andnot_pd(v_sign_mask, _mm_loadu_pd(data + i)), v_max);
+    double res[2];
+    _mm_storeu_pd(res, v_max);
+    norm = (res[0] > res[1]) ? res[0] : res[1];
+  }
+#endif
+
+  for (;i<rowNum;i++){
     double x =  fabs ( (*this)[i] ) ;
     if (x > norm) {
       norm = x;
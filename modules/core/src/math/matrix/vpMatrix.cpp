@@ -61,8 +61,26 @@
 #endif
 
 #include <visp3/core/vpMatrix.h>
+
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+#include <string.h>
+#include <stdio.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpTranslationVector.h>
+
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpDebug.h>
@@ -70,6 +88,86 @@
 //Prototypes of specific functions
 vpMatrix subblock(const vpMatrix &, unsigned int, unsigned int);
 
+#ifdef VISP_HAVE_LAPACK_C
+extern "C" int dgemm_(char *transa, char *transb, int *m, int *n, int *k,
+                      double *alpha, double *a, int *lda, double *b, int *ldb,
+                      double *beta, double *c, int *ldc);
+
+// Minimal size from which the matrix product is worth a BLAS call. Below
+// this size the function call overhead dominates and the hand-rolled loops
+// used as fallback are faster on the small matrices found in control laws.
+static const unsigned int vpMATRIX_BLAS_MIN_SIZE = 8;
+#endif
+
+// Minimal number of rows of the left operand from which mult2Matrices()
+// spreads the product over the available threads. Can be tuned at runtime
+// with setParallelMultMinRows(); large enough by default to never trigger
+// on control-law sized matrices.
+unsigned int vpMatrix::parallelMultMinRows = 2048;
+
+// Number of rows of the bands distributed to the threads by the
+// multi-threaded product; sized so that one band of a skinny interaction
+// matrix stays resident in the L2 cache.
+#define VP_MATRIX_MULT_BAND_SIZE 256
+
+#ifdef VISP_HAVE_LAPACK_C
+
+/*!
+  Compute the rows [r0, r1) of C = A * B using the BLAS dgemm routine.
+
+  ViSP matrices are stored row-major while BLAS expects column-major
+  storage. Instead of transposing the operands we compute
+  \f$C^T = B^T \; A^T\f$ which, seen through the column-major convention,
+  is exactly the row-major product \f$C = A B\f$. A band of rows of C is
+  a band of columns of \f$C^T\f$ so that the multi-threaded path can call
+  this function on disjoint bands concurrently.
+*/
+static void blas_dgemm_band(const vpMatrix &A, const vpMatrix &B, vpMatrix &C,
+                            unsigned int r0, unsigned int r1)
+{
+  int m = static_cast<int>(B.getCols());
+  int n = static_cast<int>(r1 - r0);
+  int k = static_cast<int>(A.getCols());
+  double alpha = 1., beta = 0.;
+
+  dgemm_((char*)"N", (char*)"N", &m, &n, &k, &alpha,
+         B.data, &m, A.data + r0*A.getCols(), &k, &beta,
+         C.data + r0*B.getCols(), &m);
+}
+
+//! Compute C = A * B through dgemm, see blas_dgemm_band()
+static void blas_dgemm(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
+{
+  blas_dgemm_band(A, B, C, 0, A.getRows());
+}
+#endif
+
+/*!
+  Set the number of rows of the left operand from which mult2Matrices()
+  distributes the product over the available threads. The default value
+  is high enough to keep control-law sized products single-threaded.
+
+  \param min_rows : Minimal number of rows of A in C = A * B enabling the
+  multi-threaded path.
+
+  \sa getParallelMultMinRows()
+*/
+void vpMatrix::setParallelMultMinRows(unsigned int min_rows)
+{
+  parallelMultMinRows = min_rows;
+}
+
+/*!
+  Get the number of rows of the left operand from which mult2Matrices()
+  distributes the product over the available threads.
+
+  \sa setParallelMultMinRows()
+*/
+unsigned int vpMatrix::getParallelMultMinRows()
+{
+  return parallelMultMinRows;
+}
+
 
 /*!
   Construct a matrix as a sub-matrix of the input matrix \e M.
@@ -338,6 +436,19 @@ void vpMatrix::AtA(vpMatrix &B) const
     throw ;
   }
 
+#ifdef VISP_HAVE_LAPACK_C
+  // B = A^T A through dgemm. With the row-major data seen column-major the
+  // operands read as A^T so that dgemm("N","T") produces A^T A directly.
+  if (rowNum >= vpMATRIX_BLAS_MIN_SIZE || colNum >= vpMATRIX_BLAS_MIN_SIZE) {
+    int n = static_cast<int>(colNum);
+    int m = static_cast<int>(rowNum);
+    double alpha = 1., beta = 0.;
+    dgemm_((char*)"N", (char*)"T", &n, &n, &m, &alpha,
+           data, &n, data, &n, &beta, B.data, &n);
+    return;
+  }
+#endif
+
   unsigned int i,j,k;
   double s;
   double *ptr;
@@ -655,6 +766,47 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
                       A.getRows(), A.getCols(), B.getRows(), B.getCols())) ;
   }
 
+#ifdef VISP_HAVE_OPENMP
+  // Very tall products, as produced when stacking dense interaction
+  // matrices, are cut in cache-sized horizontal bands of C computed
+  // concurrently, each band through one dgemm call when lapack is used.
+  if (A.rowNum >= parallelMultMinRows) {
+    int nbands = static_cast<int>((A.rowNum + VP_MATRIX_MULT_BAND_SIZE - 1)/VP_MATRIX_MULT_BAND_SIZE);
+#pragma omp parallel for schedule(static)
+    for (int band = 0; band < nbands; band++) {
+      unsigned int r0 = static_cast<unsigned int>(band)*VP_MATRIX_MULT_BAND_SIZE;
+      unsigned int r1 = r0 + VP_MATRIX_MULT_BAND_SIZE;
+      if (r1 > A.rowNum) r1 = A.rowNum;
+#ifdef VISP_HAVE_LAPACK_C
+      blas_dgemm_band(A, B, C, r0, r1);
+#else
+      double **BrowPtrs_ = B.rowPtrs;
+      for (unsigned int i=r0;i<r1;i++) {
+        double *rowptri = A.rowPtrs[i];
+        double *ci = C[i];
+        for (unsigned int j=0;j<B.colNum;j++) {
+          double s = 0;
+          for (unsigned int k=0;k<B.rowNum;k++) s += rowptri[k] * BrowPtrs_[k][j];
+          ci[j] = s;
+        }
+      }
+#endif
+    }
+    return;
+  }
+#endif
+
+#ifdef VISP_HAVE_LAPACK_C
+  // Large products are delegated to BLAS; the naive loops below remain the
+  // fallback for builds without lapack and for small matrices where the
+  // dgemm call overhead is not amortized.
+  if (A.rowNum >= vpMATRIX_BLAS_MIN_SIZE || A.colNum >= vpMATRIX_BLAS_MIN_SIZE
+      || B.colNum >= vpMATRIX_BLAS_MIN_SIZE) {
+    blas_dgemm(A, B, C);
+    return;
+  }
+#endif
+
   // 5/12/06 some "very" simple optimization to avoid indexation
   unsigned int BcolNum = B.colNum;
   unsigned int BrowNum = B.rowNum;
@@ -3552,7 +3704,26 @@ void vpMatrix::computeHLM(const vpMatrix &H, const double &alpha, vpMatrix &HLM)
 double vpMatrix::euclideanNorm() const
 {
   double norm=0.0;
-  for (unsigned int i=0;i<dsize;i++) {
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  // Two accumulators over the aligned flat storage guaranteed by
+  // vpArray2D::resize()
+  if (dsize >= 4 && ((((size_t)data) & 0xF) == 0)) {
+    __m128d v_sum1 = _mm_setzero_pd(), v_sum2 = _mm_setzero_pd();
+    for (; i <= dsize-4; i+=4) {
+      __m128d v_x1 = _mm_load_pd(data + i);
+      __m128d v_x2 = _mm_load_pd(data + i + 2);
+      v_sum1 = _mm_add_pd(_mm_mul_pd(v_x1, v_x1), v_sum1);
+      v_sum2 = _mm_add_pd(_mm_mul_pd(v_x2, v_x2), v_sum2);
+    }
+    double res[2];
+    _mm_storeu_pd(res, _mm_add_pd(v_sum1, v_sum2));
+    norm = res[0]+res[1];
+  }
+#endif
+
+  for (;i<dsize;i++) {
     double x = *(data +i);
     norm += x*x;
   }
@@ -3575,8 +3746,23 @@ double vpMatrix::infinityNorm() const
   double norm=0.0;
   for (unsigned int i=0;i<rowNum;i++){
     double x = 0;
-    for (unsigned int j=0; j<colNum;j++){
-      x += fabs (*(*(rowPtrs + i)+j)) ;
+    unsigned int j = 0;
+    double *row = rowPtrs[i];
+
+#if VISP_HAVE_SSE2
+    __m128d v_sign_mask = _mm_set1_pd(-0.0);
+    __m128d v_sum = _mm_setzero_pd();
+    if (colNum >= 2) {
+      for (; j <= colNum-2; j+=2)
+        v_sum = _mm_add_pd(_mm_andnot_pd(v_sign_mask, _mm_loadu_pd(row + j)), v_sum);
+      double res[2];
+      _mm_storeu_pd(res, v_sum);
+      x = res[0]+res[1];
+    }
+#endif
+
+    for (; j<colNum;j++){
+      x += fabs (row[j]) ;
     }
     if (x > norm) {
       norm = x;
@@ -3674,3 +3860,177 @@ vpMatrix::setIdentity(const double & val)
 
 #endif //#if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
 
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! On-disk header of the v2 binary matrix format: 64-byte aligned so that
+//! the mapped payload keeps the alignment of the in-memory storage.
+struct vpMatrixV2Header
+{
+  unsigned int magic;      //!< 0x56504d32 ("VPM2")
+  unsigned int version;
+  unsigned int rows;
+  unsigned int cols;
+  unsigned int headerSize; //!< bytes of user header following this struct
+  unsigned int payload;    //!< absolute offset of the data block
+  unsigned int reserved[10]; //!< pad the struct to 64 bytes
+};
+#endif
+
+/*!
+  Save a matrix in the v2 binary format: a 64-byte aligned header (with an
+  optional user header string) followed by one contiguous write of the
+  data block, instead of the element-by-element streaming of the historic
+  binary format.
+
+  \param filename : Absolute file name.
+  \param M : Matrix to be saved.
+  \param header : Optional user header string.
+
+  \return True on success.
+*/
+bool vpMatrix::saveMatrixV2(const std::string &filename, const vpArray2D<double> &M, const char *header)
+{
+  FILE *fd = fopen(filename.c_str(), "wb");
+  if (fd == NULL)
+    return false;
+
+  size_t headerSize = strlen(header);
+  size_t payload = sizeof(vpMatrixV2Header) + headerSize;
+  payload = (payload + 63u) & ~(size_t)63u; //keep the data block 64-byte aligned
+
+  vpMatrixV2Header h;
+  memset(&h, 0, sizeof(h));
+  h.magic = 0x56504d32u;
+  h.version = 2;
+  h.rows = M.getRows();
+  h.cols = M.getCols();
+  h.headerSize = (unsigned int) headerSize;
+  h.payload = (unsigned int) payload;
+
+  bool ok = (fwrite(&h, sizeof(h), 1, fd) == 1);
+  if (headerSize > 0)
+    ok = ok && (fwrite(header, 1, headerSize, fd) == headerSize);
+  //pad to the aligned payload offset
+  size_t pos = sizeof(h) + headerSize;
+  while (ok && pos < payload) {
+    ok = (fputc(0, fd) != EOF);
+    pos++;
+  }
+  size_t nb = (size_t) M.getRows() * M.getCols();
+  if (nb > 0)
+    ok = ok && (fwrite(&M[0][0], sizeof(double), nb, fd) == nb);
+
+  fclose(fd);
+  return ok;
+}
+
+/*!
+  Load a matrix saved with saveMatrixV2(): the data block is read with a
+  single fread into the (re)allocated storage.
+
+  \param filename : Absolute file name.
+  \param M : Matrix loaded from the file.
+  \param header : Optional buffer receiving the user header (must be large
+  enough, nul terminated on return).
+
+  \return True on success.
+*/
+bool vpMatrix::loadMatrixV2(const std::string &filename, vpArray2D<double> &M, char *header)
+{
+  FILE *fd = fopen(filename.c_str(), "rb");
+  if (fd == NULL)
+    return false;
+
+  vpMatrixV2Header h;
+  if (fread(&h, sizeof(h), 1, fd) != 1 || h.magic != 0x56504d32u || h.version != 2) {
+    fclose(fd);
+    return false;
+  }
+
+  if (header != NULL && h.headerSize > 0) {
+    if (fread(header, 1, h.headerSize, fd) != h.headerSize) {
+      fclose(fd);
+      return false;
+    }
+    header[h.headerSize] = '\0';
+  }
+
+  if (fseek(fd, (long) h.payload, SEEK_SET) != 0) {
+    fclose(fd);
+    return false;
+  }
+
+  M.resize(h.rows, h.cols, false);
+  size_t nb = (size_t) h.rows * h.cols;
+  bool ok = (nb == 0) || (fread(&M[0][0], sizeof(double), nb, fd) == nb);
+  fclose(fd);
+  return ok;
+}
+
+/*!
+  Map a matrix saved with saveMatrixV2() and wrap it without any copy: \e M
+  becomes a read-only view of the mapped data block (64-byte aligned by the
+  format). The mapping stays alive until unloadMatrixMmap() is called with
+  the returned address and length, after \e M stopped viewing it. Do not
+  write through the view. On platforms without mmap the data is loaded with
+  loadMatrixV2() and \e map_addr is returned NULL.
+
+  \param filename : Absolute file name.
+  \param M : Matrix turned into a view of the mapped file.
+  \param map_addr : Returned mapping address, to pass to unloadMatrixMmap().
+  \param map_length : Returned mapping length.
+
+  \return True on success.
+*/
+bool vpMatrix::loadMatrixMmap(const std::string &filename, vpMatrix &M, void **map_addr, size_t *map_length)
+{
+  *map_addr = NULL;
+  *map_length = 0;
+
+#if !defined(_WIN32)
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(vpMatrixV2Header)) {
+    ::close(fd);
+    return false;
+  }
+  size_t length = (size_t) st.st_size;
+  void *map = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  const vpMatrixV2Header *h = (const vpMatrixV2Header *) map;
+  size_t nb = (size_t) h->rows * h->cols;
+  if (h->magic != 0x56504d32u || h->version != 2 ||
+      length < h->payload + nb*sizeof(double)) {
+    munmap(map, length);
+    return false;
+  }
+
+  M.view((double *)((char *) map + h->payload), h->rows, h->cols);
+  *map_addr = map;
+  *map_length = length;
+  return true;
+#else
+  return loadMatrixV2(filename, M, NULL);
+#endif
+}
+
+/*!
+  Release a mapping returned by loadMatrixMmap(). Every matrix viewing it
+  must have been destroyed or reassigned before. Harmless with a NULL
+  address (the fallback path of the platforms without mmap).
+*/
+void vpMatrix::unloadMatrixMmap(void *map_addr, size_t map_length)
+{
+#if !defined(_WIN32)
+  if (map_addr != NULL)
+    munmap(map_addr, map_length);
+#else
+  (void) map_addr;
+  (void) map_length;
+#endif
+}
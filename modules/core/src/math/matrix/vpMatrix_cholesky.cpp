@@ -45,6 +45,8 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpMatrixException.h>
 
+#include <limits>   // numeric_limits
+
 // Debug trace
 #include <visp3/core/vpDebug.h>
 
@@ -122,7 +124,64 @@ vpMatrix::inverseByCholesky() const
   return inverseByCholeskyLapack();
 }
 
-#elif !defined(VISP_BUILD_SHARED_LIBS)
-// Work arround to avoid warning: libvisp_core.a(vpMatrixLapack.cpp.o) has no symbols
-void dummy_vpMatrixLapack() {};
+#endif // VISP_HAVE_LAPACK_C
+
+#ifdef VISP_HAVE_LAPACK_C
+extern "C" int dpotrs_(char *uplo, int *n, int *nrhs, double *a, int *lda, double *b, int *ldb, int *info);
+#endif
+
+/*!
+  Solve the linear system \f$ A x = b \f$ with \f$ A \f$ the current
+  matrix, through a Cholesky decomposition when lapack is available.
+  The matrix must be symmetric positive definite, which is the case of
+  the normal equations \f$ A^T\!A \f$ assembled by the virtual visual
+  servoing loops; the factorization is then several times cheaper than
+  the SVD based pseudo inverse.
+
+  When the matrix is found not positive definite or ill conditioned
+  (tiny pivot in the factor), or when lapack is not available, the
+  system is solved through the SVD as solveBySVD() would.
+
+  \param b : Right hand side vector.
+  \param x : Solution of the system.
+
+  \sa luSolve(), solveBySVD()
+*/
+void vpMatrix::choleskySolve(const vpColVector &b, vpColVector &x) const
+{
+  if (rowNum != colNum || rowNum != b.getRows()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot solve a (%dx%d) system with a (%d) right hand side",
+                      rowNum, colNum, b.getRows())) ;
+  }
+  if (rowNum == 0) {
+    x.resize(0);
+    return;
+  }
+
+#ifdef VISP_HAVE_LAPACK_C
+  int n = (int)rowNum;
+  int nrhs = 1, lda = n, ldb = n, info;
+
+  vpMatrix A = *this; // dpotrf is destructive; the matrix is symmetric so
+                      // the row major storage needs no transposition
+  x = b;
+  dpotrf_((char*)"L", &n, A.data, &lda, &info);
+  if (info == 0) {
+    // Conditioning check on the diagonal of the factor before trusting it
+    double dmin = A[0][0], dmax = A[0][0];
+    for (unsigned int i = 1; i < rowNum; i++) {
+      if (A[i][i] < dmin) dmin = A[i][i];
+      if (A[i][i] > dmax) dmax = A[i][i];
+    }
+    if (dmin > dmax*std::numeric_limits<double>::epsilon()*rowNum) {
+      dpotrs_((char*)"L", &n, &nrhs, A.data, &lda, x.data, &ldb, &info);
+      if (info == 0)
+        return;
+    }
+  }
 #endif
+
+  // Not positive definite or ill conditioned: fall back on the SVD
+  solveBySVD(b, x);
+}
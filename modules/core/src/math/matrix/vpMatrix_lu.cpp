@@ -275,3 +275,62 @@ vpMatrix::inverseByLU() const
   return B;
 }
 
+
+/*!
+  Solve the linear system \f$ A x = b \f$ with \f$ A \f$ the current
+  square matrix, through a LU decomposition. The factorization is
+  several times cheaper than the SVD based pseudo inverse for the well
+  conditioned square systems found in the minimization loops.
+
+  When the matrix is found singular or ill conditioned (tiny pivot in
+  the factor), the system is solved through the SVD as solveBySVD()
+  would.
+
+  \param b : Right hand side vector.
+  \param x : Solution of the system.
+
+  \sa choleskySolve(), solveBySVD()
+*/
+void vpMatrix::luSolve(const vpColVector &b, vpColVector &x) const
+{
+  if (rowNum != colNum || rowNum != b.getRows()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot solve a (%dx%d) system with a (%d) right hand side",
+                      rowNum, colNum, b.getRows())) ;
+  }
+  if (rowNum == 0) {
+    x.resize(0);
+    return;
+  }
+
+  vpMatrix A = *this; // LUDcmp is destructive
+  unsigned int *perm = new unsigned int[rowNum];
+  int d;
+
+  try {
+    A.LUDcmp(perm, d);
+  }
+  catch(...) {
+    // Singular matrix: fall back on the SVD
+    delete [] perm;
+    solveBySVD(b, x);
+    return;
+  }
+
+  // Conditioning check on the diagonal of the factor before trusting it
+  double dmin = fabs(A[0][0]), dmax = fabs(A[0][0]);
+  for (unsigned int i = 1; i < rowNum; i++) {
+    double diag = fabs(A[i][i]);
+    if (diag < dmin) dmin = diag;
+    if (diag > dmax) dmax = diag;
+  }
+  if (dmin <= dmax*std::numeric_limits<double>::epsilon()*rowNum) {
+    delete [] perm;
+    solveBySVD(b, x);
+    return;
+  }
+
+  x = b;
+  A.LUBksb(perm, x);
+  delete [] perm;
+}
@@ -75,21 +75,24 @@ void vpSubColVector::init(vpColVector &v,
   
   if(offset+nrows<=v.getRows()){
     data=v.data+offset;
-    
-    rowNum=nrows;
-    colNum = 1;
-    
+
     pRowNum=v.getRows();
     parent=&v;
-    
-    if(rowPtrs){
-      free(rowPtrs);
+
+    // Keep the row pointer table when the view is re-initialized with the
+    // same size, so that moving a view over a parent vector in an inner
+    // loop costs no allocation
+    if(rowPtrs == NULL || rowNum != nrows) {
+      if(rowPtrs){
+        free(rowPtrs);
+      }
+      rowPtrs=(double**)malloc( nrows * sizeof(double*));
     }
-    
-    rowPtrs=(double**)malloc( parent->getRows() * sizeof(double*));
+    rowNum=nrows;
+    colNum = 1;
     for(unsigned int i=0;i<nrows;i++)
       rowPtrs[i]=v.data+i+offset;
-    
+
     dsize = rowNum ;
   } else {
     throw(vpException(vpException::dimensionError,
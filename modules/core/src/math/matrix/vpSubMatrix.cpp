@@ -79,19 +79,23 @@ void vpSubMatrix::init(vpMatrix &m, const unsigned int &row_offset, const unsign
   
   if(row_offset+nrows <= m.getRows() && col_offset+ncols <= m.getCols()){
     data=m.data;
-    parent =&m; 
+    parent =&m;
+    pRowNum=m.getRows();
+    pColNum=m.getCols();
+
+    // Keep the row pointer table when the view is re-initialized with the
+    // same number of rows, so that moving a view over a parent matrix in
+    // an inner loop costs no allocation
+    if(rowPtrs == NULL || rowNum != nrows) {
+      if(rowPtrs)
+        free(rowPtrs);
+      rowPtrs=(double**) malloc(nrows * sizeof(double*));
+    }
     rowNum = nrows;
     colNum = ncols;
-    pRowNum=m.getRows(); 
-    pColNum=m.getCols(); 
-    
-    if(rowPtrs)
-      free(rowPtrs);
-    
-    rowPtrs=(double**) malloc(nrows * sizeof(double*));
     for(unsigned int r=0;r<nrows;r++)
       rowPtrs[r]= m.data+col_offset+(r+row_offset)*pColNum;
-    
+
     dsize = pRowNum*pColNum ;
   }else{
     vpERROR_TRACE("Submatrix cannot be contain in parent matrix") ;
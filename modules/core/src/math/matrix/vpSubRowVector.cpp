@@ -73,20 +73,19 @@ void vpSubRowVector::init(vpRowVector &v, const unsigned int & offset,const unsi
   
   if(offset+ncols<=v.getCols()){
 	data=v.data+offset;
-	  
+
 	rowNum=1;
 	colNum = ncols;
-	
+
 	pColNum=v.getCols();
 	parent=&v;
-	
-	if(rowPtrs)
-	  free(rowPtrs);
-	
-	rowPtrs=(double**) malloc(1 * sizeof(double*));
-	for(unsigned int i=0;i<1;i++)
-	  rowPtrs[i]=v.data+i+offset;
-	
+
+	// A row view has a single row pointer: allocate it once and only
+	// refresh it on the next initializations
+	if(rowPtrs == NULL)
+	  rowPtrs=(double**) malloc(1 * sizeof(double*));
+	rowPtrs[0]=v.data+offset;
+
 	dsize = colNum ;
   } else {
     throw(vpException(vpException::dimensionError,
@@ -0,0 +1,347 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reusable workspace for SVD based decompositions.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpSvdContext.h>
+#include <visp3/core/vpMatrixException.h>
+#include <visp3/core/vpDebug.h>
+
+#include <cmath>
+#include <string.h>
+
+#ifdef VISP_HAVE_LAPACK_C
+extern "C" int dgesdd_(char *jobz, int *m, int *n, double *a, int *lda, double *s, double *u, int *ldu, double *vt, int *ldvt, double *work, int *lwork, int *iwork, int *info);
+#endif
+
+vpSvdContext::vpSvdContext()
+  : m_a(), m_a1(), m_v(), m_sv()
+#ifdef VISP_HAVE_LAPACK_C
+  , m_work(NULL), m_iwork(NULL), m_lwork(0), m_workRows(0), m_workCols(0), m_acopy(NULL)
+#endif
+{
+}
+
+vpSvdContext::~vpSvdContext()
+{
+#ifdef VISP_HAVE_LAPACK_C
+  if (m_work != NULL)
+    delete[] m_work;
+  if (m_iwork != NULL)
+    delete[] m_iwork;
+  if (m_acopy != NULL)
+    delete[] m_acopy;
+#endif
+}
+
+/*!
+  Compute the singular value decomposition \f$ A = U W V^T \f$ without
+  modifying \e A. The working buffers owned by the context are reused so
+  that repeated decompositions of the same shape are allocation free.
+
+  \param A : Matrix to decompose.
+  \param w : Singular values, sized to the column number of \e A.
+  \param U : Left singular vectors, with the dimensions of \e A.
+  \param V : Right singular vectors (the matrix V, not its transpose).
+*/
+void vpSvdContext::svd(const vpMatrix &A, vpColVector &w, vpMatrix &U, vpMatrix &V)
+{
+  unsigned int nrows = A.getRows();
+  unsigned int ncols = A.getCols();
+
+  if (U.getRows() != nrows || U.getCols() != ncols)
+    U.resize(nrows, ncols);
+  if (w.getRows() != ncols)
+    w.resize(ncols);
+  if (V.getRows() != ncols || V.getCols() != ncols)
+    V.resize(ncols, ncols);
+
+#ifdef VISP_HAVE_LAPACK_C
+  // Same calling convention as vpMatrix::svdLapack() with the difference
+  // that the destructive input copy and the work arrays are kept alive in
+  // the context between the calls.
+  int m = static_cast<int>(ncols), n = static_cast<int>(nrows);
+  int lda = m, ldu = m, ldvt = std::min(m, n);
+  int info;
+
+  if (m_workRows != nrows || m_workCols != ncols || m_work == NULL) {
+    if (m_work != NULL) {
+      delete[] m_work;
+      m_work = NULL;
+    }
+    if (m_iwork != NULL) {
+      delete[] m_iwork;
+      m_iwork = NULL;
+    }
+    if (m_acopy != NULL) {
+      delete[] m_acopy;
+      m_acopy = NULL;
+    }
+    m_iwork = new int[8*static_cast<unsigned int>(std::min(m, n))];
+    m_acopy = new double[static_cast<unsigned int>(lda)*nrows];
+
+    double wkopt;
+    m_lwork = -1;
+    dgesdd_( (char*)"S", &m, &n, m_acopy, &lda, w.data, V.data, &ldu, U.data, &ldvt, &wkopt, &m_lwork, m_iwork, &info );
+    m_lwork = (int)wkopt;
+    m_work = new double[static_cast<unsigned int>(m_lwork)];
+    m_workRows = nrows;
+    m_workCols = ncols;
+  }
+
+  memcpy(m_acopy, A.data, nrows*ncols*sizeof(double));
+  if (U.data != A.data) // pseudoInverse() decomposes its working copy in place
+    memcpy(U.data, A.data, nrows*ncols*sizeof(double));
+
+  dgesdd_( (char*)"S", &m, &n, m_acopy, &lda, w.data, V.data, &ldu, U.data, &ldvt, m_work, &m_lwork, m_iwork, &info );
+
+  if (info > 0) {
+    vpTRACE("The algorithm computing SVD failed to converge.");
+    throw(vpMatrixException(vpMatrixException::fatalError,
+          "The algorithm computing SVD failed to converge.")) ;
+  }
+
+  // In place transposition of the square V to stay allocation free
+  for (unsigned int i = 0; i < ncols; i++) {
+    for (unsigned int j = i+1; j < ncols; j++) {
+      double tmp = V[i][j];
+      V[i][j] = V[j][i];
+      V[j][i] = tmp;
+    }
+  }
+#else
+  // Without lapack fall back on the generic entry point; the working copy
+  // is still reused between the calls.
+  if (U.data != A.data)
+    U = A;
+  U.svd(w, V);
+#endif
+}
+
+/*!
+  Compute the pseudo inverse \f$ Ap = A^+ \f$ reusing the context buffers.
+
+  \param A : Input matrix.
+  \param Ap : The pseudo inverse \f$ A^+ \f$.
+  \param svThreshold : Threshold used to test the singular values.
+  \return The rank of the matrix \e A.
+*/
+unsigned int vpSvdContext::pseudoInverse(const vpMatrix &A, vpMatrix &Ap, double svThreshold)
+{
+  unsigned int i, j, k;
+
+  unsigned int nrows_orig = A.getRows();
+  unsigned int ncols_orig = A.getCols();
+  unsigned int nrows, ncols;
+
+  if (nrows_orig >= ncols_orig) {
+    nrows = nrows_orig;
+    ncols = ncols_orig;
+  }
+  else {
+    nrows = ncols_orig;
+    ncols = nrows_orig;
+  }
+
+  if (Ap.getRows() != ncols_orig || Ap.getCols() != nrows_orig)
+    Ap.resize(ncols_orig, nrows_orig);
+  if (m_a1.getRows() != ncols || m_a1.getCols() != nrows)
+    m_a1.resize(ncols, nrows);
+
+  if (nrows_orig >= ncols_orig)
+    svd(A, m_sv, m_a, m_v);
+  else {
+    m_a = A.t();
+    // The transposed copy is decomposed in place through the working buffers
+    svd(m_a, m_sv, m_a, m_v);
+  }
+
+  // compute the highest singular value and the rank of A
+  double maxsv = 0;
+  for (i = 0; i < ncols; i++)
+    if (fabs(m_sv[i]) > maxsv) maxsv = fabs(m_sv[i]);
+
+  unsigned int rank = 0;
+  for (i = 0; i < ncols; i++)
+    if (fabs(m_sv[i]) > maxsv*svThreshold) rank++;
+
+  for (i = 0; i < ncols; i++) {
+    for (j = 0; j < nrows; j++) {
+      double s = 0.0;
+      for (k = 0; k < ncols; k++)
+        if (fabs(m_sv[k]) > maxsv*svThreshold)
+          s += m_v[i][k]*m_a[j][k]/m_sv[k];
+      m_a1[i][j] = s;
+    }
+  }
+
+  if (nrows_orig >= ncols_orig) {
+    for (i = 0; i < ncols_orig; i++)
+      for (j = 0; j < nrows_orig; j++)
+        Ap[i][j] = m_a1[i][j];
+  }
+  else {
+    for (i = 0; i < ncols_orig; i++)
+      for (j = 0; j < nrows_orig; j++)
+        Ap[i][j] = m_a1[j][i];
+  }
+
+  return rank;
+}
+
+/*!
+  Compute the pseudo inverse \f$ Ap = A^+ \f$ along with Im \f$A\f$ and
+  Im \f$A^T\f$, with the same convention as
+  vpMatrix::pseudoInverse(vpMatrix &, vpColVector &, double, vpMatrix &, vpMatrix &) const
+  but reusing the context buffers between the calls.
+
+  \param A : Input matrix.
+  \param Ap : The pseudo inverse \f$ A^+ \f$.
+  \param sv : Singular values.
+  \param svThreshold : Threshold used to test the singular values.
+  \param imA : Image of \e A.
+  \param imAt : Image of \f$A^T\f$.
+  \return The rank of the matrix \e A.
+*/
+unsigned int vpSvdContext::pseudoInverse(const vpMatrix &A, vpMatrix &Ap, vpColVector &sv,
+                                         double svThreshold, vpMatrix &imA, vpMatrix &imAt)
+{
+  unsigned int i, j, k;
+
+  unsigned int nrows_orig = A.getRows();
+  unsigned int ncols_orig = A.getCols();
+  unsigned int nrows, ncols;
+
+  if (nrows_orig >= ncols_orig) {
+    nrows = nrows_orig;
+    ncols = ncols_orig;
+  }
+  else {
+    nrows = ncols_orig;
+    ncols = nrows_orig;
+  }
+
+  if (Ap.getRows() != ncols_orig || Ap.getCols() != nrows_orig)
+    Ap.resize(ncols_orig, nrows_orig);
+  if (m_a1.getRows() != ncols || m_a1.getCols() != nrows)
+    m_a1.resize(ncols, nrows);
+
+  if (nrows_orig >= ncols_orig)
+    svd(A, sv, m_a, m_v);
+  else {
+    m_a = A.t();
+    svd(m_a, sv, m_a, m_v);
+  }
+
+  // compute the highest singular value and the rank of A
+  double maxsv = 0;
+  for (i = 0; i < ncols; i++)
+    if (fabs(sv[i]) > maxsv) maxsv = fabs(sv[i]);
+
+  unsigned int rank = 0;
+  for (i = 0; i < ncols; i++)
+    if (fabs(sv[i]) > maxsv*svThreshold) rank++;
+
+  for (i = 0; i < ncols; i++) {
+    for (j = 0; j < nrows; j++) {
+      double s = 0.0;
+      for (k = 0; k < ncols; k++)
+        if (fabs(sv[k]) > maxsv*svThreshold)
+          s += m_v[i][k]*m_a[j][k]/sv[k];
+      m_a1[i][j] = s;
+    }
+  }
+
+  if (nrows_orig >= ncols_orig) {
+    for (i = 0; i < ncols_orig; i++)
+      for (j = 0; j < nrows_orig; j++)
+        Ap[i][j] = m_a1[i][j];
+
+    //  compute dim At
+    imAt.resize(ncols_orig, rank);
+    for (i = 0; i < ncols_orig; i++)
+      for (j = 0; j < rank; j++)
+        imAt[i][j] = m_v[i][j];
+
+    //  compute dim A
+    imA.resize(nrows_orig, rank);
+    for (i = 0; i < nrows_orig; i++)
+      for (j = 0; j < rank; j++)
+        imA[i][j] = m_a[i][j];
+  }
+  else {
+    for (i = 0; i < ncols_orig; i++)
+      for (j = 0; j < nrows_orig; j++)
+        Ap[i][j] = m_a1[j][i];
+
+    //  compute dim At
+    imAt.resize(ncols_orig, rank);
+    for (i = 0; i < ncols_orig; i++)
+      for (j = 0; j < rank; j++)
+        imAt[i][j] = m_a[i][j];
+
+    imA.resize(nrows_orig, rank);
+    for (i = 0; i < nrows_orig; i++)
+      for (j = 0; j < rank; j++)
+        imA[i][j] = m_v[i][j];
+  }
+
+  return rank;
+}
+
+/*!
+  Solve the linear system \f$ A x = b \f$ using the singular value
+  decomposition, with the same result as vpMatrix::solveBySVD() but
+  reusing the context buffers between the calls.
+
+  \param A : System matrix.
+  \param b : Right hand side vector.
+  \param x : Solution, sized to the column number of \e A.
+*/
+void vpSvdContext::solveBySVD(const vpMatrix &A, const vpColVector &b, vpColVector &x)
+{
+  unsigned int ncols = A.getCols();
+
+  pseudoInverse(A, m_ap, 1e-6);
+  if (x.getRows() != ncols)
+    x.resize(ncols);
+  for (unsigned int i = 0; i < ncols; i++) {
+    double s = 0.0;
+    for (unsigned int j = 0; j < b.getRows(); j++)
+      s += m_ap[i][j]*b[j];
+    x[i] = s;
+  }
+}
@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bank of Hinkley cumulative sum tests over several channels.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpHinkleyBank.h>
+#include <visp3/core/vpMath.h>
+
+#include <cmath>
+#include <limits>
+
+/*!
+  Default constructor : the bank is unusable until init().
+*/
+vpHinkleyBank::vpHinkleyBank()
+  : m_nbChannels(0), m_dmin2(0.), m_alpha(0.), m_time(0),
+    m_mean(), m_Sk(), m_Mk(), m_Tk(), m_Nk(), m_nsignal()
+{
+}
+
+/*!
+  Build and initialize the bank, see init().
+*/
+vpHinkleyBank::vpHinkleyBank(const unsigned int &nbChannels, const double &alpha, const double &delta)
+  : m_nbChannels(0), m_dmin2(0.), m_alpha(0.), m_time(0),
+    m_mean(), m_Sk(), m_Mk(), m_Tk(), m_Nk(), m_nsignal()
+{
+  init(nbChannels, alpha, delta);
+}
+
+/*!
+  Initialize the bank.
+
+  \param nbChannels : Number of monitored channels.
+  \param alpha : Detection threshold, as for vpHinkley::setAlpha().
+  \param delta : Jump minimal magnitude, as for vpHinkley::setDelta().
+*/
+void vpHinkleyBank::init(const unsigned int &nbChannels, const double &alpha, const double &delta)
+{
+  m_nbChannels = nbChannels;
+  m_dmin2 = fabs(delta) / 2.;
+  m_alpha = alpha;
+  m_time = 0;
+  m_mean.assign(nbChannels, 0.);
+  m_Sk.assign(nbChannels, 0.);
+  m_Mk.assign(nbChannels, 0.);
+  m_Tk.assign(nbChannels, 0.);
+  m_Nk.assign(nbChannels, 0.);
+  m_nsignal.assign(nbChannels, 0);
+}
+
+/*!
+  Process one sample frame : one value per channel.
+
+  \param samples : One sample per channel.
+  \param events : Appended with the jumps detected on this frame.
+*/
+void vpHinkleyBank::update(const double *samples, std::vector<vpHinkleyEvent> &events)
+{
+  update(samples, 1, events);
+}
+
+/*!
+  Process a block of sample frames. The block is frame-interleaved :
+  block[k * getNbChannels() + channel] is the sample of \e channel in
+  frame \e k, the natural layout of a multi-channel acquisition.
+
+  \param block : nbSamples frames of getNbChannels() values.
+  \param nbSamples : Number of frames in the block.
+  \param events : Appended with every (channel, direction, sample index)
+  jump detected inside the block. A detected channel resets, as the
+  scalar test does.
+*/
+void vpHinkleyBank::update(const double *block, const unsigned int &nbSamples,
+                           std::vector<vpHinkleyEvent> &events)
+{
+  for (unsigned int k = 0; k < nbSamples; k++) {
+    const double *frame = block + (size_t)k * m_nbChannels;
+    m_time++;
+
+    for (unsigned int ch = 0; ch < m_nbChannels; ch++) {
+      double signal = frame[ch];
+      double mean = m_mean[ch];
+      double Sk = m_Sk[ch], Mk = m_Mk[ch], Tk = m_Tk[ch], Nk = m_Nk[ch];
+      unsigned long nsignal = m_nsignal[ch] + 1;
+
+      if (nsignal == 1)
+        mean = signal;
+
+      //Same update order as vpHinkley::testDownUpwardJump()
+      Sk += signal - mean + m_dmin2;
+      Tk += signal - mean - m_dmin2;
+      if (Sk > Mk) Mk = Sk;
+      if (Tk < Nk) Nk = Tk;
+
+      vpHinkley::vpHinkleyJumpType jump = vpHinkley::noJump;
+      if ((Mk - Sk) > m_alpha)
+        jump = vpHinkley::downwardJump;
+      else if ((Tk - Nk) > m_alpha)
+        jump = vpHinkley::upwardJump;
+
+      //Drifting mean guard of the scalar test
+      if ((std::fabs(Mk - Sk) <= std::fabs(vpMath::maximum(Mk, Sk)) * std::numeric_limits<double>::epsilon())
+          && (std::fabs(Tk - Nk) <= std::fabs(vpMath::maximum(Tk, Nk)) * std::numeric_limits<double>::epsilon()))
+        mean = (mean * (nsignal - 1) + signal) / nsignal;
+
+      if (jump != vpHinkley::noJump) {
+        vpHinkleyEvent event;
+        event.channel = ch;
+        event.direction = jump;
+        event.sampleIndex = m_time;
+        events.push_back(event);
+
+        Sk = 0; Mk = 0; Tk = 0; Nk = 0; nsignal = 0;
+        mean = signal;
+      }
+
+      m_mean[ch] = mean;
+      m_Sk[ch] = Sk;
+      m_Mk[ch] = Mk;
+      m_Tk[ch] = Tk;
+      m_Nk[ch] = Nk;
+      m_nsignal[ch] = nsignal;
+    }
+  }
+}
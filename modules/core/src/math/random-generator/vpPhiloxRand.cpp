@@ -0,0 +1,312 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Counter-based random number generation.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpPhiloxRand.h>
+
+#include <cmath>
+#include <stdint.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+//Philox 4x32 multiplication and Weyl constants
+static const unsigned int vpPhiloxM0 = 0xD2511F53u;
+static const unsigned int vpPhiloxM1 = 0xCD9E8D57u;
+static const unsigned int vpPhiloxW0 = 0x9E3779B9u;
+static const unsigned int vpPhiloxW1 = 0xBB67AE85u;
+
+/*!
+  Compute the 4-value block of the given counter position. The key is not
+  modified : the same position always produces the same block.
+*/
+void vpPhiloxRand::nextBlock(const unsigned int &counterLo, const unsigned int &counterHi,
+                             unsigned int output[4]) const
+{
+  unsigned int c0 = counterLo, c1 = 0u, c2 = counterHi, c3 = 0x56504852u; // "VPHR"
+  unsigned int k0 = m_key0, k1 = m_key1;
+
+  for (unsigned int round = 0; round < 10; round++) {
+    //32x32 -> 64 products, high and low halves
+    uint64_t p0lo = (uint64_t)vpPhiloxM0 * c0;
+    uint64_t p1lo = (uint64_t)vpPhiloxM1 * c2;
+    unsigned int hi0 = (unsigned int)(p0lo >> 32);
+    unsigned int lo0 = (unsigned int)p0lo;
+    unsigned int hi1 = (unsigned int)(p1lo >> 32);
+    unsigned int lo1 = (unsigned int)p1lo;
+
+    unsigned int n0 = hi1 ^ c1 ^ k0;
+    unsigned int n1 = lo1;
+    unsigned int n2 = hi0 ^ c3 ^ k1;
+    unsigned int n3 = lo0;
+
+    c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+    k0 += vpPhiloxW0;
+    k1 += vpPhiloxW1;
+  }
+
+  output[0] = c0;
+  output[1] = c1;
+  output[2] = c2;
+  output[3] = c3;
+}
+
+/*!
+  Draw the next 32 bit value of the stream.
+*/
+unsigned int vpPhiloxRand::next()
+{
+  if (m_bufferIndex >= 4) {
+    nextBlock(m_counterLo, m_counterHi, m_buffer);
+    m_counterLo++;
+    m_bufferIndex = 0;
+  }
+  return m_buffer[m_bufferIndex++];
+}
+
+#ifdef VISP_HAVE_SSE2
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Compute four consecutive Philox blocks (16 values) at the counter
+  positions counterLo..counterLo+3 of the stream \e counterHi.
+*/
+static void vpPhiloxBlocks4SSE(const unsigned int &counterLo, const unsigned int &counterHi,
+                               const unsigned int &key0, const unsigned int &key1,
+                               unsigned int output[16])
+{
+  //One SSE lane per block
+  __m128i c0 = _mm_set_epi32((int)(counterLo+3), (int)(counterLo+2), (int)(counterLo+1), (int)counterLo);
+  __m128i c1 = _mm_setzero_si128();
+  __m128i c2 = _mm_set1_epi32((int)counterHi);
+  __m128i c3 = _mm_set1_epi32(0x56504852); // "VPHR"
+  __m128i k0 = _mm_set1_epi32((int)key0);
+  __m128i k1 = _mm_set1_epi32((int)key1);
+  const __m128i m0 = _mm_set1_epi32((int)0xD2511F53u);
+  const __m128i m1 = _mm_set1_epi32((int)0xCD9E8D57u);
+  const __m128i w0 = _mm_set1_epi32((int)0x9E3779B9u);
+  const __m128i w1 = _mm_set1_epi32((int)0xBB67AE85u);
+  //Masks selecting the odd/even 32 bit lanes of the 64 bit products
+  const __m128i loMask = _mm_set_epi32(0, -1, 0, -1);
+
+  for (unsigned int round = 0; round < 10; round++) {
+    //_mm_mul_epu32 multiplies the even lanes; shift to get the odd ones
+    __m128i p0even = _mm_mul_epu32(m0, c0);                      // lanes 0,2
+    __m128i p0odd  = _mm_mul_epu32(m0, _mm_srli_epi64(c0, 32));  // lanes 1,3
+    __m128i p1even = _mm_mul_epu32(m1, c2);
+    __m128i p1odd  = _mm_mul_epu32(m1, _mm_srli_epi64(c2, 32));
+
+    //Rebuild 4x32 vectors of the low and high product halves
+    __m128i lo0 = _mm_or_si128(_mm_and_si128(p0even, loMask),
+                               _mm_slli_epi64(_mm_and_si128(p0odd, loMask), 32));
+    __m128i hi0 = _mm_or_si128(_mm_srli_epi64(p0even, 32),
+                               _mm_andnot_si128(loMask, p0odd));
+    __m128i lo1 = _mm_or_si128(_mm_and_si128(p1even, loMask),
+                               _mm_slli_epi64(_mm_and_si128(p1odd, loMask), 32));
+    __m128i hi1 = _mm_or_si128(_mm_srli_epi64(p1even, 32),
+                               _mm_andnot_si128(loMask, p1odd));
+
+    __m128i n0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), k0);
+    __m128i n2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), k1);
+
+    c0 = n0;
+    c1 = lo1;
+    c2 = n2;
+    c3 = lo0;
+    k0 = _mm_add_epi32(k0, w0);
+    k1 = _mm_add_epi32(k1, w1);
+  }
+
+  //De-interleave : output[4*b + w] = word w of block b (lane b)
+  unsigned int t0[4], t1[4], t2[4], t3[4];
+  _mm_storeu_si128((__m128i *)t0, c0);
+  _mm_storeu_si128((__m128i *)t1, c1);
+  _mm_storeu_si128((__m128i *)t2, c2);
+  _mm_storeu_si128((__m128i *)t3, c3);
+  for (unsigned int b = 0; b < 4; b++) {
+    output[4*b + 0] = t0[b];
+    output[4*b + 1] = t1[b];
+    output[4*b + 2] = t2[b];
+    output[4*b + 3] = t3[b];
+  }
+}
+#endif
+#endif
+
+/*!
+  Fill \e values with \e n raw 32 bit values of the stream.
+
+  \param values : Filled array.
+  \param n : Number of values.
+*/
+void vpPhiloxRand::fill(unsigned int *values, const unsigned int &n)
+{
+  unsigned int i = 0;
+
+  //Finish the block in flight so that fill() and operator()() interleave
+  //into the same sequence
+  while (i < n && m_bufferIndex < 4)
+    values[i++] = next();
+
+#ifdef VISP_HAVE_SSE2
+  while (n - i >= 16) {
+    vpPhiloxBlocks4SSE(m_counterLo, m_counterHi, m_key0, m_key1, values + i);
+    m_counterLo += 4;
+    i += 16;
+  }
+#endif
+
+  while (n - i >= 4) {
+    nextBlock(m_counterLo, m_counterHi, values + i);
+    m_counterLo++;
+    i += 4;
+  }
+
+  while (i < n)
+    values[i++] = next();
+}
+
+/*!
+  Fill \e values with \e n uniform doubles in (0, 1).
+
+  \param values : Filled array.
+  \param n : Number of values.
+*/
+void vpPhiloxRand::fill(double *values, const unsigned int &n)
+{
+  unsigned int raw[64];
+  unsigned int i = 0;
+
+  while (i < n) {
+    unsigned int chunk = n - i > 64 ? 64 : n - i;
+    fill(raw, chunk);
+    for (unsigned int j = 0; j < chunk; j++)
+      values[i + j] = (raw[j] + 0.5) * 2.328306436538696e-10; // 2^-32
+    i += chunk;
+  }
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//256 layer ziggurat tables of the standard normal distribution
+//(Marsaglia & Tsang), built once at library load
+static struct vpZigguratTables
+{
+  double x[257];
+  double y[257];
+
+  vpZigguratTables()
+  {
+    const double r = 3.6541528853610088;
+    const double v = 0.00492867323399; //area of each layer
+
+    x[256] = v / std::exp(-0.5 * r * r);
+    x[255] = r;
+    y[255] = std::exp(-0.5 * r * r);
+    for (int i = 254; i >= 1; i--) {
+      x[i] = std::sqrt(-2.0 * std::log(v / x[i + 1] + std::exp(-0.5 * x[i + 1] * x[i + 1])));
+      y[i] = std::exp(-0.5 * x[i] * x[i]);
+    }
+    x[0] = 0.;
+    y[0] = 1.;
+  }
+} vpZiggurat;
+#endif
+
+/*!
+  Fill \e values with \e n normal variates of the given mean and standard
+  deviation, drawn with a ziggurat fed by the bulk uniform generation.
+
+  \param values : Filled array.
+  \param n : Number of values.
+  \param mean : Mean of the distribution.
+  \param sigma : Standard deviation of the distribution.
+*/
+void vpPhiloxRand::fillGaussian(double *values, const unsigned int &n,
+                                const double &mean, const double &sigma)
+{
+  const double r = 3.6541528853610088;
+  unsigned int raw[64];
+  unsigned int available = 0, used = 0;
+
+  for (unsigned int i = 0; i < n; ) {
+    if (used >= available) {
+      available = n - i > 64 ? 64 : (n - i < 16 ? 16 : n - i);
+      fill(raw, available);
+      used = 0;
+    }
+    unsigned int u = raw[used++];
+
+    int layer = (int)(u & 0xFF);
+    double sign = (u & 0x100) ? -1.0 : 1.0;
+    //The 23 bits left after the layer and sign draws feed the abscissa
+    double ud = (u >> 9) * (1.0 / 8388608.0) ; // 2^-23
+    double xCand = ud * vpZiggurat.x[layer + 1];
+
+    if (xCand < vpZiggurat.x[layer]) {
+      values[i++] = mean + sigma * sign * xCand;
+      continue;
+    }
+
+    if (layer == 255) {
+      //Tail of the distribution
+      double xTail, yTail;
+      do {
+        if (used + 2 > available) {
+          available = 16;
+          fill(raw, available);
+          used = 0;
+        }
+        double u1 = (raw[used++] + 0.5) * 2.328306436538696e-10;
+        double u2 = (raw[used++] + 0.5) * 2.328306436538696e-10;
+        xTail = -std::log(u1) / r;
+        yTail = -std::log(u2);
+      } while (yTail + yTail < xTail * xTail);
+      values[i++] = mean + sigma * sign * (r + xTail);
+      continue;
+    }
+
+    //Wedge : accept against the density
+    if (used >= available) {
+      available = 16;
+      fill(raw, available);
+      used = 0;
+    }
+    double uy = (raw[used++] + 0.5) * 2.328306436538696e-10;
+    double yCand = vpZiggurat.y[layer + 1]
+      + uy * (vpZiggurat.y[layer] - vpZiggurat.y[layer + 1]);
+    if (yCand < std::exp(-0.5 * xCand * xCand))
+      values[i++] = mean + sigma * sign * xCand;
+    //else reject and redraw
+  }
+}
@@ -54,6 +54,11 @@
 #include <cmath>    // std::fabs
 #include <limits>   // numeric_limits
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
 #define vpITMAX 100
 #define vpEPS 3.0e-7
 #define vpCST 1
@@ -209,6 +214,79 @@ void vpRobust::MEstimator(const vpRobustEstimatorType method,
   }
 }
 
+/*!
+  Compute the weights according a residue vector and a PsiFunction, with
+  the Tukey influence function evaluated through a vectorized kernel.
+
+  The median and the MAD are obtained with the same selection algorithm
+  as MEstimator() so that the scale estimate is identical; only the
+  weight loop differs, which makes the results of the two entry points
+  numerically equivalent but not guaranteed bitwise identical for the
+  TUKEY method. Use MEstimator() when strict reproducibility against
+  previous releases matters.
+
+  \param method : Method to use for the weight calculation.
+  \param residues : Residues \f$ r_i \f$.
+  \param weights : Computed weights, in [0, 1]. This vector must have the
+  same size than the residue vector. On input a null weight flags a
+  residue already rejected, as with MEstimator().
+*/
+void vpRobust::MEstimatorFast(const vpRobustEstimatorType method,
+		     const vpColVector &residues,
+		     vpColVector &weights)
+{
+  double med=0;	// median
+  double normmedian=0; 	// Normalized median
+  double sigma=0;// Standard Deviation
+
+  unsigned int n_data = residues.getRows();
+  resize(n_data);
+
+  sorted_residues = residues;
+
+  unsigned int ind_med = (unsigned int)(ceil(n_data/2.0))-1;
+
+  // Calculate median through selection, without any full sort
+  med = select(sorted_residues, 0, (int)n_data-1, (int)ind_med);
+
+  // Normalize residues
+  for(unsigned int i=0; i<n_data; i++)
+  {
+    normres[i] = (fabs(residues[i]- med));
+    sorted_normres[i] = (fabs(sorted_residues[i]- med));
+  }
+
+  // Calculate MAD, selection based as well
+  normmedian = select(sorted_normres, 0, (int)n_data-1, (int)ind_med);
+  // 1.48 keeps scale estimate consistent for a normal probability dist.
+  sigma = 1.4826*normmedian; // median Absolute Deviation
+
+  // Set a minimum threshold for sigma
+  // (when sigma reaches the level of noise in the image)
+  if(sigma < NoiseThreshold)
+  {
+    sigma= NoiseThreshold;
+  }
+
+  switch (method)
+  {
+  case TUKEY :
+    {
+      psiTukeyFast(sigma, normres,weights);
+      break ;
+    }
+  case CAUCHY :
+    {
+      psiCauchy(sigma, normres,weights);
+      break ;
+    }
+  case HUBER :
+    {
+      psiHuber(sigma, normres,weights);
+      break ;
+    }
+  }
+}
 
 
 void vpRobust::MEstimator(const vpRobustEstimatorType method,
@@ -661,6 +739,61 @@ void vpRobust::psiTukey(double sig, vpColVector &x, vpColVector & weights)
   }
 }
 
+/*!
+  \brief calculation of Tukey's influence function through a SSE2
+  vectorized kernel when available, processing two residues per
+  iteration. Numerically equivalent to psiTukey(), see MEstimatorFast().
+
+  \param sig : sigma parameters
+  \param x : normalized residue vector
+  \param weights : weight vector
+*/
+void vpRobust::psiTukeyFast(double sig, vpColVector &x, vpColVector & weights)
+{
+  unsigned int n_data = x.getRows();
+  double cst_const = vpCST*4.6851;
+  double epsilon = std::numeric_limits<double>::epsilon();
+  unsigned int i = 0;
+
+  if(std::fabs(sig) <= epsilon)
+  {
+    // Degenerated scale: every residue still weighted stays an inlier
+    for(i=0; i<n_data; i++)
+      weights[i] = (std::fabs(weights[i]) > epsilon) ? 1 : 0;
+    return;
+  }
+
+#if VISP_HAVE_SSE2
+  // w = (1 - (x/(sig*c))^2)^2 when x/(sig*c) <= 1 and w != 0, else 0.
+  // The normalized residues are non negative so no absolute value is
+  // needed on x.
+  __m128d v_one = _mm_set1_pd(1.0);
+  __m128d v_inv = _mm_set1_pd(1.0/(sig*cst_const));
+  __m128d v_eps = _mm_set1_pd(epsilon);
+  __m128d v_sign_mask = _mm_set1_pd(-0.0);
+
+  for(; i+2 <= n_data; i+=2)
+  {
+    __m128d v_t = _mm_mul_pd(_mm_loadu_pd(x.data + i), v_inv);
+    __m128d v_w = _mm_loadu_pd(weights.data + i);
+    __m128d v_in = _mm_cmple_pd(v_t, v_one);
+    __m128d v_wnz = _mm_cmpgt_pd(_mm_andnot_pd(v_sign_mask, v_w), v_eps);
+    __m128d v_u = _mm_sub_pd(v_one, _mm_mul_pd(v_t, v_t));
+    v_u = _mm_mul_pd(v_u, v_u);
+    _mm_storeu_pd(weights.data + i, _mm_and_pd(v_u, _mm_and_pd(v_in, v_wnz)));
+  }
+#endif
+
+  for(; i<n_data; i++)
+  {
+    double t = x[i]/(sig*cst_const);
+    if(t <= 1. && std::fabs(weights[i]) > epsilon)
+      weights[i] = vpMath::sqr(1-vpMath::sqr(t));
+    else
+      weights[i] = 0;
+  }
+}
+
 /*!
   \brief calculation of Tukey's influence function
 
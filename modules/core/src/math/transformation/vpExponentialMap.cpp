@@ -300,3 +300,83 @@ vpExponentialMap::inverse(const vpHomogeneousMatrix &M, const double &delta_t)
 
   return(v);
 }
+
+/*!
+  Batched direct exponential map : every twist of \e v is integrated over
+  \e delta_t into the corresponding entry of \e M. One sincos() evaluation
+  per twist feeds both the rotation (Rodrigues, through the same sinc and
+  mcosc kernels as the scalar entry point, which handle the small angle
+  series) and the translation coupling, instead of the scalar version's
+  separate trigonometry in the rotation build, so an MPC rollout
+  integrating hundreds of twists per cycle pays one trig call each.
+
+  Results are identical to calling direct(const vpColVector &, const
+  double &) per element.
+
+  \param v : Twists, each a 6-dimension velocity vector.
+  \param delta_t : Integration interval, shared by the batch.
+  \param M : Resized like \e v and filled with the displacements.
+*/
+void vpExponentialMap::direct(const std::vector<vpColVector> &v, const double &delta_t,
+                              std::vector<vpHomogeneousMatrix> &M)
+{
+  M.resize(v.size());
+
+  for (size_t k = 0; k < v.size(); k++) {
+    const vpColVector &vk = v[k];
+    double u0 = vk[3] * delta_t, u1 = vk[4] * delta_t, u2 = vk[5] * delta_t;
+    double t0 = vk[0] * delta_t, t1 = vk[1] * delta_t, t2 = vk[2] * delta_t;
+
+    double theta = sqrt(u0*u0 + u1*u1 + u2*u2);
+    double si, co;
+#if defined(__GLIBC__)
+    sincos(theta, &si, &co);
+#else
+    si = sin(theta);
+    co = cos(theta);
+#endif
+    double sinc = vpMath::sinc(si, theta);
+    double mcosc = vpMath::mcosc(co, theta);
+    double msinc = vpMath::msinc(si, theta);
+
+    vpHomogeneousMatrix &Delta = M[k];
+    //Rotation : same Rodrigues expression as vpRotationMatrix::buildFrom()
+    Delta[0][0] = co + mcosc*u0*u0;
+    Delta[0][1] = -sinc*u2 + mcosc*u0*u1;
+    Delta[0][2] = sinc*u1 + mcosc*u0*u2;
+    Delta[1][0] = sinc*u2 + mcosc*u1*u0;
+    Delta[1][1] = co + mcosc*u1*u1;
+    Delta[1][2] = -sinc*u0 + mcosc*u1*u2;
+    Delta[2][0] = -sinc*u1 + mcosc*u2*u0;
+    Delta[2][1] = sinc*u0 + mcosc*u2*u1;
+    Delta[2][2] = co + mcosc*u2*u2;
+
+    //Translation coupling, as in the scalar entry point
+    Delta[0][3] = t0*(sinc + u0*u0*msinc)
+                + t1*(u0*u1*msinc - u2*mcosc)
+                + t2*(u0*u2*msinc + u1*mcosc);
+    Delta[1][3] = t0*(u0*u1*msinc + u2*mcosc)
+                + t1*(sinc + u1*u1*msinc)
+                + t2*(u1*u2*msinc - u0*mcosc);
+    Delta[2][3] = t0*(u0*u2*msinc - u1*mcosc)
+                + t1*(u1*u2*msinc + u0*mcosc)
+                + t2*(sinc + u2*u2*msinc);
+  }
+}
+
+/*!
+  Batched inverse exponential map : every displacement of \e M is mapped
+  back to the twist producing it over \e delta_t, identically to
+  inverse(const vpHomogeneousMatrix &, const double &) per element.
+
+  \param M : Displacements.
+  \param delta_t : Integration interval, shared by the batch.
+  \param v : Resized like \e M and filled with the twists.
+*/
+void vpExponentialMap::inverse(const std::vector<vpHomogeneousMatrix> &M, const double &delta_t,
+                               std::vector<vpColVector> &v)
+{
+  v.resize(M.size());
+  for (size_t k = 0; k < M.size(); k++)
+    v[k] = vpExponentialMap::inverse(M[k], delta_t);
+}
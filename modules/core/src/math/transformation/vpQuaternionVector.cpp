@@ -309,3 +309,116 @@ double vpQuaternionVector::y() const {return data[1];}
 double vpQuaternionVector::z() const {return data[2];}
 //! Returns w-component of the quaternion.
 double vpQuaternionVector::w() const {return data[3];}
+
+/*!
+  Rotate a translation vector by the rotation represented by the
+  quaternion, without building the 3x3 rotation matrix. The classical
+  \f$ t' = t + 2 \, q_v \times (q_v \times t + w \, t) \f$ form costs 18
+  multiplications where converting to a rotation matrix then multiplying
+  costs more than 30.
+
+  \param t : Vector to rotate.
+  \return The rotated vector.
+*/
+vpTranslationVector vpQuaternionVector::rotate(const vpTranslationVector &t) const
+{
+  double qx = x(), qy = y(), qz = z(), qw = w();
+
+  // u = q_v x t
+  double ux = qy*t[2] - qz*t[1];
+  double uy = qz*t[0] - qx*t[2];
+  double uz = qx*t[1] - qy*t[0];
+
+  // t' = t + 2 ( q_v x (u + w t) )
+  double vx = ux + qw*t[0];
+  double vy = uy + qw*t[1];
+  double vz = uz + qw*t[2];
+
+  return vpTranslationVector(t[0] + 2.*(qy*vz - qz*vy),
+                             t[1] + 2.*(qz*vx - qx*vz),
+                             t[2] + 2.*(qx*vy - qy*vx));
+}
+
+/*!
+  Compose two poses given as rotation quaternion and translation pairs:
+  \f$ ({\bf q}_{12}, {\bf t}_{12}) = ({\bf q}_1, {\bf t}_1) \circ
+  ({\bf q}_2, {\bf t}_2) \f$ with \f$ {\bf q}_{12} = {\bf q}_1 {\bf q}_2 \f$
+  and \f$ {\bf t}_{12} = {\bf q}_1 \, {\bf t}_2 \, {\bf q}_1^{-1} + {\bf t}_1
+  \f$. Equivalent to the product of the two corresponding homogeneous
+  matrices while staying in the 7 parameter representation, which makes
+  chaining many incremental poses noticeably cheaper.
+
+  \param q1, t1 : First pose.
+  \param q2, t2 : Second pose.
+  \param q12 : Rotation of the composed pose.
+  \param t12 : Translation of the composed pose.
+*/
+void vpQuaternionVector::composePose(const vpQuaternionVector &q1, const vpTranslationVector &t1,
+                                     const vpQuaternionVector &q2, const vpTranslationVector &t2,
+                                     vpQuaternionVector &q12, vpTranslationVector &t12)
+{
+  q12 = q1 * q2;
+  vpTranslationVector t2_rotated = q1.rotate(t2);
+  t12.set(t2_rotated[0] + t1[0], t2_rotated[1] + t1[1], t2_rotated[2] + t1[2]);
+}
+
+/*!
+  Spherical linear interpolation between two unit quaternions.
+
+  \param q0 : Start rotation, reached for \e t = 0.
+  \param q1 : End rotation, reached for \e t = 1.
+  \param t : Interpolation parameter in [0, 1].
+  \return The interpolated unit quaternion, along the shortest path.
+*/
+vpQuaternionVector vpQuaternionVector::slerp(const vpQuaternionVector &q0, const vpQuaternionVector &q1,
+                                             const double t)
+{
+  vpQuaternionVector q;
+  slerp(q0, q1, 1, &t, &q);
+  return q;
+}
+
+/*!
+  Spherical linear interpolation of a whole batch of parameters between
+  two unit quaternions, with the interpolation geometry (angle between
+  the quaternions, shortest path sign) computed once for the batch. This
+  is the entry point to use when resampling a trajectory.
+
+  \param q0 : Start rotation, reached for \e t = 0.
+  \param q1 : End rotation, reached for \e t = 1.
+  \param n : Number of interpolation parameters.
+  \param t : Array of interpolation parameters in [0, 1].
+  \param q : Output array of \e n interpolated unit quaternions.
+*/
+void vpQuaternionVector::slerp(const vpQuaternionVector &q0, const vpQuaternionVector &q1,
+                               unsigned int n, const double *t, vpQuaternionVector *q)
+{
+  // Shortest path: flip one end when the dot product is negative
+  double dot = q0.x()*q1.x() + q0.y()*q1.y() + q0.z()*q1.z() + q0.w()*q1.w();
+  double sign = 1.;
+  if (dot < 0.) {
+    dot = -dot;
+    sign = -1.;
+  }
+
+  if (dot > 1. - 1e-9) {
+    // Nearly identical rotations: linear interpolation then normalization
+    for (unsigned int i = 0; i < n; i++) {
+      double a = 1. - t[i], b = sign*t[i];
+      q[i].set(a*q0.x() + b*q1.x(), a*q0.y() + b*q1.y(),
+               a*q0.z() + b*q1.z(), a*q0.w() + b*q1.w());
+      q[i].normalize();
+    }
+    return;
+  }
+
+  double theta = acos(dot);
+  double inv_sin_theta = 1./sin(theta);
+
+  for (unsigned int i = 0; i < n; i++) {
+    double a = sin((1. - t[i])*theta)*inv_sin_theta;
+    double b = sign*sin(t[i]*theta)*inv_sin_theta;
+    q[i].set(a*q0.x() + b*q1.x(), a*q0.y() + b*q1.y(),
+             a*q0.z() + b*q1.z(), a*q0.w() + b*q1.w());
+  }
+}
@@ -0,0 +1,224 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Runtime detection of the CPU vector instruction sets.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpCPUFeatures.h>
+
+#include <iostream>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#  define VP_CPU_X86 1
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#elif (defined(__arm__) || defined(__aarch64__)) && defined(__linux__)
+#  define VP_CPU_ARM_LINUX 1
+#  include <sys/auxv.h>
+#  include <asm/hwcap.h>
+#endif
+
+namespace vpCPUFeatures
+{
+
+#ifdef VP_CPU_X86
+// cpuid leaf 1 edx/ecx and leaf 7 ebx flags, queried once
+static unsigned int cpuid_edx1 = 0, cpuid_ecx1 = 0, cpuid_ebx7 = 0;
+static bool cpuid_initialized = false;
+
+static void initCpuid()
+{
+  if (cpuid_initialized)
+    return;
+
+#if defined(_MSC_VER)
+  int regs[4];
+  __cpuid(regs, 0);
+  int nids = regs[0];
+  if (nids >= 1) {
+    __cpuid(regs, 1);
+    cpuid_ecx1 = (unsigned int)regs[2];
+    cpuid_edx1 = (unsigned int)regs[3];
+  }
+  if (nids >= 7) {
+    __cpuidex(regs, 7, 0);
+    cpuid_ebx7 = (unsigned int)regs[1];
+  }
+#else
+  unsigned int eax, ebx, ecx, edx;
+  unsigned int nids = __get_cpuid_max(0, NULL);
+  if (nids >= 1 && __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    cpuid_ecx1 = ecx;
+    cpuid_edx1 = edx;
+  }
+  if (nids >= 7) {
+    eax = ebx = ecx = edx = 0;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    cpuid_ebx7 = ebx;
+  }
+#endif
+  cpuid_initialized = true;
+}
+#endif // VP_CPU_X86
+
+/*!
+  Return true if the host CPU supports the SSE2 instruction set.
+*/
+bool checkSSE2()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_edx1 & (1u << 26)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the SSE3 instruction set.
+*/
+bool checkSSE3()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_ecx1 & (1u << 0)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the SSSE3 instruction set.
+*/
+bool checkSSSE3()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_ecx1 & (1u << 9)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the SSE4.1 instruction set.
+*/
+bool checkSSE41()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_ecx1 & (1u << 19)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the SSE4.2 instruction set.
+*/
+bool checkSSE42()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_ecx1 & (1u << 20)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the AVX instruction set.
+
+  \warning Only the CPU flag is tested, not the OS support of the wide
+  registers; kernels compiled with AVX enabled run on an OS that saves
+  them anyway.
+*/
+bool checkAVX()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_ecx1 & (1u << 28)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the AVX2 instruction set.
+*/
+bool checkAVX2()
+{
+#ifdef VP_CPU_X86
+  initCpuid();
+  return (cpuid_ebx7 & (1u << 5)) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Return true if the host CPU supports the ARM Neon instruction set.
+*/
+bool checkNeon()
+{
+#if defined(VP_CPU_ARM_LINUX) && defined(__aarch64__)
+  return true; // Neon is mandatory on aarch64
+#elif defined(VP_CPU_ARM_LINUX)
+  return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#else
+  return false;
+#endif
+}
+
+/*!
+  Print the instruction sets supported by the host CPU, useful to
+  understand which kernel a heterogeneous fleet deployment ends up
+  running.
+*/
+void printVectorisationInfo()
+{
+  std::cout << "SSE2:   " << (checkSSE2() ? "yes" : "no") << std::endl;
+  std::cout << "SSE3:   " << (checkSSE3() ? "yes" : "no") << std::endl;
+  std::cout << "SSSE3:  " << (checkSSSE3() ? "yes" : "no") << std::endl;
+  std::cout << "SSE4.1: " << (checkSSE41() ? "yes" : "no") << std::endl;
+  std::cout << "SSE4.2: " << (checkSSE42() ? "yes" : "no") << std::endl;
+  std::cout << "AVX:    " << (checkAVX() ? "yes" : "no") << std::endl;
+  std::cout << "AVX2:   " << (checkAVX2() ? "yes" : "no") << std::endl;
+  std::cout << "Neon:   " << (checkNeon() ? "yes" : "no") << std::endl;
+}
+
+} // namespace vpCPUFeatures
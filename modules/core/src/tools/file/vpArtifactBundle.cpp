@@ -0,0 +1,306 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Single file container of named binary sections.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpArtifactBundle.h>
+#include <visp3/core/vpException.h>
+
+static const char vpBundleMagic[4] = { 'V', 'P', 'A', 'B' };
+static const unsigned int vpBundleVersion = 1;
+
+/*!
+  Default constructor : the bundle is unusable until create() or open().
+*/
+vpArtifactBundle::vpArtifactBundle()
+  : m_filename(), m_writing(false), m_sections(), m_stream(NULL)
+{
+}
+
+/*!
+  Destructor : finalizes a bundle being written, see close().
+*/
+vpArtifactBundle::~vpArtifactBundle()
+{
+  close();
+}
+
+/*!
+  Start writing a new bundle, truncating any existing file.
+
+  \param filename : Path of the bundle file.
+
+  \exception vpException::ioError : If the file cannot be created.
+*/
+void vpArtifactBundle::create(const std::string &filename)
+{
+  close();
+  m_stream = new std::fstream(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_stream->is_open()) {
+    delete m_stream;
+    m_stream = NULL;
+    throw vpException(vpException::ioError, "Cannot create the bundle file %s", filename.c_str());
+  }
+  m_filename = filename;
+  m_writing = true;
+  m_sections.clear();
+
+  unsigned int version = vpBundleVersion;
+  m_stream->write(vpBundleMagic, 4);
+  m_stream->write((const char *)&version, sizeof(version));
+}
+
+/*!
+  Open an existing bundle for reading and scan its section table.
+
+  \param filename : Path of the bundle file.
+
+  \exception vpException::ioError : If the file cannot be read or is not
+  a bundle.
+*/
+void vpArtifactBundle::open(const std::string &filename)
+{
+  close();
+  m_stream = new std::fstream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!m_stream->is_open()) {
+    delete m_stream;
+    m_stream = NULL;
+    throw vpException(vpException::ioError, "Cannot open the bundle file %s", filename.c_str());
+  }
+  m_filename = filename;
+  m_writing = false;
+  m_sections.clear();
+
+  m_stream->seekg(0, std::ios::end);
+  unsigned long long fileSize = (unsigned long long)m_stream->tellg();
+  m_stream->seekg(0, std::ios::beg);
+
+  char magic[4];
+  unsigned int version = 0;
+  m_stream->read(magic, 4);
+  m_stream->read((char *)&version, sizeof(version));
+  if (!m_stream->good() || magic[0] != vpBundleMagic[0] || magic[1] != vpBundleMagic[1]
+      || magic[2] != vpBundleMagic[2] || magic[3] != vpBundleMagic[3] || version != vpBundleVersion) {
+    close();
+    throw vpException(vpException::ioError, "The file %s is not a bundle", filename.c_str());
+  }
+
+  //Scan the section table : name length, name, payload size, payload
+  for (;;) {
+    unsigned int nameLen = 0;
+    m_stream->read((char *)&nameLen, sizeof(nameLen));
+    if (m_stream->eof())
+      break;
+    if (!m_stream->good() || nameLen == 0 || nameLen > 4096) {
+      close();
+      throw vpException(vpException::ioError, "The bundle %s is truncated or corrupted", filename.c_str());
+    }
+    std::vector<char> name(nameLen);
+    m_stream->read(&name[0], (std::streamsize)nameLen);
+    unsigned long long size = 0;
+    m_stream->read((char *)&size, sizeof(size));
+    if (!m_stream->good()) {
+      close();
+      throw vpException(vpException::ioError, "The bundle %s is truncated or corrupted", filename.c_str());
+    }
+    vpSectionEntry entry;
+    entry.offset = (unsigned long long)m_stream->tellg();
+    entry.size = size;
+    if (entry.size > fileSize || entry.offset + entry.size > fileSize) { // seeking past eof would not fail
+      close();
+      throw vpException(vpException::ioError, "The bundle %s is truncated or corrupted", filename.c_str());
+    }
+    m_sections[std::string(&name[0], nameLen)] = entry;
+    m_stream->seekg((std::streamoff)size, std::ios::cur);
+  }
+  m_stream->clear(); // the table scan ran into eof
+}
+
+/*!
+  Finalize and close the bundle. Called by the destructor.
+*/
+void vpArtifactBundle::close()
+{
+  if (m_stream != NULL) {
+    m_stream->close();
+    delete m_stream;
+    m_stream = NULL;
+  }
+  m_filename.clear();
+  m_writing = false;
+  m_sections.clear();
+}
+
+/*!
+  Append a named section to a bundle being written.
+
+  \param name : Section name, unique within the bundle.
+  \param data : Section payload.
+*/
+void vpArtifactBundle::addSection(const std::string &name, const std::vector<char> &data)
+{
+  addSection(name, data.empty() ? NULL : &data[0], data.size());
+}
+
+/*!
+  Append a named section to a bundle being written.
+
+  \param name : Section name, unique within the bundle.
+  \param data : Section payload, \e size bytes.
+  \param size : Payload size in bytes.
+
+  \exception vpException::ioError : If the bundle is not being written
+  or the write fails.
+*/
+void vpArtifactBundle::addSection(const std::string &name, const char *data, const size_t &size)
+{
+  if (m_stream == NULL || !m_writing)
+    throw vpException(vpException::ioError, "The bundle is not opened for writing");
+  if (hasSection(name))
+    throw vpException(vpException::ioError, "The bundle %s already has a section %s",
+                      m_filename.c_str(), name.c_str());
+
+  unsigned int nameLen = (unsigned int)name.size();
+  unsigned long long size64 = (unsigned long long)size;
+  m_stream->write((const char *)&nameLen, sizeof(nameLen));
+  m_stream->write(name.c_str(), (std::streamsize)nameLen);
+  m_stream->write((const char *)&size64, sizeof(size64));
+  if (size > 0)
+    m_stream->write(data, (std::streamsize)size);
+  if (!m_stream->good())
+    throw vpException(vpException::ioError, "Cannot write the section %s of the bundle %s",
+                      name.c_str(), m_filename.c_str());
+
+  vpSectionEntry entry;
+  entry.offset = 0;
+  entry.size = size64;
+  m_sections[name] = entry;
+}
+
+/*!
+  Append the content of a file as a named section of a bundle being
+  written.
+
+  \param name : Section name, unique within the bundle.
+  \param path : File whose bytes become the section payload.
+
+  \exception vpException::ioError : If the file cannot be read.
+*/
+void vpArtifactBundle::addFile(const std::string &name, const std::string &path)
+{
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    throw vpException(vpException::ioError, "Cannot read the file %s to bundle", path.c_str());
+  file.seekg(0, std::ios::end);
+  std::streamoff size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  std::vector<char> data((size_t)size);
+  if (size > 0)
+    file.read(&data[0], size);
+  if (!file.good())
+    throw vpException(vpException::ioError, "Cannot read the file %s to bundle", path.c_str());
+  addSection(name, data);
+}
+
+/*!
+  Indicates if the bundle holds a section.
+
+  \param name : Section name.
+  \return True if the section exists.
+*/
+bool vpArtifactBundle::hasSection(const std::string &name) const
+{
+  return m_sections.find(name) != m_sections.end();
+}
+
+std::vector<std::string> vpArtifactBundle::getSectionNames() const
+{
+  std::vector<std::string> names;
+  for (std::map<std::string, vpSectionEntry>::const_iterator it = m_sections.begin();
+       it != m_sections.end(); ++it)
+    names.push_back(it->first);
+  return names;
+}
+
+size_t vpArtifactBundle::getSectionSize(const std::string &name) const
+{
+  std::map<std::string, vpSectionEntry>::const_iterator it = m_sections.find(name);
+  return (it == m_sections.end()) ? 0 : (size_t)it->second.size;
+}
+
+/*!
+  Read a section of an open() bundle in memory.
+
+  \param name : Section name.
+  \param data : Filled with the section payload.
+
+  \exception vpException::ioError : If the section does not exist or
+  the read fails.
+*/
+void vpArtifactBundle::getSection(const std::string &name, std::vector<char> &data) const
+{
+  std::map<std::string, vpSectionEntry>::const_iterator it = m_sections.find(name);
+  if (m_stream == NULL || m_writing || it == m_sections.end())
+    throw vpException(vpException::ioError, "No section %s in the bundle %s",
+                      name.c_str(), m_filename.c_str());
+
+  data.resize((size_t)it->second.size);
+  m_stream->seekg((std::streamoff)it->second.offset, std::ios::beg);
+  if (!data.empty())
+    m_stream->read(&data[0], (std::streamsize)it->second.size);
+  if (!m_stream->good())
+    throw vpException(vpException::ioError, "Cannot read the section %s of the bundle %s",
+                      name.c_str(), m_filename.c_str());
+}
+
+/*!
+  Extract a section of an open() bundle to a file, for consumers that
+  only load from a path.
+
+  \param name : Section name.
+  \param path : Destination file, overwritten.
+
+  \exception vpException::ioError : If the section does not exist or a
+  read/write fails.
+*/
+void vpArtifactBundle::extractSection(const std::string &name, const std::string &path) const
+{
+  std::vector<char> data;
+  getSection(name, data);
+  std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw vpException(vpException::ioError, "Cannot write the file %s", path.c_str());
+  if (!data.empty())
+    file.write(&data[0], (std::streamsize)data.size());
+  if (!file.good())
+    throw vpException(vpException::ioError, "Cannot write the file %s", path.c_str());
+}
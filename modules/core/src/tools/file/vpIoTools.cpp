@@ -71,6 +71,7 @@ std::string vpIoTools::baseDir = "";
 std::string vpIoTools::configFile = "";
 std::vector<std::string> vpIoTools::configVars = std::vector<std::string>();
 std::vector<std::string> vpIoTools::configValues = std::vector<std::string>();
+std::map<std::string, unsigned int> vpIoTools::configIndex = std::map<std::string, unsigned int>();
 
 /*!
   Sets the base name (prefix) of the experiment files.
@@ -776,6 +777,7 @@ bool vpIoTools::loadConfigFile(const std::string &confFile)
 {
   configFile = path(confFile);
   configVars.clear();configValues.clear();
+  configIndex.clear();
   std::ifstream confContent(configFile.c_str(), std::ios::in);
 
   if(confContent.is_open())
@@ -803,6 +805,9 @@ bool vpIoTools::loadConfigFile(const std::string &confFile)
           val = line.substr(k+1,c_-k-1);
           configVars.push_back(var);
           configValues.push_back(val);
+          //First definition wins on lookup, matching the historic scan order
+          if (configIndex.find(var) == configIndex.end())
+            configIndex[var] = (unsigned int)(configVars.size()-1);
         }
         catch(...){}
       }
@@ -815,6 +820,82 @@ bool vpIoTools::loadConfigFile(const std::string &confFile)
   return true;
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Serve a configuration value from the index built by loadConfigFile(); the
+  linear scan only remains as a fallback for variables pushed into the
+  protected vectors without going through the loader.
+*/
+bool vpIoTools::getConfigValue(const std::string &var, std::string &value)
+{
+  std::map<std::string, unsigned int>::const_iterator it = configIndex.find(var);
+  if (it != configIndex.end() && it->second < configValues.size()) {
+    value = configValues[it->second];
+    return true;
+  }
+  for(unsigned int k=0;k<configVars.size();++k) {
+    if(configVars[k] == var) {
+      value = configValues[k];
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
+/*!
+  Batch retrieval of double parameters: every variable of \e vars is looked
+  up in the indexed configuration, \e values receiving the parsed value (or
+  0 when absent).
+
+  \param vars : Names of the parameters.
+  \param values : Parsed values, resized like \e vars.
+
+  \return The number of parameters found.
+*/
+unsigned int vpIoTools::readConfigVars(const std::vector<std::string> &vars, std::vector<double> &values)
+{
+  values.resize(vars.size());
+  unsigned int found = 0;
+  std::string str;
+  for (size_t i = 0; i < vars.size(); i++) {
+    values[i] = 0.;
+    if (getConfigValue(vars[i], str)) {
+      if(str.compare("PI") == 0)
+        values[i] = M_PI;
+      else if(str.compare("PI/2") == 0)
+        values[i] = M_PI/2.0;
+      else if(str.compare("-PI/2") == 0)
+        values[i] = -M_PI/2.0;
+      else
+        values[i] = atof(str.c_str());
+      found++;
+    }
+  }
+  return found;
+}
+
+/*!
+  Batch retrieval of string parameters, see
+  readConfigVars(const std::vector<std::string> &, std::vector<double> &).
+
+  \param vars : Names of the parameters.
+  \param values : Raw values, resized like \e vars (empty when absent).
+
+  \return The number of parameters found.
+*/
+unsigned int vpIoTools::readConfigVars(const std::vector<std::string> &vars, std::vector<std::string> &values)
+{
+  values.resize(vars.size());
+  unsigned int found = 0;
+  for (size_t i = 0; i < vars.size(); i++) {
+    values[i] = "";
+    if (getConfigValue(vars[i], values[i]))
+      found++;
+  }
+  return found;
+}
+
 /*!
   Tries to read the parameter named \e var as a \e float.
 
@@ -825,25 +906,20 @@ bool vpIoTools::loadConfigFile(const std::string &confFile)
 */
 bool vpIoTools::readConfigVar(const std::string &var, float &value)
 {
-  bool found = false;
-  for(unsigned int k=0;k<configVars.size() && found==false;++k)
-    {
-      if(configVars[k] == var)
-        {
-          if(configValues[k].compare("PI") == 0)
-              value = (float) M_PI;
-          else if(configValues[k].compare("PI/2") == 0)
-              value = (float) (M_PI/2.0);
-          else if(configValues[k].compare("-PI/2") == 0)
-              value = (float) (-M_PI/2.0);
-          else
-              value = (float) atof(configValues[k].c_str());
-          found = true;
-        }
-    }
-  if(found == false)
-    std::cout << var << " not found in config file" << std::endl;
-  return found;
+  std::string str;
+  if (getConfigValue(var, str)) {
+    if(str.compare("PI") == 0)
+      value = (float) M_PI;
+    else if(str.compare("PI/2") == 0)
+      value = (float) (M_PI/2.0);
+    else if(str.compare("-PI/2") == 0)
+      value = (float) (-M_PI/2.0);
+    else
+      value = (float) atof(str.c_str());
+    return true;
+  }
+  std::cout << var << " not found in config file" << std::endl;
+  return false;
 }
 /*!
   Tries to read the parameter named \e var as a \e double.
@@ -855,25 +931,20 @@ bool vpIoTools::readConfigVar(const std::string &var, float &value)
 */
 bool vpIoTools::readConfigVar(const std::string &var, double &value)
 {
-  bool found = false;
-  for(unsigned int k=0;k<configVars.size() && found==false;++k)
-    {
-      if(configVars[k] == var)
-        {
-          if(configValues[k].compare("PI") == 0)
-              value = M_PI;
-          else if(configValues[k].compare("PI/2") == 0)
-              value = M_PI/2;
-          else if(configValues[k].compare("-PI/2") == 0)
-              value = -M_PI/2;
-          else
-              value = atof(configValues[k].c_str());
-          found = true;
-        }
-    }
-  if(found == false)
-    std::cout << var << " not found in config file" << std::endl;
-  return found;
+  std::string str;
+  if (getConfigValue(var, str)) {
+    if(str.compare("PI") == 0)
+      value = M_PI;
+    else if(str.compare("PI/2") == 0)
+      value = M_PI/2.0;
+    else if(str.compare("-PI/2") == 0)
+      value = -M_PI/2.0;
+    else
+      value = atof(str.c_str());
+    return true;
+  }
+  std::cout << var << " not found in config file" << std::endl;
+  return false;
 }
 
 /*!
@@ -886,18 +957,13 @@ bool vpIoTools::readConfigVar(const std::string &var, double &value)
 */
 bool vpIoTools::readConfigVar(const std::string &var, int &value)
 {
-  bool found = false;
-  for(unsigned int k=0;k<configVars.size() && found==false;++k)
-    {
-      if(configVars[k] == var)
-	{
-	  value = atoi(configValues[k].c_str());
-	  found = true;
-	}
-    }
-  if(found == false)
-    std::cout << var << " not found in config file" << std::endl;
-  return found;
+  std::string str;
+  if (getConfigValue(var, str)) {
+    value = atoi(str.c_str());
+    return true;
+  }
+  std::cout << var << " not found in config file" << std::endl;
+  return false;
 }
 
 /*!
@@ -958,18 +1024,10 @@ bool vpIoTools::readConfigVar(const std::string &var, vpColor &value)
 */
 bool vpIoTools::readConfigVar(const std::string &var, std::string &value)
 {
-  bool found = false;
-  for(unsigned int k=0;k<configVars.size() && found==false;++k)
-    {
-      if(configVars[k] == var)
-	{
-	  value = configValues[k];
-	  found = true;
-	}
-    }
-  if(found == false)
-    std::cout << var << " not found in config file" << std::endl;
-  return found;
+  if (getConfigValue(var, value))
+    return true;
+  std::cout << var << " not found in config file" << std::endl;
+  return false;
 }
 
 /*!
@@ -986,37 +1044,31 @@ bool vpIoTools::readConfigVar(const std::string &var, std::string &value)
 */
 bool vpIoTools::readConfigVar(const std::string &var, vpArray2D<double> &value, const unsigned int &nCols, const unsigned int &nRows)
 {
-  bool found = false;
-  std::string nb;
-  for(unsigned int k=0;k<configVars.size() && found==false;++k)
-  {
-    if(configVars[k] == var)
-    {
-      found = true;
-      // resize or not
-      if(nCols != 0 && nRows != 0)
-        value.resize(nRows, nCols);
-      size_t ind=0,ind2;
-      for(unsigned int i=0;i<value.getRows();++i)
-        for(unsigned int j=0;j<value.getCols();++j)
-        {
-          ind2 = configValues[k].find(",",ind);
-          nb = configValues[k].substr(ind,ind2-ind);
-          if(nb.compare("PI") == 0)
-            value[i][j] = M_PI;
-          else if(nb.compare("PI/2") == 0)
-            value[i][j] = M_PI/2;
-          else if(nb.compare("-PI/2") == 0)
-            value[i][j] = -M_PI/2;
-          else
-            value[i][j] = atof(nb.c_str());
-          ind = ind2+1;
-        }
-    }
+  std::string str, nb;
+  if (getConfigValue(var, str)) {
+    // resize or not
+    if(nCols != 0 && nRows != 0)
+      value.resize(nRows, nCols);
+    size_t ind=0,ind2;
+    for(unsigned int i=0;i<value.getRows();++i)
+      for(unsigned int j=0;j<value.getCols();++j)
+      {
+        ind2 = str.find(",",ind);
+        nb = str.substr(ind,ind2-ind);
+        if(nb.compare("PI") == 0)
+          value[i][j] = M_PI;
+        else if(nb.compare("PI/2") == 0)
+          value[i][j] = M_PI/2;
+        else if(nb.compare("-PI/2") == 0)
+          value[i][j] = -M_PI/2;
+        else
+          value[i][j] = atof(nb.c_str());
+        ind = ind2+1;
+      }
+    return true;
   }
-  if(found == false)
-    std::cout << var << " not found in config file" << std::endl;
-  return found;
+  std::cout << var << " not found in config file" << std::endl;
+  return false;
 }
 
 // construct experiment filename & path
@@ -40,6 +40,7 @@
 
 
 #include <visp3/core/vpPolygon.h>
+#include <algorithm>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpMeterPixelConversion.h>
@@ -322,6 +323,81 @@ vpPolygon::isInside(const vpImagePoint& ip)
   return oddNbIntersections;
 }
 
+/*!
+  Batched point-in-polygon test : the edges are preprocessed once into a
+  per-scanline table of crossing abscissas, then each query point costs a
+  row lookup and a parity count over its (typically two) crossings, so
+  testing thousands of points against the same polygon no longer repeats
+  the per-edge intersection math.
+
+  The scanline rule is the standard half-open even-odd convention;
+  points exactly on an edge may classify differently from the historic
+  random-ray isInside(), which is itself unstable there.
+
+  \param ips : Query points.
+  \param results : results[k] is true when ips[k] lies inside the polygon.
+*/
+void
+vpPolygon::isInside(const std::vector<vpImagePoint> &ips, std::vector<bool> &results) const
+{
+  results.resize(ips.size());
+  if (_corners.size() < 3) {
+    for (size_t k = 0; k < ips.size(); k++)
+      results[k] = false;
+    return;
+  }
+
+  //Scanline table over the integer rows of the bounding box
+  int rowMin = (int)floor(_bbox.getTop());
+  int rowMax = (int)ceil(_bbox.getBottom());
+  //A pathological bounding box must not blow the table up : beyond a
+  //sane span the historic per-point test costs less than the memory
+  if (rowMax - rowMin > (1 << 20)) {
+    vpPolygon copy(*this);
+    for (size_t k = 0; k < ips.size(); k++)
+      results[k] = copy.isInside(ips[k]);
+    return;
+  }
+  unsigned int nbRows = (unsigned int)(rowMax - rowMin + 1);
+  std::vector< std::vector<double> > crossings(nbRows);
+
+  for (unsigned int e = 0; e < _corners.size(); e++) {
+    const vpImagePoint &c1 = _corners[e];
+    const vpImagePoint &c2 = _corners[(e + 1) % _corners.size()];
+    double i1 = c1.get_i(), j1 = c1.get_j();
+    double i2 = c2.get_i(), j2 = c2.get_j();
+    if (i1 == i2)
+      continue; // horizontal edges produce no crossing under the half-open rule
+    double iLow = i1 < i2 ? i1 : i2;
+    double iHigh = i1 < i2 ? i2 : i1;
+    int rFirst = (int)ceil(iLow);
+    int rLast = (int)ceil(iHigh) - 1; // [iLow, iHigh) half-open
+    if (rFirst < rowMin) rFirst = rowMin;
+    if (rLast > rowMax) rLast = rowMax;
+    double slope = (j2 - j1) / (i2 - i1);
+    for (int r = rFirst; r <= rLast; r++)
+      crossings[(unsigned int)(r - rowMin)].push_back(j1 + (r - i1) * slope);
+  }
+  for (unsigned int r = 0; r < nbRows; r++)
+    std::sort(crossings[r].begin(), crossings[r].end());
+
+  for (size_t k = 0; k < ips.size(); k++) {
+    double i = ips[k].get_i();
+    double j = ips[k].get_j();
+    int r = (int)floor(i + 0.5);
+    if (r < rowMin || r > rowMax) {
+      results[k] = false;
+      continue;
+    }
+    const std::vector<double> &row = crossings[(unsigned int)(r - rowMin)];
+    unsigned int below = 0;
+    for (size_t c = 0; c < row.size(); c++)
+      if (row[c] <= j)
+        below++;
+    results[k] = (below & 1u) != 0;
+  }
+}
+
 
 
 /*!
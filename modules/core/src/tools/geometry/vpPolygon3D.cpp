@@ -52,14 +52,18 @@
 vpPolygon3D::vpPolygon3D()
   : nbpt(0), nbCornersInsidePrev(0),
     p(NULL), polyClipped(), clippingFlag(vpPolygon3D::NO_CLIPPING),
-    distNearClip(0.001), distFarClip(100.)
+    distNearClip(0.001), distFarClip(100.),
+    clipX(), clipY(), clipZ(), m_clipScratch1(), m_clipScratch2(), clipCachedPose(), hasClipCachedPose(false),
+    clipCacheTolerance(0.), lastChangeFramePose()
 {
 }
 
 vpPolygon3D::vpPolygon3D(const vpPolygon3D& mbtp)
   : nbpt(mbtp.nbpt), nbCornersInsidePrev(mbtp.nbCornersInsidePrev),
     p(NULL), polyClipped(mbtp.polyClipped), clippingFlag(mbtp.clippingFlag),
-    distNearClip(mbtp.distNearClip), distFarClip(mbtp.distFarClip)
+    distNearClip(mbtp.distNearClip), distFarClip(mbtp.distFarClip),
+    clipX(), clipY(), clipZ(), m_clipScratch1(), m_clipScratch2(), clipCachedPose(mbtp.clipCachedPose), hasClipCachedPose(mbtp.hasClipCachedPose),
+    clipCacheTolerance(mbtp.clipCacheTolerance), lastChangeFramePose(mbtp.lastChangeFramePose)
 {
   if (p) delete [] p;
   p = new vpPoint [nbpt];
@@ -75,6 +79,10 @@ vpPolygon3D& vpPolygon3D::operator=(const vpPolygon3D& mbtp)
   clippingFlag = mbtp.clippingFlag;
   distNearClip = mbtp.distNearClip;
   distFarClip = mbtp.distFarClip;
+  clipCachedPose = mbtp.clipCachedPose;
+  hasClipCachedPose = mbtp.hasClipCachedPose;
+  clipCacheTolerance = mbtp.clipCacheTolerance;
+  lastChangeFramePose = mbtp.lastChangeFramePose;
 
   if (p) delete [] p;
   p = new vpPoint [nbpt];
@@ -124,6 +132,7 @@ vpPolygon3D::setNbPoint(const unsigned int nb)
   if (p != NULL)
     delete[] p;
   p = new vpPoint[nb] ;
+  hasClipCachedPose = false;
 }
 
 /*!
@@ -147,6 +156,7 @@ vpPolygon3D::addPoint(const unsigned int n, const vpPoint &P)
 void
 vpPolygon3D::changeFrame(const vpHomogeneousMatrix &cMo)
 {
+  lastChangeFramePose = cMo;
   for (unsigned int i = 0 ; i < nbpt ; i++)
   {
     p[i].changeFrame(cMo) ;
@@ -164,23 +174,93 @@ vpPolygon3D::changeFrame(const vpHomogeneousMatrix &cMo)
 void
 vpPolygon3D::computePolygonClipped(const vpCameraParameters &cam)
 {
+  // Temporal reuse: when the pose barely moved since the last effective
+  // clipping, the previous content of polyClipped is still valid within the
+  // configured tolerance and the whole clipping can be skipped.
+  if(hasClipCachedPose && clipCacheTolerance > 0){
+    vpHomogeneousMatrix deltaPose = clipCachedPose.inverse() * lastChangeFramePose;
+    vpTranslationVector dt;
+    vpThetaUVector dtu;
+    deltaPose.extract(dt);
+    deltaPose.extract(dtu);
+    double dTrans = sqrt(dt.sumSquare());
+    double dRot = sqrt(dtu[0]*dtu[0] + dtu[1]*dtu[1] + dtu[2]*dtu[2]);
+    if(dTrans < clipCacheTolerance && dRot < clipCacheTolerance)
+      return;
+  }
+
   polyClipped.clear();
   std::vector<vpColVector> fovNormals;
-  std::vector<std::pair<vpPoint,unsigned int> > polyClippedTemp;
-  std::vector<std::pair<vpPoint,unsigned int> > polyClippedTemp2;
+  //Persistent scratch : clear() keeps the capacity across frames
+  std::vector<std::pair<vpPoint,unsigned int> > &polyClippedTemp = m_clipScratch1;
+  std::vector<std::pair<vpPoint,unsigned int> > &polyClippedTemp2 = m_clipScratch2;
+  polyClippedTemp.clear();
+  polyClippedTemp2.clear();
 
   if(cam.isFovComputed() && clippingFlag > 3)
     fovNormals = cam.getFovNormals();
 
+  // Batched plane pre-pass: classify all the vertices against each active
+  // plane in one sweep over SoA copies of the camera frame coordinates. Only
+  // the planes that the polygon straddles are kept for the edge-by-edge
+  // clipping below; when tracking, the polygon most of the time lies entirely
+  // inside the frustum and the clipping reduces to a plain copy.
+  unsigned int planesToClip = vpPolygon3D::NO_CLIPPING;
+  if(clippingFlag != vpPolygon3D::NO_CLIPPING){
+    clipX.resize(nbpt);
+    clipY.resize(nbpt);
+    clipZ.resize(nbpt);
+    for(unsigned int i = 0 ; i < nbpt ; i++){
+      clipX[i] = p[i].get_X();
+      clipY[i] = p[i].get_Y();
+      clipZ[i] = p[i].get_Z();
+    }
+
+    for(unsigned int i = 1 ; i < 64 ; i=i*2){
+      if(((clippingFlag & i) == i) || ((clippingFlag > vpPolygon3D::FAR_CLIPPING) && (i==1))){
+        unsigned int nbInside = 0;
+        if(i == vpPolygon3D::NEAR_CLIPPING){
+          for(unsigned int j = 0 ; j < nbpt ; j++)
+            if(clipZ[j] >= distNearClip) nbInside++;
+        }
+        else if(i == vpPolygon3D::FAR_CLIPPING){
+          for(unsigned int j = 0 ; j < nbpt ; j++)
+            if(clipZ[j] <= distFarClip) nbInside++;
+        }
+        else if(!fovNormals.empty()){
+          const vpColVector &normal = fovNormals[(i == vpPolygon3D::LEFT_CLIPPING) ? 0 :
+                                                 (i == vpPolygon3D::RIGHT_CLIPPING) ? 1 :
+                                                 (i == vpPolygon3D::UP_CLIPPING) ? 2 : 3];
+          for(unsigned int j = 0 ; j < nbpt ; j++)
+            if(normal[0]*clipX[j] + normal[1]*clipY[j] + normal[2]*clipZ[j] <= 0) nbInside++;
+        }
+        else{
+          // FOV normals not available: leave the plane to the generic code
+          planesToClip = planesToClip | i;
+          continue;
+        }
+
+        if(nbInside == 0){
+          // Every vertex lies outside this plane: the polygon is fully clipped
+          clipCachedPose = lastChangeFramePose;
+          hasClipCachedPose = true;
+          return;
+        }
+        if(nbInside != nbpt)
+          planesToClip = planesToClip | i;
+      }
+    }
+  }
+
   for(unsigned int i = 0 ; i < nbpt ; i++){
       p[i%nbpt].projection();
       polyClippedTemp.push_back(std::make_pair(p[i%nbpt],vpPolygon3D::NO_CLIPPING));
   }
 
-  if(clippingFlag != vpPolygon3D::NO_CLIPPING)
+  if(planesToClip != vpPolygon3D::NO_CLIPPING)
   for(unsigned int i = 1 ; i < 64 ; i=i*2)
   {
-      if(((clippingFlag & i) == i) || ((clippingFlag > vpPolygon3D::FAR_CLIPPING) && (i==1)))
+      if((planesToClip & i) == i)
       {
       for(unsigned int j = 0 ; j < polyClippedTemp.size() ; j++)
       {
@@ -248,6 +328,9 @@ vpPolygon3D::computePolygonClipped(const vpCameraParameters &cam)
   }
 
   polyClipped = polyClippedTemp;
+
+  clipCachedPose = lastChangeFramePose;
+  hasClipCachedPose = true;
 }
     
 /*!
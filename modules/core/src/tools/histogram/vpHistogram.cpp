@@ -283,10 +283,30 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, const unsigned int
     unsigned char *ptrEnd = ptrStart + size_;
     unsigned char *ptrCurrent = ptrStart;
 
+    // Accumulate in four partial histograms to break the dependency on
+    // the increment of a single bin, which lets consecutive pixels be
+    // processed in parallel by the pipeline; size never exceeds 256
+    unsigned int partial[3*256];
+    memset(partial, 0, size*3 * sizeof(unsigned int));
+    unsigned int *histo1 = partial;
+    unsigned int *histo2 = histo1 + size;
+    unsigned int *histo3 = histo2 + size;
+
+    while(ptrCurrent + 4 <= ptrEnd) {
+      histogram[ lut[ ptrCurrent[0] ] ] ++;
+      histo1[ lut[ ptrCurrent[1] ] ] ++;
+      histo2[ lut[ ptrCurrent[2] ] ] ++;
+      histo3[ lut[ ptrCurrent[3] ] ] ++;
+      ptrCurrent += 4;
+    }
     while(ptrCurrent != ptrEnd) {
       histogram[ lut[ *ptrCurrent ] ] ++;
       ++ptrCurrent;
     }
+
+    for(unsigned int i = 0; i < size; i++) {
+      histogram[i] += histo1[i] + histo2[i] + histo3[i];
+    }
   } else {
 #if defined(VISP_HAVE_PTHREAD) || defined(_WIN32)
     //Multi-threads
@@ -348,6 +368,63 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, const unsigned int
   }
 }
 
+/*!
+  Update incrementally the histogram when only a region of the image has
+  changed since the last calculate() or update() call: the contribution
+  of the previous content of the region is removed and the one of the new
+  content added, which costs a traversal of the region instead of the
+  whole image.
+
+  \param Iprev : Image from which the current histogram was computed.
+  \param I : New image, differing from \e Iprev only inside \e roi.
+  \param roi : Region of \e I where the content has changed.
+
+  \exception vpImageException::notInitializedError : If the histogram
+  array is not allocated.
+  \exception vpException::dimensionError : If the two images have
+  different sizes or if the region does not fit in the image.
+
+  \sa calculate()
+*/
+void vpHistogram::update(const vpImage<unsigned char> &Iprev, const vpImage<unsigned char> &I,
+    const vpRect &roi)
+{
+  if (histogram == NULL || size == 0) {
+    throw(vpImageException(vpImageException::notInitializedError,
+                           "Histogram array not initialized: call calculate() before update()")) ;
+  }
+  if (Iprev.getWidth() != I.getWidth() || Iprev.getHeight() != I.getHeight()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot update the histogram with a (%dx%d) previous image and a (%dx%d) image",
+                      Iprev.getHeight(), Iprev.getWidth(), I.getHeight(), I.getWidth())) ;
+  }
+
+  unsigned int top = (unsigned int)roi.getTop();
+  unsigned int left = (unsigned int)roi.getLeft();
+  unsigned int bottom = (unsigned int)roi.getBottom();
+  unsigned int right = (unsigned int)roi.getRight();
+
+  if (bottom >= I.getHeight() || right >= I.getWidth()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot update the histogram: the region does not fit in the (%dx%d) image",
+                      I.getHeight(), I.getWidth())) ;
+  }
+
+  unsigned int lut[256];
+  for(unsigned int i = 0; i < 256; i++) {
+    lut[i] = (unsigned int) (i * size / 256.0);
+  }
+
+  for (unsigned int i = top; i <= bottom; i++) {
+    const unsigned char *rowPrev = Iprev[i];
+    const unsigned char *row = I[i];
+    for (unsigned int j = left; j <= right; j++) {
+      histogram[ lut[ rowPrev[j] ] ] --;
+      histogram[ lut[ row[j] ] ] ++;
+    }
+  }
+}
+
 /*!
   Display the histogram distribution in an image, the minimal image size is 36x36 px.
 
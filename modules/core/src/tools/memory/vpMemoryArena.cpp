@@ -0,0 +1,156 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bump allocator recycling the scratch memory of iterative loops.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpMemoryArena.h>
+#include <visp3/core/vpException.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Alignment of the block and of every returned slice; matches the
+// alignment guaranteed by vpArray2D so that vectorized kernels can
+// process arena buffers the same way
+#define VP_MEMORY_ARENA_ALIGNMENT 64
+
+// Allocate a 64-byte aligned block compatible with free()
+static unsigned char *vpArenaAllocBlock(size_t nbytes)
+{
+  void *ptr = NULL;
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  if (posix_memalign(&ptr, VP_MEMORY_ARENA_ALIGNMENT, nbytes) != 0)
+    ptr = NULL;
+#else
+  ptr = malloc(nbytes);
+#endif
+  if (ptr == NULL) {
+    throw(vpException(vpException::memoryAllocationError,
+                      "Memory allocation error when allocating an arena block")) ;
+  }
+  return (unsigned char *)ptr;
+}
+
+/*!
+  Construct an arena owning one block of \e capacity bytes.
+
+  \param capacity : Initial capacity in bytes; the arena grows as needed.
+*/
+vpMemoryArena::vpMemoryArena(size_t capacity)
+  : m_block(NULL), m_capacity(capacity), m_used(0), m_high_water(0),
+    m_retired_used(0), m_retired()
+{
+  if (m_capacity == 0)
+    m_capacity = 4096;
+  m_block = vpArenaAllocBlock(m_capacity);
+}
+
+vpMemoryArena::~vpMemoryArena()
+{
+  for (size_t i = 0; i < m_retired.size(); i++)
+    free(m_retired[i]);
+  if (m_block != NULL)
+    free(m_block);
+}
+
+/*!
+  Hand out a 64-byte aligned slice of \e nbytes bytes. The content is
+  uninitialized. When the current block is exhausted a larger one takes
+  over while the exhausted one is kept alive until reset(), so that the
+  slices already handed out stay valid; the next reset() then regrows
+  the arena in one block and the steady state of a loop whose per
+  iteration usage is stable performs no allocation.
+
+  \param nbytes : Number of bytes of the slice.
+  \return Pointer on the slice, valid until the next reset().
+*/
+void *vpMemoryArena::allocate(size_t nbytes)
+{
+  // Round the slice up so that the next one stays aligned
+  size_t rounded = (nbytes + VP_MEMORY_ARENA_ALIGNMENT-1) & ~(size_t)(VP_MEMORY_ARENA_ALIGNMENT-1);
+
+  if (m_used + rounded > m_capacity) {
+    // The slices already handed out must stay valid until reset(): the
+    // exhausted block is retired, kept alive, and a larger one takes over
+    size_t new_capacity = m_capacity*2;
+    while (rounded > new_capacity)
+      new_capacity *= 2;
+    unsigned char *new_block = vpArenaAllocBlock(new_capacity);
+    m_retired.push_back(m_block);
+    m_retired_used += m_used;
+    m_block = new_block;
+    m_capacity = new_capacity;
+    m_used = 0;
+  }
+
+  void *ptr = m_block + m_used;
+  m_used += rounded;
+  if (m_retired_used + m_used > m_high_water)
+    m_high_water = m_retired_used + m_used;
+  return ptr;
+}
+
+/*!
+  Hand out an aligned array of \e n doubles, uninitialized.
+
+  \param n : Number of doubles.
+  \return Pointer on the array, valid until the next reset().
+*/
+double *vpMemoryArena::allocateDoubles(unsigned int n)
+{
+  return (double *)allocate(n*sizeof(double));
+}
+
+/*!
+  Recycle the arena in constant time: every slice handed out since the
+  last reset() becomes invalid and the memory is reused by the next
+  allocations. When the previous iterations needed more than the current
+  block, the block is regrown here, while no allocation is live.
+*/
+void vpMemoryArena::reset()
+{
+  for (size_t i = 0; i < m_retired.size(); i++)
+    free(m_retired[i]);
+  m_retired.clear();
+  m_retired_used = 0;
+  m_used = 0;
+  if (m_high_water > m_capacity) {
+    // An iteration spilled in retired blocks: regrow the main block now
+    // that no allocation is live, so that the next iterations fit in one
+    free(m_block);
+    m_capacity = m_high_water;
+    m_block = vpArenaAllocBlock(m_capacity);
+  }
+}
@@ -229,6 +229,358 @@ int vpNetwork::sendRequestTo(vpRequest &req, const unsigned int &dest)
   return value;
 }
 
+//Framing constants of the binary scatter-gather messaging path.
+static const unsigned int vpNetworkBinaryMagic = 0x56504e42; // "VPNB"
+static const unsigned int vpNetworkBinaryMaxSegments = 64;
+static const unsigned int vpNetworkBinaryMaxIdSize = 1024;
+
+/*!
+  Send a binary request to the first receptor in the list.
+  
+  \sa vpNetwork::sendBinaryRequestTo()
+  
+  \param id : Id of the request.
+  \param buffers : Caller-owned segments to send.
+  \param nbBuffers : Number of segments.
+  
+  \return The number of bytes that have been sent, -1 if an error occured.
+*/
+int vpNetwork::sendBinaryRequest(const char *id, const vpNetworkBuffer *buffers, const unsigned int &nbBuffers)
+{
+  return sendBinaryRequestTo(id,buffers,nbBuffers,0);
+}
+
+/*!
+  Send a binary request to a specific receptor. Unlike sendRequestTo(), the
+  message is not assembled into an intermediate string : a length-prefixed
+  header is built on the stack and the caller-owned segments are handed to
+  the kernel in a single scatter-gather call.
+  
+  The frame layout is : magic, id size, number of segments, the segment
+  sizes, the id characters, then the raw segment bytes. All the size fields
+  are unsigned int in host byte order, as for the objects sent with
+  vpNetwork::send().
+  
+  \sa vpNetwork::sendBinaryRequest()
+  \sa vpNetwork::receiveBinaryRequestFrom()
+  
+  \param id : Id of the request.
+  \param buffers : Caller-owned segments to send.
+  \param nbBuffers : Number of segments.
+  \param dest : Index of the receptor receiving the request.
+  
+  \return The number of bytes that have been sent, -1 if an error occured.
+*/
+int vpNetwork::sendBinaryRequestTo(const char *id, const vpNetworkBuffer *buffers, const unsigned int &nbBuffers, const unsigned int &dest)
+{
+  int size = (int)receptor_list.size();
+  int sizeMinusOne = (int)receptor_list.size()-1;
+  if(size == 0 || dest > (unsigned)sizeMinusOne)
+  {
+    if(verboseMode)
+      vpTRACE( "Cannot Send Request! Bad Index" );
+    return 0;
+  }
+  
+  unsigned int idSize = (unsigned int)strlen(id);
+  if(idSize == 0 || idSize > vpNetworkBinaryMaxIdSize || nbBuffers > vpNetworkBinaryMaxSegments)
+  {
+    if(verboseMode)
+      vpTRACE( "Cannot Send Request! Bad id or too many segments" );
+    return -1;
+  }
+  
+  unsigned int header[3 + vpNetworkBinaryMaxSegments];
+  header[0] = vpNetworkBinaryMagic;
+  header[1] = idSize;
+  header[2] = nbBuffers;
+  for(unsigned int i = 0 ; i < nbBuffers ; i++)
+    header[3+i] = buffers[i].size;
+  
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  struct iovec iov[2 + vpNetworkBinaryMaxSegments];
+  iov[0].iov_base = (void*)header;
+  iov[0].iov_len = (3 + nbBuffers)*sizeof(unsigned int);
+  iov[1].iov_base = (void*)id;
+  iov[1].iov_len = idSize;
+  int iovCount = 2;
+  for(unsigned int i = 0 ; i < nbBuffers ; i++){
+    if(buffers[i].size == 0)
+      continue;
+    iov[iovCount].iov_base = buffers[i].data;
+    iov[iovCount].iov_len = buffers[i].size;
+    iovCount++;
+  }
+  
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = (size_t)iovCount;
+  
+  int flags = 0;
+#if defined(__linux__)
+  flags = MSG_NOSIGNAL; // Only for Linux
+#endif
+  
+  size_t remaining = 0;
+  for(int i = 0 ; i < iovCount ; i++)
+    remaining += iov[i].iov_len;
+  
+  int first = 0;
+  for(;;)
+  {
+    ssize_t sent = sendmsg(receptor_list[dest].socketFileDescriptorReceptor, &msg, flags);
+    if(sent < 0)
+      return -1;
+    
+    remaining -= (size_t)sent;
+    if(remaining == 0)
+      break;
+    
+    //Partial write : advance the segments past the bytes the kernel took.
+    size_t skip = (size_t)sent;
+    while(skip >= iov[first].iov_len){
+      skip -= iov[first].iov_len;
+      first++;
+    }
+    iov[first].iov_base = (char*)iov[first].iov_base + skip;
+    iov[first].iov_len -= skip;
+    msg.msg_iov = &iov[first];
+    msg.msg_iovlen = (size_t)(iovCount - first);
+  }
+  
+  unsigned int frameSize = (3 + nbBuffers)*(unsigned int)sizeof(unsigned int) + idSize;
+  for(unsigned int i = 0 ; i < nbBuffers ; i++)
+    frameSize += buffers[i].size;
+  return (int)frameSize;
+#else
+  WSABUF wsaBuf[2 + vpNetworkBinaryMaxSegments];
+  wsaBuf[0].buf = (char*)header;
+  wsaBuf[0].len = (3 + nbBuffers)*sizeof(unsigned int);
+  wsaBuf[1].buf = (char*)id;
+  wsaBuf[1].len = idSize;
+  DWORD bufCount = 2;
+  for(unsigned int i = 0 ; i < nbBuffers ; i++){
+    if(buffers[i].size == 0)
+      continue;
+    wsaBuf[bufCount].buf = (char*)buffers[i].data;
+    wsaBuf[bufCount].len = buffers[i].size;
+    bufCount++;
+  }
+  
+  DWORD numbytes = 0;
+  if(WSASend(receptor_list[dest].socketFileDescriptorReceptor, wsaBuf, bufCount, &numbytes, 0, NULL, NULL) != 0)
+    return -1;
+  return (int)numbytes;
+#endif
+}
+
+/*!
+  Receive a binary request from the first ready receptor.
+  
+  \sa vpNetwork::receiveBinaryRequestFrom()
+  
+  \param id : Id of the received request.
+  \param buffers : Caller-owned segments receiving the payload.
+  \param nbBuffers : Number of segments.
+  
+  \return The number of payload bytes received, 0 if a timeout occured, -1 if an error occured.
+*/
+int vpNetwork::receiveBinaryRequest(std::string &id, vpNetworkBuffer *buffers, const unsigned int &nbBuffers)
+{
+  if(receptor_list.size() == 0)
+  {
+    if(verboseMode)
+      vpTRACE( "No Receptor!" );
+    return -1;
+  }
+  
+  tv.tv_sec = tv_sec;
+#if TARGET_OS_IPHONE
+  tv.tv_usec = (int)tv_usec;
+#else
+  tv.tv_usec = tv_usec;
+#endif
+
+  FD_ZERO(&readFileDescriptor);        
+  
+  for(unsigned int i=0; i<receptor_list.size(); i++){ 
+    if(i == 0)
+      socketMax = receptor_list[i].socketFileDescriptorReceptor;
+    
+    FD_SET((unsigned)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor); 
+    if(socketMax < receptor_list[i].socketFileDescriptorReceptor) socketMax = receptor_list[i].socketFileDescriptorReceptor; 
+  }
+
+  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
+  
+  if(value == -1){
+    if(verboseMode)
+      vpERROR_TRACE( "Select error" );
+    return -1;
+  }
+  else if(value == 0){
+    //Timeout
+    return 0;
+  }
+  
+  for(unsigned int i=0; i<receptor_list.size(); i++){
+    if(FD_ISSET((unsigned int)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor))
+      return receiveBinaryRequestFrom(id,buffers,nbBuffers,i);
+  }
+  
+  return -1;
+}
+
+/*!
+  Receive a binary request sent by vpNetwork::sendBinaryRequestTo() from a
+  specific receptor. The payload segments are read straight into the
+  caller-owned \e buffers, without intermediate string storage : each wire
+  segment must fit into the matching entry of \e buffers, whose size is
+  updated to the number of bytes actually received.
+  
+  Contrary to receiveRequestFrom(), once the frame header has been seen this
+  function blocks until the entire frame has been read.
+  
+  \warning When -1 is returned part of a frame may have been consumed and
+  the connection has to be considered desynchronized.
+  
+  \sa vpNetwork::sendBinaryRequestTo()
+  \sa vpNetwork::receiveBinaryRequest()
+  
+  \param id : Id of the received request.
+  \param buffers : Caller-owned segments receiving the payload.
+  \param nbBuffers : Number of segments.
+  \param receptorEmitting : Index of the receptor emitting the message.
+  
+  \return The number of payload bytes received, 0 if a timeout occured, -1 if an error occured.
+*/
+int vpNetwork::receiveBinaryRequestFrom(std::string &id, vpNetworkBuffer *buffers, const unsigned int &nbBuffers, const unsigned int &receptorEmitting)
+{
+  int size = (int)receptor_list.size();
+  int sizeMinusOne = (int)receptor_list.size()-1;
+  if(size == 0 || receptorEmitting > (unsigned)sizeMinusOne )
+  {
+    if(verboseMode)
+      vpTRACE( "No receptor at the specified index!" );
+    return -1;
+  }
+  
+  int value = _selectOnReceptor(receptorEmitting);
+  if(value <= 0)
+    return value;
+  
+  unsigned int header[3];
+  if(_receiveAll(receptorEmitting, header, sizeof(header)) <= 0)
+    return -1;
+  
+  if(header[0] != vpNetworkBinaryMagic || header[1] == 0 || header[1] > vpNetworkBinaryMaxIdSize
+     || header[2] > vpNetworkBinaryMaxSegments)
+  {
+    if(verboseMode)
+      vpTRACE( "Incorrect message" );
+    return -1;
+  }
+  
+  unsigned int idSize = header[1];
+  unsigned int nbSegments = header[2];
+  
+  unsigned int segmentSize[vpNetworkBinaryMaxSegments];
+  if(nbSegments != 0 && _receiveAll(receptorEmitting, segmentSize, nbSegments*(unsigned int)sizeof(unsigned int)) <= 0)
+    return -1;
+  
+  char idBuf[vpNetworkBinaryMaxIdSize];
+  if(_receiveAll(receptorEmitting, idBuf, idSize) <= 0)
+    return -1;
+  id.assign(idBuf, (size_t)idSize);
+  
+  if(nbSegments > nbBuffers)
+  {
+    if(verboseMode)
+      vpTRACE( "Not enough segments to store the received message" );
+    return -1;
+  }
+  
+  int numbytes = 0;
+  for(unsigned int i = 0 ; i < nbSegments ; i++)
+  {
+    if(segmentSize[i] > buffers[i].size)
+    {
+      if(verboseMode)
+        vpTRACE( "Received segment bigger than the caller storage" );
+      return -1;
+    }
+    
+    if(segmentSize[i] != 0 && _receiveAll(receptorEmitting, buffers[i].data, segmentSize[i]) <= 0)
+      return -1;
+    
+    buffers[i].size = segmentSize[i];
+    numbytes += (int)segmentSize[i];
+  }
+  for(unsigned int i = nbSegments ; i < nbBuffers ; i++)
+    buffers[i].size = 0;
+  
+  return numbytes;
+}
+
+/*!
+  Wait until the receptor at the index \e receptor becomes readable, in the
+  limit of the configured timeout.
+  
+  \return 1 if the receptor is readable, 0 on timeout, -1 if an error occured.
+*/
+int vpNetwork::_selectOnReceptor(const unsigned int &receptor)
+{
+  tv.tv_sec = tv_sec;
+#if TARGET_OS_IPHONE
+  tv.tv_usec = (int)tv_usec;
+#else
+  tv.tv_usec = tv_usec;
+#endif
+
+  FD_ZERO(&readFileDescriptor);        
+  
+  socketMax = receptor_list[receptor].socketFileDescriptorReceptor;
+  FD_SET((unsigned int)receptor_list[receptor].socketFileDescriptorReceptor,&readFileDescriptor);
+
+  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
+  if(value == -1){
+    if(verboseMode)
+      vpERROR_TRACE( "Select error" );
+    return -1;
+  }
+  return value == 0 ? 0 : 1;
+}
+
+/*!
+  Receive exactly \e size bytes from the receptor at the index \e receptor,
+  straight into the caller storage \e buffer. Erases the receptor from the
+  list if the connection has been closed.
+  
+  \return The number of bytes received, or a value <= 0 if an error occured.
+*/
+int vpNetwork::_receiveAll(const unsigned int &receptor, void *buffer, const unsigned int &size)
+{
+  unsigned int received = 0;
+  while(received < size)
+  {
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+    int numbytes=(int)recv(receptor_list[receptor].socketFileDescriptorReceptor, (char*)buffer + received, size - received, 0);
+#else
+    int numbytes=recv((unsigned int)receptor_list[receptor].socketFileDescriptorReceptor, (char*)buffer + received, (int)(size - received), 0);
+#endif
+    if(numbytes <= 0)
+    {
+      std::cout << "Disconnected : " << inet_ntoa(receptor_list[receptor].receptorAddress.sin_addr) << std::endl;
+      receptor_list.erase(receptor_list.begin()+(int)receptor);
+      return numbytes;
+    }
+    received += (unsigned int)numbytes;
+  }
+  
+  return (int)received;
+}
+
 /*!
   Send and encode a request to the first receptor in the list.
   
@@ -748,23 +1100,9 @@ int vpNetwork::_receiveRequestOnceFrom(const unsigned int &receptorEmitting)
     return -1;
   }
   
-  tv.tv_sec = tv_sec;
-#if TARGET_OS_IPHONE
-  tv.tv_usec = (int)tv_usec;
-#else
-  tv.tv_usec = tv_usec;
-#endif
-
-  FD_ZERO(&readFileDescriptor);        
-  
-  socketMax = receptor_list[receptorEmitting].socketFileDescriptorReceptor;
-  FD_SET((unsigned int)receptor_list[receptorEmitting].socketFileDescriptorReceptor,&readFileDescriptor);
-
-  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
+  int value = _selectOnReceptor(receptorEmitting);
   int numbytes = 0;
   if(value == -1){
-    if(verboseMode)
-      vpERROR_TRACE( "Select error" );
     return -1;
   }
   else if(value == 0){
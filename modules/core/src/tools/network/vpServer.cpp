@@ -37,6 +37,12 @@
 
 #include <visp3/core/vpServer.h>
 
+#ifdef __linux__
+#  include <sys/epoll.h>
+#  include <fcntl.h>
+#  include <errno.h>
+#endif
+
 #if defined(__APPLE__) && defined(__MACH__) // Apple OSX and iOS (Darwin)
 #  include <TargetConditionals.h> // To detect OSX or IOS using TARGET_OS_IPHONE or TARGET_OS_IOS macro
 #endif
@@ -44,7 +50,12 @@
 /*!
   Construct a server on the machine launching it.
 */
-vpServer::vpServer( ) : adress(), port(0), started(false), max_clients(10)
+vpServer::vpServer( ) : adress(), port(0), started(false), max_clients(10),
+    useEventLoop(false),
+#ifdef __linux__
+    epollFd(-1), fdToReceptor(), pendingCloseFds(),
+#endif
+    receptorBuffers()
 {
   int protocol = 0;
   emitter.socketFileDescriptorEmitter = socket(AF_INET, SOCK_STREAM, protocol);
@@ -69,7 +80,12 @@ vpServer::vpServer( ) : adress(), port(0), started(false), max_clients(10)
   
   \param port_serv : server's port.
 */
-vpServer::vpServer( const int &port_serv ) : adress(), port(0), started(false), max_clients(10)
+vpServer::vpServer( const int &port_serv ) : adress(), port(0), started(false), max_clients(10),
+    useEventLoop(false),
+#ifdef __linux__
+    epollFd(-1), fdToReceptor(), pendingCloseFds(),
+#endif
+    receptorBuffers()
 {
   int protocol = 0;
   emitter.socketFileDescriptorEmitter = socket(AF_INET, SOCK_STREAM, protocol);
@@ -96,7 +112,12 @@ vpServer::vpServer( const int &port_serv ) : adress(), port(0), started(false),
   \param port_serv : server's port.
 */
 vpServer::vpServer( const std::string &adress_serv,const int &port_serv )
-  : adress(), port(0), started(false), max_clients(10)
+  : adress(), port(0), started(false), max_clients(10),
+    useEventLoop(false),
+#ifdef __linux__
+    epollFd(-1), fdToReceptor(), pendingCloseFds(),
+#endif
+    receptorBuffers()
 {
   int protocol = 0;
   emitter.socketFileDescriptorEmitter = socket(AF_INET, SOCK_STREAM, protocol);
@@ -121,6 +142,10 @@ vpServer::vpServer( const std::string &adress_serv,const int &port_serv )
 */
 vpServer::~vpServer()
 {
+#ifdef __linux__
+  if( epollFd != -1 )
+    close( epollFd );
+#endif
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
   close( emitter.socketFileDescriptorEmitter );
 #else //Win32
@@ -277,6 +302,407 @@ bool vpServer::checkForConnections()
   return false;
 }
 
+/*!
+  Enable or disable the event loop mode. In this mode the readiness of the
+  listening socket and of every connected client is reported by the
+  operating system (epoll on Linux, edge-triggered) through
+  vpServer::waitForEvents(), instead of being rediscovered by a select()
+  and a scan of the whole receptor list at each call. Each connection also
+  gets its own receive buffer, filled when the connection becomes readable
+  and parsed with vpServer::receiveBufferedRequestsFrom().
+  
+  \warning In this mode the connected sockets are switched to non-blocking
+  and the messages have to be received through the buffered functions; the
+  select() based receives of vpNetwork keep working but may return 0 on a
+  connection whose bytes have already been drained into its buffer.
+  
+  On the platforms without epoll support the mode cannot be enabled but
+  vpServer::waitForEvents() remains usable : it then falls back on a
+  select() over the receptor list.
+  
+  \sa vpServer::waitForEvents()
+  \sa vpServer::receiveBufferedRequestsFrom()
+  
+  \param enable : True to enable the event loop mode, false to disable it.
+  
+  \return True if the requested mode is in use, false otherwise.
+*/
+bool vpServer::setEventLoopMode(const bool &enable)
+{
+#ifdef __linux__
+  if(enable == useEventLoop)
+    return true;
+  
+  if(enable)
+  {
+    epollFd = epoll_create(1);
+    if(epollFd == -1)
+    {
+      vpERROR_TRACE( "vpServer::setEventLoopMode(), cannot create the epoll instance" );
+      return false;
+    }
+    
+    //The listening socket is drained with an accept loop, so it has to be
+    //non-blocking as well.
+    fcntl(emitter.socketFileDescriptorEmitter, F_SETFL,
+          fcntl(emitter.socketFileDescriptorEmitter, F_GETFL, 0) | O_NONBLOCK);
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = emitter.socketFileDescriptorEmitter;
+    if(epoll_ctl(epollFd, EPOLL_CTL_ADD, emitter.socketFileDescriptorEmitter, &ev) == -1)
+    {
+      vpERROR_TRACE( "vpServer::setEventLoopMode(), cannot watch the listening socket" );
+      close(epollFd);
+      epollFd = -1;
+      return false;
+    }
+    
+    useEventLoop = true;
+    _rebuildEventIndex();
+  }
+  else
+  {
+    for(unsigned int i = 0 ; i < receptor_list.size() ; i++)
+      fcntl(receptor_list[i].socketFileDescriptorReceptor, F_SETFL,
+            fcntl(receptor_list[i].socketFileDescriptorReceptor, F_GETFL, 0) & ~O_NONBLOCK);
+    fcntl(emitter.socketFileDescriptorEmitter, F_SETFL,
+          fcntl(emitter.socketFileDescriptorEmitter, F_GETFL, 0) & ~O_NONBLOCK);
+    
+    close(epollFd);
+    epollFd = -1;
+    fdToReceptor.clear();
+    useEventLoop = false;
+  }
+  
+  return useEventLoop == enable;
+#else
+  (void)enable;
+  return !enable;
+#endif
+}
+
+/*!
+  Wait until the configured timeout for new connections, disconnections or
+  incoming bytes. New clients are accepted, closed connections are removed
+  from the receptor list and the available bytes are drained into the
+  receive buffer of their connection; \e readyReceptors is filled with the
+  index of every receptor whose buffer received data. Contrary to
+  vpServer::checkForConnections() followed by a receive, the connections
+  without activity are never scanned when the event loop mode is enabled.
+  
+  \sa vpServer::setEventLoopMode()
+  \sa vpServer::receiveBufferedRequestsFrom()
+  
+  \param readyReceptors : Filled with the indices of the receptors having received data.
+  
+  \return The number of receptors having received data, -1 if an error occured.
+*/
+int vpServer::waitForEvents(std::vector<unsigned int> &readyReceptors)
+{
+  readyReceptors.clear();
+  
+  if(!started)
+    if(!start())
+      return -1;
+  
+  receptorBuffers.resize(receptor_list.size());
+  
+#ifdef __linux__
+  if(useEventLoop)
+  {
+    //Erase the connections that closed with data still to parse, now that
+    //their buffer has been seen by the caller.
+    for(unsigned int p = 0 ; p < pendingCloseFds.size() ; p++)
+    {
+      std::map<int, unsigned int>::iterator it = fdToReceptor.find(pendingCloseFds[p]);
+      if(it != fdToReceptor.end())
+        _eraseReceptor(it->second);
+    }
+    pendingCloseFds.clear();
+    
+    if(fdToReceptor.size() != receptor_list.size())
+      _rebuildEventIndex();
+    
+    int timeout = (int)(tv_sec*1000 + tv_usec/1000);
+    struct epoll_event events[64];
+    int nbEvents = epoll_wait(epollFd, events, 64, timeout);
+    if(nbEvents == -1)
+    {
+      if(verboseMode)
+        vpERROR_TRACE( "vpServer::waitForEvents(), epoll_wait()" );
+      return -1;
+    }
+    
+    std::vector<int> readyFds;
+    for(int e = 0 ; e < nbEvents ; e++)
+    {
+      if(events[e].data.fd == emitter.socketFileDescriptorEmitter)
+      {
+        //Edge-triggered : accept every pending connection.
+        for(;;)
+        {
+          vpNetwork::vpReceptor client;
+          client.receptorAddressSize = sizeof(client.receptorAddress);
+          client.socketFileDescriptorReceptor = accept(emitter.socketFileDescriptorEmitter,
+                                                       (struct sockaddr*) &client.receptorAddress, &client.receptorAddressSize);
+          if(client.socketFileDescriptorReceptor == -1)
+            break;
+          
+          client.receptorIP = inet_ntoa(client.receptorAddress.sin_addr);
+          printf("New client connected : %s\n", inet_ntoa(client.receptorAddress.sin_addr));
+          receptor_list.push_back(client);
+          receptorBuffers.push_back(std::string());
+          _registerReceptorEvent((unsigned int)receptor_list.size()-1);
+        }
+      }
+      else
+      {
+        std::map<int, unsigned int>::iterator it = fdToReceptor.find(events[e].data.fd);
+        if(it == fdToReceptor.end())
+          continue;
+        
+        bool closed = false;
+        int drained = _drainReceptor(it->second, closed);
+        if(drained > 0)
+          readyFds.push_back(events[e].data.fd);
+        if(closed)
+        {
+          //The buffer of a closed connection may still hold a frame : its
+          //erasure waits for the next call, once the caller has parsed it.
+          if(drained > 0 || !receptorBuffers[it->second].empty())
+            pendingCloseFds.push_back(events[e].data.fd);
+          else
+            _eraseReceptor(it->second);
+        }
+      }
+    }
+    
+    //The erasures above may have shifted the indices : translate the ready
+    //sockets only now that the receptor list is stable.
+    for(unsigned int r = 0 ; r < readyFds.size() ; r++)
+    {
+      std::map<int, unsigned int>::iterator it = fdToReceptor.find(readyFds[r]);
+      if(it != fdToReceptor.end())
+        readyReceptors.push_back(it->second);
+    }
+    
+    return (int)readyReceptors.size();
+  }
+#endif
+  
+  //select() fallback : accept pending connections, then scan the receptors.
+  checkForConnections();
+  receptorBuffers.resize(receptor_list.size());
+  
+  if(receptor_list.size() == 0)
+    return 0;
+  
+  tv.tv_sec = tv_sec;
+#if TARGET_OS_IPHONE
+  tv.tv_usec = (int)tv_usec;
+#else
+  tv.tv_usec = tv_usec;
+#endif
+
+  FD_ZERO(&readFileDescriptor);
+  
+  for(unsigned int i=0; i<receptor_list.size(); i++){
+    if(i == 0)
+      socketMax = receptor_list[i].socketFileDescriptorReceptor;
+    
+    FD_SET((unsigned)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor);
+    if(socketMax < receptor_list[i].socketFileDescriptorReceptor) socketMax = receptor_list[i].socketFileDescriptorReceptor;
+  }
+  
+  int value = select((int)socketMax+1,&readFileDescriptor,NULL,NULL,&tv);
+  if(value == -1){
+    if(verboseMode)
+      vpERROR_TRACE( "Select error" );
+    return -1;
+  }
+  else if(value == 0){
+    //Timeout
+    return 0;
+  }
+  
+  for(unsigned int i=0; i<receptor_list.size(); )
+  {
+    if(FD_ISSET((unsigned int)receptor_list[i].socketFileDescriptorReceptor,&readFileDescriptor))
+    {
+      char *buf = new char [max_size_message];
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+      int numbytes=(int)recv(receptor_list[i].socketFileDescriptorReceptor, buf, max_size_message, 0);
+#else
+      int numbytes=recv((unsigned int)receptor_list[i].socketFileDescriptorReceptor, buf, (int)max_size_message, 0);
+#endif
+      if(numbytes <= 0)
+      {
+        std::cout << "Disconnected : " << inet_ntoa(receptor_list[i].receptorAddress.sin_addr) << std::endl;
+        receptor_list.erase(receptor_list.begin()+(int)i);
+        receptorBuffers.erase(receptorBuffers.begin()+(int)i);
+        //Keep the indices already collected coherent with the erasure
+        for(unsigned int r = 0 ; r < readyReceptors.size() ; r++)
+          if(readyReceptors[r] > i)
+            readyReceptors[r]--;
+        delete [] buf;
+        continue;
+      }
+      receptorBuffers[i].append(buf, (size_t)numbytes);
+      readyReceptors.push_back(i);
+      delete [] buf;
+    }
+    i++;
+  }
+  
+  return (int)readyReceptors.size();
+}
+
+/*!
+  Parse the requests already drained into the receive buffer of a
+  connection by vpServer::waitForEvents(). The unterminated tail of the
+  buffer is kept for the next call.
+  
+  \warning The requests are handled but not decoded.
+  
+  \sa vpServer::waitForEvents()
+  \sa vpServer::receiveAndDecodeBufferedRequestsFrom()
+  
+  \param receptor : Index of the receptor whose buffer has to be parsed.
+  
+  \return The list of index corresponding to the requests that have been handled.
+*/
+std::vector<int> vpServer::receiveBufferedRequestsFrom(const unsigned int &receptor)
+{
+  std::vector<int> res;
+  if(receptor >= receptorBuffers.size())
+    return res;
+  
+  //The parsing of vpNetwork works on currentMessageReceived : substitute it
+  //with the buffer of the connection so that the requests of the different
+  //clients cannot get interleaved.
+  currentMessageReceived.swap(receptorBuffers[receptor]);
+  res = _handleRequests();
+  currentMessageReceived.swap(receptorBuffers[receptor]);
+  
+  return res;
+}
+
+/*!
+  Parse and decode the requests already drained into the receive buffer of
+  a connection by vpServer::waitForEvents().
+  
+  \sa vpServer::waitForEvents()
+  \sa vpServer::receiveBufferedRequestsFrom()
+  
+  \param receptor : Index of the receptor whose buffer has to be parsed.
+  
+  \return The list of index corresponding to the requests that have been decoded.
+*/
+std::vector<int> vpServer::receiveAndDecodeBufferedRequestsFrom(const unsigned int &receptor)
+{
+  std::vector<int> res = receiveBufferedRequestsFrom(receptor);
+  for(unsigned int i = 0 ; i < res.size() ; i++)
+    if(res[i] != -1)
+      request_list[(unsigned)res[i]]->decode();
+  
+  return res;
+}
+
+#ifdef __linux__
+/*!
+  Switch the receptor at the index \e index to non-blocking and register it
+  in the epoll instance.
+*/
+bool vpServer::_registerReceptorEvent(const unsigned int &index)
+{
+  int fd = receptor_list[index].socketFileDescriptorReceptor;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN | EPOLLET | EPOLLRDHUP;
+  ev.data.fd = fd;
+  //EEXIST happens when the map is rebuilt : the socket stays registered.
+  if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == -1 && errno != EEXIST)
+  {
+    vpERROR_TRACE( "vpServer::_registerReceptorEvent(), epoll_ctl()" );
+    return false;
+  }
+  
+  fdToReceptor[fd] = index;
+  return true;
+}
+
+/*!
+  Rebuild the socket to receptor index map, after the receptor list has
+  been modified outside of the event loop.
+*/
+void vpServer::_rebuildEventIndex()
+{
+  fdToReceptor.clear();
+  receptorBuffers.resize(receptor_list.size());
+  for(unsigned int i = 0 ; i < receptor_list.size() ; i++)
+  {
+    int fd = receptor_list[i].socketFileDescriptorReceptor;
+    if(fdToReceptor.find(fd) == fdToReceptor.end())
+      _registerReceptorEvent(i);
+  }
+}
+
+/*!
+  Drain every byte available on the receptor at the index \e index into its
+  receive buffer (edge-triggered readiness is only reported once); \e closed
+  is set when the connection ended.
+  
+  \return The number of bytes drained.
+*/
+int vpServer::_drainReceptor(const unsigned int &index, bool &closed)
+{
+  char buf[16384];
+  int fd = receptor_list[index].socketFileDescriptorReceptor;
+  int total = 0;
+  
+  closed = false;
+  for(;;)
+  {
+    ssize_t numbytes = recv(fd, buf, sizeof(buf), 0);
+    if(numbytes > 0)
+    {
+      receptorBuffers[index].append(buf, (size_t)numbytes);
+      total += (int)numbytes;
+    }
+    else if(numbytes == 0)
+    {
+      closed = true;
+      return total;
+    }
+    else
+    {
+      closed = !(errno == EAGAIN || errno == EWOULDBLOCK);
+      return total;
+    }
+  }
+}
+
+/*!
+  Remove a closed connection : erase it from the receptor list, from its
+  receive buffer and from the epoll instance.
+*/
+void vpServer::_eraseReceptor(const unsigned int &index)
+{
+  int fd = receptor_list[index].socketFileDescriptorReceptor;
+  std::cout << "Disconnected : " << inet_ntoa(receptor_list[index].receptorAddress.sin_addr) << std::endl;
+  
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, NULL);
+  close(fd);
+  receptor_list.erase(receptor_list.begin()+(int)index);
+  receptorBuffers.erase(receptorBuffers.begin()+(int)index);
+  _rebuildEventIndex();
+}
+#endif
+
 /*!
   Print the connected clients. 
 */
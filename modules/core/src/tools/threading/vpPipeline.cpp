@@ -0,0 +1,460 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Software-pipelined execution of multi-stage per-frame processing.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpPipeline.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpTime.h>
+
+/*!
+  Build an empty pipeline. Stages are declared with addStage() and the
+  execution begins with start().
+*/
+vpPipeline::vpPipeline()
+  : m_stages(), m_window(), m_completed(), m_maxInFlight(3),
+    m_dropPolicy(BLOCK_WHEN_FULL), m_nbDropped(0), m_started(false), m_stop(false),
+#if defined(VISP_HAVE_PTHREAD)
+    m_graphMutex(), m_graphCond(),
+#else
+    m_graphMutex(),
+#endif
+    m_loopArgs()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_init(&m_graphMutex, NULL);
+  pthread_cond_init(&m_graphCond, NULL);
+#endif
+}
+
+/*!
+  Stop the workers and destroy the pipeline. The frames still in flight
+  are processed first, as for stop().
+*/
+vpPipeline::~vpPipeline()
+{
+  stop();
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_cond_destroy(&m_graphCond);
+  pthread_mutex_destroy(&m_graphMutex);
+#endif
+
+  for (unsigned int i = 0; i < m_window.size(); i++)
+    delete m_window[i];
+}
+
+/*!
+  Declare a stage without dependency : it runs as soon as a frame is
+  submitted.
+
+  \param name : Name of the stage, used by the statistics.
+  \param fn : Function processing one frame.
+  \param user_data : Context passed to \e fn at each call.
+
+  \return Index of the stage, to be used as a dependency of later stages.
+*/
+unsigned int vpPipeline::addStage(const std::string &name, vpStageFn fn, void *user_data)
+{
+  return addStage(name, fn, user_data, std::vector<unsigned int>());
+}
+
+/*!
+  Declare a stage depending on other stages : for a given frame it runs
+  once all its dependencies processed that frame.
+
+  \param name : Name of the stage, used by the statistics.
+  \param fn : Function processing one frame.
+  \param user_data : Context passed to \e fn at each call.
+  \param dependencies : Indices of the stages this stage depends on.
+
+  \return Index of the stage, to be used as a dependency of later stages.
+*/
+unsigned int vpPipeline::addStage(const std::string &name, vpStageFn fn, void *user_data,
+                                  const std::vector<unsigned int> &dependencies)
+{
+  if (m_started)
+    throw vpException(vpException::fatalError, "Cannot add a stage to a running pipeline");
+  if (m_stages.size() >= 8 * sizeof(unsigned int))
+    throw vpException(vpException::dimensionError, "Too many pipeline stages");
+
+  vpStage stage;
+  stage.name = name;
+  stage.fn = fn;
+  stage.user_data = user_data;
+  for (unsigned int i = 0; i < dependencies.size(); i++) {
+    if (dependencies[i] >= m_stages.size())
+      throw vpException(vpException::badValue, "Pipeline stage depends on an undeclared stage");
+    stage.depMask |= 1u << dependencies[i];
+  }
+
+  m_stages.push_back(stage);
+  return (unsigned int)m_stages.size() - 1;
+}
+
+/*!
+  Block until every submitted frame left the pipeline.
+*/
+void vpPipeline::flush()
+{
+  lockGraph();
+  while (!m_window.empty())
+    waitGraph();
+  unlockGraph();
+}
+
+/*!
+  Get the token of a frame that left the pipeline, in completion order.
+  Dropped frames are also delivered here, so that the caller can always
+  reclaim its buffers.
+
+  \param frame : Token of the completed frame.
+  \param waitFrame : If true, block until a frame completes (or the
+  pipeline is stopped); if false return immediately.
+
+  \return True if a frame has been delivered, false otherwise.
+*/
+bool vpPipeline::getCompletedFrame(void *&frame, const bool &waitFrame)
+{
+  bool res = false;
+
+  lockGraph();
+  if (waitFrame) {
+    while (m_completed.empty() && m_started && !(m_stop && m_window.empty()))
+      waitGraph();
+  }
+  if (!m_completed.empty()) {
+    frame = m_completed.front();
+    m_completed.pop_front();
+    res = true;
+  }
+  unlockGraph();
+
+  return res;
+}
+
+/*!
+  Get the name of a stage.
+
+  \param stage : Index of the stage.
+
+  \return Name given to addStage().
+*/
+std::string vpPipeline::getStageName(const unsigned int &stage) const
+{
+  if (stage >= m_stages.size())
+    throw vpException(vpException::badValue, "Undeclared pipeline stage");
+  return m_stages[stage].name;
+}
+
+/*!
+  Get the latency statistics of a stage.
+
+  \param stage : Index of the stage.
+
+  \return Statistics accumulated since start().
+*/
+vpPipeline::vpStageStats vpPipeline::getStageStats(const unsigned int &stage)
+{
+  if (stage >= m_stages.size())
+    throw vpException(vpException::badValue, "Undeclared pipeline stage");
+
+  lockGraph();
+  vpStageStats stats = m_stages[stage].stats;
+  unlockGraph();
+  return stats;
+}
+
+/*!
+  Start the pipeline : one worker is created per stage. The stages cannot
+  be changed afterwards.
+*/
+void vpPipeline::start()
+{
+  if (m_started)
+    return;
+  if (m_stages.empty())
+    throw vpException(vpException::fatalError, "Cannot start a pipeline without stage");
+
+  m_stop = false;
+  m_nbDropped = 0;
+  for (unsigned int i = 0; i < m_stages.size(); i++) {
+    m_stages[i].stats = vpStageStats();
+    m_stages[i].totalMs = 0.;
+  }
+  m_started = true;
+
+  m_loopArgs.resize(m_stages.size());
+  for (unsigned int i = 0; i < m_stages.size(); i++) {
+    m_loopArgs[i].pipeline = this;
+    m_loopArgs[i].stage = i;
+    m_stages[i].worker = new vpThread(stageLoop, (vpThread::Args)&m_loopArgs[i]);
+  }
+}
+
+/*!
+  Stop the pipeline. The frames already submitted are processed first,
+  then the workers are joined. Frames cannot be submitted anymore until
+  the next start().
+*/
+void vpPipeline::stop()
+{
+  if (!m_started)
+    return;
+
+  lockGraph();
+  m_stop = true;
+  signalGraph();
+  unlockGraph();
+
+  for (unsigned int i = 0; i < m_stages.size(); i++) {
+    delete m_stages[i].worker; // joins
+    m_stages[i].worker = NULL;
+  }
+
+  m_started = false;
+}
+
+/*!
+  Submit a frame token to the pipeline. If the maximum number of frames is
+  already in flight, the behavior follows the configured drop policy.
+
+  \param frame : Caller-owned token given to the stage functions.
+
+  \return True if the frame entered the pipeline, false if it has been
+  rejected (DROP_NEWEST policy, or pipeline not started).
+*/
+bool vpPipeline::submitFrame(void *frame)
+{
+  if (!m_started || m_stop)
+    return false;
+
+  bool res = true;
+
+  lockGraph();
+  if (m_window.size() >= m_maxInFlight) {
+    switch (m_dropPolicy) {
+    case DROP_NEWEST:
+      m_nbDropped++;
+      m_completed.push_back(frame);
+      res = false;
+      break;
+    case DROP_OLDEST: {
+      //Drop the oldest frame no stage started to process; if every frame
+      //in flight is being processed, wait as in BLOCK_WHEN_FULL.
+      bool found = false;
+      for (unsigned int i = 0; i < m_window.size() && !found; i++) {
+        if (m_window[i]->doneMask == 0 && m_window[i]->runningMask == 0) {
+          m_nbDropped++;
+          m_completed.push_back(m_window[i]->frame);
+          delete m_window[i];
+          m_window.erase(m_window.begin() + (int)i);
+          found = true;
+        }
+      }
+      if (!found) {
+        while (m_window.size() >= m_maxInFlight)
+          waitGraph();
+      }
+      break;
+    }
+    case BLOCK_WHEN_FULL:
+    default:
+      while (m_window.size() >= m_maxInFlight)
+        waitGraph();
+      break;
+    }
+  }
+
+  if (res) {
+    vpFrameState *state = new vpFrameState;
+    state->frame = frame;
+    m_window.push_back(state);
+    signalGraph();
+  }
+  unlockGraph();
+
+  return res;
+}
+
+/*!
+  Find the oldest frame the stage can process. The scan stops at the first
+  frame the stage did not process yet whose dependencies are not satisfied,
+  so that every stage handles the frames in submission order.
+*/
+bool vpPipeline::findRunnableFrame(const unsigned int &stage, unsigned int &frameIndex)
+{
+  unsigned int bit = 1u << stage;
+  unsigned int depMask = m_stages[stage].depMask;
+
+  for (unsigned int i = 0; i < m_window.size(); i++) {
+    if (m_window[i]->doneMask & bit)
+      continue;
+    if (m_window[i]->runningMask & bit)
+      return false; // already being processed, keep the order
+    if ((m_window[i]->doneMask & depMask) != depMask)
+      return false; // dependencies pending : processing a later frame would reorder
+    frameIndex = i;
+    return true;
+  }
+
+  return false;
+}
+
+/*!
+  Main loop of a stage worker.
+*/
+vpThread::Return vpPipeline::stageLoop(vpThread::Args args)
+{
+  vpStageLoopArgs *loopArgs = (vpStageLoopArgs *)args;
+  loopArgs->pipeline->runStage(loopArgs->stage);
+  return NULL;
+}
+
+/*!
+  Process the frames of a stage until the pipeline is stopped and every
+  submitted frame has been handled.
+*/
+void vpPipeline::runStage(const unsigned int &stage)
+{
+  unsigned int bit = 1u << stage;
+  unsigned int allMask = (m_stages.size() >= 8 * sizeof(unsigned int))
+    ? ~0u : ((1u << m_stages.size()) - 1u);
+
+  lockGraph();
+  for (;;) {
+    unsigned int frameIndex = 0;
+    if (findRunnableFrame(stage, frameIndex)) {
+      vpFrameState *state = m_window[frameIndex];
+      state->runningMask |= bit;
+      unlockGraph();
+
+      double t0 = vpTime::measureTimeMs();
+      m_stages[stage].fn(m_stages[stage].user_data, state->frame);
+      double dt = vpTime::measureTimeMs() - t0;
+
+      lockGraph();
+      state->runningMask &= ~bit;
+      state->doneMask |= bit;
+
+      vpStageStats &stats = m_stages[stage].stats;
+      stats.nbFrames++;
+      stats.lastMs = dt;
+      if (dt > stats.maxMs)
+        stats.maxMs = dt;
+      m_stages[stage].totalMs += dt;
+      stats.meanMs = m_stages[stage].totalMs / stats.nbFrames;
+
+      if (state->doneMask == allMask) {
+        //The frame left the pipeline : deliver its token.
+        for (unsigned int i = 0; i < m_window.size(); i++) {
+          if (m_window[i] == state) {
+            m_completed.push_back(state->frame);
+            delete state;
+            m_window.erase(m_window.begin() + (int)i);
+            break;
+          }
+        }
+      }
+      signalGraph();
+      continue;
+    }
+
+    if (m_stop) {
+      //Leave once no submitted frame still needs this stage.
+      bool pending = false;
+      for (unsigned int i = 0; i < m_window.size() && !pending; i++)
+        if (!(m_window[i]->doneMask & bit))
+          pending = true;
+      if (!pending)
+        break;
+    }
+
+    waitGraph();
+  }
+  unlockGraph();
+}
+
+/*!
+  Take the lock protecting the frame window, the stages and the completed
+  queue.
+*/
+void vpPipeline::lockGraph()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_graphMutex);
+#else
+  m_graphMutex.lock();
+#endif
+}
+
+/*!
+  Release the lock taken by lockGraph().
+*/
+void vpPipeline::unlockGraph()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_unlock(&m_graphMutex);
+#else
+  m_graphMutex.unlock();
+#endif
+}
+
+/*!
+  Wait, with the lock held, until the state of the pipeline changes.
+*/
+void vpPipeline::waitGraph()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_cond_wait(&m_graphCond, &m_graphMutex);
+#else
+  //No native condition variable : nap with the lock released.
+  m_graphMutex.unlock();
+  Sleep(1);
+  m_graphMutex.lock();
+#endif
+}
+
+/*!
+  Wake up every thread blocked in waitGraph().
+*/
+void vpPipeline::signalGraph()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_cond_broadcast(&m_graphCond);
+#endif
+}
+
+#endif
@@ -0,0 +1,378 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Shared memory image ring for multi-process frame exchange.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpShmImageRing.h>
+
+#include <cstring>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#  define VISP_SHM_RING_AVAILABLE
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Layout of the ring : one header then the slots, each a sequence-guarded
+//frame. A slot is valid while its sequence is even and unchanged.
+struct vpShmRingHeader
+{
+  unsigned int magic; // "VPIR"
+  unsigned int height;
+  unsigned int width;
+  unsigned int pixelSize;
+  unsigned int nbSlots;
+  volatile unsigned int lastSlot;
+};
+
+struct vpShmRingSlot
+{
+  volatile unsigned long sequence;
+  unsigned long frame;
+  double timestamp;
+};
+
+static const unsigned int vpShmRingMagic = 0x56504952; // "VPIR"
+
+static size_t vpShmRingSlotSize(unsigned int h, unsigned int w, unsigned int pixelSize)
+{
+  return sizeof(vpShmRingSlot) + (size_t)h * w * pixelSize;
+}
+
+static void vpShmRingBarrier()
+{
+#if !defined(_WIN32)
+  __sync_synchronize();
+#endif
+}
+#endif
+
+/*!
+  Default constructor : the ring is unusable until create() or attach().
+*/
+vpShmImageRing::vpShmImageRing()
+  : m_height(0), m_width(0), m_pixelSize(0), m_nbSlots(0), m_isProducer(false),
+    m_frameCounter(0), m_lastAcquiredSeq(0), m_lastAcquiredSlot(-1),
+    m_shmId(-1), m_shmAddr(NULL)
+{
+}
+
+/*!
+  Destructor : detaches from the segment, see close().
+*/
+vpShmImageRing::~vpShmImageRing()
+{
+  close();
+}
+
+/*!
+  Create the ring at a System V key. To be called by the producer.
+
+  \param key : System V IPC key naming the ring.
+  \param height : Image height of the exchanged frames.
+  \param width : Image width of the exchanged frames.
+  \param pixelSize : Bytes per pixel (1 for grayscale, 4 for vpRGBa).
+  \param nbSlots : Number of frame slots; the zero-copy views of a
+  consumer stay valid for nbSlots-1 published frames.
+
+  \return True if the ring was created and mapped.
+*/
+bool vpShmImageRing::create(const int &key, const unsigned int &height, const unsigned int &width,
+                            const unsigned int &pixelSize, const unsigned int &nbSlots)
+{
+#ifdef VISP_SHM_RING_AVAILABLE
+  close();
+
+  unsigned int slots = nbSlots < 2 ? 2 : nbSlots;
+  size_t size = sizeof(vpShmRingHeader) + slots * vpShmRingSlotSize(height, width, pixelSize);
+  int shmId = shmget(key, size, IPC_CREAT | 0600);
+  if (shmId < 0)
+    return false;
+  unsigned char *addr = (unsigned char *)shmat(shmId, NULL, 0);
+  if (addr == (unsigned char *)-1)
+    return false;
+
+  vpShmRingHeader *header = (vpShmRingHeader *)addr;
+  header->magic = vpShmRingMagic;
+  header->height = height;
+  header->width = width;
+  header->pixelSize = pixelSize;
+  header->nbSlots = slots;
+  header->lastSlot = 0;
+  for (unsigned int s = 0; s < slots; s++) {
+    vpShmRingSlot *slot = (vpShmRingSlot *)(addr + sizeof(vpShmRingHeader)
+                                            + s * vpShmRingSlotSize(height, width, pixelSize));
+    slot->sequence = 0;
+    slot->frame = 0;
+    slot->timestamp = 0.;
+  }
+
+  m_height = height;
+  m_width = width;
+  m_pixelSize = pixelSize;
+  m_nbSlots = slots;
+  m_isProducer = true;
+  m_frameCounter = 0;
+  m_shmId = shmId;
+  m_shmAddr = addr;
+  return true;
+#else
+  (void)key; (void)height; (void)width; (void)pixelSize; (void)nbSlots;
+  return false;
+#endif
+}
+
+/*!
+  Attach to a ring created by another process.
+
+  \param key : System V IPC key of the ring.
+
+  \return True when the ring was found and mapped; its geometry is then
+  available through the accessors.
+*/
+bool vpShmImageRing::attach(const int &key)
+{
+#ifdef VISP_SHM_RING_AVAILABLE
+  close();
+
+  int shmId = shmget(key, 0, 0);
+  if (shmId < 0)
+    return false;
+  unsigned char *addr = (unsigned char *)shmat(shmId, NULL, 0);
+  if (addr == (unsigned char *)-1)
+    return false;
+
+  vpShmRingHeader *header = (vpShmRingHeader *)addr;
+  if (header->magic != vpShmRingMagic || header->nbSlots == 0) {
+    shmdt(addr);
+    return false;
+  }
+
+  m_height = header->height;
+  m_width = header->width;
+  m_pixelSize = header->pixelSize;
+  m_nbSlots = header->nbSlots;
+  m_isProducer = false;
+  m_shmId = shmId;
+  m_shmAddr = addr;
+  return true;
+#else
+  (void)key;
+  return false;
+#endif
+}
+
+/*!
+  Detach from the shared segment. The segment itself stays for the other
+  processes; remove it with ipcrm once every side closed.
+*/
+void vpShmImageRing::close()
+{
+#ifdef VISP_SHM_RING_AVAILABLE
+  if (m_shmAddr != NULL) {
+    shmdt(m_shmAddr);
+    m_shmAddr = NULL;
+  }
+#endif
+  m_shmId = -1;
+  m_height = m_width = m_pixelSize = m_nbSlots = 0;
+  m_lastAcquiredSlot = -1;
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+bool vpShmImageRing::publishRaw(const unsigned char *pixels, const double &timestamp)
+{
+  if (m_shmAddr == NULL || !m_isProducer)
+    return false;
+
+  vpShmRingHeader *header = (vpShmRingHeader *)m_shmAddr;
+  unsigned int s = (header->lastSlot + 1) % m_nbSlots;
+  vpShmRingSlot *slot = (vpShmRingSlot *)(m_shmAddr + sizeof(vpShmRingHeader)
+                                          + s * vpShmRingSlotSize(m_height, m_width, m_pixelSize));
+
+  m_frameCounter++;
+  slot->sequence++; // odd : being written
+  vpShmRingBarrier();
+  memcpy((void *)(slot + 1), (const void *)pixels, (size_t)m_height * m_width * m_pixelSize);
+  slot->frame = m_frameCounter;
+  slot->timestamp = timestamp;
+  vpShmRingBarrier();
+  slot->sequence++; // even : complete
+  header->lastSlot = s;
+  return true;
+}
+#endif
+
+/*!
+  Publish a grayscale frame. To be called by the producer; the frame
+  dimensions have to match the ring.
+
+  \param I : Published frame.
+  \param timestamp : Timestamp carried with the frame.
+
+  \return True if the frame was published.
+*/
+bool vpShmImageRing::publish(const vpImage<unsigned char> &I, const double &timestamp)
+{
+  if (m_pixelSize != 1 || I.getHeight() != m_height || I.getWidth() != m_width)
+    return false;
+  return publishRaw(I.bitmap, timestamp);
+}
+
+/*!
+  Publish a color frame, see publish(const vpImage<unsigned char> &, const double &).
+*/
+bool vpShmImageRing::publish(const vpImage<vpRGBa> &I, const double &timestamp)
+{
+  if (m_pixelSize != sizeof(vpRGBa) || I.getHeight() != m_height || I.getWidth() != m_width)
+    return false;
+  return publishRaw((const unsigned char *)I.bitmap, timestamp);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Find the newest complete slot; returns its index or -1, filling the
+//frame metadata and recording the sequence snapshot for checkView()
+int vpShmImageRing::acquireSlot(double &timestamp, unsigned long &frame)
+{
+  if (m_shmAddr == NULL)
+    return -1;
+
+  vpShmRingHeader *header = (vpShmRingHeader *)m_shmAddr;
+  for (unsigned int attempt = 0; attempt < m_nbSlots; attempt++) {
+    unsigned int s = (header->lastSlot + m_nbSlots - attempt) % m_nbSlots;
+    vpShmRingSlot *slot = (vpShmRingSlot *)(m_shmAddr + sizeof(vpShmRingHeader)
+                                            + s * vpShmRingSlotSize(m_height, m_width, m_pixelSize));
+    unsigned long seq = slot->sequence;
+    if ((seq & 1ul) || seq == 0)
+      continue;
+    vpShmRingBarrier();
+    timestamp = slot->timestamp;
+    frame = slot->frame;
+    vpShmRingBarrier();
+    if (slot->sequence != seq)
+      continue;
+    m_lastAcquiredSeq = seq;
+    m_lastAcquiredSlot = (int)s;
+    return (int)s;
+  }
+  return -1;
+}
+#endif
+
+/*!
+  Map the newest complete frame as a zero-copy non-owning view into the
+  shared slot. The view stays valid until the producer cycles back onto
+  the slot, i.e. for the next ring-size minus one published frames;
+  checkView() tells whether it is still intact.
+
+  \param view : Non-owning view of the slot pixels.
+  \param timestamp : Timestamp the frame was published with.
+  \param frame : Frame number, increasing by one per publish().
+
+  \return True if a frame was mapped.
+*/
+bool vpShmImageRing::acquire(vpImage<unsigned char> &view, double &timestamp, unsigned long &frame)
+{
+  if (m_pixelSize != 1)
+    return false;
+  int s = acquireSlot(timestamp, frame);
+  if (s < 0)
+    return false;
+  unsigned char *pixels = m_shmAddr + sizeof(vpShmRingHeader)
+    + (unsigned int)s * vpShmRingSlotSize(m_height, m_width, m_pixelSize) + sizeof(vpShmRingSlot);
+  view.init(pixels, m_height, m_width, false);
+  return true;
+}
+
+/*!
+  Color variant of acquire(vpImage<unsigned char> &, double &, unsigned long &).
+*/
+bool vpShmImageRing::acquire(vpImage<vpRGBa> &view, double &timestamp, unsigned long &frame)
+{
+  if (m_pixelSize != sizeof(vpRGBa))
+    return false;
+  int s = acquireSlot(timestamp, frame);
+  if (s < 0)
+    return false;
+  unsigned char *pixels = m_shmAddr + sizeof(vpShmRingHeader)
+    + (unsigned int)s * vpShmRingSlotSize(m_height, m_width, m_pixelSize) + sizeof(vpShmRingSlot);
+  view.init((vpRGBa *)pixels, m_height, m_width, false);
+  return true;
+}
+
+/*!
+  Copy the newest complete frame out of the ring, retrying on a torn
+  read, when the consumer prefers owning its pixels over the zero-copy
+  view of acquire().
+
+  \param I : Filled with the frame.
+  \param timestamp : Timestamp the frame was published with.
+  \param frame : Frame number.
+
+  \return True if a frame was read.
+*/
+bool vpShmImageRing::read(vpImage<unsigned char> &I, double &timestamp, unsigned long &frame)
+{
+  if (m_pixelSize != 1)
+    return false;
+  for (unsigned int retry = 0; retry < 4; retry++) {
+    int s = acquireSlot(timestamp, frame);
+    if (s < 0)
+      return false;
+    vpShmRingSlot *slot = (vpShmRingSlot *)(m_shmAddr + sizeof(vpShmRingHeader)
+                                            + (unsigned int)s * vpShmRingSlotSize(m_height, m_width, m_pixelSize));
+    I.resize(m_height, m_width);
+    memcpy((void *)I.bitmap, (const void *)(slot + 1), (size_t)m_height * m_width);
+    vpShmRingBarrier();
+    if (slot->sequence == m_lastAcquiredSeq)
+      return true;
+  }
+  return false;
+}
+
+/*!
+  Indicates if the slot mapped by the last acquire() still holds the given
+  frame, i.e. whether a zero-copy view of it is still intact.
+
+  \param frame : Frame number the view was acquired with.
+
+  \return True while the view is valid.
+*/
+bool vpShmImageRing::checkView(const unsigned long &frame) const
+{
+  if (m_shmAddr == NULL || m_lastAcquiredSlot < 0)
+    return false;
+  const vpShmRingSlot *slot = (const vpShmRingSlot *)(m_shmAddr + sizeof(vpShmRingHeader)
+    + (unsigned int)m_lastAcquiredSlot * vpShmRingSlotSize(m_height, m_width, m_pixelSize));
+  return slot->sequence == m_lastAcquiredSeq && slot->frame == frame;
+}
@@ -0,0 +1,416 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Process-wide thread pool.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpThreadPool.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+
+#include <visp3/core/vpException.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#  include <unistd.h>
+#endif
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+/*!
+  Build a pool of \e nbThreads workers, started immediately and reused by
+  every task submitted afterwards.
+
+  \param nbThreads : Number of workers; 0 means one worker per processor
+  reported by getHardwareConcurrency().
+*/
+vpThreadPool::vpThreadPool(unsigned int nbThreads)
+  : m_workers(), m_taskQueue(),
+#if defined(VISP_HAVE_PTHREAD)
+    m_queueMutex(), m_workCond(), m_doneCond(),
+#else
+    m_queueMutex(),
+#endif
+    m_stop(false), m_activeTasks(0), m_affinity()
+{
+  if (nbThreads == 0)
+    nbThreads = getHardwareConcurrency();
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_init(&m_queueMutex, NULL);
+  pthread_cond_init(&m_workCond, NULL);
+  pthread_cond_init(&m_doneCond, NULL);
+#endif
+
+  for (unsigned int i = 0; i < nbThreads; i++)
+    m_workers.push_back(new vpThread(workerLoop, (vpThread::Args)this));
+}
+
+/*!
+  Stop the workers once the pending tasks completed and destroy the pool.
+*/
+vpThreadPool::~vpThreadPool()
+{
+  waitAll();
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_queueMutex);
+  m_stop = true;
+  pthread_cond_broadcast(&m_workCond);
+  pthread_mutex_unlock(&m_queueMutex);
+#else
+  m_queueMutex.lock();
+  m_stop = true;
+  m_queueMutex.unlock();
+#endif
+
+  for (unsigned int i = 0; i < m_workers.size(); i++)
+    delete m_workers[i]; // joins
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_cond_destroy(&m_doneCond);
+  pthread_cond_destroy(&m_workCond);
+  pthread_mutex_destroy(&m_queueMutex);
+#endif
+}
+
+/*!
+  Submit a task to the pool. The task starts as soon as a worker is
+  available, in submission order.
+
+  \param fn : Function run by the worker.
+  \param args : Arguments passed to \e fn.
+  \param status : Optional future, signaled when the task completed. It has
+  to stay alive until then.
+*/
+void vpThreadPool::enqueue(vpTaskFn fn, vpThread::Args args, vpTaskStatus *status)
+{
+  vpPoolTask task;
+  task.fn = fn;
+  task.args = args;
+  task.status = status;
+
+  if (status != NULL) {
+    status->m_done = false;
+    status->m_ret = NULL;
+    status->m_pool = this;
+  }
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_queueMutex);
+  m_taskQueue.push_back(task);
+  pthread_cond_signal(&m_workCond);
+  pthread_mutex_unlock(&m_queueMutex);
+#else
+  m_queueMutex.lock();
+  m_taskQueue.push_back(task);
+  m_queueMutex.unlock();
+#endif
+}
+
+/*!
+  Run \e fn over the iteration range [0, nbIterations), split in as many
+  chunks as there are workers. The calling thread blocks until the whole
+  range has been processed.
+
+  \param fn : Body called on each [first, last) chunk.
+  \param args : Arguments passed to \e fn.
+  \param nbIterations : Number of iterations of the range.
+*/
+void vpThreadPool::parallelFor(vpRangeFn fn, void *args, const unsigned int &nbIterations)
+{
+  if (nbIterations == 0)
+    return;
+
+  unsigned int nbChunks = getNbThreads();
+  if (nbChunks > nbIterations)
+    nbChunks = nbIterations;
+  if (nbChunks <= 1) {
+    fn(args, 0, nbIterations);
+    return;
+  }
+
+  std::vector<vpRangeTask> tasks(nbChunks);
+  std::vector<vpTaskStatus> status(nbChunks);
+
+  unsigned int chunkSize = nbIterations / nbChunks;
+  unsigned int remainder = nbIterations % nbChunks;
+  unsigned int first = 0;
+
+  for (unsigned int i = 0; i < nbChunks; i++) {
+    unsigned int last = first + chunkSize + (i < remainder ? 1 : 0);
+    tasks[i].fn = fn;
+    tasks[i].args = args;
+    tasks[i].first = first;
+    tasks[i].last = last;
+    first = last;
+
+    if (i + 1 < nbChunks)
+      enqueue(rangeTask, (vpThread::Args)&tasks[i], &status[i]);
+  }
+
+  //The last chunk runs on the calling thread instead of leaving it idle.
+  rangeTask((vpThread::Args)&tasks[nbChunks - 1]);
+
+  //Help with the queued tasks while waiting, so that a parallelFor() run
+  //from inside a task cannot starve the pool.
+  for (unsigned int i = 0; i + 1 < nbChunks; i++) {
+    while (!status[i].isDone()) {
+      if (!tryRunOneTask())
+        status[i].wait();
+    }
+  }
+}
+
+/*!
+  Pin the workers on the given processors, worker \e i going on
+  cpus[i modulo cpus.size()]. Only effective on Linux; ignored elsewhere.
+
+  \param cpus : Processor indices the workers are allowed to run on. An
+  empty vector leaves the current pinning unchanged.
+*/
+void vpThreadPool::setAffinity(const std::vector<unsigned int> &cpus)
+{
+  m_affinity = cpus;
+
+#ifdef __linux__
+  if (m_affinity.empty())
+    return;
+
+  for (unsigned int i = 0; i < m_workers.size(); i++) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(m_affinity[i % m_affinity.size()], &cpuset);
+    pthread_setaffinity_np(m_workers[i]->getHandle(), sizeof(cpu_set_t), &cpuset);
+  }
+#endif
+}
+
+/*!
+  Block until every submitted task completed.
+*/
+void vpThreadPool::waitAll()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_queueMutex);
+  while (!m_taskQueue.empty() || m_activeTasks != 0)
+    pthread_cond_wait(&m_doneCond, &m_queueMutex);
+  pthread_mutex_unlock(&m_queueMutex);
+#else
+  for (;;) {
+    m_queueMutex.lock();
+    bool done = m_taskQueue.empty() && m_activeTasks == 0;
+    m_queueMutex.unlock();
+    if (done)
+      return;
+    Sleep(1);
+  }
+#endif
+}
+
+/*!
+  Get the shared process-wide pool, created with one worker per processor
+  on its first use.
+
+  \return The shared pool.
+*/
+vpThreadPool &vpThreadPool::getInstance()
+{
+#if defined(VISP_HAVE_PTHREAD)
+  static pthread_mutex_t creationMutex = PTHREAD_MUTEX_INITIALIZER;
+  pthread_mutex_lock(&creationMutex);
+  static vpThreadPool instance;
+  pthread_mutex_unlock(&creationMutex);
+  return instance;
+#else
+  static vpThreadPool instance;
+  return instance;
+#endif
+}
+
+/*!
+  Get the number of processors available on the machine.
+
+  \return Number of processors, at least 1.
+*/
+unsigned int vpThreadPool::getHardwareConcurrency()
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (unsigned int)n : 1;
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+#endif
+}
+
+/*!
+  Block until the task completed and get its result.
+
+  \return The value returned by the task function.
+*/
+vpThread::Return vpThreadPool::vpTaskStatus::wait()
+{
+  if (m_done || m_pool == NULL)
+    return m_ret;
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_pool->m_queueMutex);
+  while (!m_done)
+    pthread_cond_wait(&m_pool->m_doneCond, &m_pool->m_queueMutex);
+  pthread_mutex_unlock(&m_pool->m_queueMutex);
+#else
+  while (!m_done)
+    Sleep(1);
+#endif
+
+  return m_ret;
+}
+
+/*!
+  Main loop of the workers : pop a task, run it, publish its completion.
+*/
+vpThread::Return vpThreadPool::workerLoop(vpThread::Args args)
+{
+  vpThreadPool *pool = (vpThreadPool *)args;
+
+  for (;;) {
+    vpPoolTask task;
+
+#if defined(VISP_HAVE_PTHREAD)
+    pthread_mutex_lock(&pool->m_queueMutex);
+    while (pool->m_taskQueue.empty() && !pool->m_stop)
+      pthread_cond_wait(&pool->m_workCond, &pool->m_queueMutex);
+    if (pool->m_taskQueue.empty()) { // m_stop
+      pthread_mutex_unlock(&pool->m_queueMutex);
+      return NULL;
+    }
+    task = pool->m_taskQueue.front();
+    pool->m_taskQueue.pop_front();
+    pool->m_activeTasks++;
+    pthread_mutex_unlock(&pool->m_queueMutex);
+#else
+    bool hasTask = false;
+    pool->m_queueMutex.lock();
+    if (!pool->m_taskQueue.empty()) {
+      task = pool->m_taskQueue.front();
+      pool->m_taskQueue.pop_front();
+      pool->m_activeTasks++;
+      hasTask = true;
+    }
+    bool stop = pool->m_stop;
+    pool->m_queueMutex.unlock();
+    if (!hasTask) {
+      if (stop)
+        return NULL;
+      Sleep(1);
+      continue;
+    }
+#endif
+
+    pool->runTask(task);
+  }
+}
+
+/*!
+  Run a task already popped from the queue and publish its completion.
+*/
+void vpThreadPool::runTask(vpPoolTask &task)
+{
+  vpThread::Return ret = task.fn(task.args);
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_queueMutex);
+  m_activeTasks--;
+  if (task.status != NULL) {
+    task.status->m_ret = ret;
+    task.status->m_done = true;
+  }
+  pthread_cond_broadcast(&m_doneCond);
+  pthread_mutex_unlock(&m_queueMutex);
+#else
+  m_queueMutex.lock();
+  m_activeTasks--;
+  if (task.status != NULL) {
+    task.status->m_ret = ret;
+    task.status->m_done = true;
+  }
+  m_queueMutex.unlock();
+#endif
+}
+
+/*!
+  Pop and run one queued task if any is pending.
+
+  \return True if a task has been run, false if the queue was empty.
+*/
+bool vpThreadPool::tryRunOneTask()
+{
+  vpPoolTask task;
+  bool hasTask = false;
+
+#if defined(VISP_HAVE_PTHREAD)
+  pthread_mutex_lock(&m_queueMutex);
+  if (!m_taskQueue.empty()) {
+    task = m_taskQueue.front();
+    m_taskQueue.pop_front();
+    m_activeTasks++;
+    hasTask = true;
+  }
+  pthread_mutex_unlock(&m_queueMutex);
+#else
+  m_queueMutex.lock();
+  if (!m_taskQueue.empty()) {
+    task = m_taskQueue.front();
+    m_taskQueue.pop_front();
+    m_activeTasks++;
+    hasTask = true;
+  }
+  m_queueMutex.unlock();
+#endif
+
+  if (hasTask)
+    runTask(task);
+  return hasTask;
+}
+
+/*!
+  Trampoline turning a range chunk into a plain task.
+*/
+vpThread::Return vpThreadPool::rangeTask(vpThread::Args args)
+{
+  vpRangeTask *range = (vpRangeTask *)args;
+  range->fn(range->args, range->first, range->last);
+  return NULL;
+}
+
+#endif
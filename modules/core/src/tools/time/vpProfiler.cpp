@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Scoped instrumentation of the hot paths.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpProfiler.h>
+
+#include <cstdio>
+
+volatile bool vpProfiler::s_enabled = false;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+//Per-thread event buffer, written by its owner thread only; the slots are
+//claimed once with an atomic counter so that recording never takes a lock.
+#define VP_PROFILER_MAX_THREADS 64
+#define VP_PROFILER_BUFFER_SIZE 65536
+
+struct vpProfilerThreadBuffer
+{
+  vpProfiler::vpEvent events[VP_PROFILER_BUFFER_SIZE];
+  volatile unsigned int count;   //events recorded (capped to the capacity)
+  volatile unsigned int dropped; //events lost once the buffer was full
+};
+
+static vpProfilerThreadBuffer *vpProfilerBuffers[VP_PROFILER_MAX_THREADS];
+static volatile int vpProfilerNbBuffers = 0;
+
+#if defined(VISP_HAVE_PTHREAD)
+#  include <pthread.h>
+
+static pthread_key_t vpProfilerKey;
+static pthread_once_t vpProfilerKeyOnce = PTHREAD_ONCE_INIT;
+
+static void vpProfilerMakeKey()
+{
+  pthread_key_create(&vpProfilerKey, NULL);
+}
+
+static vpProfilerThreadBuffer *vpProfilerGetBuffer()
+{
+  pthread_once(&vpProfilerKeyOnce, vpProfilerMakeKey);
+  vpProfilerThreadBuffer *buffer = (vpProfilerThreadBuffer *)pthread_getspecific(vpProfilerKey);
+  if (buffer == NULL) {
+    buffer = new vpProfilerThreadBuffer;
+    buffer->dropped = 0;
+    int slot = __sync_fetch_and_add(&vpProfilerNbBuffers, 1);
+    if (slot < VP_PROFILER_MAX_THREADS) {
+      buffer->count = 0;
+      vpProfilerBuffers[slot] = buffer;
+    }
+    else {
+      //No slot left : the thread keeps an unregistered, already full
+      //buffer so that its further records only count as dropped.
+      buffer->count = VP_PROFILER_BUFFER_SIZE;
+    }
+    pthread_setspecific(vpProfilerKey, buffer);
+  }
+  return buffer;
+}
+#else
+//Without pthread there is no per-thread storage : a single buffer, which
+//is only safe when one thread records.
+static vpProfilerThreadBuffer *vpProfilerGetBuffer()
+{
+  if (vpProfilerNbBuffers == 0) {
+    vpProfilerBuffers[0] = new vpProfilerThreadBuffer;
+    vpProfilerBuffers[0]->count = 0;
+    vpProfilerBuffers[0]->dropped = 0;
+    vpProfilerNbBuffers = 1;
+  }
+  return vpProfilerBuffers[0];
+}
+#endif
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Record one scope in the buffer of the calling thread. Normally called by
+  the VP_PROFILE_SCOPE() destructor rather than directly.
+
+  \param name : Scope name; has to point to storage outliving the profiler
+  use, typically a string literal.
+  \param beginUs : Timestamp of the scope entry, from vpTime::measureTimeMicros().
+  \param endUs : Timestamp of the scope exit.
+*/
+void vpProfiler::record(const char *name, const double &beginUs, const double &endUs)
+{
+  vpProfilerThreadBuffer *buffer = vpProfilerGetBuffer();
+  if (buffer == NULL)
+    return;
+
+  if (buffer->count >= VP_PROFILER_BUFFER_SIZE) {
+    buffer->dropped++;
+    return;
+  }
+
+  vpEvent &event = buffer->events[buffer->count];
+  event.name = name;
+  event.beginUs = beginUs;
+  event.endUs = endUs;
+  buffer->count++;
+}
+
+/*!
+  Forget every recorded event. The recording threads have to be quiescent.
+*/
+void vpProfiler::reset()
+{
+  for (int i = 0; i < vpProfilerNbBuffers && i < VP_PROFILER_MAX_THREADS; i++) {
+    if (vpProfilerBuffers[i] != NULL) {
+      vpProfilerBuffers[i]->count = 0;
+      vpProfilerBuffers[i]->dropped = 0;
+    }
+  }
+}
+
+/*!
+  Get the number of events lost because a thread buffer was full.
+
+  \return Number of dropped events.
+*/
+unsigned int vpProfiler::getNbDroppedEvents()
+{
+  unsigned int dropped = 0;
+  for (int i = 0; i < vpProfilerNbBuffers && i < VP_PROFILER_MAX_THREADS; i++)
+    if (vpProfilerBuffers[i] != NULL)
+      dropped += vpProfilerBuffers[i]->dropped;
+  return dropped;
+}
+
+/*!
+  Write every recorded event as a chrome://tracing JSON file, one timeline
+  per recording thread. The recording threads have to be quiescent, as for
+  reset().
+
+  \param filename : Path of the written file.
+
+  \return True on success, false if the file could not be written.
+*/
+bool vpProfiler::saveTrace(const std::string &filename)
+{
+  FILE *fd = fopen(filename.c_str(), "w");
+  if (fd == NULL)
+    return false;
+
+  fprintf(fd, "{\"traceEvents\":[\n");
+  bool first = true;
+  for (int i = 0; i < vpProfilerNbBuffers && i < VP_PROFILER_MAX_THREADS; i++) {
+    vpProfilerThreadBuffer *buffer = vpProfilerBuffers[i];
+    if (buffer == NULL)
+      continue;
+    unsigned int count = buffer->count;
+    for (unsigned int e = 0; e < count; e++) {
+      const vpEvent &event = buffer->events[e];
+      fprintf(fd, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+              first ? "" : ",\n", event.name, i, event.beginUs, event.endUs - event.beginUs);
+      first = false;
+    }
+  }
+  fprintf(fd, "\n]}\n");
+  fclose(fd);
+
+  return true;
+}
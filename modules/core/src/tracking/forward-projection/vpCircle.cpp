@@ -354,6 +354,44 @@ vpCircle *vpCircle::duplicate() const
   return feature ;
 }
 
+/*!
+  Project a whole set of circles at a common pose in one pass, the entry
+  point of a model with many circles updated once per pose : the pose is
+  loaded once and every circle gets its frame change and its perspective
+  projection, as changeFrame() then projection() would do one by one.
+
+  \param circles : The circles to project; each has its internal
+  \f$^{c}{\bf P}\f$ and \f$\bf p\f$ parameters updated.
+  \param cMo : Camera to world frame transformation, common to the set.
+
+  \exception vpException::divideByZeroError : If the projection of one
+  of the circles degenerates, as with projection().
+*/
+void
+vpCircle::project(const std::vector<vpCircle *> &circles, const vpHomogeneousMatrix &cMo)
+{
+  const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], tx = cMo[0][3];
+  const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], ty = cMo[1][3];
+  const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], tz = cMo[2][3];
+
+  for (size_t k = 0; k < circles.size(); k++) {
+    vpCircle *circle = circles[k];
+    const vpColVector &oP_ = circle->oP;
+    vpColVector &cP_ = circle->cP;
+
+    // Frame change, as changeFrame() with the pose rows kept in registers
+    cP_[0] = r00*oP_[0] + r01*oP_[1] + r02*oP_[2];
+    cP_[1] = r10*oP_[0] + r11*oP_[1] + r12*oP_[2];
+    cP_[2] = r20*oP_[0] + r21*oP_[1] + r22*oP_[2];
+    cP_[3] = tx + r00*oP_[3] + r01*oP_[4] + r02*oP_[5];
+    cP_[4] = ty + r10*oP_[3] + r11*oP_[4] + r12*oP_[5];
+    cP_[5] = tz + r20*oP_[3] + r21*oP_[4] + r22*oP_[5];
+    cP_[6] = oP_[6];
+
+    circle->projection(cP_, circle->p);
+  }
+}
+
 /*!
   Computes the coordinates of the point corresponding to the intersection
   between a circle and a line.
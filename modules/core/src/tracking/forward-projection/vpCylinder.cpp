@@ -271,6 +271,57 @@ vpCylinder::projection(const vpColVector &cP_, vpColVector &p_)
   //  std::cout << p.t() << std::endl ;
 }
 
+/*!
+  Project a whole set of cylinders at a common pose in one pass, the
+  entry point of a model with many cylinders updated once per pose : the
+  pose is loaded once and every cylinder gets its frame change and its
+  perspective projection, as changeFrame() then projection() would do
+  one by one.
+
+  \param cylinders : The cylinders to project; each has its internal
+  \f$^{c}{\bf P}\f$ and \f$\bf p\f$ parameters updated.
+  \param cMo : Camera to world frame transformation, common to the set.
+
+  \exception vpException::fatalError : If the camera lies inside one of
+  the cylinders, as with projection().
+*/
+void
+vpCylinder::project(const std::vector<vpCylinder *> &cylinders, const vpHomogeneousMatrix &cMo)
+{
+  const double r00 = cMo[0][0], r01 = cMo[0][1], r02 = cMo[0][2], tx = cMo[0][3];
+  const double r10 = cMo[1][0], r11 = cMo[1][1], r12 = cMo[1][2], ty = cMo[1][3];
+  const double r20 = cMo[2][0], r21 = cMo[2][1], r22 = cMo[2][2], tz = cMo[2][3];
+
+  for (size_t k = 0; k < cylinders.size(); k++) {
+    vpCylinder *cylinder = cylinders[k];
+    const vpColVector &oP_ = cylinder->oP;
+    vpColVector &cP_ = cylinder->cP;
+
+    // Frame change, as changeFrame() with the pose rows kept in registers
+    double X1 = r00*oP_[0] + r01*oP_[1] + r02*oP_[2];
+    double Y1 = r10*oP_[0] + r11*oP_[1] + r12*oP_[2];
+    double Z1 = r20*oP_[0] + r21*oP_[1] + r22*oP_[2];
+    double s = sqrt(X1*X1 + Y1*Y1 + Z1*Z1);
+    double a = X1 / s;
+    double b = Y1 / s;
+    double c = Z1 / s;
+
+    double X2 = tx + r00*oP_[3] + r01*oP_[4] + r02*oP_[5];
+    double Y2 = ty + r10*oP_[3] + r11*oP_[4] + r12*oP_[5];
+    double Z2 = tz + r20*oP_[3] + r21*oP_[4] + r22*oP_[5];
+
+    cP_[0] = a;
+    cP_[1] = b;
+    cP_[2] = c;
+    cP_[3] =  (1-a*a)*X2 - a*b*Y2 - a*c*Z2;
+    cP_[4] = -a*b*X2 + (1-b*b)*Y2 - b*c*Z2;
+    cP_[5] = -a*c*X2 - b*c*Y2 + (1-c*c)*Z2;
+    cP_[6] = cylinder->oP[6];
+
+    cylinder->projection(cP_, cylinder->p);
+  }
+}
+
 /*!
   From the cylinder parameters \f$^{o}{\bf P}\f$ expressed in the world frame, compute
   the cylinder internal parameters \f$^{c}{\bf P}\f$ expressed in the camera frame.
@@ -0,0 +1,204 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Batched frame change and perspective projection of 3D point sets.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPointCloud.cpp
+  \brief Batched frame change and perspective projection of 3D point sets.
+*/
+
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/core/vpException.h>
+
+/*!
+  Basic constructor of an empty point set.
+*/
+vpPointCloud::vpPointCloud()
+  : m_npoints(0), m_oX(), m_oY(), m_oZ(), m_X(), m_Y(), m_Z(), m_x(), m_y()
+{
+}
+
+/*!
+  Construct a set of \e npoints points, with all the coordinates set to
+  zero.
+
+  \param npoints : Number of points of the set.
+*/
+vpPointCloud::vpPointCloud(unsigned int npoints)
+  : m_npoints(0), m_oX(), m_oY(), m_oZ(), m_X(), m_Y(), m_Z(), m_x(), m_y()
+{
+  resize(npoints);
+}
+
+vpPointCloud::~vpPointCloud()
+{
+}
+
+/*!
+  Set the size of the point set. The object frame coordinates of the
+  common part are preserved.
+
+  \param npoints : Number of points of the set.
+*/
+void vpPointCloud::resize(unsigned int npoints)
+{
+  m_npoints = npoints;
+  m_oX.resize(npoints, 0.);
+  m_oY.resize(npoints, 0.);
+  m_oZ.resize(npoints, 0.);
+  m_X.resize(npoints, 0.);
+  m_Y.resize(npoints, 0.);
+  m_Z.resize(npoints, 0.);
+  m_x.resize(npoints, 0.);
+  m_y.resize(npoints, 0.);
+}
+
+/*!
+  Set the object frame coordinates of point \e i.
+
+  \param i : Point index in [0, size()-1].
+  \param oX, oY, oZ : Coordinates of the point in the object frame.
+*/
+void vpPointCloud::setPoint(unsigned int i, double oX, double oY, double oZ)
+{
+  if (i >= m_npoints) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot set point %d in a point set of size %d", i, m_npoints)) ;
+  }
+  m_oX[i] = oX;
+  m_oY[i] = oY;
+  m_oZ[i] = oZ;
+}
+
+/*!
+  Initialize the set from a vector of points. Only the object frame
+  coordinates are taken.
+
+  \param points : Points to copy in the set.
+*/
+void vpPointCloud::setPoints(const std::vector<vpPoint> &points)
+{
+  resize((unsigned int)points.size());
+  for (unsigned int i = 0; i < m_npoints; i++) {
+    m_oX[i] = points[i].get_oX();
+    m_oY[i] = points[i].get_oY();
+    m_oZ[i] = points[i].get_oZ();
+  }
+}
+
+/*!
+  Compute the camera frame coordinates of the whole set from the object
+  frame coordinates, with the same convention as vpPoint::changeFrame().
+
+  \param cMo : Transformation from camera to object frame.
+*/
+void vpPointCloud::changeFrame(const vpHomogeneousMatrix &cMo)
+{
+  // Hoist the transformation once for the whole set; the per-array loops
+  // below are free of any indirection so that they vectorize.
+  const double r11 = cMo[0][0], r12 = cMo[0][1], r13 = cMo[0][2], t1 = cMo[0][3];
+  const double r21 = cMo[1][0], r22 = cMo[1][1], r23 = cMo[1][2], t2 = cMo[1][3];
+  const double r31 = cMo[2][0], r32 = cMo[2][1], r33 = cMo[2][2], t3 = cMo[2][3];
+
+  const double *oX = m_npoints ? &m_oX[0] : NULL;
+  const double *oY = m_npoints ? &m_oY[0] : NULL;
+  const double *oZ = m_npoints ? &m_oZ[0] : NULL;
+  double *X = m_npoints ? &m_X[0] : NULL;
+  double *Y = m_npoints ? &m_Y[0] : NULL;
+  double *Z = m_npoints ? &m_Z[0] : NULL;
+
+  for (unsigned int i = 0; i < m_npoints; i++) {
+    double x_ = oX[i], y_ = oY[i], z_ = oZ[i];
+    X[i] = r11*x_ + r12*y_ + r13*z_ + t1;
+    Y[i] = r21*x_ + r22*y_ + r23*z_ + t2;
+    Z[i] = r31*x_ + r32*y_ + r33*z_ + t3;
+  }
+}
+
+/*!
+  Perspective projection of the whole set from the camera frame
+  coordinates to the image plane, with the same convention as
+  vpPoint::projection(). changeFrame() must have been called before.
+*/
+void vpPointCloud::projection()
+{
+  const double *X = m_npoints ? &m_X[0] : NULL;
+  const double *Y = m_npoints ? &m_Y[0] : NULL;
+  const double *Z = m_npoints ? &m_Z[0] : NULL;
+  double *x = m_npoints ? &m_x[0] : NULL;
+  double *y = m_npoints ? &m_y[0] : NULL;
+
+  for (unsigned int i = 0; i < m_npoints; i++) {
+    double d = 1/Z[i];
+    x[i] = X[i]*d;
+    y[i] = Y[i]*d;
+  }
+}
+
+/*!
+  Change the frame of the whole set and project it in the image plane in
+  one call.
+
+  \param cMo : Transformation from camera to object frame.
+*/
+void vpPointCloud::project(const vpHomogeneousMatrix &cMo)
+{
+  changeFrame(cMo);
+  projection();
+}
+
+/*!
+  Copy the coordinates of point \e i in a vpPoint, object frame, camera
+  frame and image plane coordinates included.
+
+  \param i : Point index in [0, size()-1].
+  \param point : Resulting point.
+*/
+void vpPointCloud::getPoint(unsigned int i, vpPoint &point) const
+{
+  if (i >= m_npoints) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot get point %d in a point set of size %d", i, m_npoints)) ;
+  }
+  point.setWorldCoordinates(m_oX[i], m_oY[i], m_oZ[i]);
+  point.set_X(m_X[i]);
+  point.set_Y(m_Y[i]);
+  point.set_Z(m_Z[i]);
+  point.set_W(1.);
+  point.set_x(m_x[i]);
+  point.set_y(m_y[i]);
+  point.set_w(1.);
+}
@@ -36,6 +36,11 @@
  *****************************************************************************/
 
 #include <visp3/core/vpMomentDatabase.h>
+#include <visp3/core/vpMomentObject.h>
+
+#include <string>
+#include <utility>
+#include <cstring>
 #include <visp3/core/vpMoment.h>
 #include <typeinfo>
 #include <iostream>
@@ -79,6 +84,84 @@ void vpMomentDatabase::updateAll(vpMomentObject& object){
     }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Dependencies of the moment classes shipped with ViSP (the names a moment
+//! reads from the database while computing), used by updateRequired() to
+//! evaluate only the transitive closure of the requested moments. Unknown
+//! names are treated as dependency free.
+static void vpMomentDependencies(const char *name, std::vector<const char *> &deps)
+{
+  deps.clear();
+  if (!strcmp(name, "vpMomentCentered")) {
+    deps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpMomentAlpha") || !strcmp(name, "vpMomentArea") ||
+           !strcmp(name, "vpMomentAreaNormalized") || !strcmp(name, "vpMomentCInvariant")) {
+    deps.push_back("vpMomentCentered");
+  }
+  else if (!strcmp(name, "vpMomentGravityCenterNormalized")) {
+    deps.push_back("vpMomentAreaNormalized");
+    deps.push_back("vpMomentGravityCenter");
+  }
+}
+#endif
+
+/*!
+  Updates and computes the requested moments and, transitively, the moments
+  they depend on, in dependency order, each of them once: shared
+  intermediates like vpMomentCentered are evaluated a single time however
+  many requested moments consume them. Moments present in the database but
+  not required are left untouched, which is the point: a servo task using a
+  few features does not pay for the whole database.
+
+  Unlike updateAll(), the required moments are also computed here.
+
+  \param object : Moment object the moments are computed from.
+  \param names : Names of the required moments. Names absent from the
+  database are ignored.
+*/
+void vpMomentDatabase::updateRequired(vpMomentObject& object, const std::vector<const char*> &names)
+{
+  //Iterative depth first traversal building the evaluation order
+  //(dependencies before dependents), each moment visited once
+  std::vector<const char *> order;
+  std::vector<std::pair<const char *, bool> > stack;
+  std::map<std::string, bool> visited;
+
+  for(unsigned int i = 0; i < names.size(); i++)
+    stack.push_back(std::make_pair(names[i], false));
+
+  std::vector<const char *> deps;
+  while(!stack.empty()) {
+    const char *name = stack.back().first;
+    bool expanded = stack.back().second;
+    stack.pop_back();
+
+    if (expanded) {
+      order.push_back(name);
+      continue;
+    }
+    if (visited.find(name) != visited.end())
+      continue;
+    visited[name] = true;
+
+    stack.push_back(std::make_pair(name, true));
+    vpMomentDependencies(name, deps);
+    for(unsigned int i = 0; i < deps.size(); i++)
+      if (visited.find(deps[i]) == visited.end())
+        stack.push_back(std::make_pair(deps[i], false));
+  }
+
+  for(unsigned int i = 0; i < order.size(); i++) {
+    std::map<const char*,vpMoment*,vpMomentDatabase::cmp_str>::const_iterator
+        it = moments.find(order[i]);
+    if (it != moments.end()) {
+      it->second->update(object);
+      it->second->compute();
+    }
+  }
+}
+
 /*!
 	Outputs all the moments values in the database to a stream.
 */
@@ -286,6 +286,72 @@ int main()
   \endcode
 */
 
+/*!
+  Incrementally update the basic moments with one weighted point: every
+  moment \f$ m_{pq} \f$ receives \f$ w \, x^p y^q \f$. Since the basic
+  moments of a DENSE_FULL_OBJECT or DISCRETE object are plain sums over its
+  points, feeding the pixels entering (positive weight) and leaving
+  (negative weight) a tracked region - e.g. the run deltas of a blob
+  tracker - keeps the moments exact without rescanning the region; the
+  centered moments and the gravity center then follow from the updated
+  basic moments through their usual (and cheap) compute(), for instance via
+  vpMomentDatabase::updateRequired().
+
+  The weight must match the convention the object was built with: the
+  (possibly normalized) intensity for a photometric object, 1 for a binary
+  one, divided by the pixel surface when the object was normalized with the
+  pixel size. Not applicable to DENSE_POLYGON objects, whose moments are
+  contour integrals.
+
+  \param x, y : Point coordinates, in meter in the image plane.
+  \param w : Signed weight of the point.
+*/
+void vpMomentObject::updatePoint(double x, double y, double w)
+{
+  double yval = w;
+  for (unsigned int k = 0; k < order; k++) {
+    double xval = 1.;
+    for (unsigned int l = 0; l < order-k; l++) {
+      values[k*order+l] += yval*xval;
+      xval *= x;
+    }
+    yval *= y;
+  }
+}
+
+/*!
+  Incrementally update the basic moments with a run of nb aligned points
+  starting at (x0, y) and spaced by dx along x, all with the same weight:
+  the natural entry point for the run-length deltas of a blob tracker, see
+  updatePoint().
+
+  \param y : Row coordinate of the run, in meter in the image plane.
+  \param x0 : Coordinate of the first point of the run.
+  \param dx : Spacing between two consecutive points.
+  \param nb : Number of points in the run.
+  \param w : Signed weight shared by the points of the run.
+*/
+void vpMomentObject::updateRun(double y, double x0, double dx, unsigned int nb, double w)
+{
+  //The weighted powers of y are shared by the whole run
+  std::vector<double> ypow(order);
+  ypow[0] = w;
+  for (unsigned int k = 1; k < order; k++)
+    ypow[k] = ypow[k-1]*y;
+
+  double x = x0;
+  for (unsigned int i = 0; i < nb; i++) {
+    for (unsigned int k = 0; k < order; k++) {
+      double xval = 1.;
+      for (unsigned int l = 0; l < order-k; l++) {
+        values[k*order+l] += ypow[k]*xval;
+        xval *= x;
+      }
+    }
+    x += dx;
+  }
+}
+
 void vpMomentObject::fromImage(const vpImage<unsigned char>& image, unsigned char threshold, const vpCameraParameters& cam){
 #ifdef VISP_HAVE_OPENMP
   #pragma omp parallel shared(threshold)
@@ -295,8 +361,8 @@ void vpMomentObject::fromImage(const vpImage<unsigned char>& image, unsigned cha
     unsigned int i_, j_;
 
     #pragma omp for nowait//automatically organize loop counter between threads
-    for(int i=0;i<(int)image.getCols();i++){
-      for(int j=0;j<(int)image.getRows();j++){
+    for(int j=0;j<(int)image.getRows();j++){
+      for(int i=0;i<(int)image.getCols();i++){
         i_ = static_cast<unsigned int>(i);
         j_ = static_cast<unsigned int>(j);
         if(image[j_][i_]>threshold){
@@ -324,10 +390,14 @@ void vpMomentObject::fromImage(const vpImage<unsigned char>& image, unsigned cha
 
     #pragma omp barrier
 
-    for(unsigned int k=0;k<order;k++){
-      for(unsigned int l=0;l<order-k;l++){
-        //#pragma omp atomic // Removed since causes a build issue with msvc14 2015
-        values[k*order+l]+= curvals[k*order+l];
+    //Serialized reduction of the per-thread partial moments (the historic
+    //unprotected accumulation raced between the threads)
+    #pragma omp critical (vpMomentObjectReduce)
+    {
+      for(unsigned int k=0;k<order;k++){
+        for(unsigned int l=0;l<order-k;l++){
+          values[k*order+l]+= curvals[k*order+l];
+        }
       }
     }
 
@@ -372,72 +442,89 @@ void vpMomentObject::fromImage(const vpImage<unsigned char>& image, unsigned cha
 void vpMomentObject::fromImage(const vpImage<unsigned char>& image, const vpCameraParameters& cam,
     vpCameraImgBckGrndType bg_type, bool normalize_with_pix_size)
 {
-  std::vector<double> cache(order*order,0.);
   values.assign(order*order,0);
 
-  // (x,y) - Pixel co-ordinates in metres
-  double x=0;
-  double y=0;
-  //for indexing into cache[] and values[]
-  unsigned int idx = 0;
-  unsigned int kidx = 0;
-
-  double intensity = 0;
-
-  //double Imax = static_cast<double>(image.getMaxValue());
-
   double iscale = 1.0;
   if (flg_normalize_intensity) {                                            // This makes the image a probability density function
     double Imax = 255.;                                                     // To check the effect of gray level change. ISR Coimbra
     iscale = 1.0/Imax;
   }
 
-  if (bg_type == vpMomentObject::WHITE) {
-      /////////// WHITE BACKGROUND ///////////
-      for(unsigned int j=0;j<image.getRows();j++){
-          for(unsigned int i=0;i<image.getCols();i++){
-              x = 0;
-              y = 0;
-              intensity = (double)(image[j][i])*iscale;
-              double intensity_white = 1. - intensity;
-
-              vpPixelMeterConversion::convertPoint(cam,i,j,x,y);
-              cacheValues(cache,x,y, intensity_white);			// Modify 'cache' which has x^p*y^q to x^p*y^q*(1 - I(x,y))
-
-              // Copy to "values"
-              for(unsigned int k=0;k<order;k++){
-                  kidx = k*order;
-                  for(unsigned int l=0;l<order-k;l++){
-                      idx = kidx+l;
-                      values[idx]+= cache[idx];
-                  }
-              }
+  const bool white = (bg_type == vpMomentObject::WHITE);
+  const bool no_distortion = (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion);
+  int rows_ = (int)image.getRows();
+  int cols_ = (int)image.getCols();
+
+  //The rows are spread over the threads, each accumulating its own partial
+  //moments reduced at the end; along a row the powers of y are constant and
+  //the powers of x follow an incremental recurrence, so all the orders are
+  //accumulated in one pass without the per-pixel cache copy
+#ifdef VISP_HAVE_OPENMP
+  #pragma omp parallel
+#endif
+  {
+    std::vector<double> partial(order*order, 0.);
+    std::vector<double> ypow(order);
+
+#ifdef VISP_HAVE_OPENMP
+    #pragma omp for nowait
+#endif
+    for (int j = 0; j < rows_; j++) {
+      if (no_distortion) {
+        double yrow = ((double)j - cam.get_v0())/cam.get_py();
+        double inv_px = 1.0/cam.get_px();
+        double u0 = cam.get_u0();
+        ypow[0] = 1.;
+        for (unsigned int k = 1; k < order; k++)
+          ypow[k] = ypow[k-1]*yrow;
+
+        for (int i = 0; i < cols_; i++) {
+          double intensity = (double)(image[(unsigned int)j][(unsigned int)i])*iscale;
+          if (white)
+            intensity = 1. - intensity;
+          double xpix = ((double)i - u0)*inv_px;
+
+          for (unsigned int k = 0; k < order; k++) {
+            double w = intensity*ypow[k];
+            double xval = 1.;
+            double *prow = &partial[k*order];
+            for (unsigned int l = 0; l < order-k; l++) {
+              prow[l] += w*xval;
+              xval *= xpix;
+            }
           }
+        }
       }
-  }
-  else {
-      /////////// BLACK BACKGROUND	///////////
-      for(unsigned int j=0;j<image.getRows();j++){
-          for(unsigned int i=0;i<image.getCols();i++){
-              x = 0;
-              y = 0;
-              intensity = (double)(image[j][i])*iscale;
-              vpPixelMeterConversion::convertPoint(cam,i,j,x,y);
-
-              // Cache values for fast moment calculation
-              cacheValues(cache,x,y, intensity);					// Modify 'cache' which has x^p*y^q to x^p*y^q*I(x,y)
-
-              // Copy to moments array 'values'
-              for(unsigned int k=0;k<order;k++){
-                  kidx = k*order;
-                  for(unsigned int l=0;l<order-k;l++){
-                      idx = kidx+l;
-                      values[idx]+= cache[idx];
-                  }
-              }
-
+      else {
+        //Distorted models keep the generic per-pixel conversion
+        for (int i = 0; i < cols_; i++) {
+          double x = 0, y = 0;
+          vpPixelMeterConversion::convertPoint(cam, (unsigned int)i, (unsigned int)j, x, y);
+          double intensity = (double)(image[(unsigned int)j][(unsigned int)i])*iscale;
+          if (white)
+            intensity = 1. - intensity;
+
+          double yval = intensity;
+          for (unsigned int k = 0; k < order; k++) {
+            double xval = 1.;
+            double *prow = &partial[k*order];
+            for (unsigned int l = 0; l < order-k; l++) {
+              prow[l] += yval*xval;
+              xval *= x;
+            }
+            yval *= y;
           }
+        }
       }
+    }
+
+#ifdef VISP_HAVE_OPENMP
+    #pragma omp critical (vpMomentObjectPhotometricReduce)
+#endif
+    {
+      for (unsigned int idx = 0; idx < order*order; idx++)
+        values[idx] += partial[idx];
+    }
   }
 
   if (normalize_with_pix_size){
@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Inter-frame pose prediction used to warm start the trackers.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPosePredictor.cpp
+  \brief Constant velocity pose prediction between two frames.
+*/
+
+#include <visp3/core/vpPosePredictor.h>
+#include <visp3/core/vpExponentialMap.h>
+
+vpPosePredictor::vpPosePredictor()
+  : m_cMo(), m_v(6), m_nbUpdates(0)
+{
+}
+
+vpPosePredictor::~vpPosePredictor()
+{
+}
+
+/*!
+  Forget the poses fed so far. The next prediction is available once two
+  new poses were fed with update().
+*/
+void vpPosePredictor::reset()
+{
+  m_cMo.eye();
+  m_v = 0;
+  m_nbUpdates = 0;
+}
+
+/*!
+  Feed the pose estimated on the current frame. The velocity twist is
+  computed from the displacement since the previous update.
+
+  \param cMo : Pose estimated by the tracker on the current frame.
+*/
+void vpPosePredictor::update(const vpHomogeneousMatrix &cMo)
+{
+  if (m_nbUpdates > 0)
+    m_v = vpExponentialMap::inverse(m_cMo.inverse() * cMo);
+
+  m_cMo = cMo;
+  m_nbUpdates ++;
+}
+
+/*!
+  Predict the pose of the next frame by applying the last observed
+  velocity twist to the last estimated pose. While the predictor is not
+  ready the last pose is returned unchanged.
+
+  \return The predicted pose.
+*/
+vpHomogeneousMatrix vpPosePredictor::predict() const
+{
+  if (! isReady())
+    return m_cMo;
+
+  return m_cMo * vpExponentialMap::direct(m_v);
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test some vpMatrixT functionalities.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMatrixT.cpp
+
+  Test some vpMatrixT fixed size matrix functionalities.
+*/
+
+#include <cmath>
+#include <limits>
+#include <iostream>
+
+#include <visp3/core/vpMatrixT.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+
+int main()
+{
+  int err = 1;
+  double epsilon = std::numeric_limits<double>::epsilon();
+  {
+    // Compare the fixed size product with the vpMatrix one
+    vpMatrixT<3, 4> A;
+    vpMatrixT<4, 2> B;
+    vpMatrix A_(3, 4), B_(4, 2);
+    for (unsigned int i = 0; i < 3; i++)
+      for (unsigned int j = 0; j < 4; j++)
+        A[i][j] = A_[i][j] = cos((double)(i+j));
+    for (unsigned int i = 0; i < 4; i++)
+      for (unsigned int j = 0; j < 2; j++)
+        B[i][j] = B_[i][j] = sin((double)(i*j+1));
+
+    vpMatrixT<3, 2> C = A * B;
+    vpMatrix C_ = A_ * B_;
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 2; j++) {
+        if (std::fabs(C[i][j] - C_[i][j]) > epsilon) {
+          std::cout << "Test fails: bad product content" << std::endl;
+          return err;
+        }
+      }
+    }
+  }
+  {
+    // Conversion from/to a velocity twist matrix
+    vpHomogeneousMatrix cMe(0.1, 0.2, 0.3, 0.1, -0.2, 0.3);
+    vpVelocityTwistMatrix cVe(cMe);
+    vpMatrixT<6, 6> V(cVe);
+    vpMatrix V_ = V.toMatrix();
+    for (unsigned int i = 0; i < 6; i++) {
+      for (unsigned int j = 0; j < 6; j++) {
+        if (std::fabs(V[i][j] - cVe[i][j]) > epsilon
+            || std::fabs(V_[i][j] - cVe[i][j]) > epsilon) {
+          std::cout << "Test fails: bad twist conversion" << std::endl;
+          return err;
+        }
+      }
+    }
+  }
+  {
+    // Matrix vector product without allocation
+    vpMatrixT<6, 6> A;
+    vpColVector v(6), w(6);
+    for (unsigned int i = 0; i < 6; i++) {
+      v[i] = (double)i;
+      for (unsigned int j = 0; j < 6; j++)
+        A[i][j] = (double)(i+j);
+    }
+    A.mult(v, w);
+    vpColVector w_ = A.toMatrix() * v;
+    for (unsigned int i = 0; i < 6; i++) {
+      if (std::fabs(w[i] - w_[i]) > epsilon) {
+        std::cout << "Test fails: bad matrix vector product" << std::endl;
+        return err;
+      }
+    }
+  }
+  {
+    // Dimension exception
+    vpMatrix A(3, 3);
+    try {
+      vpMatrixT<4, 4> B(A);
+      std::cout << "Test fails: dimension exception not thrown" << std::endl;
+      return err;
+    }
+    catch(vpException &e) {
+      std::cout << "Catch expected exception: " << e.getMessage() << std::endl;
+    }
+  }
+  {
+    // Transpose and operators
+    vpMatrixT<2, 3> A;
+    A[0][0] = 1; A[0][1] = 2; A[0][2] = 3;
+    A[1][0] = 4; A[1][1] = 5; A[1][2] = 6;
+    vpMatrixT<3, 2> At = A.t();
+    for (unsigned int i = 0; i < 2; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        if (std::fabs(At[j][i] - A[i][j]) > epsilon) {
+          std::cout << "Test fails: bad transpose" << std::endl;
+          return err;
+        }
+      }
+    }
+    vpMatrixT<2, 3> B = (A + A) - A * 1.;
+    for (unsigned int i = 0; i < 2; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        if (std::fabs(B[i][j] - A[i][j]) > epsilon) {
+          std::cout << "Test fails: bad add/sub/scale" << std::endl;
+          return err;
+        }
+      }
+    }
+  }
+  std::cout << "Test succeed" << std::endl;
+  return 0;
+}
@@ -65,6 +65,14 @@ protected:
   std::vector< std::string > m_message; //!< Message attached to each object.
   size_t m_nb_objects; //!< Number of detected objects.
 
+  //Guided search state, see detectGuided()
+  bool m_guidedEnabled;                                  //!< True when detectGuided() restricts the search
+  unsigned int m_guidedMargin;                           //!< Pixels added around the prior polygons
+  unsigned int m_guidedFullScanCadence;                  //!< Full-frame retry period while the prior misses
+  unsigned int m_guidedDownscale;                        //!< Subsampling of the full-frame localization pass
+  std::vector< std::vector<vpImagePoint> > m_guidedPrior; //!< Polygons of the last successful detection
+  unsigned long m_guidedMissCount;                       //!< Misses since the last successful detection
+
 public:
   /*!
      Default constructor.
@@ -118,6 +126,33 @@ public:
     Return the bounding box of the ith object.
    */
   vpRect getBBox(size_t i) const ;
+
+  bool detectGuided(const vpImage<unsigned char> &I);
+
+  /*!
+    Enable or disable the guided search of detectGuided(). While enabled,
+    the detection first searches the neighborhood of the last seen
+    polygons and only rescans the full frame on a miss, every
+    \e fullScanCadence calls, on an image subsampled by
+    \e downscale and refined at full resolution around each hit.
+
+    \param enable : True to guide the search.
+    \param margin : Pixels added around the prior polygons.
+    \param fullScanCadence : Full-frame retry period while missing.
+    \param downscale : Subsampling factor of the localization pass; 1
+    scans at full resolution.
+  */
+  void setGuidedSearch(const bool &enable, const unsigned int &margin = 32,
+                       const unsigned int &fullScanCadence = 5,
+                       const unsigned int &downscale = 2)
+  {
+    m_guidedEnabled = enable;
+    m_guidedMargin = margin;
+    m_guidedFullScanCadence = fullScanCadence == 0 ? 1 : fullScanCadence;
+    m_guidedDownscale = downscale == 0 ? 1 : downscale;
+    m_guidedPrior.clear();
+    m_guidedMissCount = 0;
+  }
 };
 
 #endif
@@ -49,6 +49,9 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 #include <visp3/detection/vpDetectorBase.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpMutex.h>
+#include <visp3/core/vpRect.h>
 
 /*!
   \class vpDetectorFace
@@ -86,16 +89,44 @@ protected:
   cv::CascadeClassifier m_face_cascade; //!< Haar cascade classifier file name.
   cv::Mat m_frame_gray; //!< OpenCV image used as input for the face detection.
 
+  //Pipelined mode, see setAsyncDetection()
+  bool m_asyncEnabled;                  //!< Detection runs on a worker every m_asyncStride frames
+  unsigned int m_asyncStride;           //!< Frames between two worker detections
+  unsigned int m_asyncDownscale;        //!< Subsampling of the frame handed to the worker
+  unsigned long m_asyncFrameCounter;    //!< Frames submitted to detect()
+  vpThread *m_asyncThread;              //!< Worker running detectMultiScale
+  volatile bool m_asyncRunning;         //!< Worker lifetime flag
+  volatile bool m_asyncBusy;            //!< A frame is being processed by the worker
+  vpImage<unsigned char> m_asyncInput;  //!< Frame handed to the worker
+  double m_asyncInputTimestamp;         //!< Submission time of the worker frame
+  vpMutex m_asyncMutex;                 //!< Guards the worker input/result exchange
+  std::vector<vpRect> m_asyncResult;    //!< Last worker detection, full-resolution boxes
+  double m_asyncResultTimestamp;        //!< Capture time of the last worker detection
+  std::vector<vpRect> m_prevResult;     //!< Previous worker detection, for the extrapolation
+  double m_prevResultTimestamp;         //!< Capture time of the previous detection
+  double m_lastDeliveredTimestamp;      //!< Timestamp reported by getDetectionTimestamp()
+
+  static vpThread::Return asyncLoop(vpThread::Args args);
+  void publishBoxes(const std::vector<vpRect> &boxes);
+
 public:
   vpDetectorFace();
-  /*!
-    Default destructor.
-   */
-  virtual ~vpDetectorFace() {};
+  virtual ~vpDetectorFace();
   void setCascadeClassifierFile(const std::string &filename);
 
   bool detect(const vpImage<unsigned char> &I);
   bool detect(const cv::Mat &frame_gray);
+
+  void setAsyncDetection(const bool &enable, const unsigned int &stride = 3,
+                         const unsigned int &downscale = 2);
+
+  /*!
+    Get the capture time, from vpTime::measureTimeMicros(), of the frame
+    the currently reported boxes were detected (or extrapolated) from.
+
+    \return Timestamp of the delivered detection, in microseconds.
+  */
+  double getDetectionTimestamp() const { return m_lastDeliveredTimestamp; }
 };
 
 #endif
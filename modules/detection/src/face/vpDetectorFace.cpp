@@ -41,6 +41,10 @@
 #include <algorithm>
 
 #include <visp3/detection/vpDetectorFace.h>
+#include <visp3/core/vpTime.h>
+#if !defined(_WIN32)
+#  include <unistd.h> // usleep
+#endif
 #include <visp3/core/vpImageConvert.h>
 
 bool vpSortLargestFace(cv::Rect rect1, cv::Rect rect2)
@@ -52,7 +56,13 @@ bool vpSortLargestFace(cv::Rect rect1, cv::Rect rect2)
   Default constructor.
  */
 vpDetectorFace::vpDetectorFace() :
-  m_faces(), m_face_cascade(), m_frame_gray()
+  m_faces(), m_face_cascade(), m_frame_gray(),
+  m_asyncEnabled(false), m_asyncStride(3), m_asyncDownscale(2),
+  m_asyncFrameCounter(0), m_asyncThread(NULL), m_asyncRunning(false),
+  m_asyncBusy(false), m_asyncInput(),
+  m_asyncInputTimestamp(0.), m_asyncMutex(), m_asyncResult(),
+  m_asyncResultTimestamp(0.), m_prevResult(), m_prevResultTimestamp(0.),
+  m_lastDeliveredTimestamp(0.)
 {
 }
 
@@ -82,11 +92,212 @@ void vpDetectorFace::setCascadeClassifierFile(const std::string &filename)
 
    \sa detect(const cv::Mat &)
  */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Nearest-neighbor subsampling handed to the detection worker
+static void vpDetectorFaceDownscale(const vpImage<unsigned char> &I, unsigned int factor,
+                                    vpImage<unsigned char> &small)
+{
+  unsigned int h = I.getHeight() / factor;
+  unsigned int w = I.getWidth() / factor;
+  small.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    const unsigned char *src = I[i * factor];
+    unsigned char *dst = small[i];
+    for (unsigned int j = 0; j < w; j++)
+      dst[j] = src[j * factor];
+  }
+}
+#endif
+
+/*!
+  Destructor : stops the detection worker of the pipelined mode.
+*/
+vpDetectorFace::~vpDetectorFace()
+{
+  if (m_asyncThread != NULL) {
+    m_asyncRunning = false;
+    delete m_asyncThread; // joins
+  }
+}
+
+/*!
+  Enable or disable the pipelined detection mode. While enabled, every
+  \e stride-th frame given to detect() is handed, subsampled by
+  \e downscale, to a worker thread running the cascade; the intermediate
+  frames are answered immediately with the latest boxes extrapolated
+  under a constant-velocity assumption from the two previous detections.
+  getDetectionTimestamp() dates the frame the reported boxes come from.
+
+  \param enable : True to detect asynchronously.
+  \param stride : Frames between two worker detections.
+  \param downscale : Subsampling of the frames handed to the worker; the
+  reported boxes stay in full-resolution coordinates.
+*/
+void vpDetectorFace::setAsyncDetection(const bool &enable, const unsigned int &stride,
+                                       const unsigned int &downscale)
+{
+  if (!enable && m_asyncThread != NULL) {
+    m_asyncRunning = false;
+    delete m_asyncThread;
+    m_asyncThread = NULL;
+  }
+  m_asyncEnabled = enable;
+  m_asyncStride = stride == 0 ? 1 : stride;
+  m_asyncDownscale = downscale == 0 ? 1 : downscale;
+  m_asyncFrameCounter = 0;
+  m_asyncBusy = false;
+  m_asyncResult.clear();
+  m_prevResult.clear();
+  if (enable && m_asyncThread == NULL) {
+    m_asyncRunning = true;
+    m_asyncThread = new vpThread(asyncLoop, (vpThread::Args)this);
+  }
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Worker : runs the cascade on the frames handed by detect().
+*/
+vpThread::Return vpDetectorFace::asyncLoop(vpThread::Args args)
+{
+  vpDetectorFace *self = (vpDetectorFace *)args;
+  vpImage<unsigned char> frame;
+  double timestamp = 0.;
+  cv::Mat gray;
+  std::vector<cv::Rect> faces;
+
+  while (self->m_asyncRunning) {
+    bool work = false;
+    {
+      vpMutex::vpScopedLock lock(self->m_asyncMutex);
+      if (self->m_asyncBusy) {
+        frame = self->m_asyncInput;
+        timestamp = self->m_asyncInputTimestamp;
+        work = true;
+      }
+    }
+    if (!work) {
+#if defined(_WIN32)
+      Sleep(1);
+#else
+      usleep(200);
+#endif
+      continue;
+    }
+
+    faces.clear();
+    try {
+      vpImageConvert::convert(frame, gray);
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+      self->m_face_cascade.detectMultiScale( gray, faces, 1.1, 2, 0, cv::Size(30, 30) );
+#else
+      self->m_face_cascade.detectMultiScale( gray, faces, 1.1, 2, 0|CV_HAAR_SCALE_IMAGE, cv::Size(30, 30) );
+#endif
+      std::sort(faces.begin(), faces.end(), vpSortLargestFace);
+    }
+    catch (...) {
+      //A throwing cascade must not kill the worker : the frame is dropped
+      vpMutex::vpScopedLock lock(self->m_asyncMutex);
+      self->m_asyncBusy = false;
+      continue;
+    }
+
+    {
+      vpMutex::vpScopedLock lock(self->m_asyncMutex);
+      self->m_prevResult = self->m_asyncResult;
+      self->m_prevResultTimestamp = self->m_asyncResultTimestamp;
+      self->m_asyncResult.clear();
+      for (size_t i = 0; i < faces.size(); i++) {
+        //Back to full-resolution coordinates
+        self->m_asyncResult.push_back(vpRect(faces[i].x * (double)self->m_asyncDownscale,
+                                             faces[i].y * (double)self->m_asyncDownscale,
+                                             faces[i].width * (double)self->m_asyncDownscale,
+                                             faces[i].height * (double)self->m_asyncDownscale));
+      }
+      self->m_asyncResultTimestamp = timestamp;
+      self->m_asyncBusy = false;
+    }
+  }
+  return NULL;
+}
+#endif
+
+/*!
+  Fill the detector state from full-resolution boxes.
+*/
+void vpDetectorFace::publishBoxes(const std::vector<vpRect> &boxes)
+{
+  m_message.clear();
+  m_polygon.clear();
+  m_nb_objects = boxes.size();
+  for (size_t i = 0; i < boxes.size(); i++) {
+    std::ostringstream message;
+    message << "Face " << i;
+    m_message.push_back(message.str());
+    std::vector<vpImagePoint> polygon;
+    polygon.push_back(vpImagePoint(boxes[i].getTop(), boxes[i].getLeft()));
+    polygon.push_back(vpImagePoint(boxes[i].getTop(), boxes[i].getRight()));
+    polygon.push_back(vpImagePoint(boxes[i].getBottom(), boxes[i].getRight()));
+    polygon.push_back(vpImagePoint(boxes[i].getBottom(), boxes[i].getLeft()));
+    m_polygon.push_back(polygon);
+  }
+}
+
 bool vpDetectorFace::detect(const vpImage<unsigned char> &I)
 {
-  vpImageConvert::convert(I, m_frame_gray);
+  if (!m_asyncEnabled) {
+    vpImageConvert::convert(I, m_frame_gray);
 
-  return detect(m_frame_gray);
+    return detect(m_frame_gray);
+  }
+
+  double now = vpTime::measureTimeMicros();
+  m_asyncFrameCounter++;
+
+  //Hand every stride-th frame to the worker when it is free
+  if ((m_asyncFrameCounter % m_asyncStride) == 1 || m_asyncStride == 1) {
+    vpMutex::vpScopedLock lock(m_asyncMutex);
+    if (!m_asyncBusy) {
+      vpDetectorFaceDownscale(I, m_asyncDownscale, m_asyncInput);
+      m_asyncInputTimestamp = now;
+      m_asyncBusy = true;
+    }
+  }
+
+  //Deliver the latest result, extrapolated with the inter-detection motion
+  std::vector<vpRect> current, previous;
+  double currentTs = 0., previousTs = 0.;
+  {
+    vpMutex::vpScopedLock lock(m_asyncMutex);
+    current = m_asyncResult;
+    currentTs = m_asyncResultTimestamp;
+    previous = m_prevResult;
+    previousTs = m_prevResultTimestamp;
+  }
+
+  if (current.empty()) {
+    publishBoxes(current);
+    m_lastDeliveredTimestamp = currentTs;
+    return false;
+  }
+
+  std::vector<vpRect> delivered = current;
+  if (!previous.empty() && currentTs > previousTs) {
+    //Constant-velocity extrapolation of the matching boxes
+    double advance = (now - currentTs) / (currentTs - previousTs);
+    if (advance > 3.) advance = 3.; // a stalled worker must not fling the boxes
+    size_t n = current.size() < previous.size() ? current.size() : previous.size();
+    for (size_t i = 0; i < n; i++) {
+      double dLeft = current[i].getLeft() - previous[i].getLeft();
+      double dTop = current[i].getTop() - previous[i].getTop();
+      delivered[i] = vpRect(current[i].getLeft() + dLeft * advance,
+                            current[i].getTop() + dTop * advance,
+                            current[i].getWidth(), current[i].getHeight());
+    }
+  }
+  publishBoxes(delivered);
+  m_lastDeliveredTimestamp = currentTs;
+  return true;
 }
 /*!
    Allows to detect a face in the image. When more than one face is detected, faces are sorted from largest to smallest.
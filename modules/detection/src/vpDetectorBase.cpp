@@ -37,11 +37,15 @@
 #include <visp3/core/vpConfig.h>
 
 #include <visp3/detection/vpDetectorBase.h>
+#include <visp3/core/vpImageTools.h>
 
  /*!
 	 Default constructor.
  */
-vpDetectorBase::vpDetectorBase() : m_polygon(), m_message(), m_nb_objects(0)
+vpDetectorBase::vpDetectorBase()
+  : m_polygon(), m_message(), m_nb_objects(0),
+    m_guidedEnabled(false), m_guidedMargin(32), m_guidedFullScanCadence(5),
+    m_guidedDownscale(2), m_guidedPrior(), m_guidedMissCount(0)
 {}
 
 /*!
@@ -105,3 +109,138 @@ vpDetectorBase::getBBox(size_t i) const
 	vpRect roi(vpImagePoint(top, left), vpImagePoint(bottom, right));
 	return roi;
 }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Nearest-neighbor subsampling of the localization pass
+static void vpDetectorDownscale(const vpImage<unsigned char> &I, unsigned int factor,
+                                vpImage<unsigned char> &small)
+{
+  unsigned int h = I.getHeight() / factor;
+  unsigned int w = I.getWidth() / factor;
+  small.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    const unsigned char *src = I[i * factor];
+    unsigned char *dst = small[i];
+    for (unsigned int j = 0; j < w; j++)
+      dst[j] = src[j * factor];
+  }
+}
+
+//Clamped bounding box of a polygon set, enlarged by margin
+static vpRect vpDetectorPriorBox(const std::vector< std::vector<vpImagePoint> > &polygons,
+                                 unsigned int margin, const vpImage<unsigned char> &I)
+{
+  double top = I.getHeight(), left = I.getWidth(), bottom = 0, right = 0;
+  for (size_t p = 0; p < polygons.size(); p++)
+    for (size_t k = 0; k < polygons[p].size(); k++) {
+      if (polygons[p][k].get_i() < top) top = polygons[p][k].get_i();
+      if (polygons[p][k].get_i() > bottom) bottom = polygons[p][k].get_i();
+      if (polygons[p][k].get_j() < left) left = polygons[p][k].get_j();
+      if (polygons[p][k].get_j() > right) right = polygons[p][k].get_j();
+    }
+  top -= margin; left -= margin; bottom += margin; right += margin;
+  if (top < 0) top = 0;
+  if (left < 0) left = 0;
+  if (bottom > I.getHeight() - 1) bottom = I.getHeight() - 1;
+  if (right > I.getWidth() - 1) right = I.getWidth() - 1;
+  return vpRect(left, top, right - left + 1, bottom - top + 1);
+}
+#endif
+
+/*!
+  Detect objects, restricting the work with the position of the previous
+  detection : the neighborhood of the last seen polygons is searched
+  first, and a full-frame scan only runs on a miss, at the configured
+  cadence, localizing on a subsampled copy and refining each hit at full
+  resolution. Results are available through the usual getPolygon(),
+  getMessage() and getNbObjects() accessors; when the guided search is
+  disabled this behaves exactly as detect().
+
+  \param I : Image where to detect objects.
+  \return true if one or multiple objects are detected, false otherwise.
+
+  \sa setGuidedSearch()
+*/
+bool vpDetectorBase::detectGuided(const vpImage<unsigned char> &I)
+{
+  if (!m_guidedEnabled)
+    return detect(I);
+
+  //Prior neighborhood first
+  if (!m_guidedPrior.empty()) {
+    vpRect roi = vpDetectorPriorBox(m_guidedPrior, m_guidedMargin, I);
+    vpImage<unsigned char> crop;
+    vpImageTools::crop(I, roi, crop);
+    if (detect(crop)) {
+      for (size_t p = 0; p < m_polygon.size(); p++)
+        for (size_t k = 0; k < m_polygon[p].size(); k++)
+          m_polygon[p][k].set_ij(m_polygon[p][k].get_i() + roi.getTop(),
+                                 m_polygon[p][k].get_j() + roi.getLeft());
+      m_guidedPrior = m_polygon;
+      m_guidedMissCount = 0;
+      return true;
+    }
+    m_guidedMissCount++;
+    if (m_guidedMissCount % m_guidedFullScanCadence != 0) {
+      m_polygon.clear();
+      m_message.clear();
+      m_nb_objects = 0;
+      return false;
+    }
+  }
+
+  //Full-frame pass, localized on a subsampled copy when requested
+  bool detected = false;
+  if (m_guidedDownscale > 1 && I.getHeight() >= 2 * m_guidedDownscale) {
+    vpImage<unsigned char> small;
+    vpDetectorDownscale(I, m_guidedDownscale, small);
+    if (detect(small)) {
+      //Snapshot the coarse hits, then refine each at full resolution
+      std::vector< std::vector<vpImagePoint> > coarse = m_polygon;
+      std::vector<std::string> coarseMsg = m_message;
+      std::vector< std::vector<vpImagePoint> > refined;
+      std::vector<std::string> refinedMsg;
+
+      for (size_t p = 0; p < coarse.size(); p++) {
+        std::vector< std::vector<vpImagePoint> > one(1, coarse[p]);
+        for (size_t k = 0; k < one[0].size(); k++)
+          one[0][k].set_ij(one[0][k].get_i() * m_guidedDownscale,
+                           one[0][k].get_j() * m_guidedDownscale);
+        vpRect roi = vpDetectorPriorBox(one, m_guidedMargin, I);
+        vpImage<unsigned char> crop;
+        vpImageTools::crop(I, roi, crop);
+        if (detect(crop)) {
+          for (size_t q = 0; q < m_polygon.size(); q++) {
+            for (size_t k = 0; k < m_polygon[q].size(); k++)
+              m_polygon[q][k].set_ij(m_polygon[q][k].get_i() + roi.getTop(),
+                                     m_polygon[q][k].get_j() + roi.getLeft());
+            refined.push_back(m_polygon[q]);
+            refinedMsg.push_back(q < m_message.size() ? m_message[q] : coarseMsg[p]);
+          }
+        }
+        else {
+          //Keep the coarse localization when the refinement misses
+          refined.push_back(one[0]);
+          refinedMsg.push_back(coarseMsg.size() > p ? coarseMsg[p] : std::string());
+        }
+      }
+
+      m_polygon = refined;
+      m_message = refinedMsg;
+      m_nb_objects = m_polygon.size();
+      detected = !m_polygon.empty();
+    }
+  }
+  else {
+    detected = detect(I);
+  }
+
+  if (detected) {
+    m_guidedPrior = m_polygon;
+    m_guidedMissCount = 0;
+  }
+  else {
+    m_guidedPrior.clear();
+  }
+  return detected;
+}
@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Headless display backend.
+ *
+ *****************************************************************************/
+
+#ifndef vpDisplayNull_h
+#define vpDisplayNull_h
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpDisplayNull
+
+  \ingroup group_gui_display
+
+  \brief Headless display backend : every vpDisplay call is accepted at
+  near-zero cost, so the same binary runs on production hosts without an
+  X server and on development machines.
+
+  When a live view is needed, enableFrameExport() publishes the
+  composited frame (background image plus overlay primitives, rendered in
+  software) into a System V shared memory ring at each flushDisplay(); a
+  separate viewer process polls it with readExportedFrame(). While the
+  export is disabled the drawing functions only record nothing and cost a
+  test each.
+
+  \code
+#include <visp3/gui/vpDisplayNull.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  vpDisplayNull d(I);
+  d.enableFrameExport(0x4d50); // only while debugging
+
+  // usual tracking loop : display/overlay/flush calls all work
+}
+  \endcode
+
+  \sa vpDisplayX
+*/
+class VISP_EXPORT vpDisplayNull : public vpDisplay
+{
+public:
+  vpDisplayNull();
+  vpDisplayNull(vpImage<unsigned char> &I, int winx=-1, int winy=-1, const std::string &title="");
+  vpDisplayNull(vpImage<vpRGBa> &I, int winx=-1, int winy=-1, const std::string &title="");
+
+  virtual ~vpDisplayNull();
+
+  void init(vpImage<unsigned char> &I, int winx=-1, int winy=-1, const std::string &title="");
+  void init(vpImage<vpRGBa> &I, int winx=-1, int winy=-1, const std::string &title="");
+  void init(unsigned int width, unsigned int height, int winx=-1, int winy=-1, const std::string &title="");
+
+  bool enableFrameExport(const int &key, const unsigned int &nbSlots = 4);
+  void disableFrameExport();
+
+  /*!
+    Indicates if the composited frames are published into the shared
+    memory ring.
+
+    \return True while the export is enabled.
+  */
+  bool isFrameExportEnabled() const { return m_exportEnabled; }
+
+  static bool readExportedFrame(const int &key, vpImage<vpRGBa> &I, unsigned int &frameNumber);
+
+  void getImage(vpImage<vpRGBa> &I);
+  void getScreenSize(unsigned int &w, unsigned int &h);
+
+protected:
+  void clearDisplay(const vpColor &color=vpColor::white);
+  void closeDisplay();
+  void displayArrow(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color=vpColor::white,
+                    unsigned int w=4, unsigned int h=2, unsigned int thickness=1);
+  void displayCharString(const vpImagePoint &ip, const char *text, const vpColor &color=vpColor::green);
+  void displayCircle(const vpImagePoint &center, unsigned int radius, const vpColor &color,
+                     bool fill=false, unsigned int thickness=1);
+  void displayCross(const vpImagePoint &ip, unsigned int size, const vpColor &color, unsigned int thickness=1);
+  void displayDotLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color, unsigned int thickness=1);
+  void displayLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color, unsigned int thickness=1);
+  void displayImage(const vpImage<unsigned char> &I);
+  void displayImage(const vpImage<vpRGBa> &I);
+  void displayImageROI(const vpImage<unsigned char> &I, const vpImagePoint &iP, const unsigned int width, const unsigned int height);
+  void displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &iP, const unsigned int width, const unsigned int height);
+  void displayPoint(const vpImagePoint &ip, const vpColor &color);
+  void displayRectangle(const vpImagePoint &topLeft, unsigned int width, unsigned int height,
+                        const vpColor &color, bool fill=false, unsigned int thickness=1);
+  void displayRectangle(const vpImagePoint &topLeft, const vpImagePoint &bottomRight,
+                        const vpColor &color, bool fill=false, unsigned int thickness=1);
+  void displayRectangle(const vpRect &rectangle, const vpColor &color, bool fill=false, unsigned int thickness=1);
+  void flushDisplay();
+  void flushDisplayROI(const vpImagePoint &iP, const unsigned int width, const unsigned int height);
+  bool getClick(bool blocking=true);
+  bool getClick(vpImagePoint &ip, bool blocking=true);
+  bool getClick(vpImagePoint &ip, vpMouseButton::vpMouseButtonType &button, bool blocking=true);
+  bool getClickUp(vpImagePoint &ip, vpMouseButton::vpMouseButtonType &button, bool blocking=true);
+  bool getKeyboardEvent(bool blocking=true);
+  bool getKeyboardEvent(std::string &key, bool blocking=true);
+  bool getPointerMotionEvent(vpImagePoint &ip);
+  bool getPointerPosition(vpImagePoint &ip);
+  void setFont(const std::string &font);
+  void setTitle(const std::string &title);
+  void setWindowPosition(int winx, int winy);
+
+private:
+  void setPixel(int i, int j, const vpColor &color);
+  void drawLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color, unsigned int thickness);
+  void publishFrame();
+
+  //Composited frame, only maintained while the export is enabled
+  vpImage<vpRGBa> m_frame;
+  bool m_exportEnabled;
+  int m_exportKey;
+  unsigned int m_nbSlots;
+  int m_shmId;
+  unsigned char *m_shmAddr;
+  unsigned int m_frameNumber;
+};
+
+#endif
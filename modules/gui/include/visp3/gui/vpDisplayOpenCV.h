@@ -152,6 +152,8 @@ private:
   cv::Scalar cvcolor;
   int font;
   float fontScale;
+  //Dirty flag of the window content between two flushes
+  bool m_dirty;
 #endif
   static std::vector<std::string> m_listTitles;
   static unsigned int m_nbWindows ;
@@ -108,6 +108,16 @@ class VISP_EXPORT vpDisplayWin32 : public vpDisplay
   //! The window.
   vpWin32Window window;
 
+  //Dirty region accumulated between two flushes
+  bool m_dirtyValid;
+  double m_dirtyLeft;
+  double m_dirtyTop;
+  double m_dirtyRight;
+  double m_dirtyBottom;
+
+  void markDirty(const double &left, const double &top, const double &right, const double &bottom);
+  void markAllDirty();
+
   //!
   RECT roi;
 
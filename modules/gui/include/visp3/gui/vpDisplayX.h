@@ -40,6 +40,8 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDisplay.h>
+
+#include <vector>
 #ifdef VISP_HAVE_X11
 
 //namespace X11name
@@ -170,6 +172,35 @@ private:
   unsigned int RMask, GMask, BMask;
   int RShift, GShift, BShift;
 
+  //MIT-SHM backed double buffered path; the segment descriptors stay
+  //opaque so that the header does not depend on the XShm extension
+  //Row hashes of the last grayscale conversion per destination buffer
+  //(two SHM buffers + the classic XImage) and of the last pushed frame,
+  //plus the overlay flag forcing a full repaint of the background
+  std::vector<unsigned long long> m_rowHash[3];
+  std::vector<unsigned long long> m_pushedRowHash;
+  bool m_pixmapDirty;
+
+  bool m_shmEnabled;
+  int m_shmBack;
+  XImage *m_shmImage[2];
+  void *m_shmInfo[2];
+  bool m_shmPending[2];
+  int m_shmCompletionType;
+
+  void displayPrimitives(const std::vector<vpOverlayPrimitive> &primitives);
+
+  void setDrawColor(const vpColor &color);
+
+  void setupSHM();
+  void teardownSHM();
+  XImage *workImage();
+  int workBufferIndex() const;
+  void invalidateConversionCache();
+  void pushImageBand(const unsigned int &firstRow, const unsigned int &nbRows);
+  void waitShmCompletion(const int &buffer);
+  void pushImage();
+
   //private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
   //  vpDisplayX(const vpDisplayX &)
@@ -198,6 +229,16 @@ public:
   void init(unsigned int width, unsigned int height, int winx=-1, int winy=-1, const std::string &title="") ;
   
   unsigned int getScreenDepth();
+
+  /*!
+    Indicates if the display uses the MIT-SHM double buffered path. The
+    shared memory images are set up at init() when the extension is
+    usable, with an automatic fallback on XPutImage() otherwise.
+
+    \return True when the images go through XShmPutImage().
+  */
+  bool isUsingSHM() const { return m_shmEnabled; }
+
   void getScreenSize(unsigned int &width, unsigned int &height);
   void getImage(vpImage<vpRGBa> &I) ;
 
@@ -45,8 +45,11 @@
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpThread.h>
 #include <visp3/gui/vpPlotGraph.h>
 
+#include <vector>
+
 /*!
   \class vpPlot
   \ingroup group_gui_plotter
@@ -116,16 +119,33 @@ class VISP_EXPORT vpPlot
     vpImage<unsigned char> I;
   
   private:
+    //! One sample handed over by the wait-free record() API.
+    typedef struct {
+      unsigned int graphNum;
+      unsigned int curveNum;
+      double x;
+      double y;
+    } vpPlotSample;
+
     vpDisplay *display;
-    
+
     unsigned int graphNbr;
     vpPlotGraph* graphList;
-    
+
     unsigned int margei;
     unsigned int margej;
-    
+
     float factori;
     float factorj;
+
+    std::vector<vpPlotSample> m_recordSlots;
+    unsigned int m_recordSize; //!< Ring size : capacity + 1
+    volatile unsigned int m_recordHead; //!< Next slot the producer writes
+    volatile unsigned int m_recordTail; //!< Next slot the consumer reads
+    volatile unsigned long m_recordDropped;
+    vpThread *m_renderThread;
+    volatile bool m_renderRunning;
+    double m_renderPeriodMs;
     
 //private:
 //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -191,8 +211,20 @@ public:
     void setUnitY (const unsigned int graphNum, const std::string &unity);
     void setUnitZ (const unsigned int graphNum, const std::string &unitz);
     void setThickness (const unsigned int graphNum, const unsigned int curveNum, const unsigned int thickness);
-    
+    void setMaxBufferSize (const unsigned int graphNum, const unsigned int maxPoints);
+
+    void initRecording (const unsigned int &capacity = 1024);
+    bool record (const unsigned int graphNum, const unsigned int curveNum, const double x, const double y);
+    unsigned int flushRecorded ();
+    //! Get the number of samples record() dropped because the ring was full.
+    unsigned long getRecordingNbDropped() const { return m_recordDropped; }
+    void startRecordingDisplay (const double &periodMs = 40.);
+    void stopRecordingDisplay ();
+
   private:
+    static vpThread::Return renderLoop (vpThread::Args args);
+    static void memoryBarrier();
+
     void initNbGraph (unsigned int nbGraph);
     void displayGrid();
 };
@@ -81,12 +81,19 @@ class vpPlotCurve
     double xmax;
     double ymin;
     double ymax;
+    //! Bound on the number of stored points; 0 keeps every point.
+    unsigned int maxBufferSize;
     
   public:
     vpPlotCurve();
     ~vpPlotCurve();
     void plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y);
     void plotList(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx, const double zoomy);
+    void setMaxBufferSize(const unsigned int &maxPoints);
+  
+  private:
+    void plotListDecimated(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx, const double zoomy);
+    void trimBuffer();
 };
 
 #endif
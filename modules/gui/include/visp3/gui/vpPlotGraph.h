@@ -205,6 +205,7 @@ public:
       this->gridThickness = thickness;
     };
     void setLegend (const unsigned int curveNum, const std::string &legend);
+    void setMaxBufferSize (const unsigned int &maxPoints);
     void setTitle (const std::string &title);
     void setUnitX (const std::string &unitx);
     void setUnitY (const std::string &unity);
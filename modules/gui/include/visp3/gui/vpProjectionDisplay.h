@@ -99,7 +99,10 @@ public:
 #if defined (VISP_HAVE_DISPLAY)
       dIcam(), dIext(),
 #endif
-      listFp(), o(), x(), y(), z(), traj()
+      listFp(),
+      m_projCacheValid(false), m_projCacheCextMo(), m_projCachePx(0), m_projCachePy(0),
+      m_projCacheU0(0), m_projCacheV0(0), m_projCacheColor(), m_projCacheThickness(0),
+      m_projCachePrimitives(), o(), x(), y(), z(), traj()
   {
     init();
   }
@@ -108,7 +111,10 @@ public:
 #if defined (VISP_HAVE_DISPLAY)
       dIcam(), dIext(),
 #endif
-      listFp(), o(), x(), y(), z(), traj()
+      listFp(),
+      m_projCacheValid(false), m_projCacheCextMo(), m_projCachePx(0), m_projCachePy(0),
+      m_projCacheU0(0), m_projCacheV0(0), m_projCacheColor(), m_projCacheThickness(0),
+      m_projCachePrimitives(), o(), x(), y(), z(), traj()
   {
     init(select) ;
   }
@@ -129,6 +135,14 @@ public:
 
 private:
   std::list<vpForwardProjection *> listFp ;
+  //Cache of the projected object overlay, keyed on the external view pose
+  //and camera : the forward projection chain only reruns when they change
+  bool m_projCacheValid;
+  vpHomogeneousMatrix m_projCacheCextMo;
+  double m_projCachePx, m_projCachePy, m_projCacheU0, m_projCacheV0;
+  vpColor m_projCacheColor;
+  unsigned int m_projCacheThickness;
+  std::vector<vpDisplay::vpOverlayPrimitive> m_projCachePrimitives;
   vpPoint o ;
   vpPoint x ;
   vpPoint y ;
@@ -0,0 +1,542 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Headless display backend.
+ *
+ *****************************************************************************/
+
+#include <visp3/gui/vpDisplayNull.h>
+
+#include <visp3/core/vpDisplayException.h>
+#include <visp3/core/vpMath.h>
+
+#include <cstring>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#  define VISP_NULL_DISPLAY_HAVE_SHM
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Layout of the exported shared memory ring : a header followed by the
+//slots, each slot being a sequence-guarded RGBA frame. A slot is valid
+//when its sequence counter is even and unchanged around the copy.
+struct vpDisplayNullShmHeader
+{
+  unsigned int magic;       // "VPND"
+  unsigned int width;
+  unsigned int height;
+  unsigned int nbSlots;
+  volatile unsigned int lastSlot;
+  volatile unsigned int lastFrameNumber;
+};
+
+struct vpDisplayNullShmSlot
+{
+  volatile unsigned int sequence;
+  unsigned int frameNumber;
+};
+
+static const unsigned int vpDisplayNullMagic = 0x56504e44; // "VPND"
+
+static size_t vpDisplayNullSlotSize(const unsigned int &w, const unsigned int &h)
+{
+  return sizeof(vpDisplayNullShmSlot) + (size_t)w * h * sizeof(vpRGBa);
+}
+#endif
+
+/*!
+  Basic constructor.
+*/
+vpDisplayNull::vpDisplayNull()
+  : vpDisplay(), m_frame(), m_exportEnabled(false), m_exportKey(0), m_nbSlots(0),
+    m_shmId(-1), m_shmAddr(NULL), m_frameNumber(0)
+{
+}
+
+/*!
+  Constructor initializing the headless display on a grayscale image.
+
+  \param I : Image associated to the display.
+  \param winx, winy : Ignored, kept for the interface of the other backends.
+  \param title : Window title, stored but unused.
+*/
+vpDisplayNull::vpDisplayNull(vpImage<unsigned char> &I, int winx, int winy, const std::string &title)
+  : vpDisplay(), m_frame(), m_exportEnabled(false), m_exportKey(0), m_nbSlots(0),
+    m_shmId(-1), m_shmAddr(NULL), m_frameNumber(0)
+{
+  init(I, winx, winy, title);
+}
+
+/*!
+  Constructor initializing the headless display on a color image.
+
+  \param I : Image associated to the display.
+  \param winx, winy : Ignored, kept for the interface of the other backends.
+  \param title : Window title, stored but unused.
+*/
+vpDisplayNull::vpDisplayNull(vpImage<vpRGBa> &I, int winx, int winy, const std::string &title)
+  : vpDisplay(), m_frame(), m_exportEnabled(false), m_exportKey(0), m_nbSlots(0),
+    m_shmId(-1), m_shmAddr(NULL), m_frameNumber(0)
+{
+  init(I, winx, winy, title);
+}
+
+/*!
+  Destructor : detaches the shared memory ring if the export was enabled.
+*/
+vpDisplayNull::~vpDisplayNull()
+{
+  closeDisplay();
+}
+
+void vpDisplayNull::init(vpImage<unsigned char> &I, int winx, int winy, const std::string &title)
+{
+  init(I.getWidth(), I.getHeight(), winx, winy, title);
+  I.display = this;
+}
+
+void vpDisplayNull::init(vpImage<vpRGBa> &I, int winx, int winy, const std::string &title)
+{
+  init(I.getWidth(), I.getHeight(), winx, winy, title);
+  I.display = this;
+}
+
+void vpDisplayNull::init(unsigned int w, unsigned int h, int winx, int winy, const std::string &title)
+{
+  //The exported ring describes the previous geometry : drop it
+  disableFrameExport();
+  width = w;
+  height = h;
+  windowXPosition = winx;
+  windowYPosition = winy;
+  title_ = title;
+  displayHasBeenInitialized = true;
+}
+
+/*!
+  Publish the composited frames into a System V shared memory ring that a
+  viewer process reads with readExportedFrame(). The ring is created at
+  the given key with \e nbSlots frames; each flushDisplay() writes the
+  current frame into the next slot.
+
+  \param key : System V IPC key identifying the ring.
+  \param nbSlots : Number of frames of the ring.
+
+  \return True if the ring could be created, false otherwise (or on the
+  platforms without System V shared memory).
+*/
+bool vpDisplayNull::enableFrameExport(const int &key, const unsigned int &nbSlots)
+{
+#ifdef VISP_NULL_DISPLAY_HAVE_SHM
+  if (!displayHasBeenInitialized)
+    throw(vpDisplayException(vpDisplayException::notInitializedError, "Display not initialized"));
+
+  disableFrameExport();
+
+  unsigned int slots = nbSlots == 0 ? 1 : nbSlots;
+  size_t size = sizeof(vpDisplayNullShmHeader) + slots * vpDisplayNullSlotSize(width, height);
+  int shmId = shmget(key, size, IPC_CREAT | 0600);
+  if (shmId < 0)
+    return false;
+  unsigned char *addr = (unsigned char *)shmat(shmId, NULL, 0);
+  if (addr == (unsigned char *)-1)
+    return false;
+
+  vpDisplayNullShmHeader *header = (vpDisplayNullShmHeader *)addr;
+  header->magic = vpDisplayNullMagic;
+  header->width = width;
+  header->height = height;
+  header->nbSlots = slots;
+  header->lastSlot = 0;
+  header->lastFrameNumber = 0;
+  for (unsigned int s = 0; s < slots; s++) {
+    vpDisplayNullShmSlot *slot =
+      (vpDisplayNullShmSlot *)(addr + sizeof(vpDisplayNullShmHeader) + s * vpDisplayNullSlotSize(width, height));
+    slot->sequence = 0;
+    slot->frameNumber = 0;
+  }
+
+  m_exportKey = key;
+  m_nbSlots = slots;
+  m_shmId = shmId;
+  m_shmAddr = addr;
+  m_frame.resize(height, width);
+  m_exportEnabled = true;
+  return true;
+#else
+  (void)key;
+  (void)nbSlots;
+  return false;
+#endif
+}
+
+/*!
+  Stop publishing the frames and detach from the shared memory ring. The
+  ring itself is left in place for late viewers; it disappears with
+  ipcrm or at reboot, as usual for System V segments.
+*/
+void vpDisplayNull::disableFrameExport()
+{
+#ifdef VISP_NULL_DISPLAY_HAVE_SHM
+  if (m_shmAddr != NULL) {
+    shmdt(m_shmAddr);
+    m_shmAddr = NULL;
+  }
+  m_shmId = -1;
+#endif
+  m_exportEnabled = false;
+  m_frame.destroy();
+}
+
+/*!
+  Attach to the ring published by enableFrameExport() and read the most
+  recent complete frame.
+
+  \param key : System V IPC key of the ring.
+  \param I : Filled with the frame.
+  \param frameNumber : Number of the read frame, increasing by one per
+  flushDisplay() of the publisher.
+
+  \return True if a complete frame could be read.
+*/
+bool vpDisplayNull::readExportedFrame(const int &key, vpImage<vpRGBa> &I, unsigned int &frameNumber)
+{
+#ifdef VISP_NULL_DISPLAY_HAVE_SHM
+  int shmId = shmget(key, 0, 0);
+  if (shmId < 0)
+    return false;
+  unsigned char *addr = (unsigned char *)shmat(shmId, NULL, SHM_RDONLY);
+  if (addr == (unsigned char *)-1)
+    return false;
+
+  bool res = false;
+  vpDisplayNullShmHeader *header = (vpDisplayNullShmHeader *)addr;
+  if (header->magic == vpDisplayNullMagic && header->nbSlots != 0) {
+    unsigned int w = header->width, h = header->height;
+    //Try the most recent slots first; a slot is good when its sequence is
+    //even and identical before and after the copy
+    for (unsigned int attempt = 0; attempt < header->nbSlots && !res; attempt++) {
+      unsigned int s = (header->lastSlot + header->nbSlots - attempt) % header->nbSlots;
+      vpDisplayNullShmSlot *slot =
+        (vpDisplayNullShmSlot *)(addr + sizeof(vpDisplayNullShmHeader) + s * vpDisplayNullSlotSize(w, h));
+      unsigned int seqBefore = slot->sequence;
+      if (seqBefore & 1u)
+        continue;
+      if (seqBefore == 0)
+        continue; // never written
+      __sync_synchronize();
+      I.resize(h, w);
+      memcpy((void *)I.bitmap, (const void *)(slot + 1), (size_t)w * h * sizeof(vpRGBa));
+      unsigned int number = slot->frameNumber;
+      __sync_synchronize();
+      if (slot->sequence == seqBefore) {
+        frameNumber = number;
+        res = true;
+      }
+    }
+  }
+  shmdt(addr);
+  return res;
+#else
+  (void)key;
+  (void)I;
+  (void)frameNumber;
+  return false;
+#endif
+}
+
+//Write the composited frame into the next ring slot
+void vpDisplayNull::publishFrame()
+{
+#ifdef VISP_NULL_DISPLAY_HAVE_SHM
+  if (!m_exportEnabled || m_shmAddr == NULL)
+    return;
+
+  vpDisplayNullShmHeader *header = (vpDisplayNullShmHeader *)m_shmAddr;
+  unsigned int s = (header->lastSlot + 1) % m_nbSlots;
+  vpDisplayNullShmSlot *slot =
+    (vpDisplayNullShmSlot *)(m_shmAddr + sizeof(vpDisplayNullShmHeader) + s * vpDisplayNullSlotSize(width, height));
+
+  m_frameNumber++;
+  slot->sequence++; // odd : writing
+  __sync_synchronize();
+  memcpy((void *)(slot + 1), (const void *)m_frame.bitmap, (size_t)width * height * sizeof(vpRGBa));
+  slot->frameNumber = m_frameNumber;
+  __sync_synchronize();
+  slot->sequence++; // even : complete
+  header->lastSlot = s;
+  header->lastFrameNumber = m_frameNumber;
+#endif
+}
+
+void vpDisplayNull::getImage(vpImage<vpRGBa> &I)
+{
+  if (m_exportEnabled)
+    I = m_frame;
+  else
+    I.resize(height, width);
+}
+
+void vpDisplayNull::getScreenSize(unsigned int &w, unsigned int &h)
+{
+  w = width;
+  h = height;
+}
+
+void vpDisplayNull::clearDisplay(const vpColor &color)
+{
+  if (!m_exportEnabled)
+    return;
+  vpRGBa value(color.R, color.G, color.B, 0);
+  m_frame = value;
+}
+
+void vpDisplayNull::closeDisplay()
+{
+  disableFrameExport();
+  displayHasBeenInitialized = false;
+}
+
+void vpDisplayNull::displayArrow(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                                 unsigned int /*w*/, unsigned int /*h*/, unsigned int thickness)
+{
+  if (!m_exportEnabled)
+    return;
+  drawLine(ip1, ip2, color, thickness);
+}
+
+void vpDisplayNull::displayCharString(const vpImagePoint & /*ip*/, const char * /*text*/, const vpColor & /*color*/)
+{
+  //Text is not rasterized by the headless backend
+}
+
+void vpDisplayNull::displayCircle(const vpImagePoint &center, unsigned int radius, const vpColor &color,
+                                  bool fill, unsigned int /*thickness*/)
+{
+  if (!m_exportEnabled)
+    return;
+  int ci = vpMath::round(center.get_i());
+  int cj = vpMath::round(center.get_j());
+  int r = (int)radius;
+  for (int di = -r; di <= r; di++) {
+    for (int dj = -r; dj <= r; dj++) {
+      int d2 = di * di + dj * dj;
+      if (d2 > r * r)
+        continue;
+      if (!fill && d2 < (r - 1) * (r - 1))
+        continue;
+      setPixel(ci + di, cj + dj, color);
+    }
+  }
+}
+
+void vpDisplayNull::displayCross(const vpImagePoint &ip, unsigned int size, const vpColor &color, unsigned int thickness)
+{
+  if (!m_exportEnabled)
+    return;
+  double i = ip.get_i(), j = ip.get_j();
+  drawLine(vpImagePoint(i - size / 2, j), vpImagePoint(i + size / 2, j), color, thickness);
+  drawLine(vpImagePoint(i, j - size / 2), vpImagePoint(i, j + size / 2), color, thickness);
+}
+
+void vpDisplayNull::displayDotLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                                   unsigned int thickness)
+{
+  if (!m_exportEnabled)
+    return;
+  drawLine(ip1, ip2, color, thickness);
+}
+
+void vpDisplayNull::displayLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                                unsigned int thickness)
+{
+  if (!m_exportEnabled)
+    return;
+  drawLine(ip1, ip2, color, thickness);
+}
+
+void vpDisplayNull::displayImage(const vpImage<unsigned char> &I)
+{
+  if (!m_exportEnabled)
+    return;
+  for (unsigned int i = 0; i < height && i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < width && j < I.getWidth(); j++) {
+      unsigned char v = I[i][j];
+      m_frame[i][j].R = v;
+      m_frame[i][j].G = v;
+      m_frame[i][j].B = v;
+      m_frame[i][j].A = 0;
+    }
+}
+
+void vpDisplayNull::displayImage(const vpImage<vpRGBa> &I)
+{
+  if (!m_exportEnabled)
+    return;
+  for (unsigned int i = 0; i < height && i < I.getHeight(); i++)
+    memcpy((void *)m_frame[i], (const void *)I[i],
+           (width < I.getWidth() ? width : I.getWidth()) * sizeof(vpRGBa));
+}
+
+void vpDisplayNull::displayImageROI(const vpImage<unsigned char> &I, const vpImagePoint &iP,
+                                    const unsigned int w, const unsigned int h)
+{
+  if (!m_exportEnabled)
+    return;
+  unsigned int i0 = (unsigned int)iP.get_i(), j0 = (unsigned int)iP.get_j();
+  for (unsigned int i = i0; i < i0 + h && i < height && i < I.getHeight(); i++)
+    for (unsigned int j = j0; j < j0 + w && j < width && j < I.getWidth(); j++) {
+      unsigned char v = I[i][j];
+      m_frame[i][j].R = v;
+      m_frame[i][j].G = v;
+      m_frame[i][j].B = v;
+      m_frame[i][j].A = 0;
+    }
+}
+
+void vpDisplayNull::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &iP,
+                                    const unsigned int w, const unsigned int h)
+{
+  if (!m_exportEnabled)
+    return;
+  unsigned int i0 = (unsigned int)iP.get_i(), j0 = (unsigned int)iP.get_j();
+  for (unsigned int i = i0; i < i0 + h && i < height && i < I.getHeight(); i++)
+    for (unsigned int j = j0; j < j0 + w && j < width && j < I.getWidth(); j++)
+      m_frame[i][j] = I[i][j];
+}
+
+void vpDisplayNull::displayPoint(const vpImagePoint &ip, const vpColor &color)
+{
+  if (!m_exportEnabled)
+    return;
+  setPixel(vpMath::round(ip.get_i()), vpMath::round(ip.get_j()), color);
+}
+
+void vpDisplayNull::displayRectangle(const vpImagePoint &topLeft, unsigned int w, unsigned int h,
+                                     const vpColor &color, bool fill, unsigned int thickness)
+{
+  if (!m_exportEnabled)
+    return;
+  double i = topLeft.get_i(), j = topLeft.get_j();
+  if (fill) {
+    for (unsigned int di = 0; di < h; di++)
+      for (unsigned int dj = 0; dj < w; dj++)
+        setPixel(vpMath::round(i) + (int)di, vpMath::round(j) + (int)dj, color);
+  }
+  else {
+    drawLine(vpImagePoint(i, j), vpImagePoint(i, j + w), color, thickness);
+    drawLine(vpImagePoint(i + h, j), vpImagePoint(i + h, j + w), color, thickness);
+    drawLine(vpImagePoint(i, j), vpImagePoint(i + h, j), color, thickness);
+    drawLine(vpImagePoint(i, j + w), vpImagePoint(i + h, j + w), color, thickness);
+  }
+}
+
+void vpDisplayNull::displayRectangle(const vpImagePoint &topLeft, const vpImagePoint &bottomRight,
+                                     const vpColor &color, bool fill, unsigned int thickness)
+{
+  double w = bottomRight.get_j() - topLeft.get_j();
+  double h = bottomRight.get_i() - topLeft.get_i();
+  displayRectangle(topLeft, w > 0 ? (unsigned int)w : 0, h > 0 ? (unsigned int)h : 0,
+                   color, fill, thickness);
+}
+
+void vpDisplayNull::displayRectangle(const vpRect &rectangle, const vpColor &color, bool fill, unsigned int thickness)
+{
+  displayRectangle(vpImagePoint(rectangle.getTop(), rectangle.getLeft()),
+                   (unsigned int)rectangle.getWidth(), (unsigned int)rectangle.getHeight(),
+                   color, fill, thickness);
+}
+
+void vpDisplayNull::flushDisplay()
+{
+  publishFrame();
+}
+
+void vpDisplayNull::flushDisplayROI(const vpImagePoint & /*iP*/, const unsigned int /*width*/,
+                                    const unsigned int /*height*/)
+{
+  publishFrame();
+}
+
+bool vpDisplayNull::getClick(bool /*blocking*/) { return false; }
+bool vpDisplayNull::getClick(vpImagePoint & /*ip*/, bool /*blocking*/) { return false; }
+bool vpDisplayNull::getClick(vpImagePoint & /*ip*/, vpMouseButton::vpMouseButtonType & /*button*/, bool /*blocking*/) { return false; }
+bool vpDisplayNull::getClickUp(vpImagePoint & /*ip*/, vpMouseButton::vpMouseButtonType & /*button*/, bool /*blocking*/) { return false; }
+bool vpDisplayNull::getKeyboardEvent(bool /*blocking*/) { return false; }
+bool vpDisplayNull::getKeyboardEvent(std::string & /*key*/, bool /*blocking*/) { return false; }
+bool vpDisplayNull::getPointerMotionEvent(vpImagePoint & /*ip*/) { return false; }
+bool vpDisplayNull::getPointerPosition(vpImagePoint & /*ip*/) { return false; }
+
+void vpDisplayNull::setFont(const std::string & /*font*/) {}
+void vpDisplayNull::setTitle(const std::string &title) { title_ = title; }
+void vpDisplayNull::setWindowPosition(int winx, int winy) { windowXPosition = winx; windowYPosition = winy; }
+
+//Clipped pixel write into the composited frame
+void vpDisplayNull::setPixel(int i, int j, const vpColor &color)
+{
+  if (i < 0 || j < 0 || i >= (int)height || j >= (int)width)
+    return;
+  m_frame[i][j].R = color.R;
+  m_frame[i][j].G = color.G;
+  m_frame[i][j].B = color.B;
+  m_frame[i][j].A = 0;
+}
+
+//Bresenham rasterization of the overlay lines
+void vpDisplayNull::drawLine(const vpImagePoint &ip1, const vpImagePoint &ip2, const vpColor &color,
+                             unsigned int thickness)
+{
+  int i0 = vpMath::round(ip1.get_i()), j0 = vpMath::round(ip1.get_j());
+  int i1 = vpMath::round(ip2.get_i()), j1 = vpMath::round(ip2.get_j());
+
+  int dj = j1 > j0 ? j1 - j0 : j0 - j1;
+  int di = -(i1 > i0 ? i1 - i0 : i0 - i1);
+  int sj = j0 < j1 ? 1 : -1;
+  int si = i0 < i1 ? 1 : -1;
+  int err = dj + di;
+  int t = (int)(thickness == 0 ? 1 : thickness);
+  bool steep = -di > dj;
+
+  for (;;) {
+    for (int k = -(t - 1) / 2; k <= t / 2; k++) {
+      if (steep)
+        setPixel(i0, j0 + k, color);
+      else
+        setPixel(i0 + k, j0, color);
+    }
+    if (i0 == i1 && j0 == j1)
+      break;
+    int e2 = 2 * err;
+    if (e2 >= di) { err += di; j0 += sj; }
+    if (e2 <= dj) { err += dj; i0 += si; }
+  }
+}
@@ -103,7 +103,7 @@ vpDisplayOpenCV::vpDisplayOpenCV(vpImage<unsigned char> &I,
     x_rbuttondown(0), y_rbuttondown(0), rbuttondown(false),
     x_lbuttonup(0), y_lbuttonup(0), lbuttonup(false),
     x_mbuttonup(0), y_mbuttonup(0), mbuttonup(false),
-    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false)
+    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false), m_dirty(true)
 {
   init(I, x, y, title) ;
 }
@@ -132,7 +132,7 @@ vpDisplayOpenCV::vpDisplayOpenCV(vpImage<vpRGBa> &I,
     x_rbuttondown(0), y_rbuttondown(0), rbuttondown(false),
     x_lbuttonup(0), y_lbuttonup(0), lbuttonup(false),
     x_mbuttonup(0), y_mbuttonup(0), mbuttonup(false),
-    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false)
+    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false), m_dirty(true)
 {
   init(I, x, y, title) ;
 }
@@ -172,7 +172,7 @@ vpDisplayOpenCV::vpDisplayOpenCV ( int x, int y, const std::string &title)
     x_rbuttondown(0), y_rbuttondown(0), rbuttondown(false),
     x_lbuttonup(0), y_lbuttonup(0), lbuttonup(false),
     x_mbuttonup(0), y_mbuttonup(0), mbuttonup(false),
-    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false)
+    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false), m_dirty(true)
 {
   windowXPosition = x;
   windowYPosition = y;
@@ -236,7 +236,7 @@ vpDisplayOpenCV::vpDisplayOpenCV()
     x_rbuttondown(0), y_rbuttondown(0), rbuttondown(false),
     x_lbuttonup(0), y_lbuttonup(0), lbuttonup(false),
     x_mbuttonup(0), y_mbuttonup(0), mbuttonup(false),
-    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false)
+    x_rbuttonup(0), y_rbuttonup(0), rbuttonup(false), m_dirty(true)
 {
 }
 
@@ -528,6 +528,7 @@ void vpDisplayOpenCV::displayImage(const vpImage<unsigned char> &I)
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     vpImage<vpRGBa> Ic;
     vpImageConvert::convert(I,Ic);
     vpImageConvert::convert(Ic,background);
@@ -563,7 +564,8 @@ void vpDisplayOpenCV::displayImageROI ( const vpImage<unsigned char> &I,const vp
                                         const unsigned int w, const unsigned int h )
 {
   if (displayHasBeenInitialized)
-  { 
+  {
+    m_dirty = true; 
     vpImage<unsigned char> Itemp;
     vpImageTools::crop(I,(unsigned int)iP.get_i(),(unsigned int)iP.get_j(),h,w,Itemp);
     vpImage<vpRGBa> Ic;
@@ -668,6 +670,7 @@ void vpDisplayOpenCV::displayImage(const vpImage<vpRGBa> &I)
 
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     /* Copie de l'image dans le pixmap fond */
 
     vpImageConvert::convert(I,background);
@@ -702,7 +705,8 @@ void vpDisplayOpenCV::displayImageROI ( const vpImage<vpRGBa> &I,const vpImagePo
                                         const unsigned int w, const unsigned int h )
 {
   if (displayHasBeenInitialized)
-  { 
+  {
+    m_dirty = true; 
     vpImage<vpRGBa> Ic;
     vpImageTools::crop(I,(unsigned int)iP.get_i(),(unsigned int)iP.get_j(),h,w,Ic);
     
@@ -849,6 +853,18 @@ void vpDisplayOpenCV::flushDisplay()
 {
   if (displayHasBeenInitialized)
   {
+    //HighGUI repaints the whole window : when nothing changed since the
+    //last flush the repaint is skipped entirely, only the events are
+    //pumped so the window stays responsive
+    if (!m_dirty) {
+#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+      cvWaitKey(5);
+#else
+      cv::waitKey(5);
+#endif
+      return;
+    }
+    m_dirty = false;
 #if (VISP_HAVE_OPENCV_VERSION < 0x020408)
     cvShowImage(this->title_.c_str(), background );
     cvWaitKey(5);
@@ -874,13 +890,10 @@ void vpDisplayOpenCV::flushDisplayROI(const vpImagePoint &/*iP*/, const unsigned
 {
   if (displayHasBeenInitialized)
   {
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
-    cvShowImage(this->title_.c_str(), background );
-    cvWaitKey(5);
-#else
-    cv::imshow(this->title_.c_str(), background );
-    cv::waitKey(5);
-#endif
+    //A requested region keeps the window dirty; HighGUI cannot blit a
+    //region so the repaint pushes the whole window as before
+    flushDisplay();
+    return;
   }
   else
   {
@@ -918,6 +931,7 @@ void vpDisplayOpenCV::displayArrow ( const vpImagePoint &ip1,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     try{
       double a = ip2.get_i() - ip1.get_i() ;
       double b = ip2.get_j() - ip1.get_j() ;
@@ -984,6 +998,7 @@ void vpDisplayOpenCV::displayCharString(const vpImagePoint &ip,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
       cvPutText( background, text,
@@ -1036,6 +1051,7 @@ void vpDisplayOpenCV::displayCircle(const vpImagePoint &center,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     if (fill == false) {
       if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
@@ -1123,6 +1139,7 @@ vpDisplayOpenCV::displayCross(const vpImagePoint &ip,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     vpImagePoint top,bottom,left,right;
     top.set_i(ip.get_i()-size/2);
     top.set_j(ip.get_j());
@@ -1171,6 +1188,7 @@ vpDisplayOpenCV::displayDotLine(const vpImagePoint &ip1,
 
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     //vpTRACE("Dot lines are not yet implemented");
     if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
@@ -1231,6 +1249,7 @@ vpDisplayOpenCV::displayLine(const vpImagePoint &ip1,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
       cvLine( background,
@@ -1285,6 +1304,7 @@ void vpDisplayOpenCV::displayPoint(const vpImagePoint &ip,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     displayLine(ip,ip,color,1);
 //     if (color.id < vpColor::id_unknown) {
 //       ((uchar*)(background->imageData 
@@ -1344,6 +1364,7 @@ vpDisplayOpenCV::displayRectangle(const vpImagePoint &topLeft,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     if (fill == false) {
       if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
@@ -1451,6 +1472,7 @@ vpDisplayOpenCV::displayRectangle ( const vpImagePoint &topLeft,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     if (fill == false) {
       if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
@@ -1558,6 +1580,7 @@ vpDisplayOpenCV::displayRectangle(const vpRect &rectangle,
 {
   if (displayHasBeenInitialized)
   {
+    m_dirty = true;
     if (fill == false) {
       if (color.id < vpColor::id_unknown) {
 #if VISP_HAVE_OPENCV_VERSION < 0x020408
@@ -59,6 +59,12 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpDisplayException.h>
 
+#ifdef VISP_HAVE_XSHM
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#  include <X11/extensions/XShm.h>
+#endif
+
 // math
 #include <visp3/core/vpMath.h>
 
@@ -79,8 +85,12 @@ vpDisplayX::vpDisplayX ( vpImage<unsigned char> &I,
   : display(NULL), window(), Ximage(NULL), lut(), context(),
     screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false),
-    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0)
+    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0),
+    m_pixmapDirty(true), m_shmEnabled(false), m_shmBack(0), m_shmCompletionType(0)
 {
+  m_shmImage[0] = m_shmImage[1] = NULL;
+  m_shmInfo[0] = m_shmInfo[1] = NULL;
+  m_shmPending[0] = m_shmPending[1] = false;
   init ( I, x, y, title ) ;
 }
 
@@ -99,8 +109,12 @@ vpDisplayX::vpDisplayX ( vpImage<vpRGBa> &I,
   : display(NULL), window(), Ximage(NULL), lut(), context(),
     screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false),
-    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0)
+    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0),
+    m_pixmapDirty(true), m_shmEnabled(false), m_shmBack(0), m_shmCompletionType(0)
 {
+  m_shmImage[0] = m_shmImage[1] = NULL;
+  m_shmInfo[0] = m_shmInfo[1] = NULL;
+  m_shmPending[0] = m_shmPending[1] = false;
   init ( I, x, y, title ) ;
 }
 
@@ -130,8 +144,12 @@ vpDisplayX::vpDisplayX ( int x, int y, const std::string &title )
   : display(NULL), window(), Ximage(NULL), lut(), context(),
     screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false),
-    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0)
+    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0),
+    m_pixmapDirty(true), m_shmEnabled(false), m_shmBack(0), m_shmCompletionType(0)
 {
+  m_shmImage[0] = m_shmImage[1] = NULL;
+  m_shmInfo[0] = m_shmInfo[1] = NULL;
+  m_shmPending[0] = m_shmPending[1] = false;
   windowXPosition = x ;
   windowYPosition = y ;
 
@@ -161,8 +179,12 @@ vpDisplayX::vpDisplayX()
   : display(NULL), window(), Ximage(NULL), lut(), context(),
     screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false),
-    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0)
+    RMask(0), GMask(0), BMask(0), RShift(0), GShift(0), BShift(0),
+    m_pixmapDirty(true), m_shmEnabled(false), m_shmBack(0), m_shmCompletionType(0)
 {
+  m_shmImage[0] = m_shmImage[1] = NULL;
+  m_shmInfo[0] = m_shmInfo[1] = NULL;
+  m_shmPending[0] = m_shmPending[1] = false;
 }
 
 /*!
@@ -618,6 +640,7 @@ vpDisplayX::init ( vpImage<unsigned char> &I, int x, int y, const std::string &t
 
     Ximage->data = ( char * ) malloc ( I.getHeight() * (unsigned int)Ximage->bytes_per_line );
     ximage_data_init = true;
+    setupSHM();
 
   }
   displayHasBeenInitialized = true ;
@@ -1080,6 +1103,7 @@ vpDisplayX::init ( vpImage<vpRGBa> &I, int x, int y, const std::string &title)
 
     Ximage->data = ( char * ) malloc ( I.getHeight() * (unsigned int)Ximage->bytes_per_line );
     ximage_data_init = true;
+    setupSHM();
 
   }
   displayHasBeenInitialized = true ;
@@ -1557,6 +1581,7 @@ void vpDisplayX::init ( unsigned int w, unsigned int h, int x, int y, const std:
 
     Ximage->data = ( char * ) malloc ( height * (unsigned int)Ximage->bytes_per_line );
     ximage_data_init = true;
+    setupSHM();
   }
   displayHasBeenInitialized = true ;
 
@@ -1648,6 +1673,267 @@ void vpDisplayX::setWindowPosition(int winx, int winy)
   }
 }
 
+#ifdef VISP_HAVE_XSHM
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Detection of the asynchronous BadAccess the server sends when the shared
+//segment cannot be attached (e.g. remote display)
+static bool vpDisplayXShmAttachFailed = false;
+static int vpDisplayXShmErrorHandler(Display *, XErrorEvent *)
+{
+  vpDisplayXShmAttachFailed = true;
+  return 0;
+}
+#endif
+#endif
+
+/*!
+  Try to set up the MIT-SHM double buffered path : two shared memory
+  images the conversions write into, pushed with XShmPutImage() so that
+  the conversion of a frame overlaps the display of the previous one.
+  On any failure (extension missing, remote display, no shared memory
+  left) the display silently stays on the XPutImage() path.
+*/
+void vpDisplayX::setupSHM()
+{
+  //Release the segments of a previous init()
+  teardownSHM();
+#ifdef VISP_HAVE_XSHM
+  int major, minor;
+  Bool pixmaps;
+  if ( !XShmQueryVersion ( display, &major, &minor, &pixmaps ) )
+    return;
+
+  for ( int b = 0; b < 2; b ++ ) {
+    m_shmImage[b] = NULL;
+    m_shmInfo[b] = NULL;
+    m_shmPending[b] = false;
+  }
+
+  for ( int b = 0; b < 2; b ++ ) {
+    XShmSegmentInfo *info = new XShmSegmentInfo;
+    memset ( info, 0, sizeof ( XShmSegmentInfo ) );
+    XImage *img = XShmCreateImage ( display, DefaultVisual ( display, screen ),
+                                    screen_depth, ZPixmap, NULL, info,
+                                    width, height );
+    if ( img == NULL ) {
+      delete info;
+      teardownSHM();
+      return;
+    }
+    info->shmid = shmget ( IPC_PRIVATE, (size_t)img->bytes_per_line * img->height,
+                           IPC_CREAT | 0600 );
+    if ( info->shmid < 0 ) {
+      XDestroyImage ( img );
+      delete info;
+      teardownSHM();
+      return;
+    }
+    info->shmaddr = img->data = ( char * ) shmat ( info->shmid, NULL, 0 );
+    //The segment is removed once both sides detached
+    shmctl ( info->shmid, IPC_RMID, NULL );
+    if ( info->shmaddr == ( char * ) -1 ) {
+      img->data = NULL;
+      XDestroyImage ( img );
+      delete info;
+      teardownSHM();
+      return;
+    }
+    info->readOnly = False;
+
+    vpDisplayXShmAttachFailed = false;
+    XErrorHandler previousHandler = XSetErrorHandler ( vpDisplayXShmErrorHandler );
+    Status attached = XShmAttach ( display, info );
+    XSync ( display, False );
+    XSetErrorHandler ( previousHandler );
+
+    m_shmImage[b] = img;
+    m_shmInfo[b] = info;
+
+    if ( !attached || vpDisplayXShmAttachFailed ) {
+      teardownSHM();
+      return;
+    }
+  }
+
+  m_shmCompletionType = XShmGetEventBase ( display ) + ShmCompletion;
+  m_shmBack = 0;
+  m_shmEnabled = true;
+#endif
+}
+
+/*!
+  Release the shared memory images set up by setupSHM().
+*/
+void vpDisplayX::teardownSHM()
+{
+#ifdef VISP_HAVE_XSHM
+  for ( int b = 0; b < 2; b ++ ) {
+    XShmSegmentInfo *info = ( XShmSegmentInfo * ) m_shmInfo[b];
+    if ( info != NULL && m_shmImage[b] != NULL ) {
+      if ( info->shmaddr != NULL && info->shmaddr != ( char * ) -1 ) {
+        XShmDetach ( display, info );
+        XSync ( display, False );
+      }
+      m_shmImage[b]->data = NULL;
+      XDestroyImage ( m_shmImage[b] );
+      if ( info->shmaddr != NULL && info->shmaddr != ( char * ) -1 )
+        shmdt ( info->shmaddr );
+    }
+    else if ( m_shmImage[b] != NULL ) {
+      m_shmImage[b]->data = NULL;
+      XDestroyImage ( m_shmImage[b] );
+    }
+    delete info;
+    m_shmImage[b] = NULL;
+    m_shmInfo[b] = NULL;
+    m_shmPending[b] = false;
+  }
+#endif
+  m_shmEnabled = false;
+}
+
+/*!
+  Get the image the conversion of the current frame has to write into :
+  the back shared memory buffer on the MIT-SHM path (waiting first for the
+  server to be done reading it), the classic XImage otherwise.
+*/
+XImage *vpDisplayX::workImage()
+{
+#ifdef VISP_HAVE_XSHM
+  if ( m_shmEnabled ) {
+    waitShmCompletion ( m_shmBack );
+    return m_shmImage[m_shmBack];
+  }
+#endif
+  return Ximage;
+}
+
+/*!
+  Index of the buffer workImage() returns, used to address its conversion
+  cache : 0 and 1 for the shared memory buffers, 2 for the classic XImage.
+*/
+int vpDisplayX::workBufferIndex() const
+{
+#ifdef VISP_HAVE_XSHM
+  if ( m_shmEnabled )
+    return m_shmBack;
+#endif
+  return 2;
+}
+
+/*!
+  Drop the grayscale conversion caches, after a destination buffer or the
+  pixmap received content through another path.
+*/
+void vpDisplayX::invalidateConversionCache()
+{
+  for ( int b = 0; b < 3; b ++ )
+    m_rowHash[b].clear();
+  m_pushedRowHash.clear();
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//64 bit FNV-1a of a pixel row, 8 bytes at a time
+static unsigned long long vpDisplayXRowHash ( const unsigned char *row, unsigned int size )
+{
+  unsigned long long h = 14695981039346656037ull;
+  unsigned int i = 0;
+  for ( ; i + 8 <= size; i += 8 ) {
+    unsigned long long chunk;
+    memcpy ( &chunk, row + i, 8 );
+    h = ( h ^ chunk ) * 1099511628211ull;
+  }
+  for ( ; i < size; i ++ )
+    h = ( h ^ row[i] ) * 1099511628211ull;
+  return h;
+}
+#endif
+
+/*!
+  Push only the rows [firstRow, firstRow+nbRows) of the image prepared in
+  workImage() into the pixmap, see pushImage().
+*/
+void vpDisplayX::pushImageBand ( const unsigned int &firstRow, const unsigned int &nbRows )
+{
+#ifdef VISP_HAVE_XSHM
+  if ( m_shmEnabled ) {
+    XShmPutImage ( display, pixmap, context, m_shmImage[m_shmBack],
+                   0, (int)firstRow, 0, (int)firstRow, width, nbRows, True );
+    m_shmPending[m_shmBack] = true;
+    XSetWindowBackgroundPixmap ( display, window, pixmap );
+    XFlush ( display );
+    m_shmBack = 1 - m_shmBack;
+    return;
+  }
+#endif
+  XPutImage ( display, pixmap, context, Ximage, 0, (int)firstRow, 0, (int)firstRow, width, nbRows );
+  XSetWindowBackgroundPixmap ( display, window, pixmap );
+}
+
+/*!
+  Wait until the server finished reading the given shared memory buffer,
+  draining the ShmCompletion events.
+*/
+void vpDisplayX::waitShmCompletion ( const int &buffer )
+{
+#ifdef VISP_HAVE_XSHM
+  if ( !m_shmPending[buffer] )
+    return;
+
+  XEvent xevent;
+  while ( m_shmPending[buffer] ) {
+    if ( XCheckTypedEvent ( display, m_shmCompletionType, &xevent ) ) {
+      XShmCompletionEvent *completion = ( XShmCompletionEvent * ) &xevent;
+      for ( int b = 0; b < 2; b ++ ) {
+        XShmSegmentInfo *info = ( XShmSegmentInfo * ) m_shmInfo[b];
+        if ( info != NULL && completion->shmseg == info->shmseg )
+          m_shmPending[b] = false;
+      }
+    }
+    else {
+      //No event yet : let the server catch up, then consider the
+      //round trip as the completion barrier
+      XSync ( display, False );
+      if ( !XCheckTypedEvent ( display, m_shmCompletionType, &xevent ) ) {
+        m_shmPending[0] = m_shmPending[1] = false;
+        break;
+      }
+      XShmCompletionEvent *completion = ( XShmCompletionEvent * ) &xevent;
+      for ( int b = 0; b < 2; b ++ ) {
+        XShmSegmentInfo *info = ( XShmSegmentInfo * ) m_shmInfo[b];
+        if ( info != NULL && completion->shmseg == info->shmseg )
+          m_shmPending[b] = false;
+      }
+    }
+  }
+#else
+  ( void ) buffer;
+#endif
+}
+
+/*!
+  Push the image prepared in workImage() into the pixmap : asynchronously
+  through XShmPutImage() on the MIT-SHM path, with the buffers flipped so
+  that the next conversion overlaps the display, through XPutImage()
+  otherwise.
+*/
+void vpDisplayX::pushImage()
+{
+#ifdef VISP_HAVE_XSHM
+  if ( m_shmEnabled ) {
+    XShmPutImage ( display, pixmap, context, m_shmImage[m_shmBack],
+                   0, 0, 0, 0, width, height, True );
+    m_shmPending[m_shmBack] = true;
+    XSetWindowBackgroundPixmap ( display, window, pixmap );
+    XFlush ( display );
+    m_shmBack = 1 - m_shmBack;
+    return;
+  }
+#endif
+  XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
+  XSetWindowBackgroundPixmap ( display, window, pixmap );
+}
+
 /*!
   Display the gray level image \e I (8bits).
 
@@ -1670,8 +1956,10 @@ void vpDisplayX::displayImage ( const vpImage<unsigned char> &I )
     {
       unsigned char       *src_8  = NULL;
       unsigned char       *dst_8  = NULL;
+      invalidateConversionCache();
+      XImage *xim = workImage();
       src_8 = ( unsigned char * ) I.bitmap;
-      dst_8 = ( unsigned char * ) Ximage->data;
+      dst_8 = ( unsigned char * ) xim->data;
       // Correction de l'image de facon a liberer les niveaux de gris
       // ROUGE, VERT, BLEU, JAUNE
       {
@@ -1691,18 +1979,19 @@ void vpDisplayX::displayImage ( const vpImage<unsigned char> &I )
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
-      XSetWindowBackgroundPixmap ( display, window, pixmap );
+      pushImage();
       //        XClearWindow ( display, window );
       //        XSync ( display,1 );
       break;
     }
     case 16:
     {
-      unsigned short *dst_16 = ( unsigned short* ) Ximage->data;
-      unsigned int bytes_per_line = (unsigned int)Ximage->bytes_per_line;
+      invalidateConversionCache();
+      XImage *xim = workImage();
+      unsigned short *dst_16 = ( unsigned short* ) xim->data;
+      unsigned int bytes_per_line = (unsigned int)xim->bytes_per_line;
       for ( unsigned int i = 0; i < height ; i++ ) {
-        unsigned char  *dst_8 =  (unsigned char*) Ximage->data + i * bytes_per_line;
+        unsigned char  *dst_8 =  (unsigned char*) xim->data + i * bytes_per_line;
         dst_16 = (unsigned short *) dst_8;
         for ( unsigned int j=0 ; j < width; j++ )
         {
@@ -1711,8 +2000,7 @@ void vpDisplayX::displayImage ( const vpImage<unsigned char> &I )
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
-      XSetWindowBackgroundPixmap ( display, window, pixmap );
+      pushImage();
       //        XClearWindow ( display, window );
       //        XSync ( display,1 );
       break;
@@ -1721,24 +2009,62 @@ void vpDisplayX::displayImage ( const vpImage<unsigned char> &I )
     case 24:
     default:
     {
-      unsigned char       *dst_32 = NULL;
-      unsigned int size_ = width * height ;
-      dst_32 = ( unsigned char* ) Ximage->data;
-      unsigned char *bitmap = I.bitmap ;
-      unsigned char *n = I.bitmap + size_;
-      //for (unsigned int i = 0; i < size; i++) // suppression de l'iterateur i
-      while ( bitmap < n )
+      XImage *xim = workImage();
+      int buf = workBufferIndex();
+
+      //Per row checksums : only the rows that changed since the last
+      //conversion into this buffer are reconverted, and only the span
+      //that differs from the pixmap content is uploaded
+      bool bufCacheValid = ( m_rowHash[buf].size() == height );
+      if ( !bufCacheValid )
+        m_rowHash[buf].resize ( height );
+      bool pushedCacheValid = ( m_pushedRowHash.size() == height );
+      if ( !pushedCacheValid )
+        m_pushedRowHash.resize ( height );
+
+      int firstRow = -1, lastRow = -1;
+      unsigned int bytes_per_line = (unsigned int)xim->bytes_per_line;
+      for ( unsigned int i = 0; i < height; i ++ )
       {
-        unsigned char val = * ( bitmap++ );
-        * ( dst_32 ++ ) = val;  // Composante Rouge.
-        * ( dst_32 ++ ) = val;  // Composante Verte.
-        * ( dst_32 ++ ) = val;  // Composante Bleue.
-        * ( dst_32 ++ ) = val;
+        const unsigned char *src = I.bitmap + (size_t)i * width;
+        unsigned long long h = vpDisplayXRowHash ( src, width );
+
+        if ( !bufCacheValid || m_rowHash[buf][i] != h )
+        {
+          unsigned char *dst_32 = ( unsigned char* ) xim->data + (size_t)i * bytes_per_line;
+          for ( unsigned int j = 0; j < width; j ++ )
+          {
+            unsigned char val = src[j];
+            * ( dst_32 ++ ) = val;  // Composante Rouge.
+            * ( dst_32 ++ ) = val;  // Composante Verte.
+            * ( dst_32 ++ ) = val;  // Composante Bleue.
+            * ( dst_32 ++ ) = val;
+          }
+          m_rowHash[buf][i] = h;
+        }
+
+        if ( !pushedCacheValid || m_pushedRowHash[i] != h )
+        {
+          if ( firstRow < 0 ) firstRow = (int)i;
+          lastRow = (int)i;
+          m_pushedRowHash[i] = h;
+        }
       }
 
-      // Affichage de l'image dans la Pixmap.
-      XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
-      XSetWindowBackgroundPixmap ( display, window, pixmap );
+      //Overlays drew onto the pixmap : the whole background has to be
+      //restored whatever the changed span
+      if ( m_pixmapDirty )
+      {
+        firstRow = 0;
+        lastRow = (int)height - 1;
+      }
+
+      if ( firstRow >= 0 )
+      {
+        // Affichage de l'image dans la Pixmap.
+        pushImageBand ( (unsigned int)firstRow, (unsigned int)(lastRow - firstRow + 1) );
+        m_pixmapDirty = false;
+      }
       //        XClearWindow ( display, window );
       //        XSync ( display,1 );
       break;
@@ -1772,10 +2098,12 @@ void vpDisplayX::displayImage ( const vpImage<vpRGBa> &I )
     case 16: {
       vpRGBa* bitmap = I.bitmap;
       unsigned int r, g, b;
-      unsigned int bytes_per_line = (unsigned int)Ximage->bytes_per_line;
+      invalidateConversionCache();
+      XImage *xim = workImage();
+      unsigned int bytes_per_line = (unsigned int)xim->bytes_per_line;
 
       for ( unsigned int i = 0; i < height ; i++ ) {
-        unsigned char  *dst_8 =  (unsigned char*) Ximage->data + i * bytes_per_line;
+        unsigned char  *dst_8 =  (unsigned char*) xim->data + i * bytes_per_line;
         unsigned short *dst_16 = (unsigned short *) dst_8;
         for ( unsigned int j=0 ; j < width; j++ )
         {
@@ -1789,8 +2117,7 @@ void vpDisplayX::displayImage ( const vpImage<vpRGBa> &I )
         }
       }
 
-      XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
-      XSetWindowBackgroundPixmap ( display, window, pixmap );
+      pushImage();
 
       break;
     }
@@ -1801,7 +2128,8 @@ void vpDisplayX::displayImage ( const vpImage<vpRGBa> &I )
          * 32-bit source, 24/32-bit destination
          */
       unsigned char       *dst_32 = NULL;
-      dst_32 = ( unsigned char* ) Ximage->data;
+      invalidateConversionCache();
+      dst_32 = ( unsigned char* ) workImage()->data;
       vpRGBa* bitmap = I.bitmap;
       unsigned int sizeI = I.getWidth() * I.getHeight();
       if (XImageByteOrder(display) == 1) {
@@ -1825,8 +2153,7 @@ void vpDisplayX::displayImage ( const vpImage<vpRGBa> &I )
         }
       }
       // Affichage de l'image dans la Pixmap.
-      XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
-      XSetWindowBackgroundPixmap ( display, window, pixmap );
+      pushImage();
       //        XClearWindow ( display, window );
       //        XSync ( display,1 );
       break;
@@ -1863,7 +2190,8 @@ void vpDisplayX::displayImage ( const unsigned char *I )
 
   if ( displayHasBeenInitialized )
   {
-    unsigned char *dst_32 = ( unsigned char* ) Ximage->data;
+    invalidateConversionCache();
+    unsigned char *dst_32 = ( unsigned char* ) workImage()->data;
 
     for ( unsigned int i = 0; i < width * height; i++ )
     {
@@ -1875,8 +2203,7 @@ void vpDisplayX::displayImage ( const unsigned char *I )
     }
 
     // Affichage de l'image dans la Pixmap.
-    XPutImage ( display, pixmap, context, Ximage, 0, 0, 0, 0, width, height );
-    XSetWindowBackgroundPixmap ( display, window, pixmap );
+    pushImage();
     //    XClearWindow ( display, window );
     //    XSync ( display,1 );
   }
@@ -1909,6 +2236,7 @@ void vpDisplayX::displayImageROI ( const vpImage<unsigned char> &I, const vpImag
 {
   if ( displayHasBeenInitialized )
   {
+    invalidateConversionCache();
     switch ( screen_depth )
     {
     case 8:
@@ -2069,6 +2397,7 @@ void vpDisplayX::displayImageROI ( const vpImage<vpRGBa> &I,const vpImagePoint &
 {
   if ( displayHasBeenInitialized )
   {
+    invalidateConversionCache();
     switch ( screen_depth )
     {
     case 16: {
@@ -2180,6 +2509,8 @@ void vpDisplayX::displayImageROI ( const vpImage<vpRGBa> &I,const vpImagePoint &
 */
 void vpDisplayX::closeDisplay()
 {
+  teardownSHM();
+
   if ( displayHasBeenInitialized )
   {
     if ( ximage_data_init == true )
@@ -2255,6 +2586,7 @@ void vpDisplayX::flushDisplayROI(const vpImagePoint &iP, const unsigned int w, c
 */
 void vpDisplayX::clearDisplay ( const vpColor &color )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
 
@@ -2363,6 +2695,7 @@ void vpDisplayX::displayCharString ( const vpImagePoint &ip,
                                      const char *text,
                                      const vpColor &color )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if (color.id < vpColor::id_unknown)
@@ -2402,6 +2735,7 @@ void vpDisplayX::displayCircle ( const vpImagePoint &center,
                                  bool fill,
                                  unsigned int thickness )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if ( thickness == 1 ) thickness = 0;
@@ -2442,6 +2776,126 @@ void vpDisplayX::displayCircle ( const vpImagePoint &center,
   }
 }
 
+/*!
+  Set the drawing color of the graphic context, allocating it when it is
+  not one of the predefined colors.
+*/
+void vpDisplayX::setDrawColor ( const vpColor &color )
+{
+  if (color.id < vpColor::id_unknown)
+    XSetForeground ( display, context, x_color[color.id] );
+  else {
+    xcolor.pad   = 0;
+    xcolor.red   = 256 * color.R;
+    xcolor.green = 256 * color.G;
+    xcolor.blue  = 256 * color.B;
+    XAllocColor ( display, lut, &xcolor );
+    XSetForeground ( display, context, xcolor.pixel );
+  }
+}
+
+/*!
+  Draw a batch of overlay primitives : consecutive primitives sharing
+  their color and thickness are grouped into single XDrawSegments() /
+  XDrawPoints() requests, instead of one request plus one color and one
+  line attribute change per primitive.
+
+  \param primitives : Display list built between
+  vpDisplay::beginOverlayBatch() and vpDisplay::endOverlayBatch().
+*/
+void vpDisplayX::displayPrimitives ( const std::vector<vpOverlayPrimitive> &primitives )
+{
+  m_pixmapDirty = true;
+  if ( !displayHasBeenInitialized )
+  {
+    vpERROR_TRACE ( "X not initialized " ) ;
+    throw ( vpDisplayException ( vpDisplayException::notInitializedError,
+                                 "X not initialized" ) ) ;
+  }
+
+  std::vector<XSegment> segments;
+  std::vector<XPoint> points;
+  segments.reserve ( primitives.size() );
+
+  unsigned int i = 0;
+  while ( i < primitives.size() )
+  {
+    const vpColor &color = primitives[i].color;
+    unsigned int thickness = primitives[i].thickness;
+
+    segments.clear();
+    points.clear();
+
+    //Collect the run sharing color and thickness
+    unsigned int j = i;
+    for ( ; j < primitives.size(); j ++ )
+    {
+      const vpOverlayPrimitive &p = primitives[j];
+      if ( p.thickness != thickness
+           || p.color.id != color.id
+           || ( color.id >= vpColor::id_unknown
+                && ( p.color.R != color.R || p.color.G != color.G || p.color.B != color.B ) ) )
+        break;
+
+      XSegment seg;
+      switch ( p.type )
+      {
+      case vpDisplay::PRIMITIVE_POINT:
+      {
+        XPoint pt;
+        pt.x = (short) vpMath::round ( p.ip1.get_u() );
+        pt.y = (short) vpMath::round ( p.ip1.get_v() );
+        points.push_back ( pt );
+        break;
+      }
+      case vpDisplay::PRIMITIVE_LINE:
+        seg.x1 = (short) vpMath::round ( p.ip1.get_u() );
+        seg.y1 = (short) vpMath::round ( p.ip1.get_v() );
+        seg.x2 = (short) vpMath::round ( p.ip2.get_u() );
+        seg.y2 = (short) vpMath::round ( p.ip2.get_v() );
+        segments.push_back ( seg );
+        break;
+      case vpDisplay::PRIMITIVE_CROSS:
+      default:
+      {
+        //Same two strokes as displayCross()
+        double ci = p.ip1.get_i();
+        double cj = p.ip1.get_j();
+        vpImagePoint ip1, ip2;
+        ip1.set_i ( ci - p.size/2 ); ip1.set_j ( cj );
+        ip2.set_i ( ci + p.size/2 ); ip2.set_j ( cj );
+        seg.x1 = (short) vpMath::round ( ip1.get_u() );
+        seg.y1 = (short) vpMath::round ( ip1.get_v() );
+        seg.x2 = (short) vpMath::round ( ip2.get_u() );
+        seg.y2 = (short) vpMath::round ( ip2.get_v() );
+        segments.push_back ( seg );
+        ip1.set_i ( ci ); ip1.set_j ( cj - p.size/2 );
+        ip2.set_i ( ci ); ip2.set_j ( cj + p.size/2 );
+        seg.x1 = (short) vpMath::round ( ip1.get_u() );
+        seg.y1 = (short) vpMath::round ( ip1.get_v() );
+        seg.x2 = (short) vpMath::round ( ip2.get_u() );
+        seg.y2 = (short) vpMath::round ( ip2.get_v() );
+        segments.push_back ( seg );
+        break;
+      }
+      }
+    }
+
+    setDrawColor ( color );
+    if ( !segments.empty() )
+    {
+      XSetLineAttributes ( display, context, thickness == 1 ? 0 : thickness,
+                           LineSolid, CapButt, JoinBevel );
+      XDrawSegments ( display, pixmap, context, &segments[0], (int) segments.size() );
+    }
+    if ( !points.empty() )
+      XDrawPoints ( display, pixmap, context, &points[0], (int) points.size(),
+                    CoordModeOrigin );
+
+    i = j;
+  }
+}
+
 /*!
   Display a cross at the image point \e ip location.
   \param ip : Cross location.
@@ -2501,6 +2955,7 @@ void vpDisplayX::displayDotLine ( const vpImagePoint &ip1,
                                   const vpColor &color,
                                   unsigned int thickness )
 {
+  m_pixmapDirty = true;
 
   if ( displayHasBeenInitialized )
   {
@@ -2545,6 +3000,7 @@ void vpDisplayX::displayLine ( const vpImagePoint &ip1,
                                const vpColor &color,
                                unsigned int thickness )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if ( thickness == 1 ) thickness = 0;
@@ -2585,6 +3041,7 @@ void vpDisplayX::displayLine ( const vpImagePoint &ip1,
 void vpDisplayX::displayPoint ( const vpImagePoint &ip,
                                 const vpColor &color )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if (color.id < vpColor::id_unknown)
@@ -2629,6 +3086,7 @@ vpDisplayX::displayRectangle ( const vpImagePoint &topLeft,
                                const vpColor &color, bool fill,
                                unsigned int thickness )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if ( thickness == 1 ) thickness = 0;
@@ -2685,6 +3143,7 @@ vpDisplayX::displayRectangle ( const vpImagePoint &topLeft,
                                const vpColor &color, bool fill,
                                unsigned int thickness )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if ( thickness == 1 ) thickness = 0;
@@ -2745,6 +3204,7 @@ vpDisplayX::displayRectangle ( const vpRect &rectangle,
                                const vpColor &color, bool fill,
                                unsigned int thickness )
 {
+  m_pixmapDirty = true;
   if ( displayHasBeenInitialized )
   {
     if ( thickness == 1 ) thickness = 0;
@@ -39,6 +39,7 @@
 #if ( defined(VISP_HAVE_GDI) || defined(VISP_HAVE_D3D9) )
 
 #include <visp3/gui/vpDisplayWin32.h>
+#include <visp3/core/vpMath.h>
 #include <visp3/core/vpDisplayException.h>
 #include <string>
 
@@ -60,7 +61,8 @@ void vpCreateWindow(threadParam * param)
   Constructor.
 */
 vpDisplayWin32::vpDisplayWin32(vpWin32Renderer * rend) :
-  iStatus(false), window(rend)
+  iStatus(false), window(rend),
+  m_dirtyValid(false), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
 }
 
@@ -169,6 +171,8 @@ void vpDisplayWin32::init(unsigned int width, unsigned int height,
   iStatus = (hThread != (HANDLE)NULL);
 
   displayHasBeenInitialized = true;
+  //The first flush after init() has to paint whatever the window holds
+  markAllDirty();
 }
 
 
@@ -208,6 +212,7 @@ void vpDisplayWin32::displayImage(const vpImage<vpRGBa> &I)
 
   //sets the image to render
   window.renderer->setImg(I);
+  markAllDirty();
   //sends a message to the window
   //PostMessage(window.getHWnd(),vpWM_DISPLAY,0,0);
 }
@@ -237,6 +242,7 @@ void vpDisplayWin32::displayImageROI ( const vpImage<vpRGBa> &I,const vpImagePoi
 
   //sets the image to render
   window.renderer->setImgROI(I,iP,width,height);
+  markDirty(iP.get_u(), iP.get_v(), iP.get_u() + width - 1, iP.get_v() + height - 1);
   //sends a message to the window
   //PostMessage(window.getHWnd(),vpWM_DISPLAY,0,0);
 }
@@ -260,6 +266,7 @@ void vpDisplayWin32::displayImage(const vpImage<unsigned char> &I)
 
   //sets the image to render
   window.renderer->setImg(I);
+  markAllDirty();
   //sends a message to the window
   //PostMessage(window.getHWnd(), vpWM_DISPLAY, 0,0);
 }
@@ -288,6 +295,7 @@ void vpDisplayWin32::displayImageROI ( const vpImage<unsigned char> &I,const vpI
 
   //sets the image to render
   window.renderer->setImgROI(I,iP,width,height);
+  markDirty(iP.get_u(), iP.get_v(), iP.get_u() + width - 1, iP.get_v() + height - 1);
   //sends a message to the window
   //PostMessage(window.getHWnd(),vpWM_DISPLAY,0,0);
 }
@@ -657,6 +665,30 @@ void vpDisplayWin32::setFont(const std::string & /* fontname */)
 }
 
 
+//Grow the dirty region with an overlay primitive bounding box
+void vpDisplayWin32::markDirty(const double &left, const double &top, const double &right, const double &bottom)
+{
+  if (!m_dirtyValid) {
+    m_dirtyLeft = left;
+    m_dirtyTop = top;
+    m_dirtyRight = right;
+    m_dirtyBottom = bottom;
+    m_dirtyValid = true;
+  }
+  else {
+    if (left < m_dirtyLeft) m_dirtyLeft = left;
+    if (top < m_dirtyTop) m_dirtyTop = top;
+    if (right > m_dirtyRight) m_dirtyRight = right;
+    if (bottom > m_dirtyBottom) m_dirtyBottom = bottom;
+  }
+}
+
+//Mark the whole window as dirty
+void vpDisplayWin32::markAllDirty()
+{
+  markDirty(0, 0, (double)width - 1, (double)height - 1);
+}
+
 /*!
   \brief flush the Win32 buffer
   It's necessary to use this function to see the results of any drawing
@@ -667,8 +699,30 @@ void vpDisplayWin32::flushDisplay()
   //waits if the window is not initialized
   waitForInit();
 
-  //sends a message to the window
-  PostMessage(window.getHWnd(), vpWM_DISPLAY, 0,0);
+  if (!m_dirtyValid)
+    return; // nothing changed since the last flush
+
+  //Clamp the union to the window
+  double left = m_dirtyLeft < 0 ? 0 : m_dirtyLeft;
+  double top = m_dirtyTop < 0 ? 0 : m_dirtyTop;
+  double right = m_dirtyRight > (double)width - 1 ? (double)width - 1 : m_dirtyRight;
+  double bottom = m_dirtyBottom > (double)height - 1 ? (double)height - 1 : m_dirtyBottom;
+  m_dirtyValid = false;
+  if (right < left || bottom < top)
+    return;
+
+  //Updating a region is more expensive per pixel than the full window :
+  //only worth it when the union stays small
+  double regionArea = (right - left + 1) * (bottom - top + 1);
+  if (regionArea >= 0.5 * (double)width * (double)height) {
+    //sends a message to the window
+    PostMessage(window.getHWnd(), vpWM_DISPLAY, 0,0);
+    return;
+  }
+
+  WPARAM wp = MAKEWPARAM((WORD)left, (WORD)right);
+  LPARAM lp = MAKELPARAM((WORD)top, (WORD)bottom);
+  PostMessage(window.getHWnd(), vpWM_DISPLAY_ROI, wp, lp);
 }
 
 /*!
@@ -676,26 +730,13 @@ void vpDisplayWin32::flushDisplay()
   It's necessary to use this function to see the results of any drawing
 
 */
-void vpDisplayWin32::flushDisplayROI(const vpImagePoint &iP, const unsigned int width, const unsigned int height)
+void vpDisplayWin32::flushDisplayROI(const vpImagePoint &iP, const unsigned int w_, const unsigned int h_)
 {
-  //waits if the window is not initialized
-  waitForInit();
-  /*
-  Under windows, flushing an ROI takes more time than
-  flushing the whole image.
-  Therefore, we update the maximum area even when asked to update a region.
-  */
-  WORD left  = (WORD)iP.get_u();
-  WORD right = (WORD)(iP.get_u()+width-1);
-
-  WORD top    = (WORD)iP.get_v();
-  WORD bottom = (WORD)(iP.get_v()+height-1);
-
-  //sends a message to the window
-  WPARAM wp = MAKEWPARAM(left, right);
-  LPARAM lp = MAKELPARAM(top, bottom);
-
-  PostMessage(window.getHWnd(), vpWM_DISPLAY_ROI, wp,lp);
+  //The requested region joins the dirty union; flushDisplay() then pushes
+  //the union as one region, or the full window when it grew too large
+  //(under Windows updating a region costs more per pixel).
+  markDirty(iP.get_u(), iP.get_v(), iP.get_u() + w_ - 1, iP.get_v() + h_ - 1);
+  flushDisplay();
 }
 
 
@@ -710,6 +751,7 @@ void vpDisplayWin32::displayPoint(const vpImagePoint &ip,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->setPixel(ip, color);
+  markDirty(ip.get_u(), ip.get_v(), ip.get_u(), ip.get_v());
 }
 
 /*!
@@ -726,6 +768,10 @@ void vpDisplayWin32::displayLine( const vpImagePoint &ip1,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawLine(ip1, ip2, color, thickness);
+  markDirty(vpMath::minimum(ip1.get_u(), ip2.get_u()) - thickness,
+            vpMath::minimum(ip1.get_v(), ip2.get_v()) - thickness,
+            vpMath::maximum(ip1.get_u(), ip2.get_u()) + thickness,
+            vpMath::maximum(ip1.get_v(), ip2.get_v()) + thickness);
 }
 
 
@@ -746,6 +792,10 @@ void vpDisplayWin32::displayDotLine(const vpImagePoint &ip1,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawLine(ip1,ip2,color,thickness,PS_DASHDOT);
+  markDirty(vpMath::minimum(ip1.get_u(), ip2.get_u()) - thickness,
+            vpMath::minimum(ip1.get_v(), ip2.get_v()) - thickness,
+            vpMath::maximum(ip1.get_u(), ip2.get_u()) + thickness,
+            vpMath::maximum(ip1.get_v(), ip2.get_v()) + thickness);
 }
 
 /*!  
@@ -769,6 +819,8 @@ void vpDisplayWin32::displayRectangle( const vpImagePoint &topLeft,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawRect(topLeft,width,height,color, fill, thickness);
+  markDirty(topLeft.get_u() - thickness, topLeft.get_v() - thickness,
+            topLeft.get_u() + width + thickness, topLeft.get_v() + height + thickness);
 }
 
 
@@ -794,6 +846,8 @@ void vpDisplayWin32::displayRectangle( const vpImagePoint &topLeft,
   unsigned int width = static_cast<unsigned int>( bottomRight.get_j() - topLeft.get_j() );
   unsigned int height = static_cast<unsigned int>(bottomRight.get_i() - topLeft.get_i() );
   window.renderer->drawRect(topLeft,width,height,color, fill, thickness);
+  markDirty(topLeft.get_u() - thickness, topLeft.get_v() - thickness,
+            bottomRight.get_u() + thickness, bottomRight.get_v() + thickness);
 }
 
 /*!
@@ -820,6 +874,8 @@ void vpDisplayWin32::displayRectangle( const vpRect &rectangle,
                             static_cast<unsigned int>( rectangle.getWidth() ),
                             static_cast<unsigned int>( rectangle.getHeight() ),
 			                      color, fill, thickness);
+  markDirty(rectangle.getLeft() - thickness, rectangle.getTop() - thickness,
+            rectangle.getRight() + thickness, rectangle.getBottom() + thickness);
 }
 
 
@@ -841,6 +897,8 @@ void vpDisplayWin32::displayCircle(const vpImagePoint &center,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawCircle(center,radius,color,fill,thickness);
+  markDirty(center.get_u() - radius - thickness, center.get_v() - radius - thickness,
+            center.get_u() + radius + thickness, center.get_v() + radius + thickness);
 }
 
 /*!
@@ -856,6 +914,8 @@ void vpDisplayWin32::displayCharString(const vpImagePoint &ip,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawText(ip,text,color);
+  //The text extent is renderer dependent : stay conservative
+  markAllDirty();
 }
 
 /*!
@@ -873,6 +933,8 @@ void vpDisplayWin32::displayCross( const vpImagePoint &ip,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawCross(ip, size, color, thickness);
+  markDirty(ip.get_u() - size/2 - thickness, ip.get_v() - size/2 - thickness,
+            ip.get_u() + size/2 + thickness, ip.get_v() + size/2 + thickness);
 }
 
 
@@ -893,6 +955,10 @@ void vpDisplayWin32::displayArrow(const vpImagePoint &ip1,
   //wait if the window is not initialized
   waitForInit();
   window.renderer->drawArrow(ip1, ip2, color, w, h, thickness);
+  markDirty(vpMath::minimum(ip1.get_u(), ip2.get_u()) - (double)(w + thickness),
+            vpMath::minimum(ip1.get_v(), ip2.get_v()) - (double)(w + thickness),
+            vpMath::maximum(ip1.get_u(), ip2.get_u()) + (double)(w + thickness),
+            vpMath::maximum(ip1.get_v(), ip2.get_v()) + (double)(w + thickness));
 }
 
 
@@ -904,6 +970,7 @@ void vpDisplayWin32::clearDisplay(const vpColor &color){
   //wait if the window is not initialized
   waitForInit();
   window.renderer->clear(color);
+  markAllDirty();
 }
 
 
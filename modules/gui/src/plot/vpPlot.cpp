@@ -48,6 +48,7 @@
 #include <visp3/gui/vpDisplayD3D.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <fstream>
 #include <list>
@@ -60,7 +61,9 @@
 
 */
 vpPlot::vpPlot() : I(), display(NULL), graphNbr(1), graphList(NULL), margei(30), margej(40),
-  factori(1.f), factorj(1.)
+  factori(1.f), factorj(1.),
+  m_recordSlots(), m_recordSize(0), m_recordHead(0), m_recordTail(0),
+  m_recordDropped(0), m_renderThread(NULL), m_renderRunning(false), m_renderPeriodMs(40.)
 {
 }
 /*!
@@ -83,7 +86,9 @@ vpPlot::vpPlot(const unsigned int graph_nbr,
 	       const unsigned int height, const unsigned int width, 
          const int x, const int y, const std::string &title)
   : I(), display(NULL), graphNbr(1), graphList(NULL), margei(30), margej(40),
-    factori(1.f), factorj(1.)
+    factori(1.f), factorj(1.),
+    m_recordSlots(), m_recordSize(0), m_recordHead(0), m_recordTail(0),
+    m_recordDropped(0), m_renderThread(NULL), m_renderRunning(false), m_renderPeriodMs(40.)
 {  
   init(graph_nbr, height, width, x, y, title);
 }
@@ -133,6 +138,7 @@ void vpPlot::init(const unsigned int graph_nbr,
 */
 vpPlot::~vpPlot()
 {
+  stopRecordingDisplay();
   if (graphList != NULL)
   {
     delete[] graphList;
@@ -573,6 +579,159 @@ vpPlot::setThickness (const unsigned int graphNum, const unsigned int curveNum,
   (graphList+graphNum)->setCurveThickness(curveNum, thickness);
 }
 
+/*!
+  Bound the number of points stored by every curve of a graph : once the
+  bound is reached the oldest point leaves for each new one and the
+  replots render a per pixel column min/max envelope, so that memory and
+  rendering cost stay constant however long the session.
+
+  \param graphNum : Number of the graph.
+  \param maxPoints : Bound on the stored points per curve; 0 restores the
+  unbounded historic behavior.
+*/
+void vpPlot::setMaxBufferSize (const unsigned int graphNum, const unsigned int maxPoints)
+{
+  (graphList+graphNum)->setMaxBufferSize(maxPoints);
+}
+
+/*!
+  Prepare the wait-free sample exchange : a high rate producer thread
+  (typically a control loop) record()s samples in constant time without
+  touching the display, and either flushRecorded() or the thread started
+  by startRecordingDisplay() drains them into the curves at display rate.
+
+  \warning To be called before the producer thread starts (or while it
+  is known quiet) : the ring is reallocated here.
+
+  \param capacity : Number of samples the ring can hold; sized so that
+  the ring covers at least one display period of production (e.g. 1 kHz
+  producer and 25 Hz display need 40 samples per recorded curve).
+*/
+void vpPlot::initRecording (const unsigned int &capacity)
+{
+  stopRecordingDisplay();
+  m_recordSize = (capacity < 1 ? 2 : capacity + 1);
+  m_recordSlots.resize(m_recordSize);
+  m_recordHead = 0;
+  m_recordTail = 0;
+  m_recordDropped = 0;
+}
+
+/*!
+  Append a sample to the recording ring, in constant time and without
+  ever blocking : safe to call from a real-time thread. The sample is
+  drawn later by flushRecorded() or by the startRecordingDisplay()
+  thread. A single producer thread is assumed, as with vpFrameQueue.
+
+  \param graphNum : The index of the graph in the window.
+  \param curveNum : The index of the curve in the graph.
+  \param x,y : Coordinates of the new point, in the user unit system.
+
+  \return True if the sample entered the ring, false if it was dropped
+  because the consumer lags by the whole capacity (counted in
+  getRecordingNbDropped()).
+*/
+bool vpPlot::record (const unsigned int graphNum, const unsigned int curveNum, const double x, const double y)
+{
+  if (m_recordSize == 0)
+    return false;
+
+  unsigned int head = m_recordHead;
+  unsigned int next = (head + 1) % m_recordSize;
+  if (next == m_recordTail) {
+    m_recordDropped++;
+    return false;
+  }
+  m_recordSlots[head].graphNum = graphNum;
+  m_recordSlots[head].curveNum = curveNum;
+  m_recordSlots[head].x = x;
+  m_recordSlots[head].y = y;
+  memoryBarrier();
+  m_recordHead = next;
+  return true;
+}
+
+/*!
+  Drain the recording ring and draw every pending sample, in recording
+  order. To be called from the thread owning the display, at display
+  rate; startRecordingDisplay() runs it for you.
+
+  \return The number of samples drawn.
+*/
+unsigned int vpPlot::flushRecorded ()
+{
+  unsigned int nbFlushed = 0;
+  if (m_recordSize == 0)
+    return nbFlushed;
+
+  unsigned int head = m_recordHead; // snapshot of the published samples
+  unsigned int tail = m_recordTail;
+  while (tail != head) {
+    memoryBarrier();
+    const vpPlotSample &sample = m_recordSlots[tail];
+    this->plot(sample.graphNum, sample.curveNum, sample.x, sample.y);
+    memoryBarrier();
+    tail = (tail + 1) % m_recordSize;
+    m_recordTail = tail;
+    nbFlushed++;
+  }
+  return nbFlushed;
+}
+
+/*!
+  Render thread : drains the recording ring at display rate.
+*/
+vpThread::Return vpPlot::renderLoop (vpThread::Args args)
+{
+  vpPlot *self = (vpPlot *)args;
+  while (self->m_renderRunning) {
+    self->flushRecorded();
+    vpTime::wait(self->m_renderPeriodMs);
+  }
+  return 0;
+}
+
+/*!
+  Start a thread draining the recording ring at display rate, so that
+  record() is the only interaction the producer ever has with the
+  plotter. The thread owns the drawing from now on : do not call plot()
+  or flushRecorded() from an other thread while it runs.
+
+  \param periodMs : Refresh period of the render thread, in ms.
+*/
+void vpPlot::startRecordingDisplay (const double &periodMs)
+{
+  if (m_renderThread != NULL)
+    return;
+  m_renderPeriodMs = periodMs;
+  m_renderRunning = true;
+  m_renderThread = new vpThread(renderLoop, (vpThread::Args)this);
+}
+
+/*!
+  Stop the thread started by startRecordingDisplay(), after a last drain
+  of the ring. Pending samples recorded after this call stay in the ring
+  for flushRecorded().
+*/
+void vpPlot::stopRecordingDisplay ()
+{
+  if (m_renderThread == NULL)
+    return;
+  m_renderRunning = false;
+  delete m_renderThread; // joins
+  m_renderThread = NULL;
+  flushRecorded();
+}
+
+void vpPlot::memoryBarrier()
+{
+#if defined(_WIN32)
+  MemoryBarrier();
+#else
+  __sync_synchronize();
+#endif
+}
+
 /*!
 This function enables you to choose the thickness used to draw all the curves belonging to a given graphic.
 
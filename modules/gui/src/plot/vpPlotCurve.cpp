@@ -35,6 +35,8 @@
  *
  *****************************************************************************/
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpMath.h>
+#include <vector>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
@@ -48,7 +50,8 @@
 #if defined(VISP_HAVE_DISPLAY)
 vpPlotCurve::vpPlotCurve() :
   color(vpColor::red), curveStyle(point), thickness(1), nbPoint(0), lastPoint(),
-  pointListx(), pointListy(), pointListz(), legend(), xmin(0), xmax(0), ymin(0), ymax(0)
+  pointListx(), pointListy(), pointListz(), legend(), xmin(0), xmax(0), ymin(0), ymax(0),
+  maxBufferSize(0)
 {
 }
 
@@ -84,11 +87,49 @@ vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP,
   pointListx.push_back(x);
   pointListy.push_back(y);
   pointListz.push_back(0.0);
+  trimBuffer();
+}
+
+//Ring buffer semantics : the oldest points leave once the bound is reached
+void
+vpPlotCurve::trimBuffer()
+{
+  if (maxBufferSize == 0)
+    return;
+  while (nbPoint > maxBufferSize) {
+    pointListx.pop_front();
+    pointListy.pop_front();
+    pointListz.pop_front();
+    nbPoint--;
+  }
+}
+
+/*!
+  Bound the number of stored points of the curve : once \e maxPoints are
+  stored the oldest point is discarded for each new one, so hours-long
+  sessions keep both the memory and the replot cost constant.
+
+  \param maxPoints : Bound on the stored points; 0 restores the unbounded
+  historic behavior.
+*/
+void
+vpPlotCurve::setMaxBufferSize(const unsigned int &maxPoints)
+{
+  maxBufferSize = maxPoints;
+  trimBuffer();
 }
 
 void 
 vpPlotCurve::plotList(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx, const double zoomy)
 {
+  //Above two points per pixel column the per point lines cannot be told
+  //apart : render the min/max envelope per column instead, so that the
+  //replot cost depends on the window width and not on the sample count.
+  if (nbPoint > 2 * I.getWidth()) {
+    plotListDecimated(I, xorg, yorg, zoomx, zoomy);
+    return;
+  }
+
   std::list<double>::const_iterator it_ptListx = pointListx.begin();
   std::list<double>::const_iterator it_ptListy = pointListy.begin();
   
@@ -109,6 +150,88 @@ vpPlotCurve::plotList(const vpImage<unsigned char> &I, const double xorg, const
   }
 }
 
+//Per pixel column accumulator of the decimated rendering
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct vpPlotColumnRange
+{
+  bool used;
+  double vMin;
+  double vMax;
+  double vFirst;
+  double vLast;
+};
+#endif
+
+void
+vpPlotCurve::plotListDecimated(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx, const double zoomy)
+{
+  std::list<double>::const_iterator it_ptListx = pointListx.begin();
+  std::list<double>::const_iterator it_ptListy = pointListy.begin();
+
+  //Columns outside the image would be clipped by the display anyway :
+  //clamping them bounds the accumulator to the image width
+  const int colLow = -1;
+  const int colHigh = (int)I.getWidth();
+
+  //First pass : the column span of the curve
+  int colMin = 0, colMax = -1;
+  for (unsigned int k = 0; k < nbPoint; k++, ++it_ptListx) {
+    int col = vpMath::round(xorg + zoomx * (*it_ptListx));
+    if (col < colLow) col = colLow;
+    if (col > colHigh) col = colHigh;
+    if (colMax < colMin) { colMin = colMax = col; }
+    else {
+      if (col < colMin) colMin = col;
+      if (col > colMax) colMax = col;
+    }
+  }
+  if (colMax < colMin)
+    return;
+
+  //Second pass : min/max envelope and first/last sample per column
+  std::vector<vpPlotColumnRange> columns((size_t)(colMax - colMin + 1));
+  for (size_t c = 0; c < columns.size(); c++)
+    columns[c].used = false;
+
+  it_ptListx = pointListx.begin();
+  for (unsigned int k = 0; k < nbPoint; k++, ++it_ptListx, ++it_ptListy) {
+    int col = vpMath::round(xorg + zoomx * (*it_ptListx));
+    if (col < colLow) col = colLow;
+    if (col > colHigh) col = colHigh;
+    double v = yorg - zoomy * (*it_ptListy);
+    vpPlotColumnRange &range = columns[(size_t)(col - colMin)];
+    if (!range.used) {
+      range.used = true;
+      range.vMin = range.vMax = range.vFirst = range.vLast = v;
+    }
+    else {
+      if (v < range.vMin) range.vMin = v;
+      if (v > range.vMax) range.vMax = v;
+      range.vLast = v;
+    }
+  }
+
+  //One vertical segment per column plus the connector to the next one
+  bool hasPrev = false;
+  int prevCol = 0;
+  double prevLast = 0.;
+  for (size_t c = 0; c < columns.size(); c++) {
+    if (!columns[c].used)
+      continue;
+    int col = colMin + (int)c;
+    if (columns[c].vMax > columns[c].vMin)
+      vpDisplay::displayLine(I, vpImagePoint(columns[c].vMin, col),
+                             vpImagePoint(columns[c].vMax, col), color, thickness);
+    if (hasPrev)
+      vpDisplay::displayLine(I, vpImagePoint(prevLast, prevCol),
+                             vpImagePoint(columns[c].vFirst, col), color, thickness);
+    hasPrev = true;
+    prevCol = col;
+    prevLast = columns[c].vLast;
+    lastPoint.set_ij(columns[c].vLast, col);
+  }
+}
+
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning: libvisp_core.a(vpPlotCurve.cpp.o) has no symbols
 void dummy_vpPlotCurve() {};
@@ -262,6 +262,17 @@ vpPlotGraph::setLegend (const unsigned int curveNum, const std::string &newlegen
   dispLegend = true;
 }
 
+/*!
+  Bound the number of points stored by every curve of the graph, see
+  vpPlotCurve::setMaxBufferSize().
+*/
+void
+vpPlotGraph::setMaxBufferSize (const unsigned int &maxPoints)
+{
+  for (unsigned int i = 0; i < curveNbr; i++)
+    (curveList+i)->setMaxBufferSize(maxPoints);
+}
+
 void 
 vpPlotGraph::setCurveThickness(const unsigned int curveNum, const unsigned int thickness)
 {
@@ -590,8 +601,10 @@ vpPlotGraph::replot (vpImage<unsigned char> &I)
 {
   clearGraphZone(I);
   displayGrid(I);
+  vpDisplay::beginOverlayBatch(I);
   for (unsigned int i = 0; i < curveNbr; i++)
     (curveList+i)->plotList(I,xorg,yorg,zoomx,zoomy);
+  vpDisplay::endOverlayBatch(I);
   vpDisplay::flushROI(I,graphZone);
 }
 
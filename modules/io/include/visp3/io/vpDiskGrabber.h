@@ -44,6 +44,7 @@
 #define vpDiskGrabber_hh
 
 #include <visp3/io/vpImageIo.h>
+#include <visp3/core/vpThread.h>
 #include <visp3/core/vpFrameGrabber.h>
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpDebug.h>
@@ -117,6 +118,27 @@ private:
   bool useGenericName;
   char genericName[FILENAME_MAX];
 
+  //!Double-buffered prefetch state, see setPrefetch(): one frame loaded
+  //!ahead by a background thread while the caller processes the current one
+  bool m_prefetchEnabled;
+  vpImage<unsigned char> m_prefetchGray;
+  vpImage<vpRGBa> m_prefetchColor;
+  //!0: none, 1: grayscale, 2: color, fixed by the first prefetched acquire
+  int m_prefetchType;
+  volatile bool m_prefetchReady;  //!< written only by the reader thread
+  volatile bool m_prefetchWanted; //!< written only by the caller
+  volatile bool m_prefetchRun;
+  volatile bool m_prefetchFailed;
+  //!Cursor of the reader thread, so that image_number keeps reporting the
+  //!consumer position as with the synchronous reads
+  long m_prefetchNumber;
+  //!Number of the frame currently in the ready buffer
+  long m_prefetchLoadedNumber;
+  vpThread *m_prefetchThread;
+
+  void startPrefetch(int type);
+  void stopPrefetch();
+
 public:
   vpDiskGrabber();
   vpDiskGrabber(const char *genericName);
@@ -146,6 +168,12 @@ public:
   void setExtension(const char *ext);
   void setGenericName(const char *genericName);
 
+  void setPrefetch(bool enable);
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  //! Entry point of the background reader thread, not meant to be called directly.
+  void runPrefetchThread();
+#endif
+
   /*!
     Return the current image number.
   */
@@ -165,6 +165,8 @@ class VISP_EXPORT vpFFMPEG
     AVFrame *pFrameGRAY;
     AVPacket *packet;
     SwsContext *img_convert_ctx  ;
+    //! Decoder thread count requested before openStream(), 0 for the codec default
+    unsigned int m_decoderThreads ;
     unsigned int videoStream;
     int numBytes ;
     uint8_t * buffer ;
@@ -243,6 +245,17 @@ class VISP_EXPORT vpFFMPEG
 #endif
     bool openStream(const char *filename,vpFFMPEGColorType color_type);
 
+    /*!
+      Set the number of decoder threads used by openStream(): frame
+      threading is requested (with slice threading as codec fallback), so a
+      multi-core machine decodes several frames concurrently instead of the
+      codec's default single threaded decode. Has to be called before
+      openStream().
+
+      \param nb : Number of threads; 0 (default) keeps the codec default.
+    */
+    void setDecoderThreads(unsigned int nb) { m_decoderThreads = nb; }
+
     bool saveFrame(vpImage<vpRGBa> &I);
     bool saveFrame(vpImage<unsigned char> &I);
     /*!
@@ -123,6 +123,8 @@ private:
   } vpImageFormatType;
   
   static const int vpMAX_LEN;
+  //! PNG compression level applied by writePNG(), -1 for the library default
+  static int s_pngCompressionLevel;
 
   static FILE * openFileRead(const char *filename) ;
   static FILE * openFileWrite(const char *filename, const char *mode="w") ;
@@ -132,10 +134,21 @@ private:
 			      const std::string mode="w") ;
 
   static vpImageFormatType getFormat(const char *filename) ;
+
   static std::string getExtension(const std::string &filename);
 
 public:
 
+  /*!
+    Set the zlib compression level used when writing PNG images: 0-1 favor
+    speed (several times faster encodes), 9 favors size, -1 (the default)
+    keeps the library default. Applies to every subsequent writePNG().
+
+    \param level : Compression level in [0, 9], or -1 for the default.
+  */
+  static void setPNGCompressionLevel(int level) { s_pngCompressionLevel = level; }
+
+
   static
   void read(vpImage<unsigned char> &I, const char *filename) ;
   static
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Raw uncompressed sequence container, memory mapped at reading.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpRawSequence_h__
+#define __vpRawSequence_h__
+
+/*!
+  \file vpRawSequence.h
+  \brief Raw uncompressed sequence container, memory mapped at reading.
+*/
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+#include <cstdio>
+
+/*!
+  \class vpRawSequence
+  \ingroup group_io_video
+
+  \brief ViSP-native raw sequence container (".vraw"): one file holding
+  uncompressed frames of a fixed geometry behind a small header, so that
+  reading a frame costs no decoding at all. The reader maps the file read
+  only; getFrame() is then a single copy from the mapped pages and
+  getFrameRef() no copy at all (the image aliases the mapping), which gives
+  the deterministic zero-decode replay needed to benchmark the trackers.
+  vpVideoWriter writes the format and vpVideoReader replays it through
+  their usual interfaces.
+*/
+class VISP_EXPORT vpRawSequence
+{
+public:
+  typedef enum {
+    TYPE_NONE = 0,
+    TYPE_GRAY = 1, /*!< 8 bits per pixel. */
+    TYPE_RGBA = 2  /*!< 32 bits vpRGBa per pixel. */
+  } vpFrameType;
+
+  vpRawSequence();
+  ~vpRawSequence();
+
+  // Writing
+  void openWriting(const char *filename);
+  void writeFrame(const vpImage<unsigned char> &I);
+  void writeFrame(const vpImage<vpRGBa> &I);
+
+  // Reading
+  void openReading(const char *filename);
+  void getFrame(vpImage<unsigned char> &I, long index) const;
+  void getFrame(vpImage<vpRGBa> &I, long index) const;
+  void getFrameRef(vpImage<unsigned char> &I, long index) const;
+  void getFrameRef(vpImage<vpRGBa> &I, long index) const;
+
+  void close();
+
+  //! Get the number of frames of an opened sequence.
+  long getFrameCount() const { return m_frameCount; }
+  //! Get the frame width of an opened sequence.
+  unsigned int getWidth() const { return m_width; }
+  //! Get the frame height of an opened sequence.
+  unsigned int getHeight() const { return m_height; }
+  //! Get the pixel type of an opened sequence.
+  vpFrameType getType() const { return (vpFrameType) m_type; }
+
+private:
+  // The mapping and the file handle are owned: copying would double-close.
+  vpRawSequence(const vpRawSequence &);
+  vpRawSequence &operator=(const vpRawSequence &);
+
+  const unsigned char *framePtr(long index) const;
+  void checkFrame(long index, int type) const;
+
+  FILE *m_file;            //!< writing handle
+  unsigned char *m_map;    //!< read-only mapping (or heap fallback)
+  size_t m_mapLength;
+  bool m_mapped;           //!< true when m_map comes from mmap
+  int m_type;
+  unsigned int m_width;
+  unsigned int m_height;
+  long m_frameCount;
+  size_t m_frameSize;      //!< bytes per frame
+};
+
+#endif
@@ -47,6 +47,8 @@
 #include <string>
 
 #include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpRawSequence.h>
+#include <visp3/core/vpThread.h>
 #include <visp3/io/vpFFMPEG.h>
 
 #if VISP_HAVE_OPENCV_VERSION >= 0x020200
@@ -155,6 +157,16 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
   private:
     //!To read sequences of images
     vpDiskGrabber *imSequence;
+    //!To read ViSP raw sequence containers (".vraw")
+    vpRawSequence *rawSeq;
+    //!Next frame the sequential acquire() will serve from the raw container
+    long rawNextIndex;
+    //!One-time directory index of the image sequence, see buildSequenceIndex()
+    bool m_seqIndexValid;
+    long m_seqIndexFirst;
+    long m_seqIndexLast;
+
+    bool buildSequenceIndex();
 #ifdef VISP_HAVE_FFMPEG
     //!To read video files
     vpFFMPEG *ffmpeg;
@@ -186,6 +198,8 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
       FORMAT_WMV,
       FORMAT_FLV,
       FORMAT_MKV,
+      // ViSP raw sequence container
+      FORMAT_RAW,
       FORMAT_UNKNOWN
     } vpVideoFormatType;
     
@@ -207,6 +221,22 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
     bool firstFrameIndexIsSet;
     bool lastFrameIndexIsSet;
 
+    //!Prefetch state, see setPrefetch(): bounded ring of decoded frames
+    //!filled by a background thread (image sequence backend only)
+    unsigned int m_prefetchCapacity;
+    std::vector<vpImage<unsigned char> > m_prefetchGray;
+    std::vector<vpImage<vpRGBa> > m_prefetchColor;
+    //!0: unset, 1: grayscale, 2: color, fixed by the first prefetched acquire
+    int m_prefetchType;
+    volatile unsigned int m_prefetchHead;  //!< written only by the decode thread
+    volatile unsigned int m_prefetchTail;  //!< written only by the caller
+    volatile bool m_prefetchRun;
+    volatile bool m_prefetchEos;
+    vpThread *m_prefetchThread;
+
+    void startPrefetch(int type);
+    void stopPrefetch();
+
 //private:
 //#ifndef DOXYGEN_SHOULD_SKIP_THIS
 //    vpVideoReader(const vpVideoReader &)
@@ -244,6 +274,13 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
       return false;
     }
     bool getFrame(vpImage<vpRGBa> &I, long frame);
+
+    void setPrefetch(unsigned int nbFrames);
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    //! Entry point of the background decode thread, not meant to be called directly.
+    void runPrefetchThread();
+#endif
+
     bool getFrame(vpImage<unsigned char> &I, long frame);
     double getFramerate();
 
@@ -293,6 +330,7 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
       \sa setLastFrameIndex()
     */
     inline void setFirstFrameIndex(const long first_frame) {
+      stopPrefetch(); //a seek invalidates the frames read ahead
       this->firstFrameIndexIsSet = true;
       this->firstFrame = first_frame;
     }
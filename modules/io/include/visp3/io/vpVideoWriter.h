@@ -46,6 +46,9 @@
 #include <string>
 
 #include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpRawSequence.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpMutex.h>
 #include <visp3/io/vpFFMPEG.h>
 
 #if VISP_HAVE_OPENCV_VERSION >= 0x020200
@@ -174,11 +177,37 @@ class VISP_EXPORT vpVideoWriter
       FORMAT_MPEG,
       FORMAT_MPEG4,
       FORMAT_MOV,
+      FORMAT_RAW,
       FORMAT_UNKNOWN
     } vpVideoFormatType;
     
     //!Video's format which has to be writen
     vpVideoFormatType formatType;
+    //!To write ViSP raw sequence containers (".vraw")
+    vpRawSequence *rawSeq;
+
+    //!Asynchronous encoding state, see setAsyncEncoding(): bounded frame
+    //!queue consumed by a background encoder thread
+    bool m_asyncEnabled;
+    unsigned int m_asyncCapacity;
+    int m_asyncPolicy;
+    //!0: unset, 1: grayscale, 2: color, fixed by the first queued frame
+    int m_asyncType;
+    std::vector<vpImage<unsigned char> > m_asyncGray;
+    std::vector<vpImage<vpRGBa> > m_asyncColor;
+    std::vector<long> m_asyncIndex;
+    unsigned int m_asyncCount;   //!< frames currently queued
+    unsigned int m_asyncFirst;   //!< index of the oldest queued frame
+    volatile unsigned int m_asyncErrors;
+    volatile bool m_asyncRun;
+    volatile bool m_asyncBusy;   //!< true while the thread encodes a frame
+    vpMutex m_asyncMutex;
+    vpThread *m_asyncThread;
+
+    void startAsync(int type);
+    void stopAsync();
+    void saveFrameSync(const vpImage<unsigned char> &I, long index);
+    void saveFrameSync(const vpImage<vpRGBa> &I, long index);
     
     //!Path to the image sequence
     char fileName[FILENAME_MAX];
@@ -222,6 +251,21 @@ class VISP_EXPORT vpVideoWriter
     inline void resetFrameCounter() {frameCount = firstFrame;}
 
     void saveFrame (vpImage< vpRGBa > &I);
+
+    //!Backpressure policy of the asynchronous encoding queue.
+    typedef enum {
+      ASYNC_BLOCK,       /*!< saveFrame() waits for a free slot. */
+      ASYNC_DROP_OLDEST  /*!< The oldest queued frame is discarded. */
+    } vpAsyncPolicy;
+
+    void setAsyncEncoding(bool enable, unsigned int queueSize = 8, vpAsyncPolicy policy = ASYNC_BLOCK);
+    void flush();
+    //! Get the number of queued frames whose background encode failed.
+    unsigned int getAsyncEncodingErrors() const { return m_asyncErrors; }
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    //! Entry point of the background encoder thread, not meant to be called directly.
+    void runAsyncThread();
+#endif
     void saveFrame (vpImage< unsigned char > &I);
 
 #ifdef VISP_HAVE_FFMPEG
@@ -42,10 +42,14 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/io/vpImageIo.h>
+
+#include <ctype.h>
+#include <vector>
 #include <visp3/core/vpImageConvert.h> //image  conversion
 #include <visp3/core/vpIoTools.h>
 
 const int vpImageIo::vpMAX_LEN = 100;
+int vpImageIo::s_pngCompressionLevel = -1;
 
 /*!
 
@@ -994,194 +998,100 @@ vpImageIo::readPFM(vpImage<float> &I, const char *filename)
 
 */
 
-void
-vpImageIo::readPGM(vpImage<unsigned char> &I, const char *filename)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Read the whole portable anymap file and parse its header from memory:
+//! expects "P<magic>", then width, height and maxval as whitespace separated
+//! integers with '#' comments allowed, the binary payload following the
+//! single whitespace after maxval. Throws on any malformation.
+static void vpReadPNMFile(const char *filename, char magic, std::vector<unsigned char> &data,
+                          unsigned int &w, unsigned int &h, unsigned int &maxval, size_t &payload)
 {
-  FILE* fd = NULL; // File descriptor
-  int   ierr;
-  char* err ;
-  char  str[vpMAX_LEN];
-  unsigned int magic=5, w=0, h=0, maxval=255;
-
-  // Test the filename
-  if (!filename || *filename == '\0') {
-    throw (vpImageException(vpImageException::ioError,
-          "No filename")) ;
-  }
+  if (!filename || *filename == '\0')
+    throw (vpImageException(vpImageException::ioError, "No filename"));
 
-  // Open the filename
-  if ((fd = fopen(filename, "rb")) == NULL) {
-    throw (vpImageException(vpImageException::ioError,
-          "Cannot read file \"%s\"", filename)) ;
-  }
+  FILE *fd = fopen(filename, "rb");
+  if (fd == NULL)
+    throw (vpImageException(vpImageException::ioError, "Cannot read file \"%s\"", filename));
 
-  while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-  if (err == NULL) {
-    fclose (fd);
-    throw (vpImageException(vpImageException::ioError,
-          "Cannot read header of file \"%s\"",  filename));
-  }
-  if ((ierr = sscanf(str, "P%u %u %u %u", &magic, &w, &h, &maxval)) == 0) {
-    fclose (fd);
-    throw (vpImageException(vpImageException::ioError,
-          "Cannot read header of file \"%s\"",  filename));
+  fseek(fd, 0, SEEK_END);
+  long size = ftell(fd);
+  fseek(fd, 0, SEEK_SET);
+  if (size <= 0) {
+    fclose(fd);
+    throw (vpImageException(vpImageException::ioError, "Cannot read file \"%s\"", filename));
   }
-
-  if (magic != 5) {
-    fclose (fd);
-    throw (vpImageException(vpImageException::ioError,
-                            "\"%s\" is not a PGM P5 file", filename));
+  data.resize((size_t) size);
+  if (fread(&data[0], 1, (size_t) size, fd) != (size_t) size) {
+    fclose(fd);
+    throw (vpImageException(vpImageException::ioError, "Cannot read file \"%s\"", filename));
   }
+  fclose(fd);
 
-  // Depending on ierr the line may contain:
-  // 1 : P5
-  // 2 : P5 w
-  // 3 : P5 w h
-  // 4 : P5 w h maxval
-
-  if (ierr == 1) {
-//    std::cout << "magic: " << magic << std::endl;
-    while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-    if (err == NULL) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if (((ierr = sscanf(str, "%u %u %u", &w, &h, &maxval)) == 0) || (ierr != 1 && ierr != 2 && ierr != 3)) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    // Depending on ierr the line may contain:
-    // 1 : w
-    // 2 : w h
-    // 3 : w h maxval
-    if (ierr == 1) {
-//      std::cout << "w: " << w << std::endl;
-      while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-      if (err == NULL) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if (((ierr = sscanf(str, "%u %u", &h, &maxval)) == 0) || (ierr != 1 && ierr != 2)) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if (ierr == 1) {
-//        std::cout << "h: " << h << std::endl;
-        while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-        if (err == NULL) {
-          fclose (fd);
-          throw (vpImageException(vpImageException::ioError,
-                "Cannot read header of file \"%s\"",  filename));
-        }
-        if ((ierr = sscanf(str, "%u", &maxval)) != 1) {
-          fclose (fd);
-          throw (vpImageException(vpImageException::ioError,
-                "Cannot read header of file \"%s\"",  filename));
-        }
-      }
-//      else {
-//        std::cout << "h: " << h << " maxval: " << maxval << std::endl;
-//      }
-    }
-    else if (ierr == 2) {
-//      std::cout << "w: " << w << " h: " << h << std::endl;
-
-      while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-      if (err == NULL) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if ((ierr = sscanf(str, "%u", &maxval)) != 1)  {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-//      std::cout << "maxval: " << maxval << std::endl;
-    }
-//    else {
-//      std::cout << "w: " << w << " h: " << h << " maxval: " << maxval << std::endl;
-//    }
-  }
-  else if (ierr == 2) {
-//    std::cout << "magic: " << magic << " w: " << w << std::endl;
-    while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-    if (err == NULL) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if (((ierr = sscanf(str, "%u %u", &h, &maxval)) == 0) || (ierr != 1 && ierr != 2)) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if (ierr == 1) {
-//      std::cout << "h: " << h << std::endl;
-      while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-      if (err == NULL) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
+  size_t pos = 0;
+  size_t len = data.size();
+
+  if (len < 2 || data[0] != 'P' || data[1] != magic)
+    throw (vpImageException(vpImageException::ioError, "Bad file header in file \"%s\"", filename));
+  pos = 2;
+
+  unsigned int values[3];
+  for (int field = 0; field < 3; field++) {
+    //Skip whitespace and comments
+    for (;;) {
+      while (pos < len && isspace(data[pos]))
+        pos++;
+      if (pos < len && data[pos] == '#') {
+        while (pos < len && data[pos] != '\n')
+          pos++;
       }
-      if ((ierr = sscanf(str, "%u", &maxval)) != 1) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-//      std::cout << "maxval: " << maxval << std::endl;
+      else
+        break;
     }
-//    else {
-//      std::cout << "h: " << h << " maxval: " << maxval << std::endl;
-//    }
-  }
-  else if (ierr == 3) {
-//    std::cout << "magic: " << magic << " w: " << w << " h: " << h << std::endl;
-    while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-    if (err == NULL) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
+    if (pos >= len || !isdigit(data[pos]))
+      throw (vpImageException(vpImageException::ioError, "Bad file header in file \"%s\"", filename));
+    unsigned int v = 0;
+    while (pos < len && isdigit(data[pos])) {
+      v = v*10 + (unsigned int)(data[pos] - '0');
+      pos++;
     }
-    if ((sscanf(str, "%u", &maxval)) != 1)  {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-//    std::cout << "maxval: " << maxval << std::endl;
+    values[field] = v;
   }
-//  else if (ierr == 4) {
-//    std::cout << "magic: " << magic << " w: " << w << " h: " << h << " maxval: " << maxval << std::endl;
-//  }
 
-  if (w > 100000 || h>100000) {
-    fclose (fd);
-    throw(vpException(vpException::badValue, "Bad image size in \"%s\"",  filename));
-  }
-  if (maxval != 255)
-  {
-    fclose (fd);
+  //A single whitespace separates the header from the payload
+  if (pos >= len || !isspace(data[pos]))
+    throw (vpImageException(vpImageException::ioError, "Bad file header in file \"%s\"", filename));
+  pos++;
+
+  w = values[0];
+  h = values[1];
+  maxval = values[2];
+  payload = pos;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void
+vpImageIo::readPGM(vpImage<unsigned char> &I, const char *filename)
+{
+  // The whole file is read in one pass and the header parsed from memory:
+  // the historic fgets/fscanf parsing made raw PGM ingestion IO-call bound
+  std::vector<unsigned char> data;
+  unsigned int w = 0, h = 0, maxval = 0;
+  size_t payload = 0;
+  vpReadPNMFile(filename, '5', data, w, h, maxval, payload);
+
+  if (maxval > 255)
     throw (vpImageException(vpImageException::ioError,
-          "Bad maxval in \"%s\"",  filename));
-  }
+          "Bad maxval in pgm file \"%s\"", filename));
 
-  if ((h != I.getHeight())||( w != I.getWidth())) {
+  if ((h != I.getHeight())||( w != I.getWidth()))
     I.resize(h,w) ;
-  }
 
-  unsigned int nbyte = I.getHeight()*I.getWidth();
-  size_t n;
-  if ((n = fread (I.bitmap, sizeof(unsigned char), nbyte, fd)) != nbyte) {
-    fclose (fd);
+  size_t nbyte = (size_t) h * w;
+  if (data.size() - payload < nbyte)
     throw (vpImageException(vpImageException::ioError,
-          "Read only %d of %d bytes in file \"%s\"", n, nbyte, filename));
-  }
+          "Read only %d bytes in file \"%s\"", (int)(data.size() - payload), filename));
 
-  fclose (fd);
+  memcpy(I.bitmap, &data[payload], nbyte);
 }
 
 
@@ -1277,201 +1187,33 @@ vpImageIo::readPPM(vpImage<unsigned char> &I, const char *filename)
 void
 vpImageIo::readPPM(vpImage<vpRGBa> &I, const char *filename)
 {
-  FILE* fd = NULL; // File descriptor
-  int   ierr;
-  char* err ;
-  char  str[vpMAX_LEN];
-  unsigned int magic=5, w=0, h=0, maxval=255;
+  // One-pass read and in-memory parsing; the binary payload is expanded
+  // into the RGBa bitmap in a single sweep instead of three stdio reads
+  // per pixel
+  std::vector<unsigned char> data;
+  unsigned int w = 0, h = 0, maxval = 0;
+  size_t payload = 0;
+  vpReadPNMFile(filename, '6', data, w, h, maxval, payload);
 
-  // Test the filename
-  if (!filename || *filename == '\0') {
+  if (maxval > 255)
     throw (vpImageException(vpImageException::ioError,
-          "No filename")) ;
-  }
-
-  // Open the filename
-  if ((fd = fopen(filename, "rb")) == NULL) {
-    throw (vpImageException(vpImageException::ioError,
-          "Cannot read file \"%s\"", filename)) ;
-  }
-
-  while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-  if (err == NULL) {
-    fclose (fd);
-    throw (vpImageException(vpImageException::ioError,
-          "Cannot read header of file \"%s\"",  filename));
-  }
-  if ((ierr = sscanf(str, "P%u %u %u %u", &magic, &w, &h, &maxval)) == 0) {
-    fclose (fd);
-    throw (vpImageException(vpImageException::ioError,
-          "Cannot read header of file \"%s\"",  filename));
-  }
-
-  if (magic != 6) {
-    fclose (fd);
-    throw (vpImageException(vpImageException::ioError,
-                            "\"%s\" is not a PGM P6 file", filename));
-  }
+          "Bad maxval in ppm file \"%s\"", filename));
 
-  // Depending on ierr the line may contain:
-  // 1 : P6
-  // 2 : P6 w
-  // 3 : P6 w h
-  // 4 : P6 w h maxval
-
-  if (ierr == 1) {
-//    std::cout << "magic: " << magic << std::endl;
-    while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-    if (err == NULL) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if (((ierr = sscanf(str, "%u %u %u", &w, &h, &maxval)) == 0) || (ierr != 1 && ierr != 2 && ierr != 3)) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    // Depending on ierr the line may contain:
-    // 1 : w
-    // 2 : w h
-    // 3 : w h maxval
-    if (ierr == 1) {
-//      std::cout << "w: " << w << std::endl;
-      while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-      if (err == NULL) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if (((ierr = sscanf(str, "%u %u", &h, &maxval)) == 0) || (ierr != 1 && ierr != 2)) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if (ierr == 1) {
-//        std::cout << "h: " << h << std::endl;
-        while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-        if (err == NULL) {
-          fclose (fd);
-          throw (vpImageException(vpImageException::ioError,
-                "Cannot read header of file \"%s\"",  filename));
-        }
-        if ((ierr = sscanf(str, "%u", &maxval)) != 1) {
-          fclose (fd);
-          throw (vpImageException(vpImageException::ioError,
-                "Cannot read header of file \"%s\"",  filename));
-        }
-      }
-//      else {
-//        std::cout << "h: " << h << " maxval: " << maxval << std::endl;
-//      }
-    }
-    else if (ierr == 2) {
-//      std::cout << "w: " << w << " h: " << h << std::endl;
-
-      while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-      if (err == NULL) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if ((ierr = sscanf(str, "%u", &maxval)) != 1)  {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-//      std::cout << "maxval: " << maxval << std::endl;
-    }
-//    else {
-//      std::cout << "w: " << w << " h: " << h << " maxval: " << maxval << std::endl;
-//    }
-  }
-  else if (ierr == 2) {
-//    std::cout << "magic: " << magic << " w: " << w << std::endl;
-    while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-    if (err == NULL) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if (((ierr = sscanf(str, "%u %u", &h, &maxval)) == 0) || (ierr != 1 && ierr != 2)) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if (ierr == 1) {
-//      std::cout << "h: " << h << std::endl;
-      while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-      if (err == NULL) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-      if ((ierr = sscanf(str, "%u", &maxval)) != 1) {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read header of file \"%s\"",  filename));
-      }
-//      std::cout << "maxval: " << maxval << std::endl;
-    }
-//    else {
-//      std::cout << "h: " << h << " maxval: " << maxval << std::endl;
-//    }
-  }
-  else if (ierr == 3) {
-//    std::cout << "magic: " << magic << " w: " << w << " h: " << h << std::endl;
-    while ((err = fgets(str, vpMAX_LEN - 1, fd)) != NULL && ((str[0] == '#') || (str[0] == '\n'))) {};
-    if (err == NULL) {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-    if ((sscanf(str, "%u", &maxval)) != 1)  {
-      fclose (fd);
-      throw (vpImageException(vpImageException::ioError,
-            "Cannot read header of file \"%s\"",  filename));
-    }
-//    std::cout << "maxval: " << maxval << std::endl;
-  }
-//  else if (ierr == 4) {
-//    std::cout << "magic: " << magic << " w: " << w << " h: " << h << " maxval: " << maxval << std::endl;
-//  }
+  if ((h != I.getHeight())||( w != I.getWidth()))
+    I.resize(h,w);
 
-  if (w > 100000 || h>100000) {
-    fclose (fd);
-    throw(vpException(vpException::badValue, "Bad image size in \"%s\"",  filename));
-  }
-  if (maxval != 255)
-  {
-    fclose (fd);
+  size_t nbpixel = (size_t) h * w;
+  if (data.size() - payload < 3*nbpixel)
     throw (vpImageException(vpImageException::ioError,
-          "Bad maxval in \"%s\"",  filename));
-  }
+          "Read only %d bytes in file \"%s\"", (int)(data.size() - payload), filename));
 
-  if ((h != I.getHeight())||( w != I.getWidth())) {
-    I.resize(h,w) ;
+  const unsigned char *src = &data[payload];
+  for (size_t k = 0; k < nbpixel; k++) {
+    I.bitmap[k].R = src[3*k];
+    I.bitmap[k].G = src[3*k+1];
+    I.bitmap[k].B = src[3*k+2];
+    I.bitmap[k].A = 0;
   }
-
-  for(unsigned int i=0;i<I.getHeight();i++)
-  {
-    for(unsigned int j=0;j<I.getWidth();j++)
-    {
-      vpRGBa v ;
-      size_t res = fread(&v.R,sizeof(v.R),1,fd) ;
-      res |= fread(&v.G,sizeof(v.G),1,fd) ;
-      res |= fread(&v.B,sizeof(v.B),1,fd) ;
-      if (res==0)
-      {
-        fclose (fd);
-        throw (vpImageException(vpImageException::ioError,
-              "Cannot read bytes in file \"%s\"\n", filename));
-      }
-      I[i][j] = v ;
-    }
-  }
-
-  fclose (fd);
 }
 
 /*!
@@ -1961,14 +1703,40 @@ vpImageIo::readJPEG(vpImage<unsigned char> &I, const char *filename)
   if ( (width != I.getWidth()) || (height != I.getHeight()) )
     I.resize(height,width);
 
-  jpeg_start_decompress(&cinfo);
-
-  unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
-  JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)
-                      ((j_common_ptr) &cinfo, JPOOL_IMAGE, rowbytes, 1);
-
-  if (cinfo.out_color_space == JCS_RGB) {
+  if (cinfo.jpeg_color_space == JCS_GRAYSCALE)
+  {
+    //Grayscale file: the scanlines are decoded directly into the
+    //destination bitmap, without the historic intermediate row buffer
+    jpeg_start_decompress(&cinfo);
+    while (cinfo.output_scanline<cinfo.output_height)
+    {
+      JSAMPROW rowptr = (JSAMPROW) I[cinfo.output_scanline];
+      jpeg_read_scanlines(&cinfo,&rowptr,1);
+    }
+  }
+  else
+  {
+    //Color file: decode to color then convert, keeping the historic
+    //grayscale weights of vpImageConvert (the decoder's own grayscale
+    //conversion uses different ones)
     vpImage<vpRGBa> Ic(height,width);
+#if defined(JCS_EXTENSIONS)
+    //libjpeg-turbo writes the 4-byte RGBX pixels straight into the bitmap
+    cinfo.out_color_space = JCS_EXT_RGBX;
+    jpeg_start_decompress(&cinfo);
+    while (cinfo.output_scanline<cinfo.output_height)
+    {
+      JSAMPROW rowptr = (JSAMPROW) Ic[cinfo.output_scanline];
+      jpeg_read_scanlines(&cinfo,&rowptr,1);
+    }
+    //The X byte of the decoder is undefined: restore the historic A=0
+    for (unsigned int i = 0; i < height*width; i++)
+      Ic.bitmap[i].A = 0;
+#else
+    jpeg_start_decompress(&cinfo);
+    unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)
+                        ((j_common_ptr) &cinfo, JPOOL_IMAGE, rowbytes, 1);
     unsigned char* output = (unsigned char*)Ic.bitmap;
     while (cinfo.output_scanline<cinfo.output_height)	{
       jpeg_read_scanlines(&cinfo,buffer,1);
@@ -1976,22 +1744,13 @@ vpImageIo::readJPEG(vpImage<unsigned char> &I, const char *filename)
         *(output++) = buffer[0][i*3];
         *(output++) = buffer[0][i*3+1];
         *(output++) = buffer[0][i*3+2];
-	*(output++) = 0;
+        *(output++) = 0;
       }
     }
+#endif
     vpImageConvert::convert(Ic,I) ;
   }
 
-  else if (cinfo.out_color_space == JCS_GRAYSCALE)
-  {
-    while (cinfo.output_scanline<cinfo.output_height)
-    {
-      unsigned int row = cinfo.output_scanline;
-      jpeg_read_scanlines(&cinfo,buffer,1);
-      memcpy(I[row], buffer[0], rowbytes);
-    }
-  }
-
   jpeg_finish_decompress(&cinfo);
   jpeg_destroy_decompress(&cinfo);
   fclose(file);
@@ -2074,6 +1833,31 @@ vpImageIo::readJPEG(vpImage<vpRGBa> &I, const char *filename)
   if ( (width != I.getWidth()) || (height != I.getHeight()) )
     I.resize(height,width);
 
+#if defined(JCS_EXTENSIONS)
+  //libjpeg-turbo: the decoder writes the 4-byte RGBX pixels straight into
+  //the destination bitmap, removing the row buffer and the expansion loop
+  if (cinfo.out_color_space == JCS_RGB) {
+    cinfo.out_color_space = JCS_EXT_RGBX;
+
+    jpeg_start_decompress(&cinfo);
+
+    while (cinfo.output_scanline<cinfo.output_height)
+    {
+      JSAMPROW rowptr = (JSAMPROW) I[cinfo.output_scanline];
+      jpeg_read_scanlines(&cinfo,&rowptr,1);
+    }
+
+    //The X byte of the decoder is undefined: restore the historic A=0
+    for (unsigned int i = 0; i < height*width; i++)
+      I.bitmap[i].A = 0;
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    fclose(file);
+    return;
+  }
+#endif
+
   jpeg_start_decompress(&cinfo);
 
   unsigned int rowbytes = cinfo.output_width * (unsigned int)(cinfo.output_components);
@@ -2428,6 +2212,9 @@ vpImageIo::writePNG(const vpImage<unsigned char> &I, const char *filename)
   /* setup libpng for using standard C fwrite() function with our FILE pointer */
   png_init_io (png_ptr, file);
 
+  if (s_pngCompressionLevel >= 0)
+    png_set_compression_level(png_ptr, s_pngCompressionLevel);
+
   unsigned int width = I.getWidth();
   unsigned int height = I.getHeight();
   int bit_depth = 8;
@@ -2554,6 +2341,9 @@ vpImageIo::writePNG(const vpImage<vpRGBa> &I, const char *filename)
   /* setup libpng for using standard C fwrite() function with our FILE pointer */
   png_init_io (png_ptr, file);
 
+  if (s_pngCompressionLevel >= 0)
+    png_set_compression_level(png_ptr, s_pngCompressionLevel);
+
   unsigned int width = I.getWidth();
   unsigned int height = I.getHeight();
   int bit_depth = 8;
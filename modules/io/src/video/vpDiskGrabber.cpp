@@ -38,12 +38,33 @@
 
 #include <visp3/io/vpDiskGrabber.h>
 
+#if !defined(_WIN32)
+#  include <unistd.h>
+#else
+#  include <windows.h>
+#endif
+
+//! Short yielding nap for the prefetch handshake: vpTime::wait() busy-spins
+//! under a few ms.
+static inline void vpDiskGrabberBarrier();
+
+static inline void vpDiskGrabberNap()
+{
+#if !defined(_WIN32)
+  usleep(200);
+#else
+  Sleep(1);
+#endif
+}
+
 
 /*!
   Elementary constructor.
 */
 vpDiskGrabber::vpDiskGrabber()
-  : image_number(0), image_step(1), number_of_zero(0), useGenericName(false)
+  : image_number(0), image_step(1), number_of_zero(0), useGenericName(false), m_prefetchEnabled(false), m_prefetchType(0), m_prefetchReady(false),
+    m_prefetchWanted(false), m_prefetchRun(false), m_prefetchFailed(false),
+    m_prefetchNumber(0), m_prefetchLoadedNumber(0), m_prefetchThread(NULL)
 {
   setDirectory("/tmp");
   setBaseName("I");
@@ -54,7 +75,9 @@ vpDiskGrabber::vpDiskGrabber()
 
 
 vpDiskGrabber::vpDiskGrabber(const char *generic_name)
-  : image_number(0), image_step(1), number_of_zero(0), useGenericName(false)
+  : image_number(0), image_step(1), number_of_zero(0), useGenericName(false), m_prefetchEnabled(false), m_prefetchType(0), m_prefetchReady(false),
+    m_prefetchWanted(false), m_prefetchRun(false), m_prefetchFailed(false),
+    m_prefetchNumber(0), m_prefetchLoadedNumber(0), m_prefetchThread(NULL)
 {
   setDirectory("/tmp");
   setBaseName("I");
@@ -86,7 +109,9 @@ vpDiskGrabber::vpDiskGrabber(const char *dir, const char *basename,
                              long number,
                              int step, unsigned int noz,
                              const char *ext)
-  : image_number(number), image_step(step), number_of_zero(noz), useGenericName(false)
+  : image_number(number), image_step(step), number_of_zero(noz), useGenericName(false), m_prefetchEnabled(false), m_prefetchType(0), m_prefetchReady(false),
+    m_prefetchWanted(false), m_prefetchRun(false), m_prefetchFailed(false),
+    m_prefetchNumber(0), m_prefetchLoadedNumber(0), m_prefetchThread(NULL)
 {
   setDirectory(dir);
   setBaseName(basename);
@@ -167,6 +192,32 @@ vpDiskGrabber::open(vpImage<float> &I)
 void
 vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 {
+  if (m_prefetchEnabled) {
+    //Double-buffered read: the background thread loaded this frame while
+    //the caller was processing the previous one
+    if (m_prefetchThread != NULL && m_prefetchType == 2)
+      stopPrefetch();
+    if (m_prefetchThread == NULL)
+      startPrefetch(1);
+
+    while (!m_prefetchReady && !m_prefetchFailed)
+      vpDiskGrabberNap();
+
+    if (m_prefetchReady) {
+      vpDiskGrabberBarrier(); //the flag must be read before the frame
+      I = m_prefetchGray;
+      width = I.getWidth();
+      height = I.getHeight();
+      image_number = m_prefetchLoadedNumber + image_step; //consumer position
+      vpDiskGrabberBarrier(); //the frame must be read before the buffer is handed back
+      m_prefetchReady = false;
+      m_prefetchWanted = !m_prefetchWanted; //hand the buffer back to the thread
+      return;
+    }
+    //Read failure: fall through to the synchronous path, which throws as
+    //it always did
+    stopPrefetch();
+  }
 
   char name[FILENAME_MAX] ;
 
@@ -194,6 +245,28 @@ vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 void
 vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 {
+  if (m_prefetchEnabled) {
+    if (m_prefetchThread != NULL && m_prefetchType == 1)
+      stopPrefetch();
+    if (m_prefetchThread == NULL)
+      startPrefetch(2);
+
+    while (!m_prefetchReady && !m_prefetchFailed)
+      vpDiskGrabberNap();
+
+    if (m_prefetchReady) {
+      vpDiskGrabberBarrier(); //the flag must be read before the frame
+      I = m_prefetchColor;
+      width = I.getWidth();
+      height = I.getHeight();
+      image_number = m_prefetchLoadedNumber + image_step; //consumer position
+      vpDiskGrabberBarrier(); //the frame must be read before the buffer is handed back
+      m_prefetchReady = false;
+      m_prefetchWanted = !m_prefetchWanted;
+      return;
+    }
+    stopPrefetch();
+  }
 
   char name[FILENAME_MAX] ;
 
@@ -222,6 +295,7 @@ vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 void
 vpDiskGrabber::acquire(vpImage<float> &I)
 {
+  stopPrefetch(); //the float path stays synchronous and owns the sequence
 
   char name[FILENAME_MAX] ;
 
@@ -251,6 +325,7 @@ vpDiskGrabber::acquire(vpImage<float> &I)
 void
 vpDiskGrabber::acquire(vpImage<unsigned char> &I, long img_number)
 {
+  stopPrefetch(); //a seek invalidates the frame read ahead
 
   char name[FILENAME_MAX] ;
 
@@ -277,6 +352,7 @@ vpDiskGrabber::acquire(vpImage<unsigned char> &I, long img_number)
 void
 vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long img_number)
 {
+  stopPrefetch(); //a seek invalidates the frame read ahead
 
   char name[FILENAME_MAX] ;
 
@@ -305,6 +381,7 @@ vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long img_number)
 void
 vpDiskGrabber::acquire(vpImage<float> &I, long img_number)
 {
+  stopPrefetch(); //a seek invalidates the frame read ahead
 
   char name[FILENAME_MAX] ;
 
@@ -339,8 +416,118 @@ vpDiskGrabber::close()
 
   In fact nothing to destroy...
  */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+static vpThread::Return vpDiskGrabberPrefetchThreadEntry(vpThread::Args args)
+{
+  ((vpDiskGrabber *) args)->runPrefetchThread();
+  return 0;
+}
+
+//! Full memory barrier ordering the buffer accesses with the flag publications.
+static inline void vpDiskGrabberBarrier()
+{
+#if defined(__GNUC__)
+  __sync_synchronize();
+#elif defined(_WIN32)
+  MemoryBarrier();
+#endif
+}
+#endif
+
+/*!
+  Enable the double-buffered prefetch: while the caller processes a frame, a
+  background thread reads and decodes the next one (following the
+  configured step and direction), so the sequential acquire() overloads
+  reduce to a buffer swap. The frame type is fixed by the first prefetched
+  acquire; indexed acquires and setImageNumber() cancel the frame read
+  ahead, which restarts from the new position. The sequential acquire()
+  semantics are unchanged.
+
+  \param enable : True to prefetch, false (default) to read synchronously.
+*/
+void vpDiskGrabber::setPrefetch(bool enable)
+{
+  if (!enable)
+    stopPrefetch();
+  m_prefetchEnabled = enable;
+}
+
+/*!
+  Start the background reader thread for the given frame type (1 grayscale,
+  2 color). Internal.
+*/
+void vpDiskGrabber::startPrefetch(int type)
+{
+  stopPrefetch();
+  m_prefetchType = type;
+  m_prefetchNumber = image_number;
+  m_prefetchReady = false;
+  m_prefetchFailed = false;
+  m_prefetchWanted = true;
+  m_prefetchRun = true;
+  m_prefetchThread = new vpThread((vpThread::Fn) vpDiskGrabberPrefetchThreadEntry, (vpThread::Args) this);
+}
+
+/*!
+  Stop the background reader thread and discard the frame read ahead.
+  Internal.
+*/
+void vpDiskGrabber::stopPrefetch()
+{
+  if (m_prefetchThread != NULL) {
+    m_prefetchRun = false;
+    m_prefetchThread->join();
+    delete m_prefetchThread;
+    m_prefetchThread = NULL;
+  }
+  m_prefetchReady = false;
+  m_prefetchFailed = false;
+  m_prefetchType = 0;
+}
+
+/*!
+  Background reader loop: loads the next frame of the sequence into the
+  back buffer whenever the caller consumed the previous one. Internal entry
+  point.
+*/
+void vpDiskGrabber::runPrefetchThread()
+{
+  bool lastWanted = !m_prefetchWanted; //force an initial load
+  while (m_prefetchRun) {
+    if (m_prefetchReady || lastWanted == m_prefetchWanted) {
+      vpDiskGrabberNap();
+      continue;
+    }
+    lastWanted = m_prefetchWanted;
+
+    char name[FILENAME_MAX] ;
+    if(useGenericName)
+      sprintf(name,genericName,m_prefetchNumber) ;
+    else
+      sprintf(name,"%s/%s%0*ld.%s",directory,base_name,number_of_zero,m_prefetchNumber,extension) ;
+
+    try {
+      if (m_prefetchType == 1)
+        vpImageIo::read(m_prefetchGray, name);
+      else
+        vpImageIo::read(m_prefetchColor, name);
+    }
+    catch(...) {
+      m_prefetchFailed = true;
+      break;
+    }
+
+    m_prefetchLoadedNumber = m_prefetchNumber ;
+    m_prefetchNumber += image_step ;
+
+    vpDiskGrabberBarrier(); //the frame must be visible before the flag
+    m_prefetchReady = true;
+  }
+}
+
 vpDiskGrabber::~vpDiskGrabber()
 {
+  stopPrefetch();
 }
 
 
@@ -377,6 +564,7 @@ vpDiskGrabber::setExtension(const char *ext)
 void
 vpDiskGrabber::setImageNumber(long number)
 {
+  stopPrefetch(); //a seek invalidates the frame read ahead
   image_number = number ;
   vpDEBUG_TRACE(2, "image number %ld", image_number);
 
@@ -63,7 +63,7 @@ extern "C"
 vpFFMPEG::vpFFMPEG()
   : width(-1), height(-1), frameNumber(0), pFormatCtx(NULL), pCodecCtx(NULL),
     pCodec(NULL), pFrame(NULL), pFrameRGB(NULL), pFrameGRAY(NULL), packet(NULL),
-    img_convert_ctx(NULL), videoStream(0), numBytes(0), buffer(NULL), index(),
+    img_convert_ctx(NULL), m_decoderThreads(0), videoStream(0), numBytes(0), buffer(NULL), index(),
     streamWasOpen(false), streamWasInitialized(false), color_type(COLORED),
     f(NULL), outbuf(NULL), picture_buf(NULL), outbuf_size(0), out_size(0),
     bit_rate(500000), encoderWasOpened(false),
@@ -153,6 +153,17 @@ bool vpFFMPEG::openStream(const char *filename, vpFFMPEGColorType colortype)
       return false;		// Codec not found
     }
     
+    if (m_decoderThreads > 0)
+    {
+      //Multi-threaded decode: frame threading when the codec supports it,
+      //slice threading otherwise. The SwsContext and the destination
+      //buffers are already allocated once per stream and reused per frame.
+      pCodecCtx->thread_count = (int)m_decoderThreads;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52,112,0)
+      pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+#endif
+    }
+
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(53,35,0) // libavcodec 53.35.0
     if (avcodec_open (pCodecCtx, pCodec) < 0)
 #else
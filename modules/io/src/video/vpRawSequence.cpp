@@ -0,0 +1,313 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Raw uncompressed sequence container, memory mapped at reading.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpRawSequence.cpp
+  \brief Raw uncompressed sequence container, memory mapped at reading.
+*/
+
+#include <visp3/io/vpRawSequence.h>
+#include <visp3/core/vpException.h>
+
+#include <string.h>
+
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! On-disk header of the raw sequence container.
+struct vpRawSequenceHeader
+{
+  unsigned int magic;      //!< 0x56525351 ("VRSQ")
+  unsigned int version;
+  unsigned int type;       //!< vpRawSequence::vpFrameType
+  unsigned int width;
+  unsigned int height;
+  unsigned int frameCount; //!< patched by close()
+  unsigned int reserved[2];
+};
+#endif
+
+vpRawSequence::vpRawSequence()
+  : m_file(NULL), m_map(NULL), m_mapLength(0), m_mapped(false),
+    m_type(TYPE_NONE), m_width(0), m_height(0), m_frameCount(0), m_frameSize(0)
+{
+}
+
+vpRawSequence::~vpRawSequence()
+{
+  close();
+}
+
+/*!
+  Open the container for writing: the geometry and pixel type are fixed by
+  the first writeFrame() call, the frame count is patched at close().
+
+  \param filename : Path of the ".vraw" file to create.
+*/
+void vpRawSequence::openWriting(const char *filename)
+{
+  close();
+  m_file = fopen(filename, "wb");
+  if (m_file == NULL)
+    throw(vpException(vpException::ioError, "Cannot create the raw sequence file"));
+
+  vpRawSequenceHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = 0x56525351u;
+  header.version = 1;
+  fwrite(&header, sizeof(header), 1, m_file); //placeholder, patched at close()
+  m_frameCount = 0;
+  m_type = TYPE_NONE;
+}
+
+/*!
+  Append one grayscale frame. All the frames of a container share the
+  geometry and type of the first one.
+
+  \param I : Frame to append.
+*/
+void vpRawSequence::writeFrame(const vpImage<unsigned char> &I)
+{
+  if (m_file == NULL)
+    throw(vpException(vpException::notInitialized, "Raw sequence not open for writing"));
+
+  if (m_type == TYPE_NONE) {
+    m_type = TYPE_GRAY;
+    m_width = I.getWidth();
+    m_height = I.getHeight();
+    m_frameSize = (size_t) m_width * m_height;
+  }
+  if (m_type != TYPE_GRAY || I.getWidth() != m_width || I.getHeight() != m_height)
+    throw(vpException(vpException::dimensionError, "Raw sequence frame type or geometry mismatch"));
+
+  if (fwrite(I.bitmap, 1, m_frameSize, m_file) != m_frameSize)
+    throw(vpException(vpException::ioError, "Error while writing the raw sequence frame"));
+  m_frameCount++;
+}
+
+/*!
+  Append one color frame, see writeFrame(const vpImage<unsigned char> &).
+
+  \param I : Frame to append.
+*/
+void vpRawSequence::writeFrame(const vpImage<vpRGBa> &I)
+{
+  if (m_file == NULL)
+    throw(vpException(vpException::notInitialized, "Raw sequence not open for writing"));
+
+  if (m_type == TYPE_NONE) {
+    m_type = TYPE_RGBA;
+    m_width = I.getWidth();
+    m_height = I.getHeight();
+    m_frameSize = (size_t) m_width * m_height * sizeof(vpRGBa);
+  }
+  if (m_type != TYPE_RGBA || I.getWidth() != m_width || I.getHeight() != m_height)
+    throw(vpException(vpException::dimensionError, "Raw sequence frame type or geometry mismatch"));
+
+  if (fwrite(I.bitmap, 1, m_frameSize, m_file) != m_frameSize)
+    throw(vpException(vpException::ioError, "Error while writing the raw sequence frame"));
+  m_frameCount++;
+}
+
+/*!
+  Open the container for reading: the file is mapped read only (so its clean
+  pages are shared between the processes replaying the same sequence), and
+  the frames are served from the mapping without any decoding.
+
+  \param filename : Path of the ".vraw" file.
+*/
+void vpRawSequence::openReading(const char *filename)
+{
+  close();
+
+#if !defined(_WIN32)
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    throw(vpException(vpException::ioError, "Cannot open the raw sequence file"));
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(vpRawSequenceHeader)) {
+    ::close(fd);
+    throw(vpException(vpException::ioError, "Invalid raw sequence file"));
+  }
+  m_mapLength = (size_t) st.st_size;
+  void *map = mmap(NULL, m_mapLength, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+    throw(vpException(vpException::ioError, "Cannot map the raw sequence file"));
+  m_map = (unsigned char *) map;
+  m_mapped = true;
+#else
+  //No mmap on this platform: plain buffered read of the whole file
+  FILE *f = fopen(filename, "rb");
+  if (f == NULL)
+    throw(vpException(vpException::ioError, "Cannot open the raw sequence file"));
+  fseek(f, 0, SEEK_END);
+  long sz = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (sz < (long) sizeof(vpRawSequenceHeader)) {
+    fclose(f);
+    throw(vpException(vpException::ioError, "Invalid raw sequence file"));
+  }
+  m_mapLength = (size_t) sz;
+  m_map = new unsigned char[m_mapLength];
+  if (fread(m_map, 1, m_mapLength, f) != m_mapLength) {
+    fclose(f);
+    delete[] m_map;
+    m_map = NULL;
+    throw(vpException(vpException::ioError, "Error while reading the raw sequence file"));
+  }
+  fclose(f);
+  m_mapped = false;
+#endif
+
+  const vpRawSequenceHeader *header = (const vpRawSequenceHeader *) m_map;
+  m_type = (int) header->type;
+  m_width = header->width;
+  m_height = header->height;
+  m_frameCount = (long) header->frameCount;
+  m_frameSize = (size_t) m_width * m_height * (m_type == TYPE_RGBA ? sizeof(vpRGBa) : 1);
+
+  if (header->magic != 0x56525351u || header->version != 1 ||
+      (m_type != TYPE_GRAY && m_type != TYPE_RGBA) ||
+      m_mapLength < sizeof(vpRawSequenceHeader) + (size_t) m_frameCount * m_frameSize) {
+    close();
+    throw(vpException(vpException::ioError, "Invalid raw sequence file"));
+  }
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+const unsigned char *vpRawSequence::framePtr(long index) const
+{
+  return m_map + sizeof(vpRawSequenceHeader) + (size_t) index * m_frameSize;
+}
+
+void vpRawSequence::checkFrame(long index, int type) const
+{
+  if (m_map == NULL)
+    throw(vpException(vpException::notInitialized, "Raw sequence not open for reading"));
+  if (m_type != type)
+    throw(vpException(vpException::badValue, "Raw sequence frame type mismatch"));
+  if (index < 0 || index >= m_frameCount)
+    throw(vpException(vpException::badValue, "Raw sequence frame index out of range"));
+}
+#endif
+
+/*!
+  Copy a frame out of the mapping (no decoding, a single copy).
+
+  \param I : Output frame, resized as needed.
+  \param index : Zero based frame index.
+*/
+void vpRawSequence::getFrame(vpImage<unsigned char> &I, long index) const
+{
+  checkFrame(index, TYPE_GRAY);
+  I.resize(m_height, m_width);
+  memcpy(I.bitmap, framePtr(index), m_frameSize);
+}
+
+//! Copy a color frame out of the mapping, see getFrame(vpImage<unsigned char> &, long).
+void vpRawSequence::getFrame(vpImage<vpRGBa> &I, long index) const
+{
+  checkFrame(index, TYPE_RGBA);
+  I.resize(m_height, m_width);
+  memcpy(I.bitmap, framePtr(index), m_frameSize);
+}
+
+/*!
+  Alias a frame of the mapping without any copy: the image becomes a non
+  owning view of the read-only mapping, valid until close(). Do not write
+  through it.
+
+  \param I : Image turned into a view of the frame.
+  \param index : Zero based frame index.
+*/
+void vpRawSequence::getFrameRef(vpImage<unsigned char> &I, long index) const
+{
+  checkFrame(index, TYPE_GRAY);
+  I.init((unsigned char *) framePtr(index), m_height, m_width, false);
+}
+
+//! Alias a color frame without copy, see getFrameRef(vpImage<unsigned char> &, long).
+void vpRawSequence::getFrameRef(vpImage<vpRGBa> &I, long index) const
+{
+  checkFrame(index, TYPE_RGBA);
+  I.init((vpRGBa *) framePtr(index), m_height, m_width, false);
+}
+
+/*!
+  Close the container: a written file gets its header patched with the frame
+  count, a read mapping is released. Harmless when nothing is open.
+*/
+void vpRawSequence::close()
+{
+  if (m_file != NULL) {
+    vpRawSequenceHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = 0x56525351u;
+    header.version = 1;
+    header.type = (unsigned int) m_type;
+    header.width = m_width;
+    header.height = m_height;
+    header.frameCount = (unsigned int) m_frameCount;
+    fseek(m_file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, m_file);
+    fclose(m_file);
+    m_file = NULL;
+  }
+  if (m_map != NULL) {
+#if !defined(_WIN32)
+    if (m_mapped)
+      munmap((void *) m_map, m_mapLength);
+    else
+      delete[] m_map;
+#else
+    delete[] m_map;
+#endif
+    m_map = NULL;
+  }
+  m_mapLength = 0;
+  m_mapped = false;
+  m_type = TYPE_NONE;
+  m_width = m_height = 0;
+  m_frameCount = 0;
+  m_frameSize = 0;
+}
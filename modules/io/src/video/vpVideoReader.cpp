@@ -44,6 +44,20 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/io/vpVideoReader.h>
 
+#if !defined(_WIN32)
+#  include <dirent.h>
+#endif
+#include <ctype.h>
+
+static inline void vpVideoReaderBarrier();
+
+#if !defined(_WIN32)
+#  include <unistd.h>
+#else
+#  include <windows.h>
+#endif
+static inline void vpVideoReaderNap();
+
 #include <iostream>
 #include <fstream>
 #include <limits>   // numeric_limits
@@ -52,14 +66,18 @@
 Basic constructor.
 */
 vpVideoReader::vpVideoReader()
-  : vpFrameGrabber(), imSequence(NULL),
+  : vpFrameGrabber(), imSequence(NULL), rawSeq(NULL), rawNextIndex(0),
+    m_seqIndexValid(false), m_seqIndexFirst(0), m_seqIndexLast(-1),
 #ifdef VISP_HAVE_FFMPEG
 	ffmpeg(NULL),
 #elif VISP_HAVE_OPENCV_VERSION >= 0x020100
   capture(), frame(),
 #endif
 	formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0),
-	firstFrame(0), lastFrame(0), firstFrameIndexIsSet(false), lastFrameIndexIsSet(false)
+	firstFrame(0), lastFrame(0), firstFrameIndexIsSet(false), lastFrameIndexIsSet(false),
+	m_prefetchCapacity(0), m_prefetchGray(), m_prefetchColor(), m_prefetchType(0),
+	m_prefetchHead(0), m_prefetchTail(0), m_prefetchRun(false), m_prefetchEos(false),
+	m_prefetchThread(NULL)
 {
 }
 
@@ -72,6 +90,10 @@ vpVideoReader::~vpVideoReader()
 	{
 		delete imSequence;
 	}
+	if (rawSeq != NULL)
+	{
+		delete rawSeq;
+	}
 #ifdef VISP_HAVE_FFMPEG
 	if (ffmpeg != NULL)
 	{
@@ -105,6 +127,8 @@ void vpVideoReader::setFileName(const char *filename)
 
 	strcpy(this->fileName,filename);
 
+	m_seqIndexValid = false; //the pattern changed, rebuild the index lazily
+
 	formatType = getFormat(fileName);
 
   if (formatType == FORMAT_UNKNOWN) {
@@ -143,7 +167,12 @@ void vpVideoReader::open(vpImage< vpRGBa > &I)
 		throw (vpImageException(vpImageException::noFileNameError,"filename empty"));
 	}
 
-	if (isImageExtensionSupported())
+	if (formatType == FORMAT_RAW)
+	{
+		rawSeq = new vpRawSequence;
+		rawSeq->openReading(fileName);
+	}
+	else if (isImageExtensionSupported())
 	{
 		imSequence = new vpDiskGrabber;
 		imSequence->setGenericName(fileName);
@@ -207,7 +236,12 @@ void vpVideoReader::open(vpImage<unsigned char> &I)
 		throw (vpImageException(vpImageException::noFileNameError,"filename empty"));
 	}
 
-	if (isImageExtensionSupported())
+	if (formatType == FORMAT_RAW)
+	{
+		rawSeq = new vpRawSequence;
+		rawSeq->openReading(fileName);
+	}
+	else if (isImageExtensionSupported())
 	{
 		imSequence = new vpDiskGrabber;
 		imSequence->setGenericName(fileName);
@@ -271,8 +305,38 @@ void vpVideoReader::acquire(vpImage< vpRGBa > &I)
 		open(I);
 	}
 
+	if (imSequence != NULL && m_prefetchCapacity > 0)
+	{
+		if (m_prefetchThread != NULL && m_prefetchType == 1)
+			stopPrefetch();
+		if (m_prefetchThread == NULL && !m_prefetchEos)
+			startPrefetch(2);
+
+		if (m_prefetchThread != NULL && m_prefetchType == 2)
+		{
+			while (m_prefetchTail == m_prefetchHead && !m_prefetchEos)
+				vpVideoReaderNap();
+
+			if (m_prefetchTail != m_prefetchHead)
+			{
+				vpVideoReaderBarrier(); //the index must be read before the frame
+				I = m_prefetchColor[m_prefetchTail & (m_prefetchCapacity-1)];
+				vpVideoReaderBarrier(); //the frame must be read before the slot is released
+				m_prefetchTail = m_prefetchTail + 1;
+				frameCount++; // next index
+				return;
+			}
+		}
+	}
+
 	//getFrame(I,frameCount);
-	if (imSequence != NULL)
+	if (rawSeq != NULL)
+	{
+		rawSeq->getFrame(I, rawNextIndex);
+		frameCount = rawNextIndex; // index of the frame just read, as with sequences
+		rawNextIndex++;
+	}
+	else if (imSequence != NULL)
 	{
 		imSequence->acquire(I);
     frameCount++; // next index
@@ -315,7 +379,42 @@ void vpVideoReader::acquire(vpImage< unsigned char > &I)
 		open(I);
 	}
 
-	if (imSequence != NULL)
+	if (imSequence != NULL && m_prefetchCapacity > 0)
+	{
+		//Prefetched read-ahead: the background thread decodes the sequence
+		//into the ring, acquire() reduces to a queue pop. A type change stops
+		//the other-type thread first (it owns the sequence while running)
+		if (m_prefetchThread != NULL && m_prefetchType == 2)
+			stopPrefetch();
+		if (m_prefetchThread == NULL && !m_prefetchEos)
+			startPrefetch(1);
+
+		if (m_prefetchThread != NULL && m_prefetchType == 1)
+		{
+			while (m_prefetchTail == m_prefetchHead && !m_prefetchEos)
+				vpVideoReaderNap();
+
+			if (m_prefetchTail != m_prefetchHead)
+			{
+				vpVideoReaderBarrier(); //the index must be read before the frame
+				I = m_prefetchGray[m_prefetchTail & (m_prefetchCapacity-1)];
+				vpVideoReaderBarrier(); //the frame must be read before the slot is released
+				m_prefetchTail = m_prefetchTail + 1;
+				frameCount++; // next index
+				return;
+			}
+			//Drained and end of sequence: fall through to the synchronous
+			//path, which reports the end as it always did
+		}
+	}
+
+	if (rawSeq != NULL)
+	{
+		rawSeq->getFrame(I, rawNextIndex);
+		frameCount = rawNextIndex; // index of the frame just read, as with sequences
+		rawNextIndex++;
+	}
+	else if (imSequence != NULL)
 	{
 		imSequence->acquire(I);
     frameCount++; // next index
@@ -359,7 +458,23 @@ one after one.
 */
 bool vpVideoReader::getFrame(vpImage<vpRGBa> &I, long frame_index)
 {
-	if (imSequence != NULL)
+	//A seek invalidates the frames read ahead
+	stopPrefetch();
+
+	if (rawSeq != NULL)
+	{
+		try
+		{
+			rawSeq->getFrame(I, frame_index);
+			frameCount = frame_index + 1; // next index
+			rawNextIndex = frame_index + 1;
+		}
+		catch(...)
+		{
+			return false;
+		}
+	}
+	else if (imSequence != NULL)
 	{
 		try
 		{
@@ -435,9 +550,146 @@ one after one.
 
 \return It returns true if the frame could be read. Else it returns false.
 */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+static vpThread::Return vpVideoReaderPrefetchThreadEntry(vpThread::Args args)
+{
+	((vpVideoReader *) args)->runPrefetchThread();
+	return 0;
+}
+
+//! Short yielding nap for the ring polls: vpTime::wait() busy-spins under
+//! a few ms, which would burn the core the decode thread needs.
+static inline void vpVideoReaderNap()
+{
+#if !defined(_WIN32)
+	usleep(200);
+#else
+	Sleep(1);
+#endif
+}
+
+//! Full memory barrier ordering the ring accesses with the index publications.
+static inline void vpVideoReaderBarrier()
+{
+#if defined(__GNUC__)
+	__sync_synchronize();
+#elif defined(_WIN32)
+	MemoryBarrier();
+#endif
+}
+#endif
+
+/*!
+  Enable the prefetching mode on image sequences: a background thread
+  decodes up to \e nbFrames frames ahead into a bounded ring, so that
+  acquire() reduces to a queue pop when the reader keeps up. The frame type
+  (grayscale or color) is fixed by the first prefetched acquire(); seeking
+  with getFrame() or setFirstFrameIndex() cancels the read-ahead, which
+  restarts from the new position at the next acquire(). Video backends keep
+  the synchronous path.
+
+  \param nbFrames : Depth of the read-ahead ring (rounded up to a power of
+  two), 0 to disable (default).
+*/
+void vpVideoReader::setPrefetch(unsigned int nbFrames)
+{
+	stopPrefetch();
+	if (nbFrames == 0) {
+		m_prefetchCapacity = 0;
+		return;
+	}
+	m_prefetchCapacity = 1;
+	while (m_prefetchCapacity < nbFrames)
+		m_prefetchCapacity *= 2;
+}
+
+/*!
+  Start the background decode thread for the given frame type (1 grayscale,
+  2 color). Internal.
+*/
+void vpVideoReader::startPrefetch(int type)
+{
+	stopPrefetch();
+	m_prefetchType = type;
+	if (type == 1)
+		m_prefetchGray.resize(m_prefetchCapacity);
+	else
+		m_prefetchColor.resize(m_prefetchCapacity);
+	m_prefetchHead = 0;
+	m_prefetchTail = 0;
+	m_prefetchEos = false;
+	m_prefetchRun = true;
+	m_prefetchThread = new vpThread((vpThread::Fn) vpVideoReaderPrefetchThreadEntry, (vpThread::Args) this);
+}
+
+/*!
+  Stop the background decode thread and discard the frames read ahead, so
+  that the underlying sequence is repositioned by the caller (seek) or the
+  reader destroyed safely. Internal; also resets the end-of-sequence latch.
+*/
+void vpVideoReader::stopPrefetch()
+{
+	if (m_prefetchThread != NULL) {
+		m_prefetchRun = false;
+		m_prefetchThread->join();
+		delete m_prefetchThread;
+		m_prefetchThread = NULL;
+	}
+	m_prefetchHead = 0;
+	m_prefetchTail = 0;
+	m_prefetchEos = false;
+	m_prefetchType = 0;
+}
+
+/*!
+  Background decode loop: keeps the ring full with the next frames of the
+  sequence, latching the end of the sequence on decode failure. Internal
+  entry point.
+*/
+void vpVideoReader::runPrefetchThread()
+{
+	while (m_prefetchRun) {
+		unsigned int head = m_prefetchHead;
+		if (head - m_prefetchTail >= m_prefetchCapacity) {
+			vpVideoReaderNap();
+			continue;
+		}
+
+		try {
+			if (m_prefetchType == 1)
+				imSequence->acquire(m_prefetchGray[head & (m_prefetchCapacity-1)]);
+			else
+				imSequence->acquire(m_prefetchColor[head & (m_prefetchCapacity-1)]);
+		}
+		catch(...) {
+			m_prefetchEos = true;
+			break;
+		}
+
+		vpVideoReaderBarrier(); //the frame must be visible before its index
+		m_prefetchHead = head + 1;
+	}
+}
+
 bool vpVideoReader::getFrame(vpImage<unsigned char> &I, long frame_index)
 {
-	if (imSequence != NULL)
+	//A seek invalidates the frames read ahead
+	stopPrefetch();
+
+	if (rawSeq != NULL)
+	{
+		try
+		{
+			rawSeq->getFrame(I, frame_index);
+			frameCount = frame_index + 1;
+			rawNextIndex = frame_index + 1;
+		}
+		catch(...)
+		{
+			return false;
+		}
+	}
+	else if (imSequence != NULL)
 	{
 		try
 		{
@@ -506,7 +758,14 @@ Gets the format of the file(s) which has/have to be read.
 */
 vpVideoReader::vpVideoFormatType
 	vpVideoReader::getFormat(const char *filename)
-{  
+{
+  {
+    std::string name(filename);
+    size_t dot = name.find_last_of(".");
+    if (dot != std::string::npos && name.substr(dot) == ".vraw")
+      return FORMAT_RAW;
+  }
+  
 	std::string sfilename(filename);
 
 	std::string ext = vpVideoReader::getExtension(sfilename);
@@ -623,8 +882,15 @@ void vpVideoReader::findLastFrameIndex()
     throw (vpException(vpException::notInitialized,"file not yet opened"));
   }
   
-  if (imSequence != NULL) {
-    if (! lastFrameIndexIsSet) {
+  if (rawSeq != NULL) {
+    if (! lastFrameIndexIsSet)
+      lastFrame = rawSeq->getFrameCount() - 1;
+  }
+  else if (imSequence != NULL) {
+    if (! lastFrameIndexIsSet && buildSequenceIndex()) {
+      lastFrame = m_seqIndexLast;
+    }
+    else if (! lastFrameIndexIsSet) {
       char name[FILENAME_MAX];
       long image_number = firstFrame;
       bool failed;
@@ -673,15 +939,100 @@ void vpVideoReader::findLastFrameIndex()
   }
 #endif
 }
+/*!
+  Build the one-time directory index of the image sequence: the sequence
+  directory is listed once and the entries matched against the filename
+  pattern, giving the first and last frame indices without probing one file
+  per index (each probe being a round trip on network filesystems). Only
+  plain "%d" / "%0Nd" patterns are indexed; anything else falls back to the
+  historic probing, as do the platforms without dirent. On a sequence with
+  holes the index reports the true extremal frames (the historic probing
+  stopped at the first hole).
+
+  \return True when the index has been built (cached for the session).
+*/
+bool vpVideoReader::buildSequenceIndex()
+{
+	if (m_seqIndexValid)
+		return true;
+
+#if !defined(_WIN32)
+	//Split the pattern around its single integer conversion
+	std::string pattern(fileName);
+	size_t pc = pattern.find('%');
+	if (pc == std::string::npos || pattern.find('%', pc+1) != std::string::npos)
+		return false;
+	size_t d = pc+1;
+	while (d < pattern.size() && isdigit((unsigned char) pattern[d]))
+		d++;
+	if (d >= pattern.size() || pattern[d] != 'd')
+		return false;
+
+	size_t slash = pattern.find_last_of('/');
+	if (slash != std::string::npos && slash > pc)
+		return false; //conversion inside the directory part
+	std::string dir = (slash == std::string::npos) ? "." : pattern.substr(0, slash);
+	std::string prefix = pattern.substr(slash+1, pc-(slash+1));
+	std::string suffix = pattern.substr(d+1);
+
+	DIR *dp = opendir(dir.c_str());
+	if (dp == NULL)
+		return false;
+
+	long first = -1, last = -1;
+	struct dirent *entry;
+	while ((entry = readdir(dp)) != NULL) {
+		std::string name(entry->d_name);
+		if (name.size() <= prefix.size() + suffix.size())
+			continue;
+		if (name.compare(0, prefix.size(), prefix) != 0)
+			continue;
+		if (name.compare(name.size()-suffix.size(), suffix.size(), suffix) != 0)
+			continue;
+		std::string digits = name.substr(prefix.size(), name.size()-suffix.size()-prefix.size());
+		if (digits.empty())
+			continue;
+		bool numeric = true;
+		for (size_t k = 0; k < digits.size(); k++)
+			if (!isdigit((unsigned char) digits[k])) { numeric = false; break; }
+		if (!numeric)
+			continue;
+		long idx = atol(digits.c_str());
+		if (first < 0 || idx < first) first = idx;
+		if (idx > last) last = idx;
+	}
+	closedir(dp);
+
+	if (first < 0)
+		return false;
+
+	m_seqIndexFirst = first;
+	m_seqIndexLast = last;
+	m_seqIndexValid = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
 /*!
 Get the first frame index (update the firstFrame attribute).
 */
 void
 	vpVideoReader::findFirstFrameIndex()
 {
-	if (imSequence != NULL)
+	if (rawSeq != NULL)
 	{
-		if (! firstFrameIndexIsSet) {
+		if (! firstFrameIndexIsSet)
+			firstFrame = 0;
+	}
+	else if (imSequence != NULL)
+	{
+		if (! firstFrameIndexIsSet && buildSequenceIndex()) {
+			firstFrame = m_seqIndexFirst;
+			imSequence->setImageNumber(firstFrame);
+		}
+		else if (! firstFrameIndexIsSet) {
 			char name[FILENAME_MAX];
 			int image_number = 0;
 			bool failed;
@@ -692,7 +1043,10 @@ void
 				failed = file.fail();
 				if (!failed) file.close();
 				image_number++;
-			} while(failed);
+			} while(failed && image_number < 100000);
+			if (failed) {
+				throw (vpException(vpException::ioError ,"Could not find the first frame of the video sequence"));
+			}
 
 			firstFrame = image_number - 1;
 			imSequence->setImageNumber(firstFrame);
@@ -44,6 +44,23 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/io/vpVideoWriter.h>
 
+#if !defined(_WIN32)
+#  include <unistd.h>
+#else
+#  include <windows.h>
+#endif
+
+//! Short yielding nap for the encode queue handshakes: vpTime::wait()
+//! busy-spins under a few ms.
+static inline void vpVideoWriterNap()
+{
+#if !defined(_WIN32)
+  usleep(200);
+#else
+  Sleep(1);
+#endif
+}
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020200
 #  include <opencv2/imgproc/imgproc.hpp>
 #endif
@@ -65,7 +82,11 @@ vpVideoWriter::vpVideoWriter() :
 #elif VISP_HAVE_OPENCV_VERSION >= 0x020100
     writer(), fourcc(0), framerate(0.),
 #endif
-    formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0),
+    formatType(FORMAT_UNKNOWN), rawSeq(NULL),
+    m_asyncEnabled(false), m_asyncCapacity(8), m_asyncPolicy(0), m_asyncType(0),
+    m_asyncGray(), m_asyncColor(), m_asyncIndex(), m_asyncCount(0), m_asyncFirst(0),
+    m_asyncErrors(0), m_asyncRun(false), m_asyncBusy(false), m_asyncMutex(), m_asyncThread(NULL),
+    initFileName(false), isOpen(false), frameCount(0),
     firstFrame(0), width(0), height(0)
 {
   initFileName = false;
@@ -160,7 +181,14 @@ void vpVideoWriter::open(vpImage< vpRGBa > &I)
     throw (vpImageException(vpImageException::noFileNameError,"filename empty"));
   }
   
-  if (formatType == FORMAT_PGM ||
+  if (formatType == FORMAT_RAW)
+  {
+    rawSeq = new vpRawSequence;
+    rawSeq->openWriting(fileName);
+    width = I.getWidth();
+    height = I.getHeight();
+  }
+  else if (formatType == FORMAT_PGM ||
       formatType == FORMAT_PPM ||
       formatType == FORMAT_JPEG ||
       formatType == FORMAT_PNG)
@@ -213,7 +241,14 @@ void vpVideoWriter::open(vpImage< unsigned char > &I)
     throw (vpImageException(vpImageException::noFileNameError,"filename empty"));
   }
   
-  if (formatType == FORMAT_PGM ||
+  if (formatType == FORMAT_RAW)
+  {
+    rawSeq = new vpRawSequence;
+    rawSeq->openWriting(fileName);
+    width = I.getWidth();
+    height = I.getHeight();
+  }
+  else if (formatType == FORMAT_PGM ||
       formatType == FORMAT_PPM ||
       formatType == FORMAT_JPEG ||
       formatType == FORMAT_PNG)
@@ -268,22 +303,73 @@ void vpVideoWriter::saveFrame (vpImage< vpRGBa > &I)
     throw (vpException(vpException::notInitialized,"file not yet opened"));
   }
 
+  if (m_asyncEnabled)
+  {
+    //Queue the frame for the background encoder; the frame type is fixed
+    //by the first queued frame
+    int type = 2;
+    if (m_asyncThread == NULL)
+      startAsync(type);
+    if (m_asyncType != type)
+      throw (vpException(vpException::badValue, "Asynchronous encoding queue already bound to the other frame type"));
+
+    for (;;) {
+      m_asyncMutex.lock();
+      if (m_asyncCount < m_asyncCapacity) {
+        unsigned int slot = (m_asyncFirst + m_asyncCount) % m_asyncCapacity;
+        m_asyncColor[slot] = I;
+        m_asyncIndex[slot] = frameCount;
+        m_asyncCount++;
+        m_asyncMutex.unlock();
+        break;
+      }
+      if (m_asyncPolicy == (int) ASYNC_DROP_OLDEST) {
+        //Discard the oldest queued frame to make room
+        m_asyncFirst = (m_asyncFirst + 1) % m_asyncCapacity;
+        m_asyncCount--;
+        m_asyncMutex.unlock();
+        continue;
+      }
+      m_asyncMutex.unlock();
+      vpVideoWriterNap(); //ASYNC_BLOCK: wait for the encoder
+    }
+
+    frameCount++;
+    return;
+  }
+
+  saveFrameSync(I, frameCount);
+  frameCount++;
+}
+
+void vpVideoWriter::saveFrameSync (const vpImage< vpRGBa > &I, long index)
+{
+  if (!isOpen)
+  {
+    vpERROR_TRACE("The video has to be open first with the open method");
+    throw (vpException(vpException::notInitialized,"file not yet opened"));
+  }
+
   
-  if (formatType == FORMAT_PGM ||
+  if (formatType == FORMAT_RAW)
+  {
+    rawSeq->writeFrame(I);
+  }
+  else if (formatType == FORMAT_PGM ||
       formatType == FORMAT_PPM ||
       formatType == FORMAT_JPEG ||
       formatType == FORMAT_PNG)
   {
     char name[FILENAME_MAX];
 
-    sprintf(name,fileName,frameCount);
+    sprintf(name,fileName,index);
 
     vpImageIo::write(I, name);
   }
   else
   {
 #ifdef VISP_HAVE_FFMPEG
-    ffmpeg->saveFrame(I);
+    ffmpeg->saveFrame(const_cast<vpImage< vpRGBa > &>(I));
 #elif VISP_HAVE_OPENCV_VERSION >= 0x020100
 	  cv::Mat matFrame;
 	  vpImageConvert::convert(I, matFrame);
@@ -291,7 +377,6 @@ void vpVideoWriter::saveFrame (vpImage< vpRGBa > &I)
 #endif
   }
 
-  frameCount++;
 }
 
 
@@ -310,21 +395,72 @@ void vpVideoWriter::saveFrame (vpImage< unsigned char > &I)
     throw (vpException(vpException::notInitialized,"file not yet opened"));
   }
 
-  if (formatType == FORMAT_PGM ||
+  if (m_asyncEnabled)
+  {
+    //Queue the frame for the background encoder; the frame type is fixed
+    //by the first queued frame
+    int type = 1;
+    if (m_asyncThread == NULL)
+      startAsync(type);
+    if (m_asyncType != type)
+      throw (vpException(vpException::badValue, "Asynchronous encoding queue already bound to the other frame type"));
+
+    for (;;) {
+      m_asyncMutex.lock();
+      if (m_asyncCount < m_asyncCapacity) {
+        unsigned int slot = (m_asyncFirst + m_asyncCount) % m_asyncCapacity;
+        m_asyncGray[slot] = I;
+        m_asyncIndex[slot] = frameCount;
+        m_asyncCount++;
+        m_asyncMutex.unlock();
+        break;
+      }
+      if (m_asyncPolicy == (int) ASYNC_DROP_OLDEST) {
+        //Discard the oldest queued frame to make room
+        m_asyncFirst = (m_asyncFirst + 1) % m_asyncCapacity;
+        m_asyncCount--;
+        m_asyncMutex.unlock();
+        continue;
+      }
+      m_asyncMutex.unlock();
+      vpVideoWriterNap(); //ASYNC_BLOCK: wait for the encoder
+    }
+
+    frameCount++;
+    return;
+  }
+
+  saveFrameSync(I, frameCount);
+  frameCount++;
+}
+
+void vpVideoWriter::saveFrameSync (const vpImage< unsigned char > &I, long index)
+{
+  if (!isOpen)
+  {
+    vpERROR_TRACE("The video has to be open first with the open method");
+    throw (vpException(vpException::notInitialized,"file not yet opened"));
+  }
+
+  if (formatType == FORMAT_RAW)
+  {
+    rawSeq->writeFrame(I);
+  }
+  else if (formatType == FORMAT_PGM ||
       formatType == FORMAT_PPM ||
       formatType == FORMAT_JPEG ||
       formatType == FORMAT_PNG)
   {
     char name[FILENAME_MAX];
 
-    sprintf(name,fileName,frameCount);
+    sprintf(name,fileName,index);
 
     vpImageIo::write(I, name);
   }
   else
   {
 #ifdef VISP_HAVE_FFMPEG
-    ffmpeg->saveFrame(I);
+    ffmpeg->saveFrame(const_cast<vpImage< unsigned char > &>(I));
 #elif VISP_HAVE_OPENCV_VERSION >= 0x030000
     cv::Mat matFrame, rgbMatFrame;
     vpImageConvert::convert(I, matFrame);
@@ -338,15 +474,161 @@ void vpVideoWriter::saveFrame (vpImage< unsigned char > &I)
 #endif
   }
 
-  frameCount++;
 }
 
 
 /*!
   Deallocates parameters use to write the video or the image sequence.
 */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+static vpThread::Return vpVideoWriterAsyncThreadEntry(vpThread::Args args)
+{
+  ((vpVideoWriter *) args)->runAsyncThread();
+  return 0;
+}
+#endif
+
+/*!
+  Enable the asynchronous encoding mode: saveFrame() copies the frame into a
+  bounded queue consumed by a background encoder thread, so the caller never
+  pays the per-frame encode (PNG/JPEG compression, video encoder spikes).
+  With the ASYNC_BLOCK policy a full queue makes saveFrame() wait for the
+  encoder; with ASYNC_DROP_OLDEST the oldest queued frame is discarded
+  instead. close() (or flush()) drains the queue before returning, so no
+  accepted frame is lost on a clean shutdown. Frames are encoded in the
+  order they were queued.
+
+  \param enable : True to queue the frames, false (default) to encode in
+  the caller's thread.
+  \param queueSize : Depth of the frame queue.
+  \param policy : Backpressure policy when the queue is full.
+*/
+void vpVideoWriter::setAsyncEncoding(bool enable, unsigned int queueSize, vpAsyncPolicy policy)
+{
+  if (!enable)
+    stopAsync();
+  m_asyncEnabled = enable;
+  m_asyncCapacity = (queueSize == 0) ? 1 : queueSize;
+  m_asyncPolicy = (int) policy;
+}
+
+/*!
+  Start the encoder thread and size the queue for the bound frame type.
+  Internal.
+*/
+void vpVideoWriter::startAsync(int type)
+{
+  stopAsync();
+  m_asyncType = type;
+  if (m_asyncType == 1)
+    m_asyncGray.resize(m_asyncCapacity);
+  else
+    m_asyncColor.resize(m_asyncCapacity);
+  m_asyncIndex.resize(m_asyncCapacity);
+  m_asyncCount = 0;
+  m_asyncFirst = 0;
+  m_asyncErrors = 0;
+  m_asyncRun = true;
+  m_asyncBusy = false;
+  m_asyncThread = new vpThread((vpThread::Fn) vpVideoWriterAsyncThreadEntry, (vpThread::Args) this);
+}
+
+/*!
+  Drain the queue and stop the encoder thread. Internal.
+*/
+void vpVideoWriter::stopAsync()
+{
+  if (m_asyncThread != NULL) {
+    flush();
+    m_asyncRun = false;
+    m_asyncThread->join();
+    delete m_asyncThread;
+    m_asyncThread = NULL;
+  }
+  m_asyncType = 0;
+}
+
+/*!
+  Wait until every queued frame has been encoded. Harmless when the
+  asynchronous mode is off.
+*/
+void vpVideoWriter::flush()
+{
+  if (m_asyncThread == NULL)
+    return;
+  for (;;) {
+    m_asyncMutex.lock();
+    bool empty = (m_asyncCount == 0) && !m_asyncBusy;
+    m_asyncMutex.unlock();
+    if (empty)
+      return;
+    vpVideoWriterNap();
+  }
+}
+
+/*!
+  Background encoder loop: pops the oldest queued frame and encodes it with
+  the synchronous path. Internal entry point.
+*/
+void vpVideoWriter::runAsyncThread()
+{
+  vpImage<unsigned char> gray;
+  vpImage<vpRGBa> color;
+
+  for (;;) {
+    long index = 0;
+    bool has = false;
+
+    m_asyncMutex.lock();
+    if (m_asyncCount > 0) {
+      unsigned int slot = m_asyncFirst;
+      index = m_asyncIndex[slot];
+      if (m_asyncType == 1)
+        gray = m_asyncGray[slot];
+      else
+        color = m_asyncColor[slot];
+      m_asyncFirst = (m_asyncFirst + 1) % m_asyncCapacity;
+      m_asyncCount--;
+      m_asyncBusy = true;
+      has = true;
+    }
+    m_asyncMutex.unlock();
+
+    if (!has) {
+      if (!m_asyncRun)
+        break;
+      vpVideoWriterNap();
+      continue;
+    }
+
+    try {
+      if (m_asyncType == 1)
+        saveFrameSync(gray, index);
+      else
+        saveFrameSync(color, index);
+    }
+    catch(...) {
+      //An encode failure must not kill the thread; the frame is lost and
+      //accounted, see getAsyncEncodingErrors()
+      m_asyncErrors = m_asyncErrors + 1;
+    }
+
+    m_asyncMutex.lock();
+    m_asyncBusy = false;
+    m_asyncMutex.unlock();
+  }
+}
+
 void vpVideoWriter::close()
 {
+  stopAsync();
+
+  if (rawSeq != NULL)
+  {
+    rawSeq->close();
+    delete rawSeq;
+    rawSeq = NULL;
+  }
   if (!isOpen)
   {
     vpERROR_TRACE("The video has to be open first with the open method");
@@ -369,6 +651,13 @@ void vpVideoWriter::close()
 vpVideoWriter::vpVideoFormatType
 vpVideoWriter::getFormat(const char *filename)
 {
+  {
+    std::string fname(filename);
+    size_t dot = fname.find_last_of(".");
+    if (dot != std::string::npos && fname.substr(dot) == ".vraw")
+      return FORMAT_RAW;
+  }
+
   std::string sfilename(filename);
 
   std::string ext = vpVideoWriter::getExtension(sfilename);
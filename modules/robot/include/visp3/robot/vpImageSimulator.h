@@ -299,6 +299,9 @@ class VISP_EXPORT vpImageSimulator
     
     void getRoi(const unsigned int &Iwidth, const unsigned int &Iheight, 
         const vpCameraParameters &cam, const std::vector<vpPoint> &point, vpRect &rect);
+
+    //Geometry setup cache for consecutive calls with an unchanged pose
+    bool m_poseCached;
 };
 
 
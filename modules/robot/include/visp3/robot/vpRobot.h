@@ -45,6 +45,8 @@
 
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpTime.h>
+#include <vector>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpPoseVector.h>
 
@@ -112,6 +114,67 @@ protected:
 
   bool verbose_;
 
+public:
+  //! Callback fired by the loop monitor when a cycle overruns the deadline.
+  typedef void (*vpLoopOverrunCallback)(void *user_data, const double &cycleMs);
+
+  /*!
+    Timing statistics of the control loop, see setLoopMonitor(). A cycle
+    is the interval between two consecutive velocity writes.
+  */
+  struct vpLoopMonitorStats
+  {
+    unsigned long nbCycles;       //!< Number of completed cycles.
+    unsigned long nbDeadlineMiss; //!< Cycles longer than the deadline.
+    double lastMs;                //!< Duration of the last cycle, in ms.
+    double minMs;                 //!< Shortest cycle, in ms.
+    double maxMs;                 //!< Longest cycle, in ms.
+    double meanMs;                //!< Mean cycle duration, in ms.
+    double lastStateReadMs;      //!< Duration of the last state read, in ms.
+    double lastVelocityWriteMs;  //!< Duration of the last velocity write, in ms.
+
+    vpLoopMonitorStats()
+      : nbCycles(0), nbDeadlineMiss(0), lastMs(0.), minMs(0.), maxMs(0.),
+        meanMs(0.), lastStateReadMs(0.), lastVelocityWriteMs(0.) {}
+  };
+
+protected:
+  //Loop monitor state, written by the control thread only
+  bool m_monitorEnabled;
+  double m_monitorDeadlineMs;
+  vpLoopOverrunCallback m_monitorCallback;
+  void *m_monitorCallbackData;
+  double m_monitorLastWriteEnd;
+  double m_monitorTotalMs;
+  vpLoopMonitorStats m_monitorStats;
+  //Jitter histogram : 100 bins of m_monitorBinMs plus one overflow bin
+  double m_monitorBinMs;
+  volatile unsigned int m_monitorHistogram[101];
+
+  void monitorStateReadBegin(double &t0) const
+  {
+    if (m_monitorEnabled)
+      t0 = vpTime::measureTimeMicros();
+  }
+  void monitorStateReadEnd(const double &t0)
+  {
+    if (m_monitorEnabled)
+      m_monitorStats.lastStateReadMs = (vpTime::measureTimeMicros() - t0) / 1000.;
+  }
+  void monitorVelocityWriteBegin(double &t0) const
+  {
+    if (m_monitorEnabled)
+      t0 = vpTime::measureTimeMicros();
+  }
+  void monitorVelocityWriteEnd(const double &t0);
+
+public:
+  void setLoopMonitor(bool enable, const double &deadlineMs = 0., const double &histogramBinMs = 0.1);
+  void setLoopOverrunCallback(vpLoopOverrunCallback callback, void *user_data);
+  vpLoopMonitorStats getLoopMonitorStats() const;
+  void getLoopJitterHistogram(std::vector<unsigned int> &bins, double &binMs) const;
+  void resetLoopMonitor();
+
 public:
   vpRobot (void);
   vpRobot (const vpRobot &robot);
@@ -58,6 +58,7 @@
 #include <visp3/robot/vpWireFrameSimulator.h>
 #include <visp3/robot/vpRobot.h>
 #include <visp3/robot/vpRobotSimulator.h>
+#include <visp3/core/vpSeqLock.h>
 #include <visp3/gui/vpDisplayOpenCV.h>
 #include <visp3/gui/vpDisplayX.h>
 #include <visp3/gui/vpDisplayGTK.h>
@@ -116,6 +117,17 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
     /*! The velocity in the current frame (articular, camera or reference)*/
     vpColVector velocity;
 
+    //! Fixed-size joint vector snapshot exchanged through vpSeqLock
+    struct vpJointStateData {
+      double value[12];
+      unsigned int size;
+    };
+    //Wait-free published copies of the hot articular state : the control
+    //loop reads them without contending with the simulation thread
+    vpSeqLock<vpJointStateData> artCoordState;
+    vpSeqLock<vpJointStateData> artVelState;
+    vpSeqLock<vpJointStateData> velocityState;
+
 #if defined(_WIN32)
     HANDLE hThread;
     HANDLE mutex_fMi;
@@ -383,38 +395,43 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
     void initDisplay() {;}
     virtual void initArms() = 0;
 
-	#if defined(_WIN32)
+    //The articular state is exchanged through wait-free sequence locks :
+    //the 1 kHz control loop never blocks on the display or simulation
+    //thread, the mutexes remain for the display handshake only
     vpColVector get_artCoord() const {
-      WaitForSingleObject(mutex_artCoord,INFINITE);
-      vpColVector artCoordTmp (6);
-      artCoordTmp = artCoord;
-      ReleaseMutex(mutex_artCoord);
-      return artCoordTmp;}
+      vpJointStateData state = artCoordState.read();
+      vpColVector v(state.size);
+      for (unsigned int i = 0; i < state.size; i++) v[i] = state.value[i];
+      return v;}
     void set_artCoord(const vpColVector &coord) {
-      WaitForSingleObject(mutex_artCoord,INFINITE);
-      artCoord = coord;
-      ReleaseMutex(mutex_artCoord);}
-    
+      vpJointStateData state;
+      state.size = coord.getRows() < 12 ? coord.getRows() : 12;
+      for (unsigned int i = 0; i < state.size; i++) state.value[i] = coord[i];
+      artCoordState.write(state);}
+
     vpColVector get_artVel() const {
-      WaitForSingleObject(mutex_artVel,INFINITE);
-      vpColVector artVelTmp (artVel);
-      ReleaseMutex(mutex_artVel);
-      return artVelTmp;}
+      vpJointStateData state = artVelState.read();
+      vpColVector v(state.size);
+      for (unsigned int i = 0; i < state.size; i++) v[i] = state.value[i];
+      return v;}
     void set_artVel(const vpColVector &vel) {
-      WaitForSingleObject(mutex_artVel,INFINITE);
-      artVel = vel;
-      ReleaseMutex(mutex_artVel);}
-    
-    vpColVector get_velocity() {
-      WaitForSingleObject(mutex_velocity,INFINITE);
-      vpColVector velocityTmp = velocity;
-      ReleaseMutex(mutex_velocity);
-      return velocityTmp;}
+      vpJointStateData state;
+      state.size = vel.getRows() < 12 ? vel.getRows() : 12;
+      for (unsigned int i = 0; i < state.size; i++) state.value[i] = vel[i];
+      artVelState.write(state);}
+
+    vpColVector get_velocity() const {
+      vpJointStateData state = velocityState.read();
+      vpColVector v(state.size);
+      for (unsigned int i = 0; i < state.size; i++) v[i] = state.value[i];
+      return v;}
     void set_velocity(const vpColVector &vel) {
-      WaitForSingleObject(mutex_velocity,INFINITE);
-      velocity = vel;
-      ReleaseMutex(mutex_velocity);}
-      
+      vpJointStateData state;
+      state.size = vel.getRows() < 12 ? vel.getRows() : 12;
+      for (unsigned int i = 0; i < state.size; i++) state.value[i] = vel[i];
+      velocityState.write(state);}
+
+	#if defined(_WIN32)
     void set_displayBusy (const bool &status) {
       WaitForSingleObject(mutex_display,INFINITE);
       displayBusy = status;
@@ -427,37 +444,6 @@ class VISP_EXPORT vpRobotWireFrameSimulator : protected vpWireFrameSimulator, pu
       return status;}
 
     #elif defined(VISP_HAVE_PTHREAD)
-    vpColVector get_artCoord() {
-      pthread_mutex_lock (&mutex_artCoord);
-      vpColVector artCoordTmp (6);
-      artCoordTmp = artCoord;
-      pthread_mutex_unlock (&mutex_artCoord);
-      return artCoordTmp;}
-    void set_artCoord(const vpColVector &coord) {
-      pthread_mutex_lock (&mutex_artCoord);
-      artCoord = coord;
-      pthread_mutex_unlock (&mutex_artCoord);}
-    
-    vpColVector get_artVel() {
-      pthread_mutex_lock (&mutex_artVel);
-      vpColVector artVelTmp (artVel);
-      pthread_mutex_unlock (&mutex_artVel);
-      return artVelTmp;}
-    void set_artVel(const vpColVector &vel) {
-      pthread_mutex_lock (&mutex_artVel);
-      artVel = vel;
-      pthread_mutex_unlock (&mutex_artVel);}
-    
-    vpColVector get_velocity() {
-      pthread_mutex_lock (&mutex_velocity);
-      vpColVector velocityTmp = velocity;
-      pthread_mutex_unlock (&mutex_velocity);
-      return velocityTmp;}
-    void set_velocity(const vpColVector &vel) {
-      pthread_mutex_lock (&mutex_velocity);
-      velocity = vel;
-      pthread_mutex_unlock (&mutex_velocity);}
-      
     void set_displayBusy (const bool &status) {
       pthread_mutex_lock (&mutex_display);
       displayBusy = status;
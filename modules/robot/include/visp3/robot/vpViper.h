@@ -47,6 +47,7 @@
 */
 
 #include <visp3/core/vpHomogeneousMatrix.h>
+#include <vector>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpCameraParameters.h>
@@ -134,6 +135,9 @@ class VISP_EXPORT vpViper
   void get_fJe(const vpColVector &q, vpMatrix &fJe) const;
   void get_eJe(const vpColVector &q, vpMatrix &eJe) const;
 
+  void get_fJe(const std::vector<vpColVector> &q, vpMatrix &fJe) const;
+  void get_eJe(const std::vector<vpColVector> &q, vpMatrix &eJe) const;
+
   virtual void set_eMc(const vpHomogeneousMatrix &eMc_);
   virtual void set_eMc(const vpTranslationVector &etc_, const vpRxyzVector &erc_);
 
@@ -147,6 +151,10 @@ class VISP_EXPORT vpViper
  private:
   bool convertJointPositionInLimits(unsigned int joint, const double &q, double &q_mod, const bool &verbose=false) const;
 
+  void computeSinCos(const vpColVector &q, double *c, double *s) const;
+  void get_fMw(const double *c, const double *s, vpHomogeneousMatrix &fMw) const;
+  void get_fJw(const double *c, const double *s, vpMatrix &fJw) const;
+
  public:
   static const unsigned int njoint; ///< Number of joint.
 
@@ -168,6 +176,13 @@ class VISP_EXPORT vpViper
   // Software joint limits in radians
   vpColVector joint_max; // Maximal value of the joints
   vpColVector joint_min; // Minimal value of the joints
+
+ private:
+  //Memoization of the last inverse kinematics call
+  mutable bool m_ikCacheValid;
+  mutable double m_ikCacheKey[18];
+  mutable vpColVector m_ikCacheSol;
+  mutable unsigned int m_ikCacheNbSol;
 };
 
 #endif
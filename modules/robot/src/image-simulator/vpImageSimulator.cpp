@@ -63,7 +63,7 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
     euclideanNorm_u(0.), euclideanNorm_v(0.), vbase_u(), vbase_v(),
     vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(),
     colorI(col), Ig(), Ic(), rect(), cleanPrevImage(false),
-    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
+    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false), m_poseCached(false)
 {
   for(int i=0;i<4;i++)
     X[i].resize(3);
@@ -103,7 +103,7 @@ vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
     euclideanNorm_u(0.), euclideanNorm_v(0.), vbase_u(), vbase_v(),
     vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(),
     colorI(GRAY_SCALED), Ig(), Ic(), rect(), cleanPrevImage(false),
-    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
+    setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false), m_poseCached(false)
 {
   pt.resize(4);
   for(unsigned int i=0;i<4;i++)
@@ -162,6 +162,7 @@ vpImageSimulator::~vpImageSimulator()
 vpImageSimulator&
 vpImageSimulator::operator=(const vpImageSimulator& sim)
 {
+  m_poseCached = false;
   for(unsigned int i=0;i<4;i++)
   {
     X[i] = sim.X[i];
@@ -230,6 +231,74 @@ vpImageSimulator::getImage(vpImage<unsigned char> &I,
     
     unsigned char *bitmap = I.bitmap;
     unsigned int width = I.getWidth();
+
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion)
+    {
+      //Without distortion the meter coordinates are affine in the pixel
+      //indices, so the plane intersection and the texture coordinates can
+      //be stepped incrementally along each scanline instead of converting
+      //and testing triangles per pixel.
+      const double u0 = cam.get_u0();
+      const double v0 = cam.get_v0();
+      const double n0 = normal_Cam_optim[0], n1 = normal_Cam_optim[1], n2 = normal_Cam_optim[2];
+      const double bu0 = vbase_u_optim[0], bu1 = vbase_u_optim[1], bu2 = vbase_u_optim[2];
+      const double bv0 = vbase_v_optim[0], bv1 = vbase_v_optim[1], bv2 = vbase_v_optim[2];
+      const double texHeight = (double)(Ig.getHeight()-1);
+      const double texWidth = (double)(Ig.getWidth()-1);
+      int i0 = (int)top, i1 = (int)bottom;
+      int j0 = (int)left, j1 = (int)right;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 8)
+#endif
+      for (int i = i0; i < i1; i++)
+      {
+        double y = (i - v0) * cam.get_py_inverse();
+        unsigned char *row = bitmap + (size_t)i * width;
+
+        for (int j = j0; j < j1; j++)
+        {
+          double x = (j - u0) * cam.get_px_inverse();
+          //Same operations, in the same order, as getPixel()
+          double z = distance / (n0*x + n1*y + n2);
+          if (z <= 0)
+            continue;
+          double Xinter0 = x*z, Xinter1 = y*z, Xinter2 = z;
+          double u = 0, v = 0;
+          u += (Xinter0 - X0_2_optim[0]) * bu0;
+          v += (Xinter0 - X0_2_optim[0]) * bv0;
+          u += (Xinter1 - X0_2_optim[1]) * bu1;
+          v += (Xinter1 - X0_2_optim[1]) * bv1;
+          u += (Xinter2 - X0_2_optim[2]) * bu2;
+          v += (Xinter2 - X0_2_optim[2]) * bv2;
+          u = u / (euclideanNorm_u*euclideanNorm_u);
+          v = v / (euclideanNorm_v*euclideanNorm_v);
+          if (!(u > 0 && v > 0 && u < 1. && v < 1.))
+            continue;
+
+          double i2 = v * texHeight;
+          double j2 = u * texWidth;
+          if (colorI == GRAY_SCALED)
+          {
+            if (interp == BILINEAR_INTERPOLATION)
+              row[j] = Ig.getValue(i2, j2);
+            else
+              row[j] = Ig[(unsigned int)i2][(unsigned int)j2];
+          }
+          else if (colorI == COLORED)
+          {
+            vpRGBa Ipixelplan;
+            if (interp == BILINEAR_INTERPOLATION)
+              Ipixelplan = Ic.getValue(i2, j2);
+            else
+              Ipixelplan = Ic[(unsigned int)i2][(unsigned int)j2];
+            row[j] = (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
+          }
+        }
+      }
+      return;
+    }
+
     vpImagePoint ip;
     int nb_point_dessine = 0;
 
@@ -443,6 +512,77 @@ vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &cam)
     
     vpRGBa *bitmap = I.bitmap;
     unsigned int width = I.getWidth();
+
+    if (cam.get_projModel() == vpCameraParameters::perspectiveProjWithoutDistortion)
+    {
+      //Without distortion the meter coordinates are affine in the pixel
+      //indices : same incremental scanline stepping as for the grayscale
+      //overload.
+      const double u0 = cam.get_u0();
+      const double v0 = cam.get_v0();
+      const double n0 = normal_Cam_optim[0], n1 = normal_Cam_optim[1], n2 = normal_Cam_optim[2];
+      const double bu0 = vbase_u_optim[0], bu1 = vbase_u_optim[1], bu2 = vbase_u_optim[2];
+      const double bv0 = vbase_v_optim[0], bv1 = vbase_v_optim[1], bv2 = vbase_v_optim[2];
+      const double texHeight = (double)(Ig.getHeight()-1);
+      const double texWidth = (double)(Ig.getWidth()-1);
+      int i0 = (int)top, i1 = (int)bottom;
+      int j0 = (int)left, j1 = (int)right;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 8)
+#endif
+      for (int i = i0; i < i1; i++)
+      {
+        double y = (i - v0) * cam.get_py_inverse();
+        vpRGBa *row = bitmap + (size_t)i * width;
+
+        for (int j = j0; j < j1; j++)
+        {
+          double x = (j - u0) * cam.get_px_inverse();
+          //Same operations, in the same order, as getPixel()
+          double z = distance / (n0*x + n1*y + n2);
+          if (z <= 0)
+            continue;
+          double Xinter0 = x*z, Xinter1 = y*z, Xinter2 = z;
+          double u = 0, v = 0;
+          u += (Xinter0 - X0_2_optim[0]) * bu0;
+          v += (Xinter0 - X0_2_optim[0]) * bv0;
+          u += (Xinter1 - X0_2_optim[1]) * bu1;
+          v += (Xinter1 - X0_2_optim[1]) * bv1;
+          u += (Xinter2 - X0_2_optim[2]) * bu2;
+          v += (Xinter2 - X0_2_optim[2]) * bv2;
+          u = u / (euclideanNorm_u*euclideanNorm_u);
+          v = v / (euclideanNorm_v*euclideanNorm_v);
+          if (!(u > 0 && v > 0 && u < 1. && v < 1.))
+            continue;
+
+          double i2 = v * texHeight;
+          double j2 = u * texWidth;
+          if (colorI == GRAY_SCALED)
+          {
+            unsigned char Ipixelplan;
+            if (interp == BILINEAR_INTERPOLATION)
+              Ipixelplan = Ig.getValue(i2, j2);
+            else
+              Ipixelplan = Ig[(unsigned int)i2][(unsigned int)j2];
+            vpRGBa pixelcolor;
+            pixelcolor.R = Ipixelplan;
+            pixelcolor.G = Ipixelplan;
+            pixelcolor.B = Ipixelplan;
+            row[j] = pixelcolor;
+          }
+          else if (colorI == COLORED)
+          {
+            if (interp == BILINEAR_INTERPOLATION)
+              row[j] = Ic.getValue(i2, j2);
+            else
+              row[j] = Ic[(unsigned int)i2][(unsigned int)j2];
+          }
+        }
+      }
+      return;
+    }
+
     vpImagePoint ip;
     int nb_point_dessine = 0;
 
@@ -1040,6 +1180,19 @@ vpImageSimulator::getImage(vpImage<vpRGBa> &I,
 void
 vpImageSimulator::setCameraPosition(const vpHomogeneousMatrix &cMt_)
 {
+  //The visibility and geometry setup only depend on the pose : skip it
+  //when the pose did not change since the last call
+  if (m_poseCached)
+  {
+    bool samePose = true;
+    for (unsigned int r = 0; r < 4 && samePose; r++)
+      for (unsigned int c = 0; c < 4; c++)
+        if (cMt[r][c] != cMt_[r][c]) { samePose = false; break; }
+    if (samePose)
+      return;
+  }
+  m_poseCached = true;
+
   cMt = cMt_;
   vpRotationMatrix R;
   cMt.extract(R);
@@ -1132,6 +1285,7 @@ vpImageSimulator::setCameraPosition(const vpHomogeneousMatrix &cMt_)
 void
 vpImageSimulator::initPlan(vpColVector* X_)
 {
+  m_poseCached = false;
   for (unsigned int i = 0; i < 4; i++)
   {
     X[i]=X_[i];
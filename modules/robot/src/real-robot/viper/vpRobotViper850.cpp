@@ -1514,6 +1514,9 @@ int main()
 void vpRobotViper850::getPosition(const vpRobot::vpControlFrameType frame,
                                   vpColVector & position, double &timestamp)
 {
+  double monitor_t0 = 0.;
+  monitorStateReadBegin(monitor_t0);
+
 
   InitTry;
 
@@ -1569,6 +1572,7 @@ void vpRobotViper850::getPosition(const vpRobot::vpControlFrameType frame,
                             "Cannot get position.");
   }
 
+  monitorStateReadEnd(monitor_t0);
   return;
 }
 
@@ -1734,6 +1738,9 @@ int main()
 void vpRobotViper850::setVelocity(const vpRobot::vpControlFrameType frame,
                                   const vpColVector & vel)
 {
+  double monitor_t0 = 0.;
+  monitorVelocityWriteBegin(monitor_t0);
+
   if (vpRobot::STATE_VELOCITY_CONTROL != getRobotState ()) {
     vpERROR_TRACE ("Cannot send a velocity to the robot "
                    "use setRobotState(vpRobot::STATE_VELOCITY_CONTROL) first) ");
@@ -1838,6 +1845,7 @@ void vpRobotViper850::setVelocity(const vpRobot::vpControlFrameType frame,
     }
   }
 
+  monitorVelocityWriteEnd(monitor_t0);
   return;
 }
 
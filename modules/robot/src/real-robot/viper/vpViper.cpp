@@ -64,7 +64,8 @@ const unsigned int vpViper::njoint = 6;
 
 */
 vpViper::vpViper()
-  : eMc(), etc(), erc(), a1(0), d1(0), a2(), a3(), d4(0), d6(0), d7(0), c56(0), joint_max(), joint_min()
+  : eMc(), etc(), erc(), a1(0), d1(0), a2(), a3(), d4(0), d6(0), d7(0), c56(0), joint_max(), joint_min(),
+    m_ikCacheValid(false), m_ikCacheSol(), m_ikCacheNbSol(0)
 {
   // Default values are initialized
 
@@ -224,10 +225,36 @@ vpViper::convertJointPositionInLimits(unsigned int joint, const double &q, doubl
 
   \sa getForwardKinematics(), getInverseKinematics()
 
+
+  \warning The result of the last call is memoized inside the object, so
+  repeating a call with the same pose and current position is free;
+  concurrent calls on one instance are not supported.
 */
 unsigned int
 vpViper::getInverseKinematicsWrist(const vpHomogeneousMatrix & fMw, vpColVector & q, const bool &verbose) const
 {
+  //Memoization : a planner line search queries the same pose with the
+  //same current position several times per cycle
+  if (m_ikCacheValid && q.getRows() == njoint) {
+    bool sameCall = true;
+    for (unsigned int i = 0; i < 3 && sameCall; i++)
+      for (unsigned int j = 0; j < 4; j++)
+        if (m_ikCacheKey[4*i + j] != fMw[i][j]) { sameCall = false; break; }
+    for (unsigned int i = 0; i < 6 && sameCall; i++)
+      if (m_ikCacheKey[12 + i] != q[i]) sameCall = false;
+    if (sameCall) {
+      if (m_ikCacheNbSol)
+        q = m_ikCacheSol;
+      return m_ikCacheNbSol;
+    }
+  }
+  bool ikCacheKeyComplete = (q.getRows() == njoint);
+  for (unsigned int i = 0; i < 3; i++)
+    for (unsigned int j = 0; j < 4; j++)
+      m_ikCacheKey[4*i + j] = fMw[i][j];
+  for (unsigned int i = 0; i < 6 && ikCacheKeyComplete; i++)
+    m_ikCacheKey[12 + i] = q[i];
+
   vpColVector q_sol[8];
 
   for (unsigned int i=0; i<8; i++)
@@ -516,6 +543,9 @@ vpViper::getInverseKinematicsWrist(const vpHomogeneousMatrix & fMw, vpColVector
     //     std::cout << "Nearest solution (" << sol << ") with distance ("
     // 	      << dist[sol] << "): " << q_sol[sol].t() << std::endl;
   }
+  m_ikCacheSol = q;
+  m_ikCacheNbSol = nbsol;
+  m_ikCacheValid = ikCacheKeyComplete;
   return nbsol;
 
 }
@@ -828,36 +858,47 @@ vpViper::get_fMe(const vpColVector & q, vpHomogeneousMatrix & fMe) const
 void
 vpViper::get_fMw(const vpColVector & q, vpHomogeneousMatrix & fMw) const
 {
-  double q1 = q[0];
-  double q2 = q[1];
-  double q3 = q[2];
-  double q4 = q[3];
-  double q5 = q[4];
-  double q6 = q[5];
-  //  We turn off the coupling since the measured positions are joint position
-  //  taking into account the coupling factor. The coupling factor is relevant
-  //  if positions are motor position.
-  // double q6 = q[5] + c56 * q[4];
+  double c[7], s[7];
+  computeSinCos(q, c, s);
+  get_fMw(c, s, fMw);
+}
 
-//   std::cout << "q6 motor: " << q[5] << " rad " 
-// 	    << vpMath::deg(q[5]) << " deg" << std::endl;
-//   std::cout << "q6 joint: " << q6 << " rad " 
-// 	    << vpMath::deg(q6) << " deg" << std::endl;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Compute the sine and cosine of every joint of \e q (plus the q2+q3
+  combination at the index 6), each through one sincos() evaluation where
+  the libc provides it.
+*/
+void
+vpViper::computeSinCos(const vpColVector &q, double *c, double *s) const
+{
+#if defined(__GLIBC__)
+  for (unsigned int i = 0; i < 6; i++)
+    sincos(q[i], &s[i], &c[i]);
+  sincos(q[1] + q[2], &s[6], &c[6]);
+#else
+  for (unsigned int i = 0; i < 6; i++) {
+    c[i] = cos(q[i]);
+    s[i] = sin(q[i]);
+  }
+  c[6] = cos(q[1] + q[2]);
+  s[6] = sin(q[1] + q[2]);
+#endif
+}
 
-  double c1 = cos(q1);
-  double s1 = sin(q1);
-  double c2 = cos(q2);
-  double s2 = sin(q2);
-  //  double c3 = cos(q3);
-  //double s3 = sin(q3);
-  double c4 = cos(q4);
-  double s4 = sin(q4);
-  double c5 = cos(q5);
-  double s5 = sin(q5);
-  double c6 = cos(q6);
-  double s6 = sin(q6);
-  double c23 = cos(q2+q3);
-  double s23 = sin(q2+q3);
+/*!
+  Body of get_fMw(), from the precomputed sines and cosines of
+  computeSinCos().
+*/
+void
+vpViper::get_fMw(const double *c_, const double *s_, vpHomogeneousMatrix & fMw) const
+{
+  double c1 = c_[0], s1 = s_[0];
+  double c2 = c_[1], s2 = s_[1];
+  double c4 = c_[3], s4 = s_[3];
+  double c5 = c_[4], s5 = s_[4];
+  double c6 = c_[5], s6 = s_[5];
+  double c23 = c_[6], s23 = s_[6];
 
   fMw[0][0] = c1*(c23*(c4*c5*c6-s4*s6)-s23*s5*c6)-s1*(s4*c5*c6+c4*s6);
   fMw[1][0] = -s1*(c23*(-c4*c5*c6+s4*s6)+s23*s5*c6)+c1*(s4*c5*c6+c4*s6);
@@ -879,6 +920,7 @@ vpViper::get_fMw(const vpColVector & q, vpHomogeneousMatrix & fMw) const
 
   return;
 }
+#endif
 
 /*!
 
@@ -1087,24 +1129,25 @@ vpViper::get_eJe(const vpColVector &q, vpMatrix &eJe) const
 void
 vpViper::get_fJw(const vpColVector &q, vpMatrix &fJw) const
 {
-  double q1 = q[0];
-  double q2 = q[1];
-  double q3 = q[2];
-  double q4 = q[3];
-  double q5 = q[4];
+  double c[7], s[7];
+  computeSinCos(q, c, s);
+  get_fJw(c, s, fJw);
+}
 
-  double c1 = cos(q1);
-  double s1 = sin(q1);
-  double c2 = cos(q2);
-  double s2 = sin(q2);
-  double c3 = cos(q3);
-  double s3 = sin(q3);
-  double c4 = cos(q4);
-  double s4 = sin(q4);
-  double c5 = cos(q5);
-  double s5 = sin(q5);
-  double c23 = cos(q2+q3);
-  double s23 = sin(q2+q3);
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Body of get_fJw(), from the precomputed sines and cosines of
+  computeSinCos().
+*/
+void
+vpViper::get_fJw(const double *c_, const double *s_, vpMatrix &fJw) const
+{
+  double c1 = c_[0], s1 = s_[0];
+  double c2 = c_[1], s2 = s_[1];
+  double c3 = c_[2], s3 = s_[2];
+  double c4 = c_[3], s4 = s_[3];
+  double c5 = c_[4], s5 = s_[4];
+  double c23 = c_[6], s23 = s_[6];
 
   vpColVector J1(6);
   vpColVector J2(6);
@@ -1167,6 +1210,7 @@ vpViper::get_fJw(const vpColVector &q, vpMatrix &fJw) const
   }
   return;
 }
+#endif
 /*!
 
   Get the robot jacobian \f${^f}{\bf J}_e\f$ which gives the velocity
@@ -1224,6 +1268,118 @@ vpViper::get_fJe(const vpColVector &q, vpMatrix &fJe) const
   return;
 }
 
+/*!
+  Batched evaluation of the robot jacobian \f${^e}{\bf J}_e\f$ : the
+  jacobians of all the configurations of \e q are stacked vertically in
+  \e eJe (rows \f$6n\f$ to \f$6n+5\f$ hold the jacobian of configuration
+  \e n). The pose independent terms are computed once, the trigonometry
+  once per joint and configuration, and the temporaries are reused across
+  the whole batch, which makes this entry point the one to use when a
+  planner queries hundreds of candidate configurations per cycle.
+
+  \param q : Joint configurations, each a six-dimension vector in radians.
+  \param eJe : Stacked jacobians, resized to 6 times the number of
+  configurations by 6.
+
+  \sa get_eJe(const vpColVector &, vpMatrix &)
+*/
+void
+vpViper::get_eJe(const std::vector<vpColVector> &q, vpMatrix &eJe) const
+{
+  unsigned int nbConfig = (unsigned int)q.size();
+  eJe.resize(6 * nbConfig, 6);
+
+  //Configuration independent terms
+  vpHomogeneousMatrix wMe;
+  get_wMe(wMe);
+  vpHomogeneousMatrix eMw = wMe.inverse();
+  vpTranslationVector etw;
+  eMw.extract(etw);
+  vpMatrix etwSkew = etw.skew();
+
+  vpMatrix V(6, 6);
+  vpMatrix fJw(6, 6);
+  vpMatrix J(6, 6);
+  vpHomogeneousMatrix fMw;
+  vpRotationMatrix fRw, wRf;
+  double c[7], s[7];
+
+  for (unsigned int n = 0; n < nbConfig; n++) {
+    computeSinCos(q[n], c, s);
+    get_fMw(c, s, fMw);
+    get_fJw(c, s, fJw);
+
+    fMw.extract(fRw);
+    wRf = fRw.inverse();
+
+    V = 0;
+    for (unsigned int i = 0; i < 3; i++)
+      for (unsigned int j = 0; j < 3; j++)
+        V[i][j] = V[i+3][j+3] = wRf[i][j];
+    vpMatrix block2 = etwSkew * wRf;
+    for (unsigned int i = 0; i < 3; i++)
+      for (unsigned int j = 0; j < 3; j++)
+        V[i][j+3] = block2[i][j];
+
+    J = V * fJw;
+    for (unsigned int i = 0; i < 6; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        eJe[6*n + i][j] = J[i][j];
+  }
+}
+
+/*!
+  Batched evaluation of the robot jacobian \f${^f}{\bf J}_e\f$, stacked
+  vertically in \e fJe as for
+  get_eJe(const std::vector<vpColVector> &, vpMatrix &).
+
+  \param q : Joint configurations, each a six-dimension vector in radians.
+  \param fJe : Stacked jacobians, resized to 6 times the number of
+  configurations by 6.
+
+  \sa get_fJe(const vpColVector &, vpMatrix &)
+*/
+void
+vpViper::get_fJe(const std::vector<vpColVector> &q, vpMatrix &fJe) const
+{
+  unsigned int nbConfig = (unsigned int)q.size();
+  fJe.resize(6 * nbConfig, 6);
+
+  vpHomogeneousMatrix wMe;
+  get_wMe(wMe);
+  vpHomogeneousMatrix eMw = wMe.inverse();
+  vpTranslationVector etw;
+  eMw.extract(etw);
+
+  vpMatrix V(6, 6);
+  vpMatrix fJw(6, 6);
+  vpMatrix J(6, 6);
+  vpHomogeneousMatrix fMw;
+  vpRotationMatrix fRw;
+  double c[7], s[7];
+
+  for (unsigned int n = 0; n < nbConfig; n++) {
+    computeSinCos(q[n], c, s);
+    get_fMw(c, s, fMw);
+    get_fJw(c, s, fJw);
+
+    fMw.extract(fRw);
+
+    V = 0;
+    for (unsigned int i = 0; i < 6; i++)
+      V[i][i] = 1;
+    vpMatrix block2 = (fRw * etw).skew();
+    for (unsigned int i = 0; i < 3; i++)
+      for (unsigned int j = 0; j < 3; j++)
+        V[i][j+3] = block2[i][j];
+
+    J = V * fJw;
+    for (unsigned int i = 0; i < 6; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        fJe[6*n + i][j] = J[i][j];
+  }
+}
+
 
 /*!
   Get minimal joint values.
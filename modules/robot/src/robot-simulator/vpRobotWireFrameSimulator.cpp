@@ -66,6 +66,7 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator()
 {
   setSamplingTime(0.010);
   velocity.resize(6);
+  set_velocity(velocity);
   I.resize(480,640);
   I = 255;
 #if defined(VISP_HAVE_DISPLAY)
@@ -98,6 +99,7 @@ vpRobotWireFrameSimulator::vpRobotWireFrameSimulator(bool do_display)
 {
   setSamplingTime(0.010);
   velocity.resize(6);
+  set_velocity(velocity);
   I.resize(480,640);
   I = 255;
   
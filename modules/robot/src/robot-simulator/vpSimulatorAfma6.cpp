@@ -232,6 +232,8 @@ vpSimulatorAfma6::init()
   
   artCoord = zeroPos;
   artVel = 0;
+  set_artCoord(artCoord);
+  set_artVel(artVel);
   
   q_prev_getdis.resize(njoint);
   q_prev_getdis = 0;
@@ -875,6 +877,8 @@ int main()
 void
 vpSimulatorAfma6::setVelocity (const vpRobot::vpControlFrameType frame, const vpColVector & vel)
 {
+  double monitor_t0 = 0.;
+  monitorVelocityWriteBegin(monitor_t0);
   if (vpRobot::STATE_VELOCITY_CONTROL != getRobotState ()) {
     vpERROR_TRACE ("Cannot send a velocity to the robot "
 		   "use setRobotState(vpRobot::STATE_VELOCITY_CONTROL) first) ");
@@ -973,6 +977,7 @@ vpSimulatorAfma6::setVelocity (const vpRobot::vpControlFrameType frame, const vp
   set_velocity (vel * scale_sat);
   setRobotFrame (frame);
   setVelocityCalled = true;
+  monitorVelocityWriteEnd(monitor_t0);
 }
 
 
@@ -1684,6 +1689,8 @@ int main()
 void 
 vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpColVector &q)
 {
+  double monitor_t0 = 0.;
+  monitorStateReadBegin(monitor_t0);
   q.resize(6);
   
   switch(frame)
@@ -1729,6 +1736,7 @@ vpSimulatorAfma6::getPosition(const vpRobot::vpControlFrameType frame, vpColVect
       break ;
     }
   }
+  monitorStateReadEnd(monitor_t0);
 }
 
 /*!
@@ -234,6 +234,8 @@ vpSimulatorViper850::init()
   
   artCoord = reposPos;
   artVel = 0;
+  set_artCoord(artCoord);
+  set_artVel(artVel);
   
   q_prev_getdis.resize(njoint);
   q_prev_getdis = 0;
@@ -832,6 +834,8 @@ int main()
 void
 vpSimulatorViper850::setVelocity (const vpRobot::vpControlFrameType frame, const vpColVector & vel)
 {
+  double monitor_t0 = 0.;
+  monitorVelocityWriteBegin(monitor_t0);
   if (vpRobot::STATE_VELOCITY_CONTROL != getRobotState ()) {
     vpERROR_TRACE ("Cannot send a velocity to the robot "
 		   "use setRobotState(vpRobot::STATE_VELOCITY_CONTROL) first) ");
@@ -930,6 +934,7 @@ vpSimulatorViper850::setVelocity (const vpRobot::vpControlFrameType frame, const
   set_velocity (vel * scale_sat);
   setRobotFrame (frame);
   setVelocityCalled = true;
+  monitorVelocityWriteEnd(monitor_t0);
 }
 
 
@@ -1641,6 +1646,8 @@ int main()
 void 
 vpSimulatorViper850::getPosition(const vpRobot::vpControlFrameType frame, vpColVector &q)
 {
+  double monitor_t0 = 0.;
+  monitorStateReadBegin(monitor_t0);
   q.resize(6);
   
   switch(frame)
@@ -1686,6 +1693,7 @@ vpSimulatorViper850::getPosition(const vpRobot::vpControlFrameType frame, vpColV
       break ;
     }
   }
+  monitorStateReadEnd(monitor_t0);
 }
 
 /*!
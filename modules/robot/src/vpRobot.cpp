@@ -54,8 +54,13 @@ vpRobot::vpRobot (void)
   maxRotationVelocity (maxRotationVelocityDefault),
   nDof(0),
   eJe(), eJeAvailable(false), fJe(), fJeAvailable(false), areJointLimitsAvailable(false),
-  qmin(NULL), qmax(NULL), verbose_(true)
+  qmin(NULL), qmax(NULL), verbose_(true),
+  m_monitorEnabled(false), m_monitorDeadlineMs(0.), m_monitorCallback(NULL),
+  m_monitorCallbackData(NULL), m_monitorLastWriteEnd(0.), m_monitorTotalMs(0.),
+  m_monitorStats(), m_monitorBinMs(0.1)
 {
+  for (unsigned int i = 0; i < 101; i++)
+    m_monitorHistogram[i] = 0;
 }
 
 vpRobot::vpRobot (const vpRobot &robot)
@@ -65,8 +70,13 @@ vpRobot::vpRobot (const vpRobot &robot)
   maxRotationVelocity (maxRotationVelocityDefault),
   nDof(0),
   eJe(), eJeAvailable(false), fJe(), fJeAvailable(false), areJointLimitsAvailable(false),
-  qmin(NULL), qmax(NULL), verbose_(true)
+  qmin(NULL), qmax(NULL), verbose_(true),
+  m_monitorEnabled(false), m_monitorDeadlineMs(0.), m_monitorCallback(NULL),
+  m_monitorCallbackData(NULL), m_monitorLastWriteEnd(0.), m_monitorTotalMs(0.),
+  m_monitorStats(), m_monitorBinMs(0.1)
 {
+  for (unsigned int i = 0; i < 101; i++)
+    m_monitorHistogram[i] = 0;
   *this = robot;
 }
 
@@ -108,6 +118,121 @@ vpRobot & vpRobot::operator=(const vpRobot &robot)
 
   return (*this);
 }
+
+/*!
+  Turn the control loop monitor on or off. While enabled, the drivers
+  timestamp their state reads and velocity writes; the interval between
+  two consecutive velocity writes is one cycle, accumulated into the
+  statistics and the jitter histogram. The recording is a few dozen
+  nanoseconds per event and involves no lock, so the monitor can stay on
+  in production.
+
+  \param enable : True to record, false to stop.
+  \param deadlineMs : Cycle deadline in ms; cycles longer than this count
+  as deadline misses and fire the overrun callback. 0 disables the
+  deadline accounting.
+  \param histogramBinMs : Width of the jitter histogram bins, in ms (100
+  bins plus one overflow bin).
+
+  \sa setLoopOverrunCallback(), getLoopMonitorStats(), getLoopJitterHistogram()
+*/
+void vpRobot::setLoopMonitor(bool enable, const double &deadlineMs, const double &histogramBinMs)
+{
+  resetLoopMonitor();
+  m_monitorDeadlineMs = deadlineMs;
+  m_monitorBinMs = histogramBinMs > 0. ? histogramBinMs : 0.1;
+  m_monitorEnabled = enable;
+}
+
+/*!
+  Install a callback fired from the control thread whenever a cycle
+  exceeds the deadline given to setLoopMonitor().
+
+  \param callback : Function called with \e user_data and the cycle
+  duration in ms; NULL removes it.
+  \param user_data : Context passed back to the callback.
+*/
+void vpRobot::setLoopOverrunCallback(vpLoopOverrunCallback callback, void *user_data)
+{
+  m_monitorCallback = callback;
+  m_monitorCallbackData = user_data;
+}
+
+/*!
+  Get a copy of the loop timing statistics.
+
+  \return Statistics accumulated since setLoopMonitor() or
+  resetLoopMonitor().
+*/
+vpRobot::vpLoopMonitorStats vpRobot::getLoopMonitorStats() const
+{
+  return m_monitorStats;
+}
+
+/*!
+  Get a copy of the cycle duration histogram : 100 bins of the configured
+  width plus one overflow bin.
+
+  \param bins : Filled with the 101 bin counts.
+  \param binMs : Width of a bin, in ms.
+*/
+void vpRobot::getLoopJitterHistogram(std::vector<unsigned int> &bins, double &binMs) const
+{
+  bins.resize(101);
+  for (unsigned int i = 0; i < 101; i++)
+    bins[i] = m_monitorHistogram[i];
+  binMs = m_monitorBinMs;
+}
+
+/*!
+  Forget every recorded cycle.
+*/
+void vpRobot::resetLoopMonitor()
+{
+  m_monitorStats = vpLoopMonitorStats();
+  m_monitorTotalMs = 0.;
+  m_monitorLastWriteEnd = 0.;
+  for (unsigned int i = 0; i < 101; i++)
+    m_monitorHistogram[i] = 0;
+}
+
+/*!
+  Close a velocity write : computes the cycle duration since the previous
+  write, updates the statistics and the histogram and fires the overrun
+  callback on a deadline miss. Called by the drivers.
+*/
+void vpRobot::monitorVelocityWriteEnd(const double &t0)
+{
+  if (!m_monitorEnabled)
+    return;
+
+  double now = vpTime::measureTimeMicros();
+  m_monitorStats.lastVelocityWriteMs = (now - t0) / 1000.;
+
+  if (m_monitorLastWriteEnd > 0.) {
+    double cycleMs = (now - m_monitorLastWriteEnd) / 1000.;
+    m_monitorStats.lastMs = cycleMs;
+    if (m_monitorStats.nbCycles == 0 || cycleMs < m_monitorStats.minMs)
+      m_monitorStats.minMs = cycleMs;
+    if (cycleMs > m_monitorStats.maxMs)
+      m_monitorStats.maxMs = cycleMs;
+    m_monitorStats.nbCycles++;
+    m_monitorTotalMs += cycleMs;
+    m_monitorStats.meanMs = m_monitorTotalMs / m_monitorStats.nbCycles;
+
+    unsigned int bin = (unsigned int)(cycleMs / m_monitorBinMs);
+    if (bin > 100) bin = 100;
+    m_monitorHistogram[bin]++;
+
+    if (m_monitorDeadlineMs > 0. && cycleMs > m_monitorDeadlineMs) {
+      m_monitorStats.nbDeadlineMiss++;
+      if (m_monitorCallback != NULL)
+        m_monitorCallback(m_monitorCallbackData, cycleMs);
+    }
+  }
+  m_monitorLastWriteEnd = now;
+}
+
 /*!
   Saturate velocities.
 
@@ -73,6 +73,47 @@
 extern Point2i *point2i;
 extern Point2i *listpoint2i;
 
+/*
+  Indique si la surface "bp" transformee par "m" est entierement hors de la
+  pyramide de vision : les huit sommets de sa boite englobante partagent
+  alors un plan de decoupage. Le decoupage complet de la surface est dans
+  ce cas inutile.
+*/
+static bool
+bound_is_outside_view (Bound *bp, Matrix m)
+{
+  if (bp->point.nbr == 0)
+    return false;
+
+  Point3f *p = bp->point.ptr;
+  Point3f pmin = *p, pmax = *p;
+  Point3f *pend = p + bp->point.nbr;
+  for (p = p + 1; p < pend; p++)
+  {
+    if (p->x < pmin.x) pmin.x = p->x;
+    if (p->y < pmin.y) pmin.y = p->y;
+    if (p->z < pmin.z) pmin.z = p->z;
+    if (p->x > pmax.x) pmax.x = p->x;
+    if (p->y > pmax.y) pmax.y = p->y;
+    if (p->z > pmax.z) pmax.z = p->z;
+  }
+
+  Point3f corner[8];
+  Point4f corner4[8];
+  for (int k = 0; k < 8; k++)
+  {
+    corner[k].x = (k & 1) ? pmax.x : pmin.x;
+    corner[k].y = (k & 2) ? pmax.y : pmin.y;
+    corner[k].z = (k & 4) ? pmax.z : pmin.z;
+  }
+  point_3D_4D (corner, 8, m, corner4);
+
+  Byte andCode = (Byte) ~IS_INSIDE;
+  for (int k = 0; k < 8 && andCode != IS_INSIDE; k++)
+    andCode = (Byte)(andCode & where_is_Point4f (&corner4[k]));
+  return andCode != IS_INSIDE;
+}
+
 
 
 /*
@@ -93,8 +134,14 @@ vpWireFrameSimulator::display_scene(Matrix mat, Bound_scene &sc, const vpImage<v
   postmult_matrix (m, *(get_tmstack ()));
   bp   = sc.bound.ptr;
   bend = bp + sc.bound.nbr;
+  vpDisplay::beginOverlayBatch(I);
+  try {
   for (; bp < bend; bp++)
   {
+    // Rejet rapide des surfaces entierement hors du volume de vision
+    if (bound_is_outside_view (bp, m))
+      continue;
+
     if ((clip = clipping_Bound (bp, m)) != NULL)
     {
       Face *fp   = clip->face.ptr;
@@ -122,6 +169,12 @@ vpWireFrameSimulator::display_scene(Matrix mat, Bound_scene &sc, const vpImage<v
       }
     }
   }
+  }
+  catch (...) {
+    vpDisplay::endOverlayBatch(I);
+    throw;
+  }
+  vpDisplay::endOverlayBatch(I);
 }
 
 /*
@@ -143,8 +196,14 @@ vpWireFrameSimulator::display_scene(Matrix mat, Bound_scene &sc, const vpImage<u
   postmult_matrix (m, *(get_tmstack ()));
   bp   = sc.bound.ptr;
   bend = bp + sc.bound.nbr;
+  vpDisplay::beginOverlayBatch(I);
+  try {
   for (; bp < bend; bp++)
   {
+    // Rejet rapide des surfaces entierement hors du volume de vision
+    if (bound_is_outside_view (bp, m))
+      continue;
+
     if ((clip = clipping_Bound (bp, m)) != NULL)
     {
       Face *fp   = clip->face.ptr;
@@ -172,6 +231,12 @@ vpWireFrameSimulator::display_scene(Matrix mat, Bound_scene &sc, const vpImage<u
       }
     }
   }
+  }
+  catch (...) {
+    vpDisplay::endOverlayBatch(I);
+    throw;
+  }
+  vpDisplay::endOverlayBatch(I);
 }
 
 /*************************************************************************************************************/
@@ -397,6 +397,28 @@ public:
   unsigned int getNumCameras() const;
   unsigned int getParameterValue(vp1394TwoParametersType param);
   unsigned int getRingBufferSize() const;
+
+  /*!
+    Enable or disable the latest-frame acquisition mode. While enabled,
+    dequeue() drains the capture ring : the frames that accumulated while
+    the caller was busy return to the driver immediately, counted by
+    getNbDroppedFrames(), and only the newest one is delivered. For
+    servoing this bounds the latency to one frame interval instead of
+    silently serving the oldest buffered frame.
+
+    \param enable : True to always deliver the newest frame.
+
+    \sa getNbDroppedFrames(), setRingBufferSize()
+  */
+  void setLatestFrameMode(const bool &enable) { m_latestFrameMode = enable; }
+
+  /*!
+    Get the number of frames the latest-frame mode dropped to stay on the
+    newest one.
+
+    \return Number of dropped frames, see setLatestFrameMode().
+  */
+  unsigned long getNbDroppedFrames() const { return m_nbDroppedFrames; }
   void getVideoMode(vp1394TwoVideoModeType & videomode);
   uint32_t getVideoModeSupported(std::list<vp1394TwoVideoModeType> & videomodes);
   void getWidth(unsigned int &width);
@@ -457,6 +479,8 @@ public:
   bool verbose;
   bool *camIsOpen;
   unsigned int num_buffers;
+  bool m_latestFrameMode;
+  unsigned long m_nbDroppedFrames;
   
   /* parameters for the cameras */
   bool* isDataModified;
@@ -171,6 +171,10 @@ public:
 
   //Access protected by a mutex:
   vpImage<float> dmap;
+  vpImage<uint16_t> m_rawDmap; //!< Raw disparity copied under the lock, converted outside it
+  //Cached per-pixel IR back-projection of warpRGBFrame()
+  std::vector<double> m_warpX;
+  std::vector<double> m_warpY;
   vpImage<vpRGBa> IRGB;
   bool m_new_rgb_frame;
   bool m_new_depth_map;
@@ -97,6 +97,21 @@ class VISP_EXPORT vpLaserScan
   inline std::vector<vpScanPoint> getScanPoints() {
     return listScanPoints;
   }
+
+  /*!
+    Direct read access to the scan points, without copying the vector as
+    getScanPoints() does.
+  */
+  inline const std::vector<vpScanPoint> &getScanPointsRef() const {
+    return listScanPoints;
+  }
+  /*!
+    Preallocate storage for \e nbPoints scan points, so that the
+    per-point additions of a measurement never reallocate.
+  */
+  inline void reserve(const unsigned int &nbPoints) {
+    listScanPoints.reserve(nbPoints);
+  }
   /*! Specifies the id of former measurements and increases with
       every measurement. */
   inline void setMeasurementId(const unsigned short &id) {
@@ -46,6 +46,7 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
 
 #if defined(VISP_HAVE_REALSENSE) && defined(VISP_HAVE_CPP11_COMPATIBILITY)
 
@@ -227,6 +228,25 @@ public:
 
   void setDeviceBySerialNumber(const std::string &serial_no);
 
+  /*!
+    Only convert every \e decimation-th pixel of each depth row and column
+    into the point cloud : a decimation of 2 divides the conversion cost
+    by 4 while keeping the cloud geometry.
+
+    \param decimation : Sampling step; 1 (the default) keeps every pixel.
+  */
+  void setPointcloudDecimation(const unsigned int &decimation) {
+    m_pointcloudDecimation = decimation == 0 ? 1 : decimation;
+  }
+
+  /*!
+    Restrict the point cloud conversion to a depth image region.
+
+    \param roi : Converted region, in depth pixel coordinates; an empty
+    rectangle (the default) converts the full frame.
+  */
+  void setPointcloudROI(const vpRect &roi) { m_pointcloudROI = roi; }
+
   friend VISP_EXPORT std::ostream & operator<< (std::ostream &os, const vpRealSense &rs);
 
 protected:
@@ -238,6 +258,8 @@ protected:
   float m_max_Z; //!< Maximal Z depth in meter
   bool m_enable_color;
   bool m_enable_depth;
+  unsigned int m_pointcloudDecimation; //!< Sampling step of the point cloud, 1 keeps every pixel
+  vpRect m_pointcloudROI; //!< Depth region converted to a point cloud; empty keeps the full frame
 };
 
 #endif
@@ -289,6 +289,19 @@ public:
     this->m_nbuffers = nbuffers;
   }
 
+  /*!
+    Enable or disable the zero-copy acquisition mode. While enabled, the
+    grayscale acquire() of a device configured in V4L2_GREY_FORMAT fills
+    \e I with a non-owning view of the mmap'ed kernel buffer instead of
+    copying it : the buffer is kept dequeued and stays valid until the
+    next acquire() or close(), when it returns to the driver ring. The
+    other pixel formats keep their converting copy, which their
+    conversion requires anyway.
+
+    \param enable : True to map the kernel buffers directly.
+  */
+  void setZeroCopy(const bool &enable) { m_zeroCopy = enable; }
+
   /*!
     Set the device name.
 
@@ -363,6 +376,7 @@ private:
   unsigned	m_nbuffers;
   unsigned int field;
   bool		streaming;
+  bool m_zeroCopy;
 
   unsigned      m_input;
   vpV4l2FramerateType m_framerate;
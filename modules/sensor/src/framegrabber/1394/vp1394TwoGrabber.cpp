@@ -164,7 +164,7 @@ int main()
 */
 vp1394TwoGrabber::vp1394TwoGrabber(bool reset)
   : camera(NULL), cameras(NULL), num_cameras(0), camera_id(0), verbose(false), camIsOpen(NULL),
-    num_buffers(4), // ring buffer size
+    num_buffers(4), m_latestFrameMode(false), m_nbDroppedFrames(0), // ring buffer size
     isDataModified(NULL), initialShutterMode(NULL), dataCam(NULL)
   #ifdef VISP_HAVE_DC1394_CAMERA_ENUMERATE // new API > libdc1394-2.0.0-rc7
   , d(NULL),
@@ -2380,6 +2380,19 @@ vp1394TwoGrabber::dequeue()
     vpERROR_TRACE ("Error: Failed to capture from camera %d\n", camera_id);
   }
 
+  if (m_latestFrameMode && frame != NULL) {
+    //Drain the ring : the frames that backed up while the caller was busy
+    //return to the driver and only the newest one is delivered
+    dc1394video_frame_t *newer = NULL;
+    while (dc1394_capture_dequeue(camera, DC1394_CAPTURE_POLICY_POLL, &newer)
+           == DC1394_SUCCESS && newer != NULL) {
+      dc1394_capture_enqueue(camera, frame);
+      frame = newer;
+      newer = NULL;
+      m_nbDroppedFrames++;
+    }
+  }
+
   return frame;
 }
 
@@ -2501,6 +2514,8 @@ vp1394TwoGrabber::dequeue(vpImage<unsigned char> &I,
   // [microseconds] at which the frame was captured in the ring buffer.
   timestamp = frame->timestamp;
   id = frame->id;
+  //Propagate the driver capture time with the frame
+  I.setTimestamp(timestamp / 1000.);
 
   this->width  = frame->size[0];
   this->height = frame->size[1];
@@ -2670,6 +2685,8 @@ vp1394TwoGrabber::dequeue(vpImage<vpRGBa> &I,
   // [microseconds] at which the frame was captured in the ring buffer.
   timestamp = frame->timestamp;
   id = frame->id;
+  //Propagate the driver capture time with the frame
+  I.setTimestamp(timestamp / 1000.);
 
   this->width  = frame->size[0];
   this->height = frame->size[1];
@@ -2863,6 +2880,8 @@ vp1394TwoGrabber::acquire(vpImage<vpRGBa> &I,
   // [microseconds] at which the frame was captured in the ring buffer.
   timestamp = frame->timestamp;
   id = frame->id;
+  //Propagate the driver capture time with the frame
+  I.setTimestamp(timestamp / 1000.);
 
   this->width  = frame->size[0];
   this->height = frame->size[1];
@@ -149,7 +149,7 @@ int main()
 vpV4l2Grabber::vpV4l2Grabber()
   : fd(-1), device(), cap(), streamparm(), inp(NULL), std(NULL), fmt(NULL), ctl(NULL),
     fmt_v4l2(), fmt_me(), reqbufs(), buf_v4l2(NULL), buf_me(NULL), queue(0),
-    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false),
+    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false), m_zeroCopy(false),
     m_input(vpV4l2Grabber::DEFAULT_INPUT),
     m_framerate(vpV4l2Grabber::framerate_25fps),
     m_frameformat(vpV4l2Grabber::V4L2_FRAME_FORMAT),
@@ -208,7 +208,7 @@ vpV4l2Grabber::vpV4l2Grabber()
 vpV4l2Grabber::vpV4l2Grabber(bool verbose)
   : fd(-1), device(), cap(), streamparm(), inp(NULL), std(NULL), fmt(NULL), ctl(NULL),
     fmt_v4l2(), fmt_me(), reqbufs(), buf_v4l2(NULL), buf_me(NULL), queue(0),
-    waiton_cpt(0), index_buffer(0), m_verbose(verbose), m_nbuffers(3), field(0), streaming(false),
+    waiton_cpt(0), index_buffer(0), m_verbose(verbose), m_nbuffers(3), field(0), streaming(false), m_zeroCopy(false),
     m_input(vpV4l2Grabber::DEFAULT_INPUT),
     m_framerate(vpV4l2Grabber::framerate_25fps),
     m_frameformat(vpV4l2Grabber::V4L2_FRAME_FORMAT),
@@ -258,7 +258,7 @@ vpV4l2Grabber::vpV4l2Grabber(bool verbose)
 vpV4l2Grabber::vpV4l2Grabber(unsigned input, unsigned scale)
   : fd(-1), device(), cap(), streamparm(), inp(NULL), std(NULL), fmt(NULL), ctl(NULL),
     fmt_v4l2(), fmt_me(), reqbufs(), buf_v4l2(NULL), buf_me(NULL), queue(0),
-    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false),
+    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false), m_zeroCopy(false),
     m_input(vpV4l2Grabber::DEFAULT_INPUT),
     m_framerate(vpV4l2Grabber::framerate_25fps),
     m_frameformat(vpV4l2Grabber::V4L2_FRAME_FORMAT),
@@ -307,7 +307,7 @@ vpV4l2Grabber::vpV4l2Grabber(unsigned input, unsigned scale)
 vpV4l2Grabber::vpV4l2Grabber(vpImage<unsigned char> &I, unsigned input, unsigned scale )
   : fd(-1), device(), cap(), streamparm(), inp(NULL), std(NULL), fmt(NULL), ctl(NULL),
     fmt_v4l2(), fmt_me(), reqbufs(), buf_v4l2(NULL), buf_me(NULL), queue(0),
-    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false),
+    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false), m_zeroCopy(false),
     m_input(vpV4l2Grabber::DEFAULT_INPUT),
     m_framerate(vpV4l2Grabber::framerate_25fps),
     m_frameformat(vpV4l2Grabber::V4L2_FRAME_FORMAT),
@@ -359,7 +359,7 @@ vpV4l2Grabber::vpV4l2Grabber(vpImage<unsigned char> &I, unsigned input, unsigned
 vpV4l2Grabber::vpV4l2Grabber(vpImage<vpRGBa> &I, unsigned input, unsigned scale )
   : fd(-1), device(), cap(), streamparm(), inp(NULL), std(NULL), fmt(NULL), ctl(NULL),
     fmt_v4l2(), fmt_me(), reqbufs(), buf_v4l2(NULL), buf_me(NULL), queue(0),
-    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false),
+    waiton_cpt(0), index_buffer(0), m_verbose(false), m_nbuffers(3), field(0), streaming(false), m_zeroCopy(false),
     m_input(vpV4l2Grabber::DEFAULT_INPUT),
     m_framerate(vpV4l2Grabber::framerate_25fps),
     m_frameformat(vpV4l2Grabber::V4L2_FRAME_FORMAT),
@@ -626,7 +626,20 @@ vpV4l2Grabber::acquire(vpImage<unsigned char> &I, struct timeval &timestamp, con
   }
 
   unsigned char *bitmap ;
+  //In zero-copy mode the buffer delivered by the previous acquire is
+  //still dequeued : give it back to the ring before waiting the next one
+  if (m_zeroCopy)
+    queueAll();
   bitmap = waiton(index_buffer, timestamp);
+  //Propagate the driver capture time with the frame
+  I.setTimestamp(timestamp.tv_sec * 1000. + timestamp.tv_usec / 1000.);
+
+  if (m_pixelformat == V4L2_GREY_FORMAT && m_zeroCopy && roi == vpRect()) {
+    //Non-owning view of the mmap'ed kernel buffer, valid until the next
+    //acquire() or close()
+    I.init(bitmap, height, width, false);
+    return;
+  }
 
   if (roi == vpRect())
     I.resize(height, width);
@@ -757,6 +770,8 @@ vpV4l2Grabber::acquire(vpImage<vpRGBa> &I, struct timeval &timestamp, const vpRe
 
   unsigned  char *bitmap ;
   bitmap = waiton(index_buffer, timestamp);
+  //Propagate the driver capture time with the frame
+  I.setTimestamp(timestamp.tv_sec * 1000. + timestamp.tv_usec / 1000.);
 
   if (roi == vpRect())
     I.resize(height, width);
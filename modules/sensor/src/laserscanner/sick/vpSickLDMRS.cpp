@@ -250,6 +250,9 @@ bool vpSickLDMRS::measure(vpLaserScan laserscan[4])
   int nlayers = 4;
   for (int i=0; i < nlayers; i++) {
     laserscan[i].clear();
+    //Preallocate so the point additions below never reallocate; clear()
+    //keeps the capacity across the 50 Hz frames
+    laserscan[i].reserve(numPoints);
     laserscan[i].setMeasurementId(measurementId); 
     laserscan[i].setStartTimestamp(startTimestamp); 
     laserscan[i].setEndTimestamp(endTimestamp); 
@@ -267,6 +270,7 @@ bool vpSickLDMRS::measure(vpLaserScan laserscan[4])
   if (numPoints > USHRT_MAX-2)
     throw(vpException (vpException::ioError, "Out of range number of point"));
 
+  const double angleStep = 2. * M_PI / numSteps;
   for (int i=0; i < numPoints; i++) {
     ushortptr = (unsigned short *) (body+44+i*10);
     unsigned char layer = ((unsigned char)  body[44+i*10])&0x0F;
@@ -274,7 +278,7 @@ bool vpSickLDMRS::measure(vpLaserScan laserscan[4])
     //unsigned char flags = (unsigned char)  body[44+i*10+1];
     
     if (echo==0) {
-      hAngle = (2.f * M_PI / numSteps)*(short) ushortptr[1];
+      hAngle = angleStep*(short) ushortptr[1];
       rDist = 0.01 * ushortptr[2]; // cm to meters conversion
       
       //vpTRACE("layer: %d d: %f hangle: %f", layer, rDist, hAngle);
@@ -54,7 +54,7 @@ vpKinect::vpKinect(freenect_context *ctx, int index)
     m_rgb_mutex(), m_depth_mutex(), RGBcam(), IRcam(),
     rgbMir(), irMrgb(), DMres(DMAP_LOW_RES),
     hd(240), wd(320),
-    dmap(), IRGB(),
+    dmap(), m_rawDmap(), m_warpX(), m_warpY(), IRGB(),
     m_new_rgb_frame(false),
     m_new_depth_map(false),
     m_new_depth_image(false),
@@ -153,20 +153,35 @@ void vpKinect::VideoCallback(void* rgb, uint32_t /* timestamp */)
   stored in dmap.  (range : 0.3 - 5m).
 
 */
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Disparity to meters conversion table, built once : the raw kinect value
+//is coded on 11 bits, values above 1023 mean the depth is unknown
+static struct vpKinectDepthLut
+{
+  float meters[2048];
+
+  vpKinectDepthLut()
+  {
+    for (int v = 0; v < 2048; v++) {
+      if (v > 1023)
+        meters[v] = -1.f;
+      else
+        meters[v] = 0.1236f * tan(v / 2842.5f + 1.1863f); //formula from http://openkinect.org/wiki/Imaging_Information
+    }
+  }
+} vpKinectLut;
+#endif
+
 void vpKinect::DepthCallback(void* depth, uint32_t /* timestamp */)
 {
 //	std::cout << "vpKinect Depth callback" << std::endl;
+  //Only the raw disparity is copied while the lock is held; the metric
+  //conversion happens in getDepthMap(), outside the capture lock, through
+  //the precomputed table
   vpMutex::vpScopedLock lock(m_depth_mutex);
   uint16_t* depth_ = static_cast<uint16_t*>(depth);
-  for (unsigned i = 0; i< height;i++){
-    for (unsigned j = 0 ; j < width ; j++)
-    {
-      dmap[i][j] = 0.1236f * tan(depth_[width*i +j] / 2842.5f + 1.1863f);//formula from http://openkinect.org/wiki/Imaging_Information
-      if(depth_[width*i +j]>1023){//Depth cannot be computed
-        dmap[i][j] = -1;
-      }
-    }
-  }
+  m_rawDmap.resize(height, width);
+  memcpy((void *)m_rawDmap.bitmap, (void *)depth_, (size_t)height * width * sizeof(uint16_t));
   m_new_depth_map = true;
   m_new_depth_image = true;
 }
@@ -177,11 +192,19 @@ void vpKinect::DepthCallback(void* depth, uint32_t /* timestamp */)
 */
 bool vpKinect::getDepthMap(vpImage<float>& map)
 {
-  vpMutex::vpScopedLock lock(m_depth_mutex);
-  if (!m_new_depth_map)
-    return false;
-  map = this->dmap;
-  m_new_depth_map = false;
+  vpImage<uint16_t> raw;
+  {
+    vpMutex::vpScopedLock lock(m_depth_mutex);
+    if (!m_new_depth_map)
+      return false;
+    raw = m_rawDmap;
+    m_new_depth_map = false;
+  }
+
+  map.resize(raw.getHeight(), raw.getWidth());
+  unsigned int size = raw.getHeight() * raw.getWidth();
+  for (unsigned int k = 0; k < size; k++)
+    map.bitmap[k] = vpKinectLut.meters[raw.bitmap[k] & 0x7FF];
   return true;
 }
 
@@ -192,19 +215,27 @@ bool vpKinect::getDepthMap(vpImage<float>& map)
 bool vpKinect::getDepthMap(vpImage<float>& map,vpImage<unsigned char>& Imap)
 {
 	//	vpMutex::vpScopedLock lock(m_depth_mutex);
-	vpImage<float> tempMap;
+	vpImage<uint16_t> raw;
 	m_depth_mutex.lock();
 	if (!m_new_depth_map && !m_new_depth_image)
 	{
 		m_depth_mutex.unlock();
 		return false;
 	}
-	tempMap = dmap;
+	raw = m_rawDmap;
 
 	m_new_depth_map = false;
 	m_new_depth_image = false;
 	m_depth_mutex.unlock();
 
+	//Metric conversion through the table, outside the capture lock
+	vpImage<float> tempMap(raw.getHeight(), raw.getWidth());
+	{
+		unsigned int size = raw.getHeight() * raw.getWidth();
+		for (unsigned int k = 0; k < size; k++)
+			tempMap.bitmap[k] = vpKinectLut.meters[raw.bitmap[k] & 0x7FF];
+	}
+
 	if ((Imap.getHeight()!=hd )||(map.getHeight()!=hd))
 	  vpERROR_TRACE(1, "Image size does not match vpKinect DM resolution");
 	if (DMres == DMAP_LOW_RES){
@@ -267,13 +298,27 @@ void vpKinect::warpRGBFrame(const vpImage<vpRGBa> & Irgb, const vpImage<float> &
 
 //		std::cout <<"rgbMir : "<<rgbMir<<std::endl;
 
+		//The metric back-projection of each depth pixel only depends on the
+		//pixel : computed once and cached
+		if (m_warpX.size() != (size_t)hd * wd) {
+			m_warpX.resize((size_t)hd * wd);
+			m_warpY.resize((size_t)hd * wd);
+			for (unsigned int i = 0; i < hd; i++)
+				for (unsigned int j = 0; j < wd; j++) {
+					vpPixelMeterConversion::convertPoint(IRcam, j, i, x1, y1);
+					m_warpX[(size_t)i*wd + j] = x1;
+					m_warpY[(size_t)i*wd + j] = y1;
+				}
+		}
+
 		for (unsigned int i = 0; i< hd;i++)
 		  for (unsigned int j = 0 ; j < wd ; j++){
-			  //! Compute metric coordinates in the ir camera Frame :
-			  vpPixelMeterConversion::convertPoint(IRcam, j, i, x1, y1);
+			  //! Metric coordinates in the ir camera frame, from the cache
+			  x1 = m_warpX[(size_t)i*wd + j];
+			  y1 = m_warpY[(size_t)i*wd + j];
 			  Z1 = Idepth[i][j];
-              //if (Z1!=-1){
-              if (std::fabs(Z1+1) <= std::numeric_limits<double>::epsilon()){
+              //Warp the pixels whose depth is known (Z1 != -1)
+              if (std::fabs(Z1+1) > std::numeric_limits<double>::epsilon()){
                   P1[0]=x1*Z1;
 				  P1[1]=y1*Z1;
 				  P1[2]=Z1;
@@ -44,12 +44,41 @@
 #if defined(VISP_HAVE_REALSENSE) && defined(VISP_HAVE_CPP11_COMPATIBILITY)
 
 #include "vpRealSense_impl.h"
+#include <visp3/core/vpThreadPool.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//Pool tasks overlapping the color conversion with the depth deprojection
+struct vpRealSenseGreyTaskData {
+  const rs::device *device;
+  const std::vector<rs::intrinsics> *intrinsics;
+  vpImage<unsigned char> *grey;
+};
+static vpThread::Return vp_rs_grey_task(vpThread::Args args)
+{
+  vpRealSenseGreyTaskData *data = (vpRealSenseGreyTaskData *)args;
+  vp_rs_get_grey_impl(data->device, *data->intrinsics, *data->grey);
+  return NULL;
+}
+
+struct vpRealSenseColorTaskData {
+  const rs::device *device;
+  const std::vector<rs::intrinsics> *intrinsics;
+  vpImage<vpRGBa> *color;
+};
+static vpThread::Return vp_rs_color_task(vpThread::Args args)
+{
+  vpRealSenseColorTaskData *data = (vpRealSenseColorTaskData *)args;
+  vp_rs_get_color_impl(data->device, *data->intrinsics, *data->color);
+  return NULL;
+}
+#endif
 
 /*!
  * Default constructor.
  */
 vpRealSense::vpRealSense()
-  : m_context(), m_device(NULL), m_num_devices(0), m_serial_no(), m_intrinsics(), m_max_Z(8), m_enable_color(true), m_enable_depth(true)
+  : m_context(), m_device(NULL), m_num_devices(0), m_serial_no(), m_intrinsics(), m_max_Z(8), m_enable_color(true), m_enable_depth(true),
+    m_pointcloudDecimation(1), m_pointcloudROI()
 {
 
 }
@@ -277,11 +306,19 @@ void vpRealSense::acquire(vpImage<unsigned char> &grey, std::vector<vpColVector>
 
   m_device->wait_for_frames();
 
-  // Retrieve grey image
-  vp_rs_get_grey_impl(m_device, m_intrinsics, grey);
+  // The grey conversion runs on the pool while this thread deprojects the
+  // depth stream
+  vpRealSenseGreyTaskData greyTask;
+  greyTask.device = m_device;
+  greyTask.intrinsics = &m_intrinsics;
+  greyTask.grey = &grey;
+  vpThreadPool::vpTaskStatus greyStatus;
+  vpThreadPool::getInstance().enqueue(vp_rs_grey_task, &greyTask, &greyStatus);
 
   // Retrieve point cloud
-  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud);
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_pointcloudDecimation, m_pointcloudROI);
+
+  greyStatus.wait();
 }
 
 /*!
@@ -300,7 +337,7 @@ void vpRealSense::acquire(std::vector<vpColVector> &pointcloud)
   m_device->wait_for_frames();
 
   // Retrieve point cloud
-  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud);
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_pointcloudDecimation, m_pointcloudROI);
 }
 
 /*!
@@ -350,7 +387,7 @@ void vpRealSense::acquire(vpImage<vpRGBa> &color, vpImage<uint16_t> &infrared, v
   vp_rs_get_frame_data_impl(m_device, m_intrinsics, rs::stream::depth, depth);
 
   // Retrieve point cloud
-  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud);
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_pointcloudDecimation, m_pointcloudROI);
 }
 
 /*!
@@ -381,7 +418,7 @@ void vpRealSense::acquire(vpImage<unsigned char> &grey, vpImage<uint16_t> &infra
   vp_rs_get_frame_data_impl(m_device, m_intrinsics, rs::stream::depth, depth);
 
   // Retrieve point cloud
-  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud);
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_pointcloudDecimation, m_pointcloudROI);
 }
 
 /*!
@@ -400,11 +437,19 @@ void vpRealSense::acquire(vpImage<vpRGBa> &color, std::vector<vpColVector> &poin
 
   m_device->wait_for_frames();
 
-  // Retrieve color image
-  vp_rs_get_color_impl(m_device, m_intrinsics, color);
+  // The color conversion runs on the pool while this thread deprojects the
+  // depth stream
+  vpRealSenseColorTaskData colorTask;
+  colorTask.device = m_device;
+  colorTask.intrinsics = &m_intrinsics;
+  colorTask.color = &color;
+  vpThreadPool::vpTaskStatus colorStatus;
+  vpThreadPool::getInstance().enqueue(vp_rs_color_task, &colorTask, &colorStatus);
 
   // Retrieve point cloud
-  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud);
+  vp_rs_get_pointcloud_impl(m_device, m_intrinsics, m_max_Z, pointcloud, m_pointcloudDecimation, m_pointcloudROI);
+
+  colorStatus.wait();
 }
 
 #ifdef VISP_HAVE_PCL
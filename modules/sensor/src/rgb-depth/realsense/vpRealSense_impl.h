@@ -36,6 +36,7 @@
  *****************************************************************************/
 
 #include <librealsense/rs.hpp>
+#include <visp3/core/vpRect.h>
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImage.h>
 
@@ -92,34 +93,56 @@ void vp_rs_get_grey_impl(const rs::device *m_device, const std::vector <rs::intr
 }
 
 // Retrieve point cloud
-void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::vector <rs::intrinsics> &m_intrinsics, float max_Z, std::vector<vpColVector> &pointcloud)
+void vp_rs_get_pointcloud_impl(const rs::device *m_device, const std::vector <rs::intrinsics> &m_intrinsics, float max_Z, std::vector<vpColVector> &pointcloud,
+                               unsigned int decimation = 1, const vpRect &roi = vpRect())
 {
   if (m_device->is_stream_enabled(rs::stream::depth)) {
     const float depth_scale = m_device->get_depth_scale();
 
-    vpColVector p3d(4); // X,Y,Z coordinates
-    rs::float3 depth_point;
     uint16_t * depth = (uint16_t *)m_device->get_frame_data(rs::stream::depth);
     int width = m_intrinsics[RS_STREAM_DEPTH].width;
     int height = m_intrinsics[RS_STREAM_DEPTH].height;
-    pointcloud.resize(width*height);
 
-    for (int i = 0; i < height; i++) {
-      for (int j = 0; j < width; j++) {
+    //Optional region and sampling step of the conversion
+    int i0 = 0, i1 = height, j0 = 0, j1 = width;
+    if (roi != vpRect()) {
+      i0 = (int)roi.getTop()    < 0      ? 0      : (int)roi.getTop();
+      j0 = (int)roi.getLeft()   < 0      ? 0      : (int)roi.getLeft();
+      //getBottom()/getRight() are inclusive coordinates
+      i1 = (int)roi.getBottom() + 1 > height ? height : (int)roi.getBottom() + 1;
+      j1 = (int)roi.getRight()  + 1 > width  ? width  : (int)roi.getRight() + 1;
+      if (i1 < i0) i1 = i0;
+      if (j1 < j0) j1 = j0;
+    }
+    int step = decimation == 0 ? 1 : (int)decimation;
+    int out_h = (i1 - i0 + step - 1) / step;
+    int out_w = (j1 - j0 + step - 1) / step;
+    pointcloud.resize((size_t)out_h*out_w);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 8)
+#endif
+    for (int oi = 0; oi < out_h; oi++) {
+      int i = i0 + oi*step;
+      for (int oj = 0; oj < out_w; oj++) {
+        int j = j0 + oj*step;
         float scaled_depth = depth[i*width + j] * depth_scale;
 
         rs::float2 depth_pixel = { (float) j, (float) i};
-        depth_point = m_intrinsics[RS_STREAM_DEPTH].deproject(depth_pixel, scaled_depth);
+        rs::float3 depth_point = m_intrinsics[RS_STREAM_DEPTH].deproject(depth_pixel, scaled_depth);
 
         if (depth_point.z <= 0 || depth_point.z > max_Z) {
           depth_point.x = depth_point.y = depth_point.z = 0;
         }
+        //Fill the output in place : the per-pixel vpColVector allocation
+        //only happens on the first frame at a given size
+        vpColVector &p3d = pointcloud[(size_t)oi*out_w + oj];
+        if (p3d.getRows() != 4)
+          p3d.resize(4);
         p3d[0] = depth_point.x;
         p3d[1] = depth_point.y;
         p3d[2] = depth_point.z;
         p3d[3] = 1;
-
-        pointcloud[i*width + j] = p3d;
       }
     }
   }
@@ -0,0 +1,103 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Batch tracking of multiple blobs over one image traversal per frame.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpBlobBatchTracker_h_
+#define __vpBlobBatchTracker_h_
+
+#include <visp3/blob/vpConnectedComponents.h>
+
+/*!
+  \class vpBlobBatchTracker
+  \ingroup module_blob
+
+  \brief Track several blobs with a single image traversal per frame.
+
+  Tracking N dots with one vpDot2 each traverses the image N times.
+  This tracker labels every blob of the frame once with
+  vpConnectedComponents, then matches each tracked blob to the closest
+  detected component; a blob whose closest component is farther than the
+  allowed displacement is flagged lost and keeps its last position:
+
+  \code
+  vpBlobBatchTracker tracker;
+  tracker.initTracking(I, 128, 255, 20);       // track every blob present
+  while (grab(I)) {
+    tracker.track(I);                          // one traversal for all blobs
+    for (unsigned int b = 0; b < tracker.getNbBlobs(); b++)
+      if (!tracker.isLost(b))
+        use(tracker.getCog(b));
+  }
+  \endcode
+*/
+class VISP_EXPORT vpBlobBatchTracker
+{
+public:
+  vpBlobBatchTracker()
+    : m_cc(), m_cogs(), m_areas(), m_lost(), m_gray_min(0), m_gray_max(255),
+      m_min_area(1), m_max_displacement(20.)
+  {
+  }
+
+  void initTracking(const vpImage<unsigned char> &I,
+                    unsigned char gray_min, unsigned char gray_max,
+                    unsigned int min_area = 1);
+  void track(const vpImage<unsigned char> &I);
+
+  //! Return the number of tracked blobs.
+  inline unsigned int getNbBlobs() const { return (unsigned int)m_cogs.size(); }
+  //! Return the center of gravity of blob \e b.
+  inline const vpImagePoint &getCog(unsigned int b) const { return m_cogs[b]; }
+  //! Return the area in pixels of blob \e b.
+  inline unsigned int getArea(unsigned int b) const { return m_areas[b]; }
+  //! Return true when blob \e b could not be matched in the last frame.
+  inline bool isLost(unsigned int b) const { return m_lost[b] != 0; }
+
+  //! Set the maximal displacement in pixels of a blob between two frames.
+  inline void setMaxDisplacement(double dist) { m_max_displacement = dist; }
+
+private:
+  vpConnectedComponents m_cc;
+  std::vector<vpImagePoint> m_cogs;   //!< Tracked blob positions
+  std::vector<unsigned int> m_areas;  //!< Tracked blob areas
+  std::vector<char> m_lost;           //!< Lost flags
+  unsigned char m_gray_min;           //!< Grey level interval of the blobs
+  unsigned char m_gray_max;
+  unsigned int m_min_area;            //!< Minimal component area
+  double m_max_displacement;          //!< Maximal inter-frame displacement
+};
+
+#endif
@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Run-length connected component labeling for blob detection.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpConnectedComponents_h_
+#define __vpConnectedComponents_h_
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+
+/*!
+  \class vpConnectedComponents
+  \ingroup module_blob
+
+  \brief Run-length connected component labeling extracting all the blobs
+  of an image in one traversal.
+
+  vpDot2 grows one region at a time from a seed, which means one image
+  traversal per dot and a costly search when many blobs must be found.
+  This engine encodes each row in runs of pixels belonging to the grey
+  level interval, merges the runs with a union-find, and produces every
+  component with its area, centroid and bounding box in a single pass
+  over the image:
+
+  \code
+  vpConnectedComponents cc;
+  cc.detect(I, 128, 255, 20);                 // blobs with >= 20 pixels
+  for (unsigned int i = 0; i < cc.getNbComponents(); i++) {
+    const vpConnectedComponents::vpComponent &c = cc.getComponent(i);
+    // c.cog can seed a vpDot2 for precise tracking
+  }
+  \endcode
+
+  The components are sorted by decreasing area.
+*/
+class VISP_EXPORT vpConnectedComponents
+{
+public:
+  /*!
+    One connected component: pixel count, centroid and bounding box.
+  */
+  struct vpComponent {
+    unsigned int area;    //!< Number of pixels of the component
+    vpImagePoint cog;     //!< Center of gravity
+    unsigned int top;     //!< Bounding box top row
+    unsigned int bottom;  //!< Bounding box bottom row
+    unsigned int left;    //!< Bounding box left column
+    unsigned int right;   //!< Bounding box right column
+
+    vpComponent() : area(0), cog(), top(0), bottom(0), left(0), right(0) {}
+  };
+
+  vpConnectedComponents() : m_components() {}
+
+  void detect(const vpImage<unsigned char> &I,
+              unsigned char gray_min, unsigned char gray_max,
+              unsigned int min_area = 1);
+
+  //! Return the number of detected components.
+  inline unsigned int getNbComponents() const { return (unsigned int)m_components.size(); }
+
+  //! Return component \e i, the components being sorted by decreasing area.
+  inline const vpComponent &getComponent(unsigned int i) const { return m_components[i]; }
+
+private:
+  //! One row run of pixels inside the grey level interval.
+  struct vpRun {
+    unsigned int row;
+    unsigned int start;   //!< First column of the run
+    unsigned int end;     //!< One past the last column
+    unsigned int label;
+  };
+
+  std::vector<vpComponent> m_components;
+  std::vector<vpRun> m_runs;          //!< Run buffer reused between the calls
+  std::vector<unsigned int> m_parent; //!< Union-find forest over the run labels
+};
+
+#endif
@@ -0,0 +1,116 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Batch tracking of multiple blobs over one image traversal per frame.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/blob/vpBlobBatchTracker.h>
+
+#include <visp3/core/vpException.h>
+
+/*!
+  Initialize the tracker on every blob of the image whose pixels belong
+  to [\e gray_min, \e gray_max] and whose area reaches \e min_area: one
+  labeling pass detects them all.
+
+  \param I : Initial image.
+  \param gray_min, gray_max : Grey level interval of the blobs.
+  \param min_area : Minimal blob area in pixels.
+*/
+void vpBlobBatchTracker::initTracking(const vpImage<unsigned char> &I,
+                                      unsigned char gray_min, unsigned char gray_max,
+                                      unsigned int min_area)
+{
+  m_gray_min = gray_min;
+  m_gray_max = gray_max;
+  m_min_area = min_area;
+
+  m_cc.detect(I, gray_min, gray_max, min_area);
+
+  unsigned int n = m_cc.getNbComponents();
+  m_cogs.resize(n);
+  m_areas.resize(n);
+  m_lost.assign(n, 0);
+  for (unsigned int b = 0; b < n; b++) {
+    m_cogs[b] = m_cc.getComponent(b).cog;
+    m_areas[b] = m_cc.getComponent(b).area;
+  }
+}
+
+/*!
+  Track every blob with a single labeling pass over the frame: each
+  tracked blob takes the position of the closest detected component
+  within the allowed displacement, or is flagged lost and keeps its
+  last position. A lost blob recovers as soon as a component reappears
+  within range. The matching is not exclusive: two blobs closer than
+  the allowed displacement can lock on the same component, so the
+  displacement should stay below half the minimal blob spacing.
+
+  \param I : Current image.
+
+  \exception vpException::notInitialized : If initTracking() was not
+  called.
+*/
+void vpBlobBatchTracker::track(const vpImage<unsigned char> &I)
+{
+  if (m_cogs.empty()) {
+    throw(vpException(vpException::notInitialized,
+                      "The blob batch tracker is not initialized")) ;
+  }
+
+  m_cc.detect(I, m_gray_min, m_gray_max, m_min_area);
+
+  unsigned int nb_components = m_cc.getNbComponents();
+  for (unsigned int b = 0; b < m_cogs.size(); b++) {
+    double best_dist2 = m_max_displacement*m_max_displacement;
+    int best = -1;
+    for (unsigned int c = 0; c < nb_components; c++) {
+      double di = m_cc.getComponent(c).cog.get_i() - m_cogs[b].get_i();
+      double dj = m_cc.getComponent(c).cog.get_j() - m_cogs[b].get_j();
+      double d2 = di*di + dj*dj;
+      if (d2 <= best_dist2) {
+        best_dist2 = d2;
+        best = (int)c;
+      }
+    }
+    if (best >= 0) {
+      m_cogs[b] = m_cc.getComponent((unsigned int)best).cog;
+      m_areas[b] = m_cc.getComponent((unsigned int)best).area;
+      m_lost[b] = 0;
+    }
+    else {
+      m_lost[b] = 1;
+    }
+  }
+}
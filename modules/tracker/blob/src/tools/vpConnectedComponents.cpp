@@ -0,0 +1,172 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Run-length connected component labeling for blob detection.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/blob/vpConnectedComponents.h>
+
+#include <algorithm>
+#include <map>
+
+// Union-find with path halving
+static unsigned int vpCCFind(std::vector<unsigned int> &parent, unsigned int x)
+{
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+  }
+  return x;
+}
+
+static void vpCCUnion(std::vector<unsigned int> &parent, unsigned int a, unsigned int b)
+{
+  unsigned int ra = vpCCFind(parent, a);
+  unsigned int rb = vpCCFind(parent, b);
+  if (ra != rb)
+    parent[rb] = ra;
+}
+
+static bool vpCCAreaGreater(const vpConnectedComponents::vpComponent &a,
+                            const vpConnectedComponents::vpComponent &b)
+{
+  return a.area > b.area;
+}
+
+/*!
+  Detect every connected component (8-connexity) whose pixels belong to
+  the grey level interval [\e gray_min, \e gray_max], in one traversal of
+  the image: each row is encoded in runs, the runs overlapping between
+  two consecutive rows are merged with a union-find, and the component
+  statistics are accumulated per run.
+
+  \param I : Input image.
+  \param gray_min, gray_max : Grey level interval defining the blobs.
+  \param min_area : Components with fewer pixels are discarded.
+*/
+void vpConnectedComponents::detect(const vpImage<unsigned char> &I,
+                                   unsigned char gray_min, unsigned char gray_max,
+                                   unsigned int min_area)
+{
+  m_components.clear();
+  m_runs.clear();
+  m_parent.clear();
+
+  unsigned int height = I.getHeight(), width = I.getWidth();
+  if (height == 0 || width == 0)
+    return;
+
+  size_t prev_row_begin = 0, prev_row_end = 0;
+
+  for (unsigned int i = 0; i < height; i++) {
+    const unsigned char *row = I[i];
+    size_t cur_row_begin = m_runs.size();
+
+    // Encode the row in runs
+    unsigned int j = 0;
+    while (j < width) {
+      if (row[j] >= gray_min && row[j] <= gray_max) {
+        vpRun run;
+        run.row = i;
+        run.start = j;
+        while (j < width && row[j] >= gray_min && row[j] <= gray_max)
+          j++;
+        run.end = j;
+        run.label = (unsigned int)m_parent.size();
+        m_parent.push_back(run.label);
+        m_runs.push_back(run);
+      }
+      else {
+        j++;
+      }
+    }
+
+    // Merge with the overlapping runs of the previous row (8-connexity:
+    // runs touching diagonally overlap once extended by one pixel)
+    size_t cur_row_end = m_runs.size();
+    size_t p = prev_row_begin;
+    for (size_t c = cur_row_begin; c < cur_row_end; c++) {
+      while (p < prev_row_end && m_runs[p].end + 1 <= m_runs[c].start)
+        p++;
+      size_t p2 = p;
+      while (p2 < prev_row_end && m_runs[p2].start <= m_runs[c].end) {
+        vpCCUnion(m_parent, m_runs[p2].label, m_runs[c].label);
+        p2++;
+      }
+      // The last overlapping previous run may also overlap the next
+      // current run: do not advance p past it
+      if (p2 > p)
+        p = p2 - 1;
+    }
+
+    prev_row_begin = cur_row_begin;
+    prev_row_end = cur_row_end;
+  }
+
+  // Accumulate the component statistics per representative label
+  std::map<unsigned int, vpComponent> components;
+  std::map<unsigned int, double> sum_i, sum_j;
+  for (size_t r = 0; r < m_runs.size(); r++) {
+    const vpRun &run = m_runs[r];
+    unsigned int root = vpCCFind(m_parent, run.label);
+    vpComponent &c = components[root];
+    unsigned int len = run.end - run.start;
+    if (c.area == 0) {
+      c.top = c.bottom = run.row;
+      c.left = run.start;
+      c.right = run.end - 1;
+    }
+    else {
+      if (run.row < c.top) c.top = run.row;
+      if (run.row > c.bottom) c.bottom = run.row;
+      if (run.start < c.left) c.left = run.start;
+      if (run.end - 1 > c.right) c.right = run.end - 1;
+    }
+    c.area += len;
+    sum_i[root] += (double)run.row * len;
+    sum_j[root] += ((double)run.start + (double)(run.end - 1)) * len / 2.;
+  }
+
+  for (std::map<unsigned int, vpComponent>::iterator it = components.begin();
+       it != components.end(); ++it) {
+    vpComponent &c = it->second;
+    if (c.area >= min_area) {
+      c.cog.set_i(sum_i[it->first] / c.area);
+      c.cog.set_j(sum_j[it->first] / c.area);
+      m_components.push_back(c);
+    }
+  }
+
+  std::sort(m_components.begin(), m_components.end(), vpCCAreaGreater);
+}
@@ -136,6 +136,16 @@ public:
 
   vpKltOpencv & operator=(const vpKltOpencv& copy);
   void track(const cv::Mat &I);
+  void track(const std::vector<cv::Mat> &pyramid);
+
+  bool redetect(const cv::Mat &I, const cv::Mat &mask=cv::Mat());
+  //! Arm the redetection budget: redetect() only runs the corner
+  //! detector when fewer than \e min_features survive and at least
+  //! \e min_interval frames elapsed since the last detection.
+  inline void setRedetectionBudget(unsigned int min_features, unsigned int min_interval=0) {
+    m_redetectMinFeatures = min_features;
+    m_redetectMinInterval = min_interval;
+  }
   void setBlockSize(const int blockSize);
   void setHarrisFreeParameter(double harris_k);
   void setInitialGuess(const std::vector<cv::Point2f> &guess_pts);
@@ -153,6 +163,15 @@ public:
 
 protected:
   cv::Mat m_gray, m_prevGray;
+  //! Optical flow pyramids persisted between the track() calls so that
+  //! only the pyramid of the new frame is built per iteration.
+  std::vector<cv::Mat> m_pyramid, m_prevPyramid;
+  bool m_prevPyramidReady;
+  //! Redetection budget: minimal surviving feature count and minimal
+  //! frame interval between two detections.
+  unsigned int m_redetectMinFeatures;
+  unsigned int m_redetectMinInterval;
+  unsigned int m_framesSinceRedetection;
   std::vector<cv::Point2f> m_points[2]; //!< Previous [0] and current [1] keypoint location
   std::vector<long> m_points_id;     //!< Keypoint id
   int m_maxCount;
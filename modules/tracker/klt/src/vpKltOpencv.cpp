@@ -58,7 +58,9 @@
   Default constructor.
  */
 vpKltOpencv::vpKltOpencv()
-  : m_gray(), m_prevGray(), m_points_id(), m_maxCount(500), m_termcrit(), m_winSize(10), m_qualityLevel(0.01),
+  : m_gray(), m_prevGray(), m_pyramid(), m_prevPyramid(), m_prevPyramidReady(false),
+    m_redetectMinFeatures(0), m_redetectMinInterval(0), m_framesSinceRedetection(0),
+    m_points_id(), m_maxCount(500), m_termcrit(), m_winSize(10), m_qualityLevel(0.01),
     m_minDistance(15), m_minEigThreshold(1e-4), m_harris_k(0.04), m_blockSize(3), m_useHarrisDetector(1), m_pyrMaxLevel(3),
     m_next_points_id(0), m_initial_guess(false)
 {
@@ -70,7 +72,9 @@ vpKltOpencv::vpKltOpencv()
   Copy constructor.
  */
 vpKltOpencv::vpKltOpencv(const vpKltOpencv& copy)
-  : m_gray(), m_prevGray(), m_points_id(), m_maxCount(500), m_termcrit(), m_winSize(10), m_qualityLevel(0.01),
+  : m_gray(), m_prevGray(), m_pyramid(), m_prevPyramid(), m_prevPyramidReady(false),
+    m_redetectMinFeatures(0), m_redetectMinInterval(0), m_framesSinceRedetection(0),
+    m_points_id(), m_maxCount(500), m_termcrit(), m_winSize(10), m_qualityLevel(0.01),
     m_minDistance(15), m_minEigThreshold(1e-4), m_harris_k(0.04), m_blockSize(3), m_useHarrisDetector(1), m_pyrMaxLevel(3),
     m_next_points_id(0), m_initial_guess(false)
 {
@@ -84,6 +88,9 @@ vpKltOpencv & vpKltOpencv::operator=(const vpKltOpencv& copy)
 {
   m_gray = copy.m_gray;
   m_prevGray = copy.m_prevGray;
+  m_pyramid = copy.m_pyramid;
+  m_prevPyramid = copy.m_prevPyramid;
+  m_prevPyramidReady = copy.m_prevPyramidReady;
   m_points[0] = copy.m_points[0];
   m_points[1] = copy.m_points[1];
   m_points_id = copy.m_points_id;
@@ -98,6 +105,9 @@ vpKltOpencv & vpKltOpencv::operator=(const vpKltOpencv& copy)
   m_useHarrisDetector = copy.m_useHarrisDetector;
   m_pyrMaxLevel = copy.m_pyrMaxLevel;
   m_next_points_id = copy.m_next_points_id;
+  m_redetectMinFeatures = copy.m_redetectMinFeatures;
+  m_redetectMinInterval = copy.m_redetectMinInterval;
+  m_framesSinceRedetection = copy.m_framesSinceRedetection;
   m_initial_guess = copy.m_initial_guess;
 
   return *this;
@@ -119,6 +129,8 @@ vpKltOpencv::~vpKltOpencv()
 */
 void vpKltOpencv::initTracking(const cv::Mat &I, const cv::Mat &mask)
 {
+  m_prevPyramidReady = false;
+
   m_next_points_id = 0;
 
   //cvtColor(I, m_gray, cv::COLOR_BGR2GRAY);
@@ -170,11 +182,127 @@ void vpKltOpencv::track(const cv::Mat &I)
     m_gray.copyTo(m_prevGray);
   }
 
+  // Build only the pyramid of the new frame; the pyramid of the previous
+  // frame is persisted between the calls (only Mat headers are swapped)
+  if (!m_prevPyramidReady) {
+    cv::buildOpticalFlowPyramid(m_prevGray, m_prevPyramid, cv::Size(m_winSize, m_winSize), m_pyrMaxLevel);
+  }
+  cv::buildOpticalFlowPyramid(m_gray, m_pyramid, cv::Size(m_winSize, m_winSize), m_pyrMaxLevel);
+
+  std::vector<uchar> status;
+
+  cv::calcOpticalFlowPyrLK(m_prevPyramid, m_pyramid, m_points[0], m_points[1], status, err, cv::Size(m_winSize, m_winSize),
+      m_pyrMaxLevel, m_termcrit, flags, m_minEigThreshold);
+
+  std::swap(m_prevPyramid, m_pyramid);
+  m_prevPyramidReady = true;
+
+  // Remove points that are lost
+  for (int i=(int)status.size()-1; i>=0; i--) {
+    if (status[(size_t)i] == 0) { // point is lost
+      m_points[0].erase(m_points[0].begin()+i);
+      m_points[1].erase(m_points[1].begin()+i);
+      m_points_id.erase(m_points_id.begin()+i);
+    }
+  }
+}
+
+/*!
+  Replenish the tracked features under a redetection budget: the corner
+  detector only runs when fewer than the configured minimum of features
+  survived the tracking and when the configured number of frames elapsed
+  since the last detection, so that the expensive detection does not run
+  every frame. New corners are detected away from the surviving features
+  (masked by the minimal distance) and appended with fresh ids, the
+  surviving features being kept with their ids.
+
+  \param I : Current image.
+  \param mask : Optional detection mask, as in initTracking().
+  \return true when a detection pass was performed.
+
+  \sa setRedetectionBudget()
+*/
+bool vpKltOpencv::redetect(const cv::Mat &I, const cv::Mat &mask)
+{
+  m_framesSinceRedetection++;
+
+  if (m_redetectMinFeatures == 0)
+    return false;
+  if (m_points[1].size() >= m_redetectMinFeatures)
+    return false;
+  if (m_framesSinceRedetection < m_redetectMinInterval)
+    return false;
+
+  // Mask out the neighborhood of the surviving features so that the
+  // detector only proposes new corners
+  cv::Mat detection_mask;
+  if (mask.empty())
+    detection_mask = cv::Mat(I.size(), CV_8UC1, cv::Scalar(255));
+  else
+    mask.copyTo(detection_mask);
+  int radius = (int)m_minDistance;
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    cv::circle(detection_mask, m_points[1][i], radius, cv::Scalar(0), -1);
+  }
+
+  int nb_to_detect = m_maxCount - (int)m_points[1].size();
+  if (nb_to_detect <= 0)
+    return false;
+
+  std::vector<cv::Point2f> new_points;
+  cv::goodFeaturesToTrack(I, new_points, nb_to_detect, m_qualityLevel, m_minDistance,
+                          detection_mask, m_blockSize, 0, m_harris_k);
+
+  for (size_t i = 0; i < new_points.size(); i++) {
+    m_points[1].push_back(new_points[i]);
+    m_points_id.push_back(m_next_points_id++);
+  }
+
+  m_framesSinceRedetection = 0;
+  return true;
+}
+
+/*!
+  Track the features using an externally built optical flow pyramid
+  (cv::buildOpticalFlowPyramid with the tracker window size and level
+  count), so that one pyramid can be shared by several trackers running
+  on the same frame. Only the cv::Mat headers of \e pyramid are
+  retained for the next call: the handoff copies no pixel.
+
+  \param pyramid : Optical flow pyramid of the new frame.
+*/
+void vpKltOpencv::track(const std::vector<cv::Mat> &pyramid)
+{
+  if(m_points[1].size() == 0)
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+
+  std::vector<float> err;
+  int flags = 0;
+
+  if (m_initial_guess) {
+    flags |= cv::OPTFLOW_USE_INITIAL_FLOW;
+    m_initial_guess = false;
+  }
+  else {
+    std::swap(m_points[1], m_points[0]);
+  }
+
+  if (!m_prevPyramidReady) {
+    if (m_prevGray.empty())
+      pyramid[0].copyTo(m_prevGray);
+    cv::buildOpticalFlowPyramid(m_prevGray, m_prevPyramid, cv::Size(m_winSize, m_winSize), m_pyrMaxLevel);
+  }
+
   std::vector<uchar> status;
 
-  cv::calcOpticalFlowPyrLK(m_prevGray, m_gray, m_points[0], m_points[1], status, err, cv::Size(m_winSize, m_winSize),
+  cv::calcOpticalFlowPyrLK(m_prevPyramid, pyramid, m_points[0], m_points[1], status, err, cv::Size(m_winSize, m_winSize),
       m_pyrMaxLevel, m_termcrit, flags, m_minEigThreshold);
 
+  // Retain the shared pyramid headers as the previous pyramid: no pixel
+  // is copied, the Mats are reference counted
+  m_prevPyramid = pyramid;
+  m_prevPyramidReady = true;
+
   // Remove points that are lost
   for (int i=(int)status.size()-1; i>=0; i--) {
     if (status[(size_t)i] == 0) { // point is lost
@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpPoint.h>
 #include <visp3/mbt/vpMbTracker.h>
+#include <visp3/core/vpImagePyramid.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/mbt/vpMbtMeLine.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
@@ -295,6 +296,14 @@ class VISP_EXPORT vpMbEdgeTracker: virtual public vpMbTracker
     
     //! Number of polygon (face) currently visible. 
     unsigned int nbvisiblepolygone;
+
+    //! Global moving-edge site budget redistributed across the lines every frame, 0 when disabled.
+    unsigned int m_siteBudget;
+
+    //! Residual of the last computeVVS() call, published in the telemetry records.
+    double m_vvsResidual;
+    //! Iterations of the last computeVVS() call, published in the telemetry records.
+    unsigned int m_vvsIterations;
     
     //! Percentage of good points over total number of points below which tracking is supposed to have failed.
     double percentageGdPt;
@@ -304,6 +313,12 @@ class VISP_EXPORT vpMbEdgeTracker: virtual public vpMbTracker
     
     //! Pyramid of image associated to the current image. This pyramid is computed in the init() and in the track() methods.
     std::vector< const vpImage<unsigned char>* > Ipyramid;
+  //! Pool of pyramid objects whose buffers are reused between the
+  //! frames by initPyramid(); one entry per concurrently alive pyramid
+  //! (one per camera for the multi camera tracker).
+  std::vector<vpImagePyramid *> m_pyramidPool;
+  //! Next free entry of the pyramid pool.
+  unsigned int m_pyramidPoolNext;
     
     //! Current scale level used. This attribute must not be modified outside of the downScale() and upScale() methods, as it used to specify to some methods which set of distanceLine use. 
     unsigned int scaleLevel;
@@ -459,6 +474,15 @@ public:
   
   void setMovingEdge(const vpMe &me);
 
+  void setGlobalSiteBudget(const unsigned int &budget);
+
+  /*!
+    Get the global moving-edge site budget.
+
+    \return The site budget, 0 when the adaptive density controller is disabled.
+  */
+  inline unsigned int getGlobalSiteBudget() const { return m_siteBudget; }
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix& cdMo);
   
   void setScales(const std::vector<bool>& _scales);
@@ -520,10 +544,12 @@ protected:
   void removeCylinder(const std::string& name);
   void removeLine(const std::string& name);
   void resetMovingEdge();
+  void seedMovingEdge(const vpHomogeneousMatrix &cMo_prev);
   void testTracking();
   void trackMovingEdge(const vpImage<unsigned char> &I) ;
   void updateMovingEdge(const vpImage<unsigned char> &I) ;
   void updateMovingEdgeWeights();
+  void updateSiteDensity();
   void upScale(const unsigned int _scale); 
   void visibleFace(const vpImage<unsigned char> &_I, const vpHomogeneousMatrix &_cMo, bool &newvisibleline) ; 
   //@}
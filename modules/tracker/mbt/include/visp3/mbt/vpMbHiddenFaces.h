@@ -46,6 +46,7 @@
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 #include <visp3/mbt/vpMbScanLine.h>
+#include <visp3/core/vpThread.h>
 
 #ifdef VISP_HAVE_OGRE
   #include <visp3/ar/vpAROgre.h>
@@ -71,6 +72,12 @@ class vpMbHiddenFaces
   //! Number of visible polygon
   unsigned int nbVisiblePolygon;
   vpMbScanLine scanlineRender;
+  //! Thread running an asynchronous scan line render, NULL when inactive
+  vpThread *scanlineRenderThread;
+  //! Parameters handed to the asynchronous scan line render
+  vpCameraParameters scanlineRenderCam;
+  unsigned int scanlineRenderWidth;
+  unsigned int scanlineRenderHeight;
   
 #ifdef VISP_HAVE_OGRE
   vpImage<unsigned char> ogreBackground;
@@ -80,8 +87,24 @@ class vpMbHiddenFaces
   vpAROgre *ogre;
   std::vector< Ogre::ManualObject* > lOgrePolygons;
   bool ogreShowConfigDialog;
+  //! True when the Ogre visibility queries run asynchronously with one frame latency
+  bool ogreAsyncVisibility;
+  //! Thread running the asynchronous Ogre visibility query, NULL when inactive
+  vpThread *ogreVisibilityThread;
+  //! Camera position handed to the asynchronous visibility query
+  vpTranslationVector ogreVisibilityCameraPos;
+  //! Per-polygon results being computed by the asynchronous query
+  std::vector<unsigned char> ogreVisibilityBack;
+  //! Published per-polygon results of the last completed query
+  std::vector<unsigned char> ogreVisibilityFront;
+  //! True when ogreVisibilityFront holds the results of a completed query
+  bool ogreVisibilityValid;
+
+  bool          testVisibilityOgre(const vpTranslationVector &cameraPos, const unsigned int &index);
+  bool          ogreVisibilityTest(const vpTranslationVector &cameraPos, const unsigned int &index);
+  void          startOgreVisibilityQuery(const vpTranslationVector &cameraPos);
 #endif
-  
+
   unsigned int  setVisiblePrivate(const vpHomogeneousMatrix &cMo, const double &angleAppears, const double &angleDisappears,
                            bool &changed, 
                            bool useOgre = false, bool not_used = false,
@@ -106,6 +129,13 @@ class vpMbHiddenFaces
 
     void computeScanLineRender(const vpCameraParameters &cam, const unsigned int &w, const unsigned int &h);
 
+    void startScanLineRender(const vpCameraParameters &cam, const unsigned int &w, const unsigned int &h);
+    void waitScanLineRender();
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    //! Internal entry point of the asynchronous render thread.
+    void runScanLineRenderThread() { computeScanLineRender(scanlineRenderCam, scanlineRenderWidth, scanlineRenderHeight); }
+#endif
+
     void computeScanLineQuery(const vpPoint &a, const vpPoint &b,
                               std::vector<std::pair<vpPoint, vpPoint> > &lines, const bool &displayResults = false);
 
@@ -236,6 +266,35 @@ class vpMbHiddenFaces
     inline void setOgreShowConfigDialog(const bool showConfigDialog){
       ogreShowConfigDialog = showConfigDialog;
     }
+
+    /*!
+      Enable/Disable the asynchronous Ogre visibility service. When enabled,
+      the ray casting queries of a frame run in a background thread that
+      overlaps the tracking of that frame, and the visibility test consumes
+      the results computed at the previous frame. The one frame latency is
+      harmless for the slowly evolving visibility the queries measure, and
+      the synchronous stall of the queries disappears from the main loop.
+      The very first frame falls back to synchronous queries. Disabling the
+      service waits for a possibly running query.
+
+      \warning While a query runs the Ogre scene must not be touched:
+      displayOgre() in particular has to be called after the next visibility
+      test or after waitOgreVisibilityQuery().
+
+      \param async : True to spread the queries over a background thread,
+      false (default) to keep them synchronous.
+    */
+    void          setOgreAsyncVisibilityTest(const bool &async) {
+      if (!async) {
+        waitOgreVisibilityQuery();
+        ogreVisibilityValid = false;
+      }
+      ogreAsyncVisibility = async;
+    }
+
+    void          waitOgreVisibilityQuery();
+    //! Entry point of the asynchronous visibility query thread, not meant to be called directly.
+    void          runOgreVisibilityQueryThread();
 #endif
     
     unsigned int  setVisible(const vpImage<unsigned char>& I, const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, const double &angle, bool &changed) ;
@@ -259,7 +318,8 @@ class vpMbHiddenFaces
 */
 template<class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
-  : Lpol(), nbVisiblePolygon(0), scanlineRender()
+  : Lpol(), nbVisiblePolygon(0), scanlineRender(),
+    scanlineRenderThread(NULL), scanlineRenderCam(), scanlineRenderWidth(0), scanlineRenderHeight(0)
 {
 #ifdef VISP_HAVE_OGRE
   ogreInitialised = false;
@@ -268,6 +328,9 @@ vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
   ogreShowConfigDialog = false;
   ogre = new vpAROgre();
   ogreBackground = vpImage<unsigned char>(480, 640, 0);
+  ogreAsyncVisibility = false;
+  ogreVisibilityThread = NULL;
+  ogreVisibilityValid = false;
 #endif
 }
 
@@ -277,6 +340,11 @@ vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
 template<class PolygonType>
 vpMbHiddenFaces<PolygonType>::~vpMbHiddenFaces()
 {
+  waitScanLineRender();
+#ifdef VISP_HAVE_OGRE
+  waitOgreVisibilityQuery();
+#endif
+
   for(unsigned int i = 0 ; i < Lpol.size() ; i++){
     if (Lpol[i]!=NULL){
       delete Lpol[i] ;
@@ -344,6 +412,9 @@ vpMbHiddenFaces<PolygonType>::reset()
   Lpol.resize(0);
 
 #ifdef VISP_HAVE_OGRE
+  waitOgreVisibilityQuery();
+  ogreVisibilityValid = false;
+
   if(ogre != NULL){
     delete ogre;
     ogre = NULL;
@@ -420,6 +491,56 @@ vpMbHiddenFaces<PolygonType>::computeScanLineRender(const vpCameraParameters &ca
   scanlineRender.drawScene(listPolyClipped, listPolyIndices, cam, w, h);
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template<class PolygonType>
+vpThread::Return vpMbHiddenFacesScanLineRenderThread(vpThread::Args args)
+{
+  vpMbHiddenFaces<PolygonType> *faces = ( (vpMbHiddenFaces<PolygonType> *) args );
+  faces->runScanLineRenderThread();
+  return 0;
+}
+#endif
+
+/*!
+  Start the scan line render in a background thread, so that it overlaps
+  the acquisition of the next frame; waitScanLineRender() must be called
+  before any scan line query or before starting another render. The
+  clipped polygons must have been computed (computeClippedPolygons())
+  and must not be modified while the render runs, and no copy of the
+  container must be taken before the render completes (the container
+  copies are shallow, like its polygon list).
+
+  \param cam : Camera parameters.
+  \param w, h : Image size.
+
+  \sa waitScanLineRender(), computeScanLineRender()
+*/
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::startScanLineRender(const vpCameraParameters &cam, const unsigned int &w, const unsigned int &h)
+{
+  waitScanLineRender();
+  scanlineRenderCam = cam;
+  scanlineRenderWidth = w;
+  scanlineRenderHeight = h;
+  scanlineRenderThread = new vpThread((vpThread::Fn) vpMbHiddenFacesScanLineRenderThread<PolygonType>, (vpThread::Args) this);
+}
+
+/*!
+  Wait for the completion of the scan line render started with
+  startScanLineRender(). Harmless when no render is running.
+*/
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::waitScanLineRender()
+{
+  if (scanlineRenderThread != NULL) {
+    scanlineRenderThread->join();
+    delete scanlineRenderThread;
+    scanlineRenderThread = NULL;
+  }
+}
+
 /*!
   Compute Scanline visibility results for a line.
 
@@ -469,17 +590,50 @@ vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneousMatrix &cMo,
   if(useOgre){
 #ifdef VISP_HAVE_OGRE
     cMo.inverse().extract(cameraPos);
+    // Publish the results of the visibility query launched at the previous
+    // frame before touching the renderer again
+    waitOgreVisibilityQuery();
     ogre->renderOneFrame(ogreBackground, cMo);
 #else
     vpTRACE("ViSP doesn't have Ogre3D, simple visibility test used");
 #endif
   }
   
+#if defined(VISP_HAVE_OPENMP)
+  // Each face only touches its own state during the visibility test, so
+  // the faces are processed concurrently; the Ogre render based test
+  // stays sequential since the renderer is not thread safe
+  if (!useOgre) {
+    int nb_visible = 0;
+    int any_changed = 0;
+    int npol = (int)Lpol.size();
+#pragma omp parallel for schedule(dynamic) reduction(+:nb_visible) reduction(|:any_changed)
+    for (int i = 0; i < npol; i++) {
+      bool changed_i = false;
+      if (computeVisibility(cMo, angleAppears, angleDisappears, changed_i, useOgre, not_used, I, cam, cameraPos, (unsigned int)i))
+        nb_visible++;
+      if (changed_i)
+        any_changed = 1;
+    }
+    nbVisiblePolygon = (unsigned int)nb_visible;
+    changed = (any_changed != 0);
+    return nbVisiblePolygon;
+  }
+#endif
+
   for (unsigned int i = 0; i < Lpol.size(); i++){
     //std::cout << "Calling poly: " << i << std::endl;
     if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, i))
       nbVisiblePolygon ++;
   }
+
+#ifdef VISP_HAVE_OGRE
+  // Launch the visibility query of this frame in the background; its results
+  // will be consumed at the next frame
+  if (useOgre && ogreAsyncVisibility && ogreInitialised)
+    startOgreVisibilityQuery(cameraPos);
+#endif
+
   return nbVisiblePolygon;
 }
 
@@ -530,7 +684,7 @@ vpMbHiddenFaces<PolygonType>::computeVisibility(const vpHomogeneousMatrix &cMo,
     if(!testDisappear){
       if(useOgre)
 #ifdef VISP_HAVE_OGRE
-        testDisappear = ((!Lpol[i]->isVisible(cMo, angleDisappears, true, cam, I)) || !isVisibleOgre(cameraPos,i));
+        testDisappear = ((!Lpol[i]->isVisible(cMo, angleDisappears, true, cam, I)) || !ogreVisibilityTest(cameraPos,i));
 #else
       {
         (void)cameraPos; // Avoid warning
@@ -562,7 +716,7 @@ vpMbHiddenFaces<PolygonType>::computeVisibility(const vpHomogeneousMatrix &cMo,
     if(testAppear){
       if(useOgre)
 #ifdef VISP_HAVE_OGRE
-        testAppear = ((Lpol[i]->isVisible(cMo, angleAppears, true, cam, I)) && isVisibleOgre(cameraPos,i));
+        testAppear = ((Lpol[i]->isVisible(cMo, angleAppears, true, cam, I)) && ogreVisibilityTest(cameraPos,i));
 #else
         testAppear = (Lpol[i]->isVisible(cMo, angleAppears, false, cam, I));
 #endif
@@ -732,23 +886,22 @@ vpMbHiddenFaces<PolygonType>::setVisibleOgre(const vpHomogeneousMatrix &cMo, con
 }
 
 /*!
-  Test the visibility of a polygon through Ogre3D via RayCasting.
-  
+  Perform the ray casting visibility test of a polygon through Ogre3D,
+  without touching the polygon state. Called synchronously by
+  isVisibleOgre() and from the asynchronous visibility query thread.
+
   \param cameraPos : Position of the camera in the 3D world.
   \param index : Index of the polygon.
-  
+
   \return Return true if the polygon is visible, False otherwise.
 */
 template<class PolygonType>
-bool                           
-vpMbHiddenFaces<PolygonType>::isVisibleOgre(const vpTranslationVector &cameraPos, const unsigned int &index)
+bool
+vpMbHiddenFaces<PolygonType>::testVisibilityOgre(const vpTranslationVector &cameraPos, const unsigned int &index)
 {
   Ogre::Vector3 camera((Ogre::Real)cameraPos[0],(Ogre::Real)cameraPos[1],(Ogre::Real)cameraPos[2]);
-  if(!ogre->getCamera()->isVisible(lOgrePolygons[index]->getBoundingBox())){
-    lOgrePolygons[index]->setVisible(false);
-    Lpol[index]->isvisible = false;
+  if(!ogre->getCamera()->isVisible(lOgrePolygons[index]->getBoundingBox()))
     return false;
-  }
 
   //Get the center of gravity
   bool visible = false;
@@ -867,17 +1020,107 @@ vpMbHiddenFaces<PolygonType>::isVisibleOgre(const vpTranslationVector &cameraPos
   else
     visible = false;
 
-  if(visible){
-    lOgrePolygons[index]->setVisible(true);
-    Lpol[index]->isvisible = true;
-  }
-  else{
-    lOgrePolygons[index]->setVisible(false);
-    Lpol[index]->isvisible = false;
-  }
+  return visible;
+}
+
+/*!
+  Test the visibility of a polygon through Ogre3D via RayCasting.
+
+  \param cameraPos : Position of the camera in the 3D world.
+  \param index : Index of the polygon.
+
+  \return Return true if the polygon is visible, False otherwise.
+*/
+template<class PolygonType>
+bool
+vpMbHiddenFaces<PolygonType>::isVisibleOgre(const vpTranslationVector &cameraPos, const unsigned int &index)
+{
+  bool visible = testVisibilityOgre(cameraPos, index);
+
+  lOgrePolygons[index]->setVisible(visible);
+  Lpol[index]->isvisible = visible;
 
   return Lpol[index]->isvisible;
 }
+
+/*!
+  Ogre visibility test used by computeVisibility(): returns the result of
+  the query launched at the previous frame when the asynchronous service is
+  enabled and has published results, and falls back to a synchronous ray
+  casting otherwise (in particular at the very first frame).
+
+  \param cameraPos : Position of the camera in the 3D world.
+  \param index : Index of the polygon.
+
+  \return Return true if the polygon is visible, False otherwise.
+*/
+template<class PolygonType>
+bool
+vpMbHiddenFaces<PolygonType>::ogreVisibilityTest(const vpTranslationVector &cameraPos, const unsigned int &index)
+{
+  if (ogreAsyncVisibility && ogreVisibilityValid && index < ogreVisibilityFront.size()) {
+    bool visible = (ogreVisibilityFront[index] != 0);
+    lOgrePolygons[index]->setVisible(visible);
+    Lpol[index]->isvisible = visible;
+    return visible;
+  }
+
+  return isVisibleOgre(cameraPos, index);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template<class PolygonType>
+vpThread::Return vpMbHiddenFacesOgreVisibilityThread(vpThread::Args args)
+{
+  vpMbHiddenFaces<PolygonType> *faces = ( (vpMbHiddenFaces<PolygonType> *) args );
+  faces->runOgreVisibilityQueryThread();
+  return 0;
+}
+
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::runOgreVisibilityQueryThread()
+{
+  for (unsigned int i = 0; i < (unsigned int)ogreVisibilityBack.size(); i++)
+    ogreVisibilityBack[i] = testVisibilityOgre(ogreVisibilityCameraPos, i) ? 1 : 0;
+}
+#endif
+
+/*!
+  Launch the ray casting visibility queries of every polygon in a background
+  thread. The scene must not be rendered nor modified while the queries run:
+  waitOgreVisibilityQuery() is called before the next render in
+  setVisiblePrivate() and publishes the results.
+
+  \param cameraPos : Position of the camera in the 3D world.
+*/
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::startOgreVisibilityQuery(const vpTranslationVector &cameraPos)
+{
+  waitOgreVisibilityQuery();
+  ogreVisibilityCameraPos = cameraPos;
+  ogreVisibilityBack.resize(Lpol.size());
+  ogreVisibilityThread = new vpThread((vpThread::Fn) vpMbHiddenFacesOgreVisibilityThread<PolygonType>, (vpThread::Args) this);
+}
+
+/*!
+  Wait for the completion of the visibility query started with
+  startOgreVisibilityQuery() and publish its results. Harmless when no query
+  is running.
+*/
+template<class PolygonType>
+void
+vpMbHiddenFaces<PolygonType>::waitOgreVisibilityQuery()
+{
+  if (ogreVisibilityThread != NULL) {
+    ogreVisibilityThread->join();
+    delete ogreVisibilityThread;
+    ogreVisibilityThread = NULL;
+    ogreVisibilityFront = ogreVisibilityBack;
+    ogreVisibilityValid = true;
+  }
+}
 #endif //VISP_HAVE_OGRE
 
 #endif // vpMbHiddenFaces
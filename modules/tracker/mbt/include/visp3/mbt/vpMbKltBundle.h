@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bundled artifact of a learned detector and its klt model tracker.
+ *
+ *****************************************************************************/
+
+#ifndef __vpMbKltBundle_h_
+#define __vpMbKltBundle_h_
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+
+#include <visp3/core/vpArtifactBundle.h>
+#include <visp3/mbt/vpMbKltTracker.h>
+#include <visp3/vision/vpKeyPoint.h>
+
+/*!
+  \class vpMbKltBundle
+
+  \ingroup group_mbt_trackers
+
+  \brief Packaging of everything the keypoint based (re)initialization
+  of a vpMbKltTracker needs -- model geometry, learned reference
+  descriptors, matcher index and camera parameters -- as one
+  vpArtifactBundle file, with a one call loader that brings the
+  detector and the tracker to ready-to-detect state.
+
+  \code
+// training time :
+vpKeyPoint keypoint(detector, extractor, matcher);
+keypoint.buildReference(Iref);
+vpMbKltBundle::save("scene.vpb", keypoint, tracker, "scene.cao");
+
+// deployment, one call to be ready to detect :
+vpKeyPoint keypoint(detector, extractor, matcher);
+vpMbKltTracker tracker;
+vpMbKltBundle::load("scene.vpb", keypoint, tracker);
+  \endcode
+
+  \sa vpArtifactBundle, vpKeyPoint::saveLearningData()
+*/
+class VISP_EXPORT vpMbKltBundle
+{
+public:
+  static void save(const std::string &filename, vpKeyPoint &keypoint,
+                   const vpMbKltTracker &tracker, const std::string &modelFile);
+  static void load(const std::string &filename, vpKeyPoint &keypoint, vpMbKltTracker &tracker);
+};
+
+#endif
+#endif
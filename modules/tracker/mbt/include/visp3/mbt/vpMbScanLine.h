@@ -136,6 +136,17 @@ private:
   std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> visibility_samples;
   double                  depthTreshold;
 
+  //! Pixel tolerance under which the previous render is reused (0: always re-render)
+  double                  reuseTolerance;
+  //! True when the cached render (mask, ids, visibility samples) is valid
+  bool                    hasCachedRender;
+  //! Polygon ids of the cached render
+  std::vector<int>        cachedPolyIndices;
+  //! Projected pixel coordinates of the polygon vertices at the last effective render
+  std::vector<std::vector<std::pair<double, double> > > cachedPolyPixels;
+  //! Edge keys currently indexing visibility_samples, in polygon and edge order
+  std::vector<std::vector<vpMbScanLineEdge> > cachedEdgeKeys;
+
 public:
 #if defined(DEBUG_DISP)
   vpDisplay *dispMaskDebug;
@@ -158,6 +169,13 @@ public:
   */
   double                        getDepthTreshold() { return depthTreshold; }
   unsigned int                  getMaskBorder() { return maskBorder; }
+
+  /*!
+    Get the pixel tolerance under which the previous render is reused.
+
+    \return Current tolerance.
+  */
+  double                        getRenderReuseTolerance() const { return reuseTolerance; }
   const vpImage<unsigned char>& getMask() const  { return mask; }
   const vpImage<int>&           getPrimitiveIDs() const  { return primitive_ids; }
 
@@ -174,8 +192,25 @@ public:
   void                          setDepthTreshold(const double &treshold) { depthTreshold = treshold; }
   void                          setMaskBorder(const unsigned int &mb){ maskBorder = mb; }
 
+  /*!
+    Set the pixel tolerance under which the render of the previous call to
+    drawScene() is reused: when every polygon vertex projects within this
+    tolerance of where it was rasterized, the scanline structures are kept and
+    only the visibility sample keys are re-expressed with the new coordinates.
+
+    \param tol : Pixel tolerance (0 to always re-render).
+  */
+  void                          setRenderReuseTolerance(const double &tol) { reuseTolerance = tol; }
+
 
 private:
+  bool tryReuseRender(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > * > &polygons,
+                      const std::vector<int> &listPolyIndices,
+                      const vpCameraParameters &cam);
+
+  void recordRenderCache(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > * > &polygons,
+                         const std::vector<int> &listPolyIndices);
+
   void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
                                  std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
                                  const unsigned int &size);
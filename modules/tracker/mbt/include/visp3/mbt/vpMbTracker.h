@@ -57,12 +57,15 @@
 
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpLatencyStats.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPosePredictor.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 #include <visp3/mbt/vpMbHiddenFaces.h>
 #include <visp3/core/vpPolygon.h>
@@ -79,6 +82,8 @@
 # include <Inventor/VRMLnodes/SoVRMLIndexedLineSet.h>
 #endif
 
+class vpTrackerTelemetry;
+
 /*!
   \class vpMbTracker
   \ingroup group_mbt_trackers
@@ -125,8 +130,18 @@ protected:
   std::string poseSavingFilename;
   //! Flag used to specify if the covariance matrix has to be computed or not.
   bool computeCovariance;
-  //! Covariance matrix
-  vpMatrix covarianceMatrix;
+  //! Covariance matrix, computed on demand from the cached VVS factorization
+  mutable vpMatrix covarianceMatrix;
+  //! True when the cached VVS factorization must be turned into the covariance on demand
+  mutable bool m_covarianceDirty;
+  //! Pose before the last VVS update, cached for the deferred covariance computation
+  vpHomogeneousMatrix m_covCMoPrev;
+  //! Error vector of the last VVS solve, cached for the deferred covariance computation
+  vpColVector m_covError;
+  //! Jacobian of the last VVS solve, cached for the deferred covariance computation
+  vpMatrix m_covJacobian;
+  //! Robust weights of the last VVS solve, cached for the deferred covariance computation
+  vpColVector m_covWeights;
   //! Flag used to specify if the gradient error criteria has to be computed or not.
   bool computeProjError;
   //! Error angle between the gradient direction of the model features projected at the resulting pose and their normal.
@@ -152,11 +167,42 @@ protected:
   double distFarClip;
   //! Flags specifying which clipping to used
   unsigned int clippingFlag;
+  //! Pose displacement under which the polygon clipping result is reused
+  double clippedPolygonCacheTol;
+  //! Telemetry buffer the tracker publishes its per-frame diagnostics into, NULL when disabled
+  vpTrackerTelemetry *m_telemetry;
+  //! Frame counter of the telemetry records
+  unsigned int m_telemetryFrame;
+
+  //! One model build operation recorded while parsing a model file,
+  //! replayed by the binary model cache.
+  struct vpModelOp {
+    int type;                  //!< 0: face init from lines, 1: face init from corners, 2: cylinder, 3: circle
+    std::vector<vpPoint> pts;  //!< Corners, or axis/circle points
+    double radius;             //!< Cylinder or circle radius
+    std::string name;          //!< Polygon name
+    bool useLod;               //!< Level of detail flag
+    double minPolygonArea;     //!< LOD polygon area threshold
+    double minLineLength;      //!< LOD line length threshold
+
+    vpModelOp() : type(0), pts(), radius(0), name(), useLod(false), minPolygonArea(2500.), minLineLength(50.) {}
+  };
+  //! Operations recorded during the model parsing, see setModelCacheEnabled().
+  std::vector<vpModelOp> m_modelOps;
+  //! True while loadModel() records the build operations.
+  bool m_modelRecording;
+  //! True when the binary model cache is enabled.
+  bool m_modelCacheEnabled;
+
+  bool saveModelCache(const std::string &cacheFile) const;
+  bool replayModelCache(const std::string &cacheFile, const std::string &modelFile);
   //! Use Ogre3d for visibility tests
   bool useOgre;
   bool ogreShowConfigDialog;
   //! Use Scanline for visibility tests
   bool useScanLine;
+  //! Age of the frames processed by track(), see getDataLatencyStats()
+  vpLatencyStats m_dataLatency;
   //! Number of points in CAO model
   unsigned int nbPoints;
   //! Number of lines in CAO model
@@ -179,6 +225,8 @@ protected:
   double minPolygonAreaThresholdGeneral;
   //! Map with [map.first]=parameter_names and [map.second]=type (string, number or boolean)
   std::map<std::string, std::string> mapOfParameterNames;
+  //! Predictor seeding the pose at the beginning of each frame, NULL when disabled.
+  vpPosePredictor *m_posePredictor;
 
 public:
   vpMbTracker();
@@ -199,7 +247,16 @@ public:
     \param camera : copy of the camera parameters used by the tracker.
   */
   virtual void getCameraParameters(vpCameraParameters& camera) const { camera = this->cam;}
-  
+
+  /*!
+    Get the age-of-data statistics of the tracking : each track() call
+    on a frame stamped by its grabber (see vpImage::getTimestamp())
+    records the capture-to-tracking latency, so the delay the control
+    loop runs on is measurable without external hardware.
+  */
+  const vpLatencyStats &getDataLatencyStats() const { return m_dataLatency; }
+
+
   /*!
     Get the clipping used and defined in vpPolygon3D::vpMbtPolygonClippingType.
 
@@ -213,7 +270,17 @@ public:
   virtual vpMatrix getCovarianceMatrix() const { 
     if(!computeCovariance)
       vpTRACE("Warning : The covariance matrix has not been computed. See setCovarianceComputation() to do it.");
-    
+
+    // The trackers cache the factorization of their last VVS solve and the
+    // covariance is only computed here, on demand: consumers sampling it at
+    // a lower rate than the tracker do not pay the pseudo inverse per frame
+    if(m_covarianceDirty) {
+      vpMatrix D;
+      D.diag(m_covWeights);
+      covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(m_covCMoPrev, m_covError, m_covJacobian, D);
+      m_covarianceDirty = false;
+    }
+
     return covarianceMatrix; 
   }
 
@@ -353,6 +420,17 @@ public:
   virtual void initFromPoints( const vpImage<unsigned char>& I, const std::vector<vpImagePoint> &points2D_list, const std::vector<vpPoint> &points3D_list );
 
   virtual void initFromPose(const vpImage<unsigned char>& I, const std::string &initFile);
+
+  virtual bool saveCheckpoint(const std::string &filename) const;
+  virtual bool loadCheckpoint(const vpImage<unsigned char>& I, const std::string &filename);
+
+  /*! Enable or disable the binary model cache used by loadModel(): when
+    enabled, the model build operations parsed from a cao file are
+    recorded in a "<model>.bin" side file replayed on the next loads as
+    long as it is newer than the model file. vrml models are not
+    cached. Disabled by default. */
+  inline void setModelCacheEnabled(bool enable) { m_modelCacheEnabled = enable; }
+
   virtual void initFromPose(const vpImage<unsigned char>& I, const vpHomogeneousMatrix &cMo);
   virtual void initFromPose(const vpImage<unsigned char>& I, const vpPoseVector &cPo);
 
@@ -389,7 +467,10 @@ public:
   virtual void setCameraParameters(const vpCameraParameters& camera) {this->cam = camera;}
 
   virtual void setClipping(const unsigned int &flags);
-  
+
+  virtual void setClippedPolygonCacheTolerance(const double &tol);
+
+
   /*!
     Set if the covaraince matrix has to be computed.
 
@@ -438,6 +519,25 @@ public:
 
   virtual void setScanLineVisibilityTest(const bool &v){ useScanLine = v; }
 
+  /*!
+    Set the telemetry buffer the tracker publishes one diagnostics record
+    into at the end of each tracked frame. The tracking thread is the single
+    producer of the buffer; drain it from one monitoring thread.
+
+    \param telemetry : The telemetry buffer, NULL (default) to disable.
+  */
+  virtual inline void setTelemetry(vpTrackerTelemetry *telemetry) { m_telemetry = telemetry; }
+
+  /*!
+    Set the pixel tolerance under which the scan line visibility render of the
+    previous frame is reused instead of being recomputed. Useful when the
+    camera moves slowly with respect to the object since the visibility then
+    barely changes between frames.
+
+    \param tol : Pixel tolerance (0 to always re-render, which is the default).
+  */
+  virtual void setScanLineRenderReuseTolerance(const double &tol) { faces.getMbScanLineRenderer().setRenderReuseTolerance(tol); }
+
   virtual void setOgreVisibilityTest(const bool &v);
   
   void savePose(const std::string &filename) const;
@@ -464,6 +564,18 @@ public:
   void setNbRayCastingAttemptsForVisibility(const unsigned int &attempts) {
     faces.setNbRayCastingAttemptsForVisibility(attempts);
   }
+  /*!
+    Enable/Disable the asynchronous Ogre visibility service: the ray casting
+    queries of a frame run in a background thread and the visibility test
+    consumes the results computed at the previous frame, removing the
+    synchronous stall of the queries from the tracking loop.
+
+    \param async : True to run the queries asynchronously with one frame
+    latency, false (default) to keep them synchronous.
+  */
+  void setOgreAsyncVisibilityTest(const bool &async) {
+    faces.setOgreAsyncVisibilityTest(async);
+  }
 #endif
 
   /*!
@@ -493,6 +605,19 @@ public:
     poseSavingFilename = filename;
   }
 
+  /*!
+    Set a pose predictor warm starting the tracking. Once the predictor
+    has seen two frames, each call to track() starts from the predicted
+    pose instead of the pose estimated on the previous frame; with fast
+    motion this allows to reduce the moving-edge search range. The
+    predictor is fed automatically with the estimated poses. It is not
+    owned by the tracker and must stay alive while tracking.
+
+    \param predictor : The predictor to use, or NULL to restore the
+    default behaviour.
+  */
+  virtual inline void setPosePredictor(vpPosePredictor *predictor) { m_posePredictor = predictor; }
+
   /* PURE VIRTUAL METHODS */
 
   /*!
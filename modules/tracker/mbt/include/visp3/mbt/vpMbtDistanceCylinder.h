@@ -74,7 +74,13 @@ class VISP_EXPORT vpMbtDistanceCylinder
     vpFeatureLine featureline1 ;
     vpFeatureLine featureline2 ;
     bool isTrackedCylinder;
-    
+    //! Pose the geometry was last projected at, see projectFeatures()
+    vpHomogeneousMatrix m_cMoProjected;
+    //! True while the cached projection matches m_cMoProjected
+    bool m_projectionValid;
+    //! Outcome of the cached projection (false when a circle projection failed)
+    bool m_projectionOk;
+
   public: 
     //! The moving edge containers (first line of the cylinder)
     vpMbtMeLine *meline1;
@@ -265,6 +271,7 @@ class VISP_EXPORT vpMbtDistanceCylinder
 
   private:
     void project(const vpHomogeneousMatrix &cMo);
+    bool projectFeatures(const vpHomogeneousMatrix &cMo);
 } ;
 
 #endif
@@ -69,6 +69,10 @@ class VISP_EXPORT vpMbtDistanceLine
     unsigned int index;
     vpCameraParameters cam;
     vpMe *me;
+    //! Moving edge parameters of the line when its sampling density factor is not 1
+    vpMe m_meAdaptive;
+    //! Sampling density factor applied on top of the shared sample step
+    double m_sampleDensityFactor;
     bool isTrackedLine;
     bool isTrackedLineWithVisibility;
     double wmean;
@@ -82,6 +86,12 @@ class VISP_EXPORT vpMbtDistanceLine
     //! The moving edge container
     //vpMbtMeLine *meline;
     std::vector<vpMbtMeLine*> meline;
+    //! Retired moving-edge lines reused by the next initialization, so a
+    //! visibility transition does not reallocate them
+    std::vector<vpMbtMeLine*> m_melinePool;
+
+    vpMbtMeLine *acquireMeLine();
+    void releaseMeLines();
     //! The 3D line
     vpLine *line;
     //! The first extremity
@@ -134,6 +144,12 @@ class VISP_EXPORT vpMbtDistanceLine
     
     bool closeToImageBorder(const vpImage<unsigned char>& I, const unsigned int threshold);
     void computeInteractionMatrixError(const vpHomogeneousMatrix &cMo);
+
+    void computeInteractionMatrixError(const vpHomogeneousMatrix &cMo, vpMatrix &L_stack,
+                                       vpColVector &e_stack, const unsigned int &offset);
+    //! Invalidate the normalized site coordinate cache used by
+    //! computeInteractionMatrixError(); called whenever the sites change.
+    inline void invalidateSiteCache() { m_siteCacheValid = false; }
     
     void display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, const vpColor col, const unsigned int thickness = 1, const bool displayFullModel = false);
     void display(const vpImage<vpRGBa> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, const vpColor col, const unsigned int thickness = 1, const bool displayFullModel = false);
@@ -216,6 +232,15 @@ class VISP_EXPORT vpMbtDistanceLine
     inline void setMeanWeight(const double w_mean) {this->wmean = w_mean;}
     
     void setMovingEdge(vpMe *Me);
+
+    void setSampleDensityFactor(const double &factor);
+
+    /*!
+      Get the sampling density factor of the line.
+
+      \return The sampling density factor.
+    */
+    inline double getSampleDensityFactor() const { return m_sampleDensityFactor; }
     
     /*!
       Set the name of the line.
@@ -247,6 +272,16 @@ class VISP_EXPORT vpMbtDistanceLine
     void updateTracked();
 
   private:
+    vpMe *activeMe();
+
+    void refreshSiteCache();
+
+    //! Site pixel coordinates cached across the VVS iterations,
+    //! refreshed when the moving edges change.
+    std::vector<double> m_sitePixX;
+    std::vector<double> m_sitePixY;
+    bool m_siteCacheValid;
+
     void project(const vpHomogeneousMatrix &cMo);
 } ;
 
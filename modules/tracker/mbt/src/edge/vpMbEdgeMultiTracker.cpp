@@ -2886,19 +2886,36 @@ void vpMbEdgeMultiTracker::track(std::map<std::string, const vpImage<unsigned ch
       try
       {
         downScale(lvl);
+
+        // The cameras are independent: their moving edges are tracked
+        // concurrently, each tracker only touching its own state
+        std::vector<vpMbEdgeTracker *> camera_trackers;
+        std::vector<const vpImage<unsigned char> *> camera_images;
         for(std::map<std::string, vpMbEdgeTracker *>::const_iterator it1 = m_mapOfEdgeTrackers.begin();
             it1 != m_mapOfEdgeTrackers.end(); ++it1) {
           //Downscale for each camera
           it1->second->downScale(lvl);
+          camera_trackers.push_back(it1->second);
+          camera_images.push_back(m_mapOfPyramidalImages[it1->first][lvl]);
+        }
 
+        int nb_cameras = (int)camera_trackers.size();
+        int tracking_error = 0;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(|:tracking_error)
+#endif
+        for (int c = 0; c < nb_cameras; c++) {
           //Track moving edges
           try {
-            it1->second->trackMovingEdge(*m_mapOfPyramidalImages[it1->first][lvl]);
+            camera_trackers[(size_t)c]->trackMovingEdge(*camera_images[(size_t)c]);
           } catch(...) {
-            vpTRACE("Error in moving edge tracking") ;
-            throw ;
+            tracking_error = 1;
           }
         }
+        if (tracking_error) {
+          vpTRACE("Error in moving edge tracking") ;
+          throw vpTrackingException(vpTrackingException::fatalError, "Error in moving edge tracking");
+        }
 
         try {
           std::map<std::string, const vpImage<unsigned char> *> mapOfPyramidImages;
@@ -46,12 +46,15 @@
 #include <visp3/vision/vpPose.h>
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpRobust.h>
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbEdgeTracker.h>
+#include <visp3/core/vpProfiler.h>
+#include <visp3/core/vpTrackerTelemetry.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 #include <visp3/mbt/vpMbtXmlParser.h>
 #include <visp3/core/vpPolygon3D.h>
@@ -69,8 +72,8 @@
 */
 vpMbEdgeTracker::vpMbEdgeTracker()
   : compute_interaction(1), lambda(1), me(), lines(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0),
-    nbvisiblepolygone(0), percentageGdPt(0.4), scales(1),
-    Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0)
+    nbvisiblepolygone(0), m_siteBudget(0), m_vvsResidual(0.), m_vvsIterations(0), percentageGdPt(0.4), scales(1),
+    Ipyramid(0), m_pyramidPool(), m_pyramidPoolNext(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0)
 {
   angleAppears = vpMath::rad(89);
   angleDisappears = vpMath::rad(89);
@@ -87,6 +90,10 @@ vpMbEdgeTracker::vpMbEdgeTracker()
 */
 vpMbEdgeTracker::~vpMbEdgeTracker()
 {
+  for (size_t i_pyr = 0; i_pyr < m_pyramidPool.size(); i_pyr++)
+    delete m_pyramidPool[i_pyr];
+  m_pyramidPool.clear();
+
   vpMbtDistanceLine *l ;
   vpMbtDistanceCylinder *cy;
   vpMbtDistanceCircle *ci;
@@ -288,18 +295,24 @@ vpMbEdgeTracker::computeVVS(const vpImage<unsigned char>& _I, const unsigned int
 
 //   std::cout << "VVS estimate pose cMo:\n" << cMo << std::endl;
   if(computeCovariance){
-    vpMatrix D;
-    D.diag(W_true);
-
-    // Note that here the covariance is computed on cMoPrev for time computation efficiency
+    // The factorization inputs are cached and the covariance itself is
+    // computed on demand by getCovarianceMatrix(). Note that the covariance
+    // refers to cMoPrev for time computation efficiency
+    m_covCMoPrev = cMoPrev;
+    m_covError = m_error;
     if(isoJoIdentity_){
-        covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(cMoPrev,m_error,L_true,D);
+        m_covJacobian = L_true;
     }
     else{
-        covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(cMoPrev,m_error,LVJ_true,D);
+        m_covJacobian = LVJ_true;
     }
+    m_covWeights = W_true;
+    m_covarianceDirty = true;
   }
 
+  m_vvsResidual = r;
+  m_vvsIterations = iter;
+
   updateMovingEdgeWeights();
 }
 
@@ -322,7 +335,9 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
     if((*it)->isTracked())
     {
       l = *it;
-      l->computeInteractionMatrixError(cMo);
+      // The rows of the line are written directly into the stacked system
+      l->computeInteractionMatrixError(cMo, L, error, n);
+      const unsigned int n0 = n;
 
       double fac = 1;
       if (iter == 0)
@@ -353,12 +368,6 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
 
         for (unsigned int i=0 ; i < l->nbFeature[a] ; i++)
         {
-          for (unsigned int j=0; j < 6 ; j++)
-          {
-            L[n+i][j] = l->L[indexFeature][j]; //On remplit la matrice d'interaction globale
-          }
-          error[n+i] = l->error[indexFeature]; //On remplit la matrice d'erreur
-
           if (error[n+i] <= limite) count = count+1.0; //Si erreur proche de 0 on incremente cur
 
           w_mbt[n+i] = 0;
@@ -374,10 +383,10 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
           //If pour la premiere extremite des moving edges
           if (indexFeature == 0)
           {
-            e_cur = l->error[0];
+            e_cur = error[n0];
             if (l->nbFeature[a] > 1)
             {
-              e_next = l->error[1];
+              e_next = error[n0+1];
               if ( fabs(e_cur - e_next) < limite && vpMath::sign(e_cur) == vpMath::sign(e_next) )
               {
                 w_mbt[n+i] = 1/*0.5*/;
@@ -390,7 +399,7 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
           //If pour la derniere extremite des moving edges
           else if(indexFeature == l->nbFeatureTotal-1)
           {
-            e_cur = l->error[indexFeature];
+            e_cur = error[n0+indexFeature];
             if ( fabs(e_cur - e_prev) < limite && vpMath::sign(e_cur) == vpMath::sign(e_prev) )
             {
               w_mbt[n+i] += 1/*0.5*/;
@@ -399,8 +408,8 @@ vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char>& _I, const un
 
           else
           {
-            e_cur = l->error[indexFeature];
-            e_next = l->error[indexFeature+1];
+            e_cur = error[n0+indexFeature];
+            e_next = error[n0+indexFeature+1];
             if ( fabs(e_cur - e_prev) < limite )
             {
               w_mbt[n+i] += 0.5;
@@ -752,7 +761,12 @@ vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(const unsigned int nerror, c
   if(isoJoIdentity_){
       LTL = L.AtA();
       computeJTR(L, weighted_error, LTR);
-      v = -0.7*LTL.pseudoInverse(LTL.getRows()*std::numeric_limits<double>::epsilon())*LTR;
+      // Solve the normal equations through a Cholesky decomposition,
+      // several times cheaper than the SVD based pseudo inverse;
+      // choleskySolve() falls back on the SVD when LTL is ill conditioned
+      vpColVector sol;
+      LTL.choleskySolve(LTR, sol);
+      v = -0.7*sol;
   }
   else{
       cVo.buildFrom(cMo);
@@ -760,7 +774,9 @@ vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(const unsigned int nerror, c
       vpMatrix LVJTLVJ = (LVJ).AtA();
       vpColVector LVJTR;
       computeJTR(LVJ, weighted_error, LVJTR);
-      v = -0.7*LVJTLVJ.pseudoInverse(LVJTLVJ.getRows()*std::numeric_limits<double>::epsilon())*LVJTR;
+      vpColVector sol;
+      LVJTLVJ.choleskySolve(LVJTR, sol);
+      v = -0.7*sol;
       v = cVo * v;
   }
 
@@ -782,13 +798,10 @@ vpMbEdgeTracker::computeVVSSecondPhase(const vpImage<unsigned char>& _I, vpMatri
   for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[lvl].begin(); it!=lines[lvl].end(); ++it){
     if((*it)->isTracked()){
       l = *it;
-      l->computeInteractionMatrixError(cMo) ;
+      // The rows of the line are written directly into the stacked system
+      l->computeInteractionMatrixError(cMo, L, error, n) ;
       for (unsigned int i=0 ; i < l->nbFeatureTotal ; i++){
-        for (unsigned int j=0; j < 6 ; j++){
-          L[n+i][j] = l->L[i][j];
-          error[n+i] = l->error[i];
-          error_lines[nlines+i] = error[n+i];
-        }
+        error_lines[nlines+i] = error[n+i];
       }
       n+= l->nbFeatureTotal;
       nlines+= l->nbFeatureTotal;
@@ -911,7 +924,9 @@ vpMbEdgeTracker::computeVVSSecondPhasePoseEstimation(const unsigned int nerror,
       vpMatrix LMA(LTL.getRows(), LTL.getCols());
       LMA.eye();
       vpMatrix LTLmuI = LTL + (LMA*mu);
-      v = -lambda*LTLmuI.pseudoInverse(LTLmuI.getRows()*std::numeric_limits<double>::epsilon())*LTR;
+      vpColVector sol;
+      LTLmuI.choleskySolve(LTR, sol);
+      v = -lambda*sol;
 
       if(iter != 0)
         mu /= 10.0;
@@ -922,7 +937,9 @@ vpMbEdgeTracker::computeVVSSecondPhasePoseEstimation(const unsigned int nerror,
     }
     case vpMbTracker::GAUSS_NEWTON_OPT:
     default:
-      v = -lambda*LTL.pseudoInverse(LTL.getRows()*std::numeric_limits<double>::epsilon())*LTR;
+      vpColVector sol;
+      LTL.choleskySolve(LTR, sol);
+      v = -lambda*sol;
     }
   }
   else{
@@ -938,7 +955,9 @@ vpMbEdgeTracker::computeVVSSecondPhasePoseEstimation(const unsigned int nerror,
       vpMatrix LMA(LVJTLVJ.getRows(), LVJTLVJ.getCols());
       LMA.eye();
       vpMatrix LTLmuI = LVJTLVJ + (LMA*mu);
-      v = -lambda*LTLmuI.pseudoInverse(LTLmuI.getRows()*std::numeric_limits<double>::epsilon())*LVJTR;
+      vpColVector sol;
+      LTLmuI.choleskySolve(LVJTR, sol);
+      v = -lambda*sol;
       v = cVo * v;
 
       if(iter != 0)
@@ -951,7 +970,9 @@ vpMbEdgeTracker::computeVVSSecondPhasePoseEstimation(const unsigned int nerror,
     case vpMbTracker::GAUSS_NEWTON_OPT:
     default:
     {
-      v = -lambda*LVJTLVJ.pseudoInverse(LVJTLVJ.getRows()*std::numeric_limits<double>::epsilon())*LVJTR;
+      vpColVector sol;
+      LVJTLVJ.choleskySolve(LVJTR, sol);
+      v = -lambda*sol;
       v = cVo * v;
       break;
     }
@@ -987,39 +1008,51 @@ vpMbEdgeTracker::computeVVSSecondPhaseWeights(const unsigned int iter, const uns
     robust_lines.setThreshold(2/cam.get_px());
     robust_cylinders.setThreshold(2/cam.get_px());
     robust_circles.setThreshold(vpMath::sqr(2/cam.get_px()));
-    if(nberrors_lines > 0)
-              robust_lines.MEstimator(vpRobust::TUKEY, error_lines,w_lines);
-    if(nberrors_cylinders > 0)
-     robust_cylinders.MEstimator(vpRobust::TUKEY, error_cylinders,w_cylinders);
-    if(nberrors_circles > 0)
-      robust_circles.MEstimator(vpRobust::TUKEY, error_circles,w_circles);
   }
   else
   {
     robust_lines.setIteration(iter);
     robust_cylinders.setIteration(iter);
     robust_circles.setIteration(iter);
-    if(nberrors_lines > 0)
-              robust_lines.MEstimator(vpRobust::TUKEY, error_lines, w_lines);
-    if(nberrors_cylinders > 0)
-      robust_cylinders.MEstimator(vpRobust::TUKEY, error_cylinders,w_cylinders);
-    if(nberrors_circles > 0)
-      robust_circles.MEstimator(vpRobust::TUKEY, error_circles,w_circles);
   }
 
-  unsigned int cpt = 0;
-  while(cpt<nbrow){
-    if(cpt<nberrors_lines){
-      m_w[cpt] = w_lines[cpt];
+  // The three estimators own their state and work on disjoint residual
+  // slices, so they run concurrently; the merged weight vector is assembled
+  // afterward
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel sections
+  {
+#pragma omp section
+    {
+      if(nberrors_lines > 0)
+        robust_lines.MEstimator(vpRobust::TUKEY, error_lines, w_lines);
     }
-    else if (cpt<nberrors_lines+nberrors_cylinders){
-      m_w[cpt] = w_cylinders[cpt-nberrors_lines];
+#pragma omp section
+    {
+      if(nberrors_cylinders > 0)
+        robust_cylinders.MEstimator(vpRobust::TUKEY, error_cylinders, w_cylinders);
     }
-    else {
-      m_w[cpt] = w_circles[cpt-nberrors_lines-nberrors_cylinders];
+#pragma omp section
+    {
+      if(nberrors_circles > 0)
+        robust_circles.MEstimator(vpRobust::TUKEY, error_circles, w_circles);
     }
-    cpt++;
   }
+#else
+  if(nberrors_lines > 0)
+    robust_lines.MEstimator(vpRobust::TUKEY, error_lines, w_lines);
+  if(nberrors_cylinders > 0)
+    robust_cylinders.MEstimator(vpRobust::TUKEY, error_cylinders, w_cylinders);
+  if(nberrors_circles > 0)
+    robust_circles.MEstimator(vpRobust::TUKEY, error_circles, w_circles);
+#endif
+
+  for(unsigned int cpt = 0; cpt < nberrors_lines && cpt < nbrow; cpt++)
+    m_w[cpt] = w_lines[cpt];
+  for(unsigned int cpt = 0; cpt < nberrors_cylinders && nberrors_lines+cpt < nbrow; cpt++)
+    m_w[nberrors_lines+cpt] = w_cylinders[cpt];
+  for(unsigned int cpt = 0; cpt < nberrors_circles && nberrors_lines+nberrors_cylinders+cpt < nbrow; cpt++)
+    m_w[nberrors_lines+nberrors_cylinders+cpt] = w_circles[cpt];
 }
 
 /*!
@@ -1184,9 +1217,26 @@ vpMbEdgeTracker::testTracking()
  */
 void
 vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
-{ 
+{
+  double dataAgeMs = -1.;
+  if (I.getTimestamp() >= 0.) { // age of the frame handed by the grabber
+    dataAgeMs = vpTime::measureTimeMs() - I.getTimestamp();
+    m_dataLatency.record(dataAgeMs);
+  }
+
+  bool warm_started = false;
+  vpHomogeneousMatrix cMo_prev = cMo;
+  if (m_posePredictor != NULL && m_posePredictor->isReady()) {
+    // Start the frame from the predicted pose: the moving-edge sites are
+    // shifted towards the predicted projection of the model so that their
+    // search starts closer to the solution, and the VVS is seeded with
+    // the predicted pose
+    cMo = m_posePredictor->predict();
+    warm_started = true;
+  }
+
   initPyramid(I, Ipyramid);
-  
+
 //  for (int lvl = ((int)scales.size()-1); lvl >= 0; lvl -= 1)
   unsigned int lvl = (unsigned int)scales.size();
   do{
@@ -1200,8 +1250,15 @@ vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
       {
         downScale(lvl);
 
+        if (warm_started) {
+          // Move the moving-edge sites onto the model projected at the
+          // predicted pose before searching them in the new image
+          seedMovingEdge(cMo_prev);
+        }
+
         try
-        {  
+        {
+          VP_PROFILE_SCOPE("mbt.trackMovingEdge");
           trackMovingEdge(*Ipyramid[lvl]);
         }
         catch(...)
@@ -1238,11 +1295,13 @@ vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
 
         try
         {
+          VP_PROFILE_SCOPE("mbt.computeVVS");
           computeVVS(*Ipyramid[lvl], lvl);
         }
         catch(...)
         {
           covarianceMatrix = -1;
+          m_covarianceDirty = false;
           throw; // throw the original exception
         }
 
@@ -1262,7 +1321,10 @@ vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
 
         // Looking for new visible face
         bool newvisibleface = false ;
-        visibleFace(I, cMo, newvisibleface) ;
+        {
+          VP_PROFILE_SCOPE("mbt.visibleFace");
+          visibleFace(I, cMo, newvisibleface) ;
+        }
 
         //cam.computeFov(I.getWidth(), I.getHeight());
         if(useScanLine){
@@ -1270,8 +1332,13 @@ vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
           faces.computeScanLineRender(cam, I.getWidth(), I.getHeight());
         }
 
+        // Redistribute the site budget before the moving edges resample
+        if (m_siteBudget > 0)
+          updateSiteDensity();
+
         try
         {
+          VP_PROFILE_SCOPE("mbt.updateMovingEdge");
           updateMovingEdge(I);
         }
         catch(...)
@@ -1279,9 +1346,12 @@ vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
           throw; // throw the original exception
         }
 
-        initMovingEdge(I,cMo) ;
-        // Reinit the moving edge for the lines which need it.
-        reinitMovingEdge(I,cMo);
+        {
+          VP_PROFILE_SCOPE("mbt.initMovingEdge");
+          initMovingEdge(I,cMo) ;
+          // Reinit the moving edge for the lines which need it.
+          reinitMovingEdge(I,cMo);
+        }
 
         if(computeProjError)
           computeProjectionError(I);
@@ -1302,7 +1372,24 @@ vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
       }
     }
   } while(lvl != 0);
-  
+
+  if (m_posePredictor != NULL)
+    m_posePredictor->update(cMo);
+
+  if (m_telemetry != NULL) {
+    vpTrackerTelemetry::vpRecord record;
+    record.frame = m_telemetryFrame++;
+    record.nbFeatures = m_error.getRows();
+    record.nbIterations = m_vvsIterations;
+    record.residual = m_vvsResidual;
+    double sum_w = 0;
+    for (unsigned int i = 0; i < m_w.getRows(); i++)
+      sum_w += m_w[i];
+    record.meanWeight = (m_w.getRows() > 0) ? sum_w / m_w.getRows() : 1.;
+    record.dataAgeMs = dataAgeMs;
+    m_telemetry->publish(record);
+  }
+
   cleanPyramid(Ipyramid);
 }
 
@@ -1370,6 +1457,11 @@ vpMbEdgeTracker::setPose( const vpImage<unsigned char> &I, const vpHomogeneousMa
 {
   cMo = cdMo;
 
+  // The pose is imposed from outside: the velocity observed so far does
+  // not apply anymore
+  if (m_posePredictor != NULL)
+    m_posePredictor->reset();
+
   init(I);
 }
 
@@ -1510,6 +1602,9 @@ vpMbEdgeTracker::display(const vpImage<unsigned char>& I, const vpHomogeneousMat
                          const vpCameraParameters &camera, const vpColor& col,
                          const unsigned int thickness, const bool displayFullModel)
 {
+  //One backend submission for the whole model overlay
+  vpDisplay::beginOverlayBatch(I);
+  try {
   for (unsigned int i = 0; i < scales.size(); i += 1){
     if(scales[i]){
       for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
@@ -1527,6 +1622,12 @@ vpMbEdgeTracker::display(const vpImage<unsigned char>& I, const vpHomogeneousMat
       break ; //displaying model on one scale only
     }
   }
+  }
+  catch(...) {
+    vpDisplay::endOverlayBatch(I);
+    throw;
+  }
+  vpDisplay::endOverlayBatch(I);
 
 #ifdef VISP_HAVE_OGRE
   if(useOgre)
@@ -1549,6 +1650,9 @@ vpMbEdgeTracker::display(const vpImage<vpRGBa>& I, const vpHomogeneousMatrix &cM
                          const vpCameraParameters &camera, const vpColor& col,
                          const unsigned int thickness, const bool displayFullModel)
 {
+  //One backend submission for the whole model overlay
+  vpDisplay::beginOverlayBatch(I);
+  try {
   for (unsigned int i = 0; i < scales.size(); i += 1){
     if(scales[i]){
       for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
@@ -1565,6 +1669,12 @@ vpMbEdgeTracker::display(const vpImage<vpRGBa>& I, const vpHomogeneousMatrix &cM
       break ; //displaying model on one scale only
     }
   }
+  }
+  catch(...) {
+    vpDisplay::endOverlayBatch(I);
+    throw;
+  }
+  vpDisplay::endOverlayBatch(I);
 
 #ifdef VISP_HAVE_OGRE
   if(useOgre)
@@ -1726,41 +1836,158 @@ vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogen
 void
 vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
+  // The distance features only touch their own state while tracking
+  // their moving edges (failures are handled internally through their
+  // Reinit flag), so the faces are processed concurrently; the per-site
+  // parallelism of vpMeTracker stays inactive inside this region.
+  std::vector<vpMbtDistanceLine*> line_list;
+  line_list.reserve(lines[scaleLevel].size());
   for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
     vpMbtDistanceLine *l = *it;
-    if(l->isVisible() && l->isTracked()){
-      if(l->meline.size() == 0){
-        l->initMovingEdge(I, cMo);
-      }
-      l->trackMovingEdge(I, cMo) ;
+    if(l->isVisible() && l->isTracked())
+      line_list.push_back(l);
+  }
+
+  int nb_lines = (int)line_list.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < nb_lines; k++) {
+    vpMbtDistanceLine *l = line_list[(size_t)k];
+    if(l->meline.size() == 0){
+      l->initMovingEdge(I, cMo);
     }
+    l->trackMovingEdge(I, cMo) ;
   }
 
+  std::vector<vpMbtDistanceCylinder*> cylinder_list;
+  cylinder_list.reserve(cylinders[scaleLevel].size());
   for(std::list<vpMbtDistanceCylinder*>::const_iterator it=cylinders[scaleLevel].begin(); it!=cylinders[scaleLevel].end(); ++it){
     vpMbtDistanceCylinder *cy = *it;
-    if(cy->isVisible() && cy->isTracked()) {
-        if(cy->meline1 == NULL || cy->meline2 == NULL){
-          cy->initMovingEdge(I, cMo);
-        }
-        cy->trackMovingEdge(I, cMo) ;
+    if(cy->isVisible() && cy->isTracked())
+      cylinder_list.push_back(cy);
+  }
+
+  int nb_cylinders = (int)cylinder_list.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < nb_cylinders; k++) {
+    vpMbtDistanceCylinder *cy = cylinder_list[(size_t)k];
+    if(cy->meline1 == NULL || cy->meline2 == NULL){
+      cy->initMovingEdge(I, cMo);
     }
+    cy->trackMovingEdge(I, cMo) ;
   }
 
+  std::vector<vpMbtDistanceCircle*> circle_list;
+  circle_list.reserve(circles[scaleLevel].size());
   for(std::list<vpMbtDistanceCircle*>::const_iterator it=circles[scaleLevel].begin(); it!=circles[scaleLevel].end(); ++it){
     vpMbtDistanceCircle *ci = *it;
-    if(ci->isVisible() && ci->isTracked()){
-      if(ci->meEllipse == NULL){
-        ci->initMovingEdge(I, cMo);
-      }
-      ci->trackMovingEdge(I, cMo) ;
+    if(ci->isVisible() && ci->isTracked())
+      circle_list.push_back(ci);
+  }
+
+  int nb_circles = (int)circle_list.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < nb_circles; k++) {
+    vpMbtDistanceCircle *ci = circle_list[(size_t)k];
+    if(ci->meEllipse == NULL){
+      ci->initMovingEdge(I, cMo);
     }
+    ci->trackMovingEdge(I, cMo) ;
   }
 }
 
 
+/*!
+  Predicted image displacement of the 3D point \e P between the two given
+  poses. Returns false when the point does not lie in front of the camera
+  at both poses.
+*/
+static bool predictedDisplacement(vpPoint *P, const vpCameraParameters &cam,
+                                  const vpHomogeneousMatrix &cMo_prev,
+                                  const vpHomogeneousMatrix &cMo_pred,
+                                  double &di, double &dj)
+{
+  vpColVector cP(4), xy(3);
+  vpImagePoint ip_prev, ip_pred;
+
+  P->changeFrame(cMo_prev, cP);
+  if (cP[2] <= 0)
+    return false;
+  P->projection(cP, xy);
+  vpMeterPixelConversion::convertPoint(cam, xy[0], xy[1], ip_prev);
+
+  P->changeFrame(cMo_pred, cP);
+  if (cP[2] <= 0)
+    return false;
+  P->projection(cP, xy);
+  vpMeterPixelConversion::convertPoint(cam, xy[0], xy[1], ip_pred);
+
+  di = ip_pred.get_i() - ip_prev.get_i();
+  dj = ip_pred.get_j() - ip_prev.get_j();
+  return true;
+}
+
+/*!
+  Shift the moving-edge sites of every feature by the image displacement
+  that the predicted pose induces on its model points, so that the site
+  search of the next tracking starts from the predicted location of the
+  edges. The current pose cMo must already hold the prediction.
+
+  \param cMo_prev : Pose estimated on the previous frame.
+*/
+void
+vpMbEdgeTracker::seedMovingEdge(const vpHomogeneousMatrix &cMo_prev)
+{
+  double di1, dj1, di2, dj2;
+
+  vpMbtDistanceLine *l ;
+  for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
+    l = *it;
+    if (l->isTracked() && l->isVisible()){
+      if (predictedDisplacement(l->p1, cam, cMo_prev, cMo, di1, dj1) &&
+          predictedDisplacement(l->p2, cam, cMo_prev, cMo, di2, dj2)){
+        for(unsigned int a = 0 ; a < l->meline.size() ; a++){
+          if (l->meline[a] != NULL)
+            l->meline[a]->seedDisplacement(0.5*(di1+di2), 0.5*(dj1+dj2));
+        }
+      }
+    }
+  }
+
+  vpMbtDistanceCylinder *cy ;
+  for(std::list<vpMbtDistanceCylinder*>::const_iterator it=cylinders[scaleLevel].begin(); it!=cylinders[scaleLevel].end(); ++it){
+    cy = *it;
+    if (cy->isTracked() && cy->isVisible()){
+      if (predictedDisplacement(cy->p1, cam, cMo_prev, cMo, di1, dj1) &&
+          predictedDisplacement(cy->p2, cam, cMo_prev, cMo, di2, dj2)){
+        if (cy->meline1 != NULL)
+          cy->meline1->seedDisplacement(0.5*(di1+di2), 0.5*(dj1+dj2));
+        if (cy->meline2 != NULL)
+          cy->meline2->seedDisplacement(0.5*(di1+di2), 0.5*(dj1+dj2));
+      }
+    }
+  }
+
+  vpMbtDistanceCircle *ci ;
+  for(std::list<vpMbtDistanceCircle*>::const_iterator it=circles[scaleLevel].begin(); it!=circles[scaleLevel].end(); ++it){
+    ci = *it;
+    if (ci->isTracked() && ci->isVisible()){
+      if (predictedDisplacement(ci->p1, cam, cMo_prev, cMo, di1, dj1)){
+        if (ci->meEllipse != NULL)
+          ci->meEllipse->seedDisplacement(di1, dj1);
+      }
+    }
+  }
+}
+
 /*!
   Update the moving edges at the end of the virtual visual servoing.
-  
+
   \param I : the image.
 */
 void
@@ -1800,6 +2027,71 @@ vpMbEdgeTracker::updateMovingEdge(const vpImage<unsigned char> &I)
   }
 }
 
+/*!
+  Set the global moving-edge site budget: every frame the sampling density of
+  the visible lines is adjusted so that the total number of their moving-edge
+  sites stays close to the budget, with the uncertain lines (low robust mean
+  weight) receiving a denser sampling than the stable ones. A fixed budget
+  makes the per frame tracking cost deterministic, which matters for real
+  time scheduling.
+
+  \param budget : Target total number of line moving-edge sites per frame.
+  0 (the default) disables the controller and restores the uniform sampling
+  step of the shared moving-edge parameters.
+*/
+void
+vpMbEdgeTracker::setGlobalSiteBudget(const unsigned int &budget)
+{
+  m_siteBudget = budget;
+
+  if (budget == 0) {
+    for (unsigned int i = 0; i < scales.size(); i += 1){
+      if(scales[i]){
+        for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[i].begin(); it!=lines[i].end(); ++it)
+          (*it)->setSampleDensityFactor(1.0);
+      }
+    }
+  }
+}
+
+/*!
+  Redistribute the global site budget across the lines of the current scale
+  level: each line receives a sampling density factor proportional to its
+  uncertainty score (derived from the robust mean weight of its sites) and
+  scaled so that the expected total number of sites matches the budget. The
+  factors take effect when the moving edges resample their sites.
+*/
+void
+vpMbEdgeTracker::updateSiteDensity()
+{
+  // Expected number of sites of each line at unit density, estimated from
+  // the current site count and the current density factor
+  double weighted_sites = 0;
+  for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
+    vpMbtDistanceLine *l = *it;
+    if(l->isVisible() && l->isTracked() && l->nbFeatureTotal > 0){
+      double n0 = (double)l->nbFeatureTotal / l->getSampleDensityFactor();
+      double score = 0.5 + (1.0 - l->getMeanWeight());
+      weighted_sites += n0 * score;
+    }
+  }
+
+  if (weighted_sites <= std::numeric_limits<double>::epsilon())
+    return;
+
+  for(std::list<vpMbtDistanceLine*>::const_iterator it=lines[scaleLevel].begin(); it!=lines[scaleLevel].end(); ++it){
+    vpMbtDistanceLine *l = *it;
+    if(l->isVisible() && l->isTracked() && l->nbFeatureTotal > 0){
+      double score = 0.5 + (1.0 - l->getMeanWeight());
+      double factor = (double)m_siteBudget * score / weighted_sites;
+      // Bounded so that a line can neither starve nor flood the budget
+      if (factor < 0.25) factor = 0.25;
+      else if (factor > 4.0) factor = 4.0;
+      l->setSampleDensityFactor(factor);
+    }
+  }
+}
+
 void
 vpMbEdgeTracker::updateMovingEdgeWeights() {
   unsigned int n = 0;
@@ -2802,35 +3094,20 @@ void
 vpMbEdgeTracker::initPyramid(const vpImage<unsigned char>& _I, std::vector< const vpImage<unsigned char>* >& _pyramid)
 {
   _pyramid.resize(scales.size());
-  
-  if(scales[0]){
-    _pyramid[0] = &_I;
-  }
-  else{
-    _pyramid[0] = NULL;
-  }
-  
-  for(unsigned int i=1; i<_pyramid.size(); i += 1){
+
+  // The level buffers come from a pooled vpImagePyramid whose storage is
+  // reused between the frames: rebuilding the pyramid of a video stream
+  // allocates nothing after the first frame. The pool holds one pyramid
+  // per concurrently alive pyramid (one per camera in the multi camera
+  // tracker).
+  if (m_pyramidPoolNext >= m_pyramidPool.size())
+    m_pyramidPool.push_back(new vpImagePyramid());
+  vpImagePyramid *pyramid = m_pyramidPool[m_pyramidPoolNext++];
+  pyramid->build(_I, (unsigned int)scales.size());
+
+  for(unsigned int i=0; i<_pyramid.size(); i += 1){
     if(scales[i]){
-      unsigned int cScale = static_cast<unsigned int>(pow(2., (int)i));
-      vpImage<unsigned char>* I = new vpImage<unsigned char>(_I.getHeight() / cScale, _I.getWidth() / cScale);
-#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
-      IplImage* vpI0 = cvCreateImageHeader(cvSize((int)_I.getWidth(), (int)_I.getHeight()), IPL_DEPTH_8U, 1);
-      vpI0->imageData = (char*)(_I.bitmap);
-      IplImage* vpI = cvCreateImage(cvSize((int)(_I.getWidth() / cScale), (int)(_I.getHeight() / cScale)), IPL_DEPTH_8U, 1);
-      cvResize(vpI0, vpI, CV_INTER_NN);
-      vpImageConvert::convert(vpI, *I);
-      cvReleaseImage(&vpI);  
-      vpI0->imageData = NULL;
-      cvReleaseImageHeader(&vpI0);    
-#else
-      for (unsigned int k = 0, ii = 0; k < I->getHeight(); k += 1, ii += cScale){
-        for (unsigned int l = 0, jj = 0; l < I->getWidth(); l += 1, jj += cScale){
-          (*I)[k][l] = _I[ii][jj];
-        }
-      }
-#endif   
-      _pyramid[i] = I;
+      _pyramid[i] = &pyramid->getLevel(i);
     }
     else{
       _pyramid[i] = NULL;
@@ -2848,14 +3125,14 @@ void
 vpMbEdgeTracker::cleanPyramid(std::vector< const vpImage<unsigned char>* >& _pyramid)
 {
   if(_pyramid.size() > 0){
-    _pyramid[0] = NULL;
-    for (unsigned int i = 1; i < _pyramid.size(); i += 1){
-      if(_pyramid[i] != NULL){
-        delete _pyramid[i];
-        _pyramid[i] = NULL;
-      }
+    // The level images belong to the pooled pyramids: releasing a
+    // pyramid only clears the pointers and hands its pool entry back
+    for (unsigned int i = 0; i < _pyramid.size(); i += 1){
+      _pyramid[i] = NULL;
     }
     _pyramid.resize(0);
+    if (m_pyramidPoolNext > 0)
+      m_pyramidPoolNext--;
   }
 }
 
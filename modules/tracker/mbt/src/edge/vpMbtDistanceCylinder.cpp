@@ -62,7 +62,8 @@
 */
 vpMbtDistanceCylinder::vpMbtDistanceCylinder()
   : name(), index(0), cam(), me(NULL), wmean1(1), wmean2(1),
-    featureline1(), featureline2(), isTrackedCylinder(true), meline1(NULL), meline2(NULL),
+    featureline1(), featureline2(), isTrackedCylinder(true),
+    m_cMoProjected(), m_projectionValid(false), m_projectionOk(false), meline1(NULL), meline2(NULL),
     cercle1(NULL), cercle2(NULL), radius(0), p1(NULL), p2(NULL), L(),
     error(), nbFeature(0), nbFeaturel1(0), nbFeaturel2(0), Reinit(false),
     c(NULL), hiddenface(NULL), index_polygon(-1), isvisible(false)
@@ -98,6 +99,60 @@ vpMbtDistanceCylinder::project(const vpHomogeneousMatrix &cMo)
   p2->project(cMo) ;
   cercle1->project(cMo) ;
   cercle2->project(cMo) ;
+  m_projectionValid = false;
+}
+
+/*!
+  Project the whole geometry of the cylinder (axis extremities, limiting
+  circles, limbo lines) for the given pose, once : the projection is
+  cached and the frame processing steps (moving edge update, init,
+  display) that share the frame pose reuse it instead of reprojecting.
+
+  \param cMo : The pose of the camera used to project the cylinder into the image.
+  \return false if the projection of one of the limiting circles failed,
+  true otherwise.
+*/
+bool
+vpMbtDistanceCylinder::projectFeatures(const vpHomogeneousMatrix &cMo)
+{
+  if (m_projectionValid) {
+    bool samePose = true;
+    for (unsigned int i = 0; i < 3 && samePose; i++)
+      for (unsigned int j = 0; j < 4 && samePose; j++)
+        if (m_cMoProjected[i][j] != cMo[i][j])
+          samePose = false;
+    if (samePose)
+      return m_projectionOk;
+  }
+
+  p1->changeFrame(cMo);
+  p2->changeFrame(cMo);
+  cercle1->changeFrame(cMo);
+  cercle2->changeFrame(cMo);
+  c->changeFrame(cMo);
+
+  m_projectionOk = true;
+  p1->projection();
+  p2->projection();
+  try{
+    cercle1->projection();
+  }
+  catch(...){
+    //std::cout<<"Problem when projecting circle 1\n";
+    m_projectionOk = false;
+  }
+  try{
+    cercle2->projection();
+  }
+  catch(...){
+    //std::cout<<"Problem when projecting circle 2\n";
+    m_projectionOk = false;
+  }
+  c->projection();
+
+  m_cMoProjected = cMo;
+  m_projectionValid = true;
+  return m_projectionOk;
 }
 
 
@@ -144,6 +199,9 @@ vpMbtDistanceCylinder::buildFrom(const vpPoint &_p1, const vpPoint &_p2, const d
 
   // Build our cylinder
   c->setWorldCoordinates(ABC[0],ABC[1],ABC[2],(_p1.get_oX()+_p2.get_oX())/2.0,(_p1.get_oY()+_p2.get_oY())/2.0,(_p1.get_oZ()+_p2.get_oZ())/2.0,r);
+
+  // The cached projection refers to the previous geometry
+  m_projectionValid = false;
 }
 
 
@@ -178,30 +236,9 @@ bool
 vpMbtDistanceCylinder::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
   if(isvisible){
-    // Perspective projection
-    p1->changeFrame(cMo);
-    p2->changeFrame(cMo);
-    cercle1->changeFrame(cMo);
-    cercle2->changeFrame(cMo);
-    c->changeFrame(cMo);
-
-    p1->projection();
-    p2->projection();
-    try{
-      cercle1->projection();
-    }
-    catch(...){
-      //std::cout<<"Problem when projecting circle 1\n";
+    // Perspective projection, cached across the processing of the frame
+    if (!projectFeatures(cMo))
       return false;
-    }
-    try{
-      cercle2->projection();
-    }
-    catch(...){
-      //std::cout<<"Problem when projecting circle 2\n";
-      return false;
-    }
-    c->projection();
 
     double rho1,theta1;
     double rho2,theta2;
@@ -328,24 +365,8 @@ void
 vpMbtDistanceCylinder::updateMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
   if(isvisible){
-    // Perspective projection
-    p1->changeFrame(cMo);
-    p2->changeFrame(cMo);
-    cercle1->changeFrame(cMo);
-    cercle2->changeFrame(cMo);
-    c->changeFrame(cMo);
-
-    p1->projection();
-    p2->projection();
-    try{
-      cercle1->projection();
-    }
-    catch(...){std::cout<<"Probleme projection cercle 1\n";}
-    try{
-      cercle2->projection();
-    }
-    catch(...){std::cout<<"Probleme projection cercle 2\n";}
-    c->projection();
+    // Perspective projection, cached across the processing of the frame
+    projectFeatures(cMo);
 
     // Get the limbos
     double rho1,theta1;
@@ -461,24 +482,8 @@ vpMbtDistanceCylinder::display(const vpImage<unsigned char>&I, const vpHomogeneo
                                const bool displayFullModel)
 {
   if( (isvisible && isTrackedCylinder) || displayFullModel){
-    // Perspective projection
-    p1->changeFrame(cMo);
-    p2->changeFrame(cMo);
-    cercle1->changeFrame(cMo);
-    cercle2->changeFrame(cMo);
-    c->changeFrame(cMo);
-
-    p1->projection();
-    p2->projection();
-    try{
-      cercle1->projection();
-    }
-    catch(...){std::cout<<"Problem projection circle 1";}
-    try{
-      cercle2->projection();
-    }
-    catch(...){std::cout<<"Problem projection circle 2";}
-    c->projection();
+    // Perspective projection, cached across the processing of the frame
+    projectFeatures(cMo);
 
     double rho1,theta1;
     double rho2,theta2;
@@ -525,24 +530,8 @@ vpMbtDistanceCylinder::display(const vpImage<vpRGBa> &I, const vpHomogeneousMatr
                                const bool displayFullModel)
 {
   if( (isvisible && isTrackedCylinder) || displayFullModel){
-    // Perspective projection
-    p1->changeFrame(cMo);
-    p2->changeFrame(cMo);
-    cercle1->changeFrame(cMo);
-    cercle2->changeFrame(cMo);
-    c->changeFrame(cMo);
-
-    p1->projection();
-    p2->projection();
-    try{
-      cercle1->projection();
-    }
-    catch(...){std::cout<<"Problem projection circle 1";}
-    try{
-      cercle2->projection();
-    }
-    catch(...){std::cout<<"Problem projection circle 2";}
-    c->projection();
+    // Perspective projection, cached across the processing of the frame
+    projectFeatures(cMo);
 
     double rho1,theta1;
     double rho2,theta2;
@@ -624,19 +613,13 @@ void
 vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo, const vpImage<unsigned char> &I)
 {
   if (isvisible) {
-    // Perspective projection
+    // Perspective projection of the limbo lines only : the limiting
+    // circles do not enter the interaction matrix, projecting them at
+    // every iteration of the minimization was wasted work. The pose
+    // changes at each iteration, so the per-frame cache is stale now.
     c->changeFrame(cMo) ;
     c->projection() ;
-    cercle1->changeFrame(cMo) ;
-    cercle1->changeFrame(cMo) ;
-    try{
-      cercle1->projection();
-    }
-    catch(...){std::cout<<"Problem projection circle 1\n";}
-    try{
-      cercle2->projection();
-    }
-    catch(...){std::cout<<"Problem projection circle 2\n";}
+    m_projectionValid = false;
 
     bool disp = false;
     bool disp2 = false;
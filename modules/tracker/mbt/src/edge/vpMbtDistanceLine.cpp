@@ -49,6 +49,11 @@
 #include <visp3/visual_features/vpFeatureBuilder.h>
 #include <stdlib.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
 void buildPlane(vpPoint &P, vpPoint &Q, vpPoint &R, vpPlane &plane);
 void buildLine(vpPoint &P1, vpPoint &P2, vpPoint &P3, vpPoint &P4, vpLine &L);
 
@@ -56,11 +61,14 @@ void buildLine(vpPoint &P1, vpPoint &P2, vpPoint &P3, vpPoint &P4, vpLine &L);
   Basic constructor
 */
 vpMbtDistanceLine::vpMbtDistanceLine()
-  : name(), index(0), cam(), me(NULL), isTrackedLine(true), isTrackedLineWithVisibility(true),
-    wmean(1), featureline(), poly(), useScanLine(false), meline(), line(NULL), p1(NULL), p2(NULL), L(),
+  : name(), index(0), cam(), me(NULL), m_meAdaptive(), m_sampleDensityFactor(1.),
+    isTrackedLine(true), isTrackedLineWithVisibility(true),
+    wmean(1), featureline(), poly(), useScanLine(false), meline(), m_melinePool(), line(NULL), p1(NULL), p2(NULL), L(),
     error(), nbFeature(), nbFeatureTotal(0), Reinit(false), hiddenface(NULL), Lindex_polygon(),
     Lindex_polygon_tracked(), isvisible(false)
 {
+  m_siteCacheValid = false;
+
 }
 
 /*!
@@ -75,6 +83,36 @@ vpMbtDistanceLine::~vpMbtDistanceLine()
     if (meline[i] != NULL) delete meline[i] ;
 
   meline.clear();
+
+  for(unsigned int i = 0 ; i < m_melinePool.size() ; i++){
+    if (m_melinePool[i] != NULL) delete m_melinePool[i] ;
+  }
+}
+
+/*!
+  Get a moving-edge line to initialize : reuse a retired one when the
+  pool has any, so visibility transitions stop reallocating.
+*/
+vpMbtMeLine *vpMbtDistanceLine::acquireMeLine()
+{
+  if (!m_melinePool.empty()) {
+    vpMbtMeLine *meLine = m_melinePool.back();
+    m_melinePool.pop_back();
+    return meLine;
+  }
+  return new vpMbtMeLine;
+}
+
+/*!
+  Retire every current moving-edge line into the pool instead of
+  destroying it.
+*/
+void vpMbtDistanceLine::releaseMeLines()
+{
+  for(unsigned int i = 0 ; i < meline.size() ; i++){
+    if (meline[i] != NULL) m_melinePool.push_back(meline[i]);
+  }
+  meline.clear();
 }
 
 /*!
@@ -293,17 +331,65 @@ vpMbtDistanceLine::setMovingEdge(vpMe *_me)
 {
   me = _me ;
 
+  if (me != NULL && std::fabs(m_sampleDensityFactor - 1.0) > std::numeric_limits<double>::epsilon()) {
+    m_meAdaptive = *me;
+    m_meAdaptive.setSampleStep(me->getSampleStep() / m_sampleDensityFactor);
+  }
+
   for(unsigned int i = 0 ; i < meline.size() ; i++)
     if (meline[i] != NULL)
     {
 //      nbFeature[i] = 0;
       meline[i]->reset();
-      meline[i]->setMe(me) ;
+      meline[i]->setMe(activeMe()) ;
     }
 
 //  nbFeatureTotal = 0;
 }
 
+/*!
+  Moving edge parameters the moving edges of the line must use: the shared
+  ones, or the per line copy when the sampling density factor is not 1.
+*/
+vpMe *
+vpMbtDistanceLine::activeMe()
+{
+  if (me != NULL && std::fabs(m_sampleDensityFactor - 1.0) > std::numeric_limits<double>::epsilon())
+    return &m_meAdaptive;
+  return me;
+}
+
+/*!
+  Set the sampling density factor of the line: its moving edges sample their
+  sites with a step of getMe()->getSampleStep()/factor, so a factor above 1
+  densifies the line while a factor below 1 relaxes it. Used by the global
+  site budget controller of vpMbEdgeTracker; takes effect when the moving
+  edges of the line (re)sample their sites.
+
+  \param factor : The sampling density factor (1 restores the shared step).
+*/
+void
+vpMbtDistanceLine::setSampleDensityFactor(const double &factor)
+{
+  // A density change only takes effect when the sites are resampled: ask
+  // for a reinitialization of the line when the step changes materially
+  if (isvisible && std::fabs(factor - m_sampleDensityFactor) > 0.2 * m_sampleDensityFactor)
+    Reinit = true;
+
+  m_sampleDensityFactor = factor;
+  if (me == NULL)
+    return;
+
+  if (std::fabs(factor - 1.0) > std::numeric_limits<double>::epsilon()) {
+    m_meAdaptive = *me;
+    m_meAdaptive.setSampleStep(me->getSampleStep() / factor);
+  }
+
+  for(unsigned int i = 0 ; i < meline.size() ; i++)
+    if (meline[i] != NULL)
+      meline[i]->setMe(activeMe()) ;
+}
+
 
 /*!
   Initialize the moving edge thanks to a given pose of the camera.                          
@@ -316,11 +402,9 @@ vpMbtDistanceLine::setMovingEdge(vpMe *_me)
 bool
 vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
-  for(unsigned int i = 0 ; i < meline.size() ; i++){
-    if (meline[i] != NULL) delete meline[i] ;
-  }
+  m_siteCacheValid = false;
 
-  meline.clear();
+  releaseMeLines();
   nbFeature.clear();
   nbFeatureTotal = 0;
 
@@ -381,8 +465,8 @@ vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomog
         vpMeterPixelConversion::convertPoint(cam,linesLst[i].first.get_x(),linesLst[i].first.get_y(),ip1);
         vpMeterPixelConversion::convertPoint(cam,linesLst[i].second.get_x(),linesLst[i].second.get_y(),ip2);
 
-        vpMbtMeLine *melinePt = new vpMbtMeLine ;
-        melinePt->setMe(me) ;
+        vpMbtMeLine *melinePt = acquireMeLine() ;
+        melinePt->setMe(activeMe()) ;
 
         //    meline[i]->setDisplay(vpMeSite::RANGE_RESULT) ;
         melinePt->setInitRange(0);
@@ -401,7 +485,7 @@ vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomog
         catch(...)
         {
           //vpTRACE("the line can't be initialized");
-          if (melinePt!=NULL) delete melinePt;
+          if (melinePt!=NULL) m_melinePool.push_back(melinePt);
           melinePt=NULL;
           isvisible = false;
           return false;
@@ -429,6 +513,8 @@ vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vpHomog
 void
 vpMbtDistanceLine::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix & /*cMo*/)
 {
+  m_siteCacheValid = false;
+
 
   if (isvisible)
   {
@@ -460,12 +546,9 @@ vpMbtDistanceLine::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomo
     }
     catch(...)
     {
-      for(unsigned int i = 0 ; i < meline.size() ; i++){
-        if (meline[i] != NULL) delete meline[i] ;
-      }
+      releaseMeLines();
 
       nbFeature.clear();
-      meline.clear();
       nbFeatureTotal = 0;
       Reinit = true;
       isvisible = false;
@@ -483,6 +566,8 @@ vpMbtDistanceLine::trackMovingEdge(const vpImage<unsigned char> &I, const vpHomo
 void
 vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
+  m_siteCacheValid = false;
+
   if(isvisible){
     p1->changeFrame(cMo);
     p2->changeFrame(cMo);
@@ -504,11 +589,7 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
       }
 
       if(linesLst.size() != meline.size() || linesLst.size() == 0){
-        for(unsigned int i = 0 ; i < meline.size() ; i++){
-          if (meline[i] != NULL) delete meline[i] ;
-        }
-
-        meline.clear();
+        releaseMeLines();
         nbFeature.clear();
         nbFeatureTotal = 0;
         isvisible = false;
@@ -560,11 +641,7 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
         }
         catch(...)
         {
-          for(unsigned int j = 0 ; j < meline.size() ; j++){
-            if (meline[j] != NULL) delete meline[j] ;
-          }
-
-          meline.clear();
+          releaseMeLines();
           nbFeature.clear();
           nbFeatureTotal = 0;
           isvisible = false;
@@ -573,11 +650,8 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
       }
     }
     else{
-      for(unsigned int i = 0 ; i < meline.size() ; i++){
-        if (meline[i] != NULL) delete meline[i] ;
-      }
+      releaseMeLines();
       nbFeature.clear();
-      meline.clear();
       nbFeatureTotal = 0;
       isvisible = false;
     }
@@ -596,12 +670,10 @@ vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const vpHom
 void
 vpMbtDistanceLine::reinitMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo)
 {
-  for(unsigned int i = 0 ; i < meline.size() ; i++){
-    if (meline[i] != NULL) delete meline[i] ;
-  }
+  m_siteCacheValid = false;
 
+  releaseMeLines();
   nbFeature.clear();
-  meline.clear();
   nbFeatureTotal = 0;
 
   if (initMovingEdge(I,cMo) == false)
@@ -765,6 +837,25 @@ vpMbtDistanceLine::initInteractionMatrixError()
 */
 void
 vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo)
+{
+  computeInteractionMatrixError(cMo, L, error, 0);
+}
+
+/*!
+  Compute the interaction matrix and the error vector corresponding to the
+  line, writing the rows directly into a pre-allocated stacked interaction
+  matrix and error vector starting at the given row. Lets the tracker assemble
+  the global system without an intermediate per-line copy.
+
+  \param cMo : Pose used to project the line in the image.
+  \param L_stack : Stacked interaction matrix receiving the rows. Must have at
+  least offset + nbFeatureTotal rows and 6 columns.
+  \param e_stack : Stacked error vector receiving the residuals.
+  \param offset : First row written in \e L_stack and \e e_stack.
+*/
+void
+vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo, vpMatrix &L_stack,
+                                                 vpColVector &e_stack, const unsigned int &offset)
 {
   if (isvisible)
   {
@@ -785,36 +876,89 @@ vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix &cMo)
     double xc = cam.get_u0() ;
     double yc = cam.get_v0() ;
 
-    double alpha_ ;
     vpMatrix H ;
     H = featureline.interaction() ;
 
-    double x,y ;
-    vpMeSite p ;
-    unsigned int j =0 ;
-
-    for(unsigned int i = 0 ; i < meline.size() ; i++){
-      for(std::list<vpMeSite>::const_iterator it=meline[i]->getMeList().begin(); it!=meline[i]->getMeList().end(); ++it){
-        x = (double)it->j ;
-        y = (double)it->i ;
-
-        x = (x-xc)*mx ;
-        y = (y-yc)*my ;
-
-        alpha_ = x*si - y*co;
+    // The site pixel coordinates are constant across the VVS iterations:
+    // their normalized values are cached when the moving edges change and
+    // the row assembly below streams through the dense cache instead of
+    // walking the site lists at every iteration
+    if (!m_siteCacheValid) {
+      refreshSiteCache();
+    }
 
-        double *Lrho = H[0] ;
-        double *Ltheta = H[1] ;
-        // Calculate interaction matrix for a distance
-        for (unsigned int k=0 ; k < 6 ; k++)
-        {
-          L[j][k] = (Lrho[k] + alpha_*Ltheta[k]);
+    const double *Lrho = H[0] ;
+    const double *Ltheta = H[1] ;
+    size_t nb_sites = m_sitePixX.size() ;
+    const double *pixX = nb_sites ? &m_sitePixX[0] : NULL;
+    const double *pixY = nb_sites ? &m_sitePixY[0] : NULL;
+    size_t j = 0;
+
+#if VISP_HAVE_SSE2
+    // Two sites per iteration: x, y, alpha and the residual are computed on
+    // packed doubles, then each of the six Jacobian columns is expanded into
+    // the two destination rows
+    if (nb_sites >= 2) {
+      const __m128d vmx = _mm_set1_pd(mx);
+      const __m128d vmy = _mm_set1_pd(my);
+      const __m128d vxc = _mm_set1_pd(xc);
+      const __m128d vyc = _mm_set1_pd(yc);
+      const __m128d vco = _mm_set1_pd(co);
+      const __m128d vsi = _mm_set1_pd(si);
+      const __m128d vrho = _mm_set1_pd(rho);
+
+      for (; j+1 < nb_sites ; j += 2) {
+        __m128d x = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(pixX+j), vxc), vmx);
+        __m128d y = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(pixY+j), vyc), vmy);
+        __m128d alpha_ = _mm_sub_pd(_mm_mul_pd(x, vsi), _mm_mul_pd(y, vco));
+        __m128d err = _mm_sub_pd(vrho, _mm_add_pd(_mm_mul_pd(x, vco), _mm_mul_pd(y, vsi)));
+
+        double *row0 = L_stack[offset + (unsigned int)j];
+        double *row1 = L_stack[offset + (unsigned int)j + 1];
+        for (unsigned int k=0 ; k < 6 ; k++) {
+          __m128d lk = _mm_add_pd(_mm_set1_pd(Lrho[k]), _mm_mul_pd(alpha_, _mm_set1_pd(Ltheta[k])));
+          _mm_storel_pd(row0 + k, lk);
+          _mm_storeh_pd(row1 + k, lk);
         }
-        error[j] = rho - ( x*co + y*si) ;
-        j++;
+        _mm_storel_pd(&e_stack[offset + (unsigned int)j], err);
+        _mm_storeh_pd(&e_stack[offset + (unsigned int)j + 1], err);
+      }
+    }
+#endif
+    for (; j < nb_sites ; j++) {
+      double x = (pixX[j]-xc)*mx ;
+      double y = (pixY[j]-yc)*my ;
+
+      double alpha_ = x*si - y*co;
+
+      // Calculate interaction matrix for a distance
+      double *row = L_stack[offset + (unsigned int)j];
+      for (unsigned int k=0 ; k < 6 ; k++)
+      {
+        row[k] = (Lrho[k] + alpha_*Ltheta[k]);
       }
+      e_stack[offset + (unsigned int)j] = rho - ( x*co + y*si) ;
+    }
+  }
+}
+
+/*!
+  Refresh the dense cache of the site pixel coordinates used by
+  computeInteractionMatrixError(). The cache stays valid until the
+  moving edges are initialized, tracked, updated or re-initialized.
+*/
+void
+vpMbtDistanceLine::refreshSiteCache()
+{
+  m_sitePixX.clear();
+  m_sitePixY.clear();
+  for(unsigned int i = 0 ; i < meline.size() ; i++){
+    for(std::list<vpMeSite>::const_iterator it=meline[i]->getMeList().begin(); it!=meline[i]->getMeList().end(); ++it){
+      m_sitePixX.push_back((double)it->j);
+      m_sitePixY.push_back((double)it->i);
     }
   }
+  m_siteCacheValid = true;
 }
 
 /*!
@@ -172,14 +172,49 @@ vpMbtMeLine::sample(const vpImage<unsigned char>& I)
   // sample positions at i*me->getSampleStep() interval along the
   // line_p, starting at PSiteExt[0]
 
+  // Analytic clipping of the sampled range against the image rectangle :
+  // samples outside cannot pass the in-image test below, so the loop only
+  // walks the visible parametric interval, padded by one sample for the
+  // rounding of that test. Lines mostly out of the view stop costing one
+  // rejection per sample.
+  int nTotal = vpMath::round(n_sample);
+  int iFirst = 0, iLast = nTotal;
+  {
+    double tmin = 0., tmax = (double)nTotal;
+    bool empty = false;
+    for (int axis = 0; axis < 2 && !empty; axis++) {
+      double d = axis == 0 ? stepi : stepj;
+      double o = axis == 0 ? is : js;
+      double hi = axis == 0 ? (double)rows - 1 : (double)cols - 1;
+      if (std::fabs(d) <= std::numeric_limits<double>::epsilon()) {
+        if (o < 0. || o > hi) empty = true;
+      }
+      else {
+        double t1 = (0. - o) / d;
+        double t2 = (hi - o) / d;
+        if (t1 > t2) { double tmp = t1; t1 = t2; t2 = tmp; }
+        if (t1 > tmin) tmin = t1;
+        if (t2 < tmax) tmax = t2;
+        if (tmin > tmax) empty = true;
+      }
+    }
+    if (empty) { iFirst = 1; iLast = 0; }
+    else {
+      iFirst = (int)floor(tmin) - 1; if (iFirst < 0) iFirst = 0;
+      iLast = (int)ceil(tmax) + 1; if (iLast > nTotal) iLast = nTotal;
+    }
+  }
+
   vpImagePoint ip;
-  for(int i=0; i<=vpMath::round(n_sample); i++)
+  for(int i=iFirst; i<=iLast; i++)
   {
+    double is_ = PExt[1].ifloat + i*stepi;
+    double js_ = PExt[1].jfloat + i*stepj;
     // If point is in the image, add to the sample list
-    if(!outOfImage(vpMath::round(is), vpMath::round(js), (int)(me->getRange()+me->getMaskSize()+1), (int)rows, (int)cols))
+    if(!outOfImage(vpMath::round(is_), vpMath::round(js_), (int)(me->getRange()+me->getMaskSize()+1), (int)rows, (int)cols))
     {
       vpMeSite pix ; //= list.value();
-      pix.init((int)is, (int)js, delta, 0, sign) ;
+      pix.init((int)is_, (int)js_, delta, 0, sign) ;
   
       pix.track(I, me, false);
       
@@ -187,16 +222,13 @@ vpMbtMeLine::sample(const vpImage<unsigned char>& I)
 
       if(vpDEBUG_ENABLE(3))
       {
-	      ip.set_i( is );
-	      ip.set_j( js );
+	      ip.set_i( is_ );
+	      ip.set_j( js_ );
 	      vpDisplay::displayCross(I, ip, 2, vpColor::blue);
       }
 
       list.push_back(pix);
     }
-    is += stepi;
-    js += stepj;
-
   }
 
   vpCDEBUG(1) << "end vpMeLine::sample() : ";
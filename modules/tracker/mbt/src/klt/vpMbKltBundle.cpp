@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bundled artifact of a learned detector and its klt model tracker.
+ *
+ *****************************************************************************/
+
+#include <visp3/mbt/vpMbKltBundle.h>
+
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+
+#include <visp3/core/vpIoTools.h>
+
+/*!
+  Package the learned detector and the tracker configuration as one
+  bundle file : the model geometry file, the learning data of \e
+  keypoint (reference keypoints, descriptors, training images), the
+  persisted matcher index when vpKeyPoint produced one, and the camera
+  parameters of \e tracker.
+
+  \param filename : Path of the bundle file, overwritten.
+  \param keypoint : Learned detector, its buildReference() already done.
+  \param tracker : Configured tracker whose camera parameters are
+  embedded.
+  \param modelFile : Model geometry file (.cao or .wrl) to embed.
+
+  \exception vpException::ioError : If a file cannot be read or written.
+*/
+void vpMbKltBundle::save(const std::string &filename, vpKeyPoint &keypoint,
+                         const vpMbKltTracker &tracker, const std::string &modelFile)
+{
+  //The learning data writer only targets paths : write a sidecar and
+  //embed its bytes
+  std::string learnFile = filename + ".learning.tmp";
+  keypoint.saveLearningData(learnFile, true, true);
+
+  vpArtifactBundle bundle;
+  bundle.create(filename);
+
+  vpCameraParameters cam;
+  tracker.getCameraParameters(cam);
+  double camData[7];
+  camData[0] = (double)cam.get_projModel();
+  camData[1] = cam.get_px();
+  camData[2] = cam.get_py();
+  camData[3] = cam.get_u0();
+  camData[4] = cam.get_v0();
+  camData[5] = cam.get_kud();
+  camData[6] = cam.get_kdu();
+  bundle.addSection("camera", (const char *)camData, sizeof(camData));
+
+  //The model parser selects its reader from the extension : keep it
+  size_t dot = modelFile.rfind('.');
+  std::string ext = (dot == std::string::npos) ? ".cao" : modelFile.substr(dot);
+  bundle.addSection("model.ext", ext.c_str(), ext.size());
+  bundle.addFile("model", modelFile);
+
+  bundle.addFile("learning", learnFile);
+  std::string indexFile = learnFile + ".matcher.idx";
+  if (vpIoTools::checkFilename(indexFile)) {
+    bundle.addFile("matcher.idx", indexFile);
+    vpIoTools::remove(indexFile);
+  }
+  vpIoTools::remove(learnFile);
+  bundle.close();
+}
+
+/*!
+  Bring a detector and a tracker to ready-to-detect state from a
+  bundle : the camera parameters are set on the tracker, the model
+  geometry is loaded, and the learning data (with the matcher index
+  when bundled) are restored into \e keypoint. The sections read from
+  paths are extracted next to the bundle file.
+
+  \param filename : Path of the bundle file written by save().
+  \param keypoint : Detector restored to its learned state; construct
+  it with the same detector/extractor/matcher configuration as at
+  training time.
+  \param tracker : Tracker receiving the camera parameters and the
+  model.
+
+  \exception vpException::ioError : If the bundle is unreadable or a
+  section cannot be extracted.
+*/
+void vpMbKltBundle::load(const std::string &filename, vpKeyPoint &keypoint, vpMbKltTracker &tracker)
+{
+  vpArtifactBundle bundle;
+  bundle.open(filename);
+
+  std::vector<char> camData;
+  bundle.getSection("camera", camData);
+  if (camData.size() != 7 * sizeof(double))
+    throw vpException(vpException::ioError, "Invalid camera section in the bundle %s", filename.c_str());
+  const double *c = (const double *)&camData[0];
+  vpCameraParameters cam;
+  if ((int)c[0] == (int)vpCameraParameters::perspectiveProjWithDistortion)
+    cam.initPersProjWithDistortion(c[1], c[2], c[3], c[4], c[5], c[6]);
+  else
+    cam.initPersProjWithoutDistortion(c[1], c[2], c[3], c[4]);
+
+  std::vector<char> extData;
+  bundle.getSection("model.ext", extData);
+  std::string ext(extData.begin(), extData.end());
+  if (ext.empty() || ext[0] != '.' || ext.find('/') != std::string::npos
+      || ext.find('\\') != std::string::npos)
+    throw vpException(vpException::ioError, "Invalid model extension in the bundle %s", filename.c_str());
+
+  std::string modelPath = filename + ".model" + ext;
+  bundle.extractSection("model", modelPath);
+  std::string learnPath = filename + ".learning.bin";
+  bundle.extractSection("learning", learnPath);
+  if (bundle.hasSection("matcher.idx"))
+    bundle.extractSection("matcher.idx", learnPath + ".matcher.idx");
+
+  tracker.setCameraParameters(cam);
+  tracker.loadModel(modelPath);
+  keypoint.loadLearningData(learnPath, true, false);
+}
+
+#elif !defined(VISP_BUILD_SHARED_LIBS)
+// Work arround to avoid warning: libvisp_mbt.a(vpMbKltBundle.cpp.o) has no symbols
+void dummy_vpMbKltBundle() {}
+#endif
@@ -60,7 +60,9 @@
 
 vpMbScanLine::vpMbScanLine()
   : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(),
-    visibility_samples(), depthTreshold(1e-06)
+    visibility_samples(), depthTreshold(1e-06),
+    reuseTolerance(0.), hasCachedRender(false),
+    cachedPolyIndices(), cachedPolyPixels(), cachedEdgeKeys()
 #if defined(DEBUG_DISP)
   ,dispMaskDebug(NULL), dispLineDebug(NULL), linedebugImg()
 #endif
@@ -335,6 +337,15 @@ vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigne
                         std::vector<int> listPolyIndices,
                         const vpCameraParameters &cam, unsigned int width, unsigned int height)
 {
+  // Temporal reuse: when every polygon vertex projects within reuseTolerance
+  // pixels of where it was rasterized, the scanline structures of the
+  // previous frame are still valid. Only the keys of the visibility samples
+  // are re-expressed with the current camera frame coordinates so that the
+  // queries keep matching.
+  if (reuseTolerance > 0 && hasCachedRender && w == width && h == height &&
+      tryReuseRender(polygons, listPolyIndices, cam))
+    return;
+
   this->w = width;
   this->h = height;
   this->K = cam;
@@ -423,14 +434,17 @@ vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigne
               {
                   const unsigned int x0 = std::max<unsigned int>(0, (unsigned int)(std::ceil(last_visible.p)));
                   const double x1 = std::min<double>(w, s.p);
-                  for(unsigned int x = x0 + maskBorder ; x < x1 - maskBorder; ++x)
-                  {
-                      primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
-
-                      if(maskBorder != 0)
-                        maskY[(unsigned int)y][(unsigned int)x] = 255;
-                      else
-                        mask[(unsigned int)y][(unsigned int)x] = 255;
+                  // The whole span shares the same ID and mask value: fill
+                  // the rows with std::fill/memset instead of per-pixel
+                  // indexations
+                  unsigned int x_start = x0 + maskBorder;
+                  if ((double)x_start < x1 - (double)maskBorder) {
+                      // One past the last x such that x < x1 - maskBorder
+                      unsigned int x_end = (unsigned int)std::ceil(x1 - (double)maskBorder);
+                      int *ids_row = primitive_ids[(unsigned int)y];
+                      std::fill(ids_row + x_start, ids_row + x_end, last_visible.ID);
+                      unsigned char *mask_row = (maskBorder != 0) ? maskY[(unsigned int)y] : mask[(unsigned int)y];
+                      memset(mask_row + x_start, 255, x_end - x_start);
                   }
               }
 
@@ -525,10 +539,15 @@ vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigne
   }
 
   if(maskBorder != 0)
-    for(unsigned int i = 0 ; i < h ; i++)
+    for(unsigned int i = 0 ; i < h ; i++) {
+      // The masks only hold 0 or 255 and mask starts cleared: the
+      // combination is a plain byte AND streamed over the rows
+      const unsigned char *mx = maskX[i];
+      const unsigned char *my = maskY[i];
+      unsigned char *m = mask[i];
       for(unsigned int j = 0 ; j < w ; j++)
-        if(maskX[i][j] == 255 && maskY[i][j] == 255)
-          mask[i][j] = 255;
+        m[j] = mx[j] & my[j];
+    }
 
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
   if(!dispMaskDebug->isInitialised()){
@@ -562,6 +581,128 @@ vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigne
   vpDisplay::display(linedebugImg);
 #endif
 
+  if (reuseTolerance > 0)
+    recordRenderCache(polygons, listPolyIndices);
+  else
+    hasCachedRender = false;
+}
+
+/*!
+  Check whether the render of the previous call to drawScene() can be reused
+  for the given polygons: same polygon list and every vertex projected within
+  reuseTolerance pixels of the cached render. On success the visibility sample
+  keys are re-expressed with the current camera frame coordinates of the
+  polygon edges and the mask, primitive ids and samples are kept as they are.
+
+  \param polygons : List of polygons composed by arrays of lines.
+  \param listPolyIndices : List of polygons IDs.
+  \param cam : Camera parameters.
+
+  \return True if the previous render has been reused.
+*/
+bool
+vpMbScanLine::tryReuseRender(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > * > &polygons,
+                             const std::vector<int> &listPolyIndices,
+                             const vpCameraParameters &cam)
+{
+  if (polygons.size() != cachedPolyPixels.size())
+    return false;
+
+  if (std::fabs(cam.get_px() - K.get_px()) > std::numeric_limits<double>::epsilon() ||
+      std::fabs(cam.get_py() - K.get_py()) > std::numeric_limits<double>::epsilon() ||
+      std::fabs(cam.get_u0() - K.get_u0()) > std::numeric_limits<double>::epsilon() ||
+      std::fabs(cam.get_v0() - K.get_v0()) > std::numeric_limits<double>::epsilon())
+    return false;
+
+  for(unsigned int ID = 0 ; ID < polygons.size() ; ++ID)
+  {
+    if (listPolyIndices[ID] != cachedPolyIndices[ID])
+      return false;
+
+    const std::vector<std::pair<vpPoint, unsigned int> > &polygon = *(polygons[ID]);
+    if (polygon.size() != cachedPolyPixels[ID].size())
+      return false;
+
+    for(size_t i = 0 ; i < polygon.size() ; ++i)
+    {
+      vpColVector v;
+      createVectorFromPoint(polygon[i].first, v, K);
+      if (std::fabs(v[0] / v[2] - cachedPolyPixels[ID][i].first) > reuseTolerance ||
+          std::fabs(v[1] / v[2] - cachedPolyPixels[ID][i].second) > reuseTolerance)
+        return false;
+    }
+  }
+
+  // Every polygon is where the cached render rasterized it: move the
+  // visibility samples under the edge keys of the current frame so that
+  // queryLineVisibility(), fed with current camera frame points, still
+  // finds them.
+  std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> new_samples;
+  for(unsigned int ID = 0 ; ID < polygons.size() ; ++ID)
+  {
+    const std::vector<std::pair<vpPoint, unsigned int> > &polygon = *(polygons[ID]);
+    for(size_t i = 0 ; i < cachedEdgeKeys[ID].size() ; ++i)
+    {
+      vpMbScanLineEdge new_key;
+      if (polygon.size() == 2)
+        new_key = makeMbScanLineEdge(polygon.front().first, polygon.back().first);
+      else
+        new_key = makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first);
+
+      std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator>::const_iterator
+          it = visibility_samples.find(cachedEdgeKeys[ID][i]);
+      if (it != visibility_samples.end())
+        new_samples[new_key].insert(it->second.begin(), it->second.end());
+
+      cachedEdgeKeys[ID][i] = new_key;
+    }
+  }
+  visibility_samples.swap(new_samples);
+
+  return true;
+}
+
+/*!
+  Record the polygons of the render that has just been performed: projected
+  pixel coordinates of every vertex (reference positions for the reuse test)
+  and the edge keys indexing the visibility samples.
+
+  \param polygons : List of polygons composed by arrays of lines.
+  \param listPolyIndices : List of polygons IDs.
+*/
+void
+vpMbScanLine::recordRenderCache(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > * > &polygons,
+                                const std::vector<int> &listPolyIndices)
+{
+  cachedPolyIndices = listPolyIndices;
+  cachedPolyPixels.resize(polygons.size());
+  cachedEdgeKeys.resize(polygons.size());
+
+  for(unsigned int ID = 0 ; ID < polygons.size() ; ++ID)
+  {
+    const std::vector<std::pair<vpPoint, unsigned int> > &polygon = *(polygons[ID]);
+    cachedPolyPixels[ID].resize(polygon.size());
+    for(size_t i = 0 ; i < polygon.size() ; ++i)
+    {
+      vpColVector v;
+      createVectorFromPoint(polygon[i].first, v, K);
+      cachedPolyPixels[ID][i] = std::make_pair(v[0] / v[2], v[1] / v[2]);
+    }
+
+    if (polygon.size() < 2)
+      cachedEdgeKeys[ID].clear();
+    else if (polygon.size() == 2) {
+      cachedEdgeKeys[ID].resize(1);
+      cachedEdgeKeys[ID][0] = makeMbScanLineEdge(polygon.front().first, polygon.back().first);
+    }
+    else {
+      cachedEdgeKeys[ID].resize(polygon.size());
+      for(size_t i = 0 ; i < polygon.size() ; ++i)
+        cachedEdgeKeys[ID][i] = makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first);
+    }
+  }
+
+  hasCachedRender = true;
 }
 
 /*!
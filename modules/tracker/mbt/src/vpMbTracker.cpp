@@ -42,6 +42,8 @@
   \brief Generic model based tracker
 */
 
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <iostream>
 #include <limits>
 #include <algorithm>
@@ -128,13 +130,15 @@ struct PolygonFaceInfo {
 */
 vpMbTracker::vpMbTracker()
 : cam(), cMo(), oJo(6,6), isoJoIdentity(true), modelFileName(), modelInitialised(false),
-  poseSavingFilename(), computeCovariance(false), covarianceMatrix(), computeProjError(false),
+  poseSavingFilename(), computeCovariance(false), covarianceMatrix(), m_covarianceDirty(false),
+  m_covCMoPrev(), m_covError(), m_covJacobian(), m_covWeights(), computeProjError(false),
   projectionError(90.0), displayFeatures(false), m_w(), m_error(), m_optimizationMethod(vpMbTracker::GAUSS_NEWTON_OPT),
   faces(), angleAppears( vpMath::rad(89) ), angleDisappears( vpMath::rad(89) ), distNearClip(0.001),
-  distFarClip(100), clippingFlag(vpPolygon3D::NO_CLIPPING), useOgre(false), ogreShowConfigDialog(false), useScanLine(false),
+  distFarClip(100), clippingFlag(vpPolygon3D::NO_CLIPPING), clippedPolygonCacheTol(0.),
+  m_telemetry(NULL), m_telemetryFrame(0), m_modelOps(), m_modelRecording(false), m_modelCacheEnabled(false), useOgre(false), ogreShowConfigDialog(false), useScanLine(false),
   nbPoints(0), nbLines(0), nbPolygonLines(0), nbPolygonPoints(0), nbCylinders(0), nbCircles(0),
   useLodGeneral(false), applyLodSettingInConfig(false), minLineLengthThresholdGeneral(50.0),
-  minPolygonAreaThresholdGeneral(2500.0), mapOfParameterNames()
+  minPolygonAreaThresholdGeneral(2500.0), mapOfParameterNames(), m_posePredictor(NULL)
 {
     oJo.eye();
     //Map used to parse additional information in CAO model files,
@@ -753,6 +757,12 @@ void vpMbTracker::initFromPose(const vpImage<unsigned char>& I, const std::strin
 void vpMbTracker::initFromPose(const vpImage<unsigned char>& I, const vpHomogeneousMatrix &cMo_)
 {
   this->cMo = cMo_;
+
+  // The pose is imposed from outside: the velocity observed so far by the
+  // pose predictor does not apply anymore
+  if (m_posePredictor != NULL)
+    m_posePredictor->reset();
+
   init(I);
 }
 
@@ -834,6 +844,9 @@ void vpMbTracker::addPolygon(const std::vector<vpPoint>& corners, const int idFa
 
   if((clippingFlag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING)
     faces.getPolygon().back()->setFarClippingDistance(distFarClip);
+
+  if(clippedPolygonCacheTol > 0)
+    faces.getPolygon().back()->setClippedPolygonCacheTolerance(clippedPolygonCacheTol);
 }
 
 void vpMbTracker::addPolygon(const vpPoint& p1, const vpPoint &p2, const vpPoint &p3, const double radius,
@@ -915,6 +928,9 @@ void vpMbTracker::addPolygon(const vpPoint& p1, const vpPoint &p2, const vpPoint
 
     if((clippingFlag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING)
       faces.getPolygon().back()->setFarClippingDistance(distFarClip);
+
+    if(clippedPolygonCacheTol > 0)
+      faces.getPolygon().back()->setClippedPolygonCacheTolerance(clippedPolygonCacheTol);
 }
 
 void vpMbTracker::addPolygon(const vpPoint& p1, const vpPoint &p2, const int idFace, const std::string &polygonName,
@@ -950,6 +966,9 @@ void vpMbTracker::addPolygon(const vpPoint& p1, const vpPoint &p2, const int idF
 
   if((clippingFlag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING)
     faces.getPolygon().back()->setFarClippingDistance(distFarClip);
+
+  if(clippedPolygonCacheTol > 0)
+    faces.getPolygon().back()->setClippedPolygonCacheTolerance(clippedPolygonCacheTol);
 }
 
 void vpMbTracker::addPolygon(const std::vector<std::vector<vpPoint> > &listFaces, const int idFace, const std::string &polygonName,
@@ -981,6 +1000,9 @@ void vpMbTracker::addPolygon(const std::vector<std::vector<vpPoint> > &listFaces
         if((clippingFlag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING)
           faces.getPolygon().back()->setFarClippingDistance(distFarClip);
 
+        if(clippedPolygonCacheTol > 0)
+          faces.getPolygon().back()->setClippedPolygonCacheTolerance(clippedPolygonCacheTol);
+
         id++;
     }
 }
@@ -1047,6 +1069,14 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
   std::string::const_iterator it;
   
   if(vpIoTools::checkFilename(modelFile)) {
+    // Replay the binary model cache instead of parsing when it is
+    // enabled, present and newer than the model file
+    if (m_modelCacheEnabled && replayModelCache(modelFile + ".bin", modelFile)) {
+      this->modelInitialised = true;
+      this->modelFileName = modelFile;
+      return;
+    }
+
     it = modelFile.end();
     if((*(it-1) == 'o' && *(it-2) == 'a' && *(it-3) == 'c' && *(it-4) == '.') ||
        (*(it-1) == 'O' && *(it-2) == 'A' && *(it-3) == 'C' && *(it-4) == '.') ){
@@ -1058,7 +1088,15 @@ vpMbTracker::loadModel(const std::string& modelFile, const bool verbose)
       nbPolygonPoints = 0;
       nbCylinders = 0;
       nbCircles = 0;
+      if (m_modelCacheEnabled) {
+        m_modelOps.clear();
+        m_modelRecording = true;
+      }
       loadCAOModel(modelFile, vectorOfModelFilename, startIdFace, verbose, true);
+      if (m_modelRecording) {
+        m_modelRecording = false;
+        saveModelCache(modelFile + ".bin");
+      }
     }
     else if((*(it-1) == 'l' && *(it-2) == 'r' && *(it-3) == 'w' && *(it-4) == '.') ||
             (*(it-1) == 'L' && *(it-2) == 'R' && *(it-3) == 'W' && *(it-4) == '.') ){
@@ -1561,6 +1599,12 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
       addPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
       initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      if (m_modelRecording) {
+        vpModelOp op; op.type = 0; op.pts = corners; op.name = polygonName;
+        op.useLod = useLod; op.minPolygonArea = minPolygonAreaThreshold;
+        op.minLineLength = minLineLengthThresholdGeneral;
+        m_modelOps.push_back(op);
+      }
     }
 
     //Add the segments which were not already added in the face segment case
@@ -1570,6 +1614,12 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         addPolygon(it->second.extremities, idFace++, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
                    it->second.minLineLengthThresh);
         initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+        if (m_modelRecording) {
+          vpModelOp op; op.type = 1; op.pts = it->second.extremities; op.name = it->second.name;
+          op.useLod = it->second.useLod; op.minPolygonArea = minPolygonAreaThresholdGeneral;
+          op.minLineLength = it->second.minLineLengthThresh;
+          m_modelOps.push_back(op);
+        }
       }
     }
 
@@ -1636,6 +1686,12 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
       addPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
       initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+      if (m_modelRecording) {
+        vpModelOp op; op.type = 1; op.pts = corners; op.name = polygonName;
+        op.useLod = useLod; op.minPolygonArea = minPolygonAreaThreshold;
+        op.minLineLength = minLineLengthThresholdGeneral;
+        m_modelOps.push_back(op);
+      }
     }
 
     //////////////////////////Read the cylinder declaration part//////////////////////////
@@ -1701,6 +1757,13 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
         idFace+=4;
 
         initCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
+        if (m_modelRecording) {
+          vpModelOp op; op.type = 2;
+          op.pts.push_back(caoPoints[indexP1]); op.pts.push_back(caoPoints[indexP2]);
+          op.radius = radius; op.name = polygonName; op.useLod = useLod;
+          op.minLineLength = minLineLengthThreshold;
+          m_modelOps.push_back(op);
+        }
       }
 
     } catch (...) {
@@ -1770,6 +1833,14 @@ vpMbTracker::loadCAOModel(const std::string& modelFile,
 
         initCircle(caoPoints[indexP1], caoPoints[indexP2],
                    caoPoints[indexP3], radius, idFace++, polygonName);
+        if (m_modelRecording) {
+          vpModelOp op; op.type = 3;
+          op.pts.push_back(caoPoints[indexP1]); op.pts.push_back(caoPoints[indexP2]);
+          op.pts.push_back(caoPoints[indexP3]);
+          op.radius = radius; op.name = polygonName; op.useLod = useLod;
+          op.minPolygonArea = minPolygonAreaThreshold;
+          m_modelOps.push_back(op);
+        }
       }
 
     } catch (...) {
@@ -2330,6 +2401,23 @@ vpMbTracker::setClipping(const unsigned int &flags)
     faces[i]->setClipping(clippingFlag);
 }
 
+/*!
+  Set the pose displacement under which the polygons reuse the clipping result
+  of the previous frame instead of recomputing it. The tolerance applies both
+  to the translation (in meter) and to the rotation (in radian) of the
+  inter-frame displacement. Useful when the camera moves slowly with respect
+  to the object since most frames then produce an identical clipping.
+
+  \param tol : Pose tolerance (0 to always recompute, which is the default).
+*/
+void
+vpMbTracker::setClippedPolygonCacheTolerance(const double &tol)
+{
+  clippedPolygonCacheTol = tol;
+  for (unsigned int i = 0; i < faces.size(); i ++)
+    faces[i]->setClippedPolygonCacheTolerance(tol);
+}
+
 /*!
   Compute \f$ J^T R \f$, with J the interaction matrix and R the vector of 
   residu.
@@ -2509,3 +2597,236 @@ vpMbTracker::createCylinderBBox(const vpPoint& p1, const vpPoint &p2, const doub
     listFaces.push_back(pointsFace);
 }
 
+
+// Magic number and version of the tracker checkpoint files
+#define VP_MB_CHECKPOINT_MAGIC 0x4d425450 // "MBTP"
+#define VP_MB_CHECKPOINT_VERSION 1
+
+/*!
+  Save the tracker state in a binary checkpoint file: the current pose
+  and the visibility/clipping configuration. Together with the model and
+  the current image, loadCheckpoint() re-arms the tracker exactly where
+  it was, without the interactive or file based initialization.
+
+  \param filename : Checkpoint file to write.
+  \return true on success, false if the file cannot be written.
+
+  \sa loadCheckpoint()
+*/
+bool vpMbTracker::saveCheckpoint(const std::string &filename) const
+{
+  std::ofstream file(filename.c_str(), std::ios::out|std::ios::binary);
+  if (!file)
+    return false;
+
+  unsigned int magic = VP_MB_CHECKPOINT_MAGIC, version = VP_MB_CHECKPOINT_VERSION;
+  file.write((const char *)&magic, sizeof(unsigned int));
+  file.write((const char *)&version, sizeof(unsigned int));
+
+  for (unsigned int i = 0; i < 4; i++)
+    for (unsigned int j = 0; j < 4; j++) {
+      double v = cMo[i][j];
+      file.write((const char *)&v, sizeof(double));
+    }
+
+  file.write((const char *)&angleAppears, sizeof(double));
+  file.write((const char *)&angleDisappears, sizeof(double));
+  file.write((const char *)&clippingFlag, sizeof(unsigned int));
+  file.write((const char *)&distNearClip, sizeof(double));
+  file.write((const char *)&distFarClip, sizeof(double));
+
+  return (bool)file.good();
+}
+
+/*!
+  Restore the tracker from a checkpoint written by saveCheckpoint(): the
+  visibility/clipping configuration is restored and the tracker is
+  re-initialized on the image from the saved pose, re-sampling its
+  features deterministically from the model. The model must have been
+  loaded before.
+
+  \param I : Current image, on which the features are re-initialized.
+  \param filename : Checkpoint file written by saveCheckpoint().
+  \return true on success, false if the file cannot be read or does not
+  hold a checkpoint.
+
+  \sa saveCheckpoint()
+*/
+bool vpMbTracker::loadCheckpoint(const vpImage<unsigned char>& I, const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::in|std::ios::binary);
+  if (!file)
+    return false;
+
+  unsigned int magic = 0, version = 0;
+  file.read((char *)&magic, sizeof(unsigned int));
+  file.read((char *)&version, sizeof(unsigned int));
+  if (!file.good() || magic != VP_MB_CHECKPOINT_MAGIC || version != VP_MB_CHECKPOINT_VERSION)
+    return false;
+
+  vpHomogeneousMatrix cMo_checkpoint;
+  for (unsigned int i = 0; i < 4; i++)
+    for (unsigned int j = 0; j < 4; j++) {
+      double v = 0;
+      file.read((char *)&v, sizeof(double));
+      cMo_checkpoint[i][j] = v;
+    }
+
+  double angle_appears = 0, angle_disappears = 0, dist_near = 0, dist_far = 0;
+  unsigned int clipping_flag = 0;
+  file.read((char *)&angle_appears, sizeof(double));
+  file.read((char *)&angle_disappears, sizeof(double));
+  file.read((char *)&clipping_flag, sizeof(unsigned int));
+  file.read((char *)&dist_near, sizeof(double));
+  file.read((char *)&dist_far, sizeof(double));
+
+  if (!file.good())
+    return false;
+
+  setAngleAppear(angle_appears);
+  setAngleDisappear(angle_disappears);
+  setClipping(clipping_flag);
+  if (clipping_flag & vpPolygon3D::NEAR_CLIPPING)
+    setNearClippingDistance(dist_near);
+  if (clipping_flag & vpPolygon3D::FAR_CLIPPING)
+    setFarClippingDistance(dist_far);
+
+  initFromPose(I, cMo_checkpoint);
+  return true;
+}
+
+#undef VP_MB_CHECKPOINT_MAGIC
+#undef VP_MB_CHECKPOINT_VERSION
+
+// Magic number and version of the binary model cache files
+#define VP_MB_MODEL_CACHE_MAGIC 0x4d424d43 // "MBMC"
+#define VP_MB_MODEL_CACHE_VERSION 1
+
+/*!
+  Write the model build operations recorded while parsing in a binary
+  cache file, see setModelCacheEnabled().
+*/
+bool vpMbTracker::saveModelCache(const std::string &cacheFile) const
+{
+  std::ofstream file(cacheFile.c_str(), std::ios::out|std::ios::binary);
+  if (!file)
+    return false;
+
+  unsigned int magic = VP_MB_MODEL_CACHE_MAGIC, version = VP_MB_MODEL_CACHE_VERSION;
+  unsigned int nb_ops = (unsigned int)m_modelOps.size();
+  file.write((const char *)&magic, sizeof(unsigned int));
+  file.write((const char *)&version, sizeof(unsigned int));
+  file.write((const char *)&nb_ops, sizeof(unsigned int));
+
+  for (size_t o = 0; o < m_modelOps.size(); o++) {
+    const vpModelOp &op = m_modelOps[o];
+    file.write((const char *)&op.type, sizeof(int));
+    unsigned int nb_pts = (unsigned int)op.pts.size();
+    file.write((const char *)&nb_pts, sizeof(unsigned int));
+    for (unsigned int i = 0; i < nb_pts; i++) {
+      double c[3] = { op.pts[i].get_oX(), op.pts[i].get_oY(), op.pts[i].get_oZ() };
+      file.write((const char *)c, 3*sizeof(double));
+    }
+    file.write((const char *)&op.radius, sizeof(double));
+    unsigned int name_len = (unsigned int)op.name.size();
+    file.write((const char *)&name_len, sizeof(unsigned int));
+    if (name_len)
+      file.write(op.name.c_str(), name_len);
+    char use_lod = op.useLod ? 1 : 0;
+    file.write(&use_lod, 1);
+    file.write((const char *)&op.minPolygonArea, sizeof(double));
+    file.write((const char *)&op.minLineLength, sizeof(double));
+  }
+
+  return (bool)file.good();
+}
+
+/*!
+  Replay the model build operations of a binary cache written by a
+  previous parse of \e modelFile, when the cache exists and is newer
+  than the model file. Reproduces exactly the faces, cylinders and
+  circles that the parse would build.
+
+  \return true when the model was built from the cache.
+*/
+bool vpMbTracker::replayModelCache(const std::string &cacheFile, const std::string &modelFile)
+{
+  struct stat cache_stat, model_stat;
+  if (stat(cacheFile.c_str(), &cache_stat) != 0 || stat(modelFile.c_str(), &model_stat) != 0)
+    return false;
+  if (cache_stat.st_mtime < model_stat.st_mtime)
+    return false;
+
+  std::ifstream file(cacheFile.c_str(), std::ios::in|std::ios::binary);
+  if (!file)
+    return false;
+
+  unsigned int magic = 0, version = 0, nb_ops = 0;
+  file.read((char *)&magic, sizeof(unsigned int));
+  file.read((char *)&version, sizeof(unsigned int));
+  file.read((char *)&nb_ops, sizeof(unsigned int));
+  if (!file.good() || magic != VP_MB_MODEL_CACHE_MAGIC || version != VP_MB_MODEL_CACHE_VERSION)
+    return false;
+
+  int idFace = (int)faces.size();
+  for (unsigned int o = 0; o < nb_ops; o++) {
+    vpModelOp op;
+    file.read((char *)&op.type, sizeof(int));
+    unsigned int nb_pts = 0;
+    file.read((char *)&nb_pts, sizeof(unsigned int));
+    op.pts.resize(nb_pts);
+    for (unsigned int i = 0; i < nb_pts; i++) {
+      double c[3];
+      file.read((char *)c, 3*sizeof(double));
+      op.pts[i].setWorldCoordinates(c[0], c[1], c[2]);
+    }
+    file.read((char *)&op.radius, sizeof(double));
+    unsigned int name_len = 0;
+    file.read((char *)&name_len, sizeof(unsigned int));
+    if (name_len) {
+      std::vector<char> buf(name_len);
+      file.read(&buf[0], name_len);
+      op.name.assign(&buf[0], name_len);
+    }
+    char use_lod = 0;
+    file.read(&use_lod, 1);
+    op.useLod = (use_lod != 0);
+    file.read((char *)&op.minPolygonArea, sizeof(double));
+    file.read((char *)&op.minLineLength, sizeof(double));
+
+    if (!file.good())
+      return false;
+
+    switch (op.type) {
+    case 0: // face initialized from lines
+      addPolygon(op.pts, idFace++, op.name, op.useLod, op.minPolygonArea, op.minLineLength);
+      initFaceFromLines(*(faces.getPolygon().back()));
+      break;
+    case 1: // face initialized from corners
+      addPolygon(op.pts, idFace++, op.name, op.useLod, op.minPolygonArea, op.minLineLength);
+      initFaceFromCorners(*(faces.getPolygon().back()));
+      break;
+    case 2: { // cylinder: same sequence as the parser
+      int idRevolutionAxis = idFace;
+      addPolygon(op.pts[0], op.pts[1], idFace++, op.name, op.useLod, op.minLineLength);
+      std::vector<std::vector<vpPoint> > listFaces;
+      createCylinderBBox(op.pts[0], op.pts[1], op.radius, listFaces);
+      addPolygon(listFaces, idFace, op.name, op.useLod, op.minLineLength);
+      idFace += 4;
+      initCylinder(op.pts[0], op.pts[1], op.radius, idRevolutionAxis, op.name);
+      break;
+    }
+    case 3: // circle
+      addPolygon(op.pts[0], op.pts[1], op.pts[2], op.radius, idFace, op.name, op.useLod, op.minPolygonArea);
+      initCircle(op.pts[0], op.pts[1], op.pts[2], op.radius, idFace++, op.name);
+      break;
+    default:
+      return false;
+    }
+  }
+
+  return true;
+}
+
+#undef VP_MB_MODEL_CACHE_MAGIC
+#undef VP_MB_MODEL_CACHE_VERSION
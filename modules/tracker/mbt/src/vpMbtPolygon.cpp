@@ -158,11 +158,12 @@ vpMbtPolygon::isVisible(const vpHomogeneousMatrix &cMo, const double alpha, cons
   //Check visibility from normal
   //Newell's Method for calculating the normal of an arbitrary 3D polygon
   //https://www.opengl.org/wiki/Calculating_a_Surface_Normal
+  //The camera frame coordinates are read in place: copying each vertex
+  //in a vpColVector allocated two temporaries per vertex and per frame
   vpColVector faceNormal(3);
-  vpColVector currentVertex, nextVertex;
   for(unsigned int  i = 0; i<nbpt; i++) {
-    currentVertex = p[i].cP;
-    nextVertex = p[(i+1) % nbpt].cP;
+    const vpColVector &currentVertex = p[i].cP;
+    const vpColVector &nextVertex = p[(i+1) % nbpt].cP;
 
     faceNormal[0] += (currentVertex[1] - nextVertex[1]) * (currentVertex[2] + nextVertex[2]);
     faceNormal[1] += (currentVertex[2] - nextVertex[2]) * (currentVertex[0] + nextVertex[0]);
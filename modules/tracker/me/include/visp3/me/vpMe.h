@@ -48,6 +48,7 @@
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpDistortionLut.h>
 
 /*!
   \class vpMe
@@ -63,7 +64,13 @@ public:
 #else
 private:
 #endif
-  double threshold ;//! Likelihood ratio threshold
+  double threshold ;
+  bool m_adaptiveThreshold; //!< Adaptive likelihood threshold enabled
+  double m_adaptiveRatio;   //!< Fraction of the running average used as threshold
+  double m_adaptiveGain;    //!< EWMA gain of the running average//! Likelihood ratio threshold
+  bool m_coarseToFine;      //!< Coarse-to-fine likelihood query enabled
+  unsigned int m_coarseToFineStep; //!< Bound on the coarse sampling step
+  const vpDistortionLut *m_distortionLut; //!< Raw-image sampling table, not owned
   double mu1; //! Contrast continuity parameter (left boundary)
   double mu2; //! Contrast continuity parameter (right boundary)
   double min_samplestep;
@@ -293,6 +300,67 @@ public:
     \return Value of threshold.
   */
   inline double getThreshold() const { return threshold; }
+
+  /*!
+    Enable the adaptive likelihood threshold : each tracker keeps an
+    exponentially weighted moving average of the contrasts of its accepted
+    sites and scales the acceptance threshold from it, so lighting drift
+    is followed without any per-frame histogram pass.
+
+    \param enable : True to adapt the thresholds.
+    \param ratio : Fraction of the average accepted contrast used as the
+    threshold (0.5 keeps sites stronger than half the running average).
+    \param gain : EWMA gain per frame, between 0 and 1.
+  */
+  void setAdaptiveThreshold(const bool &enable, const double &ratio = 0.5, const double &gain = 0.05)
+  {
+    m_adaptiveThreshold = enable;
+    m_adaptiveRatio = ratio;
+    m_adaptiveGain = gain;
+  }
+  //! Indicates if the adaptive likelihood threshold is enabled, see setAdaptiveThreshold().
+  inline bool getAdaptiveThreshold() const { return m_adaptiveThreshold; }
+  //! Ratio of the running average contrast used as threshold, see setAdaptiveThreshold().
+  inline double getAdaptiveThresholdRatio() const { return m_adaptiveRatio; }
+  //! Per-frame gain of the running average, see setAdaptiveThreshold().
+  inline double getAdaptiveThresholdGain() const { return m_adaptiveGain; }
+
+  /*!
+    Enable the coarse-to-fine likelihood query : each site first
+    evaluates the oriented mask every Kth position of its search range
+    and then refines around the best coarse hit, instead of evaluating
+    every position. K adapts to the width of the mask response (the
+    convolution of an edge spans the mask support, so sampling within
+    half of it cannot step over a peak) and the mode only engages when
+    the range is large enough to save evaluations.
+
+    \param enable : True to query coarse-to-fine.
+    \param maxStep : Bound on the coarse sampling step K.
+  */
+  void setCoarseToFineQuery(const bool &enable, const unsigned int &maxStep = 4)
+  {
+    m_coarseToFine = enable;
+    m_coarseToFineStep = (maxStep < 2) ? 2 : maxStep;
+  }
+  //! Indicates if the coarse-to-fine likelihood query is enabled, see setCoarseToFineQuery().
+  inline bool getCoarseToFineQuery() const { return m_coarseToFine; }
+  //! Bound on the coarse sampling step, see setCoarseToFineQuery().
+  inline unsigned int getCoarseToFineQueryStep() const { return m_coarseToFineStep; }
+
+  /*!
+    Track on the raw (distorted) image : the sites keep undistorted
+    coordinates, and every mask evaluation maps its position into the
+    raw image through the table, so the full-frame
+    vpImageTools::undistort() remap is no longer needed ahead of the
+    tracking.
+
+    \param lut : Distortion table built for the camera and the image
+    size, or NULL to sample the image as-is. The table is not copied :
+    it must outlive every tracker configured with this vpMe.
+  */
+  void setDistortionLut(const vpDistortionLut *lut) { m_distortionLut = lut; }
+  //! Raw-image sampling table, NULL when disabled. See setDistortionLut().
+  inline const vpDistortionLut *getDistortionLut() const { return m_distortionLut; }
 };
 
 
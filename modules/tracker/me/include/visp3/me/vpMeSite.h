@@ -104,6 +104,11 @@ public:
   double normGradient ;
   // Uncertainty of point given as a probability between 0 and 1
   double weight;
+  //! Per-site likelihood threshold; negative means use the one of vpMe
+  double m_thresholdOverride;
+
+  //! Set the per-site likelihood threshold used instead of the vpMe one; a negative value restores it.
+  inline void setThresholdOverride(const double &t) { m_thresholdOverride = t; }
   
 private:
   vpMeSiteDisplayType selectDisplay ;
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Structure of arrays storage for the moving-edge sites.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpMeSiteSoA_h_
+#define __vpMeSiteSoA_h_
+
+#include <list>
+#include <vector>
+
+#include <visp3/me/vpMeSite.h>
+
+/*!
+  \class vpMeSiteSoA
+  \ingroup group_me
+
+  \brief Structure of arrays snapshot of a list of moving-edge sites.
+
+  The trackers keep their sites in a std::list<vpMeSite> whose scattered
+  nodes are pointer-chased by every pass over the sites. This container
+  snapshots a list in separate contiguous arrays (coordinates, angle,
+  convolution, weight, state) so that the streaming passes that only
+  need a few fields per site (query list building, batched pixel/meter
+  conversion, interaction matrix assembly) run on dense arrays, while
+  the full site records stay available contiguously for the passes that
+  need them:
+
+  \code
+  vpMeSiteSoA sites;
+  sites.fromList(me_tracker_list);
+  vpPixelMeterConversion::convertPoints(cam, sites.size(),
+      sites.getJfloat(), sites.getIfloat(), x, y);  // dense arrays
+  \endcode
+
+  The buffers are reused between the fromList() calls so that a
+  per-frame snapshot performs no allocation after the first frame.
+*/
+class VISP_EXPORT vpMeSiteSoA
+{
+public:
+  vpMeSiteSoA() : m_ifloat(), m_jfloat(), m_alpha(), m_convlt(), m_weight(), m_state(), m_sites() {}
+
+  void fromList(const std::list<vpMeSite> &list);
+  void toList(std::list<vpMeSite> &list) const;
+
+  //! Return the number of sites of the snapshot.
+  inline unsigned int size() const { return (unsigned int)m_sites.size(); }
+
+  //! Dense array of the i (row) sub-pixel coordinates.
+  inline const double *getIfloat() const { return m_ifloat.empty() ? NULL : &m_ifloat[0]; }
+  //! Dense array of the j (column) sub-pixel coordinates.
+  inline const double *getJfloat() const { return m_jfloat.empty() ? NULL : &m_jfloat[0]; }
+  //! Dense array of the site orientations.
+  inline const double *getAlpha() const { return m_alpha.empty() ? NULL : &m_alpha[0]; }
+  //! Dense array of the site convolutions.
+  inline const double *getConvlt() const { return m_convlt.empty() ? NULL : &m_convlt[0]; }
+  //! Dense array of the site weights.
+  inline const double *getWeight() const { return m_weight.empty() ? NULL : &m_weight[0]; }
+  //! Dense array of the site states, as vpMeSite::vpMeSiteState values.
+  inline const int *getState() const { return m_state.empty() ? NULL : &m_state[0]; }
+
+  //! Access the full contiguous site records, for the passes needing
+  //! every field.
+  inline vpMeSite *getSites() { return m_sites.empty() ? NULL : &m_sites[0]; }
+  inline const vpMeSite *getSites() const { return m_sites.empty() ? NULL : &m_sites[0]; }
+
+private:
+  std::vector<double> m_ifloat;
+  std::vector<double> m_jfloat;
+  std::vector<double> m_alpha;
+  std::vector<double> m_convlt;
+  std::vector<double> m_weight;
+  std::vector<int> m_state;
+  std::vector<vpMeSite> m_sites;
+};
+
+#endif
@@ -45,6 +45,7 @@
 #define vpMeTracker_HH
 
 #include <visp3/core/vpColVector.h>
+#include <visp3/core/vpLatencyStats.h>
 #include <visp3/me/vpMeSite.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/core/vpTracker.h>
@@ -61,6 +62,8 @@
 
   2D state = list of points, 3D state = feature
 */
+class vpTrackerTelemetry;
+
 class VISP_EXPORT vpMeTracker : public vpTracker
 {
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
@@ -78,6 +81,23 @@ protected:
   
 protected:
   vpMeSite::vpMeSiteDisplayType selectDisplay ;
+  //! Contiguous site buffer reused by track() to stream over the sites
+  //! instead of pointer-chasing the list nodes.
+  std::vector<vpMeSite> m_siteBuffer ;
+  //Running average of the accepted site contrasts, for the adaptive
+  //likelihood threshold of vpMe::setAdaptiveThreshold()
+  double m_adaptiveContrastEwma ;
+  bool m_adaptiveEwmaValid ;
+  //! Telemetry buffer the tracker publishes its per-frame diagnostics into, NULL when disabled
+  vpTrackerTelemetry *m_telemetry ;
+  //! Frame counter of the telemetry records
+  unsigned int m_telemetryFrame ;
+  //! Age of the frames processed by track(), see getDataLatencyStats()
+  vpLatencyStats m_dataLatency ;
+  //! Age of the current frame, negative when it was not stamped
+  double m_telemetryDataAge ;
+
+  void publishTelemetry();
 
 public:
   // Constructor/Destructor
@@ -91,6 +111,17 @@ public:
   //! Track sampled pixels.
   void track(const vpImage<unsigned char>& I);
 
+  /*!
+    Set the telemetry buffer the tracker publishes one diagnostics record
+    into at the end of each track() call. The tracking thread is the single
+    producer of the buffer; drain it from one monitoring thread.
+
+    \param telemetry : The telemetry buffer, NULL (default) to disable.
+  */
+  inline void setTelemetry(vpTrackerTelemetry *telemetry) { m_telemetry = telemetry; }
+
+  void seedDisplacement(double di, double dj);
+
   unsigned int numberOfSignal() ;
   unsigned int totalNumberOfSignal() ;
   
@@ -155,7 +186,16 @@ public:
   */
   inline std::list<vpMeSite>& getMeList() { return list; }
   inline std::list<vpMeSite> getMeList() const { return list; }
-  
+
+  /*!
+    Get the age-of-data statistics of the tracking : each track() call
+    on a frame stamped by its grabber (see vpImage::getTimestamp())
+    records the capture-to-tracking latency. The per-frame age is also
+    published in the telemetry records.
+  */
+  const vpLatencyStats &getDataLatencyStats() const { return m_dataLatency; }
+
+
   /*!
     Return the number of points that has not been suppressed.
   
@@ -87,6 +87,16 @@ class VISP_EXPORT vpNurbs : public vpBSpline
 protected:
   std::vector<double> weights;  //Vector which contains the weights associated to each control Points
 
+  //! Sampling grid of the basis value cache used by computeCurveDersPoints()
+  std::vector<double> m_basisCacheU;
+  //! Knot vector of the basis value cache
+  std::vector<double> m_basisCacheKnots;
+  //! Knot spans of the cached samples
+  std::vector<unsigned int> m_basisCacheSpans;
+  //! Cached basis function values and derivatives, (der+1)x(p+1) per sample
+  std::vector<double> m_basisCacheValues;
+  //! Derivative order of the basis value cache
+  unsigned int m_basisCacheDer;
 
 protected:
   static vpMatrix computeCurveDers(double l_u, unsigned int l_i, unsigned int l_p, unsigned int l_der, std::vector<double> &l_knots, std::vector<vpImagePoint> &l_controlPoints, std::vector<double> &l_weights);
@@ -127,6 +137,8 @@ public:
   static vpImagePoint* computeCurveDersPoint(double l_u, unsigned int l_i, unsigned int l_p, unsigned int l_der, std::vector<double> &l_knots, std::vector<vpImagePoint> &l_controlPoints, std::vector<double> &l_weights);
   vpImagePoint* computeCurveDersPoint(double u, unsigned int der);
 
+  void computeCurveDersPoints(const std::vector<double> &u, unsigned int der, std::vector<vpImagePoint> &dersPoints);
+
   static void curveKnotIns(double l_u, unsigned int l_k, unsigned int l_s, unsigned int l_r, unsigned int l_p, std::vector<double> &l_knots, std::vector<vpImagePoint> &l_controlPoints, std::vector<double> &l_weights);
   void curveKnotIns(double u, unsigned int s = 0, unsigned int r = 1);
 
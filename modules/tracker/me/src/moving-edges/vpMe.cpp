@@ -304,8 +304,8 @@ calcul_masques(vpColVector &angle, // definitions des angles theta
  {
    double theta = M_PI/180*angle[i_theta]; // indice i -> theta(i) en radians
    																//  angle[] dans [0,180[
-   double cos_theta = cos(theta);        // vecteur directeur de l'ECM
-   double sin_theta = sin(theta);        //  associe au masque
+   double cos_theta = vpMath::fastCos(theta);  // vecteur directeur de l'ECM
+   double sin_theta = vpMath::fastSin(theta);  //  associe au masque
 
    // PRE-CALCULE 2 POINTS DE D(theta) BIEN EN DEHORS DU MASQUE
    // =========================================================
@@ -401,7 +401,9 @@ vpMe::print( )
 }
 
 vpMe::vpMe()
-  : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0),
+  : threshold(1500), m_adaptiveThreshold(false), m_adaptiveRatio(0.5), m_adaptiveGain(0.05),
+    m_coarseToFine(false), m_coarseToFineStep(4), m_distortionLut(NULL),
+    mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0),
     range(4), sample_step(10), ntotal_sample(0), points_to_track(500), mask_size(5),
     n_mask(180), strip(2), mask(NULL)
 {
@@ -413,7 +415,9 @@ vpMe::vpMe()
 }
 
 vpMe::vpMe(const vpMe &me)
-  : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0),
+  : threshold(1500), m_adaptiveThreshold(false), m_adaptiveRatio(0.5), m_adaptiveGain(0.05),
+    m_coarseToFine(false), m_coarseToFineStep(4), m_distortionLut(NULL),
+    mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0),
     range(4), sample_step(10), ntotal_sample(0), points_to_track(500), mask_size(5),
     n_mask(180), strip(2), mask(NULL)
 {
@@ -428,6 +432,12 @@ vpMe& vpMe::operator=(const vpMe &me)
     mask = NULL ; 
   }
   threshold = me.threshold ;
+  m_adaptiveThreshold = me.m_adaptiveThreshold ;
+  m_adaptiveRatio = me.m_adaptiveRatio ;
+  m_adaptiveGain = me.m_adaptiveGain ;
+  m_coarseToFine = me.m_coarseToFine ;
+  m_coarseToFineStep = me.m_coarseToFineStep ;
+  m_distortionLut = me.m_distortionLut ;
   mu1 = me.mu1 ;
   mu2 = me.mu2 ;
   min_samplestep = me.min_samplestep ;
@@ -320,29 +320,32 @@ vpMeNurbs::sample(const vpImage<unsigned char>& I)
   // Delete old list
   list.clear();
 
-  vpImagePoint ip;
-  double u = 0.0;
-  vpImagePoint *pt = NULL;
+  // All the curve points and tangents are evaluated in one batch; the basis
+  // values are reused by vpNurbs as long as the knot vector is unchanged
+  std::vector<double> u_vals;
+  for (double u = 0.0; u <= 1.0; u += step)
+    u_vals.push_back(u);
+
+  std::vector<vpImagePoint> ders;
+  nurbs.computeCurveDersPoints(u_vals, 1, ders);
+
   vpImagePoint pt_1(-rows,-cols);
-  while (u <= 1.0)
+  for (size_t s = 0; s < u_vals.size(); s++)
   {
-    if (pt!=NULL) delete[] pt;
-    pt = nurbs.computeCurveDersPoint(u, 1);
-    double delta = computeDelta(pt[1].get_i(),pt[1].get_j());
+    const vpImagePoint &pt = ders[2*s];
+    double delta = computeDelta(ders[2*s+1].get_i(), ders[2*s+1].get_j());
 
     // If point is in the image, add to the sample list
-    if(!outOfImage(pt[0], 0, rows, cols) && vpImagePoint::sqrDistance(pt[0],pt_1) >= vpMath::sqr(me->getSampleStep()))
+    if(!outOfImage(pt, 0, rows, cols) && vpImagePoint::sqrDistance(pt,pt_1) >= vpMath::sqr(me->getSampleStep()))
     {
       vpMeSite pix ; //= list.value();
-      pix.init(pt[0].get_i(), pt[0].get_j(), delta) ;
+      pix.init(pt.get_i(), pt.get_j(), delta) ;
       pix.setDisplay(selectDisplay) ;
 
       list.push_back(pix);
-      pt_1 = pt[0];
+      pt_1 = pt;
     }
-    u = u+step;
   }
-  if (pt!=NULL) delete[] pt;
 }
 
 
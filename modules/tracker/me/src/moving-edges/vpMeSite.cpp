@@ -46,6 +46,7 @@
 
 #include <visp3/me/vpMeSite.h>
 #include <visp3/me/vpMe.h>
+#include <visp3/core/vpMath.h>
 #include <visp3/core/vpTrackingException.h>
 #include <stdlib.h>
 #include <cmath>    // std::fabs
@@ -97,7 +98,7 @@ vpMeSite::init()
 
 vpMeSite::vpMeSite()
   : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), mask_sign(1), alpha(0.),
-    convlt(0.), normGradient(0), weight(1), selectDisplay(NONE), state(NO_SUPPRESSION)
+    convlt(0.), normGradient(0), weight(1), m_thresholdOverride(-1.), selectDisplay(NONE), state(NO_SUPPRESSION)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , suppress(0)
 #endif
@@ -106,7 +107,7 @@ vpMeSite::vpMeSite()
 
 vpMeSite::vpMeSite(double ip, double jp)
   : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), mask_sign(1), alpha(0.),
-    convlt(0.), normGradient(0), weight(1), selectDisplay(NONE), state(NO_SUPPRESSION)
+    convlt(0.), normGradient(0), weight(1), m_thresholdOverride(-1.), selectDisplay(NONE), state(NO_SUPPRESSION)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , suppress(0)
 #endif
@@ -122,7 +123,7 @@ vpMeSite::vpMeSite(double ip, double jp)
 */
 vpMeSite::vpMeSite (const vpMeSite &mesite)
   : i(0), j(0), i_1(0), j_1(0), ifloat(0), jfloat(0), v(0), mask_sign(1), alpha(0.),
-    convlt(0.), normGradient(0), weight(1), selectDisplay(NONE), state(NO_SUPPRESSION)
+    convlt(0.), normGradient(0), weight(1), m_thresholdOverride(-1.), selectDisplay(NONE), state(NO_SUPPRESSION)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , suppress(0)
 #endif
@@ -200,6 +201,7 @@ vpMeSite &vpMeSite::operator=(const vpMeSite &m)
   convlt = m.convlt;
   normGradient = m.normGradient;
   weight = m.weight;
+  m_thresholdOverride = m.m_thresholdOverride;
   selectDisplay = m.selectDisplay;
   state = m.state;
   
@@ -238,8 +240,8 @@ vpMeSite::getQueryList(const vpImage<unsigned char> &I, const int range)
   // range : +/- the range within which the pixel's
   //correspondent will be sought
 
-  double salpha = sin(alpha);
-  double calpha = cos(alpha);
+  double salpha = vpMath::fastSin(alpha);
+  double calpha = vpMath::fastCos(alpha);
   n = 0 ;
   vpImagePoint ip;
 	
@@ -284,8 +286,8 @@ vpMeSite::getSign(const vpImage<unsigned char> &I, const int range)
 
   int   k ;
 
-  double salpha = sin(alpha);
-  double calpha = cos(alpha);
+  double salpha = vpMath::fastSin(alpha);
+  double calpha = vpMath::fastCos(alpha);
 
 	//First extremity
   k = -range ;
@@ -314,7 +316,19 @@ vpMeSite::convolution(const vpImage<unsigned char>&I, const  vpMe *me)
   unsigned int msize = me->getMaskSize();
   half = (static_cast<int>(msize) - 1) >> 1 ;
 
-  if(horsImage( i , j , half + me->getStrip() , height_, width_))
+  // The site lives in undistorted coordinates; with a distortion table
+  // the mask is read around its position in the raw image instead. The
+  // mask neighborhood itself stays rigid : the distortion is smooth at
+  // the scale of the mask.
+  int i_read = i, j_read = j;
+  if (me->getDistortionLut() != NULL) {
+    double ud, vd;
+    me->getDistortionLut()->distort((double)j, (double)i, ud, vd);
+    i_read = vpMath::round(vd);
+    j_read = vpMath::round(ud);
+  }
+
+  if(horsImage( i_read , j_read , half + me->getStrip() , height_, width_))
   {
     conv = 0.0 ;
     i = 0 ; j = 0 ;
@@ -338,21 +352,24 @@ vpMeSite::convolution(const vpImage<unsigned char>&I, const  vpMe *me)
 
     unsigned int index_mask = (unsigned int)(thetadeg/(double)me->getAngleStep());
 
-    unsigned int i_ = static_cast<unsigned int>(i);
-    unsigned int j_ = static_cast<unsigned int>(j);
+    unsigned int i_ = static_cast<unsigned int>(i_read);
+    unsigned int j_ = static_cast<unsigned int>(j_read);
     unsigned int half_ = static_cast<unsigned int>(half);
 
     unsigned int ihalf = i_-half_ ;
     unsigned int jhalf = j_-half_ ;
 
+    // Hoist the oriented mask of the bank and use row pointers so that
+    // the correlation streams over contiguous mask and image rows,
+    // without re-resolving the bank and the row tables per pixel
+    const vpMatrix &m = me->getMask()[index_mask];
     for(unsigned int a = 0 ; a < msize ; a++ )
     {
-      unsigned int ihalfa = ihalf+a ;
+      const double *mask_row = m[a];
+      const unsigned char *I_row = &I[ihalf+a][jhalf];
       for(unsigned int b = 0 ; b < msize ; b++ )
       {
-        conv += mask_sign* me->getMask()[index_mask][a][b] *
-            //	  I(i-half+a,j-half+b) ;
-            I(ihalfa,jhalf+b) ;
+        conv += mask_sign* mask_row[b] * I_row[b] ;
       }
     }
 
@@ -526,12 +543,54 @@ vpMeSite::track(const vpImage<unsigned char>& I,
   i_1 = i ;
   j_1 = j ;
   double threshold;
-  threshold = me->getThreshold() ;
+  //The adaptive mode sets a per-site threshold; negative means the
+  //configured fixed one
+  threshold = m_thresholdOverride >= 0. ? m_thresholdOverride : me->getThreshold() ;
   double diff = 1e6;
 
+  unsigned int nbPositions = 2 * range + 1;
+
+  //Coarse-to-fine query : sample every Kth position first, then refine
+  //around the strongest coarse response. K follows the width of the
+  //mask response (the convolution of an edge spans the mask support, so
+  //sampling within half of it cannot step over a peak) and the mode
+  //only engages when the range is large enough to save evaluations.
+  unsigned int coarseStep = 1;
+  if (me->getCoarseToFineQuery()) {
+    coarseStep = me->getMaskSize() / 2;
+    if (coarseStep > me->getCoarseToFineQueryStep())
+      coarseStep = me->getCoarseToFineQueryStep();
+    if (coarseStep < 2 || nbPositions < 4 * coarseStep)
+      coarseStep = 1;
+  }
+
+  for (unsigned int n = 0; n < nbPositions; n++)
+    likelihood[n] = -1.; //marks the position as not evaluated yet
+
+  int bestCoarseRank = -1;
+  double bestCoarseValue = -1.;
+  unsigned int nbPasses = (coarseStep > 1) ? 2u : 1u;
+
   //    std::cout <<"---------------------"<<std::endl ;
-  for(unsigned int n = 0 ; n < 2 * range + 1 ; n++)
+  for(unsigned int pass = 0 ; pass < nbPasses ; pass++)
+  {
+  unsigned int nFirst = 0, nLast = nbPositions - 1, nStep = 1;
+  if (coarseStep > 1) {
+    if (pass == 0)
+      nStep = coarseStep;
+    else {
+      //Refine around the strongest coarse response, whether or not it
+      //passed the selection rules : the true peak lies within a step
+      nFirst = ((unsigned int)bestCoarseRank >= coarseStep) ? (unsigned int)bestCoarseRank - (coarseStep - 1) : 0;
+      nLast = (unsigned int)bestCoarseRank + (coarseStep - 1);
+      if (nLast > nbPositions - 1) nLast = nbPositions - 1;
+    }
+  }
+  for(unsigned int n = nFirst ; n <= nLast ; n += nStep)
   {
+    if (likelihood[n] >= 0.)
+      continue; //already evaluated by the coarse pass
+
     //   convolution results
     double convolution_ = list_query_pixels[n].convolution(I, me) ;
 
@@ -568,8 +627,15 @@ vpMeSite::track(const vpImage<unsigned char>& I,
         //           max_rank1 = max_rank;
       }
     }
+
+    if (pass == 0 && coarseStep > 1 && likelihood[n] > bestCoarseValue)
+    {
+      bestCoarseValue = likelihood[n];
+      bestCoarseRank = (int)n;
+    }
   }
-  
+  }
+
   // test on the likelihood threshold if threshold==-1 then
   // the me->threshold is  selected
 
@@ -0,0 +1,85 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Structure of arrays storage for the moving-edge sites.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <visp3/me/vpMeSiteSoA.h>
+
+/*!
+  Snapshot the site list in the dense arrays and in the contiguous site
+  records. The buffers are reused between the calls so that a per-frame
+  snapshot performs no allocation once warmed up.
+
+  \param list : Sites to snapshot.
+*/
+void vpMeSiteSoA::fromList(const std::list<vpMeSite> &list)
+{
+  size_t n = list.size();
+  m_ifloat.resize(n);
+  m_jfloat.resize(n);
+  m_alpha.resize(n);
+  m_convlt.resize(n);
+  m_weight.resize(n);
+  m_state.resize(n);
+  m_sites.resize(n);
+
+  size_t k = 0;
+  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it, k++) {
+    const vpMeSite &s = *it;
+    m_ifloat[k] = s.ifloat;
+    m_jfloat[k] = s.jfloat;
+    m_alpha[k] = s.alpha;
+    m_convlt[k] = s.convlt;
+    m_weight[k] = s.weight;
+    m_state[k] = (int)s.getState();
+    m_sites[k] = s;
+  }
+}
+
+/*!
+  Write the contiguous site records back in the list, which must have
+  the size of the snapshot; the dense arrays are not read back since the
+  site records are the reference.
+
+  \param list : List receiving the sites.
+*/
+void vpMeSiteSoA::toList(std::list<vpMeSite> &list) const
+{
+  size_t k = 0;
+  for (std::list<vpMeSite>::iterator it = list.begin();
+       it != list.end() && k < m_sites.size(); ++it, k++) {
+    *it = m_sites[k];
+  }
+}
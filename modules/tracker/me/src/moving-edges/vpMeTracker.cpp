@@ -43,6 +43,8 @@
 
 
 #include <visp3/me/vpMeTracker.h>
+#include <visp3/core/vpProfiler.h>
+#include <visp3/core/vpTrackerTelemetry.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpColor.h>
 
@@ -62,7 +64,8 @@ vpMeTracker::init()
 }
 
 vpMeTracker::vpMeTracker()
-  : list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE)
+  : list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE),
+    m_siteBuffer(), m_adaptiveContrastEwma(0.), m_adaptiveEwmaValid(false), m_telemetry(NULL), m_telemetryFrame(0), m_dataLatency(), m_telemetryDataAge(-1.)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
   , query_range (0), display_point(false)
 #endif
@@ -72,7 +75,8 @@ vpMeTracker::vpMeTracker()
 
 vpMeTracker::vpMeTracker(const vpMeTracker& meTracker)
   : vpTracker(meTracker),
-    list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE)
+    list(), me(NULL), init_range(1), nGoodElement(0), selectDisplay(vpMeSite::NONE),
+    m_siteBuffer(), m_adaptiveContrastEwma(0.), m_adaptiveEwmaValid(false), m_telemetry(NULL), m_telemetryFrame(0), m_dataLatency(), m_telemetryDataAge(-1.)
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     , query_range (0), display_point(false)
 #endif
@@ -253,6 +257,12 @@ vpMeTracker::initTracking(const vpImage<unsigned char>& I)
 void
 vpMeTracker::track(const vpImage<unsigned char>& I)
 {
+  VP_PROFILE_SCOPE("me.track");
+  m_telemetryDataAge = -1.;
+  if (I.getTimestamp() >= 0.) { // age of the frame handed by the grabber
+    m_telemetryDataAge = vpTime::measureTimeMs() - I.getTimestamp();
+    m_dataLatency.record(m_telemetryDataAge);
+  }
   if (!me) {
     vpDERROR_TRACE(2, "Tracking error: Moving edges not initialized");
     throw(vpTrackingException(vpTrackingException::initializationError,
@@ -267,8 +277,62 @@ vpMeTracker::track(const vpImage<unsigned char>& I)
 
   }
 
+  //Apply the adaptive likelihood threshold learned on the previous frames
+  //before tracking : the resampling of the derived trackers recreates
+  //sites, so the override has to be refreshed each frame
+  if (me->getAdaptiveThreshold() && m_adaptiveEwmaValid) {
+    double adaptedThreshold = me->getAdaptiveThresholdRatio() * m_adaptiveContrastEwma;
+    for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it)
+      it->setThresholdOverride(adaptedThreshold);
+  }
+
   vpImagePoint ip1, ip2;
   nGoodElement=0;
+
+#ifdef VISP_HAVE_OPENMP
+  // The sites are independent: they are tracked concurrently when no
+  // per-site display is requested, since the display calls performed by
+  // vpMeSite::track() are not thread safe. The parameters in me are only
+  // read during the site tracking.
+  if (selectDisplay == vpMeSite::NONE && list.size() > 1) {
+    // Snapshot the non suppressed sites in a contiguous reusable buffer:
+    // the tracking pass then streams through dense records instead of
+    // pointer-chasing the scattered list nodes
+    m_siteBuffer.clear();
+    m_siteBuffer.reserve(list.size());
+    std::vector<std::list<vpMeSite>::iterator> site_nodes;
+    site_nodes.reserve(list.size());
+    for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it) {
+      if (it->getState() == vpMeSite::NO_SUPPRESSION) {
+        m_siteBuffer.push_back(*it);
+        site_nodes.push_back(it);
+      }
+    }
+
+    int nb_sites = (int)m_siteBuffer.size();
+#pragma omp parallel for schedule(dynamic, 8)
+    for (int k = 0; k < nb_sites; k++) {
+      vpMeSite &s = m_siteBuffer[(size_t)k]; //current reference pixel
+      try {
+        s.track(I,me,true);
+      }
+      catch(vpTrackingException)
+      {
+        vpERROR_TRACE("catch exception ") ;
+        s.setState(vpMeSite::THRESHOLD);
+      }
+    }
+
+    for (int k = 0; k < nb_sites; k++) {
+      if (m_siteBuffer[(size_t)k].getState() != vpMeSite::THRESHOLD)
+        nGoodElement++;
+      *site_nodes[(size_t)k] = m_siteBuffer[(size_t)k];
+    }
+    publishTelemetry();
+    return;
+  }
+#endif
+
   //  int d =0;
   // Loop through list of sites to track
   for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
@@ -313,6 +377,73 @@ vpMeTracker::track(const vpImage<unsigned char>& I)
       *it = s;
     }
   }
+
+  publishTelemetry();
+  //Adaptive likelihood threshold : follow the lighting with a running
+  //average of the accepted site contrasts, no extra image pass needed
+  if (me->getAdaptiveThreshold()) {
+    double sum = 0.;
+    unsigned int nbGood = 0;
+    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+      if (it->getState() == vpMeSite::NO_SUPPRESSION) {
+        sum += fabs(2 * it->convlt);
+        nbGood++;
+      }
+    }
+    if (nbGood > 0) {
+      double meanContrast = sum / nbGood;
+      double gain = me->getAdaptiveThresholdGain();
+      if (m_adaptiveEwmaValid)
+        m_adaptiveContrastEwma = (1. - gain) * m_adaptiveContrastEwma + gain * meanContrast;
+      else {
+        m_adaptiveContrastEwma = meanContrast;
+        m_adaptiveEwmaValid = true;
+      }
+    }
+  }
+
+}
+
+/*!
+  Publish the per-frame diagnostics record of the tracker (site count and
+  good site ratio) into the telemetry buffer, if one is attached.
+*/
+void
+vpMeTracker::publishTelemetry()
+{
+  if (m_telemetry != NULL) {
+    vpTrackerTelemetry::vpRecord record;
+    record.frame = m_telemetryFrame++;
+    record.nbFeatures = (unsigned int)list.size();
+    record.meanWeight = list.empty() ? 1. : (double)nGoodElement / (double)list.size();
+    record.dataAgeMs = m_telemetryDataAge;
+    m_telemetry->publish(record);
+  }
+}
+
+/*!
+  Shift every moving-edge site by a predicted image displacement. Called
+  before track() with a displacement coming from a motion predictor, the
+  search starts from the predicted location of the contour, which allows
+  to reduce the search range set with vpMe::setRange() for an equal
+  robustness to fast motion.
+
+  \param di : Predicted displacement along the i axis, in pixels.
+  \param dj : Predicted displacement along the j axis, in pixels.
+*/
+void
+vpMeTracker::seedDisplacement(double di, double dj)
+{
+  for(std::list<vpMeSite>::iterator it=list.begin(); it!=list.end(); ++it){
+    vpMeSite &s = *it;
+    if (s.getState() == vpMeSite::NO_SUPPRESSION) {
+      s.ifloat += di;
+      s.jfloat += dj;
+      s.i = vpMath::round(s.ifloat);
+      s.j = vpMath::round(s.jfloat);
+    }
+  }
+
 }
 
 /*!
@@ -336,10 +467,19 @@ vpMeTracker::display(const vpImage<unsigned char>& I)
     std::cout<<" There are "<<list.size()<< " sites in the list " << std::endl ;
   }
 #endif
-  for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
-    vpMeSite p_me = *it;
-    p_me.display(I);
+  //One backend submission for the whole site list
+  vpDisplay::beginOverlayBatch(I);
+  try {
+    for(std::list<vpMeSite>::const_iterator it=list.begin(); it!=list.end(); ++it){
+      vpMeSite p_me = *it;
+      p_me.display(I);
+    }
+  }
+  catch(...) {
+    vpDisplay::endOverlayBatch(I);
+    throw;
   }
+  vpDisplay::endOverlayBatch(I);
 }
 
 /*! Displays the status of moving edge sites
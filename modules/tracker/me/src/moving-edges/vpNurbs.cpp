@@ -60,7 +60,8 @@ inline double distance(const vpImagePoint &iP1, const double w1, const vpImagePo
   compute cubic NURBS.
 */
 vpNurbs::vpNurbs()
-  : weights()
+  : weights(), m_basisCacheU(), m_basisCacheKnots(), m_basisCacheSpans(),
+    m_basisCacheValues(), m_basisCacheDer(0)
 {
   p = 3;
 }
@@ -68,7 +69,9 @@ vpNurbs::vpNurbs()
 /*!
   Copy constructor.
 */
-vpNurbs::vpNurbs(const vpNurbs &nurbs)  : vpBSpline(nurbs), weights()
+vpNurbs::vpNurbs(const vpNurbs &nurbs)
+  : vpBSpline(nurbs), weights(), m_basisCacheU(), m_basisCacheKnots(),
+    m_basisCacheSpans(), m_basisCacheValues(), m_basisCacheDer(0)
 {
   weights = nurbs.weights;
 }
@@ -316,6 +319,191 @@ vpImagePoint* vpNurbs::computeCurveDersPoint(double u, unsigned int der)
 }
 
 
+/*!
+  Compute the nonzero basis functions and their derivatives at \f$ l_u \f$
+  iteratively into a caller provided buffer, without any allocation. Flat
+  equivalent of vpBSpline::computeDersBasisFuns() used by the batched curve
+  evaluation.
+
+  \param l_u : A real number which is between the extremities of the knot vector.
+  \param l_i : The number of the knot interval in which \f$ l_u \f$ lies.
+  \param l_p : Degree of the basis functions.
+  \param l_der : The last derivative to be computed.
+  \param l_knots : The knot vector.
+  \param ders : Output buffer of size (l_der+1)x(l_p+1), row k holding the kth derivatives.
+  \param ndu, a, left, right : Workspaces of respective sizes (l_p+1)^2, 2(l_p+1), l_p+1 and l_p+1.
+*/
+static void computeDersBasisFunsFlat(double l_u, unsigned int l_i, unsigned int l_p, unsigned int l_der,
+                                     const std::vector<double> &l_knots, double *ders,
+                                     double *ndu, double *a, double *left, double *right)
+{
+  const unsigned int w = l_p+1;
+  ndu[0] = 1.0;
+
+  for(unsigned int j = 1; j <= l_p; j++)
+  {
+    left[j] = l_u - l_knots[l_i+1-j];
+    right[j] = l_knots[l_i+j] - l_u;
+    double saved = 0.0;
+
+    for (unsigned int r = 0; r < j; r++)
+    {
+      ndu[j*w+r] = right[r+1]+left[j-r];
+      double temp = ndu[r*w+j-1]/ndu[j*w+r];
+      ndu[r*w+j] = saved + right[r+1]*temp;
+      saved = left[j-r]*temp;
+    }
+    ndu[j*w+j] = saved;
+  }
+
+  for(unsigned int j = 0; j <= l_p; j++)
+    ders[j] = ndu[j*w+l_p];
+
+  for (unsigned int r = 0; r <= l_p; r++)
+  {
+    unsigned int s1 = 0;
+    unsigned int s2 = 1;
+    a[0] = 1.0;
+    for(unsigned int k = 1; k <= l_der; k++)
+    {
+      double d = 0.0;
+      int rk = (int)(r-k);
+      unsigned int pk = l_p-k;
+      unsigned int j1,j2;
+      if(r >= k)
+      {
+        a[s2*w] = a[s1*w]/ndu[(pk+1)*w+rk];
+        d = a[s2*w]*ndu[(unsigned int)rk*w+pk];
+      }
+
+      if(rk >= -1)
+        j1 = 1;
+      else
+        j1 = (unsigned int)(-rk);
+
+      if(r-1 <= pk)
+        j2 = k-1;
+      else
+        j2 = l_p-r;
+
+      for(unsigned int j = j1; j <= j2; j++)
+      {
+        a[s2*w+j] = (a[s1*w+j]-a[s1*w+j-1])/ndu[(pk+1)*w+(unsigned int)rk+j];
+        d += a[s2*w+j]*ndu[((unsigned int)rk+j)*w+pk];
+      }
+
+      if(r <= pk)
+      {
+        a[s2*w+k] = -a[s1*w+k-1]/ndu[(pk+1)*w+r];
+        d += a[s2*w+k]*ndu[r*w+pk];
+      }
+      ders[k*w+r] = d;
+
+      s1 = (s1+1)%2;
+      s2 = (s2+1)%2;
+    }
+  }
+
+  double f = l_p;
+  for ( unsigned int k = 1; k <= l_der; k++ )
+  {
+    for (unsigned int j = 0; j <= l_p; j++)
+       ders[k*w+j] *= f;
+    f *= (l_p-k);
+  }
+}
+
+/*!
+  Compute the curve points and their derivatives until the \f$ der \f$ th
+  derivative for a whole batch of parameters in one pass: the weighted
+  control points are hoisted out of the per sample loop, the basis functions
+  are evaluated iteratively without any per sample allocation, and their
+  values are cached and reused as long as the knot vector and the sampling
+  grid are unchanged (typical when a static curve is resampled every frame).
+
+  \param u : The batch of parameters, each between the extremities of the knot vector.
+  \param der : The last derivative to be computed.
+  \param dersPoints : Resulting coordinates, resized to u.size()x(der+1):
+  dersPoints[s*(der+1)+k] contains \f$ C^{(k)}(u[s]) \f$.
+*/
+void vpNurbs::computeCurveDersPoints(const std::vector<double> &u, unsigned int der, std::vector<vpImagePoint> &dersPoints)
+{
+  size_t nb = u.size();
+  dersPoints.resize(nb*(der+1));
+  if (nb == 0)
+    return;
+
+  const unsigned int w = p+1;
+  const unsigned int nbBasis = (der+1)*w;
+
+  if (m_basisCacheDer != der || m_basisCacheValues.size() != nb*nbBasis ||
+      m_basisCacheU != u || m_basisCacheKnots != knots)
+  {
+    m_basisCacheSpans.resize(nb);
+    m_basisCacheValues.resize(nb*nbBasis);
+
+    std::vector<double> ndu(w*w), a(2*w), left(w), right(w);
+    for (size_t s = 0; s < nb; s++)
+    {
+      unsigned int span = findSpan(u[s]);
+      m_basisCacheSpans[s] = span;
+      computeDersBasisFunsFlat(u[s], span, p, der, knots, &m_basisCacheValues[s*nbBasis],
+                               &ndu[0], &a[0], &left[0], &right[0]);
+    }
+
+    m_basisCacheU = u;
+    m_basisCacheKnots = knots;
+    m_basisCacheDer = der;
+  }
+
+  // Weighted control points in SoA form, hoisted out of the sample loop
+  size_t n = controlPoints.size();
+  std::vector<double> Awi(n), Awj(n);
+  for (size_t j = 0; j < n; j++)
+  {
+    Awi[j] = controlPoints[j].get_i() * weights[j];
+    Awj[j] = controlPoints[j].get_j() * weights[j];
+  }
+
+  std::vector<double> dersI(der+1), dersJ(der+1), dersW(der+1);
+  for (size_t s = 0; s < nb; s++)
+  {
+    const unsigned int span = m_basisCacheSpans[s];
+    const double *basis = &m_basisCacheValues[s*nbBasis];
+
+    for (unsigned int k = 0; k <= der; k++)
+    {
+      double ic = 0, jc = 0, wc = 0;
+      for (unsigned int j = 0; j <= p; j++)
+      {
+        double b = basis[k*w+j];
+        unsigned int idx = span-p+j;
+        ic += b * Awi[idx];
+        jc += b * Awj[idx];
+        wc += b * weights[idx];
+      }
+      dersI[k] = ic;
+      dersJ[k] = jc;
+      dersW[k] = wc;
+    }
+
+    // Rational derivatives, see the Nurbs book
+    vpImagePoint *CK = &dersPoints[s*(der+1)];
+    for (unsigned int k = 0; k <= der; k++)
+    {
+      double ic = dersI[k];
+      double jc = dersJ[k];
+      for (unsigned int j = 1; j <= k; j++)
+      {
+        double tmpComb = static_cast<double>( vpMath::comb(k,j) );
+        ic = ic - tmpComb*dersW[j]*(CK[k-j].get_i());
+        jc = jc - tmpComb*dersW[j]*(CK[k-j].get_j());
+      }
+      CK[k].set_ij(ic/dersW[0], jc/dersW[0]);
+    }
+  }
+}
+
 /*!
   Insert \f$ l_r \f$ times a knot in the \f$ l_k \f$ th interval of the knot vector. The inserted knot \f$ l_u \f$ has multiplicity \f$ l_s \f$.
   
@@ -114,6 +114,18 @@ class VISP_EXPORT vpTemplateTracker
     unsigned int                iterationMax ;
     //pour BFGS
     unsigned int                iterationGlobale;
+    //! Total iteration budget of one track() call, 0 when disabled.
+    unsigned int                iterationBudget;
+    //! Iterations spent by the last track() call, all levels included.
+    unsigned int                iterationSpent;
+    //! When true the per-point image-derived tables are packed in single precision.
+    bool                        m_floatCompute;
+    //! When true the warp parameters are extrapolated before each track() call.
+    bool                        warmStart;
+    //! True once two frames were tracked since the warm start was enabled.
+    bool                        warmStartReady;
+    //! Warp parameters estimated on the frame before the previous one.
+    vpColVector                 p_prev;
     //diverge is set to true if there is no more point in the tracked area
     bool                        diverge;
     unsigned int                nbIteration;
@@ -171,7 +183,9 @@ class VISP_EXPORT vpTemplateTracker
         G(), gain(0), thresholdGradient(0), costFunctionVerification(false),
         blur(false), useBrent(false), nbIterBrent(0), taillef(0), fgG(NULL), fgdG(NULL),
         ratioPixelIn(0), mod_i(0), mod_j(0), nbParam(), lambdaDep(0), iterationMax(0),
-        iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(false),
+        iterationGlobale(0), iterationBudget(0), iterationSpent(0),
+        warmStart(false), warmStartReady(false), p_prev(),
+        diverge(false), nbIteration(0), useCompositionnal(false),
         useInverse(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
     {}
     vpTemplateTracker(vpTemplateTrackerWarp *_warp);
@@ -208,6 +222,17 @@ class VISP_EXPORT vpTemplateTracker
     
     void    setBlur(bool b){blur = b;}
     void    setCostFunctionVerification(bool b){costFunctionVerification = b;}
+    /*!
+      Run the per-point accumulations in single precision : the
+      image-derived tables (steepest descent images) are packed as a
+      contiguous float array, halving their memory traffic, while the
+      parameter updates and the Hessian inversions remain double. The
+      estimated warp is unchanged up to the float rounding of the
+      gradient accumulation. Honored by the SSD inverse compositional
+      tracker; the other trackers ignore the flag.
+      \param b : True to enable the single precision accumulation.
+     */
+    void    setFloatComputeEnabled(const bool &b) { m_floatCompute = b; }
     void    setGain(double g){gain=g;}
     void    setGaussianFilterSize(unsigned int new_taill);
     void    setHDes(vpMatrix &tH){ Hdesire=tH; vpMatrix::computeHLM(Hdesire,lambdaDep,HLMdesire); HLMdesireInverse = HLMdesire.inverseByLU();}
@@ -216,6 +241,28 @@ class VISP_EXPORT vpTemplateTracker
       \param n : Maximum number of iterations to stop the estimation scheme. A typical value is arround 100.
      */
     void    setIterationMax(const unsigned int &n) { iterationMax = n ; }
+    /*!
+      Set a total iteration budget for one track() call: across the
+      pyramid levels no more than \e budget optimization iterations are
+      spent, the remaining budget bounding each level after the coarser
+      ones consumed their share. A zero budget (default) disables the
+      bounding and only iterationMax applies per level.
+    */
+    void    setIterationBudget(const unsigned int &budget) { iterationBudget = budget ; }
+    //! Return the number of iterations spent by the last track() call,
+    //! all pyramid levels included.
+    unsigned int getIterationSpent() const { return iterationSpent; }
+    /*!
+      Enable the warm start of the estimation: assuming a constant
+      velocity, the warp parameters are extrapolated from the two last
+      estimates before each track() call so that the optimization starts
+      closer to the solution. An externally predicted state, for example
+      filtered with vpKalmanFilter, can rather be seeded with setp()
+      before calling track().
+      \param enable : True to extrapolate the warp parameters, false
+      (default) to start from the last estimate.
+    */
+    void    setWarmStart(bool enable) { warmStart = enable; warmStartReady = false; }
     /*!
       Set the convergence gain used in the estimation scheme.
       \param l : Gain. A typical value is 0.001.
@@ -45,6 +45,7 @@
 
 #include <vector>
 
+#include <visp3/core/vpArray2D.h>
 #include <visp3/tt/vpTemplateTrackerSSD.h>
 
 /*!
@@ -58,6 +59,12 @@ class VISP_EXPORT vpTemplateTrackerSSDInverseCompositional: public vpTemplateTra
     vpMatrix  HInv;
     vpMatrix  HCompInverse;
     bool      useTemplateSelect;//use only the strong gradient pixels to compute the Jabocian
+    //! Pyramid level table the packed copies below were built from, see setFloatComputeEnabled().
+    std::vector<const vpTemplateTrackerPoint *> m_HiGFloatSrc;
+    //! Packed single precision copies of the per-point HiG tables, one per pyramid level.
+    std::vector< vpArray2D<float> > m_HiGFloat;
+    //! Row of each template point in the packed copy, -1 when not selected.
+    std::vector< std::vector<int> > m_HiGFloatRow;
     //pour eval evolRMS
     double    evolRMS;
     std::vector<double> x_pos;
@@ -78,6 +85,9 @@ class VISP_EXPORT vpTemplateTrackerSSDInverseCompositional: public vpTemplateTra
     /*! Use only the strong gradient pixels to compute the Jabobian. By default this feature is disabled. */
     void  setUseTemplateSelect(bool b) {useTemplateSelect = b;}
     void  setThresholdRMS(double threshold){threshold_RMS=threshold;}
+
+    bool  saveCache(const std::string &filename) const;
+    bool  initFromCache(const std::string &filename, vpTemplateTrackerZone &zone);
 };
 #endif
 
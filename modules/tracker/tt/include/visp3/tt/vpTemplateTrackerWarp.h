@@ -202,6 +202,12 @@ class VISP_EXPORT vpTemplateTrackerWarp
     */
     virtual void warpX(const int &i, const int &j,double &i2,double &j2, const vpColVector &ParamM) = 0;
 
+    virtual void warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                            double *i2, double *j2, const vpColVector &ParamM);
+
+    virtual void warpXScanline(const int &i, const int &j0, unsigned int nb_pt,
+                               double *i2, double *j2, const vpColVector &ParamM);
+
     /*!
       Warp a point.
 
@@ -53,12 +53,36 @@
 */
 class VISP_EXPORT vpTemplateTrackerWarpAffine: public vpTemplateTrackerWarp
 {
+  protected:
+    //! True when the batch and scanline warps are evaluated in 16.16 fixed-point
+    bool useFixedPoint;
+
   public:
     //constructor;
     vpTemplateTrackerWarpAffine();
     
     #ifndef DOXYGEN_SHOULD_SKIP_THIS
     void computeCoeff(const vpColVector &/*p*/){}
+
+    /*!
+      Select the fixed-point (16.16) evaluation of the batch and scanline
+      warp entry points. The integer path trades the per-pixel double
+      precision products for integer multiplications (and two additions per
+      pixel on the scanline path), which is substantially faster on embedded
+      targets without fast double units. The warped coordinates keep a 1/65536
+      pixel resolution; template coordinates must stay below 4096 pixels.
+
+      \param b : True to evaluate the warp in fixed-point, false (default)
+      to keep the double precision path.
+    */
+    void setFixedPointEvaluation(const bool &b) { useFixedPoint = b; }
+
+    /*!
+      Tells if the fixed-point warp evaluation is selected.
+
+      \return True when the batch and scanline warps run in fixed-point.
+    */
+    bool getFixedPointEvaluation() const { return useFixedPoint; }
     void computeDenom(vpColVector &/*vX*/, const vpColVector &/*ParamM*/){}
     #endif
 
@@ -162,6 +186,8 @@ class VISP_EXPORT vpTemplateTrackerWarpAffine: public vpTemplateTrackerWarp
       \param ParamM : Parameters of the warping function.
     */
     void warpX(const int &i,const int &j,double &i2,double &j2,const vpColVector &ParamM);
+    void warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                    double *i2, double *j2, const vpColVector &ParamM);
 
     /*!
       Inverse Warp a point.
@@ -171,5 +197,8 @@ class VISP_EXPORT vpTemplateTrackerWarpAffine: public vpTemplateTrackerWarp
       \param ParamM : Parameters of the warping function.
     */
     void warpXInv(const vpColVector &vX,vpColVector &vXres,const vpColVector &ParamM);
+
+    void warpXScanline(const int &i, const int &j0, unsigned int nb_pt,
+                       double *i2, double *j2, const vpColVector &ParamM);
 };
 #endif
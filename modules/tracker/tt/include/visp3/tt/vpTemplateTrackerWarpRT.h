@@ -162,6 +162,8 @@ public:
       \param ParamM : Parameters of the warping function.
     */
   void warpX(const int &i,const int &j,double &i2,double &j2,const vpColVector &ParamM);
+  void warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                  double *i2, double *j2, const vpColVector &ParamM);
 
   /*!
       Inverse Warp a point.
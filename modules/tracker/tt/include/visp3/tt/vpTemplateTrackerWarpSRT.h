@@ -53,12 +53,34 @@
 */
 class VISP_EXPORT vpTemplateTrackerWarpSRT: public vpTemplateTrackerWarp
 {
+  protected:
+    //! True when the batch and scanline warps are evaluated in 16.16 fixed-point
+    bool useFixedPoint;
+
   public:
     //constructor;
     vpTemplateTrackerWarpSRT();
     
     #ifndef DOXYGEN_SHOULD_SKIP_THIS
     void computeCoeff(const vpColVector &/*p*/){}
+
+    /*!
+      Select the fixed-point (16.16) evaluation of the batch and scanline
+      warp entry points, see
+      vpTemplateTrackerWarpAffine::setFixedPointEvaluation(). The
+      trigonometry of the rotation is evaluated once per batch in any case.
+
+      \param b : True to evaluate the warp in fixed-point, false (default)
+      to keep the double precision path.
+    */
+    void setFixedPointEvaluation(const bool &b) { useFixedPoint = b; }
+
+    /*!
+      Tells if the fixed-point warp evaluation is selected.
+
+      \return True when the batch and scanline warps run in fixed-point.
+    */
+    bool getFixedPointEvaluation() const { return useFixedPoint; }
     void computeDenom(vpColVector &/*vX*/, const vpColVector &/*ParamM*/){}
     #endif
 
@@ -162,6 +184,8 @@ class VISP_EXPORT vpTemplateTrackerWarpSRT: public vpTemplateTrackerWarp
       \param ParamM : Parameters of the warping function.
     */
     void warpX(const int &i,const int &j,double &i2,double &j2,const vpColVector &ParamM);
+    void warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                    double *i2, double *j2, const vpColVector &ParamM);
 
     /*!
       Inverse Warp a point.
@@ -171,5 +195,8 @@ class VISP_EXPORT vpTemplateTrackerWarpSRT: public vpTemplateTrackerWarp
       \param ParamM : Parameters of the warping function.
     */
     void warpXInv(const vpColVector &vX,vpColVector &vXres,const vpColVector &ParamM);
+
+    void warpXScanline(const int &i, const int &j0, unsigned int nb_pt,
+                       double *i2, double *j2, const vpColVector &ParamM);
 };
 #endif
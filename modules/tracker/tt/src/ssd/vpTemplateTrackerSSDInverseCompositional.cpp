@@ -41,6 +41,7 @@
 
 vpTemplateTrackerSSDInverseCompositional::vpTemplateTrackerSSDInverseCompositional(vpTemplateTrackerWarp *warp)
   : vpTemplateTrackerSSD(warp), compoInitialised(false), HInv(), HCompInverse(), useTemplateSelect(false),
+    m_HiGFloatSrc(), m_HiGFloat(), m_HiGFloatRow(),
     evolRMS(0), x_pos(), y_pos(), threshold_RMS(1e-8)
 {
   useInverse=true;
@@ -98,6 +99,9 @@ void vpTemplateTrackerSSDInverseCompositional::initCompInverse(const vpImage<uns
         ptTemplate[point].HiG[it]=HiGtemp[it];
     }
   }
+  m_HiGFloatSrc.clear(); // the packed single precision copies are stale
+  m_HiGFloat.clear();
+  m_HiGFloatRow.clear();
   compoInitialised=true;
 }
 
@@ -112,49 +116,159 @@ void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned
     vpImageFilter::filter(I, BI,fgG,taillef);
 
   vpColVector dpinv(nbParam);
-  double IW;
-  double Tij;
   unsigned int iteration=0;
   int i,j;
-  double i2,j2;
   double alpha=2.;
   //vpTemplateTrackerPointtest *pt;
   initPosEvalRMS(p);
 
   vpTemplateTrackerPoint *pt;
+
+  // Selected template point indices and their warped coordinates; the
+  // warp pass stays sequential since some warps cache per-point state
+  // (computeDenom), the accumulation pass is spread over the threads
+  std::vector<unsigned int> selected_points;
+  selected_points.reserve(templateSize);
+  for(unsigned int point=0;point<templateSize;point++)
+  {
+    if((!useTemplateSelect)||(ptTemplateSelect[point]))
+      selected_points.push_back(point);
+  }
+  std::vector<double> warped_i(selected_points.size());
+  std::vector<double> warped_j(selected_points.size());
+  std::vector<double> inside_i, inside_j, inside_val;
+  std::vector<unsigned int> inside_pts;
+  inside_i.reserve(selected_points.size());
+  inside_j.reserve(selected_points.size());
+  inside_val.reserve(selected_points.size());
+  inside_pts.reserve(selected_points.size());
+
   do
   {
     unsigned int Nbpoint=0;
     double erreur=0;
     dp=0;
     Warp->computeCoeff(p);
-    for(unsigned int point=0;point<templateSize;point++)
+
+    for(size_t k=0;k<selected_points.size();k++)
+    {
+      pt=&ptTemplate[selected_points[k]];
+      i=pt->y;
+      j=pt->x;
+      X1[0]=j;X1[1]=i;
+      Warp->computeDenom(X1,p);
+      Warp->warpX(X1,X2,p);
+      warped_j[k]=X2[0];warped_i[k]=X2[1];
+    }
+
+    // The subpixel fetches of all the inside points are performed in one
+    // batch through the shared core primitive: one range pre-validation
+    // replaces the bounds checks of the per point vpImage::getValue() calls
+    inside_i.clear(); inside_j.clear(); inside_pts.clear();
+    for(size_t k=0;k<selected_points.size();k++)
     {
-      if((!useTemplateSelect)||(ptTemplateSelect[point]))
+      double i2_=warped_i[k], j2_=warped_j[k];
+      if((i2_>=0)&&(j2_>=0)&&(i2_<I.getHeight()-1)&&(j2_<I.getWidth()-1))
       {
-        //pt=&ptTemplatetest[point];
-        pt=&ptTemplate[point];
-        i=pt->y;
-        j=pt->x;
-        X1[0]=j;X1[1]=i;
-        Warp->computeDenom(X1,p);
-        Warp->warpX(X1,X2,p);
-        j2=X2[0];i2=X2[1];
-
-        if((i2>=0)&&(j2>=0)&&(i2<I.getHeight()-1)&&(j2<I.getWidth()-1))
+        inside_i.push_back(i2_);
+        inside_j.push_back(j2_);
+        inside_pts.push_back(selected_points[k]);
+      }
+    }
+    Nbpoint = (unsigned int)inside_pts.size();
+    inside_val.resize(inside_pts.size());
+    if(Nbpoint > 0)
+    {
+      if(!blur)
+        vpImageTools::getInterpolatedValues(I, &inside_i[0], &inside_j[0], &inside_val[0], Nbpoint);
+      else
+        vpImageTools::getInterpolatedValues(BI, &inside_i[0], &inside_j[0], &inside_val[0], Nbpoint);
+    }
+
+    // Single precision accumulation : the HiG tables of the current
+    // pyramid level are packed once as a contiguous float array, halving
+    // their memory traffic and ending the per-point pointer chase; the
+    // parameter update stays double. The copies are keyed by the level
+    // table trackPyr() swapped in, and dropped on any re-initialization.
+    int lvlCache = -1;
+    if (m_floatCompute)
+    {
+      for(size_t lc=0;lc<m_HiGFloatSrc.size();lc++)
+        if(m_HiGFloatSrc[lc] == ptTemplate)
+          lvlCache = (int)lc;
+      if (lvlCache < 0)
+      {
+        std::vector<int> rowOf(templateSize, -1);
+        int nbRows = 0;
+        for(unsigned int point=0;point<templateSize;point++)
+          if(ptTemplate[point].HiG != NULL)
+            rowOf[point] = nbRows++;
+        vpArray2D<float> packed((unsigned int)nbRows, nbParam);
+        for(unsigned int point=0;point<templateSize;point++)
+          if(rowOf[point] >= 0)
+            for(unsigned int it=0;it<nbParam;it++)
+              packed[(unsigned int)rowOf[point]][it] = (float)ptTemplate[point].HiG[it];
+        m_HiGFloatSrc.push_back(ptTemplate);
+        m_HiGFloat.push_back(packed);
+        m_HiGFloatRow.push_back(rowOf);
+        lvlCache = (int)m_HiGFloatSrc.size() - 1;
+      }
+    }
+    bool floatPath = (lvlCache >= 0);
+    const vpArray2D<float> *HiGFloat = floatPath ? &m_HiGFloat[(size_t)lvlCache] : NULL;
+    const std::vector<int> *HiGFloatRow = floatPath ? &m_HiGFloatRow[(size_t)lvlCache] : NULL;
+
+    int nb_inside = (int)inside_pts.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel
+#endif
+    {
+      vpColVector dp_loc(nbParam);
+      dp_loc = 0;
+      double erreur_loc = 0;
+
+      if (floatPath)
+      {
+        std::vector<float> dp_loc_f(nbParam, 0.f);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for nowait
+#endif
+        for (int k = 0; k < nb_inside; k++)
         {
-          Tij=pt->val;
-          if(!blur)
-            IW=I.getValue(i2,j2);
-          else
-            IW=BI.getValue(i2,j2);
-          Nbpoint++;
-          double er=(Tij-IW);
+          unsigned int point = inside_pts[(size_t)k];
+          const float *HiG_f = (*HiGFloat)[(unsigned int)(*HiGFloatRow)[point]];
+          float er=(float)(ptTemplate[point].val-inside_val[(size_t)k]);
           for(unsigned int it=0;it<nbParam;it++)
-            dp[it]+=er*pt->HiG[it];
+            dp_loc_f[it]+=er*HiG_f[it];
 
-          erreur+=er*er;
+          erreur_loc+=(double)er*er;
         }
+        for(unsigned int it=0;it<nbParam;it++)
+          dp_loc[it]=dp_loc_f[it];
+      }
+      else
+      {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for nowait
+#endif
+        for (int k = 0; k < nb_inside; k++)
+        {
+          const vpTemplateTrackerPoint *pt_ = &ptTemplate[inside_pts[(size_t)k]];
+          double er=(pt_->val-inside_val[(size_t)k]);
+          for(unsigned int it=0;it<nbParam;it++)
+            dp_loc[it]+=er*pt_->HiG[it];
+
+          erreur_loc+=er*er;
+        }
+      }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical
+#endif
+      {
+        for(unsigned int it=0;it<nbParam;it++)
+          dp[it]+=dp_loc[it];
+        erreur+=erreur_loc;
       }
     }
     //std::cout << "npoint: " << Nbpoint << std::endl;
@@ -235,3 +349,174 @@ void vpTemplateTrackerSSDInverseCompositional::computeEvalRMS(const vpColVector
 void vpTemplateTrackerSSDInverseCompositional::deletePosEvalRMS()
 {
 }
+
+// Magic number and version of the precomputation cache files
+#define VP_TT_IC_CACHE_MAGIC 0x54494343 // "TICC"
+#define VP_TT_IC_CACHE_VERSION 1
+
+/*!
+  Save in a binary cache file the per-template precomputation made by
+  initTracking(): the zone triangulation, the template points with their
+  gradients and steepest descent images. Re-arming a tracker on a known
+  template then goes through initFromCache() without recomputing the
+  Hessian and the gradient images.
+
+  Only the non pyramidal configuration can be cached.
+
+  \param filename : Cache file to write.
+  \return true on success, false if the file cannot be written or if the
+  tracker is not initialized or uses a pyramid.
+
+  \sa initFromCache()
+*/
+bool vpTemplateTrackerSSDInverseCompositional::saveCache(const std::string &filename) const
+{
+  if (!ptTemplateInit || templateSize == 0 || nbLvlPyr > 1 || zoneTracked == NULL)
+    return false;
+
+  std::ofstream file(filename.c_str(), std::ios::out|std::ios::binary);
+  if (!file)
+    return false;
+
+  unsigned int magic = VP_TT_IC_CACHE_MAGIC, version = VP_TT_IC_CACHE_VERSION;
+  file.write((const char *)&magic, sizeof(unsigned int));
+  file.write((const char *)&version, sizeof(unsigned int));
+  file.write((const char *)&nbParam, sizeof(unsigned int));
+  file.write((const char *)&templateSize, sizeof(unsigned int));
+  file.write((const char *)&templateSelectSize, sizeof(unsigned int));
+
+  // Zone triangulation
+  unsigned int nb_triangle = zoneTracked->getNbTriangle();
+  file.write((const char *)&nb_triangle, sizeof(unsigned int));
+  vpTemplateTrackerTriangle triangle;
+  for (unsigned int t = 0; t < nb_triangle; t++) {
+    zoneTracked->getTriangle(t, triangle);
+    vpColVector c1, c2, c3;
+    triangle.getCorners(c1, c2, c3);
+    double corners[6] = { c1[0], c1[1], c2[0], c2[1], c3[0], c3[1] };
+    file.write((const char *)corners, 6*sizeof(double));
+  }
+
+  // Template points with their precomputation
+  for (unsigned int point = 0; point < templateSize; point++) {
+    const vpTemplateTrackerPoint &pt = ptTemplate[point];
+    file.write((const char *)&pt.x, sizeof(int));
+    file.write((const char *)&pt.y, sizeof(int));
+    file.write((const char *)&pt.dx, sizeof(double));
+    file.write((const char *)&pt.dy, sizeof(double));
+    file.write((const char *)&pt.val, sizeof(double));
+    char selected = ptTemplateSelect[point] ? 1 : 0;
+    file.write(&selected, 1);
+    char has_compo = (pt.dW != NULL && pt.HiG != NULL) ? 1 : 0;
+    file.write(&has_compo, 1);
+    if (has_compo) {
+      file.write((const char *)pt.dW, nbParam*sizeof(double));
+      file.write((const char *)pt.HiG, nbParam*sizeof(double));
+    }
+  }
+
+  return (bool)file.good();
+}
+
+/*!
+  Re-arm the tracker from a cache file written by saveCache(): the zone
+  triangulation and the whole per-template precomputation (points,
+  gradients, steepest descent images) are restored without touching the
+  image, which makes re-acquiring a target from a template library near
+  instantaneous. The tracker must use the same warp class (same number
+  of parameters) as the one that wrote the cache.
+
+  \param filename : Cache file written by saveCache().
+  \param zone : Zone object restored from the cache; it is referenced by
+  the tracker and must stay alive while tracking.
+  \return true on success, false if the file cannot be read or does not
+  match the tracker configuration.
+
+  \sa saveCache()
+*/
+bool vpTemplateTrackerSSDInverseCompositional::initFromCache(const std::string &filename,
+                                                             vpTemplateTrackerZone &zone)
+{
+  if (nbLvlPyr > 1)
+    return false;
+
+  std::ifstream file(filename.c_str(), std::ios::in|std::ios::binary);
+  if (!file)
+    return false;
+
+  unsigned int magic = 0, version = 0, nb_param = 0;
+  file.read((char *)&magic, sizeof(unsigned int));
+  file.read((char *)&version, sizeof(unsigned int));
+  file.read((char *)&nb_param, sizeof(unsigned int));
+  if (!file.good() || magic != VP_TT_IC_CACHE_MAGIC || version != VP_TT_IC_CACHE_VERSION
+      || nb_param != nbParam)
+    return false;
+
+  unsigned int template_size = 0, template_select_size = 0, nb_triangle = 0;
+  file.read((char *)&template_size, sizeof(unsigned int));
+  file.read((char *)&template_select_size, sizeof(unsigned int));
+  file.read((char *)&nb_triangle, sizeof(unsigned int));
+  if (!file.good() || template_size == 0)
+    return false;
+
+  // Restore the zone triangulation
+  zone.clear();
+  for (unsigned int t = 0; t < nb_triangle; t++) {
+    double corners[6];
+    file.read((char *)corners, 6*sizeof(double));
+    vpColVector c1(2), c2(2), c3(2);
+    c1[0] = corners[0]; c1[1] = corners[1];
+    c2[0] = corners[2]; c2[1] = corners[3];
+    c3[0] = corners[4]; c3[1] = corners[5];
+    zone.add(vpTemplateTrackerTriangle(c1, c2, c3));
+  }
+  zoneTracked = &zone;
+
+  // Restore the template points
+  if (ptTemplateInit && ptTemplate != NULL) {
+    for (unsigned int point = 0; point < templateSize; point++) {
+      delete [] ptTemplate[point].dW;
+      delete [] ptTemplate[point].HiG;
+    }
+    delete [] ptTemplate;
+  }
+  if (ptTemplateSelectInit && ptTemplateSelect != NULL)
+    delete [] ptTemplateSelect;
+
+  templateSize = template_size;
+  templateSelectSize = template_select_size;
+  ptTemplate = new vpTemplateTrackerPoint[templateSize]; ptTemplateInit = true;
+  ptTemplateSelect = new bool[templateSize]; ptTemplateSelectInit = true;
+
+  for (unsigned int point = 0; point < templateSize; point++) {
+    vpTemplateTrackerPoint &pt = ptTemplate[point];
+    file.read((char *)&pt.x, sizeof(int));
+    file.read((char *)&pt.y, sizeof(int));
+    file.read((char *)&pt.dx, sizeof(double));
+    file.read((char *)&pt.dy, sizeof(double));
+    file.read((char *)&pt.val, sizeof(double));
+    char selected = 0, has_compo = 0;
+    file.read(&selected, 1);
+    file.read(&has_compo, 1);
+    ptTemplateSelect[point] = (selected != 0);
+    if (has_compo) {
+      pt.dW = new double[nbParam];
+      pt.HiG = new double[nbParam];
+      file.read((char *)pt.dW, nbParam*sizeof(double));
+      file.read((char *)pt.HiG, nbParam*sizeof(double));
+    }
+  }
+
+  if (!file.good())
+    return false;
+
+  m_HiGFloatSrc.clear(); // the packed single precision copies are stale
+  m_HiGFloat.clear();
+  m_HiGFloatRow.clear();
+  compoInitialised = true;
+  p = 0;
+  return true;
+}
+
+#undef VP_TT_IC_CACHE_MAGIC
+#undef VP_TT_IC_CACHE_VERSION
@@ -38,6 +38,7 @@
  *****************************************************************************/
 
 #include <visp3/tt/vpTemplateTracker.h>
+#include <visp3/core/vpProfiler.h>
 #include <visp3/tt/vpTemplateTrackerBSpline.h>
 
 vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
@@ -50,7 +51,8 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
     HLMdesireInverse(), HLMdesireInversePyr(), G(), gain(1.), thresholdGradient(40),
     costFunctionVerification(false), blur(true), useBrent(false), nbIterBrent(3),
     taillef(7), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0),
-    lambdaDep(0.001), iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0),
+    lambdaDep(0.001), iterationMax(30), iterationGlobale(0), iterationBudget(0),
+    iterationSpent(0), m_floatCompute(false), diverge(false), nbIteration(0),
     useCompositionnal(true), useInverse(false), Warp(_warp), p(0), dp(), X1(), X2(),
     dW(), BI(), dIx(), dIy(), zoneRef_()
 {
@@ -82,6 +84,10 @@ void vpTemplateTracker::initTracking(const vpImage<unsigned char>& I, vpTemplate
   // 	std::cout<<"\tInitialise reference..."<<std::endl;
   zoneTracked=&zone;
 
+  // The warm start extrapolation must not use estimates of a previous
+  // initialisation
+  warmStartReady = false;
+
   int largeur_im=(int)I.getWidth();
   int hauteur_im=(int)I.getHeight();
 
@@ -815,10 +821,35 @@ void vpTemplateTracker::initHessienDesiredPyr(const vpImage<unsigned char> &I)
  */
 void vpTemplateTracker::track(const vpImage<unsigned char> &I)
 {
+  VP_PROFILE_SCOPE("tt.track");
+  vpColVector p_last;
+  if (warmStart) {
+    p_last = p;
+    if (warmStartReady) {
+      // Constant velocity extrapolation of the warp parameters
+      p = p + (p - p_prev);
+    }
+  }
+
   if (nbLvlPyr > 1)
     trackPyr(I);
-  else
-    trackNoPyr(I);
+  else {
+    if (iterationBudget > 0 && iterationMax > iterationBudget) {
+      unsigned int iterationMax_sauv = iterationMax;
+      iterationMax = iterationBudget;
+      trackNoPyr(I);
+      iterationMax = iterationMax_sauv;
+    }
+    else {
+      trackNoPyr(I);
+    }
+    iterationSpent = nbIteration;
+  }
+
+  if (warmStart) {
+    p_prev = p_last;
+    warmStartReady = true;
+  }
 }
 
 void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
@@ -865,6 +896,8 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
 
         }
 
+        unsigned int iterationMax_sauv = iterationMax;
+        iterationSpent = 0;
         for(int i=(int)nbLvlPyr-1;i>=0;i--)
         {
           if(i>=(int)l0Pyr)
@@ -878,7 +911,18 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
             HLM=HLMdesirePyr[i];
             HLMdesireInverse=HLMdesireInversePyr[i];
     //        zoneTracked=&zoneTrackedPyr[i];
-            trackRobust(pyr_I[i]);
+            // Bound the level by the remaining budget, the finest levels
+            // getting what the coarser ones did not consume; a level whose
+            // budget is exhausted is skipped, its pose propagating unchanged
+            unsigned int remaining = 0;
+            if (iterationBudget > 0) {
+              remaining = (iterationSpent < iterationBudget) ? iterationBudget - iterationSpent : 0;
+              iterationMax = (iterationMax_sauv < remaining) ? iterationMax_sauv : remaining;
+            }
+            if (iterationBudget == 0 || remaining > 0) {
+              trackRobust(pyr_I[i]);
+              iterationSpent += nbIteration;
+            }
           }
           //std::cout<<"get p up"<<std::endl;
     //      ptemp=p_sauv[i-1];
@@ -888,6 +932,7 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
             zoneTracked=&zoneTrackedPyr[i-1];
           }
         }
+        iterationMax = iterationMax_sauv;
     #if 0
         if(l0Pyr==0)
         {
@@ -916,7 +961,16 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
       else
       {
         //std::cout<<"reviens a tracker de base"<<std::endl;
-        trackRobust(I);
+        if (iterationBudget > 0 && iterationMax > iterationBudget) {
+          unsigned int iterationMax_sauv = iterationMax;
+          iterationMax = iterationBudget;
+          trackRobust(I);
+          iterationMax = iterationMax_sauv;
+        }
+        else {
+          trackRobust(I);
+        }
+        iterationSpent = nbIteration;
       }
       delete[] pyr_I;
   }
@@ -162,3 +162,42 @@ void vpTemplateTrackerWarp::findWarp(const double *ut0,const double *vt0,const d
 }
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+
+/*!
+  Warp a whole batch of points. The generic implementation forwards each
+  point to the virtual warpX(); the warp classes whose model allows it
+  override this entry point with the parameters hoisted out of the loop
+  (and the trigonometry evaluated once for the rotation based warps), so
+  that the per-point cost reduces to a few multiplications without any
+  virtual dispatch.
+
+  \param nb_pt : Number of points to warp.
+  \param i, j : Input point coordinates.
+  \param i2, j2 : Warped coordinates.
+  \param ParamM : Parameters of the warp.
+*/
+void vpTemplateTrackerWarp::warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                                       double *i2, double *j2, const vpColVector &ParamM)
+{
+  for (unsigned int k = 0; k < nb_pt; k++)
+    warpX(i[k], j[k], i2[k], j2[k], ParamM);
+}
+
+/*!
+  Warp a whole scanline of points (i, j0), (i, j0+1), ... , (i, j0+nb_pt-1).
+  The generic implementation forwards each point to the virtual warpX(); the
+  linear warps override this entry point with an incremental stepping that
+  reduces the per-pixel cost to two additions.
+
+  \param i : Row coordinate of the scanline.
+  \param j0 : Column coordinate of the first point.
+  \param nb_pt : Number of consecutive points to warp.
+  \param i2, j2 : Warped coordinates.
+  \param ParamM : Parameters of the warp.
+*/
+void vpTemplateTrackerWarp::warpXScanline(const int &i, const int &j0, unsigned int nb_pt,
+                                          double *i2, double *j2, const vpColVector &ParamM)
+{
+  for (unsigned int k = 0; k < nb_pt; k++)
+    warpX(i, j0+(int)k, i2[k], j2[k], ParamM);
+}
@@ -40,6 +40,7 @@
 
 
 vpTemplateTrackerWarpAffine::vpTemplateTrackerWarpAffine()
+  : useFixedPoint(false)
 {
   nbParam = 6 ;
   dW.resize(2,nbParam);
@@ -167,3 +168,63 @@ void vpTemplateTrackerWarpAffine::pRondp(const vpColVector &p1, const vpColVecto
   pres[1]=MWrapRes[1][0];pres[3]=MWrapRes[1][1]-1;
   pres[4]=TransRes[0];pres[5]=TransRes[1];
 }
+
+//! Batched affine warp with the parameters hoisted out of the loop, see
+//! vpTemplateTrackerWarp::warpXBatch().
+void vpTemplateTrackerWarpAffine::warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                                             double *i2, double *j2, const vpColVector &ParamM)
+{
+  double a = 1.+ParamM[0], b = ParamM[1], c = ParamM[2];
+  double d = 1.+ParamM[3], tx = ParamM[4], ty = ParamM[5];
+
+  if (useFixedPoint) {
+    // 16.16 evaluation: the six coefficients are converted once, each point
+    // then costs four integer multiplications
+    long a_fp = (long)vpMath::round(a*65536.), b_fp = (long)vpMath::round(b*65536.);
+    long c_fp = (long)vpMath::round(c*65536.), d_fp = (long)vpMath::round(d*65536.);
+    long tx_fp = (long)vpMath::round(tx*65536.), ty_fp = (long)vpMath::round(ty*65536.);
+    for (unsigned int k = 0; k < nb_pt; k++) {
+      j2[k] = (double)(a_fp*j[k] + c_fp*i[k] + tx_fp) * (1./65536.);
+      i2[k] = (double)(b_fp*j[k] + d_fp*i[k] + ty_fp) * (1./65536.);
+    }
+    return;
+  }
+
+  for (unsigned int k = 0; k < nb_pt; k++) {
+    j2[k] = a*j[k] + c*i[k] + tx;
+    i2[k] = b*j[k] + d*i[k] + ty;
+  }
+}
+
+//! Incremental scanline warp, see vpTemplateTrackerWarp::warpXScanline().
+void vpTemplateTrackerWarpAffine::warpXScanline(const int &i, const int &j0, unsigned int nb_pt,
+                                                double *i2, double *j2, const vpColVector &ParamM)
+{
+  double a = 1.+ParamM[0], b = ParamM[1], c = ParamM[2];
+  double d = 1.+ParamM[3], tx = ParamM[4], ty = ParamM[5];
+
+  if (useFixedPoint) {
+    // The warp of a scanline is linear in the column: after the initial
+    // 16.16 evaluation, each pixel costs two integer additions
+    long a_fp = (long)vpMath::round(a*65536.), b_fp = (long)vpMath::round(b*65536.);
+    long c_fp = (long)vpMath::round(c*65536.), d_fp = (long)vpMath::round(d*65536.);
+    long jw = a_fp*j0 + c_fp*i + (long)vpMath::round(tx*65536.);
+    long iw = b_fp*j0 + d_fp*i + (long)vpMath::round(ty*65536.);
+    for (unsigned int k = 0; k < nb_pt; k++) {
+      j2[k] = (double)jw * (1./65536.);
+      i2[k] = (double)iw * (1./65536.);
+      jw += a_fp;
+      iw += b_fp;
+    }
+    return;
+  }
+
+  double jw = a*j0 + c*i + tx;
+  double iw = b*j0 + d*i + ty;
+  for (unsigned int k = 0; k < nb_pt; k++) {
+    j2[k] = jw;
+    i2[k] = iw;
+    jw += a;
+    iw += b;
+  }
+}
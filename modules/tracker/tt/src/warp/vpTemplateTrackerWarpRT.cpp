@@ -175,3 +175,16 @@ void vpTemplateTrackerWarpRT::pRondp(const vpColVector &p1, const vpColVector &p
   pres[1]=TransRes[0];
   pres[2]=TransRes[1];
 }
+
+//! Batched RT warp with the trigonometry evaluated once for the whole
+//! batch, see vpTemplateTrackerWarp::warpXBatch().
+void vpTemplateTrackerWarpRT::warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                                         double *i2, double *j2, const vpColVector &ParamM)
+{
+  double co = cos(ParamM[0]), si = sin(ParamM[0]);
+  double tx = ParamM[1], ty = ParamM[2];
+  for (unsigned int k = 0; k < nb_pt; k++) {
+    j2[k] = co*j[k] - si*i[k] + tx;
+    i2[k] = si*j[k] + co*i[k] + ty;
+  }
+}
@@ -40,6 +40,7 @@
 
 
 vpTemplateTrackerWarpSRT::vpTemplateTrackerWarpSRT()
+  : useFixedPoint(false)
 {
   nbParam = 4 ;
   dW.resize(2,nbParam);
@@ -183,3 +184,63 @@ void vpTemplateTrackerWarpSRT::pRondp(const vpColVector &p1, const vpColVector &
   pres[2]=TransRes[0];
   pres[3]=TransRes[1];
 }
+
+//! Batched SRT warp: the scale and the trigonometry are evaluated once
+//! for the whole batch instead of four transcendental calls per point,
+//! see vpTemplateTrackerWarp::warpXBatch().
+void vpTemplateTrackerWarpSRT::warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                                          double *i2, double *j2, const vpColVector &ParamM)
+{
+  double sc = (1.0+ParamM[0])*cos(ParamM[1]);
+  double ss = (1.0+ParamM[0])*sin(ParamM[1]);
+  double tx = ParamM[2], ty = ParamM[3];
+
+  if (useFixedPoint) {
+    // 16.16 evaluation: the rotation and scale are folded in four integer
+    // coefficients converted once per batch
+    long sc_fp = (long)vpMath::round(sc*65536.), ss_fp = (long)vpMath::round(ss*65536.);
+    long tx_fp = (long)vpMath::round(tx*65536.), ty_fp = (long)vpMath::round(ty*65536.);
+    for (unsigned int k = 0; k < nb_pt; k++) {
+      j2[k] = (double)(sc_fp*j[k] - ss_fp*i[k] + tx_fp) * (1./65536.);
+      i2[k] = (double)(ss_fp*j[k] + sc_fp*i[k] + ty_fp) * (1./65536.);
+    }
+    return;
+  }
+
+  for (unsigned int k = 0; k < nb_pt; k++) {
+    j2[k] = sc*j[k] - ss*i[k] + tx;
+    i2[k] = ss*j[k] + sc*i[k] + ty;
+  }
+}
+
+//! Incremental scanline warp, see vpTemplateTrackerWarp::warpXScanline().
+void vpTemplateTrackerWarpSRT::warpXScanline(const int &i, const int &j0, unsigned int nb_pt,
+                                             double *i2, double *j2, const vpColVector &ParamM)
+{
+  double sc = (1.0+ParamM[0])*cos(ParamM[1]);
+  double ss = (1.0+ParamM[0])*sin(ParamM[1]);
+  double tx = ParamM[2], ty = ParamM[3];
+
+  if (useFixedPoint) {
+    // After the initial 16.16 evaluation each pixel costs two integer additions
+    long sc_fp = (long)vpMath::round(sc*65536.), ss_fp = (long)vpMath::round(ss*65536.);
+    long jw = sc_fp*j0 - ss_fp*i + (long)vpMath::round(tx*65536.);
+    long iw = ss_fp*j0 + sc_fp*i + (long)vpMath::round(ty*65536.);
+    for (unsigned int k = 0; k < nb_pt; k++) {
+      j2[k] = (double)jw * (1./65536.);
+      i2[k] = (double)iw * (1./65536.);
+      jw += sc_fp;
+      iw += ss_fp;
+    }
+    return;
+  }
+
+  double jw = sc*j0 - ss*i + tx;
+  double iw = ss*j0 + sc*i + ty;
+  for (unsigned int k = 0; k < nb_pt; k++) {
+    j2[k] = jw;
+    i2[k] = iw;
+    jw += sc;
+    iw += ss;
+  }
+}
@@ -124,3 +124,14 @@ void vpTemplateTrackerWarpTranslation::pRondp(const vpColVector &p1, const vpCol
   pres[0]=p1[0]+p2[0];
   pres[1]=p1[1]+p2[1];
 }
+
+//! Batched translation warp, see vpTemplateTrackerWarp::warpXBatch().
+void vpTemplateTrackerWarpTranslation::warpXBatch(unsigned int nb_pt, const int *i, const int *j,
+                                                  double *i2, double *j2, const vpColVector &ParamM)
+{
+  double tx = ParamM[0], ty = ParamM[1];
+  for (unsigned int k = 0; k < nb_pt; k++) {
+    j2[k] = j[k] + tx;
+    i2[k] = i[k] + ty;
+  }
+}
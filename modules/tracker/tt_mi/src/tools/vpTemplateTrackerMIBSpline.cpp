@@ -213,25 +213,29 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline3(double *Prt, int cr, double &e
   if(er>0.5){sr=1;er=er-1;}
   if(et>0.5){st=1;et=et-1;}
 
+  // After the half-unit shift |er| and |et| do not exceed 0.5, so the
+  // interval of every spline evaluation is known: the weights and their
+  // derivatives reduce to the closed forms below, without any of the
+  // branchy generic evaluations
   double Bti[3];
   double dBti[3];
   double d2Bti[3];
 
-  double *ptBti=&Bti[0];
-  double *ptdBti=&dBti[0];
-  double *ptd2Bti=&d2Bti[0];
-
-  for(short int it=1;it>=-1;it--)
-  {
-    *ptBti++ =Bspline3(it+et);
-    *ptdBti++ =dBspline3(it+et);
-    *ptd2Bti++ =d2Bspline3(it+et);
-  }
+  Bti[0] = 0.5*(0.5-et)*(0.5-et);   // Bspline3(1+et)
+  Bti[1] = 0.75 - et*et;            // Bspline3(et)
+  Bti[2] = 0.5*(0.5+et)*(0.5+et);   // Bspline3(-1+et)
+  dBti[0] = et - 0.5;               // dBspline3(1+et)
+  dBti[1] = -2.*et;                 // dBspline3(et)
+  dBti[2] = et + 0.5;               // dBspline3(-1+et)
+  d2Bti[0] = 1.;
+  d2Bti[1] = -2.;
+  d2Bti[2] = 1.;
 
   double *pt=&Prt[((cr+sr)*Nc+(ct+st))*9*(1+(int)(NbParam+NbParam*NbParam))];
   for(short int ir=-1;ir<=1;++ir)
   {
-    double Br=Bspline3(-ir+er);
+    double Br = (ir == -1) ? 0.5*(0.5-er)*(0.5-er)
+              : (ir == 0 ? 0.75 - er*er : 0.5*(0.5+er)*(0.5+er));
 
     for(short unsigned int it=0;it<=2;++it)
     {
@@ -256,25 +260,29 @@ void vpTemplateTrackerMIBSpline::PutTotPVBspline3(double *Prt, double *dPrt, dou
   if(er>0.5){sr=1;er=er-1;}
   if(et>0.5){st=1;et=et-1;}
 
+  // After the half-unit shift |er| and |et| do not exceed 0.5, so the
+  // interval of every spline evaluation is known: the weights and their
+  // derivatives reduce to the closed forms below, without any of the
+  // branchy generic evaluations
   double Bti[3];
   double dBti[3];
   double d2Bti[3];
 
-  double *ptBti=&Bti[0];
-  double *ptdBti=&dBti[0];
-  double *ptd2Bti=&d2Bti[0];
-
-  for(short int it=1;it>=-1;it--)
-  {
-    *ptBti++ =Bspline3(it+et);
-    *ptdBti++ =dBspline3(it+et);
-    *ptd2Bti++ =d2Bspline3(it+et);
-  }
+  Bti[0] = 0.5*(0.5-et)*(0.5-et);   // Bspline3(1+et)
+  Bti[1] = 0.75 - et*et;            // Bspline3(et)
+  Bti[2] = 0.5*(0.5+et)*(0.5+et);   // Bspline3(-1+et)
+  dBti[0] = et - 0.5;               // dBspline3(1+et)
+  dBti[1] = -2.*et;                 // dBspline3(et)
+  dBti[2] = et + 0.5;               // dBspline3(-1+et)
+  d2Bti[0] = 1.;
+  d2Bti[1] = -2.;
+  d2Bti[2] = 1.;
 
   int NbParam_ = (int)NbParam;
   for(short int ir=-1;ir<=1;++ir)
   {
-    double Br=Bspline3(-ir+er);
+    double Br = (ir == -1) ? 0.5*(0.5-er)*(0.5-er)
+              : (ir == 0 ? 0.75 - er*er : 0.5*(0.5+er)*(0.5+er));
     short int irInd = ir + 1;
     short int ind = (cr+sr+irInd)*Ncb;
     for(short int it=0;it<=2;++it)
@@ -324,6 +324,9 @@ public:
   */
   cv::Rect getModelROI() const { return modelROI;}
 
+  void loadCompact(const std::string &dataFile);
+  void saveCompact(const std::string &dataFile) const;
+
 protected:
   void setImage(const vpImage<unsigned char>& I);
   void train();
@@ -70,6 +70,7 @@
 #include <opencv2/features2d/features2d.hpp>
 #include <opencv2/calib3d/calib3d.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/flann/miniflann.hpp>
 
 #if defined(VISP_HAVE_OPENCV_XFEATURES2D) // OpenCV >= 3.0.0
 #  include <opencv2/xfeatures2d.hpp>
@@ -508,6 +509,9 @@ public:
 
   void initMatcher(const std::string &matcherName);
 
+  void matchGuided(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
+                   std::vector<cv::DMatch> &matches);
+
   void insertImageMatching(const vpImage<unsigned char> &IRef, const vpImage<unsigned char> &ICurrent,
                            vpImage<unsigned char> &IMatching);
   void insertImageMatching(const vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching);
@@ -853,10 +857,53 @@ public:
 
     \param ransacVVS : True to use ViSP function, otherwise use OpenCV function
   */
+  /*!
+    Enable the guided matching mode: the reference 3D points are projected
+    with the given pose prior and each detected keypoint is only matched
+    against the reference descriptors projecting within the given radius,
+    through an image grid bucketing. This converts the full query-train
+    matching into a local one when a good pose guess exists (typical when
+    re-acquiring a tracked object). The mode stays active, with the same
+    prior, until unsetGuidedMatching() is called or a new prior is given.
+
+    \param cMo_prior : Prior pose of the object.
+    \param cam : Camera parameters used for the projection.
+    \param radiusPx : Search radius around each projected reference point,
+    in pixels.
+  */
+  inline void setGuidedMatching(const vpHomogeneousMatrix &cMo_prior, const vpCameraParameters &cam,
+                                const double &radiusPx) {
+    m_guidedMatchingPose = cMo_prior;
+    m_guidedMatchingCam = cam;
+    m_guidedMatchingRadius = radiusPx;
+    m_guidedMatching = true;
+  }
+
+  //! Disable the guided matching mode, see setGuidedMatching().
+  inline void unsetGuidedMatching() { m_guidedMatching = false; }
+
   inline void setUseRansacVVS(const bool ransacVVS) {
     m_useRansacVVS = ransacVVS;
   }
 
+  /*!
+    Set the flag to persist the matcher index with the learning data:
+    saveLearningData() then also saves the FLANN index built over the train
+    descriptors (KD-trees for floating point descriptors, LSH tables for
+    binary ones), and loadLearningData() restores a ready-to-query index
+    from that file instead of rebuilding it, which turns the seconds of
+    index training at process start into milliseconds of loading. The
+    matching then queries the restored index directly. Only effective with
+    the FlannBased matcher; ignored when the index file is missing or when
+    the learning data are loaded in append mode (a merged training set
+    cannot reuse the individual indexes).
+
+    \param useSavedMatcherIndex : True to persist and reuse the matcher index.
+  */
+  inline void setUseSavedMatcherIndex(const bool useSavedMatcherIndex) {
+    m_useSavedMatcherIndex = useSavedMatcherIndex;
+  }
+
   /*!
     Set the flag to filter matches where multiple query keypoints are matched to the same train keypoints.
 
@@ -897,6 +944,14 @@ private:
   std::vector<cv::DMatch> m_filteredMatches;
   //! Chosen method of filtering to eliminate false matching.
   vpFilterMatchingType m_filterType;
+  //! True when the matching is guided by a pose prior, see setGuidedMatching().
+  bool m_guidedMatching;
+  //! Camera parameters used to project the reference points for the guided matching.
+  vpCameraParameters m_guidedMatchingCam;
+  //! Pose prior used to project the reference points for the guided matching.
+  vpHomogeneousMatrix m_guidedMatchingPose;
+  //! Pixel search radius of the guided matching.
+  double m_guidedMatchingRadius;
   //! Image format to use when saving the training images
   vpImageFormatType m_imageFormat;
   //! List of k-nearest neighbors for each detected keypoints (if the method chosen is based upon on knn).
@@ -944,6 +999,10 @@ private:
   double m_ransacReprojectionError;
   //! Maximum error (in meter for the ViSP method) to decide if a point is an inlier or not.
   double m_ransacThreshold;
+  //! Matcher index restored from the learning data without rebuilding, see setUseSavedMatcherIndex().
+  cv::flann::Index m_savedIndex;
+  //! True when m_savedIndex holds a loaded index ready to be queried.
+  bool m_savedIndexLoaded;
   //! Matrix of descriptors (each row contains the descriptors values for each keypoints
   //detected in the train images).
   cv::Mat m_trainDescriptors;
@@ -970,6 +1029,8 @@ private:
   bool m_useMatchTrainToQuery;
   //! Flag set if a Ransac VVS pose estimation must be used.
   bool m_useRansacVVS;
+  //! Flag set if the matcher index must be persisted with the learning data and queried after loading.
+  bool m_useSavedMatcherIndex;
   //! If true, keep only pairs of keypoints where each train keypoint is matched to a single query keypoint
   bool m_useSingleMatchFilter;
 
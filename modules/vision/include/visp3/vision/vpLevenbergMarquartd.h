@@ -49,6 +49,42 @@
 #include <stdlib.h>
 #include <float.h>
 
+#include <vector>
+
+/*!
+  \class vpLevenbergMarquartd
+
+  \brief Reusable Levenberg-Marquartd solver.
+
+  The solver owns the integer and double work arrays required by lmder1()
+  and keeps them across solves, and its callback receives a user data
+  pointer, so that repeated minimizations (e.g. one per calibration image or
+  per tracked frame) neither reallocate workspaces nor need file scope
+  globals to reach their data. The cost function provides the analytic
+  Jacobian, following the historic lmder() callback contract.
+*/
+class VISP_EXPORT vpLevenbergMarquartd
+{
+public:
+  /*!
+    Cost and analytic Jacobian callback: when iflag == 1 the callback fills
+    \e fvecc with the m residuals at \e xc, when iflag == 2 it fills \e jac
+    with the analytic Jacobian, with the same storage contract as the
+    lmder() callback. \e user_data is the pointer given to solve().
+  */
+  typedef void (*vpFcn)(void *user_data, int m, int n, double *xc, double *fvecc,
+                        double *jac, int ldfjac, int iflag);
+
+  vpLevenbergMarquartd() : m_ipvt(), m_wa() {}
+
+  int solve(vpFcn ptr_fcn, void *user_data, int m, int n, double *x, double *fvec,
+            double *fjac, int ldfjac, double tol, int *info);
+
+private:
+  std::vector<int> m_ipvt;
+  std::vector<double> m_wa;
+};
+
 int VISP_EXPORT
 qrsolv (int n, double *r, int ldr, int *ipvt, double *diag,
 	double *qtb, double *x, double *sdiag, double *wa) ;
@@ -72,6 +108,20 @@ int VISP_EXPORT
 qrsolv (int n, double *r, int ldr, int *ipvt, double *diag, double *qtb,
 	double *x, double *sdiag, double *wa);
 
+int VISP_EXPORT
+lmder (vpLevenbergMarquartd::vpFcn ptr_fcn, void *user_data,
+       int m, int n, double *x,
+       double *fvec, double *fjac, int ldfjac, double ftol, double xtol,
+       double gtol, unsigned int maxfev, double *diag, int mode,
+       const double factor, int nprint, int *info, unsigned int *nfev,
+       int *njev, int *ipvt, double *qtf, double *wa1, double *wa2,
+       double *wa3, double *wa4);
+
+int VISP_EXPORT
+lmder1 (vpLevenbergMarquartd::vpFcn ptr_fcn, void *user_data,
+        int m, int n, double *x, double *fvec, double *fjac,
+        int ldfjac, double tol, int *info, int *ipvt, int lwa, double *wa);
+
 int VISP_EXPORT
 lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
 		       double *jac, int ldfjac, int iflag),
@@ -49,6 +49,7 @@
 #define vpPOSE_HH
 
 #include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/vision/vpLevenbergMarquartd.h>
 #include <visp3/vision/vpHomography.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpRGBa.h>
@@ -85,7 +86,8 @@ public:
       DEMENTHON_LOWE   ,
       VIRTUAL_VS       ,
       DEMENTHON_VIRTUAL_VS,
-      LAGRANGE_VIRTUAL_VS
+      LAGRANGE_VIRTUAL_VS,
+      P3P
     } vpPoseMethodType;
 
   unsigned int npt ;       //!< number of point used in pose computation
@@ -98,12 +100,30 @@ protected :
 
 private:
   int vvsIterMax ; //! define the maximum number of iteration in VVS
+  //! Residual delta under which the VVS stops early (0: historic exact-stabilization criterion)
+  double m_vvsResidualThreshold;
+  //! Update norm under which the VVS stops early (0: disabled)
+  double m_vvsUpdateThreshold;
+  //! Wall time budget of one VVS estimation in ms (0: unlimited)
+  double m_vvsTimeBudget;
+  //! True when a prior information matrix anchors the warm started VVS
+  bool m_vvsPriorSet;
+  //! Information matrix (inverse of the initial covariance) added to the VVS normal equations
+  vpMatrix m_vvsPriorInformation;
   //! variable used in the Dementhon approach
   std::vector<vpPoint> c3d ;
   //! Flag used to specify if the covariance matrix has to be computed or not.
   bool computeCovariance;
-  //! Covariance matrix
-  vpMatrix covarianceMatrix;
+  //! Covariance matrix, computed on demand from the cached VVS factorization
+  mutable vpMatrix covarianceMatrix;
+  //! Deferred covariance model: 0 none, 1 plain VVS, 2 robust VVS
+  mutable int m_covModel;
+  //! Inputs of the deferred covariance computation, cached at the end of the VVS
+  vpHomogeneousMatrix m_covCMoPrev;
+  vpColVector m_covError;
+  vpMatrix m_covJacobian;
+  vpColVector m_covV;
+  vpColVector m_covWeights;
   
   unsigned int ransacNbInlierConsensus;
   int ransacMaxTrials;
@@ -116,6 +136,10 @@ private:
 protected:
   double computeResidualDementhon(const vpHomogeneousMatrix &cMo) ;
 
+  //! Reusable Levenberg-Marquartd solver of poseLowe(), keeping its work
+  //! arrays across the solves.
+  vpLevenbergMarquartd m_lmSolver;
+
   // method used in poseDementhonPlan()
   int calculArbreDementhon(vpMatrix &b, vpColVector &U, vpHomogeneousMatrix &cMo) ;
 
@@ -154,6 +178,8 @@ public:
   //! compute the pose using the Lowe approach (i.e., using the
   //! Levenberg Marquartd non linear minimization approach)
   void poseLowe(vpHomogeneousMatrix & cMo) ;
+
+  void poseP3P(vpHomogeneousMatrix &cMo) ;
   //! compute the pose using the Ransac approach 
   bool poseRansac(vpHomogeneousMatrix & cMo, bool (*func)(vpHomogeneousMatrix *)=NULL) ;
   //! compute the pose using a robust virtual visual servoing approach
@@ -164,6 +190,51 @@ public:
   void setDistanceToPlaneForCoplanarityTest(double d) ;
   void setLambda(double a) { lambda = a ; }
   void setVvsIterMax(int nb) { vvsIterMax = nb ; }
+
+  /*!
+    Set the residual variation under which the virtual visual servoing pose
+    estimation stops early. Useful for warm started estimations where most
+    iterations change the pose below the noise floor.
+
+    \param threshold : Residual delta threshold (0, the default, keeps the
+    historic exact-stabilization criterion).
+  */
+  void setVvsResidualThreshold(const double &threshold) { m_vvsResidualThreshold = threshold; }
+
+  /*!
+    Set the update norm under which the virtual visual servoing pose
+    estimation stops early.
+
+    \param threshold : Norm of the pose update, in the velocity twist units
+    (0, the default, disables the test).
+  */
+  void setVvsUpdateThreshold(const double &threshold) { m_vvsUpdateThreshold = threshold; }
+
+  /*!
+    Set a wall time budget for one virtual visual servoing pose estimation:
+    the minimization returns the current estimate once the budget is spent.
+
+    \param budget_ms : Budget in milliseconds (0, the default, is unlimited).
+  */
+  void setVvsTimeBudget(const double &budget_ms) { m_vvsTimeBudget = budget_ms; }
+
+  /*!
+    Provide the covariance of the initial pose of a warm started estimation:
+    its inverse is added to the normal equations of the virtual visual
+    servoing, which anchors and scales the updates according to the prior
+    confidence (maximum a posteriori estimation). The prior stays active
+    until unsetVvsPriorCovariance() is called.
+
+    \param covariance : 6x6 covariance of the initial pose, expressed in the
+    units of the velocity twist.
+  */
+  void setVvsPriorCovariance(const vpMatrix &covariance) {
+    m_vvsPriorInformation = covariance.pseudoInverse();
+    m_vvsPriorSet = true;
+  }
+
+  //! Remove the prior set by setVvsPriorCovariance().
+  void unsetVvsPriorCovariance() { m_vvsPriorSet = false; }
   
   void setRansacNbInliersToReachConsensus(const unsigned int &nbC){ ransacNbInlierConsensus = nbC; }
   void setRansacThreshold(const double &t) {
@@ -196,7 +267,21 @@ public:
   vpMatrix getCovarianceMatrix() const { 
     if(!computeCovariance)
       vpTRACE("Warning : The covariance matrix has not been computed. See setCovarianceComputation() to do it.");
-    
+
+    // The VVS estimation caches its factorization and the covariance is
+    // only computed here, on demand
+    if(m_covModel == 1) {
+      covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(m_covCMoPrev, m_covError, m_covJacobian);
+      m_covModel = 0;
+    }
+    else if(m_covModel == 2) {
+      vpMatrix WW(m_covWeights.getRows(), m_covWeights.getRows());
+      for(unsigned int i = 0; i < m_covWeights.getRows(); i++)
+        WW[i][i] = m_covWeights[i]*m_covWeights[i];
+      covarianceMatrix = vpMatrix::computeCovarianceMatrix(m_covJacobian, m_covV, m_covError, WW);
+      m_covModel = 0;
+    }
+
     return covarianceMatrix; 
   }
   
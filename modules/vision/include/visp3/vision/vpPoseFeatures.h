@@ -70,6 +70,7 @@
 
 #ifdef VISP_HAVE_CPP11_COMPATIBILITY
 #include <tuple>
+#include <type_traits>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 //#################################################
@@ -731,6 +732,200 @@ void vpPoseFeatures::addSpecificFeature(ObjType *obj, RetType (ObjType::*fct_ptr
 }
 #endif
 
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+/*!
+  Compile-time feature operators for vpPoseFeaturesFixed. An operator owns
+  its geometric primitive and its desired feature, exposes the dimension of
+  its error and writes its error and interaction rows in place at the
+  current pose. Users can provide their own operator types following the
+  same contract.
+*/
+struct vpPoseFixedFeaturePoint
+{
+  vpFeaturePoint desired;
+  vpPoint geometry;
+
+  explicit vpPoseFixedFeaturePoint(const vpPoint &p) : desired(), geometry(p) {
+    vpFeatureBuilder::create(desired, geometry);
+  }
+  unsigned int dimension() const { return desired.getDimension(); }
+  void errorAndInteraction(const vpHomogeneousMatrix &cMo, vpColVector &err, vpMatrix &L, unsigned int row) {
+    vpFeaturePoint current;
+    vpPoint p(geometry);
+    p.track(cMo);
+    vpFeatureBuilder::create(current, p);
+    writeRows(current.error(desired), current.interaction(), err, L, row);
+  }
+
+  static void writeRows(const vpColVector &e, const vpMatrix &Li, vpColVector &err, vpMatrix &L, unsigned int row) {
+    for (unsigned int i = 0; i < Li.getRows(); i++) {
+      err[row+i] = e[i];
+      for (unsigned int j = 0; j < 6; j++)
+        L[row+i][j] = Li[i][j];
+    }
+  }
+};
+
+//! Line operator of vpPoseFeaturesFixed, see vpPoseFixedFeaturePoint.
+struct vpPoseFixedFeatureLine
+{
+  vpFeatureLine desired;
+  vpLine geometry;
+
+  explicit vpPoseFixedFeatureLine(const vpLine &l) : desired(), geometry(l) {
+    vpFeatureBuilder::create(desired, geometry);
+  }
+  unsigned int dimension() const { return desired.getDimension(); }
+  void errorAndInteraction(const vpHomogeneousMatrix &cMo, vpColVector &err, vpMatrix &L, unsigned int row) {
+    vpFeatureLine current;
+    vpLine l(geometry);
+    l.track(cMo);
+    vpFeatureBuilder::create(current, l);
+    vpPoseFixedFeaturePoint::writeRows(current.error(desired), current.interaction(), err, L, row);
+  }
+};
+
+//! Ellipse (from circle) operator of vpPoseFeaturesFixed, see vpPoseFixedFeaturePoint.
+struct vpPoseFixedFeatureEllipse
+{
+  vpFeatureEllipse desired;
+  vpCircle geometry;
+
+  explicit vpPoseFixedFeatureEllipse(const vpCircle &c) : desired(), geometry(c) {
+    vpFeatureBuilder::create(desired, geometry);
+  }
+  unsigned int dimension() const { return desired.getDimension(); }
+  void errorAndInteraction(const vpHomogeneousMatrix &cMo, vpColVector &err, vpMatrix &L, unsigned int row) {
+    vpFeatureEllipse current;
+    vpCircle c(geometry);
+    c.track(cMo);
+    vpFeatureBuilder::create(current, c);
+    vpPoseFixedFeaturePoint::writeRows(current.error(desired), current.interaction(), err, L, row);
+  }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Index of a type inside a parameter pack, used by the compile-time registry.
+template <typename T, typename First, typename... Rest>
+struct vpPoseFixedTypeIndex {
+  static const std::size_t value = 1 + vpPoseFixedTypeIndex<T, Rest...>::value;
+};
+template <typename T, typename... Rest>
+struct vpPoseFixedTypeIndex<T, T, Rest...> {
+  static const std::size_t value = 0;
+};
+#endif
+
+/*!
+  \class vpPoseFeaturesFixed
+  \brief Compile-time variant of vpPoseFeatures.
+  \ingroup group_vision_pose
+
+  The set of feature types is fixed as template arguments: the features live
+  in one std::vector per type inside a tuple, and the error/interaction
+  assembly of the virtual visual servoing is a single fused loop expanded at
+  compile time, so the per feature computations inline into the minimization
+  with no virtual nor functor dispatch and no per iteration reallocation.
+  The estimation itself follows vpPoseFeatures::computePose() with the
+  VIRTUAL_VS method.
+
+  \code
+  vpPoseFeaturesFixed<vpPoseFixedFeaturePoint, vpPoseFixedFeatureLine> pose;
+  pose.addFeature(vpPoseFixedFeaturePoint(p));   // p is a vpPoint at the desired pose
+  pose.addFeature(vpPoseFixedFeatureLine(l));
+  pose.computePose(cMo);
+  \endcode
+*/
+template <typename... FeatureOps>
+class vpPoseFeaturesFixed
+{
+public:
+  vpPoseFeaturesFixed() : m_lists(), m_lambda(1.0), m_vvsIterMax(200) {}
+
+  //! Register a feature; Op must be one of the FeatureOps of the registry.
+  template <typename Op>
+  void addFeature(const Op &op) {
+    std::get<vpPoseFixedTypeIndex<Op, FeatureOps...>::value>(m_lists).push_back(op);
+  }
+
+  //! Set the virtual visual servoing gain.
+  void setLambda(const double &lambda) { m_lambda = lambda; }
+  //! Set the maximum number of virtual visual servoing iterations.
+  void setVVSIterMax(const unsigned int &iterMax) { m_vvsIterMax = iterMax; }
+
+  /*!
+    Compute the pose by virtual visual servoing over the registered
+    features, starting from the given pose.
+
+    \param cMo : In/out pose.
+  */
+  void computePose(vpHomogeneousMatrix &cMo) {
+    unsigned int total = totalDimension<0>();
+    if (total < 6) {
+      throw(vpException(vpException::dimensionError,
+            "Not enough feature rows (%u) to estimate the 6 dof pose", total));
+    }
+
+    vpColVector err(total);
+    vpMatrix L(total, 6);
+    vpColVector v;
+    vpMatrix Lp;
+
+    double residu_1 = 1e8;
+    double r = 1e8-1;
+    unsigned int iter = 0;
+    while (std::fabs((residu_1 - r)*1e12) > std::numeric_limits<double>::epsilon()) {
+      residu_1 = r;
+
+      fillErrorAndInteraction<0>(cMo, err, L, 0u);
+      r = err.sumSquare();
+
+      unsigned int rank = L.pseudoInverse(Lp, 1e-16);
+      if (rank < 6)
+        break;
+
+      v = -m_lambda*Lp*err;
+      cMo = vpExponentialMap::direct(v).inverse()*cMo;
+      if (iter++ > m_vvsIterMax)
+        break;
+    }
+  }
+
+private:
+  std::tuple<std::vector<FeatureOps>...> m_lists;
+  double m_lambda;
+  unsigned int m_vvsIterMax;
+
+  template <std::size_t I>
+  typename std::enable_if<I == sizeof...(FeatureOps), unsigned int>::type totalDimension() const {
+    return 0;
+  }
+  template <std::size_t I>
+  typename std::enable_if<I < sizeof...(FeatureOps), unsigned int>::type totalDimension() const {
+    unsigned int d = 0;
+    const auto &list = std::get<I>(m_lists);
+    for (std::size_t k = 0; k < list.size(); k++)
+      d += list[k].dimension();
+    return d + totalDimension<I+1>();
+  }
+
+  template <std::size_t I>
+  typename std::enable_if<I == sizeof...(FeatureOps), void>::type
+  fillErrorAndInteraction(const vpHomogeneousMatrix &, vpColVector &, vpMatrix &, unsigned int) {
+  }
+  template <std::size_t I>
+  typename std::enable_if<I < sizeof...(FeatureOps), void>::type
+  fillErrorAndInteraction(const vpHomogeneousMatrix &cMo, vpColVector &err, vpMatrix &L, unsigned int row) {
+    auto &list = std::get<I>(m_lists);
+    for (std::size_t k = 0; k < list.size(); k++) {
+      list[k].errorAndInteraction(cMo, err, L, row);
+      row += list[k].dimension();
+    }
+    fillErrorAndInteraction<I+1>(cMo, err, L, row);
+  }
+};
+#endif //#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+
 #endif //#ifdef VISP_HAVE_MODULE_VISUAL_FEATURES
 
 #endif
@@ -37,6 +37,10 @@
  *****************************************************************************/
 
 #include <visp3/vision/vpCalibration.h>
+
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
 #include <visp3/core/vpMath.h>
 #include <visp3/vision/vpPose.h>
 #include <visp3/core/vpPixelMeterConversion.h>
@@ -426,6 +430,16 @@ vpCalibration::calibVVSMulti(std::vector<vpCalibration> &table_cal,
       curPoint++;
     }
   }
+  //Row offsets of each view in the stacked point arrays
+  std::vector<unsigned int> startPoint(nbPose);
+  {
+    unsigned int acc = 0;
+    for (unsigned int p=0; p<nbPose ; p++) {
+      startPoint[p] = acc;
+      acc += nbPoint[p];
+    }
+  }
+
   //  double lambda = 0.1 ;
   unsigned int iter = 0 ;
 
@@ -441,98 +455,113 @@ vpCalibration::calibVVSMulti(std::vector<vpCalibration> &table_cal,
     double py = cam_est.get_py();
     double u0 = cam_est.get_u0();
     double v0 = cam_est.get_v0();
-   
-    r = 0 ;
-    curPoint = 0 ; //current point indice
-    for (unsigned int p=0; p<nbPose ; p++)
+
+    //The normal equations of the stacked system have an arrowhead
+    //structure: one 6x6 extrinsic block A_p and one 6x4 coupling block B_p
+    //per view, plus the shared 4x4 intrinsic block C. The per view blocks
+    //are accumulated concurrently (the views are independent given the
+    //parameters) and the intrinsic update comes from the reduced 4x4 Schur
+    //system, so the dense Jacobian and its pseudo inverse are never built.
+    std::vector<vpMatrix> A(nbPose), B(nbPose), Cpart(nbPose);
+    std::vector<vpColVector> gv(nbPose), gcPart(nbPose);
+    double r_sum = 0;
+
+    int nbPose_int = (int)nbPose;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:r_sum)
+#endif
+    for (int p=0; p<nbPose_int ; p++)
     {
-      vpHomogeneousMatrix cMoTmp = table_cal[p].cMo;
-      for (unsigned int i=0 ; i < nbPoint[p]; i++)
+      vpHomogeneousMatrix cMoTmp = table_cal[(unsigned int)p].cMo;
+      vpMatrix &Ap = A[(size_t)p];
+      vpMatrix &Bp = B[(size_t)p];
+      vpMatrix &Cp = Cpart[(size_t)p];
+      vpColVector &gvp = gv[(size_t)p];
+      vpColVector &gcp = gcPart[(size_t)p];
+      Ap.resize(6,6);
+      Bp.resize(6,4);
+      Cp.resize(4,4);
+      gvp.resize(6);
+      gcp.resize(4);
+
+      for (unsigned int i=0 ; i < nbPoint[(unsigned int)p]; i++)
       {
-        unsigned int curPoint2 = 2*curPoint;    
-        
-        cX[curPoint] = oX[curPoint]*cMoTmp[0][0]+oY[curPoint]*cMoTmp[0][1]
-                       +oZ[curPoint]*cMoTmp[0][2] + cMoTmp[0][3];
-        cY[curPoint] = oX[curPoint]*cMoTmp[1][0]+oY[curPoint]*cMoTmp[1][1]
-                       +oZ[curPoint]*cMoTmp[1][2] + cMoTmp[1][3];
-        cZ[curPoint] = oX[curPoint]*cMoTmp[2][0]+oY[curPoint]*cMoTmp[2][1]
-                       +oZ[curPoint]*cMoTmp[2][2] + cMoTmp[2][3];
-
-        Pd[curPoint2] =   u[curPoint] ;
-        Pd[curPoint2+1] = v[curPoint] ;
-
-        P[curPoint2] =    cX[curPoint]/cZ[curPoint]*px + u0 ;
-        P[curPoint2+1] =  cY[curPoint]/cZ[curPoint]*py + v0 ;
-
-        r += (vpMath::sqr(P[curPoint2]-Pd[curPoint2])
-               + vpMath::sqr(P[curPoint2+1]-Pd[curPoint2+1])) ;
-        curPoint++;
+        unsigned int cur = startPoint[(unsigned int)p] + i;
+        unsigned int cur2 = 2*cur;
+
+        cX[cur] = oX[cur]*cMoTmp[0][0]+oY[cur]*cMoTmp[0][1]
+                  +oZ[cur]*cMoTmp[0][2] + cMoTmp[0][3];
+        cY[cur] = oX[cur]*cMoTmp[1][0]+oY[cur]*cMoTmp[1][1]
+                  +oZ[cur]*cMoTmp[1][2] + cMoTmp[1][3];
+        cZ[cur] = oX[cur]*cMoTmp[2][0]+oY[cur]*cMoTmp[2][1]
+                  +oZ[cur]*cMoTmp[2][2] + cMoTmp[2][3];
+
+        Pd[cur2] =   u[cur] ;
+        Pd[cur2+1] = v[cur] ;
+
+        P[cur2] =    cX[cur]/cZ[cur]*px + u0 ;
+        P[cur2+1] =  cY[cur]/cZ[cur]*py + v0 ;
+
+        double err_u = P[cur2]-Pd[cur2];
+        double err_v = P[cur2+1]-Pd[cur2+1];
+        r_sum += vpMath::sqr(err_u) + vpMath::sqr(err_v);
+
+        double inv_z = 1/cZ[cur];
+        double X = cX[cur]*inv_z ;
+        double Y = cY[cur]*inv_z ;
+
+        //Rows of the Jacobian of the point: Jv on the view extrinsics,
+        //Jc on the intrinsics
+        double Jv0[6] = { px*(-inv_z), 0, px*(X*inv_z), px*X*Y, -px*(1+X*X), px*Y };
+        double Jc0[4] = { 1, 0, X, 0 };
+        double Jv1[6] = { 0, py*(-inv_z), py*(Y*inv_z), py*(1+Y*Y), -py*X*Y, -py*X };
+        double Jc1[4] = { 0, 1, 0, Y };
+
+        for (unsigned int a = 0; a < 6; a++) {
+          for (unsigned int b = 0; b < 6; b++)
+            Ap[a][b] += Jv0[a]*Jv0[b] + Jv1[a]*Jv1[b];
+          for (unsigned int b = 0; b < 4; b++)
+            Bp[a][b] += Jv0[a]*Jc0[b] + Jv1[a]*Jc1[b];
+          gvp[a] += Jv0[a]*err_u + Jv1[a]*err_v;
+        }
+        for (unsigned int a = 0; a < 4; a++) {
+          for (unsigned int b = 0; b < 4; b++)
+            Cp[a][b] += Jc0[a]*Jc0[b] + Jc1[a]*Jc1[b];
+          gcp[a] += Jc0[a]*err_u + Jc1[a]*err_v;
+        }
       }
     }
+    r = r_sum;
+
+    //Reduction of the intrinsic block and Schur complement on the
+    //intrinsics: S = C - sum B_p^t A_p^-1 B_p
+    vpMatrix C(4,4);
+    vpColVector gc(4);
+    std::vector<vpMatrix> Ainv(nbPose);
+    for (unsigned int p=0; p<nbPose ; p++) {
+      C += Cpart[p];
+      gc += gcPart[p];
+    }
 
-    vpColVector error ;
-    error = P-Pd ;
-    //r = r/nbPointTotal ;
-
-    vpMatrix L(nbPointTotal*2,nbPose6+4) ;
-    curPoint = 0 ; //current point indice
-    for (unsigned int p=0; p<nbPose ; p++)
-    {
-      unsigned int q = 6*p;   
-      for (unsigned int i=0 ; i < nbPoint[p]; i++)
-      {
-        unsigned int curPoint2 = 2*curPoint;
-        unsigned int curPoint21 = curPoint2 + 1;
-
-        double x = cX[curPoint] ;
-        double y = cY[curPoint] ;
-        double z = cZ[curPoint] ;
-
-        double inv_z = 1/z;
-            
-        double X =   x*inv_z ;
-        double Y =   y*inv_z ;
+    vpMatrix S = C;
+    vpColVector gs = gc;
+    for (unsigned int p=0; p<nbPose ; p++) {
+      Ainv[p] = A[p].pseudoInverse(1e-10);
+      vpMatrix BtAinv = B[p].t()*Ainv[p];
+      S -= BtAinv*B[p];
+      gs -= BtAinv*gv[p];
+    }
 
-        //---------------
-        {
-          {
-            L[curPoint2][q] =  px * (-inv_z) ;
-            L[curPoint2][q+1] =  0 ;
-            L[curPoint2][q+2] =  px*(X*inv_z) ;
-            L[curPoint2][q+3] =  px*X*Y ;
-            L[curPoint2][q+4] =  -px*(1+X*X) ;
-            L[curPoint2][q+5] =  px*Y ;
-          }
-          {
-            L[curPoint2][nbPose6]= 1 ;
-            L[curPoint2][nbPose6+1]= 0 ;
-            L[curPoint2][nbPose6+2]= X ;
-            L[curPoint2][nbPose6+3]= 0;
-          }
-          {
-            L[curPoint21][q] = 0 ;
-            L[curPoint21][q+1] = py*(-inv_z) ;
-            L[curPoint21][q+2] = py*(Y*inv_z) ;
-            L[curPoint21][q+3] = py* (1+Y*Y) ;
-            L[curPoint21][q+4] = -py*X*Y ;
-            L[curPoint21][q+5] = -py*X ;
-          }
-          {
-            L[curPoint21][nbPose6]= 0 ;
-            L[curPoint21][nbPose6+1]= 1 ;
-            L[curPoint21][nbPose6+2]= 0;
-            L[curPoint21][nbPose6+3]= Y ;
-          }
+    vpColVector ec = S.pseudoInverse(1e-10)*gs;
 
-        }
-        curPoint++;
-      }    // end interaction
+    vpColVector e(nbPose6+4);
+    for (unsigned int p=0; p<nbPose ; p++) {
+      vpColVector ev = Ainv[p]*(gv[p] - B[p]*ec);
+      for (unsigned int i = 0; i < 6; i++)
+        e[6*p+i] = ev[i];
     }
-    vpMatrix Lp ;
-    Lp = L.pseudoInverse(1e-10) ;
-
-    vpColVector e ;
-    e = Lp*error ;
+    for (unsigned int i = 0; i < 4; i++)
+      e[nbPose6+i] = ec[i];
 
     vpColVector Tc, Tc_v(nbPose6) ;
     Tc = -e*gain ;
@@ -287,58 +287,55 @@ void vpHomography::DLT(const std::vector<double> &xb, const std::vector<double>
       yan = ya;
     }
 
-    vpMatrix A(2*n,9);
     vpColVector h(9);
     vpColVector D(9);
     vpMatrix V(9,9);
 
-    // We need here to compute the SVD on a (n*2)*9 matrix (where n is
-    // the number of points). if n == 4, the matrix has more columns
-    // than rows. This kind of matrix is not supported by GSL for
-    // SVD. The solution is to add an extra line with zeros
-    if (n == 4)
-      A.resize(2*n+1,9);
-
-    // build matrix A
+    // Solve Ah = 0 through the 9x9 normal matrix AtA: the two sparse rows
+    // of each correspondence are accumulated in place (only the upper
+    // triangle, mirrored afterward), so the stacked 2n x 9 measurement
+    // matrix is never built
+    vpMatrix AtA(9,9);
     for(unsigned int i=0; i<n;i++)
     {
-      A[2*i][0]=0;
-      A[2*i][1]=0;
-      A[2*i][2]=0;
-      A[2*i][3]=-xbn[i] ;
-      A[2*i][4]=-ybn[i] ;
-      A[2*i][5]=-1;
-      A[2*i][6]=xbn[i]*yan[i] ;
-      A[2*i][7]=ybn[i]*yan[i];
-      A[2*i][8]=yan[i];
-
-
-      A[2*i+1][0]=xbn[i] ;
-      A[2*i+1][1]=ybn[i] ;
-      A[2*i+1][2]=1;
-      A[2*i+1][3]=0;
-      A[2*i+1][4]=0;
-      A[2*i+1][5]=0;
-      A[2*i+1][6]=-xbn[i]*xan[i];
-      A[2*i+1][7]=-ybn[i]*xan[i];
-      A[2*i+1][8]=-xan[i] ;
-    }
-
-    // Add an extra line with zero.
-    if (n == 4) {
-      for (unsigned int  i=0; i < 9; i ++) {
-        A[2*n][i] = 0;
+      double r1[9], r2[9];
+      r1[0] = 0;      r1[1] = 0;      r1[2] = 0;
+      r1[3] = -xbn[i];
+      r1[4] = -ybn[i];
+      r1[5] = -1;
+      r1[6] = xbn[i]*yan[i];
+      r1[7] = ybn[i]*yan[i];
+      r1[8] = yan[i];
+
+      r2[0] = xbn[i];
+      r2[1] = ybn[i];
+      r2[2] = 1;
+      r2[3] = 0;      r2[4] = 0;      r2[5] = 0;
+      r2[6] = -xbn[i]*xan[i];
+      r2[7] = -ybn[i]*xan[i];
+      r2[8] = -xan[i];
+
+      for(unsigned int j=0; j<9; j++)
+      {
+        double *row = AtA[j];
+        double r1j = r1[j], r2j = r2[j];
+        for(unsigned int k=j; k<9; k++)
+          row[k] += r1j*r1[k] + r2j*r2[k];
       }
     }
+    for(unsigned int j=1; j<9; j++)
+      for(unsigned int k=0; k<j; k++)
+        AtA[j][k] = AtA[k][j];
 
-    // solve Ah = 0
-    // SVD  Decomposition A = UDV^T (destructive wrt A)
-    A.svd(D,V);
+    // Eigen decomposition of the symmetric positive AtA through its SVD:
+    // same vectors as the full SVD of A, on a 9x9 system instead of 2n x 9
+    AtA.svd(D,V);
 
     // on en profite pour effectuer un controle sur le rang de la matrice :
-    // pas plus de 2 valeurs singulieres quasi=0
+    // pas plus de 2 valeurs singulieres quasi=0. The eigenvalues of AtA are
+    // the squared singular values of A, hence the squared threshold.
     int rank=0;
-    for(unsigned int i = 0; i<9;i++) if(D[i]>1e-7) rank++;
+    for(unsigned int i = 0; i<9;i++) if(D[i]>1e-14) rank++;
     if(rank <7)
     {
       vpTRACE(" Rank is : %d, should be 8", rank);
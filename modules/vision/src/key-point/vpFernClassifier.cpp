@@ -41,6 +41,17 @@
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020000) && (VISP_HAVE_OPENCV_VERSION < 0x030000) // Require opencv >= 2.0.0 and < 3.0.0
 
 #include <visp3/vision/vpFernClassifier.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+
+#include <stdio.h>
+#include <string.h>
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
 #include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpColor.h>
@@ -536,6 +547,277 @@ vpFernClassifier::record(const std::string& _objectName, const std::string& _dat
 
 
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Protected-member accessor of the wrapped cv::FernClassifier, used by the
+//! compact serialization (adds no data member, only access).
+struct vpFernClassifierCompactAccess : public cv::FernClassifier
+{
+  std::vector<Feature> &featuresRef() { return features; }
+  std::vector<int> &classCountersRef() { return classCounters; }
+  std::vector<float> &posteriorsRef() { return posteriors; }
+  void setLayout(int nclasses_, int nstructs_, int structSize_, int signatureSize_,
+                 int compressionMethod_, int leavesPerStruct_, const cv::Size &patchSize_)
+  {
+    nclasses = nclasses_;
+    nstructs = nstructs_;
+    structSize = structSize_;
+    signatureSize = signatureSize_;
+    compressionMethod = compressionMethod_;
+    leavesPerStruct = leavesPerStruct_;
+    patchSize = patchSize_;
+  }
+  void getLayout(int &nclasses_, int &nstructs_, int &structSize_, int &signatureSize_,
+                 int &compressionMethod_, int &leavesPerStruct_, cv::Size &patchSize_) const
+  {
+    nclasses_ = nclasses;
+    nstructs_ = nstructs;
+    structSize_ = structSize;
+    signatureSize_ = signatureSize;
+    compressionMethod_ = compressionMethod;
+    leavesPerStruct_ = leavesPerStruct;
+    patchSize_ = patchSize;
+  }
+};
+
+//! Header of the compact fern file: one contiguous block follows it with the
+//! feature tests, the class counters, the quantized posteriors and the model
+//! keypoints, so that loading is a single map plus fixed offset reads.
+struct vpFernCompactHeader
+{
+  unsigned int magic;       //!< 0x46524e43 ("FRNC")
+  unsigned int version;
+  int roi[4];               //!< model ROI x, y, width, height
+  int nclasses;
+  int nstructs;
+  int structSize;
+  int signatureSize;
+  int compressionMethod;
+  int leavesPerStruct;
+  int patchWidth;
+  int patchHeight;
+  unsigned int nbFeatures;
+  unsigned int nbCounters;
+  unsigned int nbPosteriors;
+  unsigned int nbModelPoints;
+  float posteriorScale;     //!< dequantization scale of the uint16 posteriors
+  float posteriorOffset;    //!< dequantization offset
+};
+
+//! Model keypoint record of the compact fern file.
+struct vpFernCompactPoint
+{
+  float x, y, size, angle, response;
+  int octave, class_id;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Save the trained classifier in the compact flat format read back by
+  loadCompact(): a single contiguous block holding the fern layout, the
+  feature tests, the posteriors quantized to 16 bits and the model
+  keypoints. Orders of magnitude faster to load than the text format of
+  record() and several times smaller on disk.
+
+  \param _dataFile : Path of the compact data file to write.
+*/
+void
+vpFernClassifier::saveCompact(const std::string& _dataFile) const
+{
+  const vpFernClassifierCompactAccess &access =
+      static_cast<const vpFernClassifierCompactAccess &>(fernClassifier);
+  vpFernClassifierCompactAccess &access_ = const_cast<vpFernClassifierCompactAccess &>(access);
+
+  vpFernCompactHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = 0x46524e43u;
+  header.version = 1;
+  header.roi[0] = modelROI_Ref.x;
+  header.roi[1] = modelROI_Ref.y;
+  header.roi[2] = modelROI_Ref.width;
+  header.roi[3] = modelROI_Ref.height;
+  cv::Size patch;
+  access.getLayout(header.nclasses, header.nstructs, header.structSize,
+                   header.signatureSize, header.compressionMethod,
+                   header.leavesPerStruct, patch);
+  header.patchWidth = patch.width;
+  header.patchHeight = patch.height;
+  header.nbFeatures = (unsigned int) access_.featuresRef().size();
+  header.nbCounters = (unsigned int) access_.classCountersRef().size();
+  header.nbPosteriors = (unsigned int) access_.posteriorsRef().size();
+  header.nbModelPoints = (unsigned int) modelPoints.size();
+
+  //Quantize the posteriors to 16 bits over their actual range
+  const std::vector<float> &post = access_.posteriorsRef();
+  float minv = 0, maxv = 0;
+  if (!post.empty()) {
+    minv = maxv = post[0];
+    for (size_t i = 1; i < post.size(); i++) {
+      if (post[i] < minv) minv = post[i];
+      if (post[i] > maxv) maxv = post[i];
+    }
+  }
+  header.posteriorOffset = minv;
+  header.posteriorScale = (maxv > minv) ? (maxv - minv)/65535.0f : 1.0f;
+
+  FILE *fd = fopen(_dataFile.c_str(), "wb");
+  if (fd == NULL)
+    throw vpException(vpException::ioError, "Cannot create the compact fern file " + _dataFile);
+
+  bool io_ok = (fwrite(&header, sizeof(header), 1, fd) == 1);
+
+  if (header.nbFeatures > 0) {
+    //cv::FernClassifier::Feature holds the four uchar test coordinates
+    io_ok = io_ok && (fwrite(&access_.featuresRef()[0],
+                             sizeof(cv::FernClassifier::Feature), header.nbFeatures, fd) == header.nbFeatures);
+  }
+  if (header.nbCounters > 0) {
+    io_ok = io_ok && (fwrite(&access_.classCountersRef()[0], sizeof(int), header.nbCounters, fd) == header.nbCounters);
+  }
+  if (header.nbPosteriors > 0) {
+    std::vector<unsigned short> q(header.nbPosteriors);
+    for (size_t i = 0; i < post.size(); i++)
+      q[i] = (unsigned short) vpMath::round((post[i] - header.posteriorOffset)/header.posteriorScale);
+    io_ok = io_ok && (fwrite(&q[0], sizeof(unsigned short), header.nbPosteriors, fd) == header.nbPosteriors);
+  }
+  if (header.nbModelPoints > 0) {
+    std::vector<vpFernCompactPoint> pts(header.nbModelPoints);
+    for (size_t i = 0; i < modelPoints.size(); i++) {
+      pts[i].x = modelPoints[i].pt.x;
+      pts[i].y = modelPoints[i].pt.y;
+      pts[i].size = modelPoints[i].size;
+      pts[i].angle = modelPoints[i].angle;
+      pts[i].response = modelPoints[i].response;
+      pts[i].octave = modelPoints[i].octave;
+      pts[i].class_id = modelPoints[i].class_id;
+    }
+    io_ok = io_ok && (fwrite(&pts[0], sizeof(vpFernCompactPoint), header.nbModelPoints, fd) == header.nbModelPoints);
+  }
+
+  fclose(fd);
+  if (!io_ok)
+    throw vpException(vpException::ioError, "Error while writing the compact fern file " + _dataFile);
+}
+
+/*!
+  Load a classifier saved with saveCompact(). The file is mapped read only
+  (so its clean pages are shared by every process loading the same
+  classifier on the host) and consumed without any parsing: the trained
+  state is rebuilt with one pass per section, the posteriors being expanded
+  from their 16 bit quantization.
+
+  \param _dataFile : Path of the compact data file written by saveCompact().
+*/
+void
+vpFernClassifier::loadCompact(const std::string& _dataFile)
+{
+  const unsigned char *base = NULL;
+  size_t length = 0;
+#if !defined(_WIN32)
+  int fd = open(_dataFile.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw vpException(vpException::ioError, "Cannot open the compact fern file " + _dataFile);
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(vpFernCompactHeader)) {
+    close(fd);
+    throw vpException(vpException::ioError, "Invalid compact fern file " + _dataFile);
+  }
+  length = (size_t) st.st_size;
+  void *map = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    throw vpException(vpException::ioError, "Cannot map the compact fern file " + _dataFile);
+  base = (const unsigned char *) map;
+#else
+  //No mmap on this platform: plain buffered read of the whole block
+  FILE *f = fopen(_dataFile.c_str(), "rb");
+  if (f == NULL)
+    throw vpException(vpException::ioError, "Cannot open the compact fern file " + _dataFile);
+  fseek(f, 0, SEEK_END);
+  long sz = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (sz < (long) sizeof(vpFernCompactHeader)) {
+    fclose(f);
+    throw vpException(vpException::ioError, "Invalid compact fern file " + _dataFile);
+  }
+  length = (size_t) sz;
+  unsigned char *buffer = new unsigned char[length];
+  if (fread(buffer, 1, length, f) != length) {
+    fclose(f);
+    delete[] buffer;
+    throw vpException(vpException::ioError, "Error while reading the compact fern file " + _dataFile);
+  }
+  fclose(f);
+  base = buffer;
+#endif
+
+  const vpFernCompactHeader *header = (const vpFernCompactHeader *) base;
+  size_t expected = sizeof(vpFernCompactHeader)
+      + header->nbFeatures*sizeof(cv::FernClassifier::Feature)
+      + header->nbCounters*sizeof(int)
+      + header->nbPosteriors*sizeof(unsigned short)
+      + header->nbModelPoints*sizeof(vpFernCompactPoint);
+  if (header->magic != 0x46524e43u || header->version != 1 || length < expected) {
+#if !defined(_WIN32)
+    munmap((void *) base, length);
+#else
+    delete[] base;
+#endif
+    throw vpException(vpException::ioError, "Invalid compact fern file " + _dataFile);
+  }
+
+  modelROI.x = header->roi[0];
+  modelROI.y = header->roi[1];
+  modelROI.width = header->roi[2];
+  modelROI.height = header->roi[3];
+
+  vpFernClassifierCompactAccess &access =
+      static_cast<vpFernClassifierCompactAccess &>(fernClassifier);
+  access.setLayout(header->nclasses, header->nstructs, header->structSize,
+                   header->signatureSize, header->compressionMethod,
+                   header->leavesPerStruct,
+                   cv::Size(header->patchWidth, header->patchHeight));
+
+  const unsigned char *ptr = base + sizeof(vpFernCompactHeader);
+
+  access.featuresRef().resize(header->nbFeatures);
+  if (header->nbFeatures > 0)
+    memcpy(&access.featuresRef()[0], ptr, header->nbFeatures*sizeof(cv::FernClassifier::Feature));
+  ptr += header->nbFeatures*sizeof(cv::FernClassifier::Feature);
+
+  access.classCountersRef().resize(header->nbCounters);
+  if (header->nbCounters > 0)
+    memcpy(&access.classCountersRef()[0], ptr, header->nbCounters*sizeof(int));
+  ptr += header->nbCounters*sizeof(int);
+
+  access.posteriorsRef().resize(header->nbPosteriors);
+  {
+    const unsigned short *q = (const unsigned short *) ptr;
+    for (unsigned int i = 0; i < header->nbPosteriors; i++)
+      access.posteriorsRef()[i] = header->posteriorOffset + header->posteriorScale*q[i];
+  }
+  ptr += header->nbPosteriors*sizeof(unsigned short);
+
+  modelPoints.resize(header->nbModelPoints);
+  {
+    const vpFernCompactPoint *pts = (const vpFernCompactPoint *) ptr;
+    for (unsigned int i = 0; i < header->nbModelPoints; i++) {
+      modelPoints[i] = cv::KeyPoint(pts[i].x, pts[i].y, pts[i].size, pts[i].angle,
+                                    pts[i].response, pts[i].octave, pts[i].class_id);
+    }
+  }
+
+#if !defined(_WIN32)
+  munmap((void *) base, length);
+#else
+  delete[] base;
+#endif
+
+  //The detector is rebuilt from the classifier parameters, as in load()
+  cv::LDetector d(radius, threshold, nbOctave, nbView, patchSize, dist);
+  ldetector = d;
+  hasLearn = true;
+}
+
 /*!
   Set the current image. This method allows to convert a image from the ViSP
   format to the OpenCV one. 
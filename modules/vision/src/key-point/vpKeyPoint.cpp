@@ -36,12 +36,24 @@
  *****************************************************************************/
 
 #include <limits>
+#include <limits.h>  //UINT_MAX
+#include <string.h>  //memcpy
 #include <iomanip>
 #include <stdint.h> //uint32_t ; works also with >= VS2010 / _MSC_VER >= 1600
 
 #include <visp3/vision/vpKeyPoint.h>
+#include <visp3/core/vpProfiler.h>
 #include <visp3/core/vpIoTools.h>
 
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
+
+#if defined __SSE4_2__ || (defined _MSC_VER && defined _M_X64)
+#  include <nmmintrin.h>
+#  define VISP_HAVE_POPCNT 1
+#endif
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
 
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -332,19 +344,21 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(),
     m_detectors(), m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
+    m_guidedMatching(false), m_guidedMatchingCam(), m_guidedMatchingPose(), m_guidedMatchingRadius(20.),
     m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(), m_matcherName(matcherName),
     m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
     m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacInliers(), m_ransacOutliers(), m_ransacReprojectionError(6.0),
-    m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(),
+    m_ransacThreshold(0.01), m_savedIndex(), m_savedIndexLoaded(false),
+    m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(),
     m_trainVpPoints(), m_useAffineDetection(false),
     #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
     #endif
     m_useConsensusPercentage(false),
-    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
+    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSavedMatcherIndex(false), m_useSingleMatchFilter(true)
 {
   //Use k-nearest neighbors (knn) to retrieve the two best matches for a keypoint
   //So this is useful only for ratioDistanceThreshold method
@@ -371,19 +385,22 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
     m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
-    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
+    m_filterType(filterType),
+    m_guidedMatching(false), m_guidedMatchingCam(), m_guidedMatchingPose(), m_guidedMatchingRadius(20.),
+    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
     m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85), m_matchingTime(0.),
     m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100), m_objectFilteredPoints(),
     m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacInliers(), m_ransacOutliers(), m_ransacReprojectionError(6.0),
-    m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(),
+    m_ransacThreshold(0.01), m_savedIndex(), m_savedIndexLoaded(false),
+    m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(),
     m_trainVpPoints(), m_useAffineDetection(false),
     #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
     #endif
     m_useConsensusPercentage(false),
-    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSingleMatchFilter(true)
+    m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true), m_useSavedMatcherIndex(false), m_useSingleMatchFilter(true)
 {
   //Use k-nearest neighbors (knn) to retrieve the two best matches for a keypoint
   //So this is useful only for ratioDistanceThreshold method
@@ -538,6 +555,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I,
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  m_savedIndexLoaded = false;
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -639,6 +657,7 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   //Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  m_savedIndexLoaded = false;
 
   _reference_computed = true;
 }
@@ -1634,7 +1653,12 @@ void vpKeyPoint::filterMatches() {
     double stdev = std::sqrt(sq_sum / distance_vec.size() - mean * mean);
     double threshold = min_dist + stdev;
 
-    for(size_t i = 0; i < m_knnMatches.size(); i++) {
+    //The filter configuration is hoisted out of the loop so that the pass
+    //over the matches reduces to one division and one comparison per match
+    const bool useStdFilter = (m_filterType == stdAndRatioDistanceThreshold);
+    const float ratioThreshold = (float) m_matchingRatioThreshold;
+    const size_t nbKnnMatches = m_knnMatches.size();
+    for(size_t i = 0; i < nbKnnMatches; i++) {
       if(m_knnMatches[i].size() >= 2) {
         //Calculate ratio of the descriptor distance between the two nearest neighbors of the keypoint
         float ratio = m_knnMatches[i][0].distance / m_knnMatches[i][1].distance;
@@ -1642,7 +1666,7 @@ void vpKeyPoint::filterMatches() {
 //            / (vecMatches[i][1].distance * vecMatches[i][1].distance));
         double dist = m_knnMatches[i][0].distance;
 
-        if(ratio < m_matchingRatioThreshold || (m_filterType == stdAndRatioDistanceThreshold && dist < threshold)) {
+        if(ratio < ratioThreshold || (useStdFilter && dist < threshold)) {
           m.push_back(cv::DMatch((int) queryKpts.size(), m_knnMatches[i][0].trainIdx, m_knnMatches[i][0].distance));
 
           if(!m_trainPoints.empty()) {
@@ -2791,6 +2815,16 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
 
+  //Restore the persisted matcher index when available: the structure is
+  //read back as saved, so no index retraining happens at load time
+  m_savedIndexLoaded = false;
+  if(m_useSavedMatcherIndex && !append && m_matcherName == "FlannBased") {
+    std::string indexFilename = filename + ".matcher.idx";
+    if(vpIoTools::checkFilename(indexFilename)) {
+      m_savedIndexLoaded = m_savedIndex.load(m_trainDescriptors, indexFilename);
+    }
+  }
+
   //Set _reference_computed to true as we load learning file
   _reference_computed = true;
 }
@@ -2803,10 +2837,274 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
    \param matches : Output list of matches.
    \param elapsedTime : Elapsed time.
  */
+//! Hamming distance between two binary descriptors of nbytes bytes,
+//! popcount based (hardware popcount on SSE4.2 capable builds).
+static inline unsigned int hammingDistance(const unsigned char *a, const unsigned char *b, int nbytes)
+{
+  unsigned int dist = 0;
+  int k = 0;
+#if defined(VISP_HAVE_POPCNT)
+  for(; k+8 <= nbytes; k += 8) {
+    unsigned long long va, vb;
+    memcpy(&va, a+k, 8);
+    memcpy(&vb, b+k, 8);
+    dist += (unsigned int) _mm_popcnt_u64(va ^ vb);
+  }
+#elif defined(__GNUC__)
+  for(; k+8 <= nbytes; k += 8) {
+    unsigned long long va, vb;
+    memcpy(&va, a+k, 8);
+    memcpy(&vb, b+k, 8);
+    dist += (unsigned int) __builtin_popcountll(va ^ vb);
+  }
+#endif
+  for(; k < nbytes; k++) {
+    unsigned char v = (unsigned char) (a[k] ^ b[k]);
+    while(v) {
+      dist++;
+      v = (unsigned char) (v & (v-1));
+    }
+  }
+  return dist;
+}
+
+//! ViSP-native brute force Hamming matcher for binary descriptors: linear
+//! popcount scan of the train set per query with the best and second best
+//! kept in registers, the queries spread over the OpenMP threads so that the
+//! train descriptors stream from the shared cache. No per-query allocation.
+static void bruteForceHammingMatch(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
+                                   bool useKnn, std::vector<std::vector<cv::DMatch> > &knnMatches,
+                                   std::vector<cv::DMatch> &matches)
+{
+  int nbytes = trainDescriptors.cols;
+  int nbTrain = trainDescriptors.rows;
+  int nbQuery = queryDescriptors.rows;
+
+  std::vector<cv::DMatch> best((size_t) nbQuery), second((size_t) nbQuery);
+
+#ifdef VISP_HAVE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for(int q = 0; q < nbQuery; q++) {
+    const unsigned char *qd = queryDescriptors.ptr<unsigned char>(q);
+    unsigned int bestDist = UINT_MAX, secondDist = UINT_MAX;
+    int bestIdx = -1, secondIdx = -1;
+
+    for(int t = 0; t < nbTrain; t++) {
+      unsigned int d = hammingDistance(qd, trainDescriptors.ptr<unsigned char>(t), nbytes);
+      if(d < bestDist) {
+        secondDist = bestDist;
+        secondIdx = bestIdx;
+        bestDist = d;
+        bestIdx = t;
+      } else if(d < secondDist) {
+        secondDist = d;
+        secondIdx = t;
+      }
+    }
+
+    best[(size_t) q] = cv::DMatch(q, bestIdx, (float) bestDist);
+    second[(size_t) q] = cv::DMatch(q, secondIdx, (float) secondDist);
+  }
+
+  if(useKnn) {
+    knnMatches.clear();
+    knnMatches.resize((size_t) nbQuery);
+    for(int q = 0; q < nbQuery; q++) {
+      if(best[(size_t) q].trainIdx >= 0)
+        knnMatches[(size_t) q].push_back(best[(size_t) q]);
+      if(second[(size_t) q].trainIdx >= 0)
+        knnMatches[(size_t) q].push_back(second[(size_t) q]);
+    }
+  } else {
+    matches.clear();
+    for(int q = 0; q < nbQuery; q++) {
+      if(best[(size_t) q].trainIdx >= 0)
+        matches.push_back(best[(size_t) q]);
+    }
+  }
+}
+
+/*!
+   Guided matching driven by a pose prior, see setGuidedMatching(): the
+   reference 3D points are projected with the prior, bucketed in an image
+   grid whose cell equals the search radius, and each query keypoint is
+   matched against the reference descriptors of its 3x3 neighborhood only.
+   Fills the knn structures or the plain matches like the generic path.
+
+   \param trainDescriptors : Train descriptors, one row per reference point.
+   \param queryDescriptors : Query descriptors, one row per detected keypoint.
+   \param matches : Resulting matches.
+ */
+void vpKeyPoint::matchGuided(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
+                             std::vector<cv::DMatch> &matches)
+{
+  const double cell = m_guidedMatchingRadius;
+  const double radius2 = m_guidedMatchingRadius*m_guidedMatchingRadius;
+  const bool binary = (trainDescriptors.type() == CV_8U);
+  const int nbytes = trainDescriptors.cols;
+
+  //Project the reference points with the prior and bucket them in the grid
+  std::vector<double> proj_u((size_t) trainDescriptors.rows), proj_v((size_t) trainDescriptors.rows);
+  std::map<std::pair<int, int>, std::vector<int> > grid;
+  for(int t = 0; t < trainDescriptors.rows; t++) {
+    vpPoint P;
+    P.setWorldCoordinates(m_trainPoints[(size_t) t].x, m_trainPoints[(size_t) t].y, m_trainPoints[(size_t) t].z);
+    P.changeFrame(m_guidedMatchingPose);
+    if(P.get_Z() <= 0) {
+      proj_u[(size_t) t] = -1e12; //behind the camera: never matched
+      proj_v[(size_t) t] = -1e12;
+      continue;
+    }
+    P.projection();
+    double u, v;
+    vpMeterPixelConversion::convertPoint(m_guidedMatchingCam, P.get_x(), P.get_y(), u, v);
+    proj_u[(size_t) t] = u;
+    proj_v[(size_t) t] = v;
+    grid[std::make_pair((int) floor(u/cell), (int) floor(v/cell))].push_back(t);
+  }
+
+  if(m_useKnn) {
+    m_knnMatches.clear();
+    m_knnMatches.resize((size_t) queryDescriptors.rows);
+  } else {
+    matches.clear();
+  }
+
+  for(int q = 0; q < queryDescriptors.rows; q++) {
+    double qu = m_queryKeyPoints[(size_t) q].pt.x;
+    double qv = m_queryKeyPoints[(size_t) q].pt.y;
+    int cu = (int) floor(qu/cell);
+    int cv_ = (int) floor(qv/cell);
+
+    float bestDist = FLT_MAX, secondDist = FLT_MAX;
+    int bestIdx = -1, secondIdx = -1;
+    const unsigned char *qd8 = binary ? queryDescriptors.ptr<unsigned char>(q) : NULL;
+    const float *qdf = binary ? NULL : queryDescriptors.ptr<float>(q);
+
+    for(int du = -1; du <= 1; du++) {
+      for(int dv = -1; dv <= 1; dv++) {
+        std::map<std::pair<int, int>, std::vector<int> >::const_iterator
+            it = grid.find(std::make_pair(cu+du, cv_+dv));
+        if(it == grid.end())
+          continue;
+
+        for(size_t k = 0; k < it->second.size(); k++) {
+          int t = it->second[k];
+          double dx = proj_u[(size_t) t] - qu;
+          double dy = proj_v[(size_t) t] - qv;
+          if(dx*dx + dy*dy > radius2)
+            continue;
+
+          float d;
+          if(binary) {
+            d = (float) hammingDistance(qd8, trainDescriptors.ptr<unsigned char>(t), nbytes);
+          } else {
+            const float *td = trainDescriptors.ptr<float>(t);
+            double acc = 0;
+            for(int j = 0; j < nbytes; j++) {
+              double diff = (double) qdf[j] - (double) td[j];
+              acc += diff*diff;
+            }
+            d = (float) sqrt(acc);
+          }
+
+          if(d < bestDist) {
+            secondDist = bestDist;
+            secondIdx = bestIdx;
+            bestDist = d;
+            bestIdx = t;
+          } else if(d < secondDist) {
+            secondDist = d;
+            secondIdx = t;
+          }
+        }
+      }
+    }
+
+    if(m_useKnn) {
+      if(bestIdx >= 0)
+        m_knnMatches[(size_t) q].push_back(cv::DMatch(q, bestIdx, bestDist));
+      if(secondIdx >= 0)
+        m_knnMatches[(size_t) q].push_back(cv::DMatch(q, secondIdx, secondDist));
+    } else if(bestIdx >= 0) {
+      matches.push_back(cv::DMatch(q, bestIdx, bestDist));
+    }
+  }
+
+  if(m_useKnn) {
+    matches.resize(m_knnMatches.size());
+    std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+  }
+}
+
 void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors,
                        std::vector<cv::DMatch> &matches, double &elapsedTime) {
   double t = vpTime::measureTimeMs();
 
+  if(m_guidedMatching && !m_useMatchTrainToQuery &&
+     (queryDescriptors.type() == CV_8U || queryDescriptors.type() == CV_32F) &&
+     m_trainPoints.size() == (size_t) trainDescriptors.rows &&
+     m_queryKeyPoints.size() == (size_t) queryDescriptors.rows &&
+     queryDescriptors.rows > 0) {
+    //Pose-prior guided matching: each query keypoint is only matched against
+    //the reference descriptors projecting nearby
+    matchGuided(trainDescriptors, queryDescriptors, matches);
+    elapsedTime = vpTime::measureTimeMs() - t;
+    return;
+  }
+
+  if(m_useSavedMatcherIndex && m_savedIndexLoaded && !m_useMatchTrainToQuery) {
+    //Query the restored index directly, with the same knn and distance
+    //conventions as the FlannBased matcher (squared L2 for floating point
+    //descriptors, Hamming for binary ones)
+    int knn = m_useKnn ? 2 : 1;
+    cv::Mat indices, dists;
+    m_savedIndex.knnSearch(queryDescriptors, indices, dists, knn, cv::flann::SearchParams());
+
+    if(m_useKnn) {
+      m_knnMatches.clear();
+      m_knnMatches.resize((size_t) queryDescriptors.rows);
+      for(int r = 0; r < queryDescriptors.rows; r++) {
+        for(int k = 0; k < knn; k++) {
+          int trainIdx = indices.at<int>(r, k);
+          if(trainIdx >= 0) {
+            float dist = (dists.type() == CV_32S) ? (float) dists.at<int>(r, k) : dists.at<float>(r, k);
+            m_knnMatches[(size_t) r].push_back(cv::DMatch(r, trainIdx, dist));
+          }
+        }
+      }
+      matches.resize(m_knnMatches.size());
+      std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+    } else {
+      matches.clear();
+      for(int r = 0; r < queryDescriptors.rows; r++) {
+        int trainIdx = indices.at<int>(r, 0);
+        if(trainIdx >= 0) {
+          float dist = (dists.type() == CV_32S) ? (float) dists.at<int>(r, 0) : dists.at<float>(r, 0);
+          matches.push_back(cv::DMatch(r, trainIdx, dist));
+        }
+      }
+    }
+
+    elapsedTime = vpTime::measureTimeMs() - t;
+    return;
+  }
+
+  if(queryDescriptors.type() == CV_8U && m_matcherName == "BruteForce-Hamming" &&
+     !m_useMatchTrainToQuery && !trainDescriptors.empty() &&
+     trainDescriptors.isContinuous() && queryDescriptors.isContinuous()) {
+    //Binary descriptors are matched by the native popcount matcher instead
+    //of the generic OpenCV path
+    bruteForceHammingMatch(trainDescriptors, queryDescriptors, m_useKnn, m_knnMatches, matches);
+    if(m_useKnn) {
+      matches.resize(m_knnMatches.size());
+      std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
+    }
+    elapsedTime = vpTime::measureTimeMs() - t;
+    return;
+  }
+
   if(m_useKnn) {
     m_knnMatches.clear();
 
@@ -2829,7 +3127,43 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     } else {
       //Match query descriptors to train descriptors
+#ifdef VISP_HAVE_OPENMP
+      int nb_threads = omp_get_max_threads();
+      if(nb_threads > 1 && queryDescriptors.rows >= 2*nb_threads &&
+         m_matcherName.compare(0, 10, "BruteForce") == 0) {
+        //The query descriptors are split across the threads, each slice
+        //matched against a clone of the trained matcher (cloning a brute
+        //force matcher only copies the train descriptor header). The query
+        //indices of the slices are rebased before the merge.
+        std::vector<std::vector<std::vector<cv::DMatch> > > knnMatchesPerThread((size_t) nb_threads);
+
+        //A parallel for over the slices rather than a thread id dispatch:
+        //every slice is matched even if the runtime grants fewer threads
+        #pragma omp parallel for schedule(static)
+        for(int t = 0; t < nb_threads; t++) {
+          int begin = (queryDescriptors.rows * t) / nb_threads;
+          int end = (queryDescriptors.rows * (t+1)) / nb_threads;
+          if(end > begin) {
+            cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(false);
+            matcherTmp->knnMatch(queryDescriptors.rowRange(begin, end), knnMatchesPerThread[(size_t) t], 2);
+            for(size_t i = 0; i < knnMatchesPerThread[(size_t) t].size(); i++) {
+              for(size_t k = 0; k < knnMatchesPerThread[(size_t) t][i].size(); k++) {
+                knnMatchesPerThread[(size_t) t][i][k].queryIdx += begin;
+              }
+            }
+          }
+        }
+
+        for(int t = 0; t < nb_threads; t++) {
+          m_knnMatches.insert(m_knnMatches.end(), knnMatchesPerThread[(size_t) t].begin(),
+                              knnMatchesPerThread[(size_t) t].end());
+        }
+      } else {
+        m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      }
+#else
       m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+#endif
       matches.resize(m_knnMatches.size());
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     }
@@ -2847,7 +3181,37 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       }
     } else {
       //Match query descriptors to train descriptors
+#ifdef VISP_HAVE_OPENMP
+      int nb_threads = omp_get_max_threads();
+      if(nb_threads > 1 && queryDescriptors.rows >= 2*nb_threads &&
+         m_matcherName.compare(0, 10, "BruteForce") == 0) {
+        //Same slicing as the knn path above
+        std::vector<std::vector<cv::DMatch> > matchesPerThread((size_t) nb_threads);
+
+        //Same slice dispatch as the knn path above
+        #pragma omp parallel for schedule(static)
+        for(int t = 0; t < nb_threads; t++) {
+          int begin = (queryDescriptors.rows * t) / nb_threads;
+          int end = (queryDescriptors.rows * (t+1)) / nb_threads;
+          if(end > begin) {
+            cv::Ptr<cv::DescriptorMatcher> matcherTmp = m_matcher->clone(false);
+            matcherTmp->match(queryDescriptors.rowRange(begin, end), matchesPerThread[(size_t) t]);
+            for(size_t i = 0; i < matchesPerThread[(size_t) t].size(); i++) {
+              matchesPerThread[(size_t) t][i].queryIdx += begin;
+            }
+          }
+        }
+
+        for(int t = 0; t < nb_threads; t++) {
+          matches.insert(matches.end(), matchesPerThread[(size_t) t].begin(),
+                         matchesPerThread[(size_t) t].end());
+        }
+      } else {
+        m_matcher->match(queryDescriptors, matches);
+      }
+#else
       m_matcher->match(queryDescriptors, matches);
+#endif
     }
   }
   elapsedTime = vpTime::measureTimeMs() - t;
@@ -2923,11 +3287,20 @@ unsigned int vpKeyPoint::matchPoint(const vpImage<unsigned char> &I,
       }
     }
   } else {
-    detect(I, m_queryKeyPoints, m_detectionTime, rectangle);
-    extract(I, m_queryKeyPoints, m_queryDescriptors, m_extractionTime);
+    {
+      VP_PROFILE_SCOPE("keypoint.detect");
+      detect(I, m_queryKeyPoints, m_detectionTime, rectangle);
+    }
+    {
+      VP_PROFILE_SCOPE("keypoint.extract");
+      extract(I, m_queryKeyPoints, m_queryDescriptors, m_extractionTime);
+    }
   }
 
-  match(m_trainDescriptors, m_queryDescriptors, m_matches, m_matchingTime);
+  {
+    VP_PROFILE_SCOPE("keypoint.match");
+    match(m_trainDescriptors, m_queryDescriptors, m_matches, m_matchingTime);
+  }
 
   if(m_filterType != noFilterMatching) {
     m_queryFilteredKeyPoints.clear();
@@ -3496,7 +3869,7 @@ void vpKeyPoint::reset() {
   m_objectFilteredPoints.clear();
   m_poseTime = 0.0; m_queryDescriptors = cv::Mat(); m_queryFilteredKeyPoints.clear(); m_queryKeyPoints.clear();
   m_ransacConsensusPercentage = 20.0; m_ransacInliers.clear(); m_ransacOutliers.clear(); m_ransacReprojectionError = 6.0;
-  m_ransacThreshold = 0.01; m_trainDescriptors = cv::Mat(); m_trainKeyPoints.clear(); m_trainPoints.clear();
+  m_ransacThreshold = 0.01; m_savedIndexLoaded = false; m_trainDescriptors = cv::Mat(); m_trainKeyPoints.clear(); m_trainPoints.clear();
   m_trainVpPoints.clear(); m_useAffineDetection = false;
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
   m_useBruteForceCrossCheck = true;
@@ -3947,6 +4320,19 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
     std::cerr << "Error: libxml2 is required !" << std::endl;
 #endif
   }
+
+  //Persist the matcher index next to the learning data so that
+  //loadLearningData() restores a ready-to-query matcher without retraining
+  if(m_useSavedMatcherIndex && m_matcherName == "FlannBased" && !m_trainDescriptors.empty()) {
+    std::string indexFilename = filename + ".matcher.idx";
+    if(m_trainDescriptors.type() == CV_8U) {
+      cv::flann::Index index(m_trainDescriptors, cv::flann::LshIndexParams(12, 20, 2), cvflann::FLANN_DIST_HAMMING);
+      index.save(indexFilename);
+    } else {
+      cv::flann::Index index(m_trainDescriptors, cv::flann::KDTreeIndexParams());
+      index.save(indexFilename);
+    }
+  }
 }
 
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -1006,8 +1006,7 @@ int	qrsolv (int n, double *r, int ldr, int *ipvt, double *diag, double *qtb,
  * En cas de succes, la valeur zero est retournee.
  * Sinon la valeur -1 est retournee.
  */
-int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
-			       double *jac, int ldfjac, int iflag), int m, int n, double *x,
+int	lmder (vpLevenbergMarquartd::vpFcn ptr_fcn, void *user_data, int m, int n, double *x,
 	       double *fvec, double *fjac, int ldfjac, double ftol, double xtol,
 	       double gtol, unsigned int maxfev, double *diag, int mode,
 	       const double factor, int nprint, int *info, unsigned int *nfev,
@@ -1062,7 +1061,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
     iflag = 0;
 
     if (nprint > 0)
-      (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+      (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
     return (count);
   }
@@ -1082,7 +1081,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
         iflag = 0;
 
         if (nprint > 0)
-          (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+          (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
         return (count);
       }
@@ -1095,7 +1094,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
    */
   iflag = 1;
 
-  (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+  (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
 
   *nfev = 1;
@@ -1111,7 +1110,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
     iflag = 0;
 
     if (nprint > 0)
-      (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+      (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
     return (count);
   }
@@ -1138,7 +1137,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
 
     iflag = 2;
 
-    (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+    (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
     (*njev) ++;
 
@@ -1153,7 +1152,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
       iflag = 0;
 
       if (nprint > 0)
-        (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+        (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
       return (count);
     }
@@ -1165,7 +1164,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
     {
       iflag = 0;
       if ((iter-1) % nprint == 0)
-        (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+        (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
       if (iflag < 0)
       {
@@ -1178,7 +1177,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
         iflag = 0;
 
         if (nprint > 0)
-          (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+          (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
         return (count);
       }
@@ -1295,7 +1294,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
       iflag = 0;
 
       if (nprint > 0)
-        (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+        (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
       return (count);
     }
@@ -1349,7 +1348,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
        */
 
       iflag = 1;
-      (*ptr_fcn)(m, n, wa2, wa4, fjac, ldfjac, iflag);
+      (*ptr_fcn)(user_data, m, n, wa2, wa4, fjac, ldfjac, iflag);
 
       (*nfev)++;
 
@@ -1362,7 +1361,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
         iflag = 0;
 
         if (nprint > 0)
-          (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+          (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
         return (count);
       }
@@ -1484,7 +1483,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
         iflag = 0;
 
         if (nprint > 0)
-          (*ptr_fcn)(m,n,x,fvec,fjac,ldfjac, iflag);
+          (*ptr_fcn)(user_data, m,n,x,fvec,fjac,ldfjac, iflag);
 
         return (count);
       }
@@ -1517,7 +1516,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
         iflag = 0;
 
         if (nprint > 0)
-          (*ptr_fcn)(m, n, x, fvec, fjac, ldfjac, iflag);
+          (*ptr_fcn)(user_data, m, n, x, fvec, fjac, ldfjac, iflag);
 
         return (count);
       }
@@ -1608,8 +1607,7 @@ int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
  * Sinon, la valeur -1.
  *
  */
-int lmder1 (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
-			    double *jac, int ldfjac, int iflag),
+int lmder1 (vpLevenbergMarquartd::vpFcn ptr_fcn, void *user_data,
 	    int m, int n, double *x, double *fvec, double *fjac,
 	    int ldfjac, double tol, int *info, int *ipvt, int lwa, double *wa)
 {
@@ -1639,7 +1637,7 @@ int lmder1 (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
   mode = 1;
   nprint = 0;
 
-  lmder (ptr_fcn , m, n, x, fvec, fjac, ldfjac, ftol, xtol, gtol, maxfev, wa,
+  lmder (ptr_fcn, user_data, m, n, x, fvec, fjac, ldfjac, ftol, xtol, gtol, maxfev, wa,
 	 mode, factor, nprint, info, &nfev, &njev, ipvt, &wa[n], &wa[2 * n],
 	 &wa[3 * n], &wa[4 * n], &wa[5 * n]);
 
@@ -1649,6 +1647,89 @@ int lmder1 (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
   return (0);
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Adapter forwarding the historic context free callbacks to the user data
+//! aware core.
+struct vpLmderLegacyFcn {
+  void (*fcn)(int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int iflag);
+};
+
+static void lmderLegacyTrampoline(void *user_data, int m, int n, double *xc, double *fvecc,
+                                  double *jac, int ldfjac, int iflag)
+{
+  ((vpLmderLegacyFcn *) user_data)->fcn(m, n, xc, fvecc, jac, ldfjac, iflag);
+}
+#endif
+
+/*
+ * Historic entry point without user data, kept for compatibility: the
+ * callback is forwarded through an adapter to the user data aware core.
+ */
+int	lmder (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
+			       double *jac, int ldfjac, int iflag), int m, int n, double *x,
+	       double *fvec, double *fjac, int ldfjac, double ftol, double xtol,
+	       double gtol, unsigned int maxfev, double *diag, int mode,
+	       const double factor, int nprint, int *info, unsigned int *nfev,
+	       int *njev, int *ipvt, double *qtf, double *wa1, double *wa2,
+	       double *wa3, double *wa4)
+{
+  vpLmderLegacyFcn legacy;
+  legacy.fcn = ptr_fcn;
+  return lmder(lmderLegacyTrampoline, (void *) &legacy, m, n, x, fvec, fjac, ldfjac,
+               ftol, xtol, gtol, maxfev, diag, mode, factor, nprint, info, nfev,
+               njev, ipvt, qtf, wa1, wa2, wa3, wa4);
+}
+
+/*
+ * Historic entry point without user data, kept for compatibility.
+ */
+int lmder1 (void (*ptr_fcn)(int m, int n, double *xc, double *fvecc,
+			    double *jac, int ldfjac, int iflag),
+	    int m, int n, double *x, double *fvec, double *fjac,
+	    int ldfjac, double tol, int *info, int *ipvt, int lwa, double *wa)
+{
+  vpLmderLegacyFcn legacy;
+  legacy.fcn = ptr_fcn;
+  return lmder1(lmderLegacyTrampoline, (void *) &legacy, m, n, x, fvec, fjac,
+                ldfjac, tol, info, ipvt, lwa, wa);
+}
+
+/*!
+  Minimize the sum of squares of the m residuals with the analytic Jacobian
+  provided by the callback, reusing the work arrays owned by the solver
+  across calls (they only grow). Same contract as lmder1() with the default
+  control settings; the integer and double workspaces are managed here.
+
+  \param ptr_fcn : Cost and analytic Jacobian callback.
+  \param user_data : Opaque pointer handed back to the callback.
+  \param m : Number of residuals.
+  \param n : Number of parameters (n <= m).
+  \param x : In/out parameter vector of size n.
+  \param fvec : Output residual vector of size m.
+  \param fjac : Output Jacobian factorization storage, ldfjac x n.
+  \param ldfjac : Leading size of fjac (>= m).
+  \param tol : Termination tolerance.
+  \param info : Termination status, see lmder1().
+
+  \return 0 on success, -1 on invalid input.
+*/
+int vpLevenbergMarquartd::solve(vpFcn ptr_fcn, void *user_data, int m, int n, double *x,
+                                double *fvec, double *fjac, int ldfjac, double tol, int *info)
+{
+  if (n <= 0 || m < n)
+    return -1;
+
+  if (m_ipvt.size() < (size_t) n)
+    m_ipvt.resize((size_t) n);
+
+  int lwa = 5*n + m;
+  if (m_wa.size() < (size_t) lwa)
+    m_wa.resize((size_t) lwa);
+
+  return lmder1(ptr_fcn, user_data, m, n, x, fvec, fjac, ldfjac, tol, info,
+                &m_ipvt[0], lwa, &m_wa[0]);
+}
+
 #undef TRUE
 #undef FALSE
 
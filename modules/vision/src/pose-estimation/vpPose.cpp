@@ -90,10 +90,14 @@ vpPose::init()
 
 /*! Defaukt constructor. */
 vpPose::vpPose()
-  : npt(0), listP(), residual(0), lambda(0.25), vvsIterMax(200), c3d(),
-    computeCovariance(false), covarianceMatrix(),
+  : npt(0), listP(), residual(0), lambda(0.25), vvsIterMax(200),
+    m_vvsResidualThreshold(0.), m_vvsUpdateThreshold(0.), m_vvsTimeBudget(0.),
+    m_vvsPriorSet(false), m_vvsPriorInformation(), c3d(),
+    computeCovariance(false), covarianceMatrix(), m_covModel(0),
+    m_covCMoPrev(), m_covError(), m_covJacobian(), m_covV(), m_covWeights(),
     ransacNbInlierConsensus(4), ransacMaxTrials(1000), ransacInliers(), ransacInlierIndex(), ransacThreshold(0.0001),
-    distanceToPlaneForCoplanarityTest(0.001), removeRansacDegeneratePoints(false)
+    distanceToPlaneForCoplanarityTest(0.001), removeRansacDegeneratePoints(false),
+    m_lmSolver()
 {
 #if (DEBUG_LEVEL1)
   std::cout << "begin vpPose::vpPose() " << std::endl ;
@@ -514,6 +518,11 @@ vpPose::computePose(vpPoseMethodType methode, vpHomogeneousMatrix& cMo, bool (*f
   case LOWE :
   case VIRTUAL_VS:
     break ;
+  case P3P :
+    {
+      poseP3P(cMo) ;
+    }
+    break ;
   }
 
   switch (methode)
@@ -521,6 +530,7 @@ vpPose::computePose(vpPoseMethodType methode, vpHomogeneousMatrix& cMo, bool (*f
   case LAGRANGE :
   case DEMENTHON :
   case RANSAC :
+  case P3P :
     break ;
   case VIRTUAL_VS:
   case LAGRANGE_VIRTUAL_VS:
@@ -45,6 +45,7 @@
 // fonctions de minimisation de Levenberg Marquartd
 #include <visp3/vision/vpLevenbergMarquartd.h>
 #include <visp3/vision/vpPose.h>
+#include <visp3/vision/vpPoseException.h>
 
 #define NBR_PAR	6
 #define X3_SIZE	3
@@ -80,18 +81,22 @@
 #define	MIJ(m,i,j,s)	((m) + ((long) (i) * (long) (s)) + (long) (j))
 #define NBPTMAX 50
 
-// Je hurle d'horreur devant ces variable globale...
-static double	XI[NBPTMAX],YI[NBPTMAX];
-static double	XO[NBPTMAX],YO[NBPTMAX],ZO[NBPTMAX];
+//! Correspondences of one poseLowe() run, handed to the cost callback
+//! through the solver user data pointer (no more file scope globals, so the
+//! computation is reentrant).
+struct vpPoseLoweData {
+  double XI[NBPTMAX], YI[NBPTMAX];
+  double XO[NBPTMAX], YO[NBPTMAX], ZO[NBPTMAX];
+};
 
 
 #define MINI 0.001
 #define MINIMUM 0.000001
 
-void eval_function(int npt,double *xc,double *f);
-void	fcn (int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int iflag);
+static void eval_function(const vpPoseLoweData *data, int npt, double *xc, double *f);
+static void fcn (void *user_data, int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int iflag);
 
-void eval_function(int npt,double *xc,double *f)
+static void eval_function(const vpPoseLoweData *data, int npt, double *xc, double *f)
 {
   int i;
   double u[3];
@@ -104,11 +109,11 @@ void eval_function(int npt,double *xc,double *f)
   //  rot_mat(u,rd);          /* matrice de rotation correspondante   */
   for (i=0;i<npt;i++)
   {
-    double x = rd[0][0]*XO[i] + rd[0][1]*YO[i] + rd[0][2]*ZO[i] + xc[0];
-    double y = rd[1][0]*XO[i] + rd[1][1]*YO[i] + rd[1][2]*ZO[i] + xc[1];
-    double z = rd[2][0]*XO[i] + rd[2][1]*YO[i] + rd[2][2]*ZO[i] + xc[2];
-    f[i] = x/z - XI[i];
-    f[npt+i] = y/z - YI[i];
+    double x = rd[0][0]*data->XO[i] + rd[0][1]*data->YO[i] + rd[0][2]*data->ZO[i] + xc[0];
+    double y = rd[1][0]*data->XO[i] + rd[1][1]*data->YO[i] + rd[1][2]*data->ZO[i] + xc[1];
+    double z = rd[2][0]*data->XO[i] + rd[2][1]*data->YO[i] + rd[2][2]*data->ZO[i] + xc[2];
+    f[i] = x/z - data->XI[i];
+    f[npt+i] = y/z - data->YI[i];
     //    std::cout << f[i] << "   " << f[i+1] << std::endl ;
   }
 }
@@ -140,8 +145,9 @@ void eval_function(int npt,double *xc,double *f)
 * 1.01 - 06/07/95 - Modifications.
 * 2.00 - 24/10/95 - Tableau jac monodimensionnel.
 */
-void	fcn (int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int iflag)
+static void fcn (void *user_data, int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int iflag)
 {
+  const vpPoseLoweData *data = (const vpPoseLoweData *) user_data;
   double	u[X3_SIZE];// rd[X3_SIZE][X3_SIZE],
   vpRotationMatrix rd ;
   int	npt;
@@ -149,7 +155,7 @@ void	fcn (int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int
   if (m < n) printf("pas assez de points\n");
   npt = m / 2;
 
-  if (iflag == 1) eval_function (npt, xc, fvecc);
+  if (iflag == 1) eval_function (data, npt, xc, fvecc);
   else if (iflag == 2)
   {
     double	u1, u2, u3;
@@ -175,9 +181,9 @@ void	fcn (int m, int n, double *xc, double *fvecc, double *jac, int ldfjac, int
 
     for (int i = 0; i < npt; i++)
     {
-      double x = XO[i];
-      double y = YO[i];     /* coordonnees du point i	*/
-      double z = ZO[i];
+      double x = data->XO[i];
+      double y = data->YO[i];     /* coordonnees du point i	*/
+      double z = data->ZO[i];
 
       /* coordonnees du point i dans le repere camera	*/
       double rx = rd[0][0] * x + rd[0][1] * y + rd[0][2] * z + xc[0];
@@ -281,18 +287,21 @@ vpPose::poseLowe(vpHomogeneousMatrix & cMo)
   std::cout << "begin CCalcuvpPose::PoseLowe(...) " << std::endl;
 #endif
   int	n, m;	/* nombre d'elements dans la matrice jac */
-  int	lwa;	/* taille du vecteur wa */
   int	ldfjac;	/* taille maximum d'une ligne de jac */
-  int   info, ipvt[NBR_PAR];
+  int   info;
   int	tst_lmder;
   double f[2 * NBPTMAX], sol[NBR_PAR];
-  double	tol, jac[NBR_PAR][2 * NBPTMAX], wa[2 * NBPTMAX + 50];
+  double	tol, jac[NBR_PAR][2 * NBPTMAX];
   //  double	u[3];	/* vecteur de rotation */
   //  double	rd[3][3]; /* matrice de rotation */
 
+  if (npt > NBPTMAX) {
+    throw(vpPoseException(vpPoseException::poseError,
+          "Lowe pose computation is limited to %d points", NBPTMAX));
+  }
+
   n = NBR_PAR;		/* nombres d'inconnues	*/
   m = (int)(2 * npt);		/* nombres d'equations	*/
-  lwa = 2 * NBPTMAX + 50;  /* taille du vecteur de travail	*/
   ldfjac = 2 * NBPTMAX;	/* nombre d'elements max sur une ligne	*/
   tol = std::numeric_limits<double>::epsilon();		/* critere d'arret	*/
 
@@ -309,19 +318,21 @@ vpPose::poseLowe(vpHomogeneousMatrix & cMo)
     sol[i+3] = u[i];
   }
 
+  vpPoseLoweData data;
+
   vpPoint P ;
   unsigned int i_=0;
   for (std::list<vpPoint>::const_iterator it = listP.begin(); it != listP.end(); ++it)
   {
     P = *it;
-    XI[i_] = P.get_x();//*cam.px + cam.xc ;
-    YI[i_] = P.get_y() ;//;*cam.py + cam.yc ;
-    XO[i_] = P.get_oX();
-    YO[i_] = P.get_oY();
-    ZO[i_] = P.get_oZ();
+    data.XI[i_] = P.get_x();//*cam.px + cam.xc ;
+    data.YI[i_] = P.get_y() ;//;*cam.py + cam.yc ;
+    data.XO[i_] = P.get_oX();
+    data.YO[i_] = P.get_oY();
+    data.ZO[i_] = P.get_oZ();
     ++i_;
   }
-  tst_lmder = lmder1 (&fcn, m, n, sol, f, &jac[0][0], ldfjac, tol, &info, ipvt, lwa, wa);
+  tst_lmder = m_lmSolver.solve(&fcn, &data, m, n, sol, f, &jac[0][0], ldfjac, tol, &info);
   if (tst_lmder == -1)
   {
     std::cout <<  " in CCalculPose::PoseLowe(...) : " ;
@@ -0,0 +1,339 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Closed form P3P pose computation.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include <visp3/vision/vpPose.h>
+#include <visp3/vision/vpPoseException.h>
+#include <visp3/core/vpMath.h>
+
+/*!
+  \file vpPoseP3P.cpp
+  \brief Closed form P3P pose computation (Grunert's three point resection
+  solved through its quartic), used standalone and as the hypothesis engine
+  of the RANSAC pose estimation.
+*/
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+//! One real root of the cubic z^3 + a2 z^2 + a1 z + a0 (Cardano).
+static double cubicRealRoot(double a2, double a1, double a0)
+{
+  double p = a1 - a2*a2/3.0;
+  double q = 2.0*a2*a2*a2/27.0 - a2*a1/3.0 + a0;
+  double disc = q*q/4.0 + p*p*p/27.0;
+
+  double t;
+  if (disc >= 0) {
+    double sd = sqrt(disc);
+    double u = -q/2.0 + sd;
+    double v = -q/2.0 - sd;
+    t = (u >= 0 ? pow(u, 1.0/3.0) : -pow(-u, 1.0/3.0))
+      + (v >= 0 ? pow(v, 1.0/3.0) : -pow(-v, 1.0/3.0));
+  }
+  else {
+    double r = sqrt(-p*p*p/27.0);
+    double phi = acos(-q/(2.0*r));
+    t = 2.0*pow(r, 1.0/3.0)*cos(phi/3.0);
+  }
+  return t - a2/3.0;
+}
+
+//! Real roots of q[4] v^4 + q[3] v^3 + q[2] v^2 + q[1] v + q[0] (Ferrari,
+//! followed by a Newton polish on the original quartic). Returns the number
+//! of roots written in v_roots (at most 4).
+static unsigned int quarticRealRoots(const double q[5], double *v_roots)
+{
+  unsigned int nb = 0;
+
+  if (std::fabs(q[4]) < std::numeric_limits<double>::epsilon())
+    return 0;
+
+  double a3 = q[3]/q[4], a2 = q[2]/q[4], a1 = q[1]/q[4], a0 = q[0]/q[4];
+
+  // Depressed quartic y^4 + p y^2 + r y + s with v = y - a3/4
+  double p = a2 - 3.0*a3*a3/8.0;
+  double r = a1 - a3*a2/2.0 + a3*a3*a3/8.0;
+  double s = a0 - a3*a1/4.0 + a3*a3*a2/16.0 - 3.0*a3*a3*a3*a3/256.0;
+
+  // Resolvent cubic z^3 - p z^2 - 4 s z + (4 p s - r^2) = 0
+  double z = cubicRealRoot(-p, -4.0*s, 4.0*p*s - r*r);
+
+  double m = z - p;
+  if (m < 0 && m > -1e-10)
+    m = 0;
+  if (m < 0)
+    return 0;
+
+  double y_roots[4];
+  unsigned int nb_y = 0;
+  if (m < std::numeric_limits<double>::epsilon()) {
+    // y^4 + p y^2 + s = 0 (r is negligible here)
+    double disc = z*z/4.0 - s;
+    if (disc < 0)
+      disc = 0;
+    double t1 = z/2.0 + sqrt(disc);
+    double t2 = z/2.0 - sqrt(disc);
+    if (t1 >= 0) { y_roots[nb_y++] = sqrt(t1); y_roots[nb_y++] = -sqrt(t1); }
+    if (t2 >= 0) { y_roots[nb_y++] = sqrt(t2); y_roots[nb_y++] = -sqrt(t2); }
+  }
+  else {
+    double sqrtm = sqrt(m);
+    // y^2 + sqrtm y + (z/2 - r/(2 sqrtm)) = 0 and
+    // y^2 - sqrtm y + (z/2 + r/(2 sqrtm)) = 0
+    double c1 = z/2.0 - r/(2.0*sqrtm);
+    double c2 = z/2.0 + r/(2.0*sqrtm);
+    double d1 = m/4.0 - c1;
+    double d2 = m/4.0 - c2;
+    if (d1 >= 0) {
+      y_roots[nb_y++] = -sqrtm/2.0 + sqrt(d1);
+      y_roots[nb_y++] = -sqrtm/2.0 - sqrt(d1);
+    }
+    if (d2 >= 0) {
+      y_roots[nb_y++] = sqrtm/2.0 + sqrt(d2);
+      y_roots[nb_y++] = sqrtm/2.0 - sqrt(d2);
+    }
+  }
+
+  for (unsigned int i = 0; i < nb_y; i++) {
+    double v = y_roots[i] - a3/4.0;
+
+    // Newton polish on the original quartic
+    for (unsigned int it = 0; it < 5; it++) {
+      double f = ((q[4]*v + q[3])*v + q[2])*v*v + q[1]*v + q[0];
+      double df = ((4.0*q[4]*v + 3.0*q[3])*v + 2.0*q[2])*v + q[1];
+      if (std::fabs(df) < std::numeric_limits<double>::epsilon())
+        break;
+      v -= f/df;
+    }
+
+    // Keep distinct roots only
+    bool duplicate = false;
+    for (unsigned int j = 0; j < nb; j++)
+      if (std::fabs(v_roots[j] - v) < 1e-10)
+        duplicate = true;
+    if (!duplicate)
+      v_roots[nb++] = v;
+  }
+
+  return nb;
+}
+
+//! Product of two polynomials given by their coefficient arrays
+//! (little-endian, sizes na and nb), written into pc of size na+nb-1.
+static void polyMult(const double *pa, unsigned int na, const double *pb, unsigned int nb, double *pc)
+{
+  for (unsigned int k = 0; k < na+nb-1; k++)
+    pc[k] = 0;
+  for (unsigned int i = 0; i < na; i++)
+    for (unsigned int j = 0; j < nb; j++)
+      pc[i+j] += pa[i]*pb[j];
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Compute the pose in closed form from three 2D-3D point correspondences
+  (Grunert's three point resection): the distances of the three points to
+  the optical center are the positive solutions of a quartic, each giving a
+  pose candidate by rigid alignment; the candidate minimizing the residual
+  over all the points of the list is kept, so that a fourth point (as in a
+  RANSAC minimal sample) disambiguates the up-to-four solutions. Orders of
+  magnitude cheaper per call than the iterative methods, which makes it the
+  natural hypothesis engine for poseRansac().
+
+  At least 3 points are required; with exactly 3 the returned candidate is
+  the one with the smallest residual on these points.
+
+  \param cMo : The computed pose.
+
+  \throw vpPoseException::notEnoughPointError if there are less than 3
+  points, or vpPoseException::poseError if no geometrically valid solution
+  exists (e.g. collinear points).
+*/
+void vpPose::poseP3P(vpHomogeneousMatrix &cMo)
+{
+  if (npt < 3) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError,
+          "At least 3 points are required by the P3P pose computation"));
+  }
+
+  // The three first points of the list define the resection problem
+  vpPoint P[3];
+  std::list<vpPoint>::const_iterator it = listP.begin();
+  for (unsigned int i = 0; i < 3; i++, ++it)
+    P[i] = *it;
+
+  // Unit bearing vectors of the three image points
+  double f[3][3];
+  for (unsigned int i = 0; i < 3; i++) {
+    double norm = sqrt(vpMath::sqr(P[i].get_x()) + vpMath::sqr(P[i].get_y()) + 1.0);
+    f[i][0] = P[i].get_x()/norm;
+    f[i][1] = P[i].get_y()/norm;
+    f[i][2] = 1.0/norm;
+  }
+
+  // Distances between the world points: a opposite to P1, b to P2, c to P3
+  double a = sqrt(vpMath::sqr(P[1].get_oX()-P[2].get_oX()) + vpMath::sqr(P[1].get_oY()-P[2].get_oY()) + vpMath::sqr(P[1].get_oZ()-P[2].get_oZ()));
+  double b = sqrt(vpMath::sqr(P[0].get_oX()-P[2].get_oX()) + vpMath::sqr(P[0].get_oY()-P[2].get_oY()) + vpMath::sqr(P[0].get_oZ()-P[2].get_oZ()));
+  double c = sqrt(vpMath::sqr(P[0].get_oX()-P[1].get_oX()) + vpMath::sqr(P[0].get_oY()-P[1].get_oY()) + vpMath::sqr(P[0].get_oZ()-P[1].get_oZ()));
+
+  if (a < std::numeric_limits<double>::epsilon() ||
+      b < std::numeric_limits<double>::epsilon() ||
+      c < std::numeric_limits<double>::epsilon()) {
+    throw(vpPoseException(vpPoseException::poseError,
+          "P3P pose computation: two of the three points coincide"));
+  }
+
+  // Cosines of the angles between the bearing vectors: alpha between f2 and
+  // f3 (opposite to side a), beta between f1 and f3, gamma between f1 and f2
+  double cos_alpha = f[1][0]*f[2][0] + f[1][1]*f[2][1] + f[1][2]*f[2][2];
+  double cos_beta  = f[0][0]*f[2][0] + f[0][1]*f[2][1] + f[0][2]*f[2][2];
+  double cos_gamma = f[0][0]*f[1][0] + f[0][1]*f[1][1] + f[0][2]*f[1][2];
+
+  // With s2 = u s1 and s3 = v s1, eliminating u gives the quartic in v:
+  //   N(v)^2 - 2 cos(gamma) N(v) den(v) + G(v) den(v)^2 = 0
+  // where u = N(v)/den(v). The coefficients are assembled by polynomial
+  // products so that no hand expanded formula is involved.
+  double D = (a*a - c*c)/(b*b);
+  double N[3]   = { -(1.0 + D), 2.0*cos_beta*D, 1.0 - D };
+  double den[2] = { -2.0*cos_gamma, 2.0*cos_alpha };
+  double G[3]   = { 1.0 - (c*c)/(b*b), 2.0*(c*c)/(b*b)*cos_beta, -(c*c)/(b*b) };
+
+  double NN[5], Nden[4], denden[3], Gdenden[5];
+  polyMult(N, 3, N, 3, NN);
+  polyMult(N, 3, den, 2, Nden);
+  polyMult(den, 2, den, 2, denden);
+  polyMult(G, 3, denden, 3, Gdenden);
+
+  double quartic[5];
+  for (unsigned int k = 0; k < 5; k++) {
+    quartic[k] = NN[k] + Gdenden[k];
+    if (k < 4)
+      quartic[k] -= 2.0*cos_gamma*Nden[k];
+  }
+
+  double v_roots[4];
+  unsigned int nb_roots = quarticRealRoots(quartic, v_roots);
+
+  // Each admissible root gives a pose candidate by rigid alignment of the
+  // world triangle on the three camera frame points s_i f_i
+  bool found = false;
+  double best_residual = std::numeric_limits<double>::max();
+
+  for (unsigned int iroot = 0; iroot < nb_roots; iroot++) {
+    double v = v_roots[iroot];
+    if (v <= std::numeric_limits<double>::epsilon())
+      continue;
+
+    double den_v = den[1]*v + den[0];
+    if (std::fabs(den_v) < std::numeric_limits<double>::epsilon())
+      continue;
+    double u = (N[2]*v*v + N[1]*v + N[0])/den_v;
+    if (u <= std::numeric_limits<double>::epsilon())
+      continue;
+
+    double s1_arg = 1.0 + v*v - 2.0*v*cos_beta;
+    if (s1_arg <= std::numeric_limits<double>::epsilon())
+      continue;
+    double s1 = b/sqrt(s1_arg);
+    double s2 = u*s1;
+    double s3 = v*s1;
+
+    // Camera frame points
+    double C[3][3];
+    for (unsigned int j = 0; j < 3; j++) {
+      C[0][j] = s1*f[0][j];
+      C[1][j] = s2*f[1][j];
+      C[2][j] = s3*f[2][j];
+    }
+
+    // Rigid alignment by matching the triads built on both triangles
+    vpColVector w1(3), w2(3), w3(3), c1(3), c2(3), c3(3);
+    for (unsigned int j = 0; j < 3; j++)
+      c1[j] = C[1][j] - C[0][j];
+    w1[0] = P[1].get_oX() - P[0].get_oX();
+    w1[1] = P[1].get_oY() - P[0].get_oY();
+    w1[2] = P[1].get_oZ() - P[0].get_oZ();
+
+    vpColVector wd(3), cd(3);
+    for (unsigned int j = 0; j < 3; j++)
+      cd[j] = C[2][j] - C[0][j];
+    wd[0] = P[2].get_oX() - P[0].get_oX();
+    wd[1] = P[2].get_oY() - P[0].get_oY();
+    wd[2] = P[2].get_oZ() - P[0].get_oZ();
+
+    w3 = vpColVector::crossProd(w1, wd);
+    c3 = vpColVector::crossProd(c1, cd);
+    if (w3.euclideanNorm() < std::numeric_limits<double>::epsilon() ||
+        c3.euclideanNorm() < std::numeric_limits<double>::epsilon())
+      continue; // collinear points
+
+    w1.normalize(); w3.normalize();
+    c1.normalize(); c3.normalize();
+    w2 = vpColVector::crossProd(w3, w1);
+    c2 = vpColVector::crossProd(c3, c1);
+
+    // R = [c1 c2 c3] [w1 w2 w3]^t
+    vpRotationMatrix R;
+    for (unsigned int row = 0; row < 3; row++)
+      for (unsigned int col = 0; col < 3; col++)
+        R[row][col] = c1[row]*w1[col] + c2[row]*w2[col] + c3[row]*w3[col];
+
+    vpTranslationVector t;
+    t[0] = C[0][0] - (R[0][0]*P[0].get_oX() + R[0][1]*P[0].get_oY() + R[0][2]*P[0].get_oZ());
+    t[1] = C[0][1] - (R[1][0]*P[0].get_oX() + R[1][1]*P[0].get_oY() + R[1][2]*P[0].get_oZ());
+    t[2] = C[0][2] - (R[2][0]*P[0].get_oX() + R[2][1]*P[0].get_oY() + R[2][2]*P[0].get_oZ());
+
+    vpHomogeneousMatrix cMo_candidate(t, R);
+
+    // The candidate minimizing the residual over all the points of the list
+    // is kept: the points beyond the three first disambiguate the solutions
+    double residual = computeResidual(cMo_candidate);
+    if (!vpMath::isNaN(residual) && residual < best_residual) {
+      best_residual = residual;
+      cMo = cMo_candidate;
+      found = true;
+    }
+  }
+
+  if (!found) {
+    throw(vpPoseException(vpPoseException::poseError,
+          "P3P pose computation found no geometrically valid solution"));
+  }
+}
@@ -52,6 +52,7 @@
 #include <map>
 
 #include <visp3/vision/vpPose.h>
+#include <visp3/core/vpPhiloxRand.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpRansac.h>
 #include <visp3/core/vpTime.h>
@@ -59,6 +60,10 @@
 #include <visp3/vision/vpPoseException.h>
 #include <visp3/core/vpMath.h>
 
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
+
 #define eps 1e-6
 
 
@@ -75,15 +80,11 @@ bool vpPose::poseRansac(vpHomogeneousMatrix & cMo, bool (*func)(vpHomogeneousMat
   ransacInliers.clear();
   ransacInlierIndex.clear();
 
-  srand(0); //Fix seed here so we will have the same pseudo-random series at each run.
   std::vector<unsigned int> best_consensus;
-  std::vector<unsigned int> cur_consensus;
-  std::vector<unsigned int> cur_outliers;
-  std::vector<unsigned int> cur_randoms;
   int nbTrials = 0;
   unsigned int nbMinRandom = 4 ;
   unsigned int nbInliers = 0;
-  double r, r_lagrange, r_dementhon;
+  double r_lagrange, r_dementhon;
 
   vpHomogeneousMatrix cMo_lagrange, cMo_dementhon;
 
@@ -131,231 +132,208 @@ bool vpPose::poseRansac(vpHomogeneousMatrix & cMo, bool (*func)(vpHomogeneousMat
   }
 
 
+  //Points copied in a vector for constant time sampling
+  std::vector<vpPoint> uniquePoints(listOfUniquePoints.begin(), listOfUniquePoints.end());
+
   bool foundSolution = false;
-  
-  while (nbTrials < ransacMaxTrials && nbInliers < (unsigned)ransacNbInlierConsensus)
+
+  //Bound on the number of trials derived from the running inlier ratio:
+  //number of samples giving a 0.99 probability to draw at least one outlier
+  //free minimal sample
+  int adaptiveMaxTrials = ransacMaxTrials;
+
+  while (nbTrials < ransacMaxTrials && nbTrials < adaptiveMaxTrials &&
+         nbInliers < (unsigned)ransacNbInlierConsensus)
   {
-    //Hold the list of the index of the inliers (points in the consensus set)
-    cur_consensus.clear();
-
-    //Use a temporary variable because if not, the cMo passed in parameters will be modified when
-    // we compute the pose for the minimal sample sets but if the pose is not correct when we pass
-    // a function pointer we do not want to modify the cMo passed in parameters
-    vpHomogeneousMatrix cMo_tmp;
-    cur_outliers.clear();
-    cur_randoms.clear();
-    
-    //Vector of used points, initialized at false for all points
-    std::vector<bool> usedPt(size, false);
-    
-    vpPose poseMin;
-    for(unsigned int i = 0; i < nbMinRandom;)
+    //One batch of trials is evaluated concurrently. Each trial owns a small
+    //deterministic generator seeded from its index, so the sampling depends
+    //neither on the thread count nor on the scheduling.
+#ifdef VISP_HAVE_OPENMP
+    int batchSize = omp_get_max_threads();
+#else
+    int batchSize = 1;
+#endif
+    if (nbTrials + batchSize > ransacMaxTrials)
+      batchSize = ransacMaxTrials - nbTrials;
+
+    std::vector<unsigned int> batchInliers((size_t) batchSize, 0);
+    std::vector<std::vector<unsigned int> > batchConsensus((size_t) batchSize);
+    std::vector<vpHomogeneousMatrix> batchPose((size_t) batchSize);
+    std::vector<unsigned char> batchValid((size_t) batchSize, 0);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int b = 0; b < batchSize; b++)
     {
-      if((size_t) std::count(usedPt.begin(), usedPt.end(), true) == usedPt.size()) {
-        //All points was picked once, break otherwise we stay in an infinite loop
-        break;
+      //Per trial counter-based stream, reproducible whatever the scheduling
+      vpPhiloxRand rng(2654435761u, (unsigned int)(nbTrials + b + 1));
+
+      //Draw a minimal sample of distinct points
+      unsigned int idx[4];
+      unsigned int nbPicked = 0;
+      for (unsigned int attempt = 0; nbPicked < nbMinRandom && attempt < 100*nbMinRandom; attempt++) {
+        unsigned int r_ = (unsigned int)(rng() * size);
+        bool alreadyPicked = false;
+        for (unsigned int k = 0; k < nbPicked; k++)
+          if (idx[k] == r_)
+            alreadyPicked = true;
+        if (!alreadyPicked)
+          idx[nbPicked++] = r_;
+      }
+      if (nbPicked < nbMinRandom)
+        continue;
+
+      //Cheap degeneracy pre-check: a minimal sample containing three
+      //collinear image points cannot constrain the pose, reject it before
+      //the expensive pose computations
+      bool degenerate = false;
+      for (unsigned int a = 0; a < nbMinRandom-2 && !degenerate; a++) {
+        for (unsigned int c = a+1; c < nbMinRandom-1 && !degenerate; c++) {
+          for (unsigned int d = c+1; d < nbMinRandom && !degenerate; d++) {
+            double x0 = uniquePoints[idx[a]].get_x(), y0 = uniquePoints[idx[a]].get_y();
+            double area2 = (uniquePoints[idx[c]].get_x() - x0)*(uniquePoints[idx[d]].get_y() - y0)
+                         - (uniquePoints[idx[c]].get_y() - y0)*(uniquePoints[idx[d]].get_x() - x0);
+            if (std::fabs(area2) < 1e-10)
+              degenerate = true;
+          }
+        }
       }
+      if (degenerate)
+        continue;
+
+      vpPose poseMin;
+      for (unsigned int k = 0; k < nbMinRandom; k++)
+        poseMin.addPoint(uniquePoints[idx[k]]);
+
+      //The closed form P3P solver is the hypothesis engine: it is orders of
+      //magnitude cheaper per minimal sample than the iterative methods,
+      //which stay as a fallback when no valid P3P solution exists
+      bool is_valid_trial = false;
+      double r_trial = DBL_MAX;
+      vpHomogeneousMatrix cMo_tmp;
 
-      //Pick a point randomly
-      unsigned int r_ = (unsigned int) rand() % size;
-      while(usedPt[r_]) {
-        //If already picked, pick another point randomly
-        r_ = (unsigned int) rand() % size;
+      try {
+        poseMin.computePose(vpPose::P3P, cMo_tmp);
+        r_trial = poseMin.computeResidual(cMo_tmp);
+        if (!vpMath::isNaN(r_trial))
+          is_valid_trial = true;
+      } catch(...) {
       }
-      //Mark this point as already picked
-      usedPt[r_] = true;
-      
-      std::list<vpPoint>::const_iterator iter = listOfUniquePoints.begin();
-      std::advance(iter, r_);
-      vpPoint pt = *iter;
-      
-      poseMin.addPoint(pt);
-      cur_randoms.push_back(r_);
-      //Increment the number of points picked
-      i++;
-
-//      bool degenerate = false;
-//      for(std::list<vpPoint>::const_iterator it = poseMin.listP.begin(); it != poseMin.listP.end(); ++it){
-//        vpPoint ptdeg = *it;
-//        if( ((fabs(pt.get_x() - ptdeg.get_x()) < 1e-6) && (fabs(pt.get_y() - ptdeg.get_y()) < 1e-6))  ||
-//            ((fabs(pt.get_oX() - ptdeg.get_oX()) < 1e-6) && (fabs(pt.get_oY() - ptdeg.get_oY()) < 1e-6) && (fabs(pt.get_oZ() - ptdeg.get_oZ()) < 1e-6))){
-//          degenerate = true;
-//          break;
-//        }
-//      }
-//      if(!degenerate) {
-//        poseMin.addPoint(pt);
-//        cur_randoms.push_back(r_);
-//        //Increment the number of points picked
-//        i++;
-//      }
-    }
 
-    if(poseMin.npt < nbMinRandom) {
-      nbTrials++;
-      continue;
-    }
+      if (!is_valid_trial) {
+        //Flags set if pose computation is OK
+        bool is_valid_lagrange = false;
+        bool is_valid_dementhon = false;
 
-    //Flags set if pose computation is OK
-    bool is_valid_lagrange = false;
-    bool is_valid_dementhon = false;
+        //Set maximum value for residuals
+        double r_lagrange_trial = DBL_MAX, r_dementhon_trial = DBL_MAX;
+        vpHomogeneousMatrix cMo_lagrange_trial, cMo_dementhon_trial;
 
-    //Set maximum value for residuals
-    r_lagrange = DBL_MAX;
-    r_dementhon = DBL_MAX;
+        try {
+          poseMin.computePose(vpPose::LAGRANGE, cMo_lagrange_trial);
+          r_lagrange_trial = poseMin.computeResidual(cMo_lagrange_trial);
+          is_valid_lagrange = true;
+        } catch(...) {
+        }
 
-    try {
-      poseMin.computePose(vpPose::LAGRANGE, cMo_lagrange);
-      r_lagrange = poseMin.computeResidual(cMo_lagrange);
-      is_valid_lagrange = true;
-    } catch(/*vpException &e*/...) {
-//      std::cerr << e.what() << std::endl;
-    }
+        try {
+          poseMin.computePose(vpPose::DEMENTHON, cMo_dementhon_trial);
+          r_dementhon_trial = poseMin.computeResidual(cMo_dementhon_trial);
+          is_valid_dementhon = true;
+        } catch(...) {
+        }
 
-    try {
-      poseMin.computePose(vpPose::DEMENTHON, cMo_dementhon);
-      r_dementhon = poseMin.computeResidual(cMo_dementhon);
-      is_valid_dementhon = true;
-    } catch(/*vpException &e*/...) {
-//      std::cerr << e.what() << std::endl;
-    }
+        //If residual returned is not a number (NAN), set valid to false
+        if (vpMath::isNaN(r_lagrange_trial)) {
+          is_valid_lagrange = false;
+          r_lagrange_trial = DBL_MAX;
+        }
 
-    //If residual returned is not a number (NAN), set valid to false
-    if(vpMath::isNaN(r_lagrange)) {
-      is_valid_lagrange = false;
-      r_lagrange = DBL_MAX;
-    }
+        if (vpMath::isNaN(r_dementhon_trial)) {
+          is_valid_dementhon = false;
+          r_dementhon_trial = DBL_MAX;
+        }
 
-    if(vpMath::isNaN(r_dementhon)) {
-      is_valid_dementhon = false;
-      r_dementhon = DBL_MAX;
-    }
+        if (!is_valid_lagrange && !is_valid_dementhon)
+          continue;
 
-    //If at least one pose computation is OK,
-    //we can continue, otherwise pick another random set
-    if(is_valid_lagrange || is_valid_dementhon) {
-      if (r_lagrange < r_dementhon) {
-        r = r_lagrange;
-//        cMo = cMo_lagrange;
-        cMo_tmp = cMo_lagrange;
-      }
-      else {
-        r = r_dementhon;
-//        cMo = cMo_dementhon;
-        cMo_tmp = cMo_dementhon;
+        if (r_lagrange_trial < r_dementhon_trial) {
+          r_trial = r_lagrange_trial;
+          cMo_tmp = cMo_lagrange_trial;
+        } else {
+          r_trial = r_dementhon_trial;
+          cMo_tmp = cMo_dementhon_trial;
+        }
       }
-      r = sqrt(r) / (double) nbMinRandom;
+      r_trial = sqrt(r_trial) / (double) nbMinRandom;
 
-      //Filter the pose using some criterion (orientation angles, translations, etc.)
+      //Filter the pose using some criterion (orientation angles,
+      //translations, etc.). The callback is not required to be thread safe,
+      //so the calls are serialized
       bool isPoseValid = true;
-      if(func != NULL) {
+      if (func != NULL) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical (vpPoseRansacFunc)
+#endif
         isPoseValid = func(&cMo_tmp);
-        if(isPoseValid) {
-          cMo = cMo_tmp;
-        }
-      } else {
-        //No post filtering on pose, so copy cMo_temp to cMo
-        cMo = cMo_tmp;
       }
 
-      if (isPoseValid && r < ransacThreshold)
+      if (isPoseValid && r_trial < ransacThreshold)
       {
         unsigned int nbInliersCur = 0;
-        unsigned int iter = 0;
-        for (std::list<vpPoint>::const_iterator it = listOfUniquePoints.begin(); it != listOfUniquePoints.end(); ++it)
+        std::vector<unsigned int> &consensus = batchConsensus[(size_t) b];
+        for (unsigned int iter = 0; iter < size; iter++)
         {
-          vpPoint pt = *it;
-          vpPoint p(pt) ;
-          p.track(cMo) ;
-
-          double d = vpMath::sqr(p.get_x() - pt.get_x()) + vpMath::sqr(p.get_y() - pt.get_y()) ;
-          double error = sqrt(d) ;
-          if(error < ransacThreshold) {
-            // the point is considered as inlier if the error is below the threshold
+          vpPoint p(uniquePoints[iter]);
+          p.track(cMo_tmp);
+
+          double d = vpMath::sqr(p.get_x() - uniquePoints[iter].get_x())
+                   + vpMath::sqr(p.get_y() - uniquePoints[iter].get_y());
+          if (sqrt(d) < ransacThreshold) {
+            //the point is considered as inlier if the error is below the threshold
             nbInliersCur++;
-            cur_consensus.push_back(iter);
-
-//            // But, we need also to check if it is not a degenerate point
-//            bool degenerate = false;
-//
-//            for(unsigned int it_inlier_index = 0; it_inlier_index< cur_consensus.size(); it_inlier_index++){
-//              std::list<vpPoint>::const_iterator it_point = listP.begin();
-//              std::advance(it_point, cur_consensus[it_inlier_index]);
-//              pt = *it_point;
-//
-//              vpPoint ptdeg = *it;
-//              if( ((fabs(pt.get_x() - ptdeg.get_x()) < 1e-6) && (fabs(pt.get_y() - ptdeg.get_y()) < 1e-6))  ||
-//                  ((fabs(pt.get_oX() - ptdeg.get_oX()) < 1e-6) && (fabs(pt.get_oY() - ptdeg.get_oY()) < 1e-6)
-//                      && (fabs(pt.get_oZ() - ptdeg.get_oZ()) < 1e-6))){
-//                degenerate = true;
-//                break;
-//              }
-//            }
-//
-//            if(!degenerate) {
-//              nbInliersCur++;
-//              cur_consensus.push_back(iter);
-//            }
-//            else {
-//              cur_outliers.push_back(iter);
-//            }
+            consensus.push_back(iter);
           }
-          else {
-            cur_outliers.push_back(iter);
-          }
-
-          iter++;
-        }
-
-        if(nbInliersCur > nbInliers)
-        {
-          foundSolution = true;
-          best_consensus = cur_consensus;
-          nbInliers = nbInliersCur;
         }
 
-        nbTrials++;
-        
-        if(nbTrials >= ransacMaxTrials) {
-//          vpERROR_TRACE("Ransac reached the maximum number of trials");
-          foundSolution = true;
-        }
+        batchInliers[(size_t) b] = nbInliersCur;
+        batchPose[(size_t) b] = cMo_tmp;
+        batchValid[(size_t) b] = 1;
       }
-      else {
-        nbTrials++;
+    }
 
-        if(nbTrials >= ransacMaxTrials) {
-//          vpERROR_TRACE("Ransac reached the maximum number of trials");
+    //Serial reduction of the batch, in trial order so that the result does
+    //not depend on the thread count
+    for (int b = 0; b < batchSize; b++)
+    {
+      if (batchValid[(size_t) b]) {
+        foundSolution = true;
+        if (batchInliers[(size_t) b] > nbInliers) {
+          nbInliers = batchInliers[(size_t) b];
+          best_consensus = batchConsensus[(size_t) b];
+          cMo = batchPose[(size_t) b];
+
+          //Update the adaptive trial bound from the running inlier ratio
+          double w = (double) nbInliers / (double) size;
+          double p_good_sample = w*w*w*w;
+          if (p_good_sample >= 1.0 - eps) {
+            adaptiveMaxTrials = nbTrials + batchSize;
+          } else if (p_good_sample > eps) {
+            double bound = log(1.0 - 0.99) / log(1.0 - p_good_sample);
+            if (bound < (double) ransacMaxTrials)
+              adaptiveMaxTrials = (int) ceil(bound);
+          }
         }
       }
-    } else {
-      nbTrials++;
-
-      if(nbTrials >= ransacMaxTrials) {
-//        vpERROR_TRACE("Ransac reached the maximum number of trials");
-      }
     }
+
+    nbTrials += batchSize;
   }
-    
+
   if(foundSolution) {
 //    std::cout << "Nombre d'inliers " << nbInliers << std::endl ;
     
-    //Display the random picked points
-    /*
-    std::cout << "Randoms : "; 
-    for(unsigned int i = 0 ; i < cur_randoms.size() ; i++)
-      std::cout << cur_randoms[i] << " ";
-    std::cout << std::endl;
-    */
-    
-    //Display the outliers
-    /*
-    std::cout << "Outliers : "; 
-    for(unsigned int i = 0 ; i < cur_outliers.size() ; i++)
-      std::cout << cur_outliers[i] << " ";
-    std::cout << std::endl;
-    */
-    
     //Even if the cardinality of the best consensus set is inferior to ransacNbInlierConsensus,
     //we want to refine the solution with data in best_consensus and return this pose.
     //This is an approach used for example in p118 in Multiple View Geometry in Computer Vision, Hartley, R.~I. and Zisserman, A.
@@ -365,10 +343,8 @@ bool vpPose::poseRansac(vpHomogeneousMatrix & cMo, bool (*func)(vpHomogeneousMat
       vpPose pose ;
       for(unsigned i = 0 ; i < best_consensus.size(); i++)
       {
-        std::list<vpPoint>::const_iterator iter = listOfUniquePoints.begin();
-        std::advance(iter, best_consensus[i]);
-        vpPoint pt = *iter;
-      
+        vpPoint pt = uniquePoints[best_consensus[i]];
+
         pose.addPoint(pt) ;
         ransacInliers.push_back(pt);
       }
@@ -436,7 +412,7 @@ bool vpPose::poseRansac(vpHomogeneousMatrix & cMo, bool (*func)(vpHomogeneousMat
         }
 
         if(computeCovariance) {
-          covarianceMatrix = pose.covarianceMatrix;
+          covarianceMatrix = pose.getCovarianceMatrix();
         }
       }
     } else {
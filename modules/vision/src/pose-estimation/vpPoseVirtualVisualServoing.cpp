@@ -41,6 +41,7 @@
 */
 
 #include <visp3/vision/vpPose.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpRobust.h>
@@ -86,6 +87,7 @@ vpPose::poseVirtualVS(vpHomogeneousMatrix & cMo)
     }
 
     vpHomogeneousMatrix cMoPrev = cMo;
+    double t_start = vpTime::measureTimeMs();
     //while((int)((residu_1 - r)*1e12) !=0)
     while(std::fabs((residu_1 - r)*1e12) > std::numeric_limits<double>::epsilon())
     {      
@@ -125,12 +127,21 @@ vpPose::poseVirtualVS(vpHomogeneousMatrix & cMo)
       // compute the residual
       r = err.sumSquare() ;
 
-      // compute the pseudo inverse of the interaction matrix
-      vpMatrix Lp ;
-      L.pseudoInverse(Lp,1e-16) ;
+      // solve the normal equations L^T L v = L^T err through a Cholesky
+      // decomposition, several times cheaper than the former SVD based
+      // pseudo inverse; choleskySolve() falls back on the SVD when the
+      // system is ill conditioned
+      vpMatrix LTL = L.AtA() ;
+      // A prior on the initial pose anchors and scales the updates
+      // (maximum a posteriori estimation)
+      if (m_vvsPriorSet)
+        LTL += m_vvsPriorInformation ;
+      vpColVector LTerr = L.t()*err ;
+      vpColVector sol ;
+      LTL.choleskySolve(LTerr, sol) ;
 
       // compute the VVS control law
-      v = -lambda*Lp*err ;
+      v = -lambda*sol ;
 
       //std::cout << "r=" << r <<std::endl ;
       // update the pose
@@ -138,10 +149,21 @@ vpPose::poseVirtualVS(vpHomogeneousMatrix & cMo)
       cMoPrev = cMo;
       cMo = vpExponentialMap::direct(v).inverse()*cMo ; ;
       if (iter++>vvsIterMax) break ;
+
+      // Early exits for warm started estimations: residual stabilized,
+      // update below the noise floor, or time budget spent
+      if (m_vvsResidualThreshold > 0 && std::fabs(residu_1 - r) < m_vvsResidualThreshold) break ;
+      if (m_vvsUpdateThreshold > 0 && sqrt(v.sumSquare()) < m_vvsUpdateThreshold) break ;
+      if (m_vvsTimeBudget > 0 && vpTime::measureTimeMs() - t_start > m_vvsTimeBudget) break ;
     }
     
-    if(computeCovariance)
-      covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(cMoPrev, err, L);
+    if(computeCovariance) {
+      // Cached for the deferred computation in getCovarianceMatrix()
+      m_covCMoPrev = cMoPrev;
+      m_covError = err;
+      m_covJacobian = L;
+      m_covModel = 1;
+    }
   }
 
   catch(...)
@@ -262,8 +284,17 @@ vpPose::poseVirtualVSrobust(vpHomogeneousMatrix & cMo)
       if (iter++>vvsIterMax) break ;
     }
     
-    if(computeCovariance)
-      covarianceMatrix = vpMatrix::computeCovarianceMatrix(L,v,-lambda*error, W*W); // Remark: W*W = W*W.t() since the matrix is diagonale, but using W*W is more efficient.
+    if(computeCovariance) {
+      // Cached for the deferred computation in getCovarianceMatrix(); only
+      // the diagonal of W is kept (W*W is rebuilt there, diagonal squared)
+      m_covJacobian = L;
+      m_covV = v;
+      m_covError = -lambda*error;
+      m_covWeights.resize(W.getRows());
+      for(unsigned int i = 0; i < W.getRows(); i++)
+        m_covWeights[i] = W[i][i];
+      m_covModel = 2;
+    }
   }
   catch(...)
   {
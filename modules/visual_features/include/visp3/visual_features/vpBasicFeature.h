@@ -138,6 +138,22 @@ public:
   unsigned int getDimension(const unsigned int select=FEATURE_ALL) const;
   //! Compute the interaction matrix from a subset of the possible features.
   virtual vpMatrix interaction(const unsigned int select = FEATURE_ALL) = 0;
+
+  /*!
+    Compute the interaction matrix into caller provided storage. The generic
+    implementation forwards to the historic by-value interaction(); the
+    features used in tight servo loops override it to fill \e L in place so
+    that the per-frame stacking of vpServo stays allocation free once the
+    storage reached its size. On a derived object the historic
+    interaction(select) declaration hides this overload: call it through a
+    vpBasicFeature reference or pointer (as vpServo does).
+
+    \param L : Interaction matrix, resized as needed.
+    \param select : Feature selector.
+  */
+  virtual void interaction(vpMatrix &L, const unsigned int select = FEATURE_ALL) {
+    L = interaction(select);
+  }
   //! Return element \e i in the state vector  (usage : x = s[i] )
   virtual inline double operator[](const unsigned int i) const {  return s[i]; }
   vpBasicFeature &operator=(const vpBasicFeature &f) ;
@@ -45,6 +45,7 @@
 
 #include <visp3/core/vpConfig.h>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <cstring>
 
@@ -167,6 +168,9 @@ class VISP_EXPORT vpFeatureMomentDatabase{
   virtual ~vpFeatureMomentDatabase() {}
   virtual void updateAll(double A=0.0, double B=0.0, double C=1.0);
 
+  void updateRequired(double A, double B, double C, const std::vector<const char*> &names);
+  std::vector<const char*> getRequiredMomentNames(const std::vector<const char*> &names);
+
   vpFeatureMoment& get(const char* type, bool& found);
 
   //friend VISP_EXPORT std::ostream & operator<<(std::ostream& os, const vpFeatureMomentDatabase& m);
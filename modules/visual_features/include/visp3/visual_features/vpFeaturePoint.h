@@ -218,6 +218,7 @@ public:
 
   void init() ;
   vpMatrix  interaction(const unsigned int select = FEATURE_ALL);
+  void interaction(vpMatrix &L, const unsigned int select = FEATURE_ALL);
 
   void print(const unsigned int select = FEATURE_ALL ) const ;
 
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Small object pool recycling visual feature instances.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef vpFeaturePool_H
+#define vpFeaturePool_H
+
+/*!
+  \file vpFeaturePool.h
+  \brief Small object pool recycling visual feature instances across frames.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class vpFeaturePool
+  \ingroup group_visual_features
+
+  \brief Small object pool recycling visual feature instances across frames.
+
+  A feature built per frame with vpFeatureBuilder does not need to be a fresh
+  object: the builder updates the feature in place, and the internal vectors
+  of a vpBasicFeature descendant are allocated once at construction. This
+  pool keeps the instances alive between frames so that a task rebuilding
+  many features per frame stops allocating: acquire() hands out a recycled
+  instance (constructing a new one only while the pool grows) and
+  releaseAll() makes every instance reusable again at the next frame without
+  destroying it.
+
+  \code
+#include <visp3/visual_features/vpFeaturePool.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/visual_features/vpFeatureBuilder.h>
+
+vpFeaturePool<vpFeaturePoint> pool;
+
+// At each frame:
+pool.releaseAll();
+for (unsigned int i = 0; i < nb_points; i++) {
+  vpFeaturePoint &s = pool.acquire();     // recycled, no allocation after frame 1
+  vpFeatureBuilder::create(s, point[i]);  // in-place update
+  // ... use s
+}
+  \endcode
+
+  The references returned by acquire() stay valid until clear() or the pool
+  destruction; releaseAll() only rewinds the distribution.
+*/
+template <class FeatureType>
+class vpFeaturePool
+{
+public:
+  vpFeaturePool() : m_pool(), m_cursor(0) {}
+
+  virtual ~vpFeaturePool()
+  {
+    clear();
+  }
+
+  /*!
+    Get a feature instance: a recycled one when available, a newly
+    constructed one while the pool is still growing.
+
+    \return A reference valid until clear() or the pool destruction.
+  */
+  FeatureType &acquire()
+  {
+    if (m_cursor == m_pool.size())
+      m_pool.push_back(new FeatureType);
+    return *m_pool[m_cursor++];
+  }
+
+  /*!
+    Make every instance reusable again, without destroying any of them.
+    Typically called once per frame before rebuilding the features.
+  */
+  void releaseAll()
+  {
+    m_cursor = 0;
+  }
+
+  //! Get the number of instances currently distributed.
+  unsigned int getNbAcquired() const { return (unsigned int) m_cursor; }
+
+  //! Get the number of instances owned by the pool.
+  unsigned int getPoolSize() const { return (unsigned int) m_pool.size(); }
+
+  //! Destroy every instance and empty the pool.
+  void clear()
+  {
+    for (size_t i = 0; i < m_pool.size(); i++)
+      delete m_pool[i];
+    m_pool.clear();
+    m_cursor = 0;
+  }
+
+private:
+  // The pool owns its instances: copying would double-delete them.
+  vpFeaturePool(const vpFeaturePool &);
+  vpFeaturePool &operator=(const vpFeaturePool &);
+
+  std::vector<FeatureType *> m_pool;
+  size_t m_cursor;
+};
+
+#endif
@@ -46,6 +46,15 @@
 
 #include <visp3/visual_features/vpFeatureLuminance.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VISP_HAVE_SSE2 1
+#endif
+
+#ifdef VISP_HAVE_OPENMP
+#  include <omp.h>
+#endif
+
 
 /*!
   \file vpFeatureLuminance.cpp
@@ -250,12 +259,49 @@ vpFeatureLuminance::buildFrom(vpImage<unsigned char> &I)
   Compute and return the interaction matrix \f$ L_I \f$. The computation is made
   thanks to the values of the luminance features \f$ I \f$
 */
-void
-vpFeatureLuminance::interaction(vpMatrix &L)
-{  
-  L.resize(dim_s,6) ;
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Compute the rows [begin, end) of the luminance interaction matrix, two
+//! pixels per iteration on SSE2 with a scalar tail. Each row only depends on
+//! its own pixel, so disjoint ranges can run concurrently.
+static void luminanceInteractionRange(const vpLuminance *pixInfo, vpMatrix &L, int begin, int end)
+{
+  int m = begin;
 
-  for(unsigned int m = 0; m< L.getRows(); m++)
+#ifdef VISP_HAVE_SSE2
+  const __m128d one = _mm_set1_pd(1.0);
+  const __m128d zero = _mm_setzero_pd();
+  for (; m+1 < end; m += 2)
+  {
+    __m128d Ix = _mm_set_pd(pixInfo[m+1].Ix, pixInfo[m].Ix);
+    __m128d Iy = _mm_set_pd(pixInfo[m+1].Iy, pixInfo[m].Iy);
+    __m128d x  = _mm_set_pd(pixInfo[m+1].x,  pixInfo[m].x);
+    __m128d y  = _mm_set_pd(pixInfo[m+1].y,  pixInfo[m].y);
+    __m128d Zinv = _mm_div_pd(one, _mm_set_pd(pixInfo[m+1].Z, pixInfo[m].Z));
+
+    __m128d xy = _mm_mul_pd(x, y);
+    __m128d c0 = _mm_mul_pd(Ix, Zinv);
+    __m128d c1 = _mm_mul_pd(Iy, Zinv);
+    __m128d c2 = _mm_sub_pd(zero,
+        _mm_mul_pd(_mm_add_pd(_mm_mul_pd(x, Ix), _mm_mul_pd(y, Iy)), Zinv));
+    __m128d c3 = _mm_sub_pd(zero,
+        _mm_add_pd(_mm_mul_pd(Ix, xy),
+                   _mm_mul_pd(_mm_add_pd(one, _mm_mul_pd(y, y)), Iy)));
+    __m128d c4 = _mm_add_pd(_mm_mul_pd(_mm_add_pd(one, _mm_mul_pd(x, x)), Ix),
+                            _mm_mul_pd(Iy, xy));
+    __m128d c5 = _mm_sub_pd(_mm_mul_pd(Iy, x), _mm_mul_pd(Ix, y));
+
+    double *row0 = L[m];
+    double *row1 = L[m+1];
+    _mm_storel_pd(row0+0, c0); _mm_storeh_pd(row1+0, c0);
+    _mm_storel_pd(row0+1, c1); _mm_storeh_pd(row1+1, c1);
+    _mm_storel_pd(row0+2, c2); _mm_storeh_pd(row1+2, c2);
+    _mm_storel_pd(row0+3, c3); _mm_storeh_pd(row1+3, c3);
+    _mm_storel_pd(row0+4, c4); _mm_storeh_pd(row1+4, c4);
+    _mm_storel_pd(row0+5, c5); _mm_storeh_pd(row1+5, c5);
+  }
+#endif
+
+  for (; m < end; m++)
   {
     double Ix = pixInfo[m].Ix;
     double Iy = pixInfo[m].Iy;
@@ -264,15 +310,39 @@ vpFeatureLuminance::interaction(vpMatrix &L)
     double y = pixInfo[m].y ;
     double Zinv =  1 / pixInfo[m].Z;
 
-    {
-      L[m][0] = Ix * Zinv;
-      L[m][1] = Iy * Zinv;
-      L[m][2] = -(x*Ix+y*Iy)*Zinv;
-      L[m][3] = -Ix*x*y-(1+y*y)*Iy;
-      L[m][4] = (1+x*x)*Ix + Iy*x*y;
-      L[m][5]  = Iy*x-Ix*y;
-    }
+    double *row = L[m];
+    row[0] = Ix * Zinv;
+    row[1] = Iy * Zinv;
+    row[2] = -(x*Ix+y*Iy)*Zinv;
+    row[3] = -Ix*x*y-(1+y*y)*Iy;
+    row[4] = (1+x*x)*Ix + Iy*x*y;
+    row[5] = Iy*x-Ix*y;
+  }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void
+vpFeatureLuminance::interaction(vpMatrix &L)
+{  
+  L.resize(dim_s,6) ;
+
+  int nb = (int) L.getRows();
+
+#ifdef VISP_HAVE_OPENMP
+  // One contiguous, even aligned row range per thread: the rows are
+  // independent and the SIMD kernel runs on each range
+  #pragma omp parallel
+  {
+    int nthreads = omp_get_num_threads();
+    int tid = omp_get_thread_num();
+    int begin = (int)(((long long) nb * tid / nthreads) & ~1LL);
+    int end = (tid == nthreads-1) ? nb : (int)(((long long) nb * (tid+1) / nthreads) & ~1LL);
+    if (end > begin)
+      luminanceInteractionRange(pixInfo, L, begin, end);
   }
+#else
+  luminanceInteractionRange(pixInfo, L, 0, nb);
+#endif
 }
 
 /*!
@@ -36,6 +36,10 @@
  *****************************************************************************/
 
 #include <visp3/visual_features/vpFeatureMomentDatabase.h>
+
+#include <cstring>
+#include <string>
+#include <utility>
 #include <visp3/visual_features/vpFeatureMoment.h>
 #include <typeinfo>
 #include <iostream>
@@ -91,6 +95,167 @@ void vpFeatureMomentDatabase::updateAll(double A, double B, double C)
 #endif
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Dependencies of the feature moment classes shipped with ViSP: the other
+//! feature moments and the moments their update reads from the databases.
+//! Used by updateRequired()/getRequiredMomentNames() so that only the
+//! transitive closure of the active features is evaluated.
+static void vpFeatureMomentDependencies(const char *name,
+                                        std::vector<const char *> &featureDeps,
+                                        std::vector<const char *> &momentDeps)
+{
+  featureDeps.clear();
+  momentDeps.clear();
+  if (!strcmp(name, "vpFeatureMomentBasic")) {
+    momentDeps.push_back("vpMomentBasic");
+  }
+  else if (!strcmp(name, "vpFeatureMomentGravityCenter")) {
+    featureDeps.push_back("vpFeatureMomentBasic");
+    momentDeps.push_back("vpMomentCentered");
+    momentDeps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpFeatureMomentCentered")) {
+    featureDeps.push_back("vpFeatureMomentBasic");
+    featureDeps.push_back("vpFeatureMomentGravityCenter");
+    momentDeps.push_back("vpMomentBasic");
+    momentDeps.push_back("vpMomentCentered");
+    momentDeps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpFeatureMomentAlpha")) {
+    featureDeps.push_back("vpFeatureMomentCentered");
+    momentDeps.push_back("vpMomentAlpha");
+    momentDeps.push_back("vpMomentCentered");
+    momentDeps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpFeatureMomentArea")) {
+    momentDeps.push_back("vpMomentArea");
+    momentDeps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpFeatureMomentAreaNormalized")) {
+    featureDeps.push_back("vpFeatureMomentBasic");
+    featureDeps.push_back("vpFeatureMomentCentered");
+    momentDeps.push_back("vpMomentAreaNormalized");
+    momentDeps.push_back("vpMomentCentered");
+    momentDeps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpFeatureMomentGravityCenterNormalized")) {
+    featureDeps.push_back("vpFeatureMomentAreaNormalized");
+    featureDeps.push_back("vpFeatureMomentGravityCenter");
+    momentDeps.push_back("vpMomentAreaNormalized");
+    momentDeps.push_back("vpMomentCentered");
+    momentDeps.push_back("vpMomentGravityCenter");
+  }
+  else if (!strcmp(name, "vpFeatureMomentCInvariant")) {
+    featureDeps.push_back("vpFeatureMomentBasic");
+    featureDeps.push_back("vpFeatureMomentCentered");
+    momentDeps.push_back("vpMomentCInvariant");
+    momentDeps.push_back("vpMomentCentered");
+  }
+}
+
+//! Depth first expansion of the feature closure of the given names,
+//! dependencies first, each feature once.
+static void vpFeatureMomentClosure(const std::vector<const char *> &names,
+                                   std::vector<const char *> &order)
+{
+  order.clear();
+  std::vector<std::pair<const char *, bool> > stack;
+  std::map<std::string, bool> visited;
+
+  for(unsigned int i = 0; i < names.size(); i++)
+    stack.push_back(std::make_pair(names[i], false));
+
+  std::vector<const char *> featureDeps, momentDeps;
+  while(!stack.empty()) {
+    const char *name = stack.back().first;
+    bool expanded = stack.back().second;
+    stack.pop_back();
+
+    if (expanded) {
+      order.push_back(name);
+      continue;
+    }
+    if (visited.find(name) != visited.end())
+      continue;
+    visited[name] = true;
+
+    stack.push_back(std::make_pair(name, true));
+    vpFeatureMomentDependencies(name, featureDeps, momentDeps);
+    for(unsigned int i = 0; i < featureDeps.size(); i++)
+      if (visited.find(featureDeps[i]) == visited.end())
+        stack.push_back(std::make_pair(featureDeps[i], false));
+  }
+}
+#endif
+
+/*!
+  Get the names of the moments required to update the given feature moments
+  and, transitively, the feature moments they depend on. Feed the result to
+  vpMomentDatabase::updateRequired() before calling updateRequired() here:
+
+  \code
+  std::vector<const char *> active;
+  active.push_back("vpFeatureMomentAreaNormalized");
+  active.push_back("vpFeatureMomentGravityCenterNormalized");
+  momentDb.updateRequired(obj, featureDb.getRequiredMomentNames(active));
+  featureDb.updateRequired(A, B, C, active);
+  \endcode
+
+  \param names : Names of the active feature moments.
+
+  \return Names of every moment the closure reads.
+*/
+std::vector<const char*> vpFeatureMomentDatabase::getRequiredMomentNames(const std::vector<const char*> &names)
+{
+  std::vector<const char *> order, featureDeps, momentDeps, result;
+  std::map<std::string, bool> seen;
+  vpFeatureMomentClosure(names, order);
+
+  for(unsigned int i = 0; i < order.size(); i++) {
+    vpFeatureMomentDependencies(order[i], featureDeps, momentDeps);
+    for(unsigned int j = 0; j < momentDeps.size(); j++) {
+      if (seen.find(momentDeps[j]) == seen.end()) {
+        seen[momentDeps[j]] = true;
+        result.push_back(momentDeps[j]);
+      }
+    }
+    //Unknown (custom) features still contribute their primary moment
+    if (momentDeps.empty()) {
+      bool found = false;
+      vpFeatureMoment &fm = get(order[i], found);
+      if (found && fm.momentName() != NULL && seen.find(fm.momentName()) == seen.end()) {
+        seen[fm.momentName()] = true;
+        result.push_back(fm.momentName());
+      }
+    }
+  }
+  return result;
+}
+
+/*!
+  Update only the given feature moments and, transitively, the feature
+  moments they depend on, dependencies first and each of them once. The
+  moments they read must have been computed beforehand, see
+  getRequiredMomentNames(). Features registered in the database but not in
+  the closure are left untouched.
+
+  \param A, B, C : Plane coefficients, see updateAll().
+  \param names : Names of the active feature moments. Names absent from the
+  database are ignored.
+*/
+void vpFeatureMomentDatabase::updateRequired(double A, double B, double C, const std::vector<const char*> &names)
+{
+  std::vector<const char *> order;
+  vpFeatureMomentClosure(names, order);
+
+  for(unsigned int i = 0; i < order.size(); i++) {
+    std::map<const char*,vpFeatureMoment*,vpFeatureMomentDatabase::cmp_str>::const_iterator
+        it = featureMomentsDataBase.find(order[i]);
+    if (it != featureMomentsDataBase.end())
+      it->second->update(A, B, C);
+  }
+}
+
 /*
 std::ostream & operator<<(std::ostream & os, const vpFeatureMomentDatabase& m){
     std::map<const char*,vpMoment*,vpFeatureMomentDatabase::cmp_str>::const_iterator itr;
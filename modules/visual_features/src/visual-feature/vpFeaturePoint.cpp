@@ -323,6 +323,91 @@ vpFeaturePoint::interaction(const unsigned int select)
 
 
 /*!
+  Compute the interaction matrix in place, see
+  vpBasicFeature::interaction(vpMatrix &, const unsigned int). When both
+  components are selected - the common servo situation - the two rows are
+  written directly into \e L without any temporary; other selections follow
+  the historic path.
+
+  \param L : Interaction matrix, resized to the selected rows.
+  \param select : Feature selector.
+*/
+void
+vpFeaturePoint::interaction(vpMatrix &L, const unsigned int select)
+{
+  if ((vpFeaturePoint::selectX() & select) && (vpFeaturePoint::selectY() & select))
+  {
+    if (deallocate == vpBasicFeature::user)
+    {
+      for (unsigned int i = 0; i < nbParameters; i++)
+      {
+        if (flags[i] == false)
+        {
+          switch(i){
+          case 0:
+            vpTRACE("Warning !!!  The interaction matrix is computed but x was not set yet");
+          break;
+          case 1:
+            vpTRACE("Warning !!!  The interaction matrix is computed but y was not set yet");
+          break;
+          case 2:
+            vpTRACE("Warning !!!  The interaction matrix is computed but Z was not set yet");
+          break;
+          default:
+            vpTRACE("Problem during the reading of the variable flags");
+          }
+        }
+      }
+      resetFlags();
+    }
+
+    double x_ = get_x() ;
+    double y_ = get_y() ;
+    double Z_ = get_Z() ;
+
+    if (Z_ < 0)
+    {
+      vpERROR_TRACE("Point is behind the camera ") ;
+      std::cout <<"Z = " << Z_ << std::endl ;
+
+      throw(vpFeatureException(vpFeatureException::badInitializationError,
+			     "Point is behind the camera ")) ;
+    }
+
+    if (fabs(Z_) < 1e-6)
+    {
+      vpERROR_TRACE("Point Z coordinates is null ") ;
+      std::cout <<"Z = " << Z_ << std::endl ;
+
+      throw(vpFeatureException(vpFeatureException::badInitializationError,
+			     "Point Z coordinates is null")) ;
+    }
+
+    L.resize(2, 6, false) ;
+
+    L[0][0] = -1/Z_  ;
+    L[0][1] = 0 ;
+    L[0][2] = x_/Z_ ;
+    L[0][3] = x_*y_ ;
+    L[0][4] = -(1+x_*x_) ;
+    L[0][5] = y_ ;
+
+    L[1][0] = 0 ;
+    L[1][1] = -1/Z_ ;
+    L[1][2] = y_/Z_ ;
+    L[1][3] = 1+y_*y_ ;
+    L[1][4] = -x_*y_ ;
+    L[1][5] = -x_ ;
+  }
+  else
+  {
+    L = interaction(select) ;
+  }
+}
+
+/*!
+  Compute the error \f$ (s-s^*)\f$ between the current and the desired
+  visual features from a subset of the possible features./*!
   Compute the error \f$ (s-s^*)\f$ between the current and the desired
   visual features from a subset of the possible features.
 
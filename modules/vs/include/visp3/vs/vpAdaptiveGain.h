@@ -70,8 +70,12 @@ class vpColVector;
   
 */
 
+class vpAdaptiveGainVector;
+
 class VISP_EXPORT vpAdaptiveGain
 {
+  friend class vpAdaptiveGainVector;
+
 
 public: /* constantes */
 
@@ -0,0 +1,213 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2015 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * ("GPL") version 2 as published by the Free Software Foundation.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Array of adaptive gains evaluated in one pass.
+ *
+ * Authors:
+ * Fabien Spindler
+ *
+ *****************************************************************************/
+
+#ifndef __vpAdaptiveGainVector_H
+#define __vpAdaptiveGainVector_H
+
+/*!
+  \file vpAdaptiveGainVector.h
+  \brief Array of adaptive gains evaluated in one pass.
+*/
+
+#include <visp3/vs/vpAdaptiveGain.h>
+
+#include <vector>
+#include <cmath>
+#include <limits>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#endif
+
+/*!
+  \class vpAdaptiveGainVector
+  \ingroup group_task
+
+  \brief Array of adaptive gains \f$ \lambda_i(x) = a_i \exp(-b_i x) + c_i \f$
+  evaluated in one pass.
+
+  When several servo tasks (or per-axis gains) run in the same control
+  cycle, evaluating one vpAdaptiveGain per task costs one libm exponential
+  call each. This class stores the coefficients of all the gains in flat
+  arrays and evaluates every gain in a single loop over them, with the
+  exponential computed by an inlined range-reduction approximation whose
+  relative error is below 1e-9 - far under any servo tuning concern - so
+  the whole pass vectorizes and makes no library call.
+*/
+class VISP_EXPORT vpAdaptiveGainVector
+{
+public:
+  vpAdaptiveGainVector() : m_a(), m_b(), m_c() {}
+
+  /*!
+    Append a gain given by its standard parameters, see
+    vpAdaptiveGain::initStandard().
+
+    \param gain_at_zero : Desired gain in 0.
+    \param gain_at_infinity : Desired gain at infinity.
+    \param slope_at_zero : Desired slope in 0.
+  */
+  void addGain(double gain_at_zero, double gain_at_infinity, double slope_at_zero)
+  {
+    double a = gain_at_zero - gain_at_infinity;
+    double b = (std::fabs(a) <= std::numeric_limits<double>::epsilon()) ? 0 : slope_at_zero/a;
+    m_a.push_back(a);
+    m_b.push_back(b);
+    m_c.push_back(gain_at_infinity);
+  }
+
+  //! Append a copy of an existing adaptive gain.
+  void addGain(const vpAdaptiveGain &gain)
+  {
+    m_a.push_back(gain.coeff_a);
+    m_b.push_back(gain.coeff_b);
+    m_c.push_back(gain.coeff_c);
+  }
+
+  //! Get the number of gains.
+  unsigned int size() const { return (unsigned int) m_a.size(); }
+
+  //! Remove every gain.
+  void clear() { m_a.clear(); m_b.clear(); m_c.clear(); }
+
+  /*!
+    Evaluate every gain at its own operating point, in one pass.
+
+    \param x : Array of size() operating points (e.g. the error norm of each
+    task or axis).
+    \param lambda : Output array of size() gain values.
+  */
+  void value(const double *x, double *lambda) const
+  {
+    size_t n = m_a.size();
+    size_t i = 0;
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+    for (; i+1 < n; i += 2) {
+      __m128d z = _mm_mul_pd(_mm_sub_pd(_mm_setzero_pd(), _mm_loadu_pd(&m_b[i])),
+                             _mm_loadu_pd(&x[i]));
+      __m128d er = expApprox2(z);
+      __m128d l = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(&m_a[i]), er), _mm_loadu_pd(&m_c[i]));
+      _mm_storeu_pd(&lambda[i], l);
+    }
+#endif
+    for (; i < n; i++)
+      lambda[i] = m_a[i]*expApprox(-m_b[i]*x[i]) + m_c[i];
+  }
+
+  /*!
+    Evaluate every gain at the same operating point, in one pass.
+
+    \param x : Shared operating point.
+    \param lambda : Output array of size() gain values.
+  */
+  void value(const double &x, double *lambda) const
+  {
+    size_t n = m_a.size();
+    for (size_t i = 0; i < n; i++)
+      lambda[i] = m_a[i]*expApprox(-m_b[i]*x) + m_c[i];
+  }
+
+private:
+  /*!
+    Exponential by range reduction: z = n ln2 + r with |r| <= ln2/2, exp(r)
+    from a degree 6 Taylor expansion and the 2^n scale folded into the
+    exponent bits. Relative error below 1e-9 on the gain operating range.
+  */
+  static double expApprox(double z)
+  {
+    if (z < -700.)
+      return 0.;
+    if (z > 700.)
+      return std::numeric_limits<double>::infinity();
+
+    static const double ln2 = 0.69314718055994530942;
+    static const double inv_ln2 = 1.4426950408889634074;
+
+    int n = (int) (z*inv_ln2 + (z >= 0 ? 0.5 : -0.5));
+    double r = z - n*ln2;
+
+    //exp(r) on [-ln2/2, ln2/2], degree 9 Taylor: max relative error ~8e-12
+    double er = 1.0 + r*(1.0 + r*(1.0/2 + r*(1.0/6 + r*(1.0/24 + r*(1.0/120 + r*(1.0/720
+                + r*(1.0/5040 + r*(1.0/40320 + r*(1.0/362880)))))))));
+
+    //scale by 2^n through the exponent bits
+    union { double d; unsigned long long u; } scale;
+    scale.u = (unsigned long long)(n + 1023) << 52;
+    return er*scale.d;
+  }
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+  //! Two-lane variant of expApprox(), same reduction and tolerance.
+  static __m128d expApprox2(__m128d z)
+  {
+    const __m128d hi = _mm_set1_pd(700.);
+    const __m128d lo = _mm_set1_pd(-700.);
+    z = _mm_min_pd(_mm_max_pd(z, lo), hi);
+
+    const __m128d ln2 = _mm_set1_pd(0.69314718055994530942);
+    const __m128d inv_ln2 = _mm_set1_pd(1.4426950408889634074);
+
+    __m128i n32 = _mm_cvtpd_epi32(_mm_mul_pd(z, inv_ln2)); //round to nearest
+    __m128d nd = _mm_cvtepi32_pd(n32);
+    __m128d r = _mm_sub_pd(z, _mm_mul_pd(nd, ln2));
+
+    __m128d er = _mm_set1_pd(1.0/362880);
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0/40320));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0/5040));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0/720));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0/120));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0/24));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0/6));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(0.5));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0));
+    er = _mm_add_pd(_mm_mul_pd(er, r), _mm_set1_pd(1.0));
+
+    //2^n through the exponent bits: (n+1023) << 52 per 64-bit lane
+    __m128i biased = _mm_add_epi32(n32, _mm_set1_epi32(1023));
+    __m128i lanes = _mm_unpacklo_epi32(biased, _mm_setzero_si128());
+    __m128d scale = _mm_castsi128_pd(_mm_slli_epi64(lanes, 52));
+
+    return _mm_mul_pd(er, scale);
+  }
+#endif
+
+  std::vector<double> m_a;
+  std::vector<double> m_b;
+  std::vector<double> m_c;
+};
+
+#endif
@@ -48,7 +48,10 @@
 
 #include <list>
 
+#include <visp3/core/vpLatencyStats.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpSvdContext.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/visual_features/vpBasicFeature.h>
 #include <visp3/vs/vpServoException.h>
@@ -236,6 +239,20 @@ public:
   // destructor
   virtual ~vpServo() ;
 
+  /*!
+    Stamp the visual data the task currently works on : pass the
+    vpImage::getTimestamp() of the frame the features were updated from,
+    and every computeControlLaw() records the age of that data at
+    control output into getDataLatencyStats(), closing the
+    capture-to-servo latency accounting without external hardware.
+
+    \param timestampMs : Acquisition time of the data, in ms with the
+    vpTime::measureTimeMs() time base; negative to disable.
+  */
+  void setDataTimestamp(const double &timestampMs) { m_dataTimestampMs = timestampMs; }
+  //! Get the age-of-data statistics at control output, see setDataTimestamp().
+  const vpLatencyStats &getDataLatencyStats() const { return m_dataLatency; }
+
   // create a new ste of  two visual features
   void addFeature(vpBasicFeature& s, vpBasicFeature& s_star,
                   const unsigned int select=vpBasicFeature::FEATURE_ALL) ;
@@ -245,6 +262,23 @@ public:
 
   // compute the desired control law
   vpColVector computeControlLaw() ;
+  void computeControlLaw(vpColVector &v_out) ;
+
+  /*!
+    Solve the primary task through the normal equations accumulated from the
+    2x6 (or nx6) feature blocks of the stacked interaction matrix: the
+    6x6 system J1t J1 is assembled block-wise and solved by Cholesky,
+    several times cheaper than the dense SVD pseudo inverse when many
+    features are stacked. Suited to full rank tasks (e.g. many point
+    features); when the system is ill conditioned the solve falls back on
+    a small SVD and the task keeps behaving as a full rank one (no
+    redundancy projector), so keep the default dense path when a secondary
+    task must exploit the null space of a rank deficient task.
+
+    \param block : True to use the block normal equation path, false
+    (default) for the historic dense pseudo inverse.
+  */
+  void setBlockNormalEquations(const bool &block) { m_useBlockNormalEquations = block; }
   // compute the desired control law
   vpColVector computeControlLaw(double t) ;
   vpColVector computeControlLaw(double t, const vpColVector &e_dot_init);
@@ -541,6 +575,18 @@ public:
     Twist transformation matrix
   */
 
+  //! Acquisition time of the data the features come from, negative when unset. See setDataTimestamp().
+  double m_dataTimestampMs ;
+  //! Age-of-data statistics at control output.
+  vpLatencyStats m_dataLatency ;
+
+  //! Record the age of the data at control output, called by the control law computations.
+  void recordDataAge()
+  {
+    if (m_dataTimestampMs >= 0.)
+      m_dataLatency.record(vpTime::measureTimeMs() - m_dataTimestampMs);
+  }
+
   //! Twist transformation matrix between Re and Rc.
   vpVelocityTwistMatrix cVe ;
   bool init_cVe ;
@@ -579,6 +625,26 @@ public:
 
   //! Projection operators \f$\bf WpW\f$.
   vpMatrix WpW ;
+
+  void computeControlLawCore() ;
+
+  //! True when the primary task is solved through block-accumulated normal
+  //! equations instead of the dense pseudo inverse, see setBlockNormalEquations().
+  bool m_useBlockNormalEquations;
+  //! Scratch of the normal equation path
+  vpMatrix m_NE_S;
+  vpColVector m_NE_g;
+
+  //! Scratch storage reused across the computeControlLaw() calls so that the
+  //! steady state path (unchanged feature set) does not allocate
+  vpVelocityTwistMatrix m_cVa;
+  vpMatrix m_aJe;
+  vpMatrix m_cVaM;
+  vpMatrix m_LcVa;
+  vpMatrix m_LcJc;
+  vpMatrix m_imJ1;
+  vpMatrix m_imJ1t;
+  vpColVector m_J1pError;
   //! Projection operators \f$\bf I-WpW\f$.
   vpMatrix I_WpW ;
   /*!
@@ -602,6 +668,10 @@ public:
   //! Singular values from the pseudo inverse.
   vpColVector sv ;
 
+  //! SVD workspace reused at each control law computation to avoid
+  //! per-iteration allocations.
+  vpSvdContext svdContext ;
+
   double mu;
 
   vpColVector e1_initial;
@@ -47,6 +47,10 @@
 
 // Servo
 #include <visp3/vs/vpServo.h>
+#include <visp3/core/vpThread.h>
+
+#include <vector>
+#include <cstdio>
 
 #include <iostream>
 
@@ -72,6 +76,21 @@ private:
   //! or in m/rad
   bool cmDeg ;
 
+  //! Binary ring logging state, see openBinary()
+  FILE *m_binFile ;
+  //! Flat ring storage: m_binCapacity slots of m_binRecordSize doubles
+  std::vector<double> m_binRing ;
+  unsigned int m_binCapacity ;
+  unsigned int m_binRecordSize ;
+  //! Task and joint dimensions captured at the first saveBinary()
+  unsigned int m_binDimTask ;
+  unsigned int m_binDof ;
+  volatile unsigned int m_binHead ;    //!< written only by the control thread
+  volatile unsigned int m_binTail ;    //!< written only by the flush thread
+  volatile unsigned int m_binDropped ;
+  volatile bool m_binActive ;
+  vpThread *m_binThread ;
+
 
 
 public:
@@ -79,7 +98,10 @@ public:
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
   vpServoData(const vpServoData &sd)
     : velocityFile(), errorFile(), errorNormFile(), sFile(),
-      sStarFile(), vNormFile(), cmDeg(false) {
+      sStarFile(), vNormFile(), cmDeg(false),
+      m_binFile(NULL), m_binRing(), m_binCapacity(0), m_binRecordSize(0),
+      m_binDimTask(0), m_binDof(0), m_binHead(0), m_binTail(0), m_binDropped(0),
+      m_binActive(false), m_binThread(NULL) {
     *this = sd;
   }      
   vpServoData & operator=(const vpServoData &) {
@@ -87,8 +109,11 @@ public:
   }
 #endif
 
-  vpServoData() : velocityFile(), errorFile(), errorNormFile(), sFile(), sStarFile(), vNormFile(), cmDeg(false) { ; }
-  virtual ~vpServoData() { ; }
+  vpServoData() : velocityFile(), errorFile(), errorNormFile(), sFile(), sStarFile(), vNormFile(), cmDeg(false),
+      m_binFile(NULL), m_binRing(), m_binCapacity(0), m_binRecordSize(0),
+      m_binDimTask(0), m_binDof(0), m_binHead(0), m_binTail(0), m_binDropped(0),
+      m_binActive(false), m_binThread(NULL) { ; }
+  virtual ~vpServoData() { closeBinary() ; }
 
   //! velocity output in cm and deg
   void setCmDeg() ;
@@ -103,6 +128,19 @@ public:
   void push() ;
   void display(vpImage<unsigned char> &I) ;
 
+  void openBinary(const char *filename, unsigned int capacity = 4096) ;
+  void saveBinary(const vpServo &task) ;
+  void closeBinary() ;
+  //! Get the number of records dropped because the ring was full.
+  unsigned int getBinaryDropped() const { return m_binDropped ; }
+
+  static bool convertBinaryLog(const char *binaryFilename, const char *directory) ;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  //! Entry point of the background flush thread, not meant to be called directly.
+  void runBinaryFlushThread() ;
+#endif
+
 } ;
 
 
@@ -68,10 +68,14 @@
 vpServo::vpServo() 
   : L(), error(), J1(), J1p(), s(), sStar(), e1(), e(), q_dot(), v(), servoType(vpServo::NONE),
     rankJ1(0), featureList(), desiredFeatureList(), featureSelectionList(), lambda(), signInteractionMatrix(1),
-    interactionMatrixType(DESIRED), inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false),
+    interactionMatrixType(DESIRED), inversionType(PSEUDO_INVERSE),
+    m_dataTimestampMs(-1.), m_dataLatency(), cVe(), init_cVe(false),
     cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false),
     errorComputed(false), interactionMatrixComputed(false), dim_task(0), taskWasKilled(false),
-    forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(),
+    forceInteractionMatrixComputation(false), WpW(),
+    m_useBlockNormalEquations(false), m_NE_S(), m_NE_g(),
+    m_cVa(), m_aJe(), m_cVaM(), m_LcVa(), m_LcJc(), m_imJ1(), m_imJ1t(), m_J1pError(),
+    I_WpW(), P(), sv(), mu(4.), e1_initial(),
     iscJcIdentity(true), cJc(6,6)
 {
   cJc.eye();
@@ -93,10 +97,14 @@ vpServo::vpServo()
 vpServo::vpServo(vpServoType servo_type)
   : L(), error(), J1(), J1p(), s(), sStar(), e1(), e(), q_dot(), v(), servoType(servo_type),
     rankJ1(0), featureList(), desiredFeatureList(), featureSelectionList(), lambda(), signInteractionMatrix(1),
-    interactionMatrixType(DESIRED), inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false),
+    interactionMatrixType(DESIRED), inversionType(PSEUDO_INVERSE),
+    m_dataTimestampMs(-1.), m_dataLatency(), cVe(), init_cVe(false),
     cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false),
     errorComputed(false), interactionMatrixComputed(false), dim_task(0), taskWasKilled(false),
-    forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4), e1_initial(),
+    forceInteractionMatrixComputation(false), WpW(),
+    m_useBlockNormalEquations(false), m_NE_S(), m_NE_g(),
+    m_cVa(), m_aJe(), m_cVaM(), m_LcVa(), m_LcJc(), m_imJ1(), m_imJ1t(), m_J1pError(),
+    I_WpW(), P(), sv(), mu(4), e1_initial(),
     iscJcIdentity(true), cJc(6,6)
 {
   cJc.eye();
@@ -634,7 +642,9 @@ static void computeInteractionMatrixFromList  (const std::list<vpBasicFeature *>
   for (it = featureList.begin(), it_select = featureSelectionList.begin(); it != featureList.end(); ++it, ++it_select)
   {
     /* Get s. */
-    matrixTmp = (*it)->interaction( *it_select );
+    //In-place computation: the features overriding the in-place interaction
+    //reuse matrixTmp storage instead of returning a fresh matrix
+    (*it)->interaction( matrixTmp, *it_select );
     unsigned int rowMatrixTmp = matrixTmp .getRows();
     unsigned int colMatrixTmp = matrixTmp .getCols();
 
@@ -950,14 +960,17 @@ bool vpServo::testUpdated()
   To ensure continuous sequencing the computeControlLaw(double) function can be used. It will ensure that
   the velocities that are computed are continuous.
 */
-vpColVector vpServo::computeControlLaw()
+void vpServo::computeControlLawCore()
 {
+  recordDataAge() ;
   static int iteration =0;
 
   try
   {
-    vpVelocityTwistMatrix cVa ; // Twist transformation matrix
-    vpMatrix aJe ;      // Jacobian
+    // Scratch members reused across the calls: in steady state (unchanged
+    // feature set) the whole control law computation is allocation free
+    vpVelocityTwistMatrix &cVa = m_cVa ; // Twist transformation matrix
+    vpMatrix &aJe = m_aJe ;      // Jacobian
 
     if (iteration==0)
     {
@@ -1007,11 +1020,20 @@ vpColVector vpServo::computeControlLaw()
     computeInteractionMatrix() ;
     computeError() ;
 
-    // compute  task Jacobian
-    if(iscJcIdentity)
-      J1 = L*cVa*aJe ;
-    else
-      J1 = L*cJc*cVa*aJe ;
+    // compute task Jacobian, chaining the products through the scratch
+    // members so that no temporary is allocated
+    m_cVaM.resize(6, 6, false);
+    for (unsigned int i = 0; i < 6; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        m_cVaM[i][j] = cVa[i][j];
+    if(iscJcIdentity) {
+      vpMatrix::mult2Matrices(L, m_cVaM, m_LcVa) ;
+    }
+    else {
+      vpMatrix::mult2Matrices(L, cJc, m_LcJc) ;
+      vpMatrix::mult2Matrices(m_LcJc, m_cVaM, m_LcVa) ;
+    }
+    vpMatrix::mult2Matrices(m_LcVa, aJe, J1) ;
 
     // handle the eye-in-hand eye-to-hand case
     J1 *= signInteractionMatrix ;
@@ -1020,12 +1042,39 @@ vpColVector vpServo::computeControlLaw()
     // and rank of the task Jacobian
     // the image of J1 is also computed to allows the computation
     // of the projection operator
-    vpMatrix imJ1t, imJ1 ;
+    vpMatrix &imJ1t = m_imJ1t ;
+    vpMatrix &imJ1 = m_imJ1 ;
     bool imageComputed = false ;
 
+    if (inversionType==PSEUDO_INVERSE && m_useBlockNormalEquations)
+    {
+      // Normal equations accumulated from the stacked feature blocks: the
+      // 6x6 system replaces the dense pseudo inverse of the whole stack.
+      // The task is treated as full rank (see setBlockNormalEquations()).
+      J1.AtA(m_NE_S) ;
+      m_NE_g.resize(J1.getCols()) ;
+      m_NE_g = 0. ;
+      for (unsigned int r = 0; r < J1.getRows(); r++) {
+        const double *row = J1[r] ;
+        double er = error[r] ;
+        for (unsigned int c = 0; c < J1.getCols(); c++)
+          m_NE_g[c] += row[c]*er ;
+      }
+      m_NE_S.choleskySolve(m_NE_g, e1) ;
+
+      rankJ1 = J1.getCols() ;
+      WpW.eye(J1.getCols(), J1.getCols()) ;
+      e = - lambda(e1) * e1 ;
+
+      computeProjectionOperators();
+
+      iteration++ ;
+      return ;
+    }
+
     if (inversionType==PSEUDO_INVERSE)
     {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t) ;
+      rankJ1 = svdContext.pseudoInverse(J1, J1p, sv, 1e-6, imJ1, imJ1t) ;
 
       imageComputed = true ;
     }
@@ -1037,7 +1086,7 @@ vpColVector vpServo::computeControlLaw()
       /* if no degrees of freedom remains (rank J1 = ndof)
        WpW = I, multiply by WpW is useless
     */
-      e1 = J1p*error ;// primary task
+      vpMatrix::multMatrixVector(J1p, error, e1) ;// primary task
 
       WpW.eye(J1.getCols(), J1.getCols()) ;
     }
@@ -1048,7 +1097,7 @@ vpColVector vpServo::computeControlLaw()
         vpMatrix Jtmp ;
         // image of J1 is computed to allows the computation
         // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t) ;
+        rankJ1 = svdContext.pseudoInverse(J1, Jtmp, sv, 1e-6, imJ1, imJ1t) ;
       }
       WpW = imJ1t*imJ1t.t() ;
 
@@ -1061,14 +1110,11 @@ vpColVector vpServo::computeControlLaw()
       std::cout << "J1" <<std::endl <<J1  ;
       std::cout << "J1p" <<std::endl <<J1p  ;
 #endif
-      e1 = WpW*J1p*error ;
+      vpMatrix::multMatrixVector(J1p, error, m_J1pError) ;
+      vpMatrix::multMatrixVector(WpW, m_J1pError, e1) ;
     }
     e = - lambda(e1) * e1 ;
 
-    vpMatrix I ;
-
-    I.eye(J1.getCols(),J1.getCols()) ;
-
     computeProjectionOperators();
 
   }
@@ -1077,9 +1123,28 @@ vpColVector vpServo::computeControlLaw()
   }
 
   iteration++ ;
+}
+
+vpColVector vpServo::computeControlLaw()
+{
+  computeControlLawCore() ;
   return e ;
 }
 
+/*!
+  Variant of computeControlLaw() writing the velocity into caller provided
+  storage: the output vector is only resized when the task dimension
+  changes, so a caller keeping it across the iterations of the servo loop
+  gets a fully allocation free steady state.
+
+  \param v_out : Computed velocity, resized to the task degrees of freedom.
+*/
+void vpServo::computeControlLaw(vpColVector &v_out)
+{
+  computeControlLawCore() ;
+  v_out = e ;
+}
+
 /*!
   Compute the control law specified using setServo(). See vpServo::vpServoType for more
   details concerning the control laws that are available. The \ref tutorial-boost-vs is also useful to
@@ -1110,6 +1175,7 @@ vpColVector vpServo::computeControlLaw()
 */
 vpColVector vpServo::computeControlLaw(double t)
 {
+  recordDataAge() ;
   static int iteration =0;
   //static vpColVector e1_initial;
 
@@ -1181,7 +1247,7 @@ vpColVector vpServo::computeControlLaw(double t)
 
     if (inversionType==PSEUDO_INVERSE)
     {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t) ;
+      rankJ1 = svdContext.pseudoInverse(J1, J1p, sv, 1e-6, imJ1, imJ1t) ;
 
       imageComputed = true ;
     }
@@ -1204,7 +1270,7 @@ vpColVector vpServo::computeControlLaw(double t)
         vpMatrix Jtmp ;
         // image of J1 is computed to allows the computation
         // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t) ;
+        rankJ1 = svdContext.pseudoInverse(J1, Jtmp, sv, 1e-6, imJ1, imJ1t) ;
       }
       WpW = imJ1t*imJ1t.t() ;
 
@@ -1274,6 +1340,7 @@ vpColVector vpServo::computeControlLaw(double t)
 */
 vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
 {
+  recordDataAge() ;
   static int iteration =0;
 
   try
@@ -1344,7 +1411,7 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
 
     if (inversionType==PSEUDO_INVERSE)
     {
-      rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, imJ1, imJ1t) ;
+      rankJ1 = svdContext.pseudoInverse(J1, J1p, sv, 1e-6, imJ1, imJ1t) ;
 
       imageComputed = true ;
     }
@@ -1367,7 +1434,7 @@ vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
         vpMatrix Jtmp ;
         // image of J1 is computed to allows the computation
         // of the projection operator
-        rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, imJ1, imJ1t) ;
+        rankJ1 = svdContext.pseudoInverse(J1, Jtmp, sv, 1e-6, imJ1, imJ1t) ;
       }
       WpW = imJ1t*imJ1t.t() ;
 
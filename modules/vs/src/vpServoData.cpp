@@ -47,6 +47,15 @@
 #include <visp3/vs/vpServoData.h>
 #include <visp3/core/vpIoException.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpMath.h>
+
+#include <string.h>
+#if !defined(_WIN32)
+#  include <unistd.h>
+#else
+#  include <windows.h>
+#endif
 
 void
 vpServoData::open(const char *directory)
@@ -117,6 +126,268 @@ void vpServoData::close()
 
 
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+//! Header of the binary servo log, followed by fixed-layout records of
+//! (3 + dof + 2*dim_task + dim_task) doubles:
+//! timestamp, errorNorm, vNorm, q_dot[dof], error[dim], s[dim], sStar[dim].
+struct vpServoDataBinHeader
+{
+  unsigned int magic;    //!< 0x53564c47 ("SVLG")
+  unsigned int version;
+  unsigned int dimTask;
+  unsigned int dof;
+  unsigned int cmDeg;    //!< Velocity unit flag of the producing vpServoData
+  unsigned int reserved;
+};
+
+static vpThread::Return vpServoDataFlushThreadEntry(vpThread::Args args)
+{
+  ((vpServoData *) args)->runBinaryFlushThread();
+  return 0;
+}
+
+//! Short yielding nap for the flush loop: vpTime::wait() busy-spins under a
+//! few ms, which would burn a core against the control thread.
+static inline void vpServoDataNap()
+{
+#if !defined(_WIN32)
+  usleep(500);
+#else
+  Sleep(1);
+#endif
+}
+
+//! Full memory barrier ordering the ring accesses with the index publications.
+static inline void vpServoDataBarrier()
+{
+#if defined(__GNUC__)
+  __sync_synchronize();
+#elif defined(_WIN32)
+  MemoryBarrier();
+#endif
+}
+#endif
+
+/*!
+  Open the binary ring log: per-iteration records are appended by
+  saveBinary() into a preallocated memory ring that a background thread
+  flushes to the given file, so the control thread never formats text nor
+  touches the disk. When the ring is full the record is dropped and
+  accounted (see getBinaryDropped()) rather than delaying the control loop.
+  The record layout is fixed by the first saveBinary() call; use
+  convertBinaryLog() to turn the file into the historic text format
+  offline.
+
+  \param filename : Path of the binary log file.
+  \param capacity : Number of records the memory ring can hold.
+*/
+void vpServoData::openBinary(const char *filename, unsigned int capacity)
+{
+  closeBinary();
+
+  m_binFile = fopen(filename, "wb");
+  if (m_binFile == NULL) {
+    vpERROR_TRACE("Cannot create the binary servo log %s", filename);
+    throw(vpException(vpException::ioError, "Cannot create the binary servo log"));
+  }
+
+  //Power of two capacity: the ring indices wrap safely with a mask
+  m_binCapacity = 1;
+  while (m_binCapacity < capacity)
+    m_binCapacity *= 2;
+  m_binRecordSize = 0;  //fixed at the first saveBinary()
+  m_binDimTask = 0;
+  m_binDof = 0;
+  m_binHead = 0;
+  m_binTail = 0;
+  m_binDropped = 0;
+  m_binActive = true;
+  m_binThread = new vpThread((vpThread::Fn) vpServoDataFlushThreadEntry, (vpThread::Args) this);
+}
+
+/*!
+  Append one fixed-layout record with the current task state into the
+  memory ring. Wait free: never blocks the control thread, never allocates
+  after the first call, drops (and accounts) the record when the flush
+  thread is late. Records whose dimensions differ from the first one are
+  dropped too, since the layout of a log is fixed.
+
+  \param task : The servo task to snapshot.
+*/
+void vpServoData::saveBinary(const vpServo &task)
+{
+  if (m_binFile == NULL)
+    return;
+
+  unsigned int dim = task.getError().getRows();
+  unsigned int dof = task.q_dot.getRows();
+
+  if (m_binRecordSize == 0) {
+    //First record: fix the layout, size the ring and write the file header
+    m_binDimTask = dim;
+    m_binDof = dof;
+    m_binRecordSize = 3 + dof + 3*dim;
+    m_binRing.resize((size_t) m_binCapacity * m_binRecordSize);
+
+    vpServoDataBinHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = 0x53564c47u;
+    header.version = 1;
+    header.dimTask = dim;
+    header.dof = dof;
+    header.cmDeg = cmDeg ? 1 : 0;
+    fwrite(&header, sizeof(header), 1, m_binFile);
+  }
+
+  if (dim != m_binDimTask || dof != m_binDof) {
+    m_binDropped = m_binDropped + 1;
+    return;
+  }
+
+  unsigned int head = m_binHead;
+  if (head - m_binTail >= m_binCapacity) {
+    m_binDropped = m_binDropped + 1;
+    return;
+  }
+
+  double *rec = &m_binRing[(size_t)(head & (m_binCapacity-1)) * m_binRecordSize];
+  unsigned int c = 0;
+  rec[c++] = vpTime::measureTimeMs();
+  rec[c++] = task.getError().sumSquare();
+  rec[c++] = task.q_dot.sumSquare();
+  for (unsigned int i = 0; i < dof; i++)
+    rec[c++] = task.q_dot[i];
+  const vpColVector &err = task.getError();
+  for (unsigned int i = 0; i < dim; i++)
+    rec[c++] = err[i];
+  for (unsigned int i = 0; i < dim; i++)
+    rec[c++] = task.s[i];
+  for (unsigned int i = 0; i < dim; i++)
+    rec[c++] = task.sStar[i];
+
+  vpServoDataBarrier(); //the record must be visible before its index
+  m_binHead = head + 1;
+}
+
+/*!
+  Background flush loop: drains the ring to the file, sleeping briefly when
+  it is empty, until closeBinary() deactivates the log (the remaining
+  records are drained before exiting). Internal entry point.
+*/
+void vpServoData::runBinaryFlushThread()
+{
+  for (;;) {
+    unsigned int tail = m_binTail;
+    if (tail == m_binHead) {
+      if (!m_binActive)
+        break;
+      vpServoDataNap();
+      continue;
+    }
+
+    vpServoDataBarrier(); //the index must be read before the record
+    fwrite(&m_binRing[(size_t)(tail & (m_binCapacity-1)) * m_binRecordSize],
+           sizeof(double), m_binRecordSize, m_binFile);
+    vpServoDataBarrier(); //the record must be read before the slot is released
+    m_binTail = tail + 1;
+  }
+  fflush(m_binFile);
+}
+
+/*!
+  Stop the binary log: waits for the background thread to drain the ring,
+  then closes the file. Harmless when no binary log is open.
+*/
+void vpServoData::closeBinary()
+{
+  if (m_binThread != NULL) {
+    m_binActive = false;
+    m_binThread->join();
+    delete m_binThread;
+    m_binThread = NULL;
+  }
+  if (m_binFile != NULL) {
+    fclose(m_binFile);
+    m_binFile = NULL;
+  }
+}
+
+/*!
+  Convert a binary servo log written by saveBinary() into the historic text
+  files (vel.dat, error.dat, errornorm.dat, vnorm.dat, s.dat, sStar.dat) in
+  the given directory, applying the cm/deg velocity conversion if the log
+  was produced in that mode.
+
+  \param binaryFilename : The binary log file.
+  \param directory : Output directory of the text files, created if needed.
+
+  \return True on success, false when the file is missing or invalid.
+*/
+bool vpServoData::convertBinaryLog(const char *binaryFilename, const char *directory)
+{
+  FILE *f = fopen(binaryFilename, "rb");
+  if (f == NULL)
+    return false;
+
+  vpServoDataBinHeader header;
+  if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != 0x53564c47u || header.version != 1) {
+    fclose(f);
+    return false;
+  }
+
+  if (vpIoTools::checkDirectory(directory) == false)
+    vpIoTools::makeDirectory(directory);
+
+  char name[FILENAME_MAX];
+  sprintf(name, "%s/vel.dat", directory);
+  std::ofstream vel(name);
+  sprintf(name, "%s/error.dat", directory);
+  std::ofstream err(name);
+  sprintf(name, "%s/errornorm.dat", directory);
+  std::ofstream errnorm(name);
+  sprintf(name, "%s/vnorm.dat", directory);
+  std::ofstream vnorm(name);
+  sprintf(name, "%s/s.dat", directory);
+  std::ofstream sfile(name);
+  sprintf(name, "%s/sStar.dat", directory);
+  std::ofstream sstar(name);
+
+  unsigned int recordSize = 3 + header.dof + 3*header.dimTask;
+  std::vector<double> rec(recordSize);
+  while (fread(&rec[0], sizeof(double), recordSize, f) == recordSize) {
+    unsigned int c = 1; //skip the timestamp, absent from the historic format
+    errnorm << rec[c++] << std::endl;
+    vnorm << rec[c++] << std::endl;
+
+    if (header.cmDeg) {
+      for (unsigned int i = 0; i < 3 && i < header.dof; i++)
+        vel << rec[c+i]*100 << " ";
+      for (unsigned int i = 4; i < 6 && i < header.dof; i++)
+        vel << vpMath::deg(rec[c+i]) << " ";
+      vel << std::endl;
+    }
+    else {
+      for (unsigned int i = 0; i < header.dof; i++)
+        vel << rec[c+i] << " ";
+      vel << std::endl;
+    }
+    c += header.dof;
+
+    for (unsigned int i = 0; i < header.dimTask; i++)
+      err << rec[c++] << " ";
+    err << std::endl;
+    for (unsigned int i = 0; i < header.dimTask; i++)
+      sfile << rec[c++] << " ";
+    sfile << std::endl;
+    for (unsigned int i = 0; i < header.dimTask; i++)
+      sstar << rec[c++] << " ";
+    sstar << std::endl;
+  }
+
+  fclose(f);
+  return true;
+}
+
 /*
  * Local variables:
  * c-basic-offset: 2